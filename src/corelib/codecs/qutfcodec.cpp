@@ -13,6 +13,7 @@
 
 #include "qutfcodec_p.h"
 #include "qlist.h"
+#include "private/qstring_p.h"
 
 #ifndef QT_NO_TEXTCODEC
 
@@ -75,7 +76,11 @@ QByteArray QUtf8Codec::convertFromUnicode(const QChar *uc, int len, ConverterSta
         }
 
         if (u < 0x80) {
-            *cursor++ = (uchar)u;
+            // copy the whole ASCII run at once
+            int n = qt_to_ascii_prefix(cursor, reinterpret_cast<const ushort *>(ch), end - ch);
+            cursor += n;
+            ch += n;
+            continue;
         } else {
             if (u < 0x0800) {
                 *cursor++ = 0xc0 | ((uchar) (u >> 6));
@@ -186,7 +191,11 @@ void QUtf8Codec::convertToUnicode(QString *target, const char *chars, int len, C
             }
         } else {
             if (ch < 128) {
-                *qch++ = QLatin1Char(ch);
+                // copy the whole ASCII run at once
+                int n = qt_from_ascii_prefix(reinterpret_cast<ushort *>(qch),
+                                             reinterpret_cast<const uchar *>(chars) + i, len - i);
+                qch += n;
+                i += n - 1;
             } else if ((ch & 0xe0) == 0xc0) {
                 uc = ch & 0x1f;
                 need = 1;
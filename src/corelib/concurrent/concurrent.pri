@@ -0,0 +1,32 @@
+# Qt core concurrent module
+
+# public headers
+HEADERS += concurrent/qfuture.h \
+           concurrent/qfutureinterface.h \
+           concurrent/qfuturewatcher.h \
+           concurrent/qtconcurrentfilter.h \
+           concurrent/qtconcurrentfilterkernel.h \
+           concurrent/qtconcurrentfunctionwrappers.h \
+           concurrent/qtconcurrentiteratekernel.h \
+           concurrent/qtconcurrentmap.h \
+           concurrent/qtconcurrentmapkernel.h \
+           concurrent/qtconcurrentreducekernel.h \
+           concurrent/qtconcurrentresultstore.h \
+           concurrent/qtconcurrentrun.h \
+           concurrent/qtconcurrentrunbase.h \
+           concurrent/qtconcurrentstoredfunctioncall.h \
+           concurrent/qtconcurrentthreadengine.h
+
+# private headers
+HEADERS += concurrent/qfutureinterface_p.h \
+           concurrent/qfuturewatcher_p.h
+
+SOURCES += concurrent/qfuture.cpp \
+           concurrent/qfutureinterface.cpp \
+           concurrent/qfuturewatcher.cpp \
+           concurrent/qtconcurrentfilter.cpp \
+           concurrent/qtconcurrentiteratekernel.cpp \
+           concurrent/qtconcurrentmap.cpp \
+           concurrent/qtconcurrentresultstore.cpp \
+           concurrent/qtconcurrentrun.cpp \
+           concurrent/qtconcurrentthreadengine.cpp
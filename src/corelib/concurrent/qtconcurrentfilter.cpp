@@ -0,0 +1,224 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+/*!
+    \headerfile <QtConcurrentFilter>
+    \title Concurrent Filter and Filter-Reduce
+    \ingroup thread
+
+    \brief The <QtConcurrentFilter> header provides concurrent Filter and
+    Filter-Reduce.
+
+    These functions are a part of the \l {threads.html#qtconcurrent-intro}{Qt Concurrent} framework.
+
+    The QtConcurrent::filter(), QtConcurrent::filtered() and
+    QtConcurrent::filteredReduced() functions filter items in a sequence such
+    as a QList or a QVector in parallel. QtConcurrent::filter() modifies a
+    sequence in-place, QtConcurrent::filtered() returns a new sequence
+    containing the filtered content, and QtConcurrent::filteredReduced()
+    returns a single result.
+
+    Each of the above functions have a blocking variant that returns the final
+    result instead of a QFuture. You use them in the same way as the
+    asynchronous variants.
+
+    \section1 Concurrent Filter
+
+    QtConcurrent::filtered() takes an input sequence and a filter function.
+    This filter function is then called for each item in the sequence, and a
+    new sequence containing the filtered values is returned.
+
+    The filter function must be of the form:
+
+    \code
+        bool function(const T &t);
+    \endcode
+
+    T must match the type stored in the sequence. The function returns true if
+    the item should be kept, false if it should be discarded.
+
+    This example shows how to keep strings that are all lower-case from a
+    QStringList:
+
+    \code
+        bool allLowerCase(const QString &string)
+        {
+            return string.lowered() == string;
+        }
+
+        QStringList strings = ...;
+        QFuture<QString> lowerCaseStrings = QtConcurrent::filtered(strings, allLowerCase);
+    \endcode
+
+    The results of the filter are made available through QFuture, in the
+    order of the original sequence. If you want to modify a sequence
+    in-place, use QtConcurrent::filter():
+
+    \code
+        QStringList strings = ...;
+        QFuture<void> future = QtConcurrent::filter(strings, allLowerCase);
+    \endcode
+
+    Since the sequence is modified in place, QtConcurrent::filter() does not
+    return any results via QFuture. However, you can still use QFuture and
+    QFutureWatcher to monitor the status of the filter.
+
+    \section1 Concurrent Filter-Reduce
+
+    QtConcurrent::filteredReduced() is similar to QtConcurrent::filtered(),
+    but instead of returning a sequence with the filtered results, the results
+    are combined into a single value using a reduce function.
+
+    The reduce function must be of the form:
+
+    \code
+        V function(T &result, const U &intermediate)
+    \endcode
+
+    T is the type of the final result, U is the type of items being filtered.
+    Note that the return value and return type of the reduce function are not
+    used.
+
+    \code
+        void addToDictionary(QSet<QString> &dictionary, const QString &string)
+        {
+            dictionary.insert(string);
+        }
+
+        QStringList strings = ...;
+        QFuture<QSet<QString> > dictionary = QtConcurrent::filteredReduced(strings, allLowerCase, addToDictionary);
+    \endcode
+
+    The reduce function will be called once for each result kept by the filter
+    function, and should merge the \e{intermediate} into the \e{result}
+    variable. Only one thread calls the reduce function at a time, and the
+    QtConcurrent::ReduceOption flags control the order in which the results
+    are reduced.
+
+    Iterator ranges, member functions and function objects are supported in
+    the same way as for \l {Concurrent Map and Map-Reduce}.
+*/
+
+/*!
+    \fn QFuture<void> QtConcurrent::filter(Sequence &sequence, FilterFunction filterFunction)
+
+    Calls \a filterFunction once for each item in \a sequence. If
+    \a filterFunction returns true, the item is kept in \a sequence;
+    otherwise, the item is removed from \a sequence.
+*/
+
+/*!
+    \fn QFuture<T> QtConcurrent::filtered(const Sequence &sequence, FilterFunction filterFunction)
+
+    Calls \a filterFunction once for each item in \a sequence and returns a
+    new Sequence of kept items. If \a filterFunction returns true, a copy of
+    the item is put in the new Sequence. Otherwise, the item will \e not
+    appear in the new Sequence.
+*/
+
+/*!
+    \fn QFuture<T> QtConcurrent::filtered(ConstIterator begin, ConstIterator end, FilterFunction filterFunction)
+
+    Calls \a filterFunction once for each item from \a begin to \a end and
+    returns a new Sequence of kept items. If \a filterFunction returns true, a
+    copy of the item is put in the new Sequence. Otherwise, the item will
+    \e not appear in the new Sequence.
+*/
+
+/*!
+    \fn QFuture<T> QtConcurrent::filteredReduced(const Sequence &sequence, FilterFunction filterFunction, ReduceFunction reduceFunction, QtConcurrent::ReduceOptions reduceOptions)
+
+    Calls \a filterFunction once for each item in \a sequence. If
+    \a filterFunction returns true for an item, that item is then passed to
+    \a reduceFunction. In other words, the return value is the result of
+    \a reduceFunction for each item where \a filterFunction returns true.
+
+    Note that while \a filterFunction is called concurrently, only one thread
+    at a time will call \a reduceFunction. The order in which \a reduceFunction
+    is called is undefined if \a reduceOptions is
+    QtConcurrent::UnorderedReduce. If \a reduceOptions is
+    QtConcurrent::OrderedReduce, \a reduceFunction is called in the order of
+    the original sequence.
+*/
+
+/*!
+    \fn QFuture<T> QtConcurrent::filteredReduced(ConstIterator begin, ConstIterator end, FilterFunction filterFunction, ReduceFunction reduceFunction, QtConcurrent::ReduceOptions reduceOptions)
+
+    Calls \a filterFunction once for each item from \a begin to \a end. If
+    \a filterFunction returns true for an item, that item is then passed to
+    \a reduceFunction. In other words, the return value is the result of
+    \a reduceFunction for each item where \a filterFunction returns true.
+
+    Note that while \a filterFunction is called concurrently, only one thread
+    at a time will call \a reduceFunction. The order in which
+    \a reduceFunction is called is undefined if \a reduceOptions is
+    QtConcurrent::UnorderedReduce. If \a reduceOptions is
+    QtConcurrent::OrderedReduce, the \a reduceFunction is called in the order
+    of the original sequence.
+*/
+
+/*!
+    \fn void QtConcurrent::blockingFilter(Sequence &sequence, FilterFunction filterFunction)
+
+    Calls \a filterFunction once for each item in \a sequence. If
+    \a filterFunction returns true, the item is kept in \a sequence;
+    otherwise, the item is removed from \a sequence.
+
+    \note This function will block until all items in the sequence have been processed.
+*/
+
+/*!
+    \fn Sequence QtConcurrent::blockingFiltered(const Sequence &sequence, FilterFunction filterFunction)
+
+    Calls \a filterFunction once for each item in \a sequence and returns a
+    new Sequence of kept items. If \a filterFunction returns true, a copy of
+    the item is put in the new Sequence. Otherwise, the item will \e not
+    appear in the new Sequence.
+
+    \note This function will block until all items in the sequence have been processed.
+*/
+
+/*!
+    \fn Sequence QtConcurrent::blockingFiltered(ConstIterator begin, ConstIterator end, FilterFunction filterFunction)
+
+    Calls \a filterFunction once for each item from \a begin to \a end and
+    returns a new Sequence of kept items. If \a filterFunction returns true, a
+    copy of the item is put in the new Sequence. Otherwise, the item will
+    \e not appear in the new Sequence. Specify the type of the new Sequence as
+    a template argument.
+
+    \note This function will block until the iterator reaches the end of the
+    sequence being processed.
+*/
+
+/*!
+    \fn T QtConcurrent::blockingFilteredReduced(const Sequence &sequence, FilterFunction filterFunction, ReduceFunction reduceFunction, QtConcurrent::ReduceOptions reduceOptions)
+
+    Calls \a filterFunction once for each item in \a sequence. If
+    \a filterFunction returns true for an item, that item is then passed to
+    \a reduceFunction. In other words, the return value is the result of
+    \a reduceFunction for each item where \a filterFunction returns true.
+
+    \note This function will block until all items in the sequence have been processed.
+*/
+
+/*!
+    \fn T QtConcurrent::blockingFilteredReduced(ConstIterator begin, ConstIterator end, FilterFunction filterFunction, ReduceFunction reduceFunction, QtConcurrent::ReduceOptions reduceOptions)
+
+    Calls \a filterFunction once for each item from \a begin to \a end. If
+    \a filterFunction returns true for an item, that item is then passed to
+    \a reduceFunction. In other words, the return value is the result of
+    \a reduceFunction for each item where \a filterFunction returns true.
+
+    \note This function will block until the iterator reaches the end of the
+    sequence being processed.
+*/
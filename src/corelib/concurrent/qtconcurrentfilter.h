@@ -0,0 +1,240 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef QTCONCURRENT_FILTER_H
+#define QTCONCURRENT_FILTER_H
+
+#include <QtCore/qglobal.h>
+
+#ifndef QT_NO_CONCURRENT
+
+#include <QtCore/qtconcurrentfilterkernel.h>
+#include <QtCore/qtconcurrentfunctionwrappers.h>
+
+QT_BEGIN_HEADER
+QT_BEGIN_NAMESPACE
+
+QT_MODULE(Core)
+
+#ifdef qdoc
+
+namespace QtConcurrent {
+
+    QFuture<void> filter(Sequence &sequence, FilterFunction filterFunction);
+
+    template <typename T>
+    QFuture<T> filtered(const Sequence &sequence, FilterFunction filterFunction);
+    template <typename T>
+    QFuture<T> filtered(ConstIterator begin, ConstIterator end, FilterFunction filterFunction);
+
+    template <typename T>
+    QFuture<T> filteredReduced(const Sequence &sequence,
+                               FilterFunction filterFunction,
+                               ReduceFunction reduceFunction,
+                               QtConcurrent::ReduceOptions reduceOptions = UnorderedReduce | SequentialReduce);
+    template <typename T>
+    QFuture<T> filteredReduced(ConstIterator begin,
+                               ConstIterator end,
+                               FilterFunction filterFunction,
+                               ReduceFunction reduceFunction,
+                               QtConcurrent::ReduceOptions reduceOptions = UnorderedReduce | SequentialReduce);
+
+    void blockingFilter(Sequence &sequence, FilterFunction filterFunction);
+
+    template <typename Sequence>
+    Sequence blockingFiltered(const Sequence &sequence, FilterFunction filterFunction);
+    template <typename Sequence>
+    Sequence blockingFiltered(ConstIterator begin, ConstIterator end, FilterFunction filterFunction);
+
+    template <typename T>
+    T blockingFilteredReduced(const Sequence &sequence,
+                              FilterFunction filterFunction,
+                              ReduceFunction reduceFunction,
+                              QtConcurrent::ReduceOptions reduceOptions = UnorderedReduce | SequentialReduce);
+    template <typename T>
+    T blockingFilteredReduced(ConstIterator begin,
+                              ConstIterator end,
+                              FilterFunction filterFunction,
+                              ReduceFunction reduceFunction,
+                              QtConcurrent::ReduceOptions reduceOptions = UnorderedReduce | SequentialReduce);
+
+} // namespace QtConcurrent
+
+#else
+
+namespace QtConcurrent {
+
+template <typename Sequence, typename KeepFunctor, typename T, typename C, typename U>
+ThreadEngineStarter<void> filterInternal(Sequence &sequence, KeepFunctor keep, T (C::*reduce)(U))
+{
+    typedef MemberFunctionWrapper1<T, C, U> ReduceFunctor;
+    typedef FilterKernel<Sequence, KeepFunctor, ReduceFunctor> KernelType;
+    return startThreadEngine(new KernelType(sequence, keep, reduce));
+}
+
+// filter() on sequences
+template <typename Sequence, typename KeepFunctor>
+QFuture<void> filter(Sequence &sequence, KeepFunctor keep)
+{
+    return filterInternal(sequence, createFunctionWrapper(keep), &Sequence::push_back);
+}
+
+// filteredReduced() on sequences
+template <typename ResultType, typename Sequence, typename KeepFunctor, typename ReduceFunctor>
+QFuture<ResultType> filteredReduced(const Sequence &sequence,
+                                    KeepFunctor keep,
+                                    ReduceFunctor reduce,
+                                    ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startFilteredReduced<ResultType>(sequence, createFunctionWrapper(keep), createFunctionWrapper(reduce), options);
+}
+
+template <typename Sequence, typename KeepFunctor, typename ReduceFunctor>
+QFuture<typename ReduceResultType<ReduceFunctor>::ResultType> filteredReduced(const Sequence &sequence,
+                                                                               KeepFunctor keep,
+                                                                               ReduceFunctor reduce,
+                                                                               ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startFilteredReduced<typename ReduceResultType<ReduceFunctor>::ResultType>
+        (sequence,
+         createFunctionWrapper(keep),
+         createFunctionWrapper(reduce),
+         options);
+}
+
+// filteredReduced() on iterators
+template <typename ResultType, typename Iterator, typename KeepFunctor, typename ReduceFunctor>
+QFuture<ResultType> filteredReduced(Iterator begin,
+                                    Iterator end,
+                                    KeepFunctor keep,
+                                    ReduceFunctor reduce,
+                                    ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startFilteredReduced<ResultType>(begin, end, createFunctionWrapper(keep), createFunctionWrapper(reduce), options);
+}
+
+template <typename Iterator, typename KeepFunctor, typename ReduceFunctor>
+QFuture<typename ReduceResultType<ReduceFunctor>::ResultType> filteredReduced(Iterator begin,
+                                                                               Iterator end,
+                                                                               KeepFunctor keep,
+                                                                               ReduceFunctor reduce,
+                                                                               ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startFilteredReduced<typename ReduceResultType<ReduceFunctor>::ResultType>
+        (begin, end,
+         createFunctionWrapper(keep),
+         createFunctionWrapper(reduce),
+         options);
+}
+
+// filtered() on sequences
+template <typename Sequence, typename KeepFunctor>
+QFuture<typename Sequence::value_type> filtered(const Sequence &sequence, KeepFunctor keep)
+{
+    return startFiltered(sequence, createFunctionWrapper(keep));
+}
+
+// filtered() on iterators
+template <typename Iterator, typename KeepFunctor>
+QFuture<typename qValueType<Iterator>::value_type> filtered(Iterator begin, Iterator end, KeepFunctor keep)
+{
+    return startFiltered(begin, end, createFunctionWrapper(keep));
+}
+
+// blocking filter() on sequences
+template <typename Sequence, typename KeepFunctor>
+void blockingFilter(Sequence &sequence, KeepFunctor keep)
+{
+    filterInternal(sequence, createFunctionWrapper(keep), &Sequence::push_back).startBlocking();
+}
+
+// blocking filteredReduced() on sequences
+template <typename ResultType, typename Sequence, typename KeepFunctor, typename ReduceFunctor>
+ResultType blockingFilteredReduced(const Sequence &sequence,
+                                   KeepFunctor keep,
+                                   ReduceFunctor reduce,
+                                   ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startFilteredReduced<ResultType>(sequence, createFunctionWrapper(keep), createFunctionWrapper(reduce), options)
+        .startBlocking();
+}
+
+template <typename Sequence, typename KeepFunctor, typename ReduceFunctor>
+typename ReduceResultType<ReduceFunctor>::ResultType blockingFilteredReduced(const Sequence &sequence,
+                                                                              KeepFunctor keep,
+                                                                              ReduceFunctor reduce,
+                                                                              ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startFilteredReduced<typename ReduceResultType<ReduceFunctor>::ResultType>
+        (sequence,
+         createFunctionWrapper(keep),
+         createFunctionWrapper(reduce),
+         options)
+        .startBlocking();
+}
+
+// blocking filteredReduced() on iterators
+template <typename ResultType, typename Iterator, typename KeepFunctor, typename ReduceFunctor>
+ResultType blockingFilteredReduced(Iterator begin,
+                                   Iterator end,
+                                   KeepFunctor keep,
+                                   ReduceFunctor reduce,
+                                   ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startFilteredReduced<ResultType>
+        (begin, end,
+         createFunctionWrapper(keep),
+         createFunctionWrapper(reduce),
+         options)
+        .startBlocking();
+}
+
+template <typename Iterator, typename KeepFunctor, typename ReduceFunctor>
+typename ReduceResultType<ReduceFunctor>::ResultType blockingFilteredReduced(Iterator begin,
+                                                                              Iterator end,
+                                                                              KeepFunctor keep,
+                                                                              ReduceFunctor reduce,
+                                                                              ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startFilteredReduced<typename ReduceResultType<ReduceFunctor>::ResultType>
+        (begin, end,
+         createFunctionWrapper(keep),
+         createFunctionWrapper(reduce),
+         options)
+        .startBlocking();
+}
+
+// blocking filtered() on sequences
+template <typename Sequence, typename KeepFunctor>
+Sequence blockingFiltered(const Sequence &sequence, KeepFunctor keep)
+{
+    return blockingFilteredReduced(sequence, keep, &Sequence::push_back, OrderedReduce);
+}
+
+// blocking filtered() on iterators
+template <typename OutputSequence, typename Iterator, typename KeepFunctor>
+OutputSequence blockingFiltered(Iterator begin, Iterator end, KeepFunctor keep)
+{
+    return blockingFilteredReduced(begin, end, keep, &OutputSequence::push_back, OrderedReduce);
+}
+
+} // namespace QtConcurrent
+
+#endif // qdoc
+
+QT_END_NAMESPACE
+QT_END_HEADER
+
+#endif // QT_NO_CONCURRENT
+
+#endif
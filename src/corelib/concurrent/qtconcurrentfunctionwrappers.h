@@ -0,0 +1,222 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef QTCONCURRENT_FUNCTIONWRAPPERS_H
+#define QTCONCURRENT_FUNCTIONWRAPPERS_H
+
+#include <QtCore/qglobal.h>
+
+#ifndef QT_NO_CONCURRENT
+
+QT_BEGIN_HEADER
+QT_BEGIN_NAMESPACE
+
+QT_MODULE(Core)
+
+#ifndef qdoc
+
+namespace QtConcurrent {
+
+// The function wrappers give plain functions and member functions the
+// same call syntax and result_type typedef as user-supplied functors, so
+// that the kernels only have to deal with one kind of callable.
+
+template <typename T>
+class FunctionWrapper0
+{
+public:
+    typedef T (*FunctionPointerType)();
+    typedef T result_type;
+    inline FunctionWrapper0(FunctionPointerType _functionPointer)
+    :functionPointer(_functionPointer) { }
+
+    inline T operator()()
+    {
+        return functionPointer();
+    }
+private:
+    FunctionPointerType functionPointer;
+};
+
+template <typename T, typename U>
+class FunctionWrapper1
+{
+public:
+    typedef T (*FunctionPointerType)(U u);
+    typedef T result_type;
+    inline FunctionWrapper1(FunctionPointerType _functionPointer)
+    :functionPointer(_functionPointer) { }
+
+    inline T operator()(U u)
+    {
+        return functionPointer(u);
+    }
+
+private:
+    FunctionPointerType functionPointer;
+};
+
+template <typename T, typename U, typename V>
+class FunctionWrapper2
+{
+public:
+    typedef T (*FunctionPointerType)(U u, V v);
+    typedef T result_type;
+    inline FunctionWrapper2(FunctionPointerType _functionPointer)
+    :functionPointer(_functionPointer) { }
+
+    inline T operator()(U u, V v)
+    {
+        return functionPointer(u, v);
+    }
+private:
+    FunctionPointerType functionPointer;
+};
+
+template <typename T, typename C>
+class MemberFunctionWrapper
+{
+public:
+    typedef T (C::*FunctionPointerType)();
+    typedef T result_type;
+    inline MemberFunctionWrapper(FunctionPointerType _functionPointer)
+    :functionPointer(_functionPointer) { }
+
+    inline T operator()(C &c)
+    {
+        return (c.*functionPointer)();
+    }
+private:
+    FunctionPointerType functionPointer;
+};
+
+template <typename T, typename C, typename U>
+class MemberFunctionWrapper1
+{
+public:
+    typedef T (C::*FunctionPointerType)(U);
+    typedef T result_type;
+
+    inline MemberFunctionWrapper1(FunctionPointerType _functionPointer)
+        : functionPointer(_functionPointer)
+    { }
+
+    inline T operator()(C &c, U u)
+    {
+        return (c.*functionPointer)(u);
+    }
+
+private:
+    FunctionPointerType functionPointer;
+};
+
+template <typename T, typename C>
+class ConstMemberFunctionWrapper
+{
+public:
+    typedef T (C::*FunctionPointerType)() const;
+    typedef T result_type;
+    inline ConstMemberFunctionWrapper(FunctionPointerType _functionPointer)
+    :functionPointer(_functionPointer) { }
+
+    inline T operator()(const C &c) const
+    {
+        return (c.*functionPointer)();
+    }
+private:
+    FunctionPointerType functionPointer;
+};
+
+template <typename T>
+const T &createFunctionWrapper(const T &t)
+{
+    return t;
+}
+
+template <typename T, typename U>
+FunctionWrapper1<T, U> createFunctionWrapper(T (*func)(U))
+{
+    return FunctionWrapper1<T, U>(func);
+}
+
+template <typename T, typename U, typename V>
+FunctionWrapper2<T, U, V> createFunctionWrapper(T (*func)(U, V))
+{
+    return FunctionWrapper2<T, U, V>(func);
+}
+
+template <typename T, typename C>
+MemberFunctionWrapper<T, C> createFunctionWrapper(T (C::*func)())
+{
+    return MemberFunctionWrapper<T, C>(func);
+}
+
+template <typename T, typename C, typename U>
+MemberFunctionWrapper1<T, C, U> createFunctionWrapper(T (C::*func)(U))
+{
+    return MemberFunctionWrapper1<T, C, U>(func);
+}
+
+template <typename T, typename C>
+ConstMemberFunctionWrapper<T, C> createFunctionWrapper(T (C::*func)() const)
+{
+    return ConstMemberFunctionWrapper<T, C>(func);
+}
+
+// MapResultType and ReduceResultType extract the type produced by a map
+// function and the type accumulated by a reduce function. Functors are
+// expected to provide a result_type typedef.
+
+template <class T>
+struct MapResultType
+{
+    typedef typename T::result_type ResultType;
+};
+
+template <class U, class V>
+struct MapResultType<U (*)(V)>
+{
+    typedef U ResultType;
+};
+
+template <class T, class C>
+struct MapResultType<T (C::*)() const>
+{
+    typedef T ResultType;
+};
+
+template <class T>
+struct ReduceResultType;
+
+template <class U, class V, class W>
+struct ReduceResultType<U (*)(V &, W)>
+{
+    typedef V ResultType;
+};
+
+template <class T, class C, class U>
+struct ReduceResultType<T (C::*)(U)>
+{
+    typedef C ResultType;
+};
+
+} // namespace QtConcurrent
+
+#endif // qdoc
+
+QT_END_NAMESPACE
+QT_END_HEADER
+
+#endif // QT_NO_CONCURRENT
+
+#endif
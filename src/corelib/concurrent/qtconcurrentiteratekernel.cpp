@@ -0,0 +1,55 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "qtconcurrentiteratekernel.h"
+
+#ifndef QT_NO_CONCURRENT
+
+QT_BEGIN_NAMESPACE
+
+enum {
+    TargetBlocksPerThread = 8
+};
+
+namespace QtConcurrent {
+
+/*! \internal
+
+    Aim for TargetBlocksPerThread blocks per thread: enough for the threads
+    to even out towards the end of the iteration, few enough for the cost
+    of reserving a block to disappear next to the user code.
+*/
+BlockSizeManager::BlockSizeManager(int iterationCount)
+    : maxBlockSize(qMax(1, iterationCount / (qMax(1, QThreadPool::globalInstance()->maxThreadCount())
+                                             * TargetBlocksPerThread))),
+      m_blockSize(1)
+{ }
+
+/*! \internal
+
+    Returns the size of the next block. The first block contains a single
+    iteration, each following block is twice as large as the previous one
+    until the maximum block size is reached.
+*/
+int BlockSizeManager::blockSize()
+{
+    const int size = m_blockSize;
+    m_blockSize = qMin(m_blockSize * 2, maxBlockSize);
+    return size;
+}
+
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
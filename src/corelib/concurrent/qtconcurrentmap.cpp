@@ -0,0 +1,405 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+/*!
+    \namespace QtConcurrent
+    \since 4.4
+    \brief The QtConcurrent namespace provides high-level APIs that make it
+    possible to write multi-threaded programs without using low-level
+    threading primitives.
+
+    The functions in QtConcurrent run on the global QThreadPool. They
+    automatically adjust the number of threads used to the number of
+    processor cores available, and report their results and progress through
+    a QFuture.
+
+    \ingroup thread
+*/
+
+/*!
+    \enum QtConcurrent::ReduceOption
+    This enum specifies the order of which results from the map or filter
+    function are passed to the reduce function.
+
+    \value UnorderedReduce Reduction is done in an arbitrary order.
+    \value OrderedReduce Reduction is done in the order of the
+    original sequence.
+    \value SequentialReduce Reduction is done sequentially: only one
+    thread will enter the reduce function at a time. (Parallel reduction
+    might be supported in a future version of Qt Concurrent.)
+*/
+
+/*!
+    \headerfile <QtConcurrentMap>
+    \title Concurrent Map and Map-Reduce
+    \ingroup thread
+
+    \brief The <QtConcurrentMap> header provides concurrent Map and MapReduce.
+
+    These functions are a part of the \l {threads.html#qtconcurrent-intro}{Qt Concurrent} framework.
+
+    The QtConcurrent::map(), QtConcurrent::mapped() and
+    QtConcurrent::mappedReduced() functions run computations in parallel on
+    the items in a sequence such as a QList or a QVector. QtConcurrent::map()
+    modifies a sequence in-place, QtConcurrent::mapped() returns a new
+    sequence containing the modified content, and QtConcurrent::mappedReduced()
+    returns a single result.
+
+    Each of the above functions has a blocking variant that returns
+    the final result instead of a QFuture. You use them in the same
+    way as the asynchronous variants.
+
+    \section1 Concurrent Map
+
+    QtConcurrent::mapped() takes an input sequence and a map function. This map
+    function is then called for each item in the sequence, and a new sequence
+    containing the return values from the map function is returned.
+
+    The map function must be of the form:
+
+    \code
+        U function(const T &t);
+    \endcode
+
+    T and U can be any type (and they can even be the same type), but T must
+    match the type stored in the sequence. The function returns the modified
+    or \e mapped content.
+
+    This example shows how to apply a scale function to all the items
+    in a sequence:
+
+    \code
+        QImage scaled(const QImage &image)
+        {
+            return image.scaled(100, 100);
+        }
+
+        QList<QImage> images = ...;
+        QFuture<QImage> thumbnails = QtConcurrent::mapped(images, scaled);
+    \endcode
+
+    The results of the map are made available through QFuture. See the
+    QFuture and QFutureWatcher documentation for more information on how to
+    use QFuture in your applications.
+
+    If you want to modify a sequence in-place, use QtConcurrent::map(). The
+    map function must then be of the form:
+
+    \code
+        U function(T &t);
+    \endcode
+
+    Note that the return value and return type of the map function are not
+    used.
+
+    Using QtConcurrent::map() is similar to using QtConcurrent::mapped():
+
+    \code
+        void scale(QImage &image)
+        {
+            image = image.scaled(100, 100);
+        }
+
+        QList<QImage> images = ...;
+        QFuture<void> future = QtConcurrent::map(images, scale);
+    \endcode
+
+    Since the sequence is modified in place, QtConcurrent::map() does not
+    return any results via QFuture. However, you can still use QFuture and
+    QFutureWatcher to monitor the status of the map.
+
+    \section1 Concurrent Map-Reduce
+
+    QtConcurrent::mappedReduced() is similar to QtConcurrent::mapped(), but
+    instead of returning a sequence with the new results, the results are
+    combined into a single value using a reduce function.
+
+    The reduce function must be of the form:
+
+    \code
+        V function(T &result, const U &intermediate)
+    \endcode
+
+    T is the type of the final result, U is the return type of the map
+    function. Note that the return value and return type of the reduce
+    function are not used.
+
+    Call QtConcurrent::mappedReduced() like this:
+
+    \code
+        void addToCollage(QImage &collage, const QImage &thumbnail)
+        {
+            QPainter p(&collage);
+            static QPoint offset = QPoint(0, 0);
+            p.drawImage(offset, thumbnail);
+            offset += ...;
+        }
+
+        QList<QImage> images = ...;
+        QFuture<QImage> collage = QtConcurrent::mappedReduced(images, scaled, addToCollage);
+    \endcode
+
+    The reduce function will be called once for each result returned by the map
+    function, and should merge the \e{intermediate} into the \e{result}
+    variable.  QtConcurrent::mappedReduced() guarantees that only one thread
+    will call reduce at a time, so using a mutex to lock the result variable
+    is not necessary. The QtConcurrent::ReduceOptions enum provides a way to
+    control the order in which the reduction is done. If
+    QtConcurrent::UnorderedReduce is used (the default), the order is
+    undefined, while QtConcurrent::OrderedReduce ensures that the reduction
+    is done in the order of the original sequence.
+
+    \section1 Additional API Features
+
+    \section2 Using Iterators instead of Sequence
+
+    Each of the above functions has a variant that takes an iterator range
+    instead of a sequence. You use them in the same way as the sequence
+    variants:
+
+    \code
+        QList<QImage> images = ...;
+
+        QFuture<QImage> thumbnails = QtConcurrent::mapped(images.constBegin(), images.constEnd(), scaled);
+
+        // map in-place only works on non-const iterators
+        QFuture<void> future = QtConcurrent::map(images.begin(), images.end(), scale);
+
+        QFuture<QImage> collage = QtConcurrent::mappedReduced(images.constBegin(), images.constEnd(), scaled, addToCollage);
+    \endcode
+
+    Random access iterators are split into blocks that the threads process
+    independently; other iterators are advanced by one thread at a time.
+
+    \section2 Blocking Variants
+
+    Each of the above functions has a blocking variant that returns
+    the final result instead of a QFuture. You use them in the same
+    way as the asynchronous variants.
+
+    \code
+        QList<QImage> images = ...;
+
+        // each call blocks until the entire operation is finished
+        QList<QImage> future = QtConcurrent::blockingMapped<QList<QImage> >(images, scaled);
+
+        QtConcurrent::blockingMap(images, scale);
+
+        QImage collage = QtConcurrent::blockingMappedReduced(images, scaled, addToCollage);
+    \endcode
+
+    Note that the result types above are not QFuture objects, but real result
+    types (in this case, QList<QImage> and QImage). The calling thread takes
+    part in the computation while it waits.
+
+    \section2 Using Member Functions
+
+    QtConcurrent::map(), QtConcurrent::mapped(), and
+    QtConcurrent::mappedReduced() accept pointers to member functions.
+    The member function class type must match the type stored in the sequence:
+
+    \code
+        // squeeze all strings in a QStringList
+        QStringList strings = ...;
+        QFuture<void> squeezedStrings = QtConcurrent::map(strings, &QString::squeeze);
+
+        // swap the rgb values of all pixels on a list of images
+        QList<QImage> images = ...;
+        QFuture<QImage> bgrImages = QtConcurrent::mapped(images, &QImage::rgbSwapped);
+
+        // create a set of the lengths of all strings in a list
+        QStringList strings = ...;
+        QFuture<QSet<int> > wordLengths = QtConcurrent::mappedReduced(strings, &QString::length, &QSet<int>::insert);
+    \endcode
+
+    \section2 Using Function Objects
+
+    QtConcurrent::map(), QtConcurrent::mapped(), and
+    QtConcurrent::mappedReduced() accept function objects, which can be used
+    to add state to a function call. The result_type typedef must define the
+    result type of the function call operator:
+
+    \code
+        struct Scaled
+        {
+            Scaled(int size)
+            : m_size(size) { }
+
+            typedef QImage result_type;
+
+            QImage operator()(const QImage &image)
+            {
+                return image.scaled(m_size, m_size);
+            }
+
+            int m_size;
+        };
+
+        QList<QImage> images = ...;
+        QFuture<QImage> thumbnails = QtConcurrent::mapped(images, Scaled(100));
+    \endcode
+
+    For the reduce function, function objects are not directly
+    supported. Function objects can, however, be used when the type of the
+    reduction result is explicitly specified:
+
+    \code
+        struct ImageTransform
+        {
+            void operator()(QImage &result, const QImage &value);
+        };
+
+        QFuture<QImage> thumbNails =
+          QtConcurrent::mappedReduced<QImage>(images,
+                                              Scaled(100),
+                                              ImageTransform(),
+                                              QtConcurrent::SequentialReduce);
+    \endcode
+*/
+
+/*!
+    \fn QFuture<void> QtConcurrent::map(Sequence &sequence, MapFunction function)
+
+    Calls \a function once for each item in \a sequence. The \a function is
+    passed a reference to the item, so that any modifications done to the item
+    will appear in \a sequence.
+*/
+
+/*!
+    \fn QFuture<void> QtConcurrent::map(Iterator begin, Iterator end, MapFunction function)
+
+    Calls \a function once for each item from \a begin to \a end. The
+    \a function is passed a reference to the item, so that any modifications
+    done to the item will appear in the sequence which the iterators belong to.
+*/
+
+/*!
+    \fn QFuture<T> QtConcurrent::mapped(const Sequence &sequence, MapFunction function)
+
+    Calls \a function once for each item in \a sequence and returns a future
+    with each mapped item as a result. You can use QFuture::const_iterator or
+    QFutureIterator to iterate through the results.
+*/
+
+/*!
+    \fn QFuture<T> QtConcurrent::mapped(ConstIterator begin, ConstIterator end, MapFunction function)
+
+    Calls \a function once for each item from \a begin to \a end and returns a
+    future with each mapped item as a result. You can use
+    QFuture::const_iterator or QFutureIterator to iterate through the results.
+*/
+
+/*!
+    \fn QFuture<T> QtConcurrent::mappedReduced(const Sequence &sequence,
+    MapFunction mapFunction, ReduceFunction reduceFunction,
+    QtConcurrent::ReduceOptions reduceOptions)
+
+    Calls \a mapFunction once for each item in \a sequence. The return value of
+    each \a mapFunction is passed to \a reduceFunction.
+
+    Note that while \a mapFunction is called concurrently, only one thread at a
+    time will call \a reduceFunction. The order in which \a reduceFunction is
+    called is determined by \a reduceOptions.
+*/
+
+/*!
+    \fn QFuture<T> QtConcurrent::mappedReduced(ConstIterator begin,
+    ConstIterator end, MapFunction mapFunction, ReduceFunction reduceFunction,
+    QtConcurrent::ReduceOptions reduceOptions)
+
+    Calls \a mapFunction once for each item from \a begin to \a end. The return
+    value of each \a mapFunction is passed to \a reduceFunction.
+
+    Note that while \a mapFunction is called concurrently, only one thread at a
+    time will call \a reduceFunction. By default, the order in which
+    \a reduceFunction is called is undefined.
+
+    \note QtConcurrent::OrderedReduce results in the ordered reduction.
+*/
+
+/*!
+    \fn void QtConcurrent::blockingMap(Sequence &sequence, MapFunction function)
+
+    Calls \a function once for each item in \a sequence. The \a function is
+    passed a reference to the item, so that any modifications done to the item
+    will appear in \a sequence.
+
+    \note This function will block until all items in the sequence have been processed.
+*/
+
+/*!
+    \fn void QtConcurrent::blockingMap(Iterator begin, Iterator end, MapFunction function)
+
+    Calls \a function once for each item from \a begin to \a end. The
+    \a function is passed a reference to the item, so that any modifications
+    done to the item will appear in the sequence which the iterators belong to.
+
+    \note This function will block until the iterator reaches the end of the
+    sequence being processed.
+*/
+
+/*!
+    \fn T QtConcurrent::blockingMapped(const Sequence &sequence, MapFunction function)
+
+    Calls \a function once for each item in \a sequence and returns a
+    container with the results. Specify the type of container as a template
+    argument, like this:
+
+    \code
+       QList<int> ints = QtConcurrent::blockingMapped<QList<int> >(sequence, fn);
+    \endcode
+
+    \note This function will block until all items in the sequence have been processed.
+*/
+
+/*!
+    \fn T QtConcurrent::blockingMapped(ConstIterator begin, ConstIterator end, MapFunction function)
+
+    Calls \a function once for each item from \a begin to \a end and returns a
+    container with the results. Specify the type of container as a template
+    argument, like this:
+
+    \code
+       QList<int> ints = QtConcurrent::blockingMapped<QList<int> >(beginIterator, endIterator, fn);
+    \endcode
+
+    \note This function will block until the iterator reaches the end of the
+    sequence being processed.
+*/
+
+/*!
+    \fn T QtConcurrent::blockingMappedReduced(const Sequence &sequence, MapFunction mapFunction, ReduceFunction reduceFunction, QtConcurrent::ReduceOptions reduceOptions)
+
+    Calls \a mapFunction once for each item in \a sequence. The return value of
+    each \a mapFunction is passed to \a reduceFunction.
+
+    Note that while \a mapFunction is called concurrently, only one thread at a
+    time will call \a reduceFunction. The order in which \a reduceFunction is
+    called is determined by \a reduceOptions.
+
+    \note This function will block until all items in the sequence have been processed.
+*/
+
+/*!
+    \fn T QtConcurrent::blockingMappedReduced(ConstIterator begin, ConstIterator end, MapFunction mapFunction, ReduceFunction reduceFunction, QtConcurrent::ReduceOptions reduceOptions)
+
+    Calls \a mapFunction once for each item from \a begin to \a end. The return
+    value of each \a mapFunction is passed to \a reduceFunction.
+
+    Note that while \a mapFunction is called concurrently, only one thread at a
+    time will call \a reduceFunction. The order in which \a reduceFunction is
+    called is undefined.
+
+    \note This function will block until the iterator reaches the end of the
+    sequence being processed.
+*/
@@ -0,0 +1,264 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef QTCONCURRENT_MAP_H
+#define QTCONCURRENT_MAP_H
+
+#include <QtCore/qglobal.h>
+
+#ifndef QT_NO_CONCURRENT
+
+#include <QtCore/qtconcurrentmapkernel.h>
+#include <QtCore/qtconcurrentreducekernel.h>
+#include <QtCore/qtconcurrentfunctionwrappers.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_HEADER
+QT_BEGIN_NAMESPACE
+
+QT_MODULE(Core)
+
+#ifdef qdoc
+
+namespace QtConcurrent {
+
+    QFuture<void> map(Sequence &sequence, MapFunction function);
+    QFuture<void> map(Iterator begin, Iterator end, MapFunction function);
+
+    template <typename T>
+    QFuture<T> mapped(const Sequence &sequence, MapFunction function);
+    template <typename T>
+    QFuture<T> mapped(ConstIterator begin, ConstIterator end, MapFunction function);
+
+    template <typename T>
+    QFuture<T> mappedReduced(const Sequence &sequence,
+                             MapFunction function,
+                             ReduceFunction function,
+                             QtConcurrent::ReduceOptions options = UnorderedReduce | SequentialReduce);
+    template <typename T>
+    QFuture<T> mappedReduced(ConstIterator begin,
+                             ConstIterator end,
+                             MapFunction function,
+                             ReduceFunction function,
+                             QtConcurrent::ReduceOptions options = UnorderedReduce | SequentialReduce);
+
+    void blockingMap(Sequence &sequence, MapFunction function);
+    void blockingMap(Iterator begin, Iterator end, MapFunction function);
+
+    template <typename T>
+    T blockingMapped(const Sequence &sequence, MapFunction function);
+    template <typename T>
+    T blockingMapped(ConstIterator begin, ConstIterator end, MapFunction function);
+
+    template <typename T>
+    T blockingMappedReduced(const Sequence &sequence,
+                            MapFunction function,
+                            ReduceFunction function,
+                            QtConcurrent::ReduceOptions options = UnorderedReduce | SequentialReduce);
+    template <typename T>
+    T blockingMappedReduced(ConstIterator begin,
+                            ConstIterator end,
+                            MapFunction function,
+                            ReduceFunction function,
+                            QtConcurrent::ReduceOptions options = UnorderedReduce | SequentialReduce);
+
+} // namespace QtConcurrent
+
+#else
+
+namespace QtConcurrent {
+
+// map() on sequences
+template <typename Sequence, typename MapFunctor>
+QFuture<void> map(Sequence &sequence, MapFunctor map)
+{
+    return startMap(sequence.begin(), sequence.end(), createFunctionWrapper(map));
+}
+
+// map() on iterators
+template <typename Iterator, typename MapFunctor>
+QFuture<void> map(Iterator begin, Iterator end, MapFunctor map)
+{
+    return startMap(begin, end, createFunctionWrapper(map));
+}
+
+// mappedReduced() for sequences.
+template <typename ResultType, typename Sequence, typename MapFunctor, typename ReduceFunctor>
+QFuture<ResultType> mappedReduced(const Sequence &sequence,
+                                  MapFunctor map,
+                                  ReduceFunctor reduce,
+                                  ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startMappedReduced<typename MapResultType<MapFunctor>::ResultType, ResultType>
+        (sequence,
+         createFunctionWrapper(map),
+         createFunctionWrapper(reduce),
+         options);
+}
+
+template <typename Sequence, typename MapFunctor, typename ReduceFunctor>
+QFuture<typename ReduceResultType<ReduceFunctor>::ResultType> mappedReduced(const Sequence &sequence,
+                                                                             MapFunctor map,
+                                                                             ReduceFunctor reduce,
+                                                                             ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startMappedReduced<typename MapResultType<MapFunctor>::ResultType, typename ReduceResultType<ReduceFunctor>::ResultType>
+        (sequence,
+         createFunctionWrapper(map),
+         createFunctionWrapper(reduce),
+         options);
+}
+
+// mappedReduced() for iterators
+template <typename ResultType, typename Iterator, typename MapFunctor, typename ReduceFunctor>
+QFuture<ResultType> mappedReduced(Iterator begin,
+                                  Iterator end,
+                                  MapFunctor map,
+                                  ReduceFunctor reduce,
+                                  ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startMappedReduced<typename MapResultType<MapFunctor>::ResultType, ResultType>
+        (begin, end,
+         createFunctionWrapper(map),
+         createFunctionWrapper(reduce),
+         options);
+}
+
+template <typename Iterator, typename MapFunctor, typename ReduceFunctor>
+QFuture<typename ReduceResultType<ReduceFunctor>::ResultType> mappedReduced(Iterator begin,
+                                                                             Iterator end,
+                                                                             MapFunctor map,
+                                                                             ReduceFunctor reduce,
+                                                                             ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startMappedReduced<typename MapResultType<MapFunctor>::ResultType, typename ReduceResultType<ReduceFunctor>::ResultType>
+        (begin, end,
+         createFunctionWrapper(map),
+         createFunctionWrapper(reduce),
+         options);
+}
+
+// mapped() for sequences
+template <typename Sequence, typename MapFunctor>
+QFuture<typename MapResultType<MapFunctor>::ResultType> mapped(const Sequence &sequence, MapFunctor map)
+{
+    return startMapped<typename MapResultType<MapFunctor>::ResultType>(sequence, createFunctionWrapper(map));
+}
+
+// mapped() for iterator ranges.
+template <typename Iterator, typename MapFunctor>
+QFuture<typename MapResultType<MapFunctor>::ResultType> mapped(Iterator begin, Iterator end, MapFunctor map)
+{
+    return startMapped<typename MapResultType<MapFunctor>::ResultType>(begin, end, createFunctionWrapper(map));
+}
+
+// blockingMap() for sequences
+template <typename Sequence, typename MapFunctor>
+void blockingMap(Sequence &sequence, MapFunctor map)
+{
+    startMap(sequence.begin(), sequence.end(), createFunctionWrapper(map)).startBlocking();
+}
+
+// blockingMap() for iterator ranges
+template <typename Iterator, typename MapFunctor>
+void blockingMap(Iterator begin, Iterator end, MapFunctor map)
+{
+    startMap(begin, end, createFunctionWrapper(map)).startBlocking();
+}
+
+// blockingMappedReduced() for sequences
+template <typename ResultType, typename Sequence, typename MapFunctor, typename ReduceFunctor>
+ResultType blockingMappedReduced(const Sequence &sequence,
+                                 MapFunctor map,
+                                 ReduceFunctor reduce,
+                                 ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startMappedReduced<typename MapResultType<MapFunctor>::ResultType, ResultType>
+        (sequence,
+         createFunctionWrapper(map),
+         createFunctionWrapper(reduce),
+         options)
+        .startBlocking();
+}
+
+template <typename Sequence, typename MapFunctor, typename ReduceFunctor>
+typename ReduceResultType<ReduceFunctor>::ResultType blockingMappedReduced(const Sequence &sequence,
+                                                                            MapFunctor map,
+                                                                            ReduceFunctor reduce,
+                                                                            ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startMappedReduced<typename MapResultType<MapFunctor>::ResultType, typename ReduceResultType<ReduceFunctor>::ResultType>
+        (sequence,
+         createFunctionWrapper(map),
+         createFunctionWrapper(reduce),
+         options)
+        .startBlocking();
+}
+
+// blockingMappedReduced() for iterator ranges
+template <typename ResultType, typename Iterator, typename MapFunctor, typename ReduceFunctor>
+ResultType blockingMappedReduced(Iterator begin,
+                                 Iterator end,
+                                 MapFunctor map,
+                                 ReduceFunctor reduce,
+                                 ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startMappedReduced<typename MapResultType<MapFunctor>::ResultType, ResultType>
+        (begin, end,
+         createFunctionWrapper(map),
+         createFunctionWrapper(reduce),
+         options)
+        .startBlocking();
+}
+
+template <typename Iterator, typename MapFunctor, typename ReduceFunctor>
+typename ReduceResultType<ReduceFunctor>::ResultType blockingMappedReduced(Iterator begin,
+                                                                            Iterator end,
+                                                                            MapFunctor map,
+                                                                            ReduceFunctor reduce,
+                                                                            ReduceOptions options = ReduceOptions(UnorderedReduce | SequentialReduce))
+{
+    return startMappedReduced<typename MapResultType<MapFunctor>::ResultType, typename ReduceResultType<ReduceFunctor>::ResultType>
+        (begin, end,
+         createFunctionWrapper(map),
+         createFunctionWrapper(reduce),
+         options)
+        .startBlocking();
+}
+
+// blockingMapped() for sequences
+template <typename OutputSequence, typename InputSequence, typename MapFunctor>
+OutputSequence blockingMapped(const InputSequence &sequence, MapFunctor map)
+{
+    return blockingMappedReduced(sequence, map, &OutputSequence::push_back,
+                                 QtConcurrent::OrderedReduce);
+}
+
+// blockingMapped() for iterator ranges
+template <typename Sequence, typename Iterator, typename MapFunctor>
+Sequence blockingMapped(Iterator begin, Iterator end, MapFunctor map)
+{
+    return blockingMappedReduced(begin, end, map, &Sequence::push_back,
+                                 QtConcurrent::OrderedReduce);
+}
+
+} // namespace QtConcurrent
+
+#endif // qdoc
+
+QT_END_NAMESPACE
+QT_END_HEADER
+
+#endif // QT_NO_CONCURRENT
+
+#endif
@@ -0,0 +1,108 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+/*!
+    \headerfile <QtConcurrentRun>
+    \title Asynchronous Run
+    \ingroup thread
+
+    \brief The <QtConcurrentRun> header provides a way to run a function in a
+    separate thread.
+
+    This function is a part of the \l {threads.html#qtconcurrent-intro}{Qt Concurrent} framework.
+
+    The QtConcurrent::run() function runs a function in a separate thread.
+    The return value of the function is made available through the QFuture
+    API.
+
+    \section1 Running a Function in a Separate Thread
+
+    To run a function in another thread, use QtConcurrent::run():
+
+    \code
+        extern void aFunction();
+        QFuture<void> future = QtConcurrent::run(aFunction);
+    \endcode
+
+    This will run \e aFunction in a separate thread obtained from the default
+    QThreadPool. You can use the QFuture and QFutureWatcher classes to monitor
+    the status of the function.
+
+    \section1 Passing Arguments to the Function
+
+    Passing arguments to the function is done by adding them to the
+    QtConcurrent::run() call immediately after the function name. For example:
+
+    \code
+        extern void aFunctionWithArguments(int arg1, double arg2, const QString &string);
+
+        int integer = ...;
+        double floatingPoint = ...;
+        QString string = ...;
+
+        QFuture<void> future = QtConcurrent::run(aFunctionWithArguments, integer, floatingPoint, string);
+    \endcode
+
+    A copy of each argument is made at the point where QtConcurrent::run() is
+    called, and these values are passed to the thread when it begins executing
+    the function. Changes made to the arguments after calling
+    QtConcurrent::run() are \e not visible to the thread. Up to five
+    arguments are supported.
+
+    \section1 Returning Values from the Function
+
+    Any return value from the function is available via QFuture:
+
+    \code
+        extern QString functionReturningAString();
+        QFuture<QString> future = QtConcurrent::run(functionReturningAString);
+        ...
+        QString result = future.result();
+    \endcode
+
+    Note that the QFuture::result() function blocks and waits for the result
+    to become available. If the pool has not started the function yet, the
+    waiting thread runs it itself. Use QFutureWatcher to get notification
+    when the function has finished execution and the result is available.
+
+    \section1 Additional API Features
+
+    \section2 Using Member Functions
+
+    QtConcurrent::run() also accepts pointers to member functions. The first
+    argument must be either a const reference or a pointer to an instance of
+    the class. Passing by const reference is useful when calling const member
+    functions; passing by pointer is useful for calling non-const member
+    functions that modify the instance.
+
+    \code
+        // call 'QList<QByteArray> QByteArray::split(char sep) const' in a separate thread
+        QByteArray bytearray = "hello world";
+        QFuture<QList<QByteArray> > future = QtConcurrent::run(bytearray, &QByteArray::split, ',');
+        ...
+        QList<QByteArray> result = future.result();
+    \endcode
+
+    Function objects with a result_type typedef can be run in the same way
+    as plain functions.
+*/
+
+/*!
+    \fn QFuture<T> QtConcurrent::run(Function function, ...);
+
+    Runs \a function in a separate thread. The thread is taken from the global
+    QThreadPool. Note that the function may not run immediately; the function
+    will only be run when a thread is available.
+
+    The QFuture returned can be used to query for the running/finished status
+    and the return value of the function.
+*/
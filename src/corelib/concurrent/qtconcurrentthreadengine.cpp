@@ -0,0 +1,166 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "qtconcurrentthreadengine.h"
+
+#ifndef QT_NO_CONCURRENT
+
+QT_BEGIN_NAMESPACE
+
+namespace QtConcurrent {
+
+ThreadEngineBase::ThreadEngineBase()
+:futureInterface(0), threadPool(QThreadPool::globalInstance())
+{
+    setAutoDelete(false);
+}
+
+ThreadEngineBase::~ThreadEngineBase() {}
+
+void ThreadEngineBase::startSingleThreaded()
+{
+    start();
+    while (threadFunction() != ThreadFinished)
+        ;
+    finish();
+}
+
+// In blocking mode the calling thread takes part in the computation: it
+// starts as many pool threads as are available, then runs the thread
+// function itself before waiting for the others to finish.
+void ThreadEngineBase::startBlocking()
+{
+    start();
+    semaphore.acquire();
+    startThreads();
+
+    bool throttled = false;
+    while (threadFunction() == ThrottleThread) {
+        if (threadThrottleExit()) {
+            throttled = true;
+            break;
+        }
+    }
+
+    if (throttled == false) {
+        semaphore.release();
+    }
+
+    semaphore.wait();
+    finish();
+}
+
+void ThreadEngineBase::startThread()
+{
+    startThreadInternal();
+}
+
+void ThreadEngineBase::acquireBarrierSemaphore()
+{
+    semaphore.acquire();
+}
+
+bool ThreadEngineBase::isCanceled()
+{
+    if (futureInterface)
+        return futureInterface->isCanceled();
+    else
+        return false;
+}
+
+void ThreadEngineBase::waitForResume()
+{
+    if (futureInterface)
+        futureInterface->waitForResume();
+}
+
+bool ThreadEngineBase::isProgressReportingEnabled()
+{
+    // If we don't have a QFuture, there is no-one to report the progress to.
+    return (futureInterface != 0);
+}
+
+void ThreadEngineBase::setProgressValue(int progress)
+{
+    if (futureInterface)
+        futureInterface->setProgressValue(progress);
+}
+
+void ThreadEngineBase::setProgressRange(int minimum, int maximum)
+{
+    if (futureInterface)
+        futureInterface->setProgressRange(minimum, maximum);
+}
+
+bool ThreadEngineBase::startThreadInternal()
+{
+    if (this->isCanceled())
+        return false;
+
+    semaphore.acquire();
+    if (!threadPool->tryStart(this)) {
+        semaphore.release();
+        return false;
+    }
+    return true;
+}
+
+void ThreadEngineBase::startThreads()
+{
+    while (shouldStartThread() && startThreadInternal())
+        ;
+}
+
+void ThreadEngineBase::threadExit()
+{
+    const bool asynchronous = futureInterface != 0;
+    const int lastThread = (semaphore.release() == 0);
+
+    if (lastThread && asynchronous)
+        this->asynchronousFinish();
+}
+
+// Called by a worker thread that wants to be throttled. If the current number
+// of running threads is larger than one the thread is allowed to exit and
+// this function returns one.
+bool ThreadEngineBase::threadThrottleExit()
+{
+    return semaphore.releaseUnlessLast();
+}
+
+void ThreadEngineBase::run() // implements QRunnable.
+{
+    if (this->isCanceled()) {
+        threadExit();
+        return;
+    }
+
+    startThreads();
+
+    while (threadFunction() == ThrottleThread) {
+        // threadFunction returning ThrottleThread means it that the user
+        // struct wants to be throttled by making a worker thread exit.
+        // Respect that request unless this is the only worker thread left
+        // running, in which case it has to keep going.
+        if (threadThrottleExit())
+            return;
+    }
+
+    threadExit();
+}
+
+} // namespace QtConcurrent
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
@@ -8,6 +8,7 @@ include(../qbase.pri)
 include(arch/arch.pri)
 include(global/global.pri)
 include(thread/thread.pri)
+include(concurrent/concurrent.pri)
 include(tools/tools.pri)
 include(io/io.pri)
 include(plugin/plugin.pri)
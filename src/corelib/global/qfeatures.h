@@ -247,6 +247,11 @@
 #define QT_NO_CODECS
 #endif
 
+// QtConcurrent
+#if !defined(QT_NO_CONCURRENT) && (defined(QT_NO_THREAD))
+#define QT_NO_CONCURRENT
+#endif
+
 // QDate/QTime/QDateTime
 #if !defined(QT_NO_DATESTRING) && (defined(QT_NO_TEXTDATE))
 #define QT_NO_DATESTRING
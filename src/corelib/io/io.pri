@@ -4,7 +4,9 @@ HEADERS +=  \
         io/qabstractfileengine.h \
         io/qabstractfileengine_p.h \
         io/qbuffer.h \
+        io/qcompressiondevice.h \
         io/qdatastream.h \
+        io/qdatastream_p.h \
         io/qdebug.h \
         io/qdir.h \
         io/qdiriterator.h \
@@ -31,6 +33,7 @@ HEADERS +=  \
 SOURCES += \
         io/qabstractfileengine.cpp \
         io/qbuffer.cpp \
+        io/qcompressiondevice.cpp \
         io/qdatastream.cpp \
         io/qdebug.cpp \
         io/qdir.cpp \
@@ -735,6 +735,53 @@ bool QAbstractFileEngine::atEnd() const
     return const_cast<QAbstractFileEngine *>(this)->extension(AtEndExtension);
 }
 
+/*!
+    \since 4.4
+
+    Maps \a size bytes of the file into memory starting at \a offset.
+    Returns a pointer to the memory if successful; otherwise returns 0
+    if there was an error (for example, if the engine cannot map the
+    file or the range is invalid).
+
+    This function bases its behavior on calling extension() with
+    MapExtensionOption. If the engine does not support this extension, 0
+    is returned.
+
+    \a flags is currently not used, but could be used in a future release.
+
+    \sa unmap(), supportsExtension()
+*/
+uchar *QAbstractFileEngine::map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags)
+{
+    MapExtensionOption option;
+    option.offset = offset;
+    option.size = size;
+    option.flags = flags;
+    MapExtensionReturn r;
+    if (!extension(MapExtension, &option, &r))
+        return 0;
+    return r.address;
+}
+
+/*!
+    \since 4.4
+
+    Unmaps the memory \a address. Returns true if the unmap succeeds;
+    otherwise returns false.
+
+    This function bases its behavior on calling extension() with
+    UnMapExtensionOption. If the engine does not support this extension,
+    false is returned.
+
+    \sa map(), supportsExtension()
+*/
+bool QAbstractFileEngine::unmap(uchar *address)
+{
+    UnMapExtensionOption options;
+    options.address = address;
+    return extension(UnMapExtension, &options);
+}
+
 /*!
     \since 4.3
     \class QAbstractFileEngineIterator
@@ -834,6 +881,11 @@ bool QAbstractFileEngine::atEnd() const
 
     This enum describes the different types of information that can be
     requested through the QAbstractFileEngineIterator::entryInfo() function.
+
+    \value FileTypeInfo The type of the entry as an int holding
+    QAbstractFileEngine::FileFlags (FileType, DirectoryType, ExistsFlag
+    and HiddenFlag), if the iterator knows it without querying the file
+    system again. QDirIterator uses it to avoid a stat() per entry.
 */
 
 /*!
@@ -1100,6 +1152,15 @@ qint64 QAbstractFileEngine::readLine(char *data, qint64 maxlen)
    internal buffer. For engines that already provide a fast readLine()
    implementation, returning false for this extension can avoid
    unnnecessary double-buffering in QIODevice.
+
+   \value MapExtension Whether the file engine provides the ability to map
+   a file to memory. The input argument is a MapExtensionOption with the
+   offset and size of the region; on success, the address of the mapped
+   region is stored in the MapExtensionReturn output argument.
+
+   \value UnMapExtension Whether the file engine provides the ability to
+   unmap memory that was previously mapped. The input argument is an
+   UnMapExtensionOption with the address returned by MapExtension.
 */
 
 /*!
@@ -1120,6 +1181,33 @@ qint64 QAbstractFileEngine::readLine(char *data, qint64 maxlen)
    \sa QAbstractFileEngine::extension()
 */
 
+/*!
+   \class QAbstractFileEngine::MapExtensionOption
+   \since 4.4
+   \brief provides the offset, size and flags of the region to map
+   with QAbstractFileEngine::MapExtension.
+
+   \sa QAbstractFileEngine::map()
+*/
+
+/*!
+   \class QAbstractFileEngine::MapExtensionReturn
+   \since 4.4
+   \brief receives the address of the region mapped with
+   QAbstractFileEngine::MapExtension.
+
+   \sa QAbstractFileEngine::map()
+*/
+
+/*!
+   \class QAbstractFileEngine::UnMapExtensionOption
+   \since 4.4
+   \brief provides the address of the region to unmap with
+   QAbstractFileEngine::UnMapExtension.
+
+   \sa QAbstractFileEngine::unmap()
+*/
+
 /*!
     \since 4.3
 
@@ -126,15 +126,37 @@ public:
 
     enum Extension {
         AtEndExtension,
-        FastReadLineExtension
+        FastReadLineExtension,
+        MapExtension,
+        UnMapExtension
     };
     class ExtensionOption
     {};
     class ExtensionReturn
     {};
+
+    class MapExtensionOption : public ExtensionOption {
+    public:
+        qint64 offset;
+        qint64 size;
+        QFile::MemoryMapFlags flags;
+    };
+    class MapExtensionReturn : public ExtensionReturn {
+    public:
+        uchar *address;
+    };
+
+    class UnMapExtensionOption : public ExtensionOption {
+    public:
+        uchar *address;
+    };
+
     virtual bool extension(Extension extension, const ExtensionOption *option = 0, ExtensionReturn *output = 0);
     virtual bool supportsExtension(Extension extension) const;
 
+    uchar *map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags);
+    bool unmap(uchar *ptr);
+
     // Factory
     static QAbstractFileEngine *create(const QString &fileName);
 
@@ -180,6 +202,7 @@ public:
 
 protected:
     enum EntryInfoType {
+        FileTypeInfo
     };
     virtual QVariant entryInfo(EntryInfoType type) const;
 
@@ -0,0 +1,505 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "qcompressiondevice.h"
+
+#ifndef QT_NO_COMPRESS
+
+#include "private/qiodevice_p.h"
+
+#include <string.h>
+#include <zlib.h>
+
+QT_BEGIN_NAMESPACE
+
+// Compressed data passes through a buffer of this size in both
+// directions. Together with zlib's own state, it bounds the memory a
+// device uses, whatever the size of the stream.
+static const int CompressedBufferSize = 16384;
+
+class QCompressionDevicePrivate : public QIODevicePrivate
+{
+    Q_DECLARE_PUBLIC(QCompressionDevice)
+
+public:
+    enum State {
+        Closed,
+        Streaming,
+        StreamEnd,
+        Error
+    };
+
+    QCompressionDevicePrivate()
+        : device(0), format(QCompressionDevice::ZlibFormat), level(Z_DEFAULT_COMPRESSION),
+          state(Closed), outputPending(false), closeDevice(false), buffer(0)
+    {
+        memset(&zstream, 0, sizeof(zstream));
+    }
+    ~QCompressionDevicePrivate()
+    {
+        delete [] buffer;
+    }
+
+    int windowBits() const;
+    void setError(const QString &message);
+    bool deflateToDevice(int flush);
+
+    QIODevice *device;
+    QCompressionDevice::Format format;
+    int level;
+    State state;
+    bool outputPending;
+    bool closeDevice;
+    z_stream zstream;
+    char *buffer;
+};
+
+int QCompressionDevicePrivate::windowBits() const
+{
+    switch (format) {
+    case QCompressionDevice::GzipFormat:
+        return MAX_WBITS + 16;
+    case QCompressionDevice::RawDeflateFormat:
+        return -MAX_WBITS;
+    case QCompressionDevice::ZlibFormat:
+    default:
+        break;
+    }
+    return MAX_WBITS;
+}
+
+void QCompressionDevicePrivate::setError(const QString &message)
+{
+    Q_Q(QCompressionDevice);
+    state = Error;
+    q->setErrorString(message);
+}
+
+/*!
+    \internal
+
+    Runs the deflater with the \a flush mode and writes everything it
+    produces to the device. Returns false if the device did not accept
+    the data.
+*/
+bool QCompressionDevicePrivate::deflateToDevice(int flush)
+{
+    int ret;
+    do {
+        zstream.next_out = reinterpret_cast<Bytef *>(buffer);
+        zstream.avail_out = CompressedBufferSize;
+        ret = deflate(&zstream, flush);
+        if (ret == Z_STREAM_ERROR) {
+            setError(QCompressionDevice::tr("Compression failed"));
+            return false;
+        }
+        qint64 produced = CompressedBufferSize - zstream.avail_out;
+        if (produced > 0 && device->write(buffer, produced) != produced) {
+            setError(device->errorString());
+            return false;
+        }
+        // a full output buffer means the deflater has more to say
+    } while (zstream.avail_out == 0 || (flush == Z_FINISH && ret != Z_STREAM_END));
+    return true;
+}
+
+/*!
+    \class QCompressionDevice
+    \reentrant
+    \since 4.4
+    \brief The QCompressionDevice class compresses or decompresses the
+    data of another QIODevice as it is read or written.
+
+    \ingroup io
+
+    QCompressionDevice wraps a device such as a QFile, a QTcpSocket or
+    a QProcess and streams its data through zlib. Opened with
+    QIODevice::WriteOnly, it deflates everything written to it and
+    writes the compressed data to the device. Opened with
+    QIODevice::ReadOnly, it reads compressed data from the device and
+    returns it inflated.
+
+    Unlike qCompress() and qUncompress(), QCompressionDevice never needs
+    the whole payload in memory: data passes through a fixed size
+    buffer, so streams of any size can be processed with the same
+    small amount of memory.
+
+    \code
+        QFile file("export.csv.gz");
+        QCompressionDevice compressor(&file, QCompressionDevice::GzipFormat);
+        compressor.open(QIODevice::WriteOnly);
+
+        QTextStream out(&compressor);
+        while (query.next())
+            out << query.value(0).toString() << "\n";
+        out.flush();
+        compressor.close();
+    \endcode
+
+    The format() determines the framing of the compressed data; it can
+    be a zlib stream (as produced by qCompress() after its four byte
+    size prefix), a gzip file, or raw deflate data. When reading a gzip
+    file that consists of several members, their data is concatenated.
+
+    If the device is not open when open() is called, QCompressionDevice
+    opens it in the same mode and closes it again in close(). Otherwise
+    the device is left open. QCompressionDevice is sequential and
+    cannot be opened with QIODevice::ReadWrite.
+
+    When reading from a sequential device such as a socket, read()
+    returns what can be decompressed from the data that has arrived so
+    far; readyRead() is emitted when the device has more data.
+
+    \sa qCompress(), qUncompress()
+*/
+
+/*!
+    \enum QCompressionDevice::Format
+
+    This enum describes the framing of the compressed data.
+
+    \value ZlibFormat A zlib stream, as described in RFC 1950. This is
+    the format qCompress() uses after its four byte size prefix.
+    \value GzipFormat A gzip file, as described in RFC 1952.
+    \value RawDeflateFormat Deflate data without any header or
+    checksum, as described in RFC 1951.
+*/
+
+/*!
+    Constructs a QCompressionDevice that processes the data of \a
+    device in ZlibFormat, with the given \a parent.
+*/
+QCompressionDevice::QCompressionDevice(QIODevice *device, QObject *parent)
+    : QIODevice(*new QCompressionDevicePrivate, parent)
+{
+    Q_D(QCompressionDevice);
+    d->device = device;
+    if (device)
+        connect(device, SIGNAL(readyRead()), this, SIGNAL(readyRead()));
+}
+
+/*!
+    Constructs a QCompressionDevice that processes the data of \a
+    device in the given \a format, with the given \a parent.
+*/
+QCompressionDevice::QCompressionDevice(QIODevice *device, Format format, QObject *parent)
+    : QIODevice(*new QCompressionDevicePrivate, parent)
+{
+    Q_D(QCompressionDevice);
+    d->device = device;
+    d->format = format;
+    if (device)
+        connect(device, SIGNAL(readyRead()), this, SIGNAL(readyRead()));
+}
+
+/*!
+    Destroys the QCompressionDevice, closing it first if it is open.
+    The underlying device is not deleted.
+*/
+QCompressionDevice::~QCompressionDevice()
+{
+    close();
+}
+
+/*!
+    Returns the device whose data is compressed or decompressed.
+*/
+QIODevice *QCompressionDevice::device() const
+{
+    Q_D(const QCompressionDevice);
+    return d->device;
+}
+
+/*!
+    Returns the format of the compressed data. The default is
+    ZlibFormat.
+
+    \sa setFormat()
+*/
+QCompressionDevice::Format QCompressionDevice::format() const
+{
+    Q_D(const QCompressionDevice);
+    return d->format;
+}
+
+/*!
+    Sets the format of the compressed data to \a format. The format
+    cannot be changed while the device is open.
+
+    \sa format()
+*/
+void QCompressionDevice::setFormat(Format format)
+{
+    Q_D(QCompressionDevice);
+    if (isOpen()) {
+        qWarning("QCompressionDevice::setFormat: Cannot change the format of an open device");
+        return;
+    }
+    d->format = format;
+}
+
+/*!
+    Returns the compression level used when writing. The default is
+    -1, which selects zlib's default level.
+
+    \sa setCompressionLevel()
+*/
+int QCompressionDevice::compressionLevel() const
+{
+    Q_D(const QCompressionDevice);
+    return d->level;
+}
+
+/*!
+    Sets the compression level used when writing to \a level. Valid
+    values are between 0 and 9, with 9 corresponding to the greatest
+    compression (i.e. smaller compressed data) at the cost of using a
+    slower algorithm. Smaller values (8, 7, ..., 1) provide successively
+    less compression at slightly faster speeds. The value 0 corresponds
+    to no compression at all. The default value is -1, which specifies
+    zlib's default compression.
+
+    The level cannot be changed while the device is open.
+
+    \sa compressionLevel()
+*/
+void QCompressionDevice::setCompressionLevel(int level)
+{
+    Q_D(QCompressionDevice);
+    if (isOpen()) {
+        qWarning("QCompressionDevice::setCompressionLevel: Cannot change the level of an open device");
+        return;
+    }
+    d->level = qBound(-1, level, 9);
+}
+
+/*!
+    \reimp
+
+    QCompressionDevice is always sequential.
+*/
+bool QCompressionDevice::isSequential() const
+{
+    return true;
+}
+
+/*!
+    \reimp
+
+    Opens the device for compressing (if \a mode contains
+    QIODevice::WriteOnly) or decompressing (if \a mode contains
+    QIODevice::ReadOnly). Returns true if successful; otherwise returns
+    false and sets an error string.
+*/
+bool QCompressionDevice::open(OpenMode mode)
+{
+    Q_D(QCompressionDevice);
+    if (isOpen()) {
+        qWarning("QCompressionDevice::open: Device already open");
+        return false;
+    }
+    OpenMode access = mode & ReadWrite;
+    if (access == ReadWrite || access == NotOpen || (mode & Append)) {
+        qWarning("QCompressionDevice::open: Only ReadOnly or WriteOnly are supported");
+        return false;
+    }
+    if (!d->device) {
+        setErrorString(tr("No device"));
+        return false;
+    }
+
+    d->closeDevice = false;
+    if (!d->device->isOpen()) {
+        if (!d->device->open(access)) {
+            setErrorString(d->device->errorString());
+            return false;
+        }
+        d->closeDevice = true;
+    } else if (!(d->device->openMode() & access)) {
+        setErrorString(access == ReadOnly ? tr("The device is not readable")
+                                          : tr("The device is not writable"));
+        return false;
+    }
+
+    memset(&d->zstream, 0, sizeof(d->zstream));
+    int ret;
+    if (access == ReadOnly)
+        ret = inflateInit2(&d->zstream, d->windowBits());
+    else
+        ret = deflateInit2(&d->zstream, d->level, Z_DEFLATED, d->windowBits(), 8, Z_DEFAULT_STRATEGY);
+    if (ret != Z_OK) {
+        setErrorString(ret == Z_MEM_ERROR ? tr("Out of memory") : tr("Cannot initialize zlib"));
+        if (d->closeDevice)
+            d->device->close();
+        return false;
+    }
+
+    d->buffer = new char[CompressedBufferSize];
+    d->state = QCompressionDevicePrivate::Streaming;
+    d->outputPending = false;
+    return QIODevice::open(mode);
+}
+
+/*!
+    \reimp
+
+    When writing, the compressed stream is finished and the remaining
+    data is written to the device.
+*/
+void QCompressionDevice::close()
+{
+    Q_D(QCompressionDevice);
+    if (!isOpen())
+        return;
+
+    if (openMode() & WriteOnly) {
+        if (d->state == QCompressionDevicePrivate::Streaming)
+            d->deflateToDevice(Z_FINISH);
+        deflateEnd(&d->zstream);
+    } else {
+        inflateEnd(&d->zstream);
+    }
+    delete [] d->buffer;
+    d->buffer = 0;
+    d->state = QCompressionDevicePrivate::Closed;
+
+    if (d->closeDevice) {
+        d->device->close();
+        d->closeDevice = false;
+    }
+    QIODevice::close();
+}
+
+/*!
+    Writes all data that has been written to the QCompressionDevice so
+    far to the device, so that a reader can decompress it without
+    waiting for more data. Flushing often degrades compression.
+
+    Returns true if successful; otherwise returns false.
+*/
+bool QCompressionDevice::flush()
+{
+    Q_D(QCompressionDevice);
+    if (!(openMode() & WriteOnly) || d->state != QCompressionDevicePrivate::Streaming)
+        return false;
+    return d->deflateToDevice(Z_SYNC_FLUSH);
+}
+
+/*!
+    \reimp
+
+    Returns true if the end of the compressed stream has been reached,
+    or if no more compressed data can be read from the device.
+*/
+bool QCompressionDevice::atEnd() const
+{
+    Q_D(const QCompressionDevice);
+    if (!QIODevice::atEnd())
+        return false;
+    if (d->state != QCompressionDevicePrivate::Streaming)
+        return true;
+    return !d->outputPending && d->zstream.avail_in == 0 && d->device->atEnd();
+}
+
+/*!
+    \reimp
+*/
+bool QCompressionDevice::waitForReadyRead(int msecs)
+{
+    Q_D(QCompressionDevice);
+    if (!(openMode() & ReadOnly) || d->state != QCompressionDevicePrivate::Streaming)
+        return false;
+    if (d->outputPending || d->zstream.avail_in > 0)
+        return true;
+    return d->device->waitForReadyRead(msecs);
+}
+
+/*!
+    \reimp
+*/
+qint64 QCompressionDevice::readData(char *data, qint64 maxlen)
+{
+    Q_D(QCompressionDevice);
+    if (d->state == QCompressionDevicePrivate::Error)
+        return -1;
+
+    qint64 produced = 0;
+    while (produced < maxlen && d->state == QCompressionDevicePrivate::Streaming) {
+        if (d->zstream.avail_in == 0 && !d->outputPending) {
+            qint64 read = d->device->read(d->buffer, CompressedBufferSize);
+            if (read < 0) {
+                d->setError(d->device->errorString());
+                break;
+            }
+            if (read == 0) {
+                // more data may arrive later on a sequential device
+                if (!d->device->isSequential() && d->device->atEnd())
+                    d->setError(tr("Unexpected end of compressed data"));
+                break;
+            }
+            d->zstream.next_in = reinterpret_cast<Bytef *>(d->buffer);
+            d->zstream.avail_in = uInt(read);
+        }
+
+        uInt chunk = uInt(qMin(maxlen - produced, qint64(1) << 30));
+        d->zstream.next_out = reinterpret_cast<Bytef *>(data + produced);
+        d->zstream.avail_out = chunk;
+        int ret = inflate(&d->zstream, Z_NO_FLUSH);
+        produced += chunk - d->zstream.avail_out;
+        d->outputPending = (d->zstream.avail_out == 0);
+
+        if (ret == Z_STREAM_END) {
+            d->outputPending = false;
+            // gzip files may consist of several members
+            if (d->format == GzipFormat && (d->zstream.avail_in > 0 || !d->device->atEnd()))
+                inflateReset(&d->zstream);
+            else
+                d->state = QCompressionDevicePrivate::StreamEnd;
+        } else if (ret == Z_BUF_ERROR) {
+            // nothing was pending; more input is needed
+            d->outputPending = false;
+        } else if (ret != Z_OK) {
+            d->setError(d->zstream.msg ? QString::fromLatin1(d->zstream.msg)
+                                       : tr("Invalid compressed data"));
+        }
+    }
+
+    if (d->state == QCompressionDevicePrivate::Error && produced == 0)
+        return -1;
+    return produced;
+}
+
+/*!
+    \reimp
+*/
+qint64 QCompressionDevice::writeData(const char *data, qint64 len)
+{
+    Q_D(QCompressionDevice);
+    if (d->state != QCompressionDevicePrivate::Streaming)
+        return -1;
+
+    qint64 consumed = 0;
+    while (consumed < len) {
+        uInt chunk = uInt(qMin(len - consumed, qint64(1) << 30));
+        d->zstream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data + consumed));
+        d->zstream.avail_in = chunk;
+        if (!d->deflateToDevice(Z_NO_FLUSH))
+            return -1;
+        consumed += chunk;
+    }
+    return len;
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_COMPRESS
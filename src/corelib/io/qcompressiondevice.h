@@ -0,0 +1,75 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef QCOMPRESSIONDEVICE_H
+#define QCOMPRESSIONDEVICE_H
+
+#include <QtCore/qiodevice.h>
+
+QT_BEGIN_HEADER
+
+QT_BEGIN_NAMESPACE
+
+QT_MODULE(Core)
+
+#ifndef QT_NO_COMPRESS
+
+class QCompressionDevicePrivate;
+
+class Q_CORE_EXPORT QCompressionDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    enum Format {
+        ZlibFormat,
+        GzipFormat,
+        RawDeflateFormat
+    };
+
+    explicit QCompressionDevice(QIODevice *device, QObject *parent = 0);
+    QCompressionDevice(QIODevice *device, Format format, QObject *parent = 0);
+    ~QCompressionDevice();
+
+    QIODevice *device() const;
+
+    Format format() const;
+    void setFormat(Format format);
+
+    int compressionLevel() const;
+    void setCompressionLevel(int level);
+
+    bool isSequential() const;
+    bool open(OpenMode mode);
+    void close();
+    bool flush();
+
+    bool atEnd() const;
+    bool waitForReadyRead(int msecs);
+
+protected:
+    qint64 readData(char *data, qint64 maxlen);
+    qint64 writeData(const char *data, qint64 len);
+
+private:
+    Q_DECLARE_PRIVATE(QCompressionDevice)
+    Q_DISABLE_COPY(QCompressionDevice)
+};
+
+#endif // QT_NO_COMPRESS
+
+QT_END_NAMESPACE
+
+QT_END_HEADER
+
+#endif // QCOMPRESSIONDEVICE_H
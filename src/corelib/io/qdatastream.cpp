@@ -12,10 +12,12 @@
 ****************************************************************************/
 
 #include "qdatastream.h"
+#include "qdatastream_p.h"
 
 #ifndef QT_NO_DATASTREAM
 #include "qbuffer.h"
 #include "qstring.h"
+#include "private/qsimd_p.h"
 #include <stdio.h>
 #include <ctype.h>
 #include <stdlib.h>
@@ -184,6 +186,19 @@ QT_BEGIN_NAMESPACE
     data, followed by the data. Note that any encoding/decoding of
     the data (apart from the length quint32) must be done by you.
 
+    \target arrays
+    \section1 Reading and writing arrays
+
+    Arrays of integers and floating point numbers can be read and
+    written with readArray() and writeArray(). They use the same
+    format as reading and writing each value in turn, but access the
+    device once for the whole array, and convert the byte order of
+    many values at a time. readArray() reads directly into the storage
+    it is given, without copying the data.
+
+    The stream operators for QVector use them for vectors of these
+    types, and the stream operator that writes a QList does the same.
+
     \sa QTextStream QVariant
 */
 
@@ -1193,6 +1208,411 @@ int QDataStream::writeRawData(const char *s, int len)
     return dev->write(s, len);
 }
 
+/*****************************************************************************
+  QDataStream array functions
+ *****************************************************************************/
+
+static inline quint32 qt_swap32(quint32 x)
+{
+    return (x >> 24) | ((x >> 8) & 0xff00) | ((x << 8) & 0xff0000) | (x << 24);
+}
+
+static void qt_swap_array16_c(void *dst, const void *src, int count)
+{
+    const quint16 *s = static_cast<const quint16 *>(src);
+    quint16 *d = static_cast<quint16 *>(dst);
+    for (int i = 0; i < count; ++i)
+        d[i] = quint16((s[i] >> 8) | (s[i] << 8));
+}
+
+static void qt_swap_array32_c(void *dst, const void *src, int count)
+{
+    const quint32 *s = static_cast<const quint32 *>(src);
+    quint32 *d = static_cast<quint32 *>(dst);
+    for (int i = 0; i < count; ++i)
+        d[i] = qt_swap32(s[i]);
+}
+
+static void qt_swap_array64_c(void *dst, const void *src, int count)
+{
+    const quint64 *s = static_cast<const quint64 *>(src);
+    quint64 *d = static_cast<quint64 *>(dst);
+    for (int i = 0; i < count; ++i)
+        d[i] = (quint64(qt_swap32(quint32(s[i]))) << 32) | qt_swap32(quint32(s[i] >> 32));
+}
+
+static void qt_swap_array16_setup(void *dst, const void *src, int count);
+static void qt_swap_array32_setup(void *dst, const void *src, int count);
+static void qt_swap_array64_setup(void *dst, const void *src, int count);
+
+qt_swap_array_func qt_swap_array16 = qt_swap_array16_setup;
+qt_swap_array_func qt_swap_array32 = qt_swap_array32_setup;
+qt_swap_array_func qt_swap_array64 = qt_swap_array64_setup;
+
+static void qInitSwapKernels()
+{
+    uint features = qDetectCPUFeatures();
+    Q_UNUSED(features);
+
+#ifdef QT_HAVE_SSE2
+    if (features & SSE2) {
+        qt_swap_array16 = qt_swap_array16_sse2;
+        qt_swap_array32 = qt_swap_array32_sse2;
+        qt_swap_array64 = qt_swap_array64_sse2;
+        return;
+    }
+#endif
+    qt_swap_array16 = qt_swap_array16_c;
+    qt_swap_array32 = qt_swap_array32_c;
+    qt_swap_array64 = qt_swap_array64_c;
+}
+
+static void qt_swap_array16_setup(void *dst, const void *src, int count)
+{
+    qInitSwapKernels();
+    qt_swap_array16(dst, src, count);
+}
+
+static void qt_swap_array32_setup(void *dst, const void *src, int count)
+{
+    qInitSwapKernels();
+    qt_swap_array32(dst, src, count);
+}
+
+static void qt_swap_array64_setup(void *dst, const void *src, int count)
+{
+    qInitSwapKernels();
+    qt_swap_array64(dst, src, count);
+}
+
+static inline void qt_swap_array(void *dst, const void *src, int count, int size)
+{
+    switch (size) {
+    case 2:
+        qt_swap_array16(dst, src, count);
+        break;
+    case 4:
+        qt_swap_array32(dst, src, count);
+        break;
+    case 8:
+        qt_swap_array64(dst, src, count);
+        break;
+    default:
+        Q_ASSERT(size == 1);
+        break;
+    }
+}
+
+/*!
+    \internal
+
+    Reads \a count values of \a size bytes directly into \a data and
+    converts them to the host byte order in place. Values that could
+    not be read are set to 0. Returns false if the device ran out of
+    data.
+*/
+bool QDataStream::readSwapped(void *data, int count, int size)
+{
+    if (count <= 0)
+        return true;
+    char *p = static_cast<char *>(data);
+    const qint64 len = qint64(count) * size;
+    qint64 got = dev->read(p, len);
+    if (got < 0)
+        got = 0;
+
+    const int complete = int(got / size);
+    if (got != len)
+        memset(p + qint64(complete) * size, 0, len - qint64(complete) * size);
+    if (!noswap)
+        qt_swap_array(p, p, complete, size);
+
+    if (got != len) {
+        setStatus(ReadPastEnd);
+        return false;
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Writes \a count values of \a size bytes from \a data in the byte
+    order of the stream.
+*/
+void QDataStream::writeSwapped(const void *data, int count, int size)
+{
+    if (count <= 0)
+        return;
+    const char *p = static_cast<const char *>(data);
+    if (noswap || size == 1) {
+        dev->write(p, qint64(count) * size);
+        return;
+    }
+
+    // convert in blocks, so large arrays need no copy of their own size
+    quint64 buffer[2048];
+    const int blockCount = int(sizeof(buffer)) / size;
+    while (count > 0) {
+        const int n = qMin(count, blockCount);
+        qt_swap_array(buffer, p, n, size);
+        dev->write(reinterpret_cast<const char *>(buffer), n * size);
+        p += n * size;
+        count -= n;
+    }
+}
+
+/*!
+    \since 4.4
+
+    Reads \a count signed bytes from the stream into the preallocated
+    array \a data, and returns a reference to the stream.
+
+    If the stream runs out of data, the remaining values are set to 0
+    and the status is set to ReadPastEnd.
+
+    \sa {QDataStream#arrays}{Reading and writing arrays}, writeArray()
+*/
+QDataStream &QDataStream::readArray(qint8 *data, int count)
+{
+    CHECK_STREAM_PRECOND(*this)
+    readSwapped(data, count, sizeof(qint8));
+    return *this;
+}
+
+/*!
+    \fn QDataStream &QDataStream::readArray(quint8 *data, int count)
+    \since 4.4
+    \overload
+
+    Reads \a count unsigned bytes from the stream into \a data.
+*/
+
+/*!
+    \since 4.4
+    \overload
+
+    Reads \a count signed 16-bit integers from the stream into \a data.
+*/
+QDataStream &QDataStream::readArray(qint16 *data, int count)
+{
+    CHECK_STREAM_PRECOND(*this)
+    readSwapped(data, count, sizeof(qint16));
+    return *this;
+}
+
+/*!
+    \fn QDataStream &QDataStream::readArray(quint16 *data, int count)
+    \since 4.4
+    \overload
+
+    Reads \a count unsigned 16-bit integers from the stream into \a data.
+*/
+
+/*!
+    \since 4.4
+    \overload
+
+    Reads \a count signed 32-bit integers from the stream into \a data.
+*/
+QDataStream &QDataStream::readArray(qint32 *data, int count)
+{
+    CHECK_STREAM_PRECOND(*this)
+    readSwapped(data, count, sizeof(qint32));
+    return *this;
+}
+
+/*!
+    \fn QDataStream &QDataStream::readArray(quint32 *data, int count)
+    \since 4.4
+    \overload
+
+    Reads \a count unsigned 32-bit integers from the stream into \a data.
+*/
+
+/*!
+    \since 4.4
+    \overload
+
+    Reads \a count signed 64-bit integers from the stream into \a data.
+*/
+QDataStream &QDataStream::readArray(qint64 *data, int count)
+{
+    CHECK_STREAM_PRECOND(*this)
+    if (version() < 6) {
+        for (int i = 0; i < count; ++i)
+            *this >> data[i];
+    } else {
+        readSwapped(data, count, sizeof(qint64));
+    }
+    return *this;
+}
+
+/*!
+    \fn QDataStream &QDataStream::readArray(quint64 *data, int count)
+    \since 4.4
+    \overload
+
+    Reads \a count unsigned 64-bit integers from the stream into \a data.
+*/
+
+/*!
+    \since 4.4
+    \overload
+
+    Reads \a count 32-bit floating point numbers from the stream into
+    \a data.
+*/
+QDataStream &QDataStream::readArray(float *data, int count)
+{
+    CHECK_STREAM_PRECOND(*this)
+    readSwapped(data, count, sizeof(float));
+    return *this;
+}
+
+/*!
+    \since 4.4
+    \overload
+
+    Reads \a count 64-bit floating point numbers from the stream into
+    \a data.
+*/
+QDataStream &QDataStream::readArray(double *data, int count)
+{
+    CHECK_STREAM_PRECOND(*this)
+#ifndef Q_DOUBLE_FORMAT
+    readSwapped(data, count, sizeof(double));
+#else
+    for (int i = 0; i < count; ++i)
+        *this >> data[i];
+#endif
+    return *this;
+}
+
+/*!
+    \since 4.4
+
+    Writes the \a count signed bytes in \a data to the stream, and
+    returns a reference to the stream.
+
+    \sa {QDataStream#arrays}{Reading and writing arrays}, readArray()
+*/
+QDataStream &QDataStream::writeArray(const qint8 *data, int count)
+{
+    CHECK_STREAM_PRECOND(*this)
+    writeSwapped(data, count, sizeof(qint8));
+    return *this;
+}
+
+/*!
+    \fn QDataStream &QDataStream::writeArray(const quint8 *data, int count)
+    \since 4.4
+    \overload
+
+    Writes the \a count unsigned bytes in \a data to the stream.
+*/
+
+/*!
+    \since 4.4
+    \overload
+
+    Writes the \a count signed 16-bit integers in \a data to the stream.
+*/
+QDataStream &QDataStream::writeArray(const qint16 *data, int count)
+{
+    CHECK_STREAM_PRECOND(*this)
+    writeSwapped(data, count, sizeof(qint16));
+    return *this;
+}
+
+/*!
+    \fn QDataStream &QDataStream::writeArray(const quint16 *data, int count)
+    \since 4.4
+    \overload
+
+    Writes the \a count unsigned 16-bit integers in \a data to the stream.
+*/
+
+/*!
+    \since 4.4
+    \overload
+
+    Writes the \a count signed 32-bit integers in \a data to the stream.
+*/
+QDataStream &QDataStream::writeArray(const qint32 *data, int count)
+{
+    CHECK_STREAM_PRECOND(*this)
+    writeSwapped(data, count, sizeof(qint32));
+    return *this;
+}
+
+/*!
+    \fn QDataStream &QDataStream::writeArray(const quint32 *data, int count)
+    \since 4.4
+    \overload
+
+    Writes the \a count unsigned 32-bit integers in \a data to the stream.
+*/
+
+/*!
+    \since 4.4
+    \overload
+
+    Writes the \a count signed 64-bit integers in \a data to the stream.
+*/
+QDataStream &QDataStream::writeArray(const qint64 *data, int count)
+{
+    CHECK_STREAM_PRECOND(*this)
+    if (version() < 6) {
+        for (int i = 0; i < count; ++i)
+            *this << data[i];
+    } else {
+        writeSwapped(data, count, sizeof(qint64));
+    }
+    return *this;
+}
+
+/*!
+    \fn QDataStream &QDataStream::writeArray(const quint64 *data, int count)
+    \since 4.4
+    \overload
+
+    Writes the \a count unsigned 64-bit integers in \a data to the stream.
+*/
+
+/*!
+    \since 4.4
+    \overload
+
+    Writes the \a count 32-bit floating point numbers in \a data to
+    the stream.
+*/
+QDataStream &QDataStream::writeArray(const float *data, int count)
+{
+    CHECK_STREAM_PRECOND(*this)
+    writeSwapped(data, count, sizeof(float));
+    return *this;
+}
+
+/*!
+    \since 4.4
+    \overload
+
+    Writes the \a count 64-bit floating point numbers in \a data to
+    the stream.
+*/
+QDataStream &QDataStream::writeArray(const double *data, int count)
+{
+    CHECK_STREAM_PRECOND(*this)
+#ifndef Q_DOUBLE_FORMAT
+    writeSwapped(data, count, sizeof(double));
+#else
+    for (int i = 0; i < count; ++i)
+        *this << data[i];
+#endif
+    return *this;
+}
+
 /*!
     \since 4.1
 
@@ -132,6 +132,28 @@ public:
     QDataStream &writeBytes(const char *, uint len);
     int writeRawData(const char *, int len);
 
+    QDataStream &readArray(qint8 *data, int count);
+    QDataStream &readArray(quint8 *data, int count);
+    QDataStream &readArray(qint16 *data, int count);
+    QDataStream &readArray(quint16 *data, int count);
+    QDataStream &readArray(qint32 *data, int count);
+    QDataStream &readArray(quint32 *data, int count);
+    QDataStream &readArray(qint64 *data, int count);
+    QDataStream &readArray(quint64 *data, int count);
+    QDataStream &readArray(float *data, int count);
+    QDataStream &readArray(double *data, int count);
+
+    QDataStream &writeArray(const qint8 *data, int count);
+    QDataStream &writeArray(const quint8 *data, int count);
+    QDataStream &writeArray(const qint16 *data, int count);
+    QDataStream &writeArray(const quint16 *data, int count);
+    QDataStream &writeArray(const qint32 *data, int count);
+    QDataStream &writeArray(const quint32 *data, int count);
+    QDataStream &writeArray(const qint64 *data, int count);
+    QDataStream &writeArray(const quint64 *data, int count);
+    QDataStream &writeArray(const float *data, int count);
+    QDataStream &writeArray(const double *data, int count);
+
     int skipRawData(int len);
 
 #ifdef QT3_SUPPORT
@@ -146,6 +168,9 @@ public:
 private:
     Q_DISABLE_COPY(QDataStream)
 
+    bool readSwapped(void *data, int count, int size);
+    void writeSwapped(const void *data, int count, int size);
+
     QDataStreamPrivate *d;
 
     QIODevice *dev;
@@ -197,6 +222,96 @@ inline QDataStream &QDataStream::operator<<(quint32 i)
 inline QDataStream &QDataStream::operator<<(quint64 i)
 { return *this << qint64(i); }
 
+inline QDataStream &QDataStream::readArray(quint8 *data, int count)
+{ return readArray(reinterpret_cast<qint8 *>(data), count); }
+
+inline QDataStream &QDataStream::readArray(quint16 *data, int count)
+{ return readArray(reinterpret_cast<qint16 *>(data), count); }
+
+inline QDataStream &QDataStream::readArray(quint32 *data, int count)
+{ return readArray(reinterpret_cast<qint32 *>(data), count); }
+
+inline QDataStream &QDataStream::readArray(quint64 *data, int count)
+{ return readArray(reinterpret_cast<qint64 *>(data), count); }
+
+inline QDataStream &QDataStream::writeArray(const quint8 *data, int count)
+{ return writeArray(reinterpret_cast<const qint8 *>(data), count); }
+
+inline QDataStream &QDataStream::writeArray(const quint16 *data, int count)
+{ return writeArray(reinterpret_cast<const qint16 *>(data), count); }
+
+inline QDataStream &QDataStream::writeArray(const quint32 *data, int count)
+{ return writeArray(reinterpret_cast<const qint32 *>(data), count); }
+
+inline QDataStream &QDataStream::writeArray(const quint64 *data, int count)
+{ return writeArray(reinterpret_cast<const qint64 *>(data), count); }
+
+/*
+    Containers of the types that QDataStream can read and write as
+    arrays are serialized with a single readArray() or writeArray()
+    call instead of one call per element. The format is the same.
+*/
+template <typename T>
+struct QDataStreamArrayType { enum { Defined = false }; };
+
+#define Q_DATASTREAM_ARRAY_TYPE(TYPE) \
+template <> struct QDataStreamArrayType<TYPE> { enum { Defined = true }; };
+
+Q_DATASTREAM_ARRAY_TYPE(qint8)
+Q_DATASTREAM_ARRAY_TYPE(quint8)
+Q_DATASTREAM_ARRAY_TYPE(qint16)
+Q_DATASTREAM_ARRAY_TYPE(quint16)
+Q_DATASTREAM_ARRAY_TYPE(qint32)
+Q_DATASTREAM_ARRAY_TYPE(quint32)
+Q_DATASTREAM_ARRAY_TYPE(qint64)
+Q_DATASTREAM_ARRAY_TYPE(quint64)
+Q_DATASTREAM_ARRAY_TYPE(float)
+Q_DATASTREAM_ARRAY_TYPE(double)
+
+#undef Q_DATASTREAM_ARRAY_TYPE
+
+template <typename T, bool IsArrayType = QDataStreamArrayType<T>::Defined>
+struct QDataStreamArray
+{
+    static void read(QDataStream &s, T *data, int count)
+    {
+        for (int i = 0; i < count; ++i)
+            s >> data[i];
+    }
+    static void write(QDataStream &s, const T *data, int count)
+    {
+        for (int i = 0; i < count; ++i)
+            s << data[i];
+    }
+    static void write(QDataStream &s, const QList<T> &l)
+    {
+        for (int i = 0; i < l.size(); ++i)
+            s << l.at(i);
+    }
+};
+
+template <typename T>
+struct QDataStreamArray<T, true>
+{
+    enum { BufferSize = 1024 };
+
+    static void read(QDataStream &s, T *data, int count)
+    { s.readArray(data, count); }
+    static void write(QDataStream &s, const T *data, int count)
+    { s.writeArray(data, count); }
+    static void write(QDataStream &s, const QList<T> &l)
+    {
+        // QList does not store its elements contiguously
+        T buffer[BufferSize];
+        for (int i = 0; i < l.size(); i += BufferSize) {
+            const int count = qMin(l.size() - i, int(BufferSize));
+            for (int j = 0; j < count; ++j)
+                buffer[j] = l.at(i + j);
+            s.writeArray(buffer, count);
+        }
+    }
+};
+
 template <typename T>
 QDataStream& operator>>(QDataStream& s, QList<T>& l)
 {
@@ -218,8 +333,7 @@ template <typename T>
 QDataStream& operator<<(QDataStream& s, const QList<T>& l)
 {
     s << quint32(l.size());
-    for (int i = 0; i < l.size(); ++i)
-        s << l.at(i);
+    QDataStreamArray<T>::write(s, l);
     return s;
 }
 
@@ -257,11 +371,7 @@ QDataStream& operator>>(QDataStream& s, QVector<T>& v)
     quint32 c;
     s >> c;
     v.resize(c);
-    for(quint32 i = 0; i < c; ++i) {
-        T t;
-        s >> t;
-        v[i] = t;
-    }
+    QDataStreamArray<T>::read(s, v.data(), c);
     return s;
 }
 
@@ -269,8 +379,7 @@ template<typename T>
 QDataStream& operator<<(QDataStream& s, const QVector<T>& v)
 {
     s << quint32(v.size());
-    for (typename QVector<T>::const_iterator it = v.begin(); it != v.end(); ++it)
-        s << *it;
+    QDataStreamArray<T>::write(s, v.constData(), v.size());
     return s;
 }
 
@@ -0,0 +1,56 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef QDATASTREAM_P_H
+#define QDATASTREAM_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Byte order conversion kernels used by QDataStream::readArray() and
+    writeArray(). They are resolved on first use to the fastest version
+    the processor supports.
+
+    qt_swap_array16, qt_swap_array32 and qt_swap_array64 reverse the
+    bytes of count 16, 32 and 64-bit values from src and store them in
+    dst. src and dst may be the same array, but must not otherwise
+    overlap.
+*/
+typedef void (*qt_swap_array_func)(void *dst, const void *src, int count);
+
+extern qt_swap_array_func qt_swap_array16;
+extern qt_swap_array_func qt_swap_array32;
+extern qt_swap_array_func qt_swap_array64;
+
+#ifdef QT_HAVE_SSE2
+void qt_swap_array16_sse2(void *dst, const void *src, int count);
+void qt_swap_array32_sse2(void *dst, const void *src, int count);
+void qt_swap_array64_sse2(void *dst, const void *src, int count);
+#endif
+
+QT_END_NAMESPACE
+
+#endif // QDATASTREAM_P_H
@@ -0,0 +1,80 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "qdatastream_p.h"
+
+#ifdef QT_HAVE_SSE2
+
+#include <emmintrin.h>
+
+QT_BEGIN_NAMESPACE
+
+// swaps the bytes of each 16-bit lane
+static inline __m128i swapPairs(__m128i v)
+{
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+void qt_swap_array16_sse2(void *dst, const void *src, int count)
+{
+    const quint16 *s = static_cast<const quint16 *>(src);
+    quint16 *d = static_cast<quint16 *>(dst);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(d + i), swapPairs(v));
+    }
+    for (; i < count; ++i)
+        d[i] = quint16((s[i] >> 8) | (s[i] << 8));
+}
+
+void qt_swap_array32_sse2(void *dst, const void *src, int count)
+{
+    const quint32 *s = static_cast<const quint32 *>(src);
+    quint32 *d = static_cast<quint32 *>(dst);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(d + i), swapPairs(v));
+    }
+    for (; i < count; ++i) {
+        const quint32 x = s[i];
+        d[i] = (x >> 24) | ((x >> 8) & 0xff00) | ((x << 8) & 0xff0000) | (x << 24);
+    }
+}
+
+void qt_swap_array64_sse2(void *dst, const void *src, int count)
+{
+    const quint64 *s = static_cast<const quint64 *>(src);
+    quint64 *d = static_cast<quint64 *>(dst);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(d + i), swapPairs(v));
+    }
+    for (; i < count; ++i) {
+        const quint32 lo = quint32(s[i]);
+        const quint32 hi = quint32(s[i] >> 32);
+        const quint32 swappedLo = (lo >> 24) | ((lo >> 8) & 0xff00) | ((lo << 8) & 0xff0000) | (lo << 24);
+        const quint32 swappedHi = (hi >> 24) | ((hi >> 8) & 0xff00) | ((hi << 8) & 0xff0000) | (hi << 24);
+        d[i] = (quint64(swappedLo) << 32) | swappedHi;
+    }
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_HAVE_SSE2
@@ -70,6 +70,18 @@
     enables iterating through all subdirectories of the assigned path,
     following all symbolic links. Symbolic link loops (e.g., "link" => "." or
     "link" => "..") are automatically detected and ignored.
+
+    \value ParallelIteration When combined with Subdirectories, this flag
+    lists the subdirectories in the threads of the global QThreadPool,
+    ahead of the iteration. The entries are returned in the same order as
+    without this flag. This speeds up iterating large directory trees,
+    especially on network file systems. This flag was introduced in Qt 4.4.
+
+    \value UnorderedIteration When combined with ParallelIteration, the
+    entries of each directory are returned as soon as the directory has
+    been listed, instead of in depth-first order. The entries of a
+    directory are still returned together. This flag was introduced in
+    Qt 4.4.
 */
 
 #include "qdiriterator.h"
@@ -79,9 +91,39 @@
 #include <QtCore/qset.h>
 #include <QtCore/qstack.h>
 #include <QtCore/qvariant.h>
+#ifndef QT_NO_THREAD
+#include <QtCore/qmutex.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qwaitcondition.h>
+#endif
 
 QT_BEGIN_NAMESPACE
 
+/*
+    Implements the filtering of QDir::Filters and name filters. The
+    name filters are compiled once, and each thread that lists
+    directories uses its own QDirIteratorFilter.
+*/
+class QDirIteratorFilter
+{
+public:
+    QDirIteratorFilter(QDir::Filters filters, const QStringList &nameFilters);
+
+    bool matches(const QString &fileName, const QFileInfo &fi, uint knownType) const;
+
+private:
+    QDir::Filters filters;
+#ifndef QT_NO_REGEXP
+    QList<QRegExp> regexps;
+#endif
+};
+
+#ifndef QT_NO_THREAD
+class QDirIteratorParallel;
+#endif
+
 class QDirIteratorPrivate
 {
 public:
@@ -94,6 +136,14 @@ public:
     void advance();
     bool matchesFilters(const QAbstractFileEngineIterator *it) const;
 
+    static QAbstractFileEngineIterator *beginEntryList(QAbstractFileEngine *engine,
+                                                       const QString &path,
+                                                       const QStringList &nameFilters,
+                                                       QDir::Filters filters);
+    static uint knownFileType(const QAbstractFileEngineIterator *it);
+    static bool isFollowableDirectory(const QFileInfo &fi, uint knownType,
+                                      QDirIterator::IteratorFlags flags);
+
     QSet<QString> visitedLinks;
     QAbstractFileEngine *engine;
     QStack<QAbstractFileEngineIterator *> fileEngineIterators;
@@ -103,19 +153,433 @@ public:
     QDirIterator::IteratorFlags iteratorFlags;
     QDir::Filters filters;
     QStringList nameFilters;
+    QDirIteratorFilter filter;
     bool followNextDir;
     bool first;
     bool done;
+#ifndef QT_NO_THREAD
+    QDirIteratorParallel *parallel;
+    QString nextFilePath;
+#endif
 
     QDirIterator *q;
 };
 
+/*!
+    \internal
+*/
+QDirIteratorFilter::QDirIteratorFilter(QDir::Filters filters, const QStringList &nameFilters)
+    : filters(filters == QDir::NoFilter ? QDir::AllEntries : filters)
+{
+#ifndef QT_NO_REGEXP
+    // Prepare name filters
+    bool hasNameFilters = !nameFilters.isEmpty() && !(nameFilters.contains(QLatin1String("*")));
+    if (hasNameFilters) {
+        for (int i = 0; i < nameFilters.size(); ++i) {
+            regexps << QRegExp(nameFilters.at(i),
+                               (filters & QDir::CaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive,
+                               QRegExp::Wildcard);
+        }
+    }
+#else
+    Q_UNUSED(nameFilters);
+#endif
+}
+
+/*!
+    \internal
+
+    This convenience function implements the iterator's filtering logics and
+    applies then to the directory entry \a fileName, with the file info \a
+    fi.
+
+    If \a knownType is not 0, it holds the type flags of the entry, as
+    returned by QDirIteratorPrivate::knownFileType(), and \a fi is only
+    used for the checks that need more than the type of the entry.
+
+    It returns true if the current entry matches the filters (i.e., the
+    current entry will be returned as part of the directory iteration);
+    otherwise, false is returned.
+*/
+bool QDirIteratorFilter::matches(const QString &fileName, const QFileInfo &fi,
+                                 uint knownType) const
+{
+    const bool filterPermissions = ((filters & QDir::PermissionMask)
+                                    && (filters & QDir::PermissionMask) != QDir::PermissionMask);
+    const bool skipDirs     = !(filters & (QDir::Dirs | QDir::AllDirs));
+    const bool skipFiles    = !(filters & QDir::Files);
+    const bool skipSymlinks = (filters & QDir::NoSymLinks);
+    const bool doReadable   = !filterPermissions || (filters & QDir::Readable);
+    const bool doWritable   = !filterPermissions || (filters & QDir::Writable);
+    const bool doExecutable = !filterPermissions || (filters & QDir::Executable);
+    const bool includeHidden = (filters & QDir::Hidden);
+    const bool includeSystem = (filters & QDir::System);
+
+    if (fileName.isEmpty()) {
+        // invalid entry
+        return false;
+    }
+
+    // symbolic links are never of a known type
+    const bool isDir = knownType ? (knownType & QAbstractFileEngine::DirectoryType) : fi.isDir();
+    const bool isFile = knownType ? (knownType & QAbstractFileEngine::FileType) : fi.isFile();
+    const bool exists = knownType ? true : fi.exists();
+
+#ifndef QT_NO_REGEXP
+    // Pass all entries through name filters, except dirs if the AllDirs
+    // filter is passed.
+    if (!regexps.isEmpty() && !((filters & QDir::AllDirs) && isDir)) {
+        bool matched = false;
+        for (int i = 0; i < regexps.size(); ++i) {
+            if (regexps.at(i).exactMatch(fileName)) {
+                matched = true;
+                break;
+            }
+        }
+        if (!matched)
+            return false;
+    }
+#endif
+
+    bool dotOrDotDot = (fileName == QLatin1String(".") || fileName == QLatin1String(".."));
+    if ((filters & QDir::NoDotAndDotDot) && dotOrDotDot)
+        return false;
+
+    bool isHidden = !dotOrDotDot
+                    && (knownType ? (knownType & QAbstractFileEngine::HiddenFlag) : fi.isHidden());
+    if (!includeHidden && isHidden)
+        return false;
+
+    bool alwaysShow = (filters & QDir::TypeMask) == 0
+        && ((isHidden && includeHidden)
+            || (includeSystem && ((exists && !isFile && !isDir && (knownType || !fi.isSymLink()))
+                                  || (!exists && fi.isSymLink()))));
+
+    // Skip files and directories
+    if ((filters & QDir::AllDirs) == 0 && skipDirs && isDir) {
+        if (!alwaysShow)
+            return false;
+    }
+
+    if ((skipFiles && (isFile || !exists))
+        || (skipSymlinks && !knownType && fi.isSymLink())) {
+        if (!alwaysShow)
+            return false;
+    }
+
+    if (filterPermissions
+        && ((doReadable && !fi.isReadable())
+            || (doWritable && !fi.isWritable())
+            || (doExecutable && !fi.isExecutable()))) {
+        return false;
+    }
+
+    if (!includeSystem && !dotOrDotDot
+        && ((exists && !isFile && !isDir && (knownType || !fi.isSymLink()))
+            || (!exists && fi.isSymLink()))) {
+        return false;
+    }
+
+    return true;
+}
+
+#ifndef QT_NO_THREAD
+struct QDirIteratorNode;
+
+struct QDirIteratorEntry
+{
+    inline QDirIteratorEntry() : subDirectory(0) { }
+
+    QString filePath;
+    QFileInfo fileInfo;
+    QDirIteratorNode *subDirectory; // listed after this entry in ordered mode
+};
+
+// A directory that is listed by a worker thread or by the iterator itself.
+struct QDirIteratorNode
+{
+    enum State { Pending, Listing, Listed };
+
+    inline QDirIteratorNode(const QString &path)
+        : path(path), state(Pending), nextEntry(0) { }
+
+    QString path;
+    State state;
+    QList<QDirIteratorEntry> entries;
+    int nextEntry;
+};
+
+/*
+    Lists the directories of a ParallelIteration in the global thread
+    pool. Every directory is listed as a whole, and its subdirectories
+    are queued for listing as soon as they have been found. At most
+    MaxBufferedEntries entries are listed ahead of the iterator; if
+    the iterator needs a directory that no thread has started on, it
+    lists that directory itself.
+
+    In ordered mode, the iterator walks the directories depth-first,
+    just like the sequential iteration. In unordered mode, it returns
+    the entries of the directories in the order their listings are
+    finished.
+*/
+class QDirIteratorParallel
+{
+public:
+    enum { MaxBufferedEntries = 16384 };
+
+    QDirIteratorParallel(QDirIteratorPrivate *d);
+    ~QDirIteratorParallel();
+
+    bool next(QDirIteratorEntry *entry);
+    void list(QDirIteratorNode *node);
+
+private:
+    QDirIteratorNode *newNode(const QString &path);
+    void startPendingNodes();
+    void listPendingNode(QDirIteratorNode *node);
+
+    QDirIteratorPrivate *d;
+    bool ordered;
+
+    QMutex mutex;
+    QWaitCondition listed;
+    QList<QDirIteratorNode *> nodes;
+    QQueue<QDirIteratorNode *> pendingNodes;
+    QStack<QDirIteratorNode *> stack;
+    QQueue<QDirIteratorEntry> results;
+    int runningJobs;
+    int bufferedEntries;
+    bool stopped;
+};
+
+class QDirIteratorJob : public QRunnable
+{
+public:
+    inline QDirIteratorJob(QDirIteratorParallel *parallel, QDirIteratorNode *node)
+        : parallel(parallel), node(node) { }
+
+    void run() { parallel->list(node); }
+
+private:
+    QDirIteratorParallel *parallel;
+    QDirIteratorNode *node;
+};
+
+QDirIteratorParallel::QDirIteratorParallel(QDirIteratorPrivate *d)
+    : d(d), ordered(!(d->iteratorFlags & QDirIterator::UnorderedIteration)),
+      runningJobs(0), bufferedEntries(0), stopped(false)
+{
+    QMutexLocker locker(&mutex);
+    QString rootPath = d->fileInfo.isSymLink() ? d->fileInfo.canonicalFilePath() : d->path;
+    if (d->iteratorFlags & QDirIterator::FollowSymlinks)
+        d->visitedLinks << d->fileInfo.canonicalFilePath();
+    QDirIteratorNode *root = newNode(rootPath);
+    if (ordered)
+        stack.push(root);
+    startPendingNodes();
+}
+
+QDirIteratorParallel::~QDirIteratorParallel()
+{
+    QMutexLocker locker(&mutex);
+    stopped = true;
+    while (runningJobs > 0)
+        listed.wait(&mutex);
+    qDeleteAll(nodes);
+}
+
+/*!
+    \internal
+
+    Creates a node for the directory \a path and queues it for
+    listing. The mutex must be locked.
+*/
+QDirIteratorNode *QDirIteratorParallel::newNode(const QString &path)
+{
+    QDirIteratorNode *node = new QDirIteratorNode(path);
+    nodes << node;
+    pendingNodes.enqueue(node);
+    return node;
+}
+
+/*!
+    \internal
+
+    Hands queued directories to the thread pool while there are idle
+    threads and the iterator isn't too far behind. The mutex must be
+    locked.
+*/
+void QDirIteratorParallel::startPendingNodes()
+{
+    QThreadPool *pool = QThreadPool::globalInstance();
+    while (!stopped && !pendingNodes.isEmpty() && runningJobs < pool->maxThreadCount()
+           && bufferedEntries < MaxBufferedEntries) {
+        QDirIteratorNode *node = pendingNodes.dequeue();
+        if (node->state != QDirIteratorNode::Pending)
+            continue; // the iterator has listed it already
+        node->state = QDirIteratorNode::Listing;
+        ++runningJobs;
+        pool->start(new QDirIteratorJob(this, node));
+    }
+}
+
+/*!
+    \internal
+
+    Lists the pending \a node in the calling thread. The mutex must be
+    locked; it is unlocked while listing.
+*/
+void QDirIteratorParallel::listPendingNode(QDirIteratorNode *node)
+{
+    node->state = QDirIteratorNode::Listing;
+    ++runningJobs;
+    mutex.unlock();
+    list(node);
+    mutex.lock();
+}
+
+/*!
+    \internal
+
+    Lists the directory of \a node. Called without holding the mutex,
+    usually in a thread of the pool.
+*/
+void QDirIteratorParallel::list(QDirIteratorNode *node)
+{
+    QList<QDirIteratorEntry> entries;
+    QStringList subDirectories;
+    QList<int> subDirectoryEntries;
+
+    QDirIteratorFilter filter(d->filters, d->nameFilters);
+    const bool recurse = (d->iteratorFlags & QDirIterator::Subdirectories);
+    const bool followSymlinks = (d->iteratorFlags & QDirIterator::FollowSymlinks);
+
+    QAbstractFileEngine *engine = QAbstractFileEngine::create(node->path);
+    QAbstractFileEngineIterator *it = QDirIteratorPrivate::beginEntryList(engine, node->path,
+                                                                          d->nameFilters, d->filters);
+    if (it) {
+        while (!stopped && it->hasNext()) {
+            it->next();
+            QFileInfo fi = it->currentFileInfo();
+            uint type = QDirIteratorPrivate::knownFileType(it);
+            if (!filter.matches(it->currentFileName(), fi, type))
+                continue;
+
+            QDirIteratorEntry entry;
+            entry.filePath = it->currentFilePath();
+            entry.fileInfo = fi;
+            if (recurse && QDirIteratorPrivate::isFollowableDirectory(fi, type, d->iteratorFlags)) {
+                QString subDir = entry.filePath;
+#ifdef Q_OS_WIN
+                if (fi.isSymLink())
+                    subDir = fi.canonicalFilePath();
+#endif
+                subDirectories << subDir;
+                subDirectoryEntries << entries.size();
+            }
+            entries << entry;
+        }
+        delete it;
+    }
+    delete engine;
+
+    /*
+        With FollowSymlinks, the visited directories are tracked by
+        their canonical path to stop link loops.
+    */
+    QStringList canonicalPaths;
+    if (followSymlinks) {
+        for (int i = 0; i < subDirectories.size(); ++i)
+            canonicalPaths << entries.at(subDirectoryEntries.at(i)).fileInfo.canonicalFilePath();
+    }
+
+    QMutexLocker locker(&mutex);
+    for (int i = 0; i < subDirectories.size(); ++i) {
+        if (followSymlinks) {
+            if (d->visitedLinks.contains(canonicalPaths.at(i)))
+                continue;
+            d->visitedLinks << canonicalPaths.at(i);
+        }
+        QDirIteratorNode *subNode = newNode(subDirectories.at(i));
+        if (ordered)
+            entries[subDirectoryEntries.at(i)].subDirectory = subNode;
+    }
+
+    bufferedEntries += entries.size();
+    if (ordered)
+        node->entries = entries;
+    else
+        results += entries;
+    node->state = QDirIteratorNode::Listed;
+    --runningJobs;
+    startPendingNodes();
+    listed.wakeAll();
+}
+
+/*!
+    \internal
+
+    Fetches the next entry into \a entry. Returns false at the end of
+    the iteration.
+*/
+bool QDirIteratorParallel::next(QDirIteratorEntry *entry)
+{
+    QMutexLocker locker(&mutex);
+    if (ordered) {
+        while (!stack.isEmpty()) {
+            QDirIteratorNode *node = stack.top();
+            while (node->state != QDirIteratorNode::Listed) {
+                if (node->state == QDirIteratorNode::Pending)
+                    listPendingNode(node);
+                else
+                    listed.wait(&mutex);
+            }
+
+            if (node->nextEntry < node->entries.size()) {
+                *entry = node->entries.at(node->nextEntry++);
+                --bufferedEntries;
+                if (entry->subDirectory)
+                    stack.push(entry->subDirectory);
+                startPendingNodes();
+                return true;
+            }
+
+            node->entries.clear();
+            stack.pop();
+        }
+        return false;
+    }
+
+    while (results.isEmpty()) {
+        if (runningJobs == 0 && pendingNodes.isEmpty())
+            return false;
+        QDirIteratorNode *node = pendingNodes.isEmpty() ? 0 : pendingNodes.head();
+        if (runningJobs == 0 && node) {
+            // the buffer is full, but there is nothing left to return
+            pendingNodes.dequeue();
+            if (node->state == QDirIteratorNode::Pending)
+                listPendingNode(node);
+        } else {
+            listed.wait(&mutex);
+        }
+    }
+    *entry = results.dequeue();
+    --bufferedEntries;
+    startPendingNodes();
+    return true;
+}
+#endif // QT_NO_THREAD
+
 /*!
     \internal
 */
 QDirIteratorPrivate::QDirIteratorPrivate(const QString &path, const QStringList &nameFilters,
                                          QDir::Filters filters, QDirIterator::IteratorFlags flags)
-    : engine(0), path(path), iteratorFlags(flags), followNextDir(false), first(true), done(false)
+    : engine(0), path(path), iteratorFlags(flags), filter(filters, nameFilters),
+      followNextDir(false), first(true), done(false)
+#ifndef QT_NO_THREAD
+      , parallel(0)
+#endif
 {
     if (filters == QDir::NoFilter)
         filters = QDir::AllEntries;
@@ -123,6 +587,12 @@ QDirIteratorPrivate::QDirIteratorPrivate(const QString &path, const QStringList
     this->nameFilters = nameFilters;
 
     fileInfo.setFile(path);
+#ifndef QT_NO_THREAD
+    if ((flags & QDirIterator::ParallelIteration) && (flags & QDirIterator::Subdirectories)) {
+        parallel = new QDirIteratorParallel(this);
+        return;
+    }
+#endif
     pushSubDirectory(fileInfo.isSymLink() ? fileInfo.canonicalFilePath() : path,
                      nameFilters, filters);
 }
@@ -132,6 +602,9 @@ QDirIteratorPrivate::QDirIteratorPrivate(const QString &path, const QStringList
 */
 QDirIteratorPrivate::~QDirIteratorPrivate()
 {
+#ifndef QT_NO_THREAD
+    delete parallel;
+#endif
     delete engine;
 }
 
@@ -150,12 +623,11 @@ void QDirIteratorPrivate::pushSubDirectory(const QString &path, const QStringLis
             visitedLinks << fileInfo.absoluteFilePath();
         }
     }
-    
+
     if (engine || (engine = QAbstractFileEngine::create(this->path))) {
         engine->setFileName(path);
-        QAbstractFileEngineIterator *it = engine->beginEntryList(filters, nameFilters);
+        QAbstractFileEngineIterator *it = beginEntryList(engine, path, nameFilters, filters);
         if (it) {
-            it->setPath(path);
             fileEngineIterators << it;
         } else {
             // No iterator; no entry list.
@@ -168,6 +640,20 @@ void QDirIteratorPrivate::pushSubDirectory(const QString &path, const QStringLis
 */
 void QDirIteratorPrivate::advance()
 {
+#ifndef QT_NO_THREAD
+    if (parallel) {
+        QDirIteratorEntry entry;
+        currentFilePath = nextFilePath;
+        if (parallel->next(&entry)) {
+            nextFilePath = entry.filePath;
+            fileInfo = entry.fileInfo;
+        } else {
+            done = true;
+        }
+        return;
+    }
+#endif
+
     // Store the current entry
     if (!fileEngineIterators.isEmpty())
         currentFilePath = fileEngineIterators.top()->currentFilePath();
@@ -222,24 +708,11 @@ void QDirIteratorPrivate::advance()
             break;
 
         // Subdirectory iteration.
-        QString filePath = fileInfo.filePath();
-
-        // Never follow . and ..
-        if (fileInfo.fileName() == QLatin1String(".") || fileInfo.fileName() == QLatin1String(".."))
+        if (!isFollowableDirectory(fileInfo, knownFileType(it), iteratorFlags))
             break;
 
-        // Never follow non-directory entries
-        if (!fileInfo.isDir())
-            break;
-      
-        // Check symlinks
-        if (fileInfo.isSymLink() && !(iteratorFlags & QDirIterator::FollowSymlinks)) {
-            // Follow symlinks only if FollowSymlinks was passed
-            break;
-        }
-
         // Stop link loops
-        if (visitedLinks.contains(fileInfo.canonicalFilePath()))
+        if (!visitedLinks.isEmpty() && visitedLinks.contains(fileInfo.canonicalFilePath()))
             break;
 
         // Signal that we want to follow this entry.
@@ -254,102 +727,69 @@ void QDirIteratorPrivate::advance()
 /*!
     \internal
 
-    This convenience function implements the iterator's filtering logics and
-    applies then to the current directory entry.
+    Returns an iterator for the entries of \a path, which \a engine
+    must refer to, or 0 if \a engine cannot list entries.
+*/
+QAbstractFileEngineIterator *QDirIteratorPrivate::beginEntryList(QAbstractFileEngine *engine,
+                                                                 const QString &path,
+                                                                 const QStringList &nameFilters,
+                                                                 QDir::Filters filters)
+{
+    QAbstractFileEngineIterator *it = engine->beginEntryList(filters, nameFilters);
+    if (it)
+        it->setPath(path);
+    return it;
+}
 
-    It returns true if the current entry matches the filters (i.e., the
-    current entry will be returned as part of the directory iteration);
-    otherwise, false is returned.
+/*!
+    \internal
+
+    Returns true if the current entry of \a it matches the filters.
 */
 bool QDirIteratorPrivate::matchesFilters(const QAbstractFileEngineIterator *it) const
 {
-    const bool filterPermissions = ((filters & QDir::PermissionMask)
-                                    && (filters & QDir::PermissionMask) != QDir::PermissionMask);
-    const bool skipDirs     = !(filters & (QDir::Dirs | QDir::AllDirs));
-    const bool skipFiles    = !(filters & QDir::Files);
-    const bool skipSymlinks = (filters & QDir::NoSymLinks);
-    const bool doReadable   = !filterPermissions || (filters & QDir::Readable);
-    const bool doWritable   = !filterPermissions || (filters & QDir::Writable);
-    const bool doExecutable = !filterPermissions || (filters & QDir::Executable);
-    const bool includeHidden = (filters & QDir::Hidden);
-    const bool includeSystem = (filters & QDir::System);
-
-#ifndef QT_NO_REGEXP
-    // Prepare name filters
-    QList<QRegExp> regexps;
-    bool hasNameFilters = !nameFilters.isEmpty() && !(nameFilters.contains(QLatin1String("*")));
-    if (hasNameFilters) {
-        for (int i = 0; i < nameFilters.size(); ++i) {
-            regexps << QRegExp(nameFilters.at(i),
-                               (filters & QDir::CaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive,
-                               QRegExp::Wildcard);
-        }
-    }
-#endif
+    return filter.matches(it->currentFileName(), it->currentFileInfo(), knownFileType(it));
+}
 
-    QString fileName = it->currentFileName();
-    if (fileName.isEmpty()) {
-        // invalid entry
-        return false;
-    }
+/*!
+    \internal
 
-    QFileInfo fi = it->currentFileInfo();
-    QString filePath = it->currentFilePath();
+    Returns the QAbstractFileEngine::FileFlags that describe the type
+    of the current entry of \a it, if the engine iterator knows them
+    from the directory listing; otherwise returns 0, and the type must
+    be taken from QFileInfo.
+*/
+uint QDirIteratorPrivate::knownFileType(const QAbstractFileEngineIterator *it)
+{
+    QVariant type = it->entryInfo(QAbstractFileEngineIterator::FileTypeInfo);
+    return type.isValid() ? type.toUInt() : 0;
+}
 
-#ifndef QT_NO_REGEXP
-    // Pass all entries through name filters, except dirs if the AllDirs
-    // filter is passed.
-    if (hasNameFilters && !((filters & QDir::AllDirs) && fi.isDir())) {
-        bool matched = false;
-        for (int i = 0; i < regexps.size(); ++i) {
-            if (regexps.at(i).exactMatch(fileName)) {
-                matched = true;
-                break;
-            }
-        }
-        if (!matched)
-            return false;
-    }
-#endif
-    
-    bool dotOrDotDot = (fileName == QLatin1String(".") || fileName == QLatin1String(".."));
-    if ((filters & QDir::NoDotAndDotDot) && dotOrDotDot)
-        return false;
+/*!
+    \internal
 
-    bool isHidden = !dotOrDotDot && fi.isHidden();
-    if (!includeHidden && isHidden)
+    Returns true if the iteration should descend into the entry \a fi,
+    whose type is \a knownType (see knownFileType()), according to \a
+    flags. Link loops are not checked.
+*/
+bool QDirIteratorPrivate::isFollowableDirectory(const QFileInfo &fi, uint knownType,
+                                                QDirIterator::IteratorFlags flags)
+{
+    // Never follow . and ..
+    QString fileName = fi.fileName();
+    if (fileName == QLatin1String(".") || fileName == QLatin1String(".."))
         return false;
-    
-    bool alwaysShow = (filters & QDir::TypeMask) == 0
-        && ((isHidden && includeHidden)
-            || (includeSystem && ((fi.exists() && !fi.isFile() && !fi.isDir() && !fi.isSymLink())
-                                  || (!fi.exists() && fi.isSymLink()))));
-
-    // Skip files and directories
-    if ((filters & QDir::AllDirs) == 0 && skipDirs && fi.isDir()) {
-        if (!alwaysShow)
-            return false;
-    }
 
-    if ((skipFiles && (fi.isFile() || !fi.exists()))
-        || (skipSymlinks && fi.isSymLink())) {
-        if (!alwaysShow)
-            return false;
+    // Never follow non-directory entries
+    if (knownType) {
+        // entries of known type are never symbolic links
+        return (knownType & QAbstractFileEngine::DirectoryType);
     }
-
-    if (filterPermissions
-        && ((doReadable && !fi.isReadable())
-            || (doWritable && !fi.isWritable())
-            || (doExecutable && !fi.isExecutable()))) {
+    if (!fi.isDir())
         return false;
-    }
 
-    if (!includeSystem && !dotOrDotDot && ((fi.exists() && !fi.isFile() && !fi.isDir() && !fi.isSymLink())
-                                           || (!fi.exists() && fi.isSymLink()))) {
-        return false;
-    }
-    
-    return true;
+    // Follow symlinks only if FollowSymlinks was passed
+    return !fi.isSymLink() || (flags & QDirIterator::FollowSymlinks);
 }
 
 /*!
@@ -475,7 +915,7 @@ bool QDirIterator::hasNext() const
 */
 QString QDirIterator::fileName() const
 {
-    if (d->fileInfo.path() != d->currentFilePath)
+    if (d->fileInfo.filePath() != d->currentFilePath)
         d->fileInfo.setFile(d->currentFilePath);
     return d->fileInfo.fileName();
 }
@@ -500,7 +940,7 @@ QString QDirIterator::filePath() const
 */
 QFileInfo QDirIterator::fileInfo() const
 {
-    if (d->fileInfo.path() != d->currentFilePath)
+    if (d->fileInfo.filePath() != d->currentFilePath)
         d->fileInfo.setFile(d->currentFilePath);
     return d->fileInfo;
 }
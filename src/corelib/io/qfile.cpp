@@ -1068,6 +1068,80 @@ QFile::handle() const
     return -1;
 }
 
+/*!
+    \enum QFile::MemoryMapFlags
+    \since 4.4
+
+    This enum describes special options that may be used by the map()
+    function.
+
+    \value NoOptions        No options.
+*/
+
+/*!
+    \since 4.4
+
+    Maps \a size bytes of the file into memory starting at \a offset. A
+    file should be open for a map to succeed, but the file does not need
+    to stay open after the memory has been mapped. When the QFile is
+    destroyed or its file name is changed, any maps that have not been
+    unmapped will automatically be unmapped.
+
+    The mapped memory can be wrapped with QByteArray::fromRawData() to
+    use the file contents without copying them. Writing to the memory
+    of a file that was opened with QIODevice::ReadOnly is not allowed.
+
+    Any mapping options can be passed through \a flags.
+
+    Returns a pointer to the memory or 0 if there is an error, in which
+    case error() describes the problem.
+
+    \sa unmap(), QAbstractFileEngine::supportsExtension()
+ */
+uchar *QFile::map(qint64 offset, qint64 size, MemoryMapFlags flags)
+{
+    Q_D(QFile);
+    QAbstractFileEngine *engine = fileEngine();
+    if (engine
+        && engine->supportsExtension(QAbstractFileEngine::MapExtension)) {
+        // the mapping must see what has been written so far
+        if (!d->ensureFlushed())
+            return 0;
+        unsetError();
+        uchar *address = engine->map(offset, size, flags);
+        if (address == 0)
+            d->setError(engine->error(), engine->errorString());
+        return address;
+    }
+    d->setError(PermissionsError, QLatin1String("No file engine available or engine does not support MapExtension"));
+    return 0;
+}
+
+/*!
+    \since 4.4
+
+    Unmaps the memory \a address.
+
+    Returns true if the unmap succeeds; false otherwise.
+
+    \sa map(), QAbstractFileEngine::supportsExtension()
+ */
+bool QFile::unmap(uchar *address)
+{
+    Q_D(QFile);
+    QAbstractFileEngine *engine = fileEngine();
+    if (engine
+        && engine->supportsExtension(QAbstractFileEngine::UnMapExtension)) {
+        unsetError();
+        bool success = engine->unmap(address);
+        if (!success)
+            d->setError(engine->error(), engine->errorString());
+        return success;
+    }
+    d->setError(PermissionsError, QLatin1String("No file engine available or engine does not support UnMapExtension"));
+    return false;
+}
+
 /*!
     \fn QString QFile::name() const
 
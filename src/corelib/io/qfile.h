@@ -69,6 +69,10 @@ public:
     };
     Q_DECLARE_FLAGS(Permissions, Permission)
 
+    enum MemoryMapFlags {
+        NoOptions = 0
+    };
+
     QFile();
     QFile(const QString &name);
 #ifndef QT_NO_QOBJECT
@@ -135,6 +139,9 @@ public:
 
     int handle() const;
 
+    uchar *map(qint64 offset, qint64 size, MemoryMapFlags flags = NoOptions);
+    bool unmap(uchar *address);
+
     virtual QAbstractFileEngine *fileEngine() const;
 
 #ifdef QT3_SUPPORT
@@ -85,6 +85,7 @@ void QFSFileEnginePrivate::init()
 #ifdef Q_OS_WIN
     fileAttrib = INVALID_FILE_ATTRIBUTES;
     fileHandle = INVALID_HANDLE_VALUE;
+    mapHandle = INVALID_HANDLE_VALUE;
 #endif
 }
 
@@ -132,6 +133,9 @@ QFSFileEngine::~QFSFileEngine()
             } while (ret == -1 && errno == EINTR);
         }
     }
+    QList<uchar *> keys = d->maps.keys();
+    for (int i = 0; i < keys.count(); ++i)
+        d->unmap(keys.at(i));
 }
 
 /*!
@@ -744,8 +748,17 @@ bool QFSFileEngine::extension(Extension extension, const ExtensionOption *option
     if (extension == AtEndExtension && d->fh && isSequential())
         return feof(d->fh);
 
-    Q_UNUSED(option);
-    Q_UNUSED(output);
+    if (extension == MapExtension) {
+        const MapExtensionOption *options = (MapExtensionOption*)(option);
+        MapExtensionReturn *returnValue = static_cast<MapExtensionReturn*>(output);
+        returnValue->address = d->map(options->offset, options->size, options->flags);
+        return (returnValue->address != 0);
+    }
+    if (extension == UnMapExtension) {
+        UnMapExtensionOption *options = (UnMapExtensionOption*)option;
+        return d->unmap(options->address);
+    }
+
     return false;
 }
 
@@ -761,6 +774,8 @@ bool QFSFileEngine::supportsExtension(Extension extension) const
         return true;
     if (extension == FastReadLineExtension && d->fd != -1 && isSequential())
         return true;
+    if (extension == UnMapExtension || extension == MapExtension)
+        return true;
     return false;
 }
 
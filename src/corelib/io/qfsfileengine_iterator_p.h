@@ -45,6 +45,9 @@ public:
     QString currentFileName() const;
     QFileInfo currentFileInfo() const;
 
+protected:
+    QVariant entryInfo(EntryInfoType type) const;
+
 private:
     QFSFileEngineIteratorPlatformSpecificData *platform;
     friend class QFSFileEngineIteratorPlatformSpecificData;
@@ -16,6 +16,11 @@
 
 #include <QtCore/qvariant.h>
 
+// Mac OS X needs a stat() to find out whether a file is hidden
+#if (defined(_DIRENT_HAVE_D_TYPE) || defined(Q_OS_BSD4)) && defined(DT_UNKNOWN) && !defined(Q_OS_MAC)
+#  define QT_HAVE_DIRENT_TYPE
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QFSFileEngineIteratorPlatformSpecificData
@@ -23,6 +28,9 @@ class QFSFileEngineIteratorPlatformSpecificData
 public:
     inline QFSFileEngineIteratorPlatformSpecificData()
         : dir(0), dirEntry(0), done(false)
+#ifdef QT_HAVE_DIRENT_TYPE
+          , currentType(DT_UNKNOWN)
+#endif
 #if defined(_POSIX_THREAD_SAFE_FUNCTIONS) && !defined(Q_OS_CYGWIN)
           , mt_file(0)
 #endif
@@ -31,6 +39,9 @@ public:
     DIR *dir;
     dirent *dirEntry;
     bool done;
+#ifdef QT_HAVE_DIRENT_TYPE
+    unsigned char currentType;
+#endif
 
 #if defined(_POSIX_THREAD_SAFE_FUNCTIONS) && !defined(Q_OS_CYGWIN)
     // for readdir_r
@@ -41,6 +52,9 @@ public:
 void QFSFileEngineIterator::advance()
 {
     currentEntry = platform->dirEntry ? QFile::decodeName(QByteArray(platform->dirEntry->d_name)) : QString();
+#ifdef QT_HAVE_DIRENT_TYPE
+    platform->currentType = platform->dirEntry ? platform->dirEntry->d_type : (unsigned char)DT_UNKNOWN;
+#endif
 
     if (!platform->dir)
         return;
@@ -105,4 +119,36 @@ bool QFSFileEngineIterator::hasNext() const
     return !platform->done;
 }
 
+QVariant QFSFileEngineIterator::entryInfo(EntryInfoType type) const
+{
+#ifdef QT_HAVE_DIRENT_TYPE
+    /*
+        readdir() tells the type of most entries, which saves a stat()
+        per entry. Symbolic links still need one to find out what they
+        point to.
+    */
+    if (type == FileTypeInfo && !currentEntry.isEmpty()) {
+        QAbstractFileEngine::FileFlags flags;
+        switch (platform->currentType) {
+        case DT_REG:
+            flags = QAbstractFileEngine::FileType;
+            break;
+        case DT_DIR:
+            flags = QAbstractFileEngine::DirectoryType;
+            break;
+        case DT_UNKNOWN:
+        case DT_LNK:
+            return QVariant();
+        default:
+            break;
+        }
+        flags |= QAbstractFileEngine::ExistsFlag;
+        if (currentEntry.at(0) == QLatin1Char('.'))
+            flags |= QAbstractFileEngine::HiddenFlag;
+        return int(flags);
+    }
+#endif
+    return QAbstractFileEngineIterator::entryInfo(type);
+}
+
 QT_END_NAMESPACE
@@ -152,4 +152,9 @@ bool QFSFileEngineIterator::hasNext() const
     return !platform->done;
 }
 
+QVariant QFSFileEngineIterator::entryInfo(EntryInfoType type) const
+{
+    return QAbstractFileEngineIterator::entryInfo(type);
+}
+
 QT_END_NAMESPACE
@@ -28,6 +28,8 @@
 #include "qplatformdefs.h"
 #include "QtCore/qfsfileengine.h"
 #include "private/qabstractfileengine_p.h"
+#include "QtCore/qhash.h"
+#include "QtCore/qpair.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -69,10 +71,17 @@ public:
     bool nativeIsSequential() const;
     bool isSequentialFdFh() const;
 
+    uchar *map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags);
+    bool unmap(uchar *ptr);
+
     int fd;
     FILE *fh;
 #ifdef Q_WS_WIN
     HANDLE fileHandle;
+    HANDLE mapHandle;
+    QHash<uchar *, DWORD /* offset % AllocationGranularity */> maps;
+#else
+    QHash<uchar *, QPair<int /*offset % PageSize*/, size_t /*length + offset % PageSize*/> > maps;
 #endif
 
     mutable uint is_sequential : 2;
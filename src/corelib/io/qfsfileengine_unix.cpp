@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <errno.h>
+#include <sys/mman.h>
 #if !defined(QWS) && defined(Q_OS_MAC)
 # include <private/qcore_mac_p.h>
 #endif
@@ -890,4 +891,75 @@ QDateTime QFSFileEngine::fileTime(FileTime time) const
     return ret;
 }
 
+uchar *QFSFileEnginePrivate::map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags)
+{
+    Q_Q(QFSFileEngine);
+    Q_UNUSED(flags);
+    if (openMode == QIODevice::NotOpen) {
+        q->setError(QFile::PermissionsError, qt_error_string(int(EACCES)));
+        return 0;
+    }
+    if (offset < 0 || size <= 0 || offset != qint64(off_t(offset))
+        || size != qint64(size_t(size))) {
+        q->setError(QFile::UnspecifiedError, qt_error_string(int(EINVAL)));
+        return 0;
+    }
+    // pages past the end of the file cannot be accessed
+    if (offset + size > q->size()) {
+        q->setError(QFile::UnspecifiedError, qt_error_string(int(EINVAL)));
+        return 0;
+    }
+
+    int access = 0;
+    if (openMode & QIODevice::ReadOnly) access |= PROT_READ;
+    if (openMode & QIODevice::WriteOnly) access |= PROT_WRITE;
+
+    // mmap() wants a page aligned offset
+    int pageSize = getpagesize();
+    int extra = int(offset % pageSize);
+    off_t realOffset = off_t(offset - extra);
+    size_t realSize = size_t(size) + extra;
+
+    void *mapAddress = ::mmap((void*)0, realSize, access, MAP_SHARED,
+                              nativeHandle(), realOffset);
+    if (mapAddress != MAP_FAILED) {
+        uchar *address = extra + static_cast<uchar*>(mapAddress);
+        maps[address] = QPair<int, size_t>(extra, realSize);
+        return address;
+    }
+
+    switch (errno) {
+    case EBADF:
+    case EACCES:
+        q->setError(QFile::PermissionsError, qt_error_string(int(errno)));
+        break;
+    case ENFILE:
+    case ENOMEM:
+        q->setError(QFile::ResourceError, qt_error_string(int(errno)));
+        break;
+    default:
+        q->setError(QFile::UnspecifiedError, qt_error_string(int(errno)));
+        break;
+    }
+    return 0;
+}
+
+bool QFSFileEnginePrivate::unmap(uchar *ptr)
+{
+    Q_Q(QFSFileEngine);
+    if (!maps.contains(ptr)) {
+        q->setError(QFile::PermissionsError, qt_error_string(EACCES));
+        return false;
+    }
+
+    const QPair<int, size_t> map = maps.value(ptr);
+    uchar *start = ptr - map.first;
+    if (::munmap(start, map.second) == -1) {
+        q->setError(QFile::UnspecifiedError, qt_error_string(errno));
+        return false;
+    }
+    maps.remove(ptr);
+    return true;
+}
+
 QT_END_NAMESPACE
@@ -1979,4 +1979,99 @@ QDateTime QFSFileEngine::fileTime(FileTime time) const
     return ret;
 }
 
+uchar *QFSFileEnginePrivate::map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags)
+{
+    Q_Q(QFSFileEngine);
+    Q_UNUSED(flags);
+    if (openMode == QFile::NotOpen) {
+        q->setError(QFile::PermissionsError, qt_error_string());
+        return 0;
+    }
+    if (offset < 0 || size <= 0 || offset + size > q->size()) {
+        q->setError(QFile::UnspecifiedError, qt_error_string(ERROR_INVALID_PARAMETER));
+        return 0;
+    }
+
+    if (mapHandle == INVALID_HANDLE_VALUE) {
+        // get handle to the file
+        HANDLE handle = fileHandle;
+        if (handle == INVALID_HANDLE_VALUE && fh)
+            handle = (HANDLE)_get_osfhandle(QT_FILENO(fh));
+        if (handle == INVALID_HANDLE_VALUE && fd != -1)
+            handle = (HANDLE)_get_osfhandle(fd);
+        if (handle == INVALID_HANDLE_VALUE) {
+            q->setError(QFile::PermissionsError, qt_error_string(ERROR_INVALID_HANDLE));
+            return 0;
+        }
+
+        // first create the file mapping handle
+        DWORD protection = (openMode & QIODevice::WriteOnly) ? PAGE_READWRITE : PAGE_READONLY;
+        QT_WA({
+            mapHandle = ::CreateFileMappingW(handle, 0, protection, 0, 0, 0);
+        }, {
+            mapHandle = ::CreateFileMappingA(handle, 0, protection, 0, 0, 0);
+        });
+        if (mapHandle == NULL) {
+            mapHandle = INVALID_HANDLE_VALUE;
+            q->setError(QFile::PermissionsError, qt_error_string());
+            return 0;
+        }
+    }
+
+    // views must start on an allocation granularity boundary
+    SYSTEM_INFO sysinfo;
+    ::GetSystemInfo(&sysinfo);
+    DWORD extra = DWORD(offset % sysinfo.dwAllocationGranularity);
+    quint64 realOffset = quint64(offset) - extra;
+
+    DWORD access = (openMode & QIODevice::WriteOnly) ? FILE_MAP_WRITE : FILE_MAP_READ;
+    LPVOID mapAddress = ::MapViewOfFile(mapHandle, access,
+                                        DWORD(realOffset >> 32), DWORD(realOffset & 0xffffffff),
+                                        SIZE_T(size + extra));
+    if (mapAddress) {
+        uchar *address = extra + static_cast<uchar*>(mapAddress);
+        maps[address] = extra;
+        return address;
+    }
+
+    switch (GetLastError()) {
+    case ERROR_ACCESS_DENIED:
+        q->setError(QFile::PermissionsError, qt_error_string());
+        break;
+    case ERROR_NOT_ENOUGH_MEMORY:
+        q->setError(QFile::ResourceError, qt_error_string());
+        break;
+    default:
+        q->setError(QFile::UnspecifiedError, qt_error_string());
+        break;
+    }
+    if (maps.isEmpty()) {
+        ::CloseHandle(mapHandle);
+        mapHandle = INVALID_HANDLE_VALUE;
+    }
+    return 0;
+}
+
+bool QFSFileEnginePrivate::unmap(uchar *ptr)
+{
+    Q_Q(QFSFileEngine);
+    if (!maps.contains(ptr)) {
+        q->setError(QFile::PermissionsError, qt_error_string(ERROR_ACCESS_DENIED));
+        return false;
+    }
+    uchar *start = ptr - maps.value(ptr);
+    if (!UnmapViewOfFile(start)) {
+        q->setError(QFile::PermissionsError, qt_error_string());
+        return false;
+    }
+
+    maps.remove(ptr);
+    if (maps.isEmpty()) {
+        ::CloseHandle(mapHandle);
+        mapHandle = INVALID_HANDLE_VALUE;
+    }
+
+    return true;
+}
+
 QT_END_NAMESPACE
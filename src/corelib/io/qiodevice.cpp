@@ -88,7 +88,7 @@ static const qint64 QIODEVICE_BUFFERSIZE = 16384;
  */
 QIODevicePrivate::QIODevicePrivate()
     : openMode(QIODevice::NotOpen), buffer(QIODEVICE_BUFFERSIZE),
-      pos(0), devicePos(0), accessMode(Unset)
+      pos(0), devicePos(0), currentWriteChunk(0), accessMode(Unset)
 {
 }
 
@@ -1236,15 +1236,28 @@ qint64 QIODevice::write(const char *data, qint64 maxSize)
     return written;
 }
 
-/*! \fn qint64 QIODevice::write(const QByteArray &byteArray)
-
+/*!
     \overload
 
     Writes the content of \a byteArray to the device. Returns the number of
     bytes that were actually written, or -1 if an error occurred.
 
+    Buffered sequential devices, such as QTcpSocket and QProcess, queue
+    large arrays written with this function without copying them; the
+    data is shared with \a byteArray until it has been written.
+
     \sa read() writeData()
 */
+qint64 QIODevice::write(const QByteArray &byteArray)
+{
+    Q_D(QIODevice);
+    // lets writeData() adopt the array instead of copying from it
+    const QByteArray *previousChunk = d->currentWriteChunk;
+    d->currentWriteChunk = &byteArray;
+    qint64 written = write(byteArray.constData(), byteArray.size());
+    d->currentWriteChunk = previousChunk;
+    return written;
+}
 
 /*!
     Puts the character \a c back into the device, and decrements the
@@ -1401,6 +1414,94 @@ QByteArray QIODevice::peek(qint64 maxSize)
     return result;
 }
 
+/*!
+    \since 4.4
+
+    Reads the next contiguous block of data from the device and returns
+    it. The size of the block depends on how the data arrived; it is
+    at most the amount of data currently available. If no data is
+    available, or an error occurred, an empty QByteArray is returned.
+
+    Unlike read(), readChunk() hands out the device's internal buffers
+    without copying them whenever possible, which makes it well suited
+    for parsers that process data as it arrives from a QTcpSocket or a
+    QProcess:
+
+    \code
+        void Parser::socketReadyRead()
+        {
+            while (socket->bytesAvailable() > 0)
+                consume(socket->readChunk());
+        }
+    \endcode
+
+    In QIODevice::Text mode, the data is copied as with read().
+
+    \sa peekChunk(), read()
+*/
+QByteArray QIODevice::readChunk()
+{
+    Q_D(QIODevice);
+    CHECK_READABLE(readChunk, QByteArray());
+
+    if (d->openMode & Text)
+        return read(QIODEVICE_BUFFERSIZE);
+
+    QByteArray chunk;
+    if (!d->buffer.isEmpty())
+        chunk = d->buffer.readChunk();
+    else
+        chunk = d->readChunkHelper(false);
+    if (!d->isSequential())
+        d->pos += chunk.size();
+    return chunk;
+}
+
+/*!
+    \since 4.4
+
+    Returns the block of data that the next call to readChunk() would
+    return, without consuming it. Like readChunk(), this function avoids
+    copying the device's internal buffers whenever possible.
+
+    \sa readChunk(), peek()
+*/
+QByteArray QIODevice::peekChunk()
+{
+    Q_D(QIODevice);
+    CHECK_READABLE(peekChunk, QByteArray());
+
+    if (d->openMode & Text)
+        return peek(QIODEVICE_BUFFERSIZE);
+
+    if (!d->buffer.isEmpty())
+        return d->buffer.peekChunk();
+    return d->readChunkHelper(true);
+}
+
+/*!
+    \internal
+
+    Returns the next chunk of data when QIODevice's own buffer is empty.
+    The default implementation fills the buffer with readData(); devices
+    that keep a read buffer of their own reimplement this to hand out
+    its blocks directly.
+*/
+QByteArray QIODevicePrivate::readChunkHelper(bool peek)
+{
+    Q_Q(QIODevice);
+    if (pos != devicePos && !isSequential() && !q->seek(pos))
+        return QByteArray();
+
+    char *writePointer = buffer.reserve(QIODEVICE_BUFFERSIZE);
+    qint64 readFromDevice = q->readData(writePointer, QIODEVICE_BUFFERSIZE);
+    buffer.chop(QIODEVICE_BUFFERSIZE - (readFromDevice < 0 ? 0 : int(readFromDevice)));
+    if (readFromDevice > 0 && !isSequential())
+        devicePos += readFromDevice;
+
+    return peek ? buffer.peekChunk() : buffer.readChunk();
+}
+
 /*!
     Blocks until data is available for reading and the readyRead()
     signal has been emitted, or until \a msecs milliseconds have
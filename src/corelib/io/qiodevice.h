@@ -93,12 +93,14 @@ public:
     virtual bool canReadLine() const;
 
     qint64 write(const char *data, qint64 len);
-    inline qint64 write(const QByteArray &data)
-    { return write(data.constData(), data.size()); }
+    qint64 write(const QByteArray &data);
 
     qint64 peek(char *data, qint64 maxlen);
     QByteArray peek(qint64 maxlen);
 
+    QByteArray readChunk();
+    QByteArray peekChunk();
+
     virtual bool waitForReadyRead(int msecs);
     virtual bool waitForBytesWritten(int msecs);
 
@@ -56,6 +56,15 @@ public:
     bool baseReadLineDataCalled;
 
     virtual bool putCharHelper(char c);
+    virtual QByteArray readChunkHelper(bool peek);
+
+    // the array being written by write(const QByteArray &), if any
+    const QByteArray *currentWriteChunk;
+    inline bool isCurrentWriteChunk(const char *data, qint64 len) const
+    {
+        return currentWriteChunk && currentWriteChunk->constData() == data
+            && currentWriteChunk->size() == len;
+    }
 
     enum AccessMode {
         Unset,
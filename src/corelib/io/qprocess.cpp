@@ -370,6 +370,7 @@ QProcessPrivate::QProcessPrivate()
     dying = false;
     emittedReadyRead = false;
     emittedBytesWritten = false;
+    readBufferSize = 0;
 #ifdef Q_WS_WIN
     pipeWriter = 0;
     processFinishedNotifier = 0;
@@ -389,6 +390,67 @@ QProcessPrivate::~QProcessPrivate()
         stdoutChannel.process->stdinChannel.clear();
 }
 
+/*! \internal
+
+    Hands out the blocks of the current read channel's buffer directly.
+*/
+QByteArray QProcessPrivate::readChunkHelper(bool peek)
+{
+    QRingBuffer *readBuffer = (processChannel == QProcess::StandardError)
+                              ? &errorReadBuffer
+                              : &outputReadBuffer;
+    if (peek)
+        return readBuffer->peekChunk();
+    QByteArray chunk = readBuffer->readChunk();
+    resumeReading();
+    return chunk;
+}
+
+/*! \internal
+
+    Returns all data of the current read channel's buffer. The data is
+    copied into a single allocation of the right size, or not copied
+    at all if the buffer holds a single block.
+*/
+QByteArray QProcessPrivate::readAllHelper()
+{
+    QRingBuffer *readBuffer = (processChannel == QProcess::StandardError)
+                              ? &errorReadBuffer
+                              : &outputReadBuffer;
+    QByteArray data = (readBuffer->nextDataBlockSize() == readBuffer->size())
+                      ? readBuffer->readChunk()
+                      : readBuffer->readAll();
+    resumeReading();
+    return data;
+}
+
+/*! \internal
+
+    Returns true if \a buffer has room for more data from the process,
+    as limited by QProcess::readBufferSize().
+*/
+bool QProcessPrivate::canBufferMore(const QRingBuffer &buffer) const
+{
+    return readBufferSize == 0 || buffer.size() < readBufferSize;
+}
+
+/*! \internal
+
+    Re-enables the read notifiers that were disabled because the read
+    buffers were full.
+*/
+void QProcessPrivate::resumeReading()
+{
+    if (stdoutChannel.notifier && stdoutChannel.pipe[0] != INVALID_Q_PIPE
+        && canBufferMore(outputReadBuffer)) {
+        stdoutChannel.notifier->setEnabled(true);
+    }
+    if (stderrChannel.notifier && stderrChannel.pipe[0] != INVALID_Q_PIPE
+        && canBufferMore(errorReadBuffer)) {
+        stderrChannel.notifier->setEnabled(true);
+    }
+}
+
 /*! \internal
 */
 void QProcessPrivate::cleanup()
@@ -490,6 +552,10 @@ bool QProcessPrivate::_q_canReadStandardOutput()
 
     outputReadBuffer.chop(available - readBytes);
 
+    // stop reading until some of the buffered data has been read
+    if (stdoutChannel.notifier && !canBufferMore(outputReadBuffer))
+        stdoutChannel.notifier->setEnabled(false);
+
     bool didRead = false;
     if (readBytes == 0) {
         if (stdoutChannel.notifier)
@@ -534,6 +600,10 @@ bool QProcessPrivate::_q_canReadStandardError()
 
     errorReadBuffer.chop(available - readBytes);
 
+    // stop reading until some of the buffered data has been read
+    if (stderrChannel.notifier && !canBufferMore(errorReadBuffer))
+        stderrChannel.notifier->setEnabled(false);
+
     bool didRead = false;
     if (readBytes == 0) {
         if (stderrChannel.notifier)
@@ -1169,6 +1239,56 @@ QStringList QProcess::environment() const
     return d->environment;
 }
 
+/*!
+    \since 4.4
+
+    Returns the size of the internal read buffers of the standard
+    output and standard error channels. This limits the amount of data
+    that QProcess receives from each channel before you call read() or
+    readAll().
+
+    A read buffer size of 0 (the default) means that the buffers have
+    no size limit.
+
+    \sa setReadBufferSize(), read()
+*/
+qint64 QProcess::readBufferSize() const
+{
+    Q_D(const QProcess);
+    return d->readBufferSize;
+}
+
+/*!
+    \since 4.4
+
+    Sets the size of QProcess's internal read buffers to \a size
+    bytes. When a buffer is full, QProcess stops reading from the
+    channel until you read some of the data, and the process blocks
+    when it writes more output than the pipe to it can hold. This
+    keeps the memory use bounded when you stream large amounts of
+    output from a process.
+
+    The buffers may exceed \a size by the amount of data that the
+    operating system buffers in the pipe. The waitForReadyRead() and
+    waitForFinished() functions read regardless of the limit, so
+    that the process can finish.
+
+    On Linux, QProcess also asks for pipes of \a size bytes (within
+    the system's limit) when the process is started, so that a
+    process can write larger chunks of output before it has to wait
+    for the reader. This also applies to the pipe between two
+    processes connected with setStandardOutputProcess(), in which case
+    the size set on the source process is used.
+
+    \sa readBufferSize(), read()
+*/
+void QProcess::setReadBufferSize(qint64 size)
+{
+    Q_D(QProcess);
+    d->readBufferSize = qMax(qint64(0), size);
+    d->resumeReading();
+}
+
 /*!
     Blocks until the process has started and the started() signal has
     been emitted, or until \a msecs milliseconds have passed.
@@ -1342,6 +1462,7 @@ qint64 QProcess::readData(char *data, qint64 maxlen)
             return -1;
         }
         *data = (char) c;
+        d->resumeReading();
 #if defined QPROCESS_DEBUG
         qDebug("QProcess::readData(%p \"%s\", %d) == 1",
                data, qt_prettyDebug(data, 1, maxlen).constData(), 1);
@@ -1359,6 +1480,8 @@ qint64 QProcess::readData(char *data, qint64 maxlen)
         readSoFar += bytesToReadFromThisBlock;
         readBuffer->free(bytesToReadFromThisBlock);
     }
+    if (readSoFar > 0)
+        d->resumeReading();
 
 #if defined QPROCESS_DEBUG
     qDebug("QProcess::readData(%p \"%s\", %lld) == %lld",
@@ -1392,8 +1515,12 @@ qint64 QProcess::writeData(const char *data, qint64 len)
         return 1;
     }
 
-    char *dest = d->writeBuffer.reserve(len);
-    memcpy(dest, data, len);
+    if (d->isCurrentWriteChunk(data, len)) {
+        d->writeBuffer.append(*d->currentWriteChunk);
+    } else {
+        char *dest = d->writeBuffer.reserve(len);
+        memcpy(dest, data, len);
+    }
     if (d->stdinChannel.notifier)
         d->stdinChannel.notifier->setEnabled(true);
 #if defined QPROCESS_DEBUG
@@ -1412,9 +1539,14 @@ qint64 QProcess::writeData(const char *data, qint64 len)
 */
 QByteArray QProcess::readAllStandardOutput()
 {
+    Q_D(QProcess);
     ProcessChannel tmp = readChannel();
     setReadChannel(StandardOutput);
-    QByteArray data = readAll();
+    QByteArray data;
+    if (isReadable() && !(openMode() & Text) && d->buffer.isEmpty())
+        data = d->readAllHelper();
+    else
+        data = readAll();
     setReadChannel(tmp);
     return data;
 }
@@ -1428,9 +1560,14 @@ QByteArray QProcess::readAllStandardOutput()
 */
 QByteArray QProcess::readAllStandardError()
 {
+    Q_D(QProcess);
     ProcessChannel tmp = readChannel();
     setReadChannel(StandardError);
-    QByteArray data = readAll();
+    QByteArray data;
+    if (isReadable() && !(openMode() & Text) && d->buffer.isEmpty())
+        data = d->readAllHelper();
+    else
+        data = readAll();
     setReadChannel(tmp);
     return data;
 }
@@ -94,6 +94,9 @@ public:
     void setEnvironment(const QStringList &environment);
     QStringList environment() const;
 
+    qint64 readBufferSize() const;
+    void setReadBufferSize(qint64 size);
+
     QProcess::ProcessError error() const;
     QProcess::ProcessState state() const;
 
@@ -123,6 +123,11 @@ public:
     QProcessPrivate();
     virtual ~QProcessPrivate();
 
+    QByteArray readChunkHelper(bool peek);
+    QByteArray readAllHelper();
+    bool canBufferMore(const QRingBuffer &buffer) const;
+    void resumeReading();
+
     // private slots
     bool _q_canReadStandardOutput();
     bool _q_canReadStandardError();
@@ -156,6 +161,7 @@ public:
     QRingBuffer outputReadBuffer;
     QRingBuffer errorReadBuffer;
     QRingBuffer writeBuffer;
+    qint64 readBufferSize;
 
     Q_PIPE childStartedPipe[2];
     Q_PIPE deathPipe[2];
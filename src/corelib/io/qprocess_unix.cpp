@@ -383,6 +383,22 @@ void QProcessPrivate::destroyPipe(int *pipe)
     }
 }
 
+/*
+    Grows the pipe \a fd to hold \a size bytes, so that the writer can
+    write larger chunks before it has to wait for the reader. Larger
+    sizes than the default maximum of Linux need privileges.
+*/
+static void qt_set_pipe_size(int fd, qint64 size)
+{
+#if defined(F_SETPIPE_SZ)
+    if (size > 0)
+        ::fcntl(fd, F_SETPIPE_SZ, int(qMin(size, qint64(1024 * 1024))));
+#else
+    Q_UNUSED(fd);
+    Q_UNUSED(size);
+#endif
+}
+
 /*
     Create the pipes to a QProcessPrivate::Channel.
 
@@ -401,6 +417,8 @@ bool QProcessPrivate::createChannel(Channel &channel)
     if (channel.type == Channel::Normal) {
         // we're piping this channel to our own process
         qt_create_pipe(channel.pipe);
+        if (&channel != &stdinChannel)
+            qt_set_pipe_size(channel.pipe[0], readBufferSize);
 
         // create the socket notifiers
         if (threadData->eventDispatcher) {
@@ -488,6 +506,10 @@ bool QProcessPrivate::createChannel(Channel &channel)
             sink->pipe[0] = pipe[0];
             source->pipe[1] = pipe[1];
 
+            // the data doesn't pass through us, the pipe is our only buffer
+            QProcessPrivate *sourceProcess = (source == &channel) ? this : channel.process;
+            qt_set_pipe_size(pipe[0], sourceProcess->readBufferSize);
+
             return true;
         }
     }
@@ -756,10 +756,11 @@ void QProcessPrivate::_q_notified()
     if (!writeBuffer.isEmpty() && (!pipeWriter || pipeWriter->waitForWrite(0)))
         _q_canWrite();
 
-    if (bytesAvailableFromStdout())
+    // leave the data in the pipes while the read buffers are full
+    if (canBufferMore(outputReadBuffer) && bytesAvailableFromStdout())
         _q_canReadStandardOutput();
 
-    if (bytesAvailableFromStderr())
+    if (canBufferMore(errorReadBuffer) && bytesAvailableFromStderr())
         _q_canReadStandardError();
 
     if (processState != QProcess::NotRunning)
@@ -82,6 +82,91 @@ Q_GLOBAL_STATIC(ResourceList, resourceList)
 
 Q_GLOBAL_STATIC(QStringList, resourceSearchPaths)
 
+/*
+    The index remembers which resource roots contain a path, so that
+    looking up the same path again does not search every registered
+    root. It is filled lazily and cleared whenever a root is registered
+    or unregistered, or when the default locale changes. All access is
+    protected by the resource mutex.
+*/
+struct QResourceIndexEntry
+{
+    QResourceRoot *root;
+    int node; // -1 if the path is a parent of the root's mapping root
+};
+Q_DECLARE_TYPEINFO(QResourceIndexEntry, Q_PRIMITIVE_TYPE);
+
+struct QResourceIndex
+{
+    enum { MaxSize = 16384 };
+
+    QHash<QString, QVector<QResourceIndexEntry> > entries;
+    QLocale locale;
+    QResourceLookupStatistics statistics;
+};
+Q_GLOBAL_STATIC(QResourceIndex, resourceIndex)
+
+static void qt_resource_invalidate_index()
+{
+    if (QResourceIndex *index = resourceIndex())
+        index->entries.clear();
+}
+
+static QVector<QResourceIndexEntry> qt_resource_find(const QString &path)
+{
+    QResourceIndex *index = resourceIndex();
+    const ResourceList *list = resourceList();
+    if (index) {
+        ++index->statistics.lookups;
+        const QLocale locale;
+        if (locale != index->locale) {
+            index->entries.clear();
+            index->locale = locale;
+        }
+        QHash<QString, QVector<QResourceIndexEntry> >::const_iterator it = index->entries.constFind(path);
+        if (it != index->entries.constEnd()) {
+            ++index->statistics.indexHits;
+            return it.value();
+        }
+        index->statistics.rootsSearched += list->size();
+    }
+
+    QVector<QResourceIndexEntry> matches;
+    for (int i = 0; i < list->size(); ++i) {
+        QResourceRoot *res = list->at(i);
+        QResourceIndexEntry entry = { res, res->findNode(path) };
+        if (entry.node != -1 || res->mappingRootSubdir(path))
+            matches.append(entry);
+    }
+
+    if (index) {
+        if (index->entries.size() >= QResourceIndex::MaxSize)
+            index->entries.clear();
+        index->entries.insert(path, matches);
+    }
+    return matches;
+}
+
+/*
+    Returns the number of resource lookups so far, how many of them
+    were answered by the index, and how many resource roots had to be
+    searched for the others.
+*/
+QResourceLookupStatistics qt_resource_lookup_statistics()
+{
+    QMutexLocker lock(resourceMutex());
+    if (QResourceIndex *index = resourceIndex())
+        return index->statistics;
+    return QResourceLookupStatistics();
+}
+
+void qt_resource_reset_lookup_statistics()
+{
+    QMutexLocker lock(resourceMutex());
+    if (QResourceIndex *index = resourceIndex())
+        index->statistics = QResourceLookupStatistics();
+}
+
 /*!
     \class QResource
     \brief The QResource class provides an interface for reading directly from resources.
@@ -186,10 +271,10 @@ QResourcePrivate::load(const QString &file)
 {
     related.clear();
     QMutexLocker lock(resourceMutex());
-    const ResourceList *list = resourceList();
-    for(int i = 0; i < list->size(); ++i) {
-        QResourceRoot *res = list->at(i);
-        const int node = res->findNode(file);
+    const QVector<QResourceIndexEntry> matches = qt_resource_find(file);
+    for(int i = 0; i < matches.size(); ++i) {
+        QResourceRoot *res = matches.at(i).root;
+        const int node = matches.at(i).node;
         if(node != -1) {
             if(related.isEmpty()) {
                 container = res->isContainer(node);
@@ -206,7 +291,7 @@ QResourcePrivate::load(const QString &file)
             }
             res->ref.ref();
             related.append(res);
-        } else if(res->mappingRootSubdir(file)) {
+        } else {
             container = true;
             data = 0;
             size = 0;
@@ -761,6 +846,7 @@ Q_CORE_EXPORT bool qRegisterResourceData(int version, const unsigned char *tree,
             QResourceRoot *root = new QResourceRoot(tree, name, data);
             root->ref.ref();
             resourceList()->append(root);
+            qt_resource_invalidate_index();
         }
         return true;
     }
@@ -776,6 +862,7 @@ Q_CORE_EXPORT bool qUnregisterResourceData(int version, const unsigned char *tre
         for(int i = 0; i < resourceList()->size(); ) {
             if(*resourceList()->at(i) == res) {
                 QResourceRoot *root = resourceList()->takeAt(i);
+                qt_resource_invalidate_index();
                 if(!root->ref.deref())
                     delete root;
             } else {
@@ -837,40 +924,19 @@ public:
     }
 };
 
-#if defined(Q_OS_UNIX)
-#define QT_USE_MMAP
-#endif
-
-// most of the headers below are already included in qplatformdefs.h
-// also this lacks Large File support but that's probably irrelevant
-#if defined(QT_USE_MMAP)
-// for mmap
-QT_BEGIN_INCLUDE_NAMESPACE
-#include <sys/mman.h>
-#include <errno.h>
-QT_END_INCLUDE_NAMESPACE
-#endif
-
-
-
 class QDynamicFileResourceRoot: public QDynamicBufferResourceRoot
 {
     QString fileName;
-    // for mmap'ed files, this is what needs to be unmapped.
-    uchar *unmapPointer;
-    unsigned int unmapLength;
+    // for mapped files, the file owns the mapping
+    QFile *mappedFile;
 
 public:
-    inline QDynamicFileResourceRoot(const QString &_root) : QDynamicBufferResourceRoot(_root), unmapPointer(0), unmapLength(0) { }
+    inline QDynamicFileResourceRoot(const QString &_root) : QDynamicBufferResourceRoot(_root), mappedFile(0) { }
     ~QDynamicFileResourceRoot() {
-#if defined(QT_USE_MMAP)
-        if (unmapPointer) {
-            munmap((char*)unmapPointer, unmapLength);
-            unmapPointer = 0;
-            unmapLength = 0;
-        } else
-#endif
-        {
+        if (mappedFile) {
+            mappedFile->unmap(const_cast<uchar *>(mappingBuffer()));
+            delete mappedFile;
+        } else {
             delete [] (uchar *)mappingBuffer();
         }
     }
@@ -878,70 +944,40 @@ public:
     virtual ResourceRootType type() const { return Resource_File; }
 
     bool registerSelf(const QString &f) {
-        bool fromMM = false;
-        uchar *data = 0;
-        unsigned int data_len = 0;
-
-#ifdef QT_USE_MMAP
-
-#ifndef MAP_FILE
-#define MAP_FILE 0
-#endif
-#ifndef MAP_FAILED
-#define MAP_FAILED -1
-#endif
-
-        int fd = QT_OPEN(QFile::encodeName(f), O_RDONLY,
-#if defined(Q_OS_WIN)
-                         _S_IREAD | _S_IWRITE
-#else
-                         0666
-#endif
-            );
-        if (fd >= 0) {
-            QT_STATBUF st;
-            if (!QT_FSTAT(fd, &st)) {
-                uchar *ptr;
-                ptr = reinterpret_cast<uchar *>(
-                    mmap(0, st.st_size,             // any address, whole file
-                         PROT_READ,                 // read-only memory
-                         MAP_FILE | MAP_PRIVATE,    // swap-backed map from file
-                         fd, 0));                   // from offset 0 of fd
-                if (ptr && ptr != reinterpret_cast<uchar *>(MAP_FAILED)) {
-                    data = ptr;
-                    data_len = st.st_size;
-                    fromMM = true;
-                }
-            }
-            ::close(fd);
+        QFile *file = new QFile(f);
+        if (!file->open(QIODevice::ReadOnly)) {
+            delete file;
+            return false;
         }
-#endif // QT_USE_MMAP
-        if(!data) {
-            QFile file(f);
-            if (!file.exists())
-                return false;
-            data_len = file.size();
-            data = new uchar[data_len];
-
-            bool ok = false;
-            if (file.open(QIODevice::ReadOnly))
-                ok = (data_len == (uint)file.read((char*)data, data_len));
-            if (!ok) {
-                delete [] data;
-                data = 0;
-                data_len = 0;
-                return false;
-            }
-            fromMM = false;
+        const qint64 data_len = file->size();
+        if (data_len < 20 || data_len > 0x7fffffff) {
+            delete file;
+            return false;
         }
-        if(data && QDynamicBufferResourceRoot::registerSelf(data)) {
-            if(fromMM) {
-                unmapPointer = data;
-                unmapLength = data_len;
+
+        // the data is paged in on demand, and shared between processes
+        uchar *data = file->map(0, data_len);
+        if (data) {
+            file->close();
+            if (QDynamicBufferResourceRoot::registerSelf(data)) {
+                mappedFile = file;
+                fileName = f;
+                return true;
             }
+            file->unmap(data);
+            delete file;
+            return false;
+        }
+
+        // fall back to reading files that cannot be mapped
+        data = new uchar[data_len];
+        bool ok = (data_len == file->read((char*)data, data_len));
+        delete file;
+        if (ok && QDynamicBufferResourceRoot::registerSelf(data)) {
             fileName = f;
             return true;
         }
+        delete [] data;
         return false;
     }
 };
@@ -982,6 +1018,7 @@ QResource::registerResource(const QString &rccFilename, const QString &resourceR
         root->ref.ref();
         QMutexLocker lock(resourceMutex());
         resourceList()->append(root);
+        qt_resource_invalidate_index();
         return true;
     }
     delete root;
@@ -1012,6 +1049,7 @@ QResource::unregisterResource(const QString &rccFilename, const QString &resourc
 	    QDynamicFileResourceRoot *root = reinterpret_cast<QDynamicFileResourceRoot*>(res);
 	    if(root->mappingFile() == rccFilename && root->mappingRoot() == r) {
                 resourceList()->removeAt(i);
+                qt_resource_invalidate_index();
                 if(!root->ref.deref()) {
                     delete root;
                     return true;
@@ -1053,6 +1091,7 @@ QResource::registerResource(const uchar *rccData, const QString &resourceRoot)
         root->ref.ref();
         QMutexLocker lock(resourceMutex());
         resourceList()->append(root);
+        qt_resource_invalidate_index();
         return true;
     }
     delete root;
@@ -1083,6 +1122,7 @@ QResource::unregisterResource(const uchar *rccData, const QString &resourceRoot)
 	    QDynamicBufferResourceRoot *root = reinterpret_cast<QDynamicBufferResourceRoot*>(res);
 	    if(root->mappingBuffer() == rccData && root->mappingRoot() == r) {
                 resourceList()->removeAt(i);
+                qt_resource_invalidate_index();
                 if(!root->ref.deref()) {
                     delete root;
                     return true;
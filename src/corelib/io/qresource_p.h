@@ -29,6 +29,18 @@
 
 QT_BEGIN_NAMESPACE
 
+struct QResourceLookupStatistics
+{
+    inline QResourceLookupStatistics() : lookups(0), indexHits(0), rootsSearched(0) { }
+
+    int lookups;
+    int indexHits;
+    int rootsSearched;
+};
+
+Q_CORE_EXPORT QResourceLookupStatistics qt_resource_lookup_statistics();
+Q_CORE_EXPORT void qt_resource_reset_lookup_statistics();
+
 class QResourceFileEnginePrivate;
 class QResourceFileEngine : public QAbstractFileEngine
 {
@@ -25,6 +25,7 @@
 #include "qmutex.h"
 #include "qlibraryinfo.h"
 #include "qtemporaryfile.h"
+#include "qendian.h"
 
 #ifndef QT_NO_GEOM_VARIANT
 #include "qsize.h"
@@ -171,11 +172,25 @@ static bool unixLock(int handle, int lockType)
 #endif
 
 QConfFile::QConfFile(const QString &fileName, bool _userPerms)
-    : name(fileName), size(0), ref(1), userPerms(_userPerms)
+    : name(fileName), size(0), binaryFile(0), binaryGeneration(0), ref(1),
+      userPerms(_userPerms)
 {
     usedHashFunc()->insert(name, this);
 }
 
+QConfFile::~QConfFile()
+{
+    unmapBinaryFile();
+}
+
+void QConfFile::unmapBinaryFile()
+{
+    binaryData.clear();
+    binaryGeneration = 0;
+    delete binaryFile; // unmaps the file
+    binaryFile = 0;
+}
+
 ParsedSettingsMap QConfFile::mergedKeyMap() const
 {
     ParsedSettingsMap result = originalKeys;
@@ -903,7 +918,12 @@ static bool checkAccess(const QString &name)
 
 void QConfFileSettingsPrivate::initFormat()
 {
-    extension = (format == QSettings::NativeFormat) ? QLatin1String(".conf") : QLatin1String(".ini");
+    if (format == QSettings::NativeFormat)
+        extension = QLatin1String(".conf");
+    else if (format == QSettings::BinaryFormat)
+        extension = QLatin1String(".qsb");
+    else
+        extension = QLatin1String(".ini");
     readFunc = 0;
     writeFunc = 0;
 #if defined(Q_OS_MAC)
@@ -912,7 +932,7 @@ void QConfFileSettingsPrivate::initFormat()
     caseSensitivity = IniCaseSensitivity;
 #endif
 
-    if (format > QSettings::IniFormat) {
+    if (format > QSettings::BinaryFormat) {
         QMutexLocker locker(globalMutex());
         const CustomFormatVector *customFormatVector = customFormatVectorFunc();
 
@@ -932,7 +952,7 @@ void QConfFileSettingsPrivate::initAccess()
     bool readAccess = false;
     if (confFiles[spec]) {
         readAccess = checkAccess(confFiles[spec]->name);
-        if (format > QSettings::IniFormat) {
+        if (format > QSettings::BinaryFormat) {
             if (!readFunc)
                 readAccess = false;
         }
@@ -1298,7 +1318,7 @@ QString QConfFileSettingsPrivate::fileName() const
 
 bool QConfFileSettingsPrivate::isWritable() const
 {
-    if (format > QSettings::IniFormat && !writeFunc)
+    if (format > QSettings::BinaryFormat && !writeFunc)
         return false;
 
     QConfFile *confFile = confFiles[spec];
@@ -1315,6 +1335,72 @@ bool QConfFileSettingsPrivate::isWritable() const
     }
 }
 
+/*
+    Layout of BinaryFormat files. All numbers are little-endian
+    quint32s and all offsets are relative to the start of the file.
+
+    header:  magic, version, generation, flags, number of entries,
+             number of buckets, offset of the entries, offset of
+             the buckets
+    entries: hash, offset and length of the key, offset and length
+             of the original case key, offset and length of the
+             value; the entries are sorted by key
+    buckets: entry number + 1 for each bucket of the hash table, or
+             0 for empty buckets; the number of buckets is a power of
+             two and collisions are resolved by linear probing
+    data:    the keys in UTF-16 and the values as written by
+             QDataStream
+
+    The generation is incremented every time the file is written,
+    which lets us notice changes that QFileInfo::lastModified() is
+    too coarse to see.
+*/
+enum {
+    BinaryMagic = 0x31425351, // "QSB1"
+    BinaryVersion = 1,
+    BinaryCaseSensitive = 0x1,
+
+    BinaryHeaderSize = 8 * 4,
+    BinaryEntrySize = 7 * 4
+};
+
+enum BinaryHeaderField {
+    BinaryHeaderMagic,
+    BinaryHeaderVersion,
+    BinaryHeaderGeneration,
+    BinaryHeaderFlags,
+    BinaryHeaderEntryCount,
+    BinaryHeaderBucketCount,
+    BinaryHeaderEntriesOffset,
+    BinaryHeaderBucketsOffset
+};
+
+enum BinaryEntryField {
+    BinaryEntryHash,
+    BinaryEntryKeyOffset,
+    BinaryEntryKeyLength,
+    BinaryEntryOriginalKeyOffset,
+    BinaryEntryOriginalKeyLength,
+    BinaryEntryValueOffset,
+    BinaryEntryValueLength
+};
+
+static inline quint32 binaryNumber(const QByteArray &data, quint32 offset)
+{
+    return qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(data.constData()) + offset);
+}
+
+static inline quint32 binaryHeader(const QByteArray &data, BinaryHeaderField field)
+{
+    return binaryNumber(data, field * 4);
+}
+
+static inline quint32 binaryEntry(const QByteArray &data, quint32 entry, BinaryEntryField field)
+{
+    return binaryNumber(data, binaryHeader(data, BinaryHeaderEntriesOffset)
+                              + entry * BinaryEntrySize + field * 4);
+}
+
 void QConfFileSettingsPrivate::syncConfFile(int confFileNo)
 {
     QConfFile *confFile = confFiles[confFileNo];
@@ -1327,7 +1413,9 @@ void QConfFileSettingsPrivate::syncConfFile(int confFileNo)
     */
     if (readOnly) {
         QFileInfo fileInfo(confFile->name);
-        if (confFile->size == fileInfo.size() && confFile->timeStamp == fileInfo.lastModified())
+        if (confFile->size == fileInfo.size() && confFile->timeStamp == fileInfo.lastModified()
+            && (confFile->binaryData.isEmpty()
+                || binaryFileGeneration(confFile->name) == confFile->binaryGeneration))
             return;
     }
 
@@ -1399,8 +1487,29 @@ void QConfFileSettingsPrivate::syncConfFile(int confFileNo)
         }
     }
 #else
-    if (file.isOpen())
+    if (file.isOpen()) {
         unixLock(file.handle(), readOnly ? F_RDLCK : F_WRLCK);
+
+        /*
+            BinaryFormat files are replaced by renaming a new file
+            over them. If that happened while we were waiting for the
+            lock, we must lock the file that is in place now.
+        */
+        if (format == QSettings::BinaryFormat) {
+            QT_STATBUF lockedInfo;
+            QT_STATBUF currentInfo;
+            while (QT_FSTAT(file.handle(), &lockedInfo) == 0
+                   && QT_STAT(QFile::encodeName(confFile->name), &currentInfo) == 0
+                   && (lockedInfo.st_ino != currentInfo.st_ino
+                       || lockedInfo.st_dev != currentInfo.st_dev)) {
+                QIODevice::OpenMode mode = file.openMode();
+                file.close();
+                if (!file.open(mode))
+                    break;
+                unixLock(file.handle(), readOnly ? F_RDLCK : F_WRLCK);
+            }
+        }
+    }
 #endif
 
     // If we have created the file, apply the file perms
@@ -1423,11 +1532,15 @@ void QConfFileSettingsPrivate::syncConfFile(int confFileNo)
     if (!readOnly) {
         mustReadFile = (confFile->size != fileInfo.size()
                         || (confFile->size != 0 && confFile->timeStamp != fileInfo.lastModified()));
+        if (!mustReadFile && !confFile->binaryData.isEmpty()) {
+            mustReadFile = (binaryFileGeneration(confFile->name) != confFile->binaryGeneration);
+        }
     }
 
     if (mustReadFile) {
         confFile->unparsedIniSections.clear();
         confFile->originalKeys.clear();
+        confFile->unmapBinaryFile();
 
         /*
             Files that we can't read (because of permissions or
@@ -1440,7 +1553,9 @@ void QConfFileSettingsPrivate::syncConfFile(int confFileNo)
             } else
 #endif
             {
-                if (format <= QSettings::IniFormat) {
+                if (format == QSettings::BinaryFormat) {
+                    ok = mapBinaryFile(confFile, caseSensitivity);
+                } else if (format <= QSettings::IniFormat) {
                     QByteArray data = file.readAll();
                     ok = readIniFile(data, &confFile->unparsedIniSections);
                 } else {
@@ -1475,7 +1590,15 @@ void QConfFileSettingsPrivate::syncConfFile(int confFileNo)
         We also need to save the file. We still hold the file lock,
         so everything is under control.
     */
-    if (!readOnly) {
+    if (!readOnly && format == QSettings::BinaryFormat) {
+        if (writeBinaryFile(file, confFile)) {
+            QFileInfo fileInfo(confFile->name);
+            confFile->size = fileInfo.size();
+            confFile->timeStamp = fileInfo.lastModified();
+        } else {
+            setStatus(QSettings::AccessError);
+        }
+    } else if (!readOnly) {
         ensureAllSectionsParsed(confFile);
         ParsedSettingsMap mergedKeys = confFile->mergedKeyMap();
 
@@ -1823,6 +1946,11 @@ bool QConfFileSettingsPrivate::writeIniFile(QIODevice &device, const ParsedSetti
 
 void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) const
 {
+    if (!confFile->binaryData.isEmpty()) {
+        ensureBinaryKeysDecoded(confFile, QSettingsKey(QString(), caseSensitivity));
+        return;
+    }
+
     UnparsedSettingsMap::const_iterator i = confFile->unparsedIniSections.constBegin();
     const UnparsedSettingsMap::const_iterator end = confFile->unparsedIniSections.constEnd();
 
@@ -1836,6 +1964,11 @@ void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) cons
 void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
                                                    const QSettingsKey &key) const
 {
+    if (!confFile->binaryData.isEmpty()) {
+        ensureBinaryKeysDecoded(confFile, key);
+        return;
+    }
+
     if (confFile->unparsedIniSections.isEmpty())
         return;
 
@@ -1860,6 +1993,372 @@ void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
     confFile->unparsedIniSections.erase(i);
 }
 
+static uint binaryKeyHash(const QString &key)
+{
+    // FNV-1a, which is part of the file format and must not change
+    const QChar *p = key.constData();
+    uint h = 2166136261u;
+    for (int i = 0; i < key.size(); ++i) {
+        h ^= p[i].unicode();
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/*
+    Returns the string stored at \a offset in the file, or a null
+    string if it lies outside of the file. Unless \a deepCopy is true,
+    the string refers to the mapped file on little-endian machines.
+*/
+static QString binaryString(const QByteArray &data, quint32 offset, quint32 length,
+                            bool deepCopy = false)
+{
+    if ((offset & 1) || quint64(offset) + quint64(length) * 2 > quint64(data.size()))
+        return QString();
+
+    const QChar *unicode = reinterpret_cast<const QChar *>(data.constData() + offset);
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    if (!deepCopy)
+        return QString::fromRawData(unicode, length);
+    return QString(unicode, length);
+#else
+    Q_UNUSED(deepCopy);
+    QString result;
+    result.resize(length);
+    QChar *p = result.data();
+    const uchar *src = reinterpret_cast<const uchar *>(unicode);
+    for (quint32 i = 0; i < length; ++i)
+        p[i] = qFromLittleEndian<quint16>(src + i * 2);
+    return result;
+#endif
+}
+
+static inline QString binaryKey(const QByteArray &data, quint32 entry)
+{
+    return binaryString(data, binaryEntry(data, entry, BinaryEntryKeyOffset),
+                        binaryEntry(data, entry, BinaryEntryKeyLength));
+}
+
+static QByteArray binaryValue(const QByteArray &data, quint32 entry)
+{
+    quint32 offset = binaryEntry(data, entry, BinaryEntryValueOffset);
+    quint32 length = binaryEntry(data, entry, BinaryEntryValueLength);
+    if (quint64(offset) + length > quint64(data.size()))
+        return QByteArray();
+    return QByteArray::fromRawData(data.constData() + offset, length);
+}
+
+static int findBinaryEntry(const QByteArray &data, const QString &key)
+{
+    const quint32 bucketCount = binaryHeader(data, BinaryHeaderBucketCount);
+    const quint32 entryCount = binaryHeader(data, BinaryHeaderEntryCount);
+    const quint32 bucketsOffset = binaryHeader(data, BinaryHeaderBucketsOffset);
+    const uint h = binaryKeyHash(key);
+
+    quint32 bucket = h & (bucketCount - 1);
+    for (quint32 probes = 0; probes < bucketCount; ++probes) {
+        quint32 entry = binaryNumber(data, bucketsOffset + bucket * 4);
+        if (entry == 0 || entry > entryCount)
+            break;
+        --entry;
+        if (binaryEntry(data, entry, BinaryEntryHash) == h && binaryKey(data, entry) == key)
+            return entry;
+        bucket = (bucket + 1) & (bucketCount - 1);
+    }
+    return -1;
+}
+
+static quint32 binaryLowerBound(const QByteArray &data, const QString &key)
+{
+    quint32 begin = 0;
+    quint32 end = binaryHeader(data, BinaryHeaderEntryCount);
+    while (begin < end) {
+        quint32 middle = begin + (end - begin) / 2;
+        if (binaryKey(data, middle) < key)
+            begin = middle + 1;
+        else
+            end = middle;
+    }
+    return begin;
+}
+
+bool QConfFileSettingsPrivate::mapBinaryFile(QConfFile *confFile, Qt::CaseSensitivity cs)
+{
+    confFile->unmapBinaryFile();
+
+    QFile *file = new QFile(confFile->name);
+    if (!file->open(QIODevice::ReadOnly)) {
+        delete file;
+        return false;
+    }
+
+    QByteArray data;
+    qint64 size = file->size();
+    if (size >= BinaryHeaderSize && size < 0x7fffffff) {
+        if (const uchar *address = file->map(0, size)) {
+            data = QByteArray::fromRawData(reinterpret_cast<const char *>(address), int(size));
+        } else {
+            // e.g., resource files can't be mapped
+            data = file->readAll();
+        }
+    }
+    file->close();
+
+    if (data.size() < BinaryHeaderSize
+        || binaryHeader(data, BinaryHeaderMagic) != quint32(BinaryMagic)
+        || binaryHeader(data, BinaryHeaderVersion) != quint32(BinaryVersion)
+        || bool(binaryHeader(data, BinaryHeaderFlags) & BinaryCaseSensitive)
+           != (cs == Qt::CaseSensitive)) {
+        delete file;
+        return false;
+    }
+
+    /*
+        Check that the entries and the hash table lie within the file.
+        The keys and values are checked when they are accessed.
+    */
+    const quint64 entryCount = binaryHeader(data, BinaryHeaderEntryCount);
+    const quint64 bucketCount = binaryHeader(data, BinaryHeaderBucketCount);
+    const quint64 entriesOffset = binaryHeader(data, BinaryHeaderEntriesOffset);
+    const quint64 bucketsOffset = binaryHeader(data, BinaryHeaderBucketsOffset);
+    if (entriesOffset + entryCount * BinaryEntrySize > quint64(data.size())
+        || bucketsOffset + bucketCount * 4 > quint64(data.size())
+        || bucketCount < entryCount
+        || (bucketCount & (bucketCount - 1)) != 0) {
+        delete file;
+        return false;
+    }
+
+    confFile->binaryFile = file;
+    confFile->binaryData = data;
+    confFile->binaryGeneration = binaryHeader(data, BinaryHeaderGeneration);
+    return true;
+}
+
+quint32 QConfFileSettingsPrivate::binaryFileGeneration(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return 0;
+    QByteArray header = file.read(BinaryHeaderGeneration * 4 + 4);
+    if (header.size() != BinaryHeaderGeneration * 4 + 4
+        || binaryHeader(header, BinaryHeaderMagic) != quint32(BinaryMagic))
+        return 0;
+    return binaryHeader(header, BinaryHeaderGeneration);
+}
+
+/*
+    Decodes the values of \a key and of the keys below it, if \a key
+    is empty or ends with a slash, from the mapped file into
+    originalKeys.
+*/
+void QConfFileSettingsPrivate::ensureBinaryKeysDecoded(QConfFile *confFile,
+                                                       const QSettingsKey &key) const
+{
+    const QByteArray &data = confFile->binaryData;
+    const quint32 entryCount = binaryHeader(data, BinaryHeaderEntryCount);
+    if (quint32(confFile->originalKeys.size()) >= entryCount)
+        return;
+
+    quint32 first = 0;
+    quint32 last = 0;
+    if (key.isEmpty()) {
+        last = entryCount;
+    } else if (key.endsWith(QLatin1Char('/'))) {
+        first = binaryLowerBound(data, key);
+        last = first;
+        while (last < entryCount && binaryKey(data, last).startsWith(key))
+            ++last;
+    } else {
+        int entry = findBinaryEntry(data, key);
+        if (entry == -1)
+            return;
+        first = entry;
+        last = first + 1;
+    }
+
+    for (quint32 i = first; i < last; ++i) {
+        QSettingsKey theKey(binaryString(data, binaryEntry(data, i, BinaryEntryOriginalKeyOffset),
+                                         binaryEntry(data, i, BinaryEntryOriginalKeyLength), true),
+                            caseSensitivity);
+        if (theKey.isEmpty() || confFile->originalKeys.contains(theKey))
+            continue;
+
+        QVariant value;
+#ifndef QT_NO_DATASTREAM
+        QByteArray bytes = binaryValue(data, i);
+        QDataStream stream(&bytes, QIODevice::ReadOnly);
+        stream.setVersion(QDataStream::Qt_4_4);
+        stream >> value;
+        if (stream.status() != QDataStream::Ok) {
+            setStatus(QSettings::FormatError);
+            continue;
+        }
+#endif
+        confFile->originalKeys.insert(theKey, value);
+    }
+}
+
+struct QSettingsBinaryEntry
+{
+    QString key;
+    QString originalKey;
+    QByteArray value;
+};
+
+/*
+    Returns the contents of the file that stores the merged keys of
+    \a confFile. The values of the keys that haven't changed are
+    copied from the mapped file without decoding them.
+*/
+QByteArray QConfFileSettingsPrivate::binaryFileData(const QConfFile *confFile,
+                                                    Qt::CaseSensitivity cs, quint32 generation)
+{
+    const QByteArray &data = confFile->binaryData;
+    const quint32 oldCount = data.isEmpty() ? 0 : binaryHeader(data, BinaryHeaderEntryCount);
+    QVector<QSettingsBinaryEntry> entries;
+    entries.reserve(oldCount + confFile->addedKeys.size());
+
+    // merge the sorted entries of the file with the sorted added keys
+    ParsedSettingsMap::const_iterator j = confFile->addedKeys.constBegin();
+    const ParsedSettingsMap::const_iterator end = confFile->addedKeys.constEnd();
+    quint32 i = 0;
+    while (i < oldCount || j != end) {
+        QString oldKey;
+        if (i < oldCount)
+            oldKey = binaryKey(data, i);
+
+        QSettingsBinaryEntry entry;
+        if (j != end && (i == oldCount || !(oldKey < j.key()))) {
+            if (i < oldCount && oldKey == j.key())
+                ++i;
+            entry.key = j.key();
+            entry.originalKey = j.key().originalCaseKey();
+#ifndef QT_NO_DATASTREAM
+            QDataStream stream(&entry.value, QIODevice::WriteOnly);
+            stream.setVersion(QDataStream::Qt_4_4);
+            stream << j.value();
+#endif
+            ++j;
+        } else {
+            if (!oldKey.isEmpty() && !confFile->removedKeys.contains(QSettingsKey(oldKey, cs))) {
+                entry.key = oldKey;
+                entry.originalKey = binaryString(data,
+                                                 binaryEntry(data, i, BinaryEntryOriginalKeyOffset),
+                                                 binaryEntry(data, i, BinaryEntryOriginalKeyLength));
+                entry.value = binaryValue(data, i);
+            }
+            ++i;
+            if (entry.key.isEmpty())
+                continue;
+        }
+        entries.append(entry);
+    }
+
+    const quint32 entryCount = entries.size();
+    quint32 bucketCount = 1;
+    while (bucketCount < entryCount * 2)
+        bucketCount <<= 1;
+
+    const quint32 entriesOffset = BinaryHeaderSize;
+    const quint32 bucketsOffset = entriesOffset + entryCount * BinaryEntrySize;
+    quint32 dataSize = bucketsOffset + bucketCount * 4;
+    for (quint32 k = 0; k < entryCount; ++k) {
+        const QSettingsBinaryEntry &entry = entries.at(k);
+        dataSize += entry.key.size() * 2;
+        if (entry.originalKey != entry.key)
+            dataSize += entry.originalKey.size() * 2;
+    }
+    quint32 valuesOffset = dataSize;
+    for (quint32 k = 0; k < entryCount; ++k)
+        dataSize += entries.at(k).value.size();
+
+    QByteArray result(dataSize, '\0');
+    uchar *out = reinterpret_cast<uchar *>(result.data());
+
+    qToLittleEndian<quint32>(BinaryMagic, out + BinaryHeaderMagic * 4);
+    qToLittleEndian<quint32>(BinaryVersion, out + BinaryHeaderVersion * 4);
+    qToLittleEndian<quint32>(generation, out + BinaryHeaderGeneration * 4);
+    qToLittleEndian<quint32>(cs == Qt::CaseSensitive ? BinaryCaseSensitive : 0,
+                             out + BinaryHeaderFlags * 4);
+    qToLittleEndian<quint32>(entryCount, out + BinaryHeaderEntryCount * 4);
+    qToLittleEndian<quint32>(bucketCount, out + BinaryHeaderBucketCount * 4);
+    qToLittleEndian<quint32>(entriesOffset, out + BinaryHeaderEntriesOffset * 4);
+    qToLittleEndian<quint32>(bucketsOffset, out + BinaryHeaderBucketsOffset * 4);
+
+    quint32 keysOffset = bucketsOffset + bucketCount * 4;
+    for (quint32 k = 0; k < entryCount; ++k) {
+        const QSettingsBinaryEntry &entry = entries.at(k);
+        uchar *fields = out + entriesOffset + k * BinaryEntrySize;
+        const uint h = binaryKeyHash(entry.key);
+        qToLittleEndian<quint32>(h, fields + BinaryEntryHash * 4);
+
+        qToLittleEndian<quint32>(keysOffset, fields + BinaryEntryKeyOffset * 4);
+        qToLittleEndian<quint32>(entry.key.size(), fields + BinaryEntryKeyLength * 4);
+        for (int c = 0; c < entry.key.size(); ++c, keysOffset += 2)
+            qToLittleEndian<quint16>(entry.key.at(c).unicode(), out + keysOffset);
+        if (entry.originalKey != entry.key) {
+            qToLittleEndian<quint32>(keysOffset, fields + BinaryEntryOriginalKeyOffset * 4);
+            for (int c = 0; c < entry.originalKey.size(); ++c, keysOffset += 2)
+                qToLittleEndian<quint16>(entry.originalKey.at(c).unicode(), out + keysOffset);
+        } else {
+            qToLittleEndian<quint32>(keysOffset - entry.key.size() * 2,
+                                     fields + BinaryEntryOriginalKeyOffset * 4);
+        }
+        qToLittleEndian<quint32>(entry.originalKey.size(), fields + BinaryEntryOriginalKeyLength * 4);
+
+        qToLittleEndian<quint32>(valuesOffset, fields + BinaryEntryValueOffset * 4);
+        qToLittleEndian<quint32>(entry.value.size(), fields + BinaryEntryValueLength * 4);
+        memcpy(out + valuesOffset, entry.value.constData(), entry.value.size());
+        valuesOffset += entry.value.size();
+
+        quint32 bucket = h & (bucketCount - 1);
+        while (binaryNumber(result, bucketsOffset + bucket * 4) != 0)
+            bucket = (bucket + 1) & (bucketCount - 1);
+        qToLittleEndian<quint32>(k + 1, out + bucketsOffset + bucket * 4);
+    }
+    return result;
+}
+
+bool QConfFileSettingsPrivate::writeBinaryFile(QFile &file, QConfFile *confFile)
+{
+    if (!file.isWritable())
+        return false;
+
+    const quint32 generation = confFile->binaryGeneration + 1;
+    QByteArray data = binaryFileData(confFile, caseSensitivity, generation);
+
+#ifdef Q_OS_UNIX
+    /*
+        Write a new file and rename it over the old one, so that the
+        old file stays intact for the processes that have it mapped.
+    */
+    QTemporaryFile newFile(confFile->name);
+    if (!newFile.open() || newFile.write(data) != data.size() || !newFile.flush())
+        return false;
+    newFile.setPermissions(file.permissions());
+    if (::rename(QFile::encodeName(newFile.fileName()), QFile::encodeName(confFile->name)) != 0)
+        return false;
+    newFile.setAutoRemove(false);
+#else
+    // a mapped file can't be resized
+    confFile->unmapBinaryFile();
+    file.seek(0);
+    file.resize(0);
+    if (file.write(data) != data.size() || !file.flush())
+        return false;
+#endif
+
+    confFile->originalKeys.clear();
+    confFile->addedKeys.clear();
+    confFile->removedKeys.clear();
+    if (!mapBinaryFile(confFile, caseSensitivity)) {
+        confFile->binaryData = data;
+        confFile->binaryGeneration = generation;
+    }
+    return true;
+}
+
 /*!
     \class QSettings
     \brief The QSettings class provides persistent platform-independent application settings.
@@ -2364,6 +2863,10 @@ void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
                          API; on Unix, this means textual
                          configuration files in INI format.
     \value IniFormat  Store the settings in INI files.
+    \value BinaryFormat  Store the settings in a binary file that is
+                         memory-mapped and indexed, so that a value
+                         is only decoded when it is read. This format
+                         was introduced in Qt 4.4.
     \value InvalidFormat Special value returned by registerFormat().
     \omitvalue CustomFormat1
     \omitvalue CustomFormat2
@@ -2425,6 +2928,20 @@ void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
         "%General" section, \e not in the "General" section.
     \endlist
 
+    The binary file format is meant for large settings files that
+    are read often, for example by long-running services. Opening
+    such a file maps it into memory without parsing it, a lookup
+    goes through a hash table stored in the file, and a value is
+    only decoded the first time it is read. When settings are
+    written, the values that didn't change are copied to the new
+    file without being decoded, and the new file replaces the old
+    one atomically on Unix, so that processes that have the old file
+    mapped are not disturbed. The files use the \c .qsb extension
+    and are located like INI files (see setPath()). Values are stored
+    using QDataStream, so any type that QVariant can stream is
+    supported. Keys follow the same case sensitivity rules as in INI
+    files.
+
     \sa registerFormat(), setPath()
 */
 
@@ -64,6 +64,7 @@ public:
     enum Format {
         NativeFormat,
         IniFormat,
+        BinaryFormat,
 
         InvalidFormat = 16,
         CustomFormat1,
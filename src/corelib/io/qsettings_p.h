@@ -26,6 +26,7 @@
 //
 
 #include "QtCore/qdatetime.h"
+#include "QtCore/qfile.h"
 #include "QtCore/qmap.h"
 #include "QtCore/qmutex.h"
 #include "QtCore/qiodevice.h"
@@ -122,11 +123,17 @@ public:
 
     static QConfFile *fromName(const QString &name, bool _userPerms);
     static void clearCache();
+    ~QConfFile();
+
+    void unmapBinaryFile();
 
     QString name;
     QDateTime timeStamp;
     qint64 size;
     UnparsedSettingsMap unparsedIniSections;
+    QFile *binaryFile;
+    QByteArray binaryData;
+    quint32 binaryGeneration;
     ParsedSettingsMap originalKeys;
     ParsedSettingsMap addedKeys;
     ParsedSettingsMap removedKeys;
@@ -247,6 +254,11 @@ public:
     static bool readIniLine(const QByteArray &data, int &dataPos, int &lineStart, int &lineLen,
                             int &equalsPos);
 
+    static bool mapBinaryFile(QConfFile *confFile, Qt::CaseSensitivity cs);
+    static quint32 binaryFileGeneration(const QString &fileName);
+    static QByteArray binaryFileData(const QConfFile *confFile, Qt::CaseSensitivity cs,
+                                     quint32 generation);
+
 private:
     void initFormat();
     void initAccess();
@@ -256,8 +268,10 @@ private:
     bool readPlistFile(const QString &fileName, ParsedSettingsMap *map) const;
     bool writePlistFile(const QString &fileName, const ParsedSettingsMap &map) const;
 #endif
+    bool writeBinaryFile(QFile &file, QConfFile *confFile);
     void ensureAllSectionsParsed(QConfFile *confFile) const;
     void ensureSectionParsed(QConfFile *confFile, const QSettingsKey &key) const;
+    void ensureBinaryKeysDecoded(QConfFile *confFile, const QSettingsKey &key) const;
 
     QConfFile *confFiles[NumConfFiles];
     QSettings::Format format;
@@ -97,6 +97,13 @@ unix {
             HEADERS += \
                 kernel/qeventdispatcher_unix_p.h
 
+        linux-*:{
+            SOURCES += \
+                kernel/qeventdispatcher_epoll.cpp
+            HEADERS += \
+                kernel/qeventdispatcher_epoll_p.h
+        }
+
    contains(QT_CONFIG, clock-monotonic):include($$QT_SOURCE_TREE/config.tests/unix/clock-monotonic/clock-monotonic.pri)
 }
 
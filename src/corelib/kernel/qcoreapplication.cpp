@@ -37,6 +37,9 @@
 #    include "qeventdispatcher_glib_p.h"
 #  endif
 #  include "qeventdispatcher_unix_p.h"
+#  if defined(Q_OS_LINUX)
+#    include "qeventdispatcher_epoll_p.h"
+#  endif
 #endif
 
 #ifdef Q_OS_WIN
@@ -125,7 +128,11 @@ bool QCoreApplicationPrivate::is_app_closing = false;
 
 Q_CORE_EXPORT uint qGlobalPostedEventsCount()
 {
-    return QThreadData::current()->postEventList.size();
+    QThreadData *data = QThreadData::current();
+    // include the queued meta calls that have not been taken in yet
+    QMutexLocker locker(&data->postEventList.mutex);
+    data->postEventList.takeIncoming();
+    return data->postEventList.size();
 }
 
 
@@ -194,10 +201,11 @@ QCoreApplicationPrivate::~QCoreApplicationPrivate()
 
     // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
     QMutexLocker locker(&threadData->postEventList.mutex);
+    threadData->postEventList.takeIncoming();
     for (int i = 0; i < threadData->postEventList.size(); ++i) {
         const QPostEvent &pe = threadData->postEventList.at(i);
         if (pe.event) {
-            --pe.receiver->d_func()->postedEvents;
+            pe.receiver->d_func()->postedEvents.deref();
             pe.event->posted = false;
             delete pe.event;
         }
@@ -215,6 +223,11 @@ void QCoreApplicationPrivate::createEventDispatcher()
     if (qgetenv("QT_NO_GLIB").isEmpty() && QEventDispatcherGlib::versionSupported())
         eventDispatcher = new QEventDispatcherGlib(q);
     else
+#  endif
+#  if defined(Q_OS_LINUX)
+    if (qgetenv("QT_NO_EPOLL").isEmpty() && QEventDispatcherEPoll::isSupported())
+        eventDispatcher = new QEventDispatcherEPoll(q);
+    else
 #  endif
         eventDispatcher = new QEventDispatcherUNIX(q);
 #elif defined(Q_OS_WIN)
@@ -890,34 +903,62 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     {
         QMutexLocker locker(&data->postEventList.mutex);
+        data->postEventList.takeIncoming();
+        QCoreApplicationPrivate::addPostedEvent(data, receiver, event, priority);
+        data->canWait = false;
+    }
 
-        // if this is one of the compressible events, do compression
-        if (receiver->d_func()->postedEvents
-            && self && self->compressEvent(event, receiver, &data->postEventList)) {
-            return;
-        }
+    if (data->eventDispatcher)
+        data->eventDispatcher->wakeUp();
+}
 
-        event->posted = true;
-        ++receiver->d_func()->postedEvents;
-        if (event->type() == QEvent::DeferredDelete) {
-            // remember the current running eventloop
-            event->d = reinterpret_cast<QEventPrivate *>(quintptr(data->loopLevel));
-        }
+/*!
+    \since 4.4
 
-        if (data->postEventList.isEmpty() || data->postEventList.last().priority >= priority) {
-            // optimization: we can simply append if the last event in
-            // the queue has higher or equal priority
-            data->postEventList.append(QPostEvent(receiver, event, priority));
-        } else {
-            // insert event in descending priority order, using upper
-            // bound for a given priority (to ensure proper ordering
-            // of events with the same priority)
-            QPostEventList::iterator begin = data->postEventList.begin()
-                                             + data->postEventList.insertionOffset,
-                                       end = data->postEventList.end();
-            QPostEventList::iterator at = qUpperBound(begin, end, priority);
-            data->postEventList.insert(at, QPostEvent(receiver, event, priority));
-        }
+    Adds the \a events, with the object \a receiver as the receiver of
+    the events, to the event queue and returns immediately. This is
+    equivalent to calling postEvent() for each event in turn, but only
+    locks the receiving thread's event queue and wakes up its event loop
+    once.
+
+    The events must be allocated on the heap. The post event queue takes
+    ownership of the events and deletes them once they have been posted.
+    Events with equal \a priority are processed in the order of the list.
+
+    \threadsafe
+
+    \sa postEvent()
+*/
+void QCoreApplication::postEvents(QObject *receiver, const QList<QEvent *> &events, int priority)
+{
+    if (events.isEmpty())
+        return;
+
+    if (receiver == 0) {
+        qWarning("QCoreApplication::postEvents: Unexpected null receiver");
+        qDeleteAll(events);
+        return;
+    }
+
+    QReadLocker locker(QObjectPrivate::readWriteLock());
+    if (!QObjectPrivate::isValidObject(receiver)) {
+        qWarning("QCoreApplication::postEvents: Receiver is not a valid QObject");
+        qDeleteAll(events);
+        return;
+    }
+
+    QThreadData *data = receiver->d_func()->threadData;
+    if (!data) {
+        // posting during destruction? just delete the events to prevent a leak
+        qDeleteAll(events);
+        return;
+    }
+
+    {
+        QMutexLocker locker(&data->postEventList.mutex);
+        data->postEventList.takeIncoming();
+        for (int i = 0; i < events.count(); ++i)
+            QCoreApplicationPrivate::addPostedEvent(data, receiver, events.at(i), priority);
         data->canWait = false;
     }
 
@@ -925,6 +966,55 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         data->eventDispatcher->wakeUp();
 }
 
+/*!
+  \internal
+
+  Adds \a event for \a receiver to the post event list of \a data,
+  unless it is compressed away. The post event list must be locked.
+*/
+void QCoreApplicationPrivate::addPostedEvent(QThreadData *data, QObject *receiver,
+                                            QEvent *event, int priority)
+{
+    // if this is one of the compressible events, do compression
+    if (receiver->d_func()->postedEvents
+        && QCoreApplication::self
+        && QCoreApplication::self->compressEvent(event, receiver, &data->postEventList)) {
+        return;
+    }
+
+    event->posted = true;
+    receiver->d_func()->postedEvents.ref();
+    if (event->type() == QEvent::DeferredDelete) {
+        // remember the current running eventloop
+        event->d = reinterpret_cast<QEventPrivate *>(quintptr(data->loopLevel));
+    }
+
+    data->postEventList.addEvent(QPostEvent(receiver, event, priority));
+}
+
+/*!
+  \internal
+
+  Posts the meta call \a event to \a receiver without locking the
+  receiver's post event list. The event is not compressed, and has
+  Qt::NormalEventPriority.
+
+  The caller must hold the QObjectPrivate::signalSlotLock() for
+  reading and guarantee that \a receiver is not being destroyed; this
+  also keeps \a receiver from being moved to another thread.
+*/
+void QCoreApplicationPrivate::postMetaCallEvent(QObject *receiver, QMetaCallEvent *event)
+{
+    QThreadData *data = receiver->d_func()->threadData;
+    event->posted = true;
+    receiver->d_func()->postedEvents.ref();
+    data->postEventList.pushIncoming(receiver, event);
+    data->canWait = false;
+
+    if (data->eventDispatcher)
+        data->eventDispatcher->wakeUp();
+}
+
 /*!
   \internal
   Returns true if \a event was compressed away (possibly deleted) and should not be added to the list.
@@ -1022,6 +1112,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
 #endif
 
     QMutexLocker locker(&data->postEventList.mutex);
+    data->postEventList.takeIncoming();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1080,7 +1171,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
         QEvent * e = pe.event;
         QObject * r = pe.receiver;
 
-        --r->d_func()->postedEvents;
+        r->d_func()->postedEvents.deref();
         Q_ASSERT(r->d_func()->postedEvents >= 0);
 
         // next, update the data structure so that we're ready
@@ -1176,6 +1267,7 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 
     QThreadData *data = receiver ? receiver->d_func()->threadData : QThreadData::current();
     QMutexLocker locker(&data->postEventList.mutex);
+    data->postEventList.takeIncoming();
 
     // the QObject destructor calls this function directly.  this can
     // happen while the event loop is in the middle of posting events,
@@ -1191,7 +1283,7 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 
         if ((!receiver || pe.receiver == receiver)
             && (pe.event && (eventType == 0 || pe.event->type() == eventType))) {
-            --pe.receiver->d_func()->postedEvents;
+            pe.receiver->d_func()->postedEvents.deref();
 #ifdef QT3_SUPPORT
             if (pe.event->type() == QEvent::ChildInsertedRequest)
                 pe.receiver->d_func()->removePendingChildInsertedEvents(0);
@@ -1237,6 +1329,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     QMutexLocker locker(&data->postEventList.mutex);
+    data->postEventList.takeIncoming();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -1255,7 +1348,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
                      pe.receiver->metaObject()->className(),
                      pe.receiver->objectName().toLocal8Bit().data());
 #endif
-            --pe.receiver->d_func()->postedEvents;
+            pe.receiver->d_func()->postedEvents.deref();
             pe.event->posted = false;
             delete pe.event;
             const_cast<QPostEvent &>(pe).event = 0;
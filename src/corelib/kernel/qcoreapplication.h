@@ -76,6 +76,8 @@ public:
     static bool sendEvent(QObject *receiver, QEvent *event);
     static void postEvent(QObject *receiver, QEvent *event);
     static void postEvent(QObject *receiver, QEvent *event, int priority);
+    static void postEvents(QObject *receiver, const QList<QEvent *> &events,
+                           int priority = Qt::NormalEventPriority);
     static void sendPostedEvents(QObject *receiver, int event_type);
     static void sendPostedEvents();
     static void removePostedEvents(QObject *receiver);
@@ -56,6 +56,8 @@ public:
     static QThread *mainThread();
     static bool checkInstance(const char *method);
     static void sendPostedEvents(QObject *receiver, int event_type, QThreadData *data);
+    static void addPostedEvent(QThreadData *data, QObject *receiver, QEvent *event, int priority);
+    static void postMetaCallEvent(QObject *receiver, QMetaCallEvent *event);
 
 #if !defined (QT_NO_DEBUG) || defined (QT_MAC_FRAMEWORK_BUILD)
     void checkReceiverThread(QObject *receiver);
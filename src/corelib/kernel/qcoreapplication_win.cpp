@@ -187,6 +187,7 @@ void QCoreApplicationPrivate::removePostedTimerEvent(QObject *object, int timerI
     QThreadData *data = object->d_func()->threadData;
 
     QMutexLocker locker(&data->postEventList.mutex);
+    data->postEventList.takeIncoming();
     if (data->postEventList.size() == 0)
         return;
     for (int i = 0; i < data->postEventList.size(); ++i) {
@@ -195,7 +196,7 @@ void QCoreApplicationPrivate::removePostedTimerEvent(QObject *object, int timerI
             && pe.event
             && pe.event->type() == QEvent::Timer
             && static_cast<QTimerEvent *>(pe.event)->timerId() == timerId) {
-                --pe.receiver->d_func()->postedEvents;
+                pe.receiver->d_func()->postedEvents.deref();
                 pe.event->posted = false;
                 delete pe.event;
                 const_cast<QPostEvent &>(pe).event = 0;
@@ -222,6 +222,7 @@ QT_BEGIN_NAMESPACE
     \omitvalue ApplicationActivated
     \omitvalue ApplicationDeactivated
     \omitvalue MacGLWindowChange
+    \omitvalue FutureCallOut
 */
 
 /*!
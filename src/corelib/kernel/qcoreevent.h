@@ -221,6 +221,8 @@ public:
 
         MacGLWindowChange = 179,                // Internal! the window of the GLWidget has changed
 
+        FutureCallOut = 180,                    // Internal! QFutureWatcher notification
+
         User = 1000,                            // first user event id
         MaxUser = 65535                         // last user event id
     };
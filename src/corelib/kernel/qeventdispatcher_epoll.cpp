@@ -0,0 +1,398 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "qplatformdefs.h"
+
+#include "qcoreapplication.h"
+#include "qsocketnotifier.h"
+#include "qthread.h"
+
+#include "qeventdispatcher_epoll_p.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <sys/epoll.h>
+#include <sys/poll.h>
+
+QT_BEGIN_NAMESPACE
+
+// maximum number of events fetched by one epoll_wait() call; any
+// remaining ready descriptors are picked up on the next iteration
+enum { MaxEPollEvents = 256 };
+
+static const char *const notifierTypeNames[] = { "Read", "Write", "Exception" };
+
+static int createEPollFd()
+{
+    int fd = epoll_create(MaxEPollEvents);
+    if (fd != -1)
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    return fd;
+}
+
+QEventDispatcherEPollPrivate::QEventDispatcherEPollPrivate()
+{
+    epollFd = createEPollFd();
+    if (epollFd == -1) {
+        perror("QEventDispatcherEPollPrivate(): Unable to create epoll descriptor");
+        return;
+    }
+
+    epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.u64 = 0;
+    ev.data.fd = thread_pipe[0];
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, thread_pipe[0], &ev) == -1) {
+        perror("QEventDispatcherEPollPrivate(): Unable to watch thread pipe");
+        ::close(epollFd);
+        epollFd = -1;
+    }
+}
+
+QEventDispatcherEPollPrivate::~QEventDispatcherEPollPrivate()
+{
+    if (epollFd != -1)
+        ::close(epollFd);
+}
+
+/*
+    Adds, modifies or removes \a fd in the epoll set so that it matches the
+    notifiers in \a fdNotifiers. Returns false if the descriptor could not be
+    watched.
+*/
+bool QEventDispatcherEPollPrivate::updateEPoll(int fd, QEPollNotifiers *fdNotifiers, bool added)
+{
+    if (!fdNotifiers->pollable)
+        return true;
+
+    epoll_event ev;
+    ev.events = 0;
+    if (fdNotifiers->notifiers[0])
+        ev.events |= EPOLLIN;
+    if (fdNotifiers->notifiers[1])
+        ev.events |= EPOLLOUT;
+    if (fdNotifiers->notifiers[2])
+        ev.events |= EPOLLPRI;
+    ev.data.u64 = 0;
+    ev.data.fd = fd;
+
+    if (!ev.events) {
+        // ENOENT or EBADF means the descriptor was closed before its
+        // notifiers were disabled, and the kernel has dropped it already
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, &ev);
+        return true;
+    }
+
+    int ret = epoll_ctl(epollFd, added ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &ev);
+    if (ret == -1 && errno == ENOENT) {
+        // the descriptor was closed and reused while we still had notifiers for it
+        ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+    } else if (ret == -1 && errno == EEXIST) {
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+    }
+
+    if (ret == -1 && errno == EPERM) {
+        // regular files and directories cannot be polled; select() reports
+        // them as always ready, so do the same
+        fdNotifiers->pollable = false;
+        unpollableFds.append(fd);
+        return true;
+    }
+    return ret != -1;
+}
+
+bool QEventDispatcherEPollPrivate::setPending(QEPollNotifiers *fdNotifiers, int type)
+{
+    QSocketNotifier *notifier = fdNotifiers->notifiers[type];
+    if (!notifier)
+        return false;
+    if (fdNotifiers->pending & (1 << type))
+        return true;
+    fdNotifiers->pending |= (1 << type);
+
+    // We choose a random activation order to be more fair under high load.
+    // If a constant order is used and a peer early in the list can
+    // saturate the IO, it might grab our attention completely.
+    if (pendingNotifiers.isEmpty()) {
+        pendingNotifiers.append(notifier);
+    } else {
+        pendingNotifiers.insert((qrand() & 0xff) % (pendingNotifiers.size() + 1), notifier);
+    }
+    return true;
+}
+
+int QEventDispatcherEPollPrivate::activatePendingNotifiers()
+{
+    if (pendingNotifiers.isEmpty())
+        return 0;
+
+    // activate entries
+    int n_act = 0;
+    QEvent event(QEvent::SockAct);
+    while (!pendingNotifiers.isEmpty()) {
+        QSocketNotifier *notifier = pendingNotifiers.takeFirst();
+        QHash<int, QEPollNotifiers>::iterator it = notifiersByFd.find(notifier->socket());
+        if (it == notifiersByFd.end())
+            continue;
+
+        // the notifier may have been unregistered or replaced by a previous
+        // activation
+        const int type = notifier->type();
+        if (it->notifiers[type] != notifier || !(it->pending & (1 << type)))
+            continue;
+        it->pending &= ~(1 << type);
+
+        QCoreApplication::sendEvent(notifier, &event);
+        ++n_act;
+    }
+    return n_act;
+}
+
+int QEventDispatcherEPollPrivate::doSelect(QEventLoop::ProcessEventsFlags flags, timeval *timeout)
+{
+    if (epollFd == -1)
+        return QEventDispatcherUNIXPrivate::doSelect(flags, timeout);
+
+    timerList.updateCurrentTime();
+
+    const bool excludeSocketNotifiers = (flags & QEventLoop::ExcludeSocketNotifiers);
+
+    int msecs = -1;
+    if (timeout) {
+        // round up, so that we never wake up before the next timer is due
+        msecs = timeout->tv_sec * 1000 + (timeout->tv_usec + 999) / 1000;
+    }
+    if (!excludeSocketNotifiers && !unpollableFds.isEmpty())
+        msecs = 0;
+
+    epoll_event events[MaxEPollEvents];
+    int nsel;
+    do {
+        if (mainThread)
+            processUnixSignals();
+
+        if (excludeSocketNotifiers) {
+            // epoll is level triggered; waiting on the full set would return
+            // immediately while a socket is ready, so only watch for wake ups
+            pollfd pfd;
+            pfd.fd = thread_pipe[0];
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            nsel = ::poll(&pfd, 1, msecs);
+            if (nsel > 0) {
+                events[0].events = EPOLLIN;
+                events[0].data.fd = thread_pipe[0];
+            }
+        } else {
+            nsel = epoll_wait(epollFd, events, MaxEPollEvents, msecs);
+        }
+    } while (nsel == -1 && (errno == EINTR || errno == EAGAIN));
+
+    if (nsel == -1) {
+        // EBADF or EINVAL... shouldn't happen, so let's complain to stderr
+        // and hope someone sends us a bug report
+        perror("epoll_wait");
+        nsel = 0;
+    }
+
+    int nevents = 0;
+    for (int i = 0; i < nsel; ++i) {
+        const int fd = events[i].data.fd;
+        const uint revents = events[i].events;
+
+        if (fd == thread_pipe[0]) {
+            // some other thread woke us up... consume the data on the thread
+            // pipe so that epoll_wait doesn't immediately return next time
+            char c[16];
+            while (::read(thread_pipe[0], c, sizeof(c)) > 0)
+                ;
+            if (!wakeUps.testAndSetRelease(1, 0)) {
+                // hopefully, this is dead code
+                qWarning("QEventDispatcherEPoll: internal error, wakeUps.testAndSetRelease(1, 0) failed!");
+            }
+            ++nevents;
+            continue;
+        }
+
+        QHash<int, QEPollNotifiers>::iterator it = notifiersByFd.find(fd);
+        if (it == notifiersByFd.end())
+            continue;
+
+        // select() reports errors and hang ups as readable and writable
+        bool activated = false;
+        if (revents & (EPOLLIN | EPOLLERR | EPOLLHUP))
+            activated |= setPending(&it.value(), 0);
+        if (revents & (EPOLLOUT | EPOLLERR | EPOLLHUP))
+            activated |= setPending(&it.value(), 1);
+        if ((revents & EPOLLPRI) || (!activated && (revents & (EPOLLERR | EPOLLHUP)))) {
+            // epoll always reports errors and hang ups; if nothing else wants
+            // them, let the exception notifier handle them instead of spinning
+            setPending(&it.value(), 2);
+        }
+    }
+
+    if (!excludeSocketNotifiers) {
+        for (int i = 0; i < unpollableFds.size(); ++i) {
+            QHash<int, QEPollNotifiers>::iterator it = notifiersByFd.find(unpollableFds.at(i));
+            if (it == notifiersByFd.end())
+                continue;
+            setPending(&it.value(), 0);
+            setPending(&it.value(), 1);
+        }
+    }
+
+    return (nevents + activatePendingNotifiers());
+}
+
+/*!
+    \internal
+    \class QEventDispatcherEPoll
+
+    \brief The QEventDispatcherEPoll class is a QEventDispatcherUNIX that
+    waits for socket notifiers with epoll instead of select().
+
+    Socket notifiers are added to and removed from the kernel's epoll set
+    when they are enabled and disabled, so each wake up costs time
+    proportional to the number of ready descriptors rather than to the
+    number of registered ones, and descriptors are not limited by
+    FD_SETSIZE.
+
+    QCoreApplication and QThread use this dispatcher on Linux whenever
+    epoll is available and the Glib event dispatcher is not used. Set the
+    \c QT_NO_EPOLL environment variable to fall back to select().
+*/
+
+QEventDispatcherEPoll::QEventDispatcherEPoll(QObject *parent)
+    : QEventDispatcherUNIX(*new QEventDispatcherEPollPrivate, parent)
+{ }
+
+QEventDispatcherEPoll::QEventDispatcherEPoll(QEventDispatcherEPollPrivate &dd, QObject *parent)
+    : QEventDispatcherUNIX(dd, parent)
+{ }
+
+QEventDispatcherEPoll::~QEventDispatcherEPoll()
+{ }
+
+/*!
+    Returns true if the running kernel supports epoll; otherwise returns false.
+*/
+bool QEventDispatcherEPoll::isSupported()
+{
+    int fd = epoll_create(1);
+    if (fd == -1)
+        return false;
+    ::close(fd);
+    return true;
+}
+
+/*!
+    Returns true if socket notifiers are waited for with epoll; returns
+    false if creating the epoll set failed and the dispatcher fell back
+    to select().
+*/
+bool QEventDispatcherEPoll::usesEPoll() const
+{
+    Q_D(const QEventDispatcherEPoll);
+    return d->epollFd != -1;
+}
+
+void QEventDispatcherEPoll::registerSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    Q_D(QEventDispatcherEPoll);
+    if (d->epollFd == -1) {
+        QEventDispatcherUNIX::registerSocketNotifier(notifier);
+        return;
+    }
+
+    int sockfd = notifier->socket();
+    int type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (sockfd < 0) {
+        qWarning("QSocketNotifier: Internal error");
+        return;
+    } else if (notifier->thread() != thread()
+               || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifiers cannot be enabled from another thread");
+        return;
+    }
+#endif
+
+    QHash<int, QEPollNotifiers>::iterator it = d->notifiersByFd.find(sockfd);
+    const bool added = (it == d->notifiersByFd.end());
+    if (added) {
+        QEPollNotifiers fdNotifiers;
+        fdNotifiers.notifiers[0] = fdNotifiers.notifiers[1] = fdNotifiers.notifiers[2] = 0;
+        fdNotifiers.pending = 0;
+        fdNotifiers.pollable = true;
+        it = d->notifiersByFd.insert(sockfd, fdNotifiers);
+    } else if (it->notifiers[type]) {
+        qWarning("QSocketNotifier: Multiple socket notifiers for "
+                 "same socket %d and type %s", sockfd, notifierTypeNames[type]);
+        if (it->pending & (1 << type)) {
+            it->pending &= ~(1 << type);
+            d->pendingNotifiers.removeAll(it->notifiers[type]);
+        }
+    }
+    it->notifiers[type] = notifier;
+
+    if (!d->updateEPoll(sockfd, &it.value(), added)) {
+        qWarning("QSocketNotifier: Invalid socket %d and type '%s', disabling...",
+                 sockfd, notifierTypeNames[type]);
+        it->notifiers[type] = 0;
+        if (!it->notifiers[0] && !it->notifiers[1] && !it->notifiers[2])
+            d->notifiersByFd.erase(it);
+    }
+}
+
+void QEventDispatcherEPoll::unregisterSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    Q_D(QEventDispatcherEPoll);
+    if (d->epollFd == -1) {
+        QEventDispatcherUNIX::unregisterSocketNotifier(notifier);
+        return;
+    }
+
+    int sockfd = notifier->socket();
+    int type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (sockfd < 0) {
+        qWarning("QSocketNotifier: Internal error");
+        return;
+    } else if (notifier->thread() != thread()
+               || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifiers cannot be disabled from another thread");
+        return;
+    }
+#endif
+
+    QHash<int, QEPollNotifiers>::iterator it = d->notifiersByFd.find(sockfd);
+    if (it == d->notifiersByFd.end() || it->notifiers[type] != notifier) // not found
+        return;
+
+    it->notifiers[type] = 0;
+    if (it->pending & (1 << type)) {
+        it->pending &= ~(1 << type);
+        d->pendingNotifiers.removeAll(notifier); // remove from activation list
+    }
+
+    d->updateEPoll(sockfd, &it.value(), false);
+    if (!it->notifiers[0] && !it->notifiers[1] && !it->notifiers[2]) {
+        if (!it->pollable)
+            d->unpollableFds.removeAll(sockfd);
+        d->notifiersByFd.erase(it);
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef QEVENTDISPATCHER_EPOLL_P_H
+#define QEVENTDISPATCHER_EPOLL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "private/qeventdispatcher_unix_p.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+
+QT_BEGIN_NAMESPACE
+
+class QEventDispatcherEPollPrivate;
+
+class Q_CORE_EXPORT QEventDispatcherEPoll : public QEventDispatcherUNIX
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QEventDispatcherEPoll)
+
+public:
+    explicit QEventDispatcherEPoll(QObject *parent = 0);
+    ~QEventDispatcherEPoll();
+
+    void registerSocketNotifier(QSocketNotifier *notifier);
+    void unregisterSocketNotifier(QSocketNotifier *notifier);
+
+    static bool isSupported();
+    bool usesEPoll() const;
+
+protected:
+    QEventDispatcherEPoll(QEventDispatcherEPollPrivate &dd, QObject *parent = 0);
+};
+
+// all socket notifiers registered for one file descriptor
+struct QEPollNotifiers
+{
+    QSocketNotifier *notifiers[3]; // read, write and exception
+    uint pending;                  // bit per type, set while queued for activation
+    bool pollable;                 // false for regular files, which epoll rejects
+};
+
+class Q_CORE_EXPORT QEventDispatcherEPollPrivate : public QEventDispatcherUNIXPrivate
+{
+    Q_DECLARE_PUBLIC(QEventDispatcherEPoll)
+
+public:
+    QEventDispatcherEPollPrivate();
+    ~QEventDispatcherEPollPrivate();
+
+    int doSelect(QEventLoop::ProcessEventsFlags flags, timeval *timeout);
+
+    bool updateEPoll(int fd, QEPollNotifiers *fdNotifiers, bool added);
+    bool setPending(QEPollNotifiers *fdNotifiers, int type);
+    int activatePendingNotifiers();
+
+    int epollFd;
+
+    // socket notifiers by file descriptor
+    QHash<int, QEPollNotifiers> notifiersByFd;
+
+    // descriptors that cannot be added to the epoll set; always ready
+    QList<int> unpollableFds;
+
+    // pending socket notifiers list
+    QList<QSocketNotifier *> pendingNotifiers;
+};
+
+QT_END_NAMESPACE
+
+#endif // QEVENTDISPATCHER_EPOLL_P_H
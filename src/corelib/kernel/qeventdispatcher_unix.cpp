@@ -93,8 +93,19 @@ QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
     close(thread_pipe[0]);
     close(thread_pipe[1]);
 
-    // cleanup timers
-    qDeleteAll(timerList);
+}
+
+void QEventDispatcherUNIXPrivate::processUnixSignals()
+{
+    while (signal_received) {
+        signal_received = 0;
+        for (int i = 0; i < NSIG; ++i) {
+            if (signals_fired[i]) {
+                signals_fired[i] = 0;
+                emit QCoreApplication::instance()->unixSignal(i);
+            }
+        }
+    }
 }
 
 int QEventDispatcherUNIXPrivate::doSelect(QEventLoop::ProcessEventsFlags flags, timeval *timeout)
@@ -106,17 +117,8 @@ int QEventDispatcherUNIXPrivate::doSelect(QEventLoop::ProcessEventsFlags flags,
 
     int nsel;
     do {
-        if (mainThread) {
-            while (signal_received) {
-                signal_received = 0;
-                for (int i = 0; i < NSIG; ++i) {
-                    if (signals_fired[i]) {
-                        signals_fired[i] = 0;
-                        emit QCoreApplication::instance()->unixSignal(i);
-                    }
-                }
-            }
-        }
+        if (mainThread)
+            processUnixSignals();
 
         // Process timers and socket notifiers - the common UNIX stuff
         int highest = 0;
@@ -223,8 +225,10 @@ int QEventDispatcherUNIXPrivate::doSelect(QEventLoop::ProcessEventsFlags flags,
 }
 
 /*
- * Internal functions for manipulating timer data structures.  The
- * timerBitVec array is used for keeping track of timer identifiers.
+ * Internal functions for manipulating timer data structures.  Timers
+ * are kept in a binary heap ordered by timeout, with hashes for looking
+ * them up by identifier and by object, so that registering, killing and
+ * activating a timer is cheap even with thousands of timers.
  */
 
 QTimerInfoList::QTimerInfoList()
@@ -262,6 +266,12 @@ QTimerInfoList::QTimerInfoList()
 #endif
 
     firstTimerInfo = currentTimerInfo = 0;
+    nextSerial = 0;
+}
+
+QTimerInfoList::~QTimerInfoList()
+{
+    qDeleteAll(heap);
 }
 
 timeval QTimerInfoList::updateCurrentTime()
@@ -358,17 +368,126 @@ void QTimerInfoList::repairTimersIfNeeded()
 #endif
 
 /*
-  insert timer info into list
+  Timers with an interval of at least 20 ms are allowed to fire up to 5%
+  late, which lets us round their timeout up to a common boundary. Timers
+  that expire close together then fire in a single wakeup.
 */
-void QTimerInfoList::timerInsert(QTimerInfo *ti)
+static void calculateCoarseTimeout(QTimerInfo *t)
+{
+    t->timeout = t->due;
+
+    const int msecs = t->interval.tv_sec * 1000 + t->interval.tv_usec / 1000;
+    const int slack = msecs / 20;
+    if (slack < 1)
+        return;
+
+    static const int boundaries[] = { 1000, 500, 100, 50, 10, 5, 1 };
+    int granularity = 1;
+    for (uint i = 0; i < sizeof(boundaries) / sizeof(boundaries[0]); ++i) {
+        if (boundaries[i] <= slack) {
+            granularity = boundaries[i];
+            break;
+        }
+    }
+
+    const qint64 granularityUsecs = qint64(granularity) * 1000;
+    qint64 usecs = qint64(t->due.tv_sec) * 1000000 + t->due.tv_usec;
+    const qint64 remainder = usecs % granularityUsecs;
+    if (remainder == 0)
+        return;
+    usecs += granularityUsecs - remainder;
+    t->timeout.tv_sec = usecs / 1000000;
+    t->timeout.tv_usec = usecs % 1000000;
+}
+
+inline bool QTimerInfoList::lessThan(const QTimerInfo *t1, const QTimerInfo *t2) const
+{
+    if (t1->timeout < t2->timeout)
+        return true;
+    if (t2->timeout < t1->timeout)
+        return false;
+    // timers with equal timeouts fire in the order they were inserted
+    return int(t1->serial - t2->serial) < 0;
+}
+
+void QTimerInfoList::siftUp(int index)
 {
-    int index = size();
-    while (index--) {
-        register const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
+    QTimerInfo *t = heap.at(index);
+    while (index > 0) {
+        const int parent = (index - 1) / 2;
+        QTimerInfo *p = heap.at(parent);
+        if (!lessThan(t, p))
+            break;
+        heap[index] = p;
+        p->heapIndex = index;
+        index = parent;
+    }
+    heap[index] = t;
+    t->heapIndex = index;
+}
+
+void QTimerInfoList::siftDown(int index)
+{
+    const int size = heap.size();
+    QTimerInfo *t = heap.at(index);
+    for (;;) {
+        int child = 2 * index + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && lessThan(heap.at(child + 1), heap.at(child)))
+            ++child;
+        QTimerInfo *c = heap.at(child);
+        if (!lessThan(c, t))
             break;
+        heap[index] = c;
+        c->heapIndex = index;
+        index = child;
     }
-    insert(index+1, ti);
+    heap[index] = t;
+    t->heapIndex = index;
+}
+
+/*
+  insert timer info into the heap
+*/
+void QTimerInfoList::timerInsert(QTimerInfo *ti)
+{
+    ti->serial = nextSerial++;
+    heap.append(ti);
+    siftUp(heap.size() - 1);
+}
+
+/*
+  remove timer info from the heap, without deleting it
+*/
+void QTimerInfoList::timerRemove(QTimerInfo *ti)
+{
+    const int index = ti->heapIndex;
+    Q_ASSERT(index >= 0 && index < heap.size() && heap.at(index) == ti);
+    QTimerInfo *last = heap.last();
+    heap.resize(heap.size() - 1);
+    ti->heapIndex = -1;
+    if (last == ti)
+        return;
+    heap[index] = last;
+    last->heapIndex = index;
+    if (index > 0 && lessThan(last, heap.at((index - 1) / 2)))
+        siftUp(index);
+    else
+        siftDown(index);
+}
+
+/*
+  remove timer info from the heap and delete it
+*/
+void QTimerInfoList::timerDelete(QTimerInfo *t)
+{
+    timerRemove(t);
+    if (t == firstTimerInfo)
+        firstTimerInfo = 0;
+    if (t == currentTimerInfo)
+        currentTimerInfo = 0;
+    delete t;
 }
 
 /*
@@ -376,10 +495,11 @@ void QTimerInfoList::timerInsert(QTimerInfo *ti)
 */
 void QTimerInfoList::timerRepair(const timeval &diff)
 {
-    // repair all timers
-    for (int i = 0; i < size(); ++i) {
-        register QTimerInfo *t = at(i);
+    // repair all timers; this keeps the heap order intact
+    for (int i = 0; i < heap.size(); ++i) {
+        register QTimerInfo *t = heap.at(i);
         t->timeout = t->timeout - diff;
+        t->due = t->due - diff;
     }
 }
 
@@ -414,49 +534,45 @@ void QTimerInfoList::registerTimer(int timerId, int interval, QObject *object)
     t->id = timerId;
     t->interval.tv_sec  = interval / 1000;
     t->interval.tv_usec = (interval % 1000) * 1000;
-    t->timeout = updateCurrentTime() + t->interval;
+    t->due = updateCurrentTime() + t->interval;
+    calculateCoarseTimeout(t);
     t->obj = object;
     t->inTimerEvent = false;
 
     timerInsert(t);
+    timersById.insert(timerId, t);
+    timersByObject.insert(object, t);
 }
 
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
+    QTimerInfo *t = timersById.take(timerId);
+    if (!t)
+        return false; // id not found
+
     // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        register QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = 0;
-            if (t == currentTimerInfo)
-                currentTimerInfo = 0;
-            delete t;
-            return true;
+    QMultiHash<QObject *, QTimerInfo *>::iterator it = timersByObject.find(t->obj);
+    while (it != timersByObject.end() && it.key() == t->obj) {
+        if (it.value() == t) {
+            timersByObject.erase(it);
+            break;
         }
+        ++it;
     }
-    // id not found
-    return false;
+    timerDelete(t);
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < count(); ++i) {
-        register QTimerInfo *t = at(i);
-        if (t->obj == object) {
-            // object found
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = 0;
-            if (t == currentTimerInfo)
-                currentTimerInfo = 0;
-            delete t;
-            // move back one so that we don't skip the new current item
-            --i;
-        }
+    QMultiHash<QObject *, QTimerInfo *>::iterator it = timersByObject.find(object);
+    while (it != timersByObject.end() && it.key() == object) {
+        QTimerInfo *t = it.value();
+        it = timersByObject.erase(it);
+        timersById.remove(t->id);
+        timerDelete(t);
     }
     return true;
 }
@@ -464,10 +580,11 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
 QList<QPair<int, int> > QTimerInfoList::registeredTimers(QObject *object) const
 {
     QList<QPair<int, int> > list;
-    for (int i = 0; i < count(); ++i) {
-        register const QTimerInfo * const t = at(i);
-        if (t->obj == object)
-            list << QPair<int, int>(t->id, t->interval.tv_sec * 1000 + t->interval.tv_usec / 1000);
+    QMultiHash<QObject *, QTimerInfo *>::const_iterator it = timersByObject.find(object);
+    while (it != timersByObject.end() && it.key() == object) {
+        register const QTimerInfo * const t = it.value();
+        list.prepend(QPair<int, int>(t->id, t->interval.tv_sec * 1000 + t->interval.tv_usec / 1000));
+        ++it;
     }
     return list;
 }
@@ -512,13 +629,14 @@ int QTimerInfoList::activateTimers()
             firstTimerInfo = currentTimerInfo;
         }
 
-        // remove from list
-        removeFirst();
+        // remove from heap
+        timerRemove(currentTimerInfo);
 
         // determine next timeout time
-        currentTimerInfo->timeout += currentTimerInfo->interval;
-        if (currentTimerInfo->timeout < currentTime)
-            currentTimerInfo->timeout = currentTime + currentTimerInfo->interval;
+        currentTimerInfo->due += currentTimerInfo->interval;
+        if (currentTimerInfo->due < currentTime)
+            currentTimerInfo->due = currentTime + currentTimerInfo->interval;
+        calculateCoarseTimeout(currentTimerInfo);
 
         // reinsert timer
         timerInsert(currentTimerInfo);
@@ -26,7 +26,9 @@
 //
 
 #include "QtCore/qabstracteventdispatcher.h"
+#include "QtCore/qhash.h"
 #include "QtCore/qlist.h"
+#include "QtCore/qvector.h"
 #include "private/qabstracteventdispatcher_p.h"
 #include "private/qpodlist_p.h"
 
@@ -82,11 +84,15 @@ struct QTimerInfo {
     int id;           // - timer identifier
     timeval interval; // - timer interval
     timeval timeout;  // - when to sent event
+    timeval due;      // - exact expiry time, before coalescing
     QObject *obj;     // - object to receive event
     bool inTimerEvent;
+    uint serial;      // - insertion order, orders timers with equal timeouts
+    int heapIndex;    // - position in the timer heap
 };
 
-class QTimerInfoList : public QList<QTimerInfo*>
+// registered timers, kept in a binary heap ordered by timeout
+class QTimerInfoList
 {
 #if (_POSIX_MONOTONIC_CLOCK-0 <= 0)
     bool useMonotonicTimers;
@@ -102,8 +108,20 @@ class QTimerInfoList : public QList<QTimerInfo*>
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo, *currentTimerInfo;
 
+    QVector<QTimerInfo *> heap;
+    QHash<int, QTimerInfo *> timersById;
+    QMultiHash<QObject *, QTimerInfo *> timersByObject;
+    uint nextSerial;
+
+    inline bool lessThan(const QTimerInfo *t1, const QTimerInfo *t2) const;
+    void siftUp(int index);
+    void siftDown(int index);
+    void timerRemove(QTimerInfo *);
+    void timerDelete(QTimerInfo *);
+
 public:
     QTimerInfoList();
+    ~QTimerInfoList();
 
     void getTime(timeval &t);
 
@@ -113,6 +131,11 @@ public:
     // must call updateCurrentTime() first!
     void repairTimersIfNeeded();
 
+    inline bool isEmpty() const { return heap.isEmpty(); }
+    inline int count() const { return heap.count(); }
+    // the timer that expires first
+    inline QTimerInfo *first() const { return heap.first(); }
+
     bool timerWait(timeval &);
     void timerInsert(QTimerInfo *);
     void timerRepair(const timeval &);
@@ -194,7 +217,8 @@ public:
     QEventDispatcherUNIXPrivate();
     ~QEventDispatcherUNIXPrivate();
 
-    int doSelect(QEventLoop::ProcessEventsFlags flags, timeval *timeout);
+    virtual int doSelect(QEventLoop::ProcessEventsFlags flags, timeval *timeout);
+    void processUnixSignals();
 
     bool mainThread;
     int thread_pipe[2];
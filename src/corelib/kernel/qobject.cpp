@@ -31,6 +31,12 @@
 
 #include <new>
 
+#if defined(Q_OS_UNIX)
+#  include <sched.h>
+#elif defined(Q_OS_WIN)
+#  include <qt_windows.h>
+#endif
+
 #include <ctype.h>
 #include <limits.h>
 
@@ -193,16 +199,63 @@ void QObjectPrivate::removePendingChildInsertedEvents(QObject *child)
 #endif
 
 
+QObjectPrivate::ConnectionList &QObjectPrivate::ConnectionList::operator=(const ConnectionList &other)
+{
+    Data *x = other.d;
+    if (x)
+        x->ref.ref();
+    qSwap(x, d);
+    if (x && !x->ref.deref())
+        freeData(x);
+    return *this;
+}
+
+QObjectPrivate::ConnectionList::Data *QObjectPrivate::ConnectionList::allocateData(int alloc)
+{
+    Data *data = static_cast<Data *>(qMalloc(sizeof(Data) + (alloc - 1) * sizeof(Connection *)));
+    Q_CHECK_PTR(data);
+    data->ref = 1;
+    data->count = 0;
+    data->alloc = alloc;
+    return data;
+}
+
+void QObjectPrivate::ConnectionList::freeData(Data *data)
+{
+    for (int i = 0; i < data->count; ++i) {
+        QObjectPrivate::Connection *c = data->connections[i];
+        if (!c->ref.deref()) {
+            if (c->argumentTypes && c->argumentTypes != &DIRECT_CONNECTION_ONLY)
+                qFree(c->argumentTypes);
+            delete c;
+        }
+    }
+    qFree(data);
+}
+
+/*
+    A snapshot of the connection lists of a sender. Emitting a signal
+    walks the snapshot without holding the signalSlotLock(). Connecting
+    appends to the list of the signal in place when there is room, and
+    otherwise publishes a new snapshot with a larger block for that
+    signal; the lists of the other signals are shared. Disconnecting only
+    clears the receiver of the connection, and dead connections are
+    dropped when the block is next replaced.
+*/
 class QObjectConnectionListVector : public QVector<QObjectPrivate::ConnectionList>
 {
 public:
-    bool orphaned;
-    bool activating;
-    bool dirty;
+    QAtomicInt ref;
+    volatile bool orphaned;
     QObjectPrivate::ConnectionList allsignals;
 
     QObjectConnectionListVector()
-        : QVector<QObjectPrivate::ConnectionList>(), orphaned(false), activating(false), dirty(false)
+        : QVector<QObjectPrivate::ConnectionList>(), ref(1), orphaned(false)
+    { }
+
+    QObjectConnectionListVector(const QObjectConnectionListVector &other)
+        : QVector<QObjectPrivate::ConnectionList>(other), ref(1), orphaned(false),
+          allsignals(other.allsignals)
     { }
 
     const QObjectPrivate::ConnectionList &at(int at) const
@@ -219,6 +272,95 @@ public:
     }
 };
 
+/*
+    Returns the current connection lists of this object with a reference
+    held, or 0 if nothing is connected. The caller must pass the result
+    to releaseConnectionLists() when done.
+
+    This does not lock. A reader registers in the reader count of the
+    current epoch before loading the pointer, and publishConnectionLists()
+    advances the epoch after replacing the pointer. retireConnectionLists()
+    then only has to wait for the readers of the previous epoch, which are
+    the ones that may have loaded the old pointer without referencing it
+    yet.
+
+    There are only two reader counts, so the count of the previous epoch
+    is reused by the next one. publishConnectionLists() waits for it to
+    drain before advancing the epoch; otherwise a reader still registered
+    there could hold a pointer that was published and retired two epochs
+    ago.
+*/
+QObjectConnectionListVector *QObjectPrivate::acquireConnectionLists() const
+{
+    if (!connectionLists)
+        return 0;
+
+    int epoch;
+    forever {
+        epoch = connectionListsEpoch;
+        connectionListsReaders[epoch & 1].ref();
+        if (connectionListsEpoch == epoch)
+            break;
+        connectionListsReaders[epoch & 1].deref();
+    }
+    QObjectConnectionListVector *lists = connectionLists;
+    if (lists)
+        lists->ref.ref();
+    connectionListsReaders[epoch & 1].deref();
+    return lists;
+}
+
+void QObjectPrivate::releaseConnectionLists(QObjectConnectionListVector *lists)
+{
+    if (!lists->ref.deref())
+        delete lists;
+}
+
+static void waitForConnectionListReaders(const QAtomicInt &readers)
+{
+    while (readers != 0) {
+        // readers only stay registered for a few instructions
+#if defined(Q_OS_UNIX)
+        sched_yield();
+#elif defined(Q_OS_WIN)
+        Sleep(0);
+#endif
+    }
+}
+
+/*
+    Replaces the connection lists with \a lists, which may be 0, and
+    returns the old lists. Must be called with the signalSlotLock() locked
+    for writing. Emissions may still be loading the old pointer, so the
+    caller has to pass it to retireConnectionLists() together with the
+    \a epoch, after unlocking.
+*/
+QObjectConnectionListVector *QObjectPrivate::publishConnectionLists(QObjectConnectionListVector *lists,
+                                                                    int *epoch)
+{
+    QObjectConnectionListVector *old = connectionLists.fetchAndStoreOrdered(lists);
+    if (old) {
+        // the epoch only changes with the lock held, so it is stable here
+        int current = connectionListsEpoch;
+        waitForConnectionListReaders(connectionListsReaders[(current + 1) & 1]);
+        *epoch = connectionListsEpoch.fetchAndAddOrdered(1);
+    }
+    return old;
+}
+
+/*
+    Waits for the readers of \a epoch, the ones that may have loaded
+    \a lists without referencing it yet, and releases \a lists. Must not
+    be called with the signalSlotLock() locked.
+*/
+void QObjectPrivate::retireConnectionLists(QObjectConnectionListVector *lists, int epoch) const
+{
+    if (!lists)
+        return;
+    waitForConnectionListReaders(connectionListsReaders[epoch & 1]);
+    releaseConnectionLists(lists);
+}
+
 bool QObjectPrivate::isSender(const QObject *receiver, const char *signal) const
 {
     Q_Q(const QObject);
@@ -230,8 +372,8 @@ bool QObjectPrivate::isSender(const QObject *receiver, const char *signal) const
         if (signal_index < connectionLists->count()) {
             const ConnectionList &connectionList = connectionLists->at(signal_index);
             for (int i = 0; i < connectionList.count(); ++i) {
-                const QObjectPrivate::Connection &c = connectionList.at(i);
-                if (c.receiver && c.receiver == receiver)
+                const QObjectPrivate::Connection *c = connectionList.at(i);
+                if (c->receiver && c->receiver == receiver)
                     return true;
             }
         }
@@ -251,9 +393,9 @@ QObjectList QObjectPrivate::receiverList(const char *signal) const
         if (signal_index < connectionLists->count()) {
             const ConnectionList &connectionList = connectionLists->at(signal_index);
             for (int i = 0; i < connectionList.count(); ++i) {
-                const QObjectPrivate::Connection &c = connectionList.at(i);
-                if (c.receiver)
-                    returnValue << c.receiver;
+                const QObjectPrivate::Connection *c = connectionList.at(i);
+                if (c->receiver)
+                    returnValue << c->receiver;
             }
         }
     }
@@ -269,28 +411,54 @@ QObjectList QObjectPrivate::senderList() const
     return returnValue;
 }
 
-void QObjectPrivate::addConnection(int signal, Connection *c)
-{
-    if (!connectionLists)
-        connectionLists = new QObjectConnectionListVector();
-    if (signal >= connectionLists->count())
-        connectionLists->resize(signal + 1);
-
-    ConnectionList &connectionList = (*connectionLists)[signal];
-    connectionList.append(*c);
+/*
+    Adds \a c to the connections of \a signal. If a new snapshot had to
+    be published, returns the old one, to be passed to
+    retireConnectionLists() with \a epoch once the lock is released.
+*/
+QObjectConnectionListVector *QObjectPrivate::addConnection(int signal, Connection *c, int *epoch)
+{
+    QObjectConnectionListVector *old = connectionLists;
+    ConnectionList::Data *data = 0;
+    if (old && signal < old->count())
+        data = old->at(signal).d;
+
+    c->ref.ref();
+    if (data && data->count < data->alloc) {
+        // emissions only read up to the count, so publish the
+        // connection before the count
+        const int count = data->count;
+        data->connections[count] = c;
+        data->count.fetchAndStoreRelease(count + 1);
+        return 0;
+    }
 
-    if (connectionLists->dirty && !connectionLists->activating) {
-        // remove broken connections
-        for (signal = -1; signal < connectionLists->count(); ++signal) {
-            QObjectPrivate::ConnectionList &connectionList = (*connectionLists)[signal];
-            for (int i = 0; i < connectionList.count(); ++i) {
-                const QObjectPrivate::Connection &c = connectionList.at(i);
-                if (!c.receiver)
-                    connectionList.removeAt(i--);
-            }
+    // the block is full: move the live connections into one twice their
+    // size, so that appending stays amortized constant time
+    int live = 0;
+    for (int i = 0; data && i < data->count; ++i) {
+        if (data->connections[i]->receiver)
+            ++live;
+    }
+    ConnectionList::Data *newData = ConnectionList::allocateData(qMax(4, 2 * (live + 1)));
+    int count = 0;
+    for (int i = 0; data && i < data->count; ++i) {
+        Connection *oldConnection = data->connections[i];
+        if (oldConnection->receiver) {
+            oldConnection->ref.ref();
+            newData->connections[count++] = oldConnection;
         }
-        connectionLists->dirty = false;
     }
+    newData->connections[count++] = c;
+    newData->count = count;
+
+    QObjectConnectionListVector *lists = old ? new QObjectConnectionListVector(*old)
+                                             : new QObjectConnectionListVector();
+    if (signal >= lists->count())
+        lists->resize(signal + 1);
+    (*lists)[signal] = ConnectionList(newData);
+
+    return publishConnectionLists(lists, epoch);
 }
 
 void QObjectPrivate::removeReceiver(int signal, QObject *receiver)
@@ -301,19 +469,46 @@ void QObjectPrivate::removeReceiver(int signal, QObject *receiver)
     if (signal >= connectionLists->count())
         return;
 
-    ConnectionList &connectionList = (*connectionLists)[signal];
+    const ConnectionList &connectionList = connectionLists->at(signal);
     for (int i = 0; i < connectionList.count(); ++i) {
-        Connection &c = connectionList[i];
-        if (c.receiver == receiver) {
-            c.receiver = 0;
-            if (c.argumentTypes && c.argumentTypes != &DIRECT_CONNECTION_ONLY) {
-                qFree(c.argumentTypes);
-                c.argumentTypes = 0;
+        Connection *c = connectionList.at(i);
+        if (c->receiver == receiver) {
+            c->receiver = 0;
+            if (c->argumentTypes && c->argumentTypes != &DIRECT_CONNECTION_ONLY) {
+                qFree(c->argumentTypes);
+                c->argumentTypes = 0;
             }
         }
     }
 }
 
+/*
+    Updates the receiver thread data stored in the connections to this
+    object and its children. Must be called with the signalSlotLock()
+    locked for writing.
+*/
+void QObjectPrivate::setConnectionsThreadData_helper(QThreadData *targetData)
+{
+    Q_Q(QObject);
+    for (int i = 0; i < senders.count(); ++i) {
+        const Sender &s = senders.at(i);
+        QObjectConnectionListVector *lists = s.sender->d_func()->connectionLists;
+        if (!lists || s.signal >= lists->count())
+            continue;
+        const ConnectionList &connectionList = lists->at(s.signal);
+        for (int j = 0; j < connectionList.count(); ++j) {
+            Connection *c = connectionList.at(j);
+            if (c->receiver == q)
+                c->receiverThreadData = targetData;
+        }
+    }
+
+    for (int i = 0; i < children.size(); ++i) {
+        QObject *child = children.at(i);
+        child->d_func()->setConnectionsThreadData_helper(targetData);
+    }
+}
+
 void QObjectPrivate::refSender(QObject *sender, int signal)
 {
     for (int i = 0; i < senders.count(); ++i) {
@@ -440,7 +635,8 @@ void QObjectPrivate::clearGuards(QObject *object)
 QMetaCallEvent::QMetaCallEvent(int id, const QObject *sender, int signalId,
                                int nargs, int *types, void **args, QSemaphore *semaphore)
     : QEvent(MetaCall), id_(id), sender_(sender), signalId_(signalId),
-      nargs_(nargs), types_(types), args_(args), semaphore_(semaphore)
+      nargs_(nargs), types_(types), args_(args), semaphore_(semaphore),
+      postedReceiver_(0), nextPosted_(0)
 { }
 
 /*! \internal
@@ -466,6 +662,165 @@ int QMetaCallEvent::placeMetaCall(QObject *object)
     return object->qt_metacall(QMetaObject::InvokeMetaMethod, id_, args_);
 }
 
+/*
+    Queued connections allocate a QMetaCallEvent in the emitting thread
+    and delete it in the receiving thread. The memory is recycled through
+    a pool owned by the allocating thread: deleted events are pushed onto
+    the pool's returned list with a single atomic operation, and the
+    owner takes the whole list back when its own free list runs dry.
+    Only the owner pops blocks, so the lists do not suffer from ABA.
+*/
+struct QMetaCallEventBlock
+{
+    QMetaCallEventPool *pool;   // 0 if not pooled
+    QMetaCallEventBlock *next;
+};
+
+// keeps the event storage aligned
+union QMetaCallEventBlockHeader
+{
+    QMetaCallEventBlock block;
+    double alignment;
+    void *alignment2;
+};
+
+class QMetaCallEventPool
+{
+public:
+    enum { MaximumCachedBlocks = 256 };
+
+    // one for the owning thread, one per block allocated from the heap and
+    // one per release() in progress
+    QAtomicInt ref;
+    QAtomicInt closed;
+    QAtomicPointer<QMetaCallEventBlock> returned;
+
+    // only accessed by the owning thread
+    QMetaCallEventBlock *freeList;
+    int freeCount;
+
+    QMetaCallEventPool()
+        : ref(1), closed(0), returned(0), freeList(0), freeCount(0)
+    { }
+
+    static inline void freeBlock(QMetaCallEventBlock *block)
+    {
+        QMetaCallEventPool *pool = block->pool;
+        qFree(block);
+        if (!pool->ref.deref())
+            delete pool;
+    }
+
+    static inline void freeBlocks(QMetaCallEventBlock *block)
+    {
+        while (block) {
+            QMetaCallEventBlock *next = block->next;
+            freeBlock(block);
+            block = next;
+        }
+    }
+
+    QMetaCallEventBlock *allocate()
+    {
+        if (!freeList) {
+            freeList = returned.fetchAndStoreAcquire(0);
+            freeCount = 0;
+            for (QMetaCallEventBlock *block = freeList; block; block = block->next)
+                ++freeCount;
+            // drop what the last burst left behind
+            while (freeCount > MaximumCachedBlocks) {
+                QMetaCallEventBlock *block = freeList;
+                freeList = block->next;
+                --freeCount;
+                freeBlock(block);
+            }
+        }
+        if (freeList) {
+            QMetaCallEventBlock *block = freeList;
+            freeList = block->next;
+            --freeCount;
+            return block;
+        }
+
+        QMetaCallEventBlock *block = static_cast<QMetaCallEventBlock *>(
+            qMalloc(sizeof(QMetaCallEventBlockHeader) + sizeof(QMetaCallEvent)));
+        Q_CHECK_PTR(block);
+        block->pool = this;
+        ref.ref();
+        return block;
+    }
+
+    void release(QMetaCallEventBlock *block)
+    {
+        // once the block is on the returned list, a concurrent close() may
+        // free it and drop the reference it held, so keep our own
+        ref.ref();
+        forever {
+            QMetaCallEventBlock *head = returned;
+            block->next = head;
+            if (returned.testAndSetOrdered(head, block))
+                break;
+        }
+        // the owning thread is gone, nobody else will take the list back
+        if (closed)
+            freeBlocks(returned.fetchAndStoreOrdered(0));
+        if (!ref.deref())
+            delete this;
+    }
+
+    void close()
+    {
+        closed.fetchAndStoreOrdered(1);
+        freeBlocks(freeList);
+        freeList = 0;
+        freeBlocks(returned.fetchAndStoreOrdered(0));
+        if (!ref.deref())
+            delete this;
+    }
+};
+
+/*! \internal
+ */
+void *QMetaCallEvent::operator new(size_t size)
+{
+    QMetaCallEventBlock *block;
+    if (size == sizeof(QMetaCallEvent)) {
+        QThreadData *data = QThreadData::current();
+        if (!data->metaCallEventPool)
+            data->metaCallEventPool = new QMetaCallEventPool;
+        block = data->metaCallEventPool->allocate();
+    } else {
+        block = static_cast<QMetaCallEventBlock *>(qMalloc(sizeof(QMetaCallEventBlockHeader) + size));
+        Q_CHECK_PTR(block);
+        block->pool = 0;
+    }
+    Q_CHECK_PTR(block);
+    return reinterpret_cast<QMetaCallEventBlockHeader *>(block) + 1;
+}
+
+/*! \internal
+ */
+void QMetaCallEvent::operator delete(void *ptr)
+{
+    if (!ptr)
+        return;
+    QMetaCallEventBlock *block =
+        reinterpret_cast<QMetaCallEventBlock *>(static_cast<QMetaCallEventBlockHeader *>(ptr) - 1);
+    if (block->pool)
+        block->pool->release(block);
+    else
+        qFree(block);
+}
+
+/*! \internal
+
+    Called when the thread owning \a pool goes away.
+*/
+void QMetaCallEvent::releasePool(QMetaCallEventPool *pool)
+{
+    pool->close();
+}
+
 /*!
     \class QObject
     \brief The QObject class is the base class of all Qt objects.
@@ -731,31 +1086,31 @@ QObject::~QObject()
 
     emit destroyed(this);
 
+    QObjectConnectionListVector *retiredLists = 0;
+    int retiredEpoch = 0;
     {
         QWriteLocker locker(QObjectPrivate::signalSlotLock());
 
         // disconnect all receivers
-        if (d->connectionLists) {
-            for (int signal = -1; signal < d->connectionLists->count(); ++signal) {
-                QObjectPrivate::ConnectionList &connectionList = (*d->connectionLists)[signal];
+        QObjectConnectionListVector *connectionLists = d->connectionLists;
+        if (connectionLists) {
+            for (int signal = -1; signal < connectionLists->count(); ++signal) {
+                const QObjectPrivate::ConnectionList &connectionList = connectionLists->at(signal);
                 for (int i = 0; i < connectionList.count(); ++i) {
-                    QObjectPrivate::Connection &c = connectionList[i];
-                    if (c.receiver)
-                        c.receiver->d_func()->removeSender(this, signal);
-                    if (c.argumentTypes && c.argumentTypes != &DIRECT_CONNECTION_ONLY) {
-                        qFree(c.argumentTypes);
-                        c.argumentTypes = 0;
+                    QObjectPrivate::Connection *c = connectionList.at(i);
+                    if (c->receiver)
+                        c->receiver->d_func()->removeSender(this, signal);
+                    if (c->argumentTypes && c->argumentTypes != &DIRECT_CONNECTION_ONLY) {
+                        qFree(c->argumentTypes);
+                        c->argumentTypes = 0;
                     }
-                    c.receiver = 0;
+                    c->receiver = 0;
                 }
             }
 
-            if (!d->connectionLists->activating) {
-                delete d->connectionLists;
-            } else {
-                d->connectionLists->orphaned = true;
-            }
-            d->connectionLists = 0;
+            // emissions still using the lists stop at the next connection
+            connectionLists->orphaned = true;
+            retiredLists = d->publishConnectionLists(0, &retiredEpoch);
         }
 
         // disconnect all senders
@@ -765,6 +1120,7 @@ QObject::~QObject()
                 s.sender->d_func()->removeReceiver(s.signal, this);
         }
     }
+    d->retireConnectionLists(retiredLists, retiredEpoch);
 
     if (d->pendTimer) {
         // unregister pending timers
@@ -1361,6 +1717,9 @@ void QObject::moveToThread(QThread *targetThread)
     // prepare to move
     d->moveToThread_helper();
 
+    // queued connections post to the receiver's thread while holding the
+    // signalSlotLock() for reading, without locking the post event list
+    QWriteLocker connectionsLocker(QObjectPrivate::signalSlotLock());
     QWriteLocker locker(QObjectPrivate::readWriteLock());
     if (currentData != targetData) {
         targetData->postEventList.mutex.lock();
@@ -1382,6 +1741,9 @@ void QObject::moveToThread(QThread *targetThread)
             currentData->postEventList.mutex.unlock();
     }
 
+    // signal emission looks up the receiver's thread in the connection
+    d->setConnectionsThreadData_helper(targetData);
+
     // now currentData can commit suicide if it wants to
     currentData->deref();
 }
@@ -1403,6 +1765,7 @@ void QObjectPrivate::setThreadData_helper(QThreadData *currentData, QThreadData
 
     // move posted events
     int eventsMoved = 0;
+    currentData->postEventList.takeIncoming();
     for (int i = 0; i < currentData->postEventList.size(); ++i) {
         const QPostEvent &pe = currentData->postEventList.at(i);
         if (!pe.event)
@@ -2317,8 +2680,14 @@ int QObject::receivers(const char *signal) const
         Q_D(const QObject);
         QReadLocker locker(QObjectPrivate::signalSlotLock());
         if (d->connectionLists) {
-            if (signal_index < d->connectionLists->count())
-                receivers = d->connectionLists->at(signal_index).count();
+            if (signal_index < d->connectionLists->count()) {
+                const QObjectPrivate::ConnectionList &connectionList =
+                    d->connectionLists->at(signal_index);
+                for (int i = 0; i < connectionList.count(); ++i) {
+                    if (connectionList.at(i)->receiver)
+                        ++receivers;
+                }
+            }
         }
     }
     return receivers;
@@ -2794,16 +3163,14 @@ bool QMetaObject::connect(const QObject *sender, int signal_index,
 
     QWriteLocker locker(QObjectPrivate::signalSlotLock());
 
-#if defined(Q_CC_HPACC) && defined(QT_ARCH_PARISC)
-    QObjectPrivate::Connection c;
-    c.receiver = r;
-    c.method = method_index;
-    c.connectionType = type;
-    c.argumentTypes = types;
-#else
-    QObjectPrivate::Connection c = { r, method_index, type, Q_BASIC_ATOMIC_INITIALIZER(types) };
-#endif
-    s->d_func()->addConnection(signal_index, &c);
+    QObjectPrivate::Connection *c = new QObjectPrivate::Connection;
+    c->receiver = r;
+    c->method = method_index;
+    c->connectionType = type;
+    c->argumentTypes = types;
+    c->receiverThreadData = r->d_func()->threadData;
+    int epoch = 0;
+    QObjectConnectionListVector *retiredLists = s->d_func()->addConnection(signal_index, c, &epoch);
     r->d_func()->refSender(s, signal_index);
 
     if (signal_index < 0)
@@ -2811,6 +3178,9 @@ bool QMetaObject::connect(const QObject *sender, int signal_index,
     else if (signal_index < 32)
         sender->d_func()->connectedSignals |= (1 << signal_index);
 
+    locker.unlock();
+    s->d_func()->retireConnectionLists(retiredLists, epoch);
+
     return true;
 }
 
@@ -2835,40 +3205,38 @@ bool QMetaObject::disconnect(const QObject *sender, int signal_index,
     if (signal_index < 0) {
         // remove from all connection lists
         for (signal_index = -1; signal_index < connectionLists->count(); ++signal_index) {
-            QObjectPrivate::ConnectionList &connectionList = (*connectionLists)[signal_index];
+            const QObjectPrivate::ConnectionList &connectionList = connectionLists->at(signal_index);
             for (int i = 0; i < connectionList.count(); ++i) {
-                QObjectPrivate::Connection &c = connectionList[i];
-                if (c.receiver
-                    && (r == 0 || (c.receiver == r
-                                   && (method_index < 0 || c.method == method_index)))) {
-                    c.receiver->d_func()->derefSender(s, signal_index);
-                    if (c.argumentTypes && c.argumentTypes != &DIRECT_CONNECTION_ONLY) {
-                        qFree(c.argumentTypes);
-                        c.argumentTypes = 0;
+                QObjectPrivate::Connection *c = connectionList.at(i);
+                if (c->receiver
+                    && (r == 0 || (c->receiver == r
+                                   && (method_index < 0 || c->method == method_index)))) {
+                    c->receiver->d_func()->derefSender(s, signal_index);
+                    if (c->argumentTypes && c->argumentTypes != &DIRECT_CONNECTION_ONLY) {
+                        qFree(c->argumentTypes);
+                        c->argumentTypes = 0;
                     }
-                    c.receiver = 0;
+                    c->receiver = 0;
 
                     success = true;
-                    connectionLists->dirty = true;
                 }
             }
         }
     } else if (signal_index < connectionLists->count()) {
-        QObjectPrivate::ConnectionList &connectionList = (*connectionLists)[signal_index];
+        const QObjectPrivate::ConnectionList &connectionList = connectionLists->at(signal_index);
         for (int i = 0; i < connectionList.count(); ++i) {
-            QObjectPrivate::Connection &c = connectionList[i];
-            if (c.receiver
-                && (r == 0 || (c.receiver == r
-                               && (method_index < 0 || c.method == method_index)))) {
-                c.receiver->d_func()->derefSender(s, signal_index);
-                if (c.argumentTypes && c.argumentTypes != &DIRECT_CONNECTION_ONLY) {
-                    qFree(c.argumentTypes);
-                    c.argumentTypes = 0;
+            QObjectPrivate::Connection *c = connectionList.at(i);
+            if (c->receiver
+                && (r == 0 || (c->receiver == r
+                               && (method_index < 0 || c->method == method_index)))) {
+                c->receiver->d_func()->derefSender(s, signal_index);
+                if (c->argumentTypes && c->argumentTypes != &DIRECT_CONNECTION_ONLY) {
+                    qFree(c->argumentTypes);
+                    c->argumentTypes = 0;
                 }
-                c.receiver = 0;
+                c->receiver = 0;
 
                 success = true;
-                connectionLists->dirty = true;
             }
         }
     }
@@ -2946,57 +3314,68 @@ void QMetaObject::connectSlotsByName(QObject *o)
     }
 }
 
-static void queued_activate(QObject *sender, int signal, const QObjectPrivate::Connection &c,
+/*
+    Posts a QMetaCallEvent for the connection \a c. Returns false if the
+    connection was broken in the meantime, or its arguments cannot be
+    queued.
+*/
+static bool queued_activate(QObject *sender, int signal, QObjectPrivate::Connection *c,
                             void **argv, QSemaphore *semaphore = 0)
 {
-    if (!c.argumentTypes || c.argumentTypes != &DIRECT_CONNECTION_ONLY) {
+    // the receiver may be destroyed in its own thread at any time; holding
+    // the lock keeps it alive until the event has been posted
+    QReadLocker locker(QObjectPrivate::signalSlotLock());
+    if (!c->receiver)
+        return false;
+
+    if (!c->argumentTypes || c->argumentTypes != &DIRECT_CONNECTION_ONLY) {
         QMetaMethod m = sender->metaObject()->method(signal);
-        QObjectPrivate::Connection &x = const_cast<QObjectPrivate::Connection &>(c);
         int *tmp = queuedConnectionTypes(m.parameterTypes());
         if (!tmp) // cannot queue arguments
             tmp = &DIRECT_CONNECTION_ONLY;
-        if (!x.argumentTypes.testAndSetOrdered(0, tmp)) {
+        if (!c->argumentTypes.testAndSetOrdered(0, tmp)) {
             if (tmp != &DIRECT_CONNECTION_ONLY)
                 qFree(tmp);
         }
     }
-    if (c.argumentTypes == &DIRECT_CONNECTION_ONLY) // cannot activate
-        return;
+    if (c->argumentTypes == &DIRECT_CONNECTION_ONLY) // cannot activate
+        return false;
     int nargs = 1; // include return type
-    while (c.argumentTypes[nargs-1])
+    while (c->argumentTypes[nargs-1])
         ++nargs;
     int *types = (int *) qMalloc(nargs*sizeof(int));
     void **args = (void **) qMalloc(nargs*sizeof(void *));
     types[0] = 0; // return type
     args[0] = 0; // return value
     for (int n = 1; n < nargs; ++n)
-        args[n] = QMetaType::construct((types[n] = c.argumentTypes[n-1]), argv[n]);
-    QCoreApplication::postEvent(c.receiver, new QMetaCallEvent(c.method,
-                                                               sender,
-                                                               signal,
-                                                               nargs,
-                                                               types,
-                                                               args,
-                                                               semaphore));
+        args[n] = QMetaType::construct((types[n] = c->argumentTypes[n-1]), argv[n]);
+    QCoreApplicationPrivate::postMetaCallEvent(c->receiver, new QMetaCallEvent(c->method,
+                                                                               sender,
+                                                                               signal,
+                                                                               nargs,
+                                                                               types,
+                                                                               args,
+                                                                               semaphore));
+    return true;
 }
 
-static void blocking_activate(QObject *sender, int signal, const QObjectPrivate::Connection &c, void **argv)
+static void blocking_activate(QObject *sender, int signal, QObjectPrivate::Connection *c, void **argv)
 {
-    if (QThread::currentThread() == c.receiver->thread()) {
+    if (c->receiverThreadData == QThreadData::current()) {
+        // the receiver lives in this thread, so it cannot go away under us
+        QObject *receiver = c->receiver;
         qWarning("Qt: Dead lock detected while activating a BlockingQueuedConnection: "
                  "Sender is %s(%p), receiver is %s(%p)",
                  sender->metaObject()->className(), sender,
-                 c.receiver->metaObject()->className(), c.receiver);
+                 receiver->metaObject()->className(), receiver);
     }
 
 #ifdef QT_NO_THREAD
     queued_activate(sender, signal, c, argv);
 #else
     QSemaphore semaphore;
-    queued_activate(sender, signal, c, argv, &semaphore);
-    QObjectPrivate::signalSlotLock()->unlock();
-    semaphore.acquire();
-    QObjectPrivate::signalSlotLock()->lockForRead();
+    if (queued_activate(sender, signal, c, argv, &semaphore))
+        semaphore.acquire();
 #endif
 }
 
@@ -3013,14 +3392,12 @@ void QMetaObject::activate(QObject *sender, int from_signal_index, int to_signal
                                                          argv ? argv : empty_argv);
     }
 
-    QReadLocker locker(QObjectPrivate::signalSlotLock());
-    QThreadData *currentThreadData = QThreadData::current();
-
-    QObjectConnectionListVector *connectionLists = sender->d_func()->connectionLists;
+    // no locking here: connect() only appends past the count we read,
+    // and disconnect() clears the receiver of broken connections
+    QObjectConnectionListVector *connectionLists = sender->d_func()->acquireConnectionLists();
     if (!connectionLists)
         return;
-    bool wasActivating = connectionLists->activating;
-    connectionLists->activating = true;
+    QThreadData *currentThreadData = QThreadData::current();
 
     // emit signals in the following order: from_signal_index <= signals <= to_signal_index, signal < 0
     for (int signal = from_signal_index;
@@ -3034,7 +3411,7 @@ void QMetaObject::activate(QObject *sender, int from_signal_index, int to_signal
         const QObjectPrivate::ConnectionList &connectionList = connectionLists->at(signal);
         int count = connectionList.count();
         for (int i = 0; i < count; ++i) {
-            const QObjectPrivate::Connection *c = &connectionList[i];
+            QObjectPrivate::Connection *c = connectionList.at(i);
             if (!c->receiver)
                 continue;
 
@@ -3042,59 +3419,67 @@ void QMetaObject::activate(QObject *sender, int from_signal_index, int to_signal
             // put into the event queue
             if ((c->connectionType == Qt::AutoConnection
                  && (currentThreadData != sender->d_func()->threadData
-                     || c->receiver->d_func()->threadData != sender->d_func()->threadData))
+                     || c->receiverThreadData != sender->d_func()->threadData))
                 || (c->connectionType == Qt::QueuedConnection)) {
-                queued_activate(sender, signal, *c, argv);
+                queued_activate(sender, signal, c, argv);
                 continue;
             } else if (c->connectionType == Qt::BlockingQueuedConnection) {
-                blocking_activate(sender, signal, *c, argv);
+                blocking_activate(sender, signal, c, argv);
                 continue;
             }
 
+            // a receiver living in another thread can be destroyed there at
+            // any time, so its sender bookkeeping has to be done under the
+            // lock, which destruction and disconnect take for writing
+            QReadWriteLock * const lock =
+                c->receiverThreadData != currentThreadData ? QObjectPrivate::signalSlotLock() : 0;
+            QReadLocker locker(lock);
+            QObject * const receiver = c->receiver;
+            if (!receiver)
+                continue;
             const int method = c->method;
-            QObject * const previousSender = c->receiver->d_func()->currentSender;
-            int previousSenderSignal = c->receiver->d_func()->currentSenderSignal;
-            c->receiver->d_func()->currentSender = sender;
-            c->receiver->d_func()->currentSenderSignal = signal < 0 ? from_signal_index : signal;
+            QObjectPrivate * const receiverPrivate = receiver->d_func();
+            QObject * const previousSender = receiverPrivate->currentSender;
+            int previousSenderSignal = receiverPrivate->currentSenderSignal;
+            receiverPrivate->currentSender = sender;
+            receiverPrivate->currentSenderSignal = signal < 0 ? from_signal_index : signal;
             locker.unlock();
 
             if (qt_signal_spy_callback_set.slot_begin_callback != 0) {
-                qt_signal_spy_callback_set.slot_begin_callback(c->receiver,
+                qt_signal_spy_callback_set.slot_begin_callback(receiver,
                                                                method,
                                                                argv ? argv : empty_argv);
             }
 
 #if defined(QT_NO_EXCEPTIONS)
-            c->receiver->qt_metacall(QMetaObject::InvokeMetaMethod, method, argv ? argv : empty_argv);
+            receiver->qt_metacall(QMetaObject::InvokeMetaMethod, method, argv ? argv : empty_argv);
 #else
             try {
-                c->receiver->qt_metacall(QMetaObject::InvokeMetaMethod, method, argv ? argv : empty_argv);
+                receiver->qt_metacall(QMetaObject::InvokeMetaMethod, method, argv ? argv : empty_argv);
             } catch (...) {
                 locker.relock();
-
-                c = &(*connectionLists)[signal][i];
-                if (c->receiver) {
-                    c->receiver->d_func()->currentSender = previousSender;
-                    c->receiver->d_func()->currentSenderSignal = previousSenderSignal;
+                // the receiver is cleared when it is destroyed, but also when
+                // it is disconnected. The two cannot be told apart here, so
+                // leave it alone; sender() checks the senders list anyway
+                if (c->receiver == receiver) {
+                    receiverPrivate->currentSender = previousSender;
+                    receiverPrivate->currentSenderSignal = previousSenderSignal;
                 }
-
-                connectionLists->activating = wasActivating;
-                if (connectionLists->orphaned)
-                    delete connectionLists;
+                locker.unlock();
+                QObjectPrivate::releaseConnectionLists(connectionLists);
                 throw;
             }
 #endif
 
-            locker.relock();
-            c = &(*connectionLists)[signal][i];
-
             if (qt_signal_spy_callback_set.slot_end_callback != 0)
                 qt_signal_spy_callback_set.slot_end_callback(c->receiver, method);
 
-            if (c->receiver) {
-                c->receiver->d_func()->currentSender = previousSender;
-                c->receiver->d_func()->currentSenderSignal = previousSenderSignal;
+            locker.relock();
+            if (c->receiver == receiver) {
+                receiverPrivate->currentSender = previousSender;
+                receiverPrivate->currentSenderSignal = previousSenderSignal;
             }
+            locker.unlock();
 
             if (connectionLists->orphaned)
                 break;
@@ -3104,11 +3489,7 @@ void QMetaObject::activate(QObject *sender, int from_signal_index, int to_signal
             break;
     }
 
-    connectionLists->activating = wasActivating;
-    if (connectionLists->orphaned)
-        delete connectionLists;
-
-    locker.unlock();
+    QObjectPrivate::releaseConnectionLists(connectionLists);
 
     if (qt_signal_spy_callback_set.signal_end_callback != 0)
         qt_signal_spy_callback_set.signal_end_callback(sender, from_signal_index);
@@ -3374,12 +3755,14 @@ void QObject::dumpObjectInfo()
             // receivers
             const QObjectPrivate::ConnectionList &connectionList = d->connectionLists->at(signal_index);
             for (int i = 0; i < connectionList.count(); ++i) {
-                const QObjectPrivate::Connection &c = connectionList.at(i);
-                const QMetaObject *receiverMetaObject = c.receiver->metaObject();
-                const QMetaMethod method = receiverMetaObject->method(c.method);
+                const QObjectPrivate::Connection *c = connectionList.at(i);
+                if (!c->receiver)
+                    continue;
+                const QMetaObject *receiverMetaObject = c->receiver->metaObject();
+                const QMetaMethod method = receiverMetaObject->method(c->method);
                 qDebug("\t  --> %s::%s %s",
                        receiverMetaObject->className(),
-                       c.receiver->objectName().isEmpty() ? "unnamed" : qPrintable(c.receiver->objectName()),
+                       c->receiver->objectName().isEmpty() ? "unnamed" : qPrintable(c->receiver->objectName()),
                        method.signature());
             }
         }
@@ -77,7 +77,7 @@ public:
     uint sendChildEvents : 1;
     uint receiveChildEvents : 1;
     uint unused : 25;
-    int postedEvents;
+    QAtomicInt postedEvents;
 };
 
 
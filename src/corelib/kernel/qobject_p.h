@@ -119,19 +119,61 @@ public:
 
     QString objectName;
 
-    // Note: you must hold the signalSlotLock() before accessing the lists below or calling the functions
+    // Note: you must hold the signalSlotLock() before accessing the lists below or calling the functions.
+    // The only exception is emitting a signal, which reads a snapshot of the
+    // sender's connection lists obtained with acquireConnectionLists().
     struct Connection
     {
-        QObject *receiver;
+        QAtomicPointer<QObject> receiver; // 0 once disconnected
         int method;
         uint connectionType : 3; // 0 == auto, 1 == direct, 2 == queued, 4 == blocking
-        QBasicAtomicPointer<int> argumentTypes;
+        QAtomicPointer<int> argumentTypes;
+        QThreadData * volatile receiverThreadData;
+        QAtomicInt ref; // number of connection list blocks containing this connection
     };
-    typedef QList<Connection> ConnectionList;
 
-    QObjectConnectionListVector *connectionLists;
-    void addConnection(int signal, Connection *c);
+    // The connections to one signal, kept in a fixed size block that is
+    // shared by all snapshots containing the list. connect() appends to
+    // the block in place while it has room; an emission only looks at the
+    // connections that were there when it started.
+    class ConnectionList
+    {
+    public:
+        struct Data
+        {
+            QAtomicInt ref;
+            QAtomicInt count;
+            int alloc;
+            Connection *connections[1];
+        };
+
+        inline ConnectionList() : d(0) { }
+        inline explicit ConnectionList(Data *data) : d(data) { }
+        inline ConnectionList(const ConnectionList &other) : d(other.d)
+        { if (d) d->ref.ref(); }
+        inline ~ConnectionList()
+        { if (d && !d->ref.deref()) freeData(d); }
+        ConnectionList &operator=(const ConnectionList &other);
+
+        inline int count() const { return d ? int(d->count) : 0; }
+        inline Connection *at(int i) const { return d->connections[i]; }
+
+        static Data *allocateData(int alloc);
+        static void freeData(Data *data);
+
+        Data *d;
+    };
+
+    QAtomicPointer<QObjectConnectionListVector> connectionLists;
+    mutable QAtomicInt connectionListsEpoch;
+    mutable QAtomicInt connectionListsReaders[2];
+    QObjectConnectionListVector *acquireConnectionLists() const;
+    static void releaseConnectionLists(QObjectConnectionListVector *lists);
+    QObjectConnectionListVector *publishConnectionLists(QObjectConnectionListVector *lists, int *epoch);
+    void retireConnectionLists(QObjectConnectionListVector *lists, int epoch) const;
+    QObjectConnectionListVector *addConnection(int signal, Connection *c, int *epoch);
     void removeReceiver(int signal, QObject *receiver);
+    void setConnectionsThreadData_helper(QThreadData *targetData);
 
     struct Sender
     {
@@ -146,10 +188,12 @@ public:
     void removeSender(QObject *sender, int signal);
 };
 
-Q_DECLARE_TYPEINFO(QObjectPrivate::Connection, Q_MOVABLE_TYPE);
 Q_DECLARE_TYPEINFO(QObjectPrivate::Sender, Q_MOVABLE_TYPE);
+Q_DECLARE_TYPEINFO(QObjectPrivate::ConnectionList, Q_MOVABLE_TYPE);
 
 class QSemaphore;
+class QMetaCallEventPool;
+
 class Q_CORE_EXPORT QMetaCallEvent : public QEvent
 {
 public:
@@ -157,6 +201,11 @@ public:
                    int nargs = 0, int *types = 0, void **args = 0, QSemaphore *semaphore = 0);
     ~QMetaCallEvent();
 
+    // recycled through a pool owned by the allocating thread
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr);
+    static void releasePool(QMetaCallEventPool *pool);
+
     inline int id() const { return id_; }
     inline const QObject *sender() const { return sender_; }
     inline int signalId() const { return signalId_; }
@@ -172,6 +221,11 @@ private:
     int *types_;
     void **args_;
     QSemaphore *semaphore_;
+
+    // used while queued in QPostEventList::incoming
+    friend class QPostEventList;
+    QObject *postedReceiver_;
+    QMetaCallEvent *nextPosted_;
 };
 
 class Q_CORE_EXPORT QBoolBlocker
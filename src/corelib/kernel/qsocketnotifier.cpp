@@ -20,9 +20,27 @@
 
 #include "qobject_p.h"
 #include <private/qthread_p.h>
+#if defined(Q_OS_LINUX)
+#  include "qeventdispatcher_epoll_p.h"
+#endif
 
 QT_BEGIN_NAMESPACE
 
+#if defined(Q_OS_UNIX)
+// select() cannot wait for descriptors of FD_SETSIZE or above, epoll can
+static bool qt_dispatcher_is_limited_by_fd_setsize(QAbstractEventDispatcher *eventDispatcher)
+{
+#if defined(Q_OS_LINUX)
+    QEventDispatcherEPoll *epollDispatcher = qobject_cast<QEventDispatcherEPoll *>(eventDispatcher);
+    if (epollDispatcher && epollDispatcher->usesEPoll())
+        return false;
+#else
+    Q_UNUSED(eventDispatcher);
+#endif
+    return true;
+}
+#endif
+
 /*!
     \class QSocketNotifier
     \brief The QSocketNotifier class provides support for monitoring
@@ -142,17 +160,17 @@ QT_BEGIN_NAMESPACE
 QSocketNotifier::QSocketNotifier(int socket, Type type, QObject *parent)
     : QObject(parent)
 {
+    Q_D(QObject);
     if (socket < 0)
         qWarning("QSocketNotifier: Invalid socket specified");
 #if defined(Q_OS_UNIX)
-    if (socket >= FD_SETSIZE)
+    if (socket >= FD_SETSIZE && qt_dispatcher_is_limited_by_fd_setsize(d->threadData->eventDispatcher))
         qWarning("QSocketNotifier: Socket descriptor too large for select()");
 #endif
     sockfd = socket;
     sntype = type;
     snenabled = true;
 
-    Q_D(QObject);
     if (!d->threadData->eventDispatcher) {
         qWarning("QSocketNotifier: Can only be used with threads started with QThread");
     } else {
@@ -180,17 +198,17 @@ QSocketNotifier::QSocketNotifier(int socket, Type type, QObject *parent,
     : QObject(parent)
 {
     setObjectName(QString::fromAscii(name));
+    Q_D(QObject);
     if (socket < 0)
         qWarning("QSocketNotifier: Invalid socket specified");
 #if defined(Q_OS_UNIX)
-    if (socket >= FD_SETSIZE)
+    if (socket >= FD_SETSIZE && qt_dispatcher_is_limited_by_fd_setsize(d->threadData->eventDispatcher))
         qWarning("QSocketNotifier: Socket descriptor too large for select()");
 #endif
     sockfd = socket;
     sntype = type;
     snenabled = true;
 
-    Q_D(QObject);
     if (!d->threadData->eventDispatcher) {
         qWarning("QSocketNotifier: Can only be used with threads started with QThread");
     } else {
@@ -84,6 +84,10 @@ QT_BEGIN_NAMESPACE
     unable to deliver the requested number of timer clicks, it will
     silently discard some.
 
+    On Unix, timers with an interval of 20 milliseconds or more may
+    fire up to 5% late, so that timers that expire close together can
+    be handled in a single wakeup. A timer never fires early.
+
     An alternative to using QTimer is to call QObject::startTimer()
     for your object and reimplement the QObject::timerEvent() event
     handler in your class (which must inherit QObject). The
@@ -26,6 +26,8 @@
 #include "qmap.h"
 #include "qalgorithms.h"
 #include "qhash.h"
+#include "qmutex.h"
+#include "qresource.h"
 #include "qtranslator_p.h"
 
 #if defined(Q_OS_UNIX)
@@ -67,14 +69,17 @@ static bool match(const uchar* found, const char* target, uint len)
     return !found || qstrncmp((const char *)found, target, len) == 0 && target[len] == '\0';
 }
 
-static uint elfHash(const char *name)
+static uint elfHash(const char *name, const char *suffix = 0)
 {
     const uchar *k;
     uint h = 0;
     uint g;
 
-    if (name) {
-        k = (const uchar *) name;
+    // hashes name and suffix as if they were concatenated
+    for (int i = 0; i < 2; ++i) {
+        k = (const uchar *) (i == 0 ? name : suffix);
+        if (!k)
+            continue;
         while (*k) {
             h = (h << 4) + *k++;
             if ((g = (h & 0xf0000000)) != 0)
@@ -87,6 +92,21 @@ static uint elfHash(const char *name)
     return h;
 }
 
+/*
+    Maps the hash \a h to a slot of a table with \a size entries. This
+    must match the function that lrelease uses to build the perfect
+    hash table.
+*/
+static inline uint perfectHashSlot(uint h, uint seed, uint size)
+{
+    h ^= seed;
+    h *= 0x45d9f3b;
+    h ^= h >> 16;
+    h *= 0x45d9f3b;
+    h ^= h >> 16;
+    return h % size;
+}
+
 static int numerusHelper(int n, const uchar *rules, int rulesSize)
 {
 #define CHECK_RANGE \
@@ -177,38 +197,99 @@ static int numerusHelper(int n, const uchar *rules, int rulesSize)
 
 extern bool qt_detectRTLLanguage();
 
+struct QTranslatorCacheKey
+{
+    const char *context;
+    const char *sourceText;
+    const char *comment;
+    int numerus;
+
+    inline bool operator==(const QTranslatorCacheKey &other) const
+    {
+        return context == other.context && sourceText == other.sourceText
+            && comment == other.comment && numerus == other.numerus;
+    }
+};
+
+static inline uint qHash(const QTranslatorCacheKey &key)
+{
+    return qHash(key.sourceText) ^ (qHash(key.context) << 1) ^ qHash(key.comment) ^ uint(key.numerus);
+}
+
+struct QTranslatorCacheEntry
+{
+    // context, source text and comment, separated by '\0'
+    QByteArray key;
+    QString translation;
+
+    bool matches(const char *context, const char *sourceText, const char *comment) const;
+};
+
 class QTranslatorPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QTranslator)
 public:
-    enum { Contexts = 0x2f, Hashes = 0x42, Messages = 0x69, NumerusRules = 0x88 };
+    enum { Contexts = 0x2f, Hashes = 0x42, Messages = 0x69, NumerusRules = 0x88,
+           PerfectHashes = 0x96 };
+    enum { MaxCacheSize = 8192 };
 
     QTranslatorPrivate()
-        : used_mmap(0), unmapPointer(0), unmapLength(0), messageArray(0), offsetArray(0),
-          contextArray(0), numerusRulesArray(0), messageLength(0), offsetLength(0),
-          contextLength(0), numerusRulesLength(0) {}
+        : used_mmap(0), unmapPointer(0), unmapLength(0), resource(0), messageArray(0),
+          offsetArray(0), contextArray(0), numerusRulesArray(0), perfectHashArray(0),
+          messageLength(0), offsetLength(0), contextLength(0), numerusRulesLength(0),
+          perfectHashLength(0) {}
 
     // for mmap'ed files, this is what needs to be unmapped.
     uint used_mmap : 1;
     char *unmapPointer;
     unsigned int unmapLength;
 
+    // for resource files, the data is used in place
+    QResource *resource;
+
     // for squeezed but non-file data, this is what needs to be deleted
     const uchar *messageArray;
     const uchar *offsetArray;
     const uchar *contextArray;
     const uchar *numerusRulesArray;
+    const uchar *perfectHashArray;
     uint messageLength;
     uint offsetLength;
     uint contextLength;
     uint numerusRulesLength;
+    uint perfectHashLength;
+
+    /*
+        Translations looked up by the addresses of the strings, which
+        are the same every time a tr() call is executed. The strings
+        are still compared, as the same addresses may be reused for
+        other strings.
+    */
+    mutable QMutex cacheMutex;
+    mutable QHash<QTranslatorCacheKey, QTranslatorCacheEntry> cache;
 
     bool do_load(const uchar *data, int len);
+    const uchar *findHash(uint h) const;
     QString do_translate(const char *context, const char *sourceText, const char *comment,
                          int n) const;
+    QString do_translate_uncached(const char *context, const char *sourceText,
+                                  const char *comment, int numerus) const;
     void clear();
 };
 
+bool QTranslatorCacheEntry::matches(const char *context, const char *sourceText,
+                                    const char *comment) const
+{
+    const char *k = key.constData();
+    const char *strings[3] = { context, sourceText, comment };
+    for (int i = 0; i < 3; ++i) {
+        if (qstrcmp(k, strings[i]) != 0)
+            return false;
+        k += qstrlen(k) + 1;
+    }
+    return true;
+}
+
 /*!
     \class QTranslator
 
@@ -392,6 +473,16 @@ bool QTranslator::load(const QString & filename, const QString & directory,
 
     bool ok = false;
 
+    // uncompressed resources are used in place
+    if (realname.startsWith(QLatin1Char(':'))) {
+        QResource *resource = new QResource(realname);
+        if (resource->isValid() && !resource->isCompressed() && resource->data()) {
+            d->resource = resource;
+            return d->do_load(resource->data(), resource->size());
+        }
+        delete resource;
+    }
+
 #ifdef QT_USE_MMAP
 
 #ifndef MAP_FILE
@@ -519,14 +610,86 @@ bool QTranslatorPrivate::do_load(const uchar *data, int len)
         } else if (tag == QTranslatorPrivate::NumerusRules) {
             numerusRulesArray = data;
             numerusRulesLength = blockLen;
+        } else if (tag == QTranslatorPrivate::PerfectHashes) {
+            perfectHashArray = data;
+            perfectHashLength = blockLen;
         }
 
         data += blockLen;
     }
 
+    /*
+        The perfect hash table consists of the number of buckets, one
+        seed per bucket and one entry per distinct hash, which is the
+        index of the first entry with that hash in the offset array.
+        Ignore tables that do not fit the offset array.
+    */
+    if (perfectHashArray) {
+        bool valid = false;
+        if (perfectHashLength >= 4 && (perfectHashLength % 4) == 0) {
+            quint32 bucketCount = read32(perfectHashArray);
+            quint32 slotCount = perfectHashLength / 4 - 1;
+            valid = bucketCount && bucketCount < slotCount
+                    && slotCount - bucketCount <= offsetLength / 8;
+        }
+        if (!valid) {
+            perfectHashArray = 0;
+            perfectHashLength = 0;
+        }
+    }
+
     return ok;
 }
 
+/*
+    Returns the first entry of the offset array with hash \a h, or 0 if
+    there is none.
+*/
+const uchar *QTranslatorPrivate::findHash(uint h) const
+{
+    const size_t numItems = offsetLength / (2 * sizeof(quint32));
+    if (!numItems)
+        return 0;
+
+    if (perfectHashArray) {
+        const quint32 bucketCount = read32(perfectHashArray);
+        const quint32 keyCount = perfectHashLength / 4 - 1 - bucketCount;
+        const uchar *seeds = perfectHashArray + 4;
+        const uchar *indices = seeds + 4 * bucketCount;
+
+        quint32 seed = read32(seeds + 4 * perfectHashSlot(h, 0, bucketCount));
+        if (!seed)
+            return 0;
+        quint32 index = read32(indices + 4 * perfectHashSlot(h, seed, keyCount));
+        if (index >= numItems)
+            return 0;
+        const uchar *entry = offsetArray + (index << 3);
+        return read32(entry) == h ? entry : 0;
+    }
+
+    const uchar *start = offsetArray;
+    const uchar *end = start + ((numItems-1) << 3);
+    while (start <= end) {
+        const uchar *middle = start + (((end - start) >> 4) << 3);
+        uint hash = read32(middle);
+        if (h == hash) {
+            start = middle;
+            break;
+        } else if (hash < h) {
+            start = middle + 8;
+        } else {
+            end = middle - 8;
+        }
+    }
+    if (start > end)
+        return 0;
+
+    // go back on equal key
+    while (start != offsetArray && read32(start) == read32(start-8))
+        start -= 8;
+    return start;
+}
+
 static QString getMessage(const uchar *m, const uchar *end, const char *context,
                           const char *sourceText, const char *comment, int numerus)
 {
@@ -587,11 +750,12 @@ static QString getMessage(const uchar *m, const uchar *end, const char *context,
 end:
     if (!tn)
         return QString();
-    QString str = QString::fromUtf16((const ushort *)tn, tn_length/2);
-    if (QSysInfo::ByteOrder == QSysInfo::LittleEndian) {
-        for (int i = 0; i < str.length(); ++i)
-            str[i] = QChar((str.at(i).unicode() >> 8) + ((str.at(i).unicode() << 8) & 0xff00));
-    }
+    const int length = tn_length / 2;
+    QString str;
+    str.resize(length);
+    ushort *data = reinterpret_cast<ushort *>(str.data());
+    for (int i = 0; i < length; ++i)
+        data[i] = (tn[2 * i] << 8) | tn[2 * i + 1];
     return str;
 }
 
@@ -608,6 +772,35 @@ QString QTranslatorPrivate::do_translate(const char *context, const char *source
     if (!offsetLength)
         return QString();
 
+    int numerus = 0;
+    if (n >= 0)
+        numerus = numerusHelper(n, numerusRulesArray, numerusRulesLength);
+
+    QTranslatorCacheKey key = { context, sourceText, comment, n >= 0 ? numerus : -1 };
+    {
+        QMutexLocker locker(&cacheMutex);
+        QHash<QTranslatorCacheKey, QTranslatorCacheEntry>::const_iterator it = cache.constFind(key);
+        if (it != cache.constEnd() && it->matches(context, sourceText, comment))
+            return it->translation;
+    }
+
+    QString translation = do_translate_uncached(context, sourceText, comment, numerus);
+
+    QTranslatorCacheEntry entry;
+    entry.key.reserve(qstrlen(context) + qstrlen(sourceText) + qstrlen(comment) + 3);
+    entry.key.append(context).append('\0').append(sourceText).append('\0')
+             .append(comment).append('\0');
+    entry.translation = translation;
+
+    QMutexLocker locker(&cacheMutex);
+    if (cache.size() < MaxCacheSize || cache.contains(key))
+        cache.insert(key, entry);
+    return translation;
+}
+
+QString QTranslatorPrivate::do_translate_uncached(const char *context, const char *sourceText,
+                                                  const char *comment, int numerus) const
+{
     /*
         Check if the context belongs to this QTranslator. If many
         translators are installed, this step is necessary.
@@ -632,37 +825,11 @@ QString QTranslatorPrivate::do_translate(const char *context, const char *source
         }
     }
 
-    size_t numItems = offsetLength / (2 * sizeof(quint32));
-    if (!numItems)
-        return QString();
-
-    int numerus = 0;
-    if (n >= 0)
-        numerus = numerusHelper(n, numerusRulesArray, numerusRulesLength);
-
     for (;;) {
-        quint32 h = elfHash(QByteArray(sourceText) + comment);
-
-        const uchar *start = offsetArray;
-        const uchar *end = start + ((numItems-1) << 3);
-        while (start <= end) {
-            const uchar *middle = start + (((end - start) >> 4) << 3);
-            uint hash = read32(middle);
-            if (h == hash) {
-                start = middle;
-                break;
-            } else if (hash < h) {
-                start = middle + 8;
-            } else {
-                end = middle - 8;
-            }
-        }
-
-        if (start <= end) {
-            // go back on equal key
-            while (start != offsetArray && read32(start) == read32(start-8))
-                start -= 8;
+        quint32 h = elfHash(sourceText, comment);
 
+        const uchar *start = findHash(h);
+        if (start) {
             while (start < offsetArray + offsetLength) {
                 quint32 rh = read32(start);
                 start += 4;
@@ -701,16 +868,26 @@ void QTranslatorPrivate::clear()
             delete [] unmapPointer;
     }
 
+    delete resource;
+
     unmapPointer = 0;
     unmapLength = 0;
+    resource = 0;
     messageArray = 0;
     contextArray = 0;
     offsetArray = 0;
     numerusRulesArray = 0;
+    perfectHashArray = 0;
     messageLength = 0;
     contextLength = 0;
     offsetLength = 0;
     numerusRulesLength = 0;
+    perfectHashLength = 0;
+
+    {
+        QMutexLocker locker(&cacheMutex);
+        cache.clear();
+    }
 
     if (QCoreApplicationPrivate::isTranslatorInstalled(q))
         QCoreApplication::postEvent(QCoreApplication::instance(),
@@ -763,7 +940,7 @@ QString QTranslator::translate(const char *context, const char *sourceText, cons
 bool QTranslator::isEmpty() const
 {
     Q_D(const QTranslator);
-    return !d->unmapPointer && !d->unmapLength && !d->messageArray &&
+    return !d->unmapPointer && !d->unmapLength && !d->resource && !d->messageArray &&
            !d->offsetArray && !d->contextArray;
 }
 
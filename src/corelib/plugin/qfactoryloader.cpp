@@ -16,6 +16,8 @@
 #ifndef QT_NO_LIBRARY
 #include "qfactoryinterface.h"
 #include "qmap.h"
+#include <qdatastream.h>
+#include <qdatetime.h>
 #include <qdir.h>
 #include <qsettings.h>
 #include <qdebug.h>
@@ -40,6 +42,63 @@ public:
     Qt::CaseSensitivity cs;
 };
 
+/*
+    The plugin cache holds, for each plugin directory, what is known
+    about the files in it: their verification data and the keys they
+    provide for each interface. It is stored as a single binary value,
+    so that an application only needs to load the plugins it uses.
+*/
+enum { PluginCacheVersion = 1 };
+
+struct QPluginCacheEntry
+{
+    QPluginCacheEntry() : qt_version(0), debug(false), hasMetaData(false) {}
+
+    QString lastModified;
+    uint qt_version;
+    bool debug;
+    QByteArray buildKey;
+    bool hasMetaData;
+    QMap<QByteArray, QStringList> keys; // by interface id
+};
+
+typedef QMap<QString, QPluginCacheEntry> QPluginCache;
+
+static QPluginCache readPluginCache(const QByteArray &data)
+{
+    QPluginCache cache;
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_4_4);
+    quint32 version, count;
+    stream >> version >> count;
+    if (version != PluginCacheVersion)
+        return cache;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString fileName;
+        QPluginCacheEntry entry;
+        stream >> fileName >> entry.lastModified >> entry.qt_version >> entry.debug
+               >> entry.buildKey >> entry.hasMetaData >> entry.keys;
+        cache.insert(fileName, entry);
+    }
+    if (stream.status() != QDataStream::Ok)
+        cache.clear();
+    return cache;
+}
+
+static QByteArray writePluginCache(const QPluginCache &cache)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_4_4);
+    stream << quint32(PluginCacheVersion) << quint32(cache.count());
+    for (QPluginCache::ConstIterator it = cache.constBegin(); it != cache.constEnd(); ++it) {
+        const QPluginCacheEntry &entry = it.value();
+        stream << it.key() << entry.lastModified << entry.qt_version << entry.debug
+               << entry.buildKey << entry.hasMetaData << entry.keys;
+    }
+    return data;
+}
+
 QFactoryLoader::QFactoryLoader(const char *iid,
                                const QStringList &paths, const QString &suffix,
                                Qt::CaseSensitivity cs)
@@ -57,13 +116,44 @@ QFactoryLoader::QFactoryLoader(const char *iid,
         if (!QDir(path).exists(QLatin1String(".")))
             continue;
         QStringList plugins = QDir(path).entryList(QDir::Files);
+
+        QString cacheKey = QString::fromLatin1("Qt Plugin Directory Cache %1.%2/%3")
+                           .arg((QT_VERSION & 0xff0000) >> 16)
+                           .arg((QT_VERSION & 0xff00) >> 8)
+                           .arg(QDir::cleanPath(path));
+        QPluginCache cache = readPluginCache(settings.value(cacheKey).toByteArray());
+        bool cacheChanged = false;
+
         QLibraryPrivate *library = 0;
         for (int j = 0; j < plugins.count(); ++j) {
             QString fileName = QDir::cleanPath(path + QLatin1Char('/') + plugins.at(j));
             if (qt_debug_component()) {
                 qDebug() << "QFactoryLoader::QFactoryLoader() looking at" << fileName;
             }
-            library = QLibraryPrivate::findOrCreate(QFileInfo(fileName).canonicalFilePath());
+            QFileInfo fileInfo(fileName);
+            QString lastModified;
+#ifndef QT_NO_DATESTRING
+            lastModified = fileInfo.lastModified().toString(Qt::ISODate);
+#endif
+            library = QLibraryPrivate::findOrCreate(fileInfo.canonicalFilePath());
+
+            QPluginCache::Iterator entry = cache.find(plugins.at(j));
+            if (entry != cache.end() && entry->lastModified == lastModified) {
+                library->setPluginData(entry->qt_version, entry->debug, entry->buildKey);
+            } else {
+                library->queryPluginData();
+                QPluginCacheEntry queried;
+                queried.lastModified = lastModified;
+                queried.qt_version = library->qt_version;
+                queried.debug = library->debug;
+                queried.buildKey = library->buildKey;
+                queried.hasMetaData = library->hasMetaData;
+                if (library->hasMetaData)
+                    queried.keys.insert(library->metaDataIid, library->metaDataKeys);
+                entry = cache.insert(plugins.at(j), queried);
+                cacheChanged = true;
+            }
+
             if (!library->isPlugin()) {
                 if (qt_debug_component()) {
                     qDebug() << library->errorString;
@@ -72,16 +162,11 @@ QFactoryLoader::QFactoryLoader(const char *iid,
                 library->release();
                 continue;
             }
-            QString regkey = QString::fromLatin1("Qt Factory Cache %1.%2/%3:/%4")
-                             .arg((QT_VERSION & 0xff0000) >> 16)
-                             .arg((QT_VERSION & 0xff00) >> 8)
-                             .arg(QLatin1String(iid))
-                             .arg(fileName);
-            QStringList reg, keys;
-            reg = settings.value(regkey).toStringList();
-            if (reg.count() && library->lastModified == reg[0]) {
-                keys = reg;
-                keys.removeFirst();
+
+            QStringList keys;
+            if (entry->hasMetaData || entry->keys.contains(d->iid)) {
+                // known without loading the plugin
+                keys = entry->keys.value(d->iid);
             } else {
                 if (!library->loadPlugin()) {
                     if (qt_debug_component()) {
@@ -100,10 +185,8 @@ QFactoryLoader::QFactoryLoader(const char *iid,
                     keys = factory->keys();
                 if (keys.isEmpty())
                     library->unload();
-                reg.clear();
-                reg << library->lastModified;
-                reg += keys;
-                settings.setValue(regkey, reg);
+                entry->keys.insert(d->iid, keys);
+                cacheChanged = true;
             }
             if (qt_debug_component()) {
                 qDebug() << "keys" << keys;
@@ -129,6 +212,21 @@ QFactoryLoader::QFactoryLoader(const char *iid,
                 }
             }
         }
+
+        // forget about plugins that were removed
+        if (cache.count() != plugins.count()) {
+            QPluginCache::Iterator it = cache.begin();
+            while (it != cache.end()) {
+                if (!plugins.contains(it.key())) {
+                    it = cache.erase(it);
+                    cacheChanged = true;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        if (cacheChanged)
+            settings.setValue(cacheKey, writePluginCache(cache));
     }
 }
 
@@ -268,6 +268,29 @@ static bool qt_parse_pattern(const char *s, uint *version, bool *debug, QByteArr
     return ret;
 }
 
+/*
+  parses the QT_PLUGIN_METADATA string s of at most len bytes.
+  returns true if it names an interface.
+*/
+static bool qt_parse_metadata(const char *s, ulong len, QByteArray *iid, QStringList *keys)
+{
+    const char *end = static_cast<const char *>(memchr(s, 0, len));
+    const QList<QByteArray> lines = QByteArray(s, end ? end - s : len).split('\n');
+    for (int i = 0; i < lines.count(); ++i) {
+        const QByteArray &line = lines.at(i);
+        if (line.startsWith("iid=")) {
+            *iid = line.mid(4);
+        } else if (line.startsWith("keys=")) {
+            const QList<QByteArray> list = line.mid(5).split(';');
+            for (int j = 0; j < list.count(); ++j) {
+                if (!list.at(j).isEmpty())
+                    *keys << QString::fromUtf8(list.at(j));
+            }
+        }
+    }
+    return !iid->isEmpty();
+}
+
 #if defined(Q_OS_UNIX) && !defined(Q_OS_MAC)
 
 #if defined(Q_OS_FREEBSD) || defined(Q_OS_LINUX)
@@ -378,6 +401,17 @@ static bool qt_unix_query(const QString &library, uint *version, bool *debug, QB
 
     if (!ret && lib)
         lib->errorString = QLibrary::tr("Plugin verification data mismatch in '%1'").arg(library);
+
+    // the keys, if the plugin declares them with Q_PLUGIN_METADATA_KEYS()
+    if (ret && lib) {
+        const char metaDataPattern[] = "pattern=QT_PLUGIN_METADATA\n";
+        const ulong mlen = qstrlen(metaDataPattern);
+        long mpos = qt_find_pattern(filedata, fdlen, metaDataPattern, mlen);
+        if (mpos >= 0) {
+            lib->hasMetaData = qt_parse_metadata(filedata + mpos + mlen, fdlen - mpos - mlen,
+                                                 &lib->metaDataIid, &lib->metaDataKeys);
+        }
+    }
 #ifdef USE_MMAP
     if (mapaddr != MAP_FAILED && munmap(mapaddr, maplen) != 0) {
         if (qt_debug_component())
@@ -400,6 +434,7 @@ Q_GLOBAL_STATIC(LibraryMap, libraryMap)
 
 QLibraryPrivate::QLibraryPrivate(const QString &canonicalFileName, int verNum)
     :pHnd(0), fileName(canonicalFileName), majorVerNum(verNum), instance(0), qt_version(0),
+     debug(false), hasMetaData(false), pluginDataKnown(false),
      libraryRefCount(1), libraryUnloadCount(0), pluginState(MightBeAPlugin)
 { libraryMap()->insert(canonicalFileName, this); }
 
@@ -534,73 +569,116 @@ bool QLibrary::isLibrary(const QString &fileName)
 
 }
 
+/*
+  Reads the plugin verification data and, if present, the metadata of
+  the library, without consulting any cache. The library is only
+  loaded if the data cannot be read from the file directly.
+*/
+bool QLibraryPrivate::queryPluginData()
+{
+    bool success = false;
+    qt_version = 0;
+    debug = !QLIBRARY_AS_DEBUG;
+    buildKey.clear();
+    hasMetaData = false;
+    metaDataIid.clear();
+    metaDataKeys.clear();
+
+#if defined(Q_OS_UNIX) && !defined(Q_OS_MAC)
+    if (!pHnd) {
+        // use unix shortcut to avoid loading the library
+        success = qt_unix_query(fileName, &qt_version, &debug, &buildKey, this);
+    } else
+#endif
+    {
+        bool temporary_load = false;
+        if (!pHnd)
+            temporary_load =  load_sys();
+#  ifdef Q_CC_BOR
+        typedef const char * __stdcall (*QtPluginQueryVerificationDataFunction)();
+#  else
+        typedef const char * (*QtPluginQueryVerificationDataFunction)();
+#  endif
+        QtPluginQueryVerificationDataFunction qtPluginQueryVerificationDataFunction =
+            (QtPluginQueryVerificationDataFunction) resolve("qt_plugin_query_verification_data");
+
+        if (!qtPluginQueryVerificationDataFunction
+            || !qt_parse_pattern(qtPluginQueryVerificationDataFunction(), &qt_version, &debug, &buildKey)) {
+            qt_version = 0;
+            buildKey = "unknown";
+            if (temporary_load)
+                unload_sys();
+        } else {
+            success = true;
+            QtPluginQueryVerificationDataFunction qtPluginQueryMetaDataFunction =
+                (QtPluginQueryVerificationDataFunction) resolve("qt_plugin_query_metadata");
+            if (qtPluginQueryMetaDataFunction) {
+                const char *metaData = qtPluginQueryMetaDataFunction();
+                const char metaDataPattern[] = "pattern=QT_PLUGIN_METADATA\n";
+                const uint mlen = qstrlen(metaDataPattern);
+                if (qstrncmp(metaData, metaDataPattern, mlen) == 0)
+                    hasMetaData = qt_parse_metadata(metaData + mlen, qstrlen(metaData) - mlen,
+                                                    &metaDataIid, &metaDataKeys);
+            }
+        }
+    }
+
+    if (!success)
+        qt_version = 0;
+    pluginDataKnown = true;
+    return success;
+}
+
+/*
+  Supplies the verification data from a cache, so that isPlugin()
+  doesn't need to read it.
+*/
+void QLibraryPrivate::setPluginData(uint version, bool debugBuild, const QByteArray &key)
+{
+    qt_version = version;
+    debug = debugBuild;
+    buildKey = key;
+    pluginDataKnown = true;
+}
+
 bool QLibraryPrivate::isPlugin()
 {
     if (pluginState != MightBeAPlugin)
         return pluginState == IsAPlugin;
 
 #ifndef QT_NO_PLUGIN_CHECK
-    bool debug = !QLIBRARY_AS_DEBUG;
-    QByteArray key;
-    bool success = false;
-
     QFileInfo fileinfo(fileName);
 
 #ifndef QT_NO_DATESTRING
     lastModified  = fileinfo.lastModified().toString(Qt::ISODate);
 #endif
-    QString regkey = QString::fromLatin1("Qt Plugin Cache %1.%2.%3/%4")
-                     .arg((QT_VERSION & 0xff0000) >> 16)
-                     .arg((QT_VERSION & 0xff00) >> 8)
-                     .arg(QLIBRARY_AS_DEBUG ? QLatin1String("debug") : QLatin1String("false"))
-                     .arg(fileName);
-    QStringList reg;
-
-    QSettings settings(QSettings::UserScope, QLatin1String("Trolltech"));
-    reg = settings.value(regkey).toStringList();
-    if (reg.count() == 4 && lastModified == reg.at(3)) {
-        qt_version = reg.at(0).toUInt(0, 16);
-        debug = bool(reg.at(1).toInt());
-        key = reg.at(2).toLatin1();
-        success = qt_version != 0;
-    } else {
-#if defined(Q_OS_UNIX) && !defined(Q_OS_MAC)
-        if (!pHnd) {
-            // use unix shortcut to avoid loading the library
-            success = qt_unix_query(fileName, &qt_version, &debug, &key, this);
-        } else
-#endif
-        {
-            bool temporary_load = false;
-            if (!pHnd)
-                temporary_load =  load_sys();
-#  ifdef Q_CC_BOR
-            typedef const char * __stdcall (*QtPluginQueryVerificationDataFunction)();
-#  else
-            typedef const char * (*QtPluginQueryVerificationDataFunction)();
-#  endif
-            QtPluginQueryVerificationDataFunction qtPluginQueryVerificationDataFunction =
-                (QtPluginQueryVerificationDataFunction) resolve("qt_plugin_query_verification_data");
-
-            if (!qtPluginQueryVerificationDataFunction
-                || !qt_parse_pattern(qtPluginQueryVerificationDataFunction(), &qt_version, &debug, &key)) {
-                qt_version = 0;
-                key = "unknown";
-                if (temporary_load)
-                    unload_sys();
-            } else {
-                success = true;
-            }
+    if (!pluginDataKnown) {
+        QString regkey = QString::fromLatin1("Qt Plugin Cache %1.%2.%3/%4")
+                         .arg((QT_VERSION & 0xff0000) >> 16)
+                         .arg((QT_VERSION & 0xff00) >> 8)
+                         .arg(QLIBRARY_AS_DEBUG ? QLatin1String("debug") : QLatin1String("false"))
+                         .arg(fileName);
+        QStringList reg;
+
+        QSettings settings(QSettings::UserScope, QLatin1String("Trolltech"));
+        reg = settings.value(regkey).toStringList();
+        if (reg.count() == 4 && lastModified == reg.at(3)) {
+            setPluginData(reg.at(0).toUInt(0, 16), bool(reg.at(1).toInt()), reg.at(2).toLatin1());
+        } else {
+            queryPluginData();
+
+            QStringList queried;
+            queried << QString::number(qt_version,16)
+                    << QString::number((int)debug)
+                    << QLatin1String(buildKey)
+                    << lastModified;
+            settings.setValue(regkey, queried);
         }
-
-        QStringList queried;
-        queried << QString::number(qt_version,16)
-                << QString::number((int)debug)
-                << QLatin1String(key)
-                << lastModified;
-        settings.setValue(regkey, queried);
     }
 
+    const QByteArray &key = buildKey;
+    bool success = qt_version != 0;
+
     if (!success) {
         if (fileName.isEmpty()) {
             errorString = QLibrary::tr("The shared library was not found.");
@@ -64,11 +64,20 @@ public:
     QtPluginInstanceFunction instance;
     uint qt_version;
     QString lastModified;
+    bool debug;
+    QByteArray buildKey;
+
+    // from Q_PLUGIN_METADATA_KEYS(), read by queryPluginData()
+    bool hasMetaData;
+    QByteArray metaDataIid;
+    QStringList metaDataKeys;
 
     QString errorString;
     QLibrary::LoadHints loadHints;
 
     bool isPlugin();
+    bool queryPluginData();
+    void setPluginData(uint version, bool debugBuild, const QByteArray &key);
 
 
 private:
@@ -79,6 +88,7 @@ private:
     bool unload_sys();
     void *resolve_sys(const char *);
 
+    bool pluginDataKnown;
     QAtomicInt libraryRefCount;
     QAtomicInt libraryUnloadCount;
 
@@ -69,6 +69,8 @@ void Q_CORE_EXPORT qRegisterStaticPluginInstanceFunction(QtPluginInstanceFunctio
 #  define Q_EXPORT_STATIC_PLUGIN2(PLUGIN, PLUGINCLASS) \
             Q_EXPORT_PLUGIN2(PLUGIN, PLUGINCLASS)
 
+#  define Q_PLUGIN_METADATA_KEYS(IID, KEYS)
+
 #else
 // NOTE: if you change pattern, you MUST change the pattern in
 // qlibrary.cpp as well.  changing the pattern will break all
@@ -104,6 +106,17 @@ void Q_CORE_EXPORT qRegisterStaticPluginInstanceFunction(QtPluginInstanceFunctio
 
 #  define Q_EXPORT_STATIC_PLUGIN2(PLUGIN, PLUGINCLASS)
 
+// NOTE: if you change this pattern, you MUST change the pattern in
+// qlibrary.cpp as well.
+#  define Q_PLUGIN_METADATA_KEYS(IID, KEYS) \
+            static const char *qt_plugin_metadata = \
+              "pattern=""QT_PLUGIN_METADATA""\n" \
+              "iid="IID"\n" \
+              "keys="KEYS"\0"; \
+            Q_EXTERN_C Q_DECL_EXPORT \
+            const char * Q_STANDARD_CALL qt_plugin_query_metadata() \
+            { return qt_plugin_metadata; }
+
 #endif
 
 QT_END_NAMESPACE
@@ -0,0 +1,105 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef QFUTEX_P_H
+#define QFUTEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of qmutex_unix.cpp and qwaitcondition_unix.cpp.  This header file
+// may change from version to version without notice, or even be
+// removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+
+#if defined(Q_OS_LINUX) && !defined(QT_NO_FUTEX)
+#  define QT_LINUX_FUTEX
+#endif
+
+#ifdef QT_LINUX_FUTEX
+
+#include <QtCore/qatomic.h>
+
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+  Blocks while \a futex contains \a expectedValue, until another thread
+  calls qt_futex_wake() on it or the relative \a timeout expires.
+  Returns false only if the timeout expired; spurious wakeups return
+  true, so callers must always recheck their condition.
+*/
+static inline bool qt_futex_wait(QBasicAtomicInt &futex, int expectedValue,
+                                 const timespec *timeout = 0)
+{
+    int r = syscall(SYS_futex, &futex._q_value, FUTEX_WAIT, expectedValue, timeout, 0, 0);
+    return r == 0 || errno != ETIMEDOUT;
+}
+
+/*
+  Wakes up at most \a count threads blocked in qt_futex_wait() on
+  \a futex.
+*/
+static inline void qt_futex_wake(QBasicAtomicInt &futex, int count)
+{
+    (void) syscall(SYS_futex, &futex._q_value, FUTEX_WAKE, count, 0, 0, 0);
+}
+
+/*
+  Converts a timeout of \a msecs milliseconds into an absolute
+  monotonic \a deadline.
+*/
+static inline void qt_futex_deadline(timespec *deadline, unsigned long msecs)
+{
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += msecs / 1000;
+    deadline->tv_nsec += (msecs % 1000) * 1000000;
+    if (deadline->tv_nsec >= 1000000000) {
+        ++deadline->tv_sec;
+        deadline->tv_nsec -= 1000000000;
+    }
+}
+
+/*
+  Stores the time left until \a deadline in \a remaining. Returns
+  false if the deadline has passed.
+*/
+static inline bool qt_futex_remaining(const timespec &deadline, timespec *remaining)
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    remaining->tv_sec = deadline.tv_sec - now.tv_sec;
+    remaining->tv_nsec = deadline.tv_nsec - now.tv_nsec;
+    if (remaining->tv_nsec < 0) {
+        --remaining->tv_sec;
+        remaining->tv_nsec += 1000000000;
+    }
+    return remaining->tv_sec >= 0;
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_LINUX_FUTEX
+
+#endif // QFUTEX_P_H
@@ -27,6 +27,7 @@
 //
 
 #include <QtCore/qglobal.h>
+#include "qfutex_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -44,7 +45,12 @@ public:
     ulong owner;
     uint count;
 
-#if defined(Q_OS_UNIX)
+#if defined(QT_LINUX_FUTEX)
+    // 0: no wakeup, 1: wakeup pending, 2: wakeup pending or threads asleep
+    QAtomicInt wakeup;
+    // adaptive estimate of how long to spin before sleeping
+    int spinCount;
+#elif defined(Q_OS_UNIX)
     volatile bool wakeup;
     pthread_mutex_t mutex;
     pthread_cond_t cond;
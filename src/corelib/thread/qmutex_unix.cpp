@@ -23,6 +23,90 @@
 
 QT_BEGIN_NAMESPACE
 
+#if defined(QT_LINUX_FUTEX)
+
+// spinning only pays off if the lock owner can run at the same time
+static bool spinningEnabled()
+{
+    static int cpus = 0;
+    if (cpus == 0)
+        cpus = qMax(1, int(sysconf(_SC_NPROCESSORS_ONLN)));
+    return cpus > 1;
+}
+
+static inline void cpuRelax()
+{
+#if defined(Q_CC_GNU) && (defined(QT_ARCH_I386) || defined(QT_ARCH_X86_64))
+    asm volatile ("rep; nop" ::: "memory");
+#endif
+}
+
+enum { MaximumSpinCount = 100 };
+
+QMutexPrivate::QMutexPrivate(QMutex::RecursionMode mode)
+    : recursive(mode == QMutex::Recursive), contenders(0), owner(0), count(0), wakeup(0),
+      spinCount(0)
+{
+}
+
+QMutexPrivate::~QMutexPrivate()
+{
+}
+
+ulong QMutexPrivate::self()
+{ return (ulong) pthread_self(); }
+
+bool QMutexPrivate::wait(int timeout)
+{
+    // The owner usually unlocks soon, so spin for a while before
+    // sleeping. The spin count adapts to how long it took recently.
+    if (spinningEnabled()) {
+        const int maximumSpins = qMin(int(MaximumSpinCount), spinCount * 2 + 10);
+        int spins = 0;
+        while (spins < maximumSpins) {
+            if (wakeup == 1 && wakeup.testAndSetAcquire(1, 0)) {
+                spinCount += (spins - spinCount) / 8;
+                return true;
+            }
+            cpuRelax();
+            ++spins;
+        }
+        spinCount += (spins - spinCount) / 8;
+    }
+
+    timespec deadline, remaining;
+    if (timeout >= 0)
+        qt_futex_deadline(&deadline, timeout);
+
+    // once we have slept, other threads may be asleep as well, so the
+    // wakeup is consumed by setting it to 2 instead of 0
+    int consumed = 0;
+    forever {
+        if (wakeup.testAndSetAcquire(1, consumed))
+            return true;
+        if (!wakeup.testAndSetRelaxed(0, 2) && wakeup != 2)
+            continue;
+        consumed = 2;
+        if (timeout >= 0) {
+            if (!qt_futex_remaining(deadline, &remaining)
+                || !qt_futex_wait(wakeup, 2, &remaining)) {
+                // timed out; leave the word at 2, other threads may be asleep
+                return wakeup.testAndSetAcquire(1, 2);
+            }
+        } else {
+            qt_futex_wait(wakeup, 2);
+        }
+    }
+}
+
+void QMutexPrivate::wakeUp()
+{
+    if (wakeup.fetchAndStoreRelease(1) == 2)
+        qt_futex_wake(wakeup, 1);
+}
+
+#else // QT_LINUX_FUTEX
+
 static void report_error(int code, const char *where, const char *what)
 {
     if (code != 0)
@@ -83,6 +167,8 @@ void QMutexPrivate::wakeUp()
     report_error(pthread_mutex_unlock(&mutex), "QMutex::unlock", "mutex unlock");
 }
 
+#endif // QT_LINUX_FUTEX
+
 QT_END_NAMESPACE
 
 #endif // QT_NO_THREAD
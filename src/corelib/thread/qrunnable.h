@@ -0,0 +1,47 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef QRUNNABLE_H
+#define QRUNNABLE_H
+
+#include <QtCore/qatomic.h>
+
+QT_BEGIN_HEADER
+
+QT_BEGIN_NAMESPACE
+
+QT_MODULE(Core)
+
+class Q_CORE_EXPORT QRunnable
+{
+    QAtomicInt ref;
+
+    friend class QThreadPool;
+    friend class QThreadPoolPrivate;
+    friend class QThreadPoolThread;
+
+public:
+    virtual void run() = 0;
+
+    QRunnable() : ref(0) { }
+    virtual ~QRunnable();
+
+    bool autoDelete() const { return ref != -1; }
+    void setAutoDelete(bool autoDelete) { ref = autoDelete ? 0 : -1; }
+};
+
+QT_END_NAMESPACE
+
+QT_END_HEADER
+
+#endif
@@ -49,7 +49,8 @@ QT_BEGIN_NAMESPACE
 
 QThreadData::QThreadData(int initialRefCount)
     : _ref(initialRefCount), thread(0),
-      quitNow(false), loopLevel(0), eventDispatcher(0), canWait(true)
+      quitNow(false), loopLevel(0), eventDispatcher(0), canWait(true),
+      metaCallEventPool(0)
 {
     // fprintf(stderr, "QThreadData %p created\n", this);
 }
@@ -62,15 +63,19 @@ QThreadData::~QThreadData()
     thread = 0;
     delete t;
 
+    postEventList.takeIncoming();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
-            --pe.receiver->d_func()->postedEvents;
+            pe.receiver->d_func()->postedEvents.deref();
             pe.event->posted = false;
             delete pe.event;
         }
     }
 
+    if (metaCallEventPool)
+        QMetaCallEvent::releasePool(metaCallEventPool);
+
     // fprintf(stderr, "QThreadData %p destroyed\n", this);
 }
 
@@ -97,6 +102,69 @@ void QThreadData::deref()
 }
 
 
+/*
+  QPostEventList
+*/
+
+/*
+    Inserts \a ev after all events of equal or higher priority. The
+    mutex must be locked.
+*/
+void QPostEventList::addEvent(const QPostEvent &ev)
+{
+    if (isEmpty() || last().priority >= ev.priority) {
+        // optimization: we can simply append if the last event in
+        // the queue has higher or equal priority
+        append(ev);
+    } else {
+        // insert event in descending priority order, using upper
+        // bound for a given priority (to ensure proper ordering
+        // of events with the same priority)
+        QPostEventList::iterator begin = this->begin() + insertionOffset, end = this->end();
+        QPostEventList::iterator at = qUpperBound(begin, end, ev.priority);
+        insert(at, ev);
+    }
+}
+
+/*
+    Queues \a event for \a receiver without locking the mutex. Events
+    queued this way have Qt::NormalEventPriority and are moved into the
+    list by the next call to takeIncoming().
+*/
+void QPostEventList::pushIncoming(QObject *receiver, QMetaCallEvent *event)
+{
+    event->postedReceiver_ = receiver;
+    forever {
+        QMetaCallEvent *head = incoming;
+        event->nextPosted_ = head;
+        if (incoming.testAndSetRelease(head, event))
+            break;
+    }
+}
+
+/*
+    Moves the events queued by pushIncoming() into the list, in the
+    order they were posted. The mutex must be locked.
+*/
+void QPostEventList::takeIncoming()
+{
+    QMetaCallEvent *event = incoming.fetchAndStoreAcquire(0);
+    if (!event)
+        return;
+
+    // the incoming queue is a stack, so reverse it first
+    QMetaCallEvent *first = 0;
+    while (event) {
+        QMetaCallEvent *next = event->nextPosted_;
+        event->nextPosted_ = first;
+        first = event;
+        event = next;
+    }
+
+    for (event = first; event; event = event->nextPosted_)
+        addEvent(QPostEvent(event->postedReceiver_, event, Qt::NormalEventPriority));
+}
+
 #ifndef QT_NO_THREAD
 /*
   QThreadPrivate
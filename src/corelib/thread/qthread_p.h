@@ -74,9 +74,16 @@ public:
 
     QMutex mutex;
 
+    // meta call events posted without taking the mutex, most recent first
+    QAtomicPointer<QMetaCallEvent> incoming;
+
     inline QPostEventList()
-        : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0)
+        : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0), incoming(0)
     { }
+
+    void addEvent(const QPostEvent &ev);
+    void pushIncoming(QObject *receiver, QMetaCallEvent *event);
+    void takeIncoming();
 };
 
 class Q_CORE_EXPORT QThreadData
@@ -101,6 +108,7 @@ public:
     QPostEventList postEventList;
     bool canWait;
     QHash<int, void *> tls;
+    QMetaCallEventPool *metaCallEventPool;
 };
 
 #ifndef QT_NO_THREAD
@@ -20,6 +20,9 @@
 #  include "../kernel/qeventdispatcher_glib_p.h"
 #endif
 #include <private/qeventdispatcher_unix_p.h>
+#if defined(Q_OS_LINUX)
+#  include <private/qeventdispatcher_epoll_p.h>
+#endif
 
 #include "qthreadstorage.h"
 
@@ -130,6 +133,11 @@ void QThreadPrivate::createEventDispatcher(QThreadData *data)
         && QEventDispatcherGlib::versionSupported())
         data->eventDispatcher = new QEventDispatcherGlib;
     else
+#endif
+#if defined(Q_OS_LINUX)
+    if (qgetenv("QT_NO_EPOLL").isEmpty() && QEventDispatcherEPoll::isSupported())
+        data->eventDispatcher = new QEventDispatcherEPoll;
+    else
 #endif
         data->eventDispatcher = new QEventDispatcherUNIX;
     data->eventDispatcher->startingUp();
@@ -0,0 +1,753 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "qthreadpool.h"
+#include "qthreadpool_p.h"
+
+#ifndef QT_NO_THREAD
+
+QT_BEGIN_NAMESPACE
+
+inline bool operator<(int priority, const QPair<QRunnable *, int> &p)
+{
+    return p.second < priority;
+}
+inline bool operator<(const QPair<QRunnable *, int> &p, int priority)
+{
+    return priority < p.second;
+}
+
+Q_GLOBAL_STATIC(QThreadPool, theInstance)
+
+/*
+    QThreadPoolThread is a pool worker. Besides the pool's shared
+    queue, every worker owns a run queue of its own: runnables that
+    are started from inside a worker are pushed to the back of that
+    worker's queue and popped from the back again (LIFO, which keeps
+    related work on a warm cache), while idle workers steal from the
+    front (FIFO, which tends to hand out the largest pieces of
+    work). The owner only takes its own queueMutex on the fast path;
+    the pool mutex is needed only to go idle, to take work from the
+    shared queue or to steal.
+*/
+class QThreadPoolThread : public QThread
+{
+    Q_OBJECT
+public:
+    QThreadPoolThread(QThreadPoolPrivate *manager);
+    void run();
+
+    QRunnable *popLocalTask();
+    static void runTask(QRunnable *r);
+
+    QThreadPoolPrivate *manager;
+    QRunnable *runnable;
+
+    QMutex queueMutex;
+    QList<QRunnable *> localQueue;
+};
+
+/*! \internal
+
+*/
+QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
+    : manager(manager), runnable(0)
+{ }
+
+/*! \internal
+
+    Runs \a r and deletes it if this was the last pending run of an
+    auto-deleting runnable.
+*/
+inline void QThreadPoolThread::runTask(QRunnable *r)
+{
+    const bool autoDelete = r->autoDelete();
+    r->run();
+    if (autoDelete && !r->ref.deref())
+        delete r;
+}
+
+/*! \internal
+
+    Pops the most recently pushed runnable from the thread's own run
+    queue. Only the owning thread calls this function.
+*/
+QRunnable *QThreadPoolThread::popLocalTask()
+{
+    QMutexLocker locker(&queueMutex);
+    if (localQueue.isEmpty())
+        return 0;
+    return localQueue.takeLast();
+}
+
+/*! \internal
+
+*/
+void QThreadPoolThread::run()
+{
+    QRunnable *r = runnable;
+    runnable = 0;
+
+    for (;;) {
+        // drain our own run queue without touching the pool mutex
+        while (r) {
+            runTask(r);
+            r = popLocalTask();
+        }
+
+        QMutexLocker locker(&manager->mutex);
+        for (;;) {
+            if (manager->isExiting)
+                return;
+
+            // expire this thread if the pool is over capacity
+            if (manager->tooManyThreadsActive()) {
+                manager->retireThread(this);
+                return;
+            }
+
+            if ((r = manager->takeTask(this)) != 0)
+                break;
+
+            // wait for work, exiting after the expiry timeout is reached
+            ++manager->waitingThreads;
+            if (manager->activeThreadCount() == 0)
+                manager->noActiveThreads.wakeAll();
+            const bool expired = !manager->runnableReady.wait(locker.mutex(), manager->expiryTimeout);
+            --manager->waitingThreads;
+
+            if (expired && !manager->isExiting) {
+                if ((r = manager->takeTask(this)) != 0)
+                    break;
+                manager->retireThread(this);
+                return;
+            }
+        }
+    }
+}
+
+/*! \internal
+
+*/
+QThreadPoolPrivate::QThreadPoolPrivate()
+    : isExiting(false),
+      expiryTimeout(30000),
+      maxThreadCount(qAbs(QThread::idealThreadCount())),
+      reservedThreads(0),
+      waitingThreads(0),
+      stealIndex(0)
+{ }
+
+/*! \internal
+
+    Returns the pool worker running in the current thread, or 0 if the
+    current thread does not belong to \a pool.
+*/
+QThreadPoolThread *QThreadPoolPrivate::currentWorker(const QThreadPoolPrivate *pool)
+{
+    QThreadPoolThread *worker = qobject_cast<QThreadPoolThread *>(QThread::currentThread());
+    return (worker && worker->manager == pool) ? worker : 0;
+}
+
+/*! \internal
+
+    Starts \a task right away if a thread is available. The mutex must
+    be locked.
+*/
+bool QThreadPoolPrivate::tryStart(QRunnable *task)
+{
+    if (allThreads.isEmpty()) {
+        // always create at least one thread
+        if (task->autoDelete())
+            task->ref.ref();
+        startThread(task);
+        return true;
+    }
+
+    // can't do anything if we're over the limit
+    if (activeThreadCount() >= maxThreadCount)
+        return false;
+
+    if (task->autoDelete())
+        task->ref.ref();
+
+    if (waitingThreads > 0) {
+        // recycle an idle thread
+        enqueueTask(task);
+        runnableReady.wakeOne();
+        return true;
+    }
+
+    startThread(task);
+    return true;
+}
+
+/*! \internal
+
+    Inserts \a task into the shared queue, after all runnables of
+    equal or higher \a priority. The mutex must be locked.
+*/
+void QThreadPoolPrivate::enqueueTask(QRunnable *task, int priority)
+{
+    QList<QPair<QRunnable *, int> >::iterator at =
+        qUpperBound(queue.begin(), queue.end(), priority);
+    queue.insert(at, qMakePair(task, priority));
+}
+
+/*! \internal
+
+    Pushes \a task onto the run queue of \a worker, which must be the
+    current thread. When the queue was empty, an idle thread is woken
+    up (or a new one started) so that it can steal from it; further
+    wake-ups cascade from the thieves.
+*/
+void QThreadPoolPrivate::enqueueLocalTask(QThreadPoolThread *worker, QRunnable *task)
+{
+    worker->queueMutex.lock();
+    worker->localQueue.append(task);
+    const bool wasEmpty = (worker->localQueue.count() == 1);
+    worker->queueMutex.unlock();
+
+    if (!wasEmpty)
+        return;
+
+    QMutexLocker locker(&mutex);
+    if (waitingThreads > 0)
+        runnableReady.wakeOne();
+    else if (activeThreadCount() < maxThreadCount)
+        startThread();
+}
+
+/*! \internal
+
+    Returns the next runnable for \a thief: the head of the shared
+    queue if there is one, otherwise the oldest runnable of another
+    worker's run queue. The mutex must be locked.
+*/
+QRunnable *QThreadPoolPrivate::takeTask(QThreadPoolThread *thief)
+{
+    if (!queue.isEmpty())
+        return queue.takeFirst().first;
+
+    const int count = workers.count();
+    for (int i = 0; i < count; ++i) {
+        const int index = (stealIndex + i) % count;
+        QThreadPoolThread *victim = workers.at(index);
+        if (victim == thief)
+            continue;
+
+        QMutexLocker queueLocker(&victim->queueMutex);
+        if (victim->localQueue.isEmpty())
+            continue;
+        QRunnable *task = victim->localQueue.takeFirst();
+        const bool moreWork = !victim->localQueue.isEmpty();
+        queueLocker.unlock();
+
+        stealIndex = (index + 1) % count;
+        if (moreWork) {
+            // pass the word on to the next idle thread
+            if (waitingThreads > 0)
+                runnableReady.wakeOne();
+            else if (activeThreadCount() < maxThreadCount)
+                startThread();
+        }
+        return task;
+    }
+    return 0;
+}
+
+/*! \internal
+
+    The mutex must be locked.
+*/
+int QThreadPoolPrivate::activeThreadCount() const
+{
+    return (allThreads.count()
+            - expiredThreads.count()
+            - waitingThreads
+            + reservedThreads);
+}
+
+/*! \internal
+
+    Returns true if the run queue of any worker holds runnables that
+    idle threads could steal. The mutex must be locked.
+*/
+bool QThreadPoolPrivate::hasLocalTasks() const
+{
+    for (int i = 0; i < workers.count(); ++i) {
+        QThreadPoolThread *worker = workers.at(i);
+        QMutexLocker queueLocker(&worker->queueMutex);
+        if (!worker->localQueue.isEmpty())
+            return true;
+    }
+    return false;
+}
+
+/*! \internal
+
+    Hands queued runnables to newly started threads while the pool has
+    room for them. When the shared queue is empty, a thread is woken up
+    or started to steal from the workers' run queues instead, so that
+    their work does not stall behind a blocked worker. The mutex must be
+    locked.
+*/
+void QThreadPoolPrivate::tryToStartMoreThreads()
+{
+    while (!queue.isEmpty() && waitingThreads == 0 && activeThreadCount() < maxThreadCount)
+        startThread(queue.takeFirst().first);
+    if (!queue.isEmpty()) {
+        if (waitingThreads > 0)
+            runnableReady.wakeAll();
+    } else if (hasLocalTasks()) {
+        // thieves pass the word on while there is more to steal
+        if (waitingThreads > 0)
+            runnableReady.wakeOne();
+        else if (activeThreadCount() < maxThreadCount)
+            startThread();
+    }
+}
+
+/*! \internal
+
+    The mutex must be locked.
+*/
+bool QThreadPoolPrivate::tooManyThreadsActive() const
+{
+    const int activeThreadCount = this->activeThreadCount();
+    return activeThreadCount > maxThreadCount && (activeThreadCount - reservedThreads) > 1;
+}
+
+/*! \internal
+
+    Starts a worker with \a runnable as its first task, reusing an
+    expired thread if there is one. A worker started without a
+    runnable goes looking for work to steal. The mutex must be locked.
+*/
+void QThreadPoolPrivate::startThread(QRunnable *runnable)
+{
+    QThreadPoolThread *thread;
+    if (!expiredThreads.isEmpty()) {
+        thread = expiredThreads.dequeue();
+        // run() has returned already; let QThread finish up before restarting
+        thread->wait();
+    } else {
+        thread = new QThreadPoolThread(this);
+        thread->setObjectName(QLatin1String("Thread (pooled)"));
+        allThreads.insert(thread);
+    }
+
+    Q_ASSERT(thread->localQueue.isEmpty());
+    thread->runnable = runnable;
+    workers.append(thread);
+    thread->start();
+}
+
+/*! \internal
+
+    Moves \a thread to the list of expired threads. The thread's run
+    queue is always empty at this point, since only the owner pushes
+    to it. The mutex must be locked.
+*/
+void QThreadPoolPrivate::retireThread(QThreadPoolThread *thread)
+{
+    Q_ASSERT(thread->localQueue.isEmpty());
+    workers.removeAll(thread);
+    stealIndex = 0;
+    expiredThreads.enqueue(thread);
+    if (activeThreadCount() == 0)
+        noActiveThreads.wakeAll();
+}
+
+/*! \internal
+
+    Makes all threads exit, waits for each tread to exit and deletes it.
+    The mutex must be locked.
+*/
+void QThreadPoolPrivate::reset()
+{
+    isExiting = true;
+    runnableReady.wakeAll();
+
+    do {
+        // make a copy of the set so that we can iterate without the lock
+        QSet<QThreadPoolThread *> allThreadsCopy = allThreads;
+        allThreads.clear();
+        expiredThreads.clear();
+        workers.clear();
+        stealIndex = 0;
+
+        mutex.unlock();
+        foreach (QThreadPoolThread *thread, allThreadsCopy) {
+            thread->wait();
+            delete thread;
+        }
+        mutex.lock();
+
+        // repeat until all newly arrived threads have also completed
+    } while (!allThreads.isEmpty());
+
+    isExiting = false;
+}
+
+/*! \internal
+
+*/
+void QThreadPoolPrivate::waitForDone()
+{
+    QMutexLocker locker(&mutex);
+    while (!(queue.isEmpty() && activeThreadCount() == 0))
+        noActiveThreads.wait(locker.mutex());
+    reset();
+}
+
+/*! \internal
+
+    Removes \a runnable from the shared queue or from a pool thread's
+    run queue, if it is still waiting there, and runs it in the calling
+    thread. This lets a thread that is about to block on the result of
+    a runnable do the work itself instead.
+*/
+void QThreadPoolPrivate::stealRunnable(QRunnable *runnable)
+{
+    if (runnable == 0)
+        return;
+
+    bool found = false;
+    {
+        QMutexLocker locker(&mutex);
+        QList<QPair<QRunnable *, int> >::iterator it = queue.begin();
+        QList<QPair<QRunnable *, int> >::iterator end = queue.end();
+        while (it != end) {
+            if (it->first == runnable) {
+                found = true;
+                queue.erase(it);
+                break;
+            }
+            ++it;
+        }
+
+        for (int i = 0; !found && i < workers.count(); ++i) {
+            QThreadPoolThread *worker = workers.at(i);
+            QMutexLocker queueLocker(&worker->queueMutex);
+            found = worker->localQueue.removeOne(runnable);
+        }
+    }
+
+    if (!found)
+        return;
+
+    QThreadPoolThread::runTask(runnable);
+}
+
+/*!
+    \class QThreadPool
+    \brief The QThreadPool class manages a collection of QThreads.
+    \since 4.4
+    \threadsafe
+
+    \ingroup thread
+
+    QThreadPool manages and recyles individual QThread objects to help
+    reduce thread creation costs in programs that use threads. Each Qt
+    application has one global QThreadPool object, which can be
+    accessed by calling globalInstance().
+
+    To use one of the QThreadPool threads, subclass QRunnable and
+    implement the run() virtual function. Then create an object of
+    that class and pass it to QThreadPool::start().
+
+    \code
+        class HelloWorldTask : public QRunnable
+        {
+            void run()
+            {
+                qDebug() << "Hello world from thread" << QThread::currentThread();
+            }
+        }
+
+        HelloWorldTask *hello = new HelloWorldTask();
+        // QThreadPool takes ownership and deletes 'hello' automatically
+        QThreadPool::globalInstance()->start(hello);
+    \endcode
+
+    QThreadPool deletes the QRunnable automatically by default. Use
+    QRunnable::setAutoDelete() to change the auto-deletion flag.
+
+    QThreadPool supports executing the same QRunnable more than once
+    by calling tryStart(this) from within QRunnable::run().
+    If autoDelete is enabled the QRunnable will be deleted when
+    the last thread exits the run function. Calling start()
+    multiple times with the same QRunnable when autoDelete is enabled
+    creates a race condition and is not recommended.
+
+    Runnables started from outside the pool are placed in a shared
+    queue that is ordered by priority. Every pool thread also has a
+    run queue of its own: runnables that a pool thread starts are
+    pushed onto that queue and executed by the same thread, most
+    recent first, while idle threads steal the oldest entries from
+    busy threads. Work that fans out from inside the pool therefore
+    stays on the thread that created it unless other threads run out
+    of work, and does not contend on the shared queue. The priority
+    argument of start() only orders the shared queue.
+
+    Threads that are unused for a certain amount of time will expire.
+    The default expiry timeout is 30000 milliseconds (30 seconds).
+    This can be changed using setExpiryTimeout(). Setting a negative
+    expiry timeout disables the expiry mechanism.
+
+    Call maxThreadCount() to query the maximum number of threads to
+    be used. If needed, you can change the limit with
+    setMaxThreadCount(). The default maxThreadCount() is
+    QThread::idealThreadCount(). The activeThreadCount() function
+    returns the number of threads currently doing work.
+
+    The reserveThread() function reserves a thread for external
+    use. Use releaseThread() when your are done with the thread, so
+    that it may be reused. Essentially, these functions temporarily
+    increase or reduce the active thread count and are useful when
+    implementing time-consuming operations that are not visible to the
+    QThreadPool. A runnable that blocks waiting for other runnables
+    should call releaseThread() before it starts waiting, so that the
+    pool can start another thread in its place, and reserveThread()
+    once it is done waiting.
+
+    Note that QThreadPool is a low-level class for managing threads.
+
+    \sa QRunnable
+*/
+
+/*!
+    Constructs a thread pool with the given \a parent.
+*/
+QThreadPool::QThreadPool(QObject *parent)
+    : QObject(*new QThreadPoolPrivate, parent)
+{ }
+
+/*!
+    Destroys the QThreadPool.
+    This function will block until all runnables have been completed.
+*/
+QThreadPool::~QThreadPool()
+{
+    d_func()->waitForDone();
+}
+
+/*!
+    Returns the global QThreadPool instance.
+*/
+QThreadPool *QThreadPool::globalInstance()
+{
+    return theInstance();
+}
+
+/*!
+    Reserves a thread and uses it to run \a runnable, unless this thread will
+    make the current thread count exceed maxThreadCount().  In that case,
+    \a runnable is added to a run queue instead. The \a priority argument can
+    be used to control the run queue's order of execution.
+
+    When called from one of the pool's own threads, \a runnable is
+    pushed onto that thread's run queue instead, where it is picked up
+    either by the calling thread when it becomes idle or by another
+    pool thread that runs out of work.
+
+    Note that the thread pool takes ownership of the \a runnable if
+    \l{QRunnable::autoDelete()}{runnable->autoDelete()} returns true,
+    and the \a runnable will be deleted automatically by the thread
+    pool after the \l{QRunnable::run()}{runnable->run()} returns. If
+    \l{QRunnable::autoDelete()}{runnable->autoDelete()} returns false,
+    ownership of \a runnable remains with the caller. Note that
+    changing the auto-deletion on \a runnable after calling this
+    functions results in undefined behavior.
+*/
+void QThreadPool::start(QRunnable *runnable, int priority)
+{
+    if (!runnable)
+        return;
+
+    Q_D(QThreadPool);
+    if (QThreadPoolThread *worker = QThreadPoolPrivate::currentWorker(d)) {
+        if (runnable->autoDelete())
+            runnable->ref.ref();
+        d->enqueueLocalTask(worker, runnable);
+        return;
+    }
+
+    QMutexLocker locker(&d->mutex);
+    if (!d->tryStart(runnable)) {
+        if (runnable->autoDelete())
+            runnable->ref.ref();
+        d->enqueueTask(runnable, priority);
+
+        if (d->waitingThreads > 0)
+            d->runnableReady.wakeOne();
+    }
+}
+
+/*!
+    Attempts to reserve a thread to run \a runnable.
+
+    If no threads are available at the time of calling, then this function
+    does nothing and returns false.  Otherwise, \a runnable is run immediately
+    using one available thread and this function returns true.
+
+    Note that the thread pool takes ownership of the \a runnable if
+    \l{QRunnable::autoDelete()}{runnable->autoDelete()} returns true,
+    and the \a runnable will be deleted automatically by the thread
+    pool after the \l{QRunnable::run()}{runnable->run()} returns. If
+    \l{QRunnable::autoDelete()}{runnable->autoDelete()} returns false,
+    ownership of \a runnable remains with the caller. Note that
+    changing the auto-deletion on \a runnable after calling this
+    function results in undefined behavior.
+*/
+bool QThreadPool::tryStart(QRunnable *runnable)
+{
+    if (!runnable)
+        return false;
+
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->tryStart(runnable);
+}
+
+/*! \property QThreadPool::expiryTimeout
+
+    Threads that are unused for \a expiryTimeout milliseconds are considered
+    to have expired and will exit. Such threads will be restarted as needed.
+    The default \a expiryTimeout is 30000 milliseconds (30 seconds). If
+    \a expiryTimeout is negative, newly created threads will not expire, e.g.
+    they will not exit until the thread pool is destroyed.
+
+    Note that setting \a expiryTimeout has no effect on already running
+    threads. Only newly created threads will use the new \a expiryTimeout.
+    We recommend setting the \a expiryTimeout immediately after creating the
+    thread pool, but before calling start().
+*/
+
+int QThreadPool::expiryTimeout() const
+{
+    Q_D(const QThreadPool);
+    return d->expiryTimeout;
+}
+
+void QThreadPool::setExpiryTimeout(int expiryTimeout)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->expiryTimeout = expiryTimeout;
+}
+
+/*! \property QThreadPool::maxThreadCount
+
+    This property represents the maximum number of threads used by the thread
+    pool.
+
+    \note The thread pool will always use at least 1 thread, even if
+    \a maxThreadCount limit is zero or negative.
+
+    The default \a maxThreadCount is QThread::idealThreadCount().
+*/
+
+int QThreadPool::maxThreadCount() const
+{
+    Q_D(const QThreadPool);
+    return d->maxThreadCount;
+}
+
+void QThreadPool::setMaxThreadCount(int maxThreadCount)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+
+    if (maxThreadCount == d->maxThreadCount)
+        return;
+
+    d->maxThreadCount = maxThreadCount;
+    d->tryToStartMoreThreads();
+}
+
+/*! \property QThreadPool::activeThreadCount
+
+    This property represents the number of active threads in the thread pool.
+
+    \note It is possible for this function to return a value that is greater
+    than maxThreadCount(). See reserveThread() for more details.
+
+    \sa reserveThread(), releaseThread()
+*/
+
+int QThreadPool::activeThreadCount() const
+{
+    Q_D(const QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->activeThreadCount();
+}
+
+/*!
+    Reserves one thread, disregarding activeThreadCount() and maxThreadCount().
+
+    Once you are done with the thread, call releaseThread() to allow it to be
+    reused.
+
+    \note This function will always increase the number of active threads.
+    This means that by using this function, it is possible for
+    activeThreadCount() to return a value greater than maxThreadCount() .
+
+    \sa releaseThread()
+ */
+void QThreadPool::reserveThread()
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    ++d->reservedThreads;
+}
+
+/*!
+    Releases a thread previously reserved by a call to
+    reserveThread().
+
+    \note Calling this function without previously reserving a thread
+    temporarily increases maxThreadCount(). This is useful when a
+    thread goes to sleep waiting for more work, allowing other threads
+    to continue. Be sure to call reserveThread() when done waiting, so
+    that the thread pool can correctly maintain the
+    activeThreadCount().
+
+    \sa reserveThread()
+*/
+void QThreadPool::releaseThread()
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    --d->reservedThreads;
+    d->tryToStartMoreThreads();
+    if (d->activeThreadCount() == 0)
+        d->noActiveThreads.wakeAll();
+}
+
+/*!
+    Waits for each thread to exit and removes all threads from the thread pool.
+*/
+void QThreadPool::waitForDone()
+{
+    Q_D(QThreadPool);
+    d->waitForDone();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qthreadpool.cpp"
+#include "qthreadpool.moc"
+
+#endif
@@ -0,0 +1,73 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef QTHREADPOOL_H
+#define QTHREADPOOL_H
+
+#include <QtCore/qglobal.h>
+
+#include <QtCore/qthread.h>
+#include <QtCore/qrunnable.h>
+
+QT_BEGIN_HEADER
+
+QT_BEGIN_NAMESPACE
+
+QT_MODULE(Core)
+
+#ifndef QT_NO_THREAD
+
+class QThreadPoolPrivate;
+class Q_CORE_EXPORT QThreadPool : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QThreadPool)
+    Q_PROPERTY(int expiryTimeout READ expiryTimeout WRITE setExpiryTimeout)
+    Q_PROPERTY(int maxThreadCount READ maxThreadCount WRITE setMaxThreadCount)
+    Q_PROPERTY(int activeThreadCount READ activeThreadCount)
+    friend class QThreadPoolThread;
+    friend class QFutureInterfaceBase;
+
+public:
+    QThreadPool(QObject *parent = 0);
+    ~QThreadPool();
+
+    static QThreadPool *globalInstance();
+
+    void start(QRunnable *runnable, int priority = 0);
+    bool tryStart(QRunnable *runnable);
+
+    int expiryTimeout() const;
+    void setExpiryTimeout(int expiryTimeout);
+
+    int maxThreadCount() const;
+    void setMaxThreadCount(int maxThreadCount);
+
+    int activeThreadCount() const;
+
+    void reserveThread();
+    void releaseThread();
+
+    void waitForDone();
+
+private:
+    Q_DISABLE_COPY(QThreadPool)
+};
+
+#endif // QT_NO_THREAD
+
+QT_END_NAMESPACE
+
+QT_END_HEADER
+
+#endif
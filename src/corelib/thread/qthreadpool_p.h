@@ -0,0 +1,87 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef QTHREADPOOL_P_H
+#define QTHREADPOOL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of qthreadpool.cpp and qfutureinterface.cpp.  This header file may
+// change from version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "QtCore/qmutex.h"
+#include "QtCore/qwaitcondition.h"
+#include "QtCore/qset.h"
+#include "QtCore/qqueue.h"
+#include "QtCore/qpair.h"
+#include "private/qobject_p.h"
+
+#ifndef QT_NO_THREAD
+
+QT_BEGIN_NAMESPACE
+
+class QRunnable;
+class QThreadPoolThread;
+
+class QThreadPoolPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QThreadPool)
+    friend class QThreadPoolThread;
+
+public:
+    QThreadPoolPrivate();
+
+    static QThreadPoolThread *currentWorker(const QThreadPoolPrivate *pool);
+
+    bool tryStart(QRunnable *task);
+    void enqueueTask(QRunnable *task, int priority = 0);
+    void enqueueLocalTask(QThreadPoolThread *worker, QRunnable *task);
+    QRunnable *takeTask(QThreadPoolThread *thief);
+    int activeThreadCount() const;
+
+    bool hasLocalTasks() const;
+    void tryToStartMoreThreads();
+    bool tooManyThreadsActive() const;
+
+    void startThread(QRunnable *runnable = 0);
+    void retireThread(QThreadPoolThread *thread);
+    void reset();
+    void waitForDone();
+    void stealRunnable(QRunnable *);
+
+    mutable QMutex mutex;
+    QWaitCondition runnableReady;
+    QSet<QThreadPoolThread *> allThreads;
+    QList<QThreadPoolThread *> workers;
+    QQueue<QThreadPoolThread *> expiredThreads;
+    QList<QPair<QRunnable *, int> > queue;
+    QWaitCondition noActiveThreads;
+
+    bool isExiting;
+    int expiryTimeout;
+    int maxThreadCount;
+    int reservedThreads;
+    int waitingThreads;
+    int stealIndex;
+};
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_THREAD
+#endif
@@ -26,20 +26,131 @@
 
 QT_BEGIN_NAMESPACE
 
+#if defined(QT_LINUX_FUTEX)
+
+/*
+  The waiting threads sleep on a futex word that changes on every
+  wakeup, so a wakeup between unlocking the mutex and going to sleep is
+  never lost. The counters are guarded by a (futex based) QMutex.
+*/
+struct QWaitConditionPrivate {
+    QMutex mutex;
+    QAtomicInt sequence;
+    int waiters;
+    int wakeups;
+
+    QWaitConditionPrivate()
+        : sequence(0), waiters(0), wakeups(0)
+    { }
+
+    void lock()
+    {
+        mutex.lock();
+    }
+
+    void wakeOne()
+    {
+        QMutexLocker locker(&mutex);
+        if (wakeups < waiters) {
+            ++wakeups;
+            sequence.ref();
+            qt_futex_wake(sequence, 1);
+        }
+    }
+
+    void wakeAll()
+    {
+        QMutexLocker locker(&mutex);
+        if (wakeups < waiters) {
+            wakeups = waiters;
+            sequence.ref();
+            qt_futex_wake(sequence, INT_MAX);
+        }
+    }
+
+    // called with mutex locked, returns with it unlocked
+    bool wait(unsigned long time)
+    {
+        timespec deadline, remaining;
+        if (time != ULONG_MAX)
+            qt_futex_deadline(&deadline, time);
+
+        bool timedOut = false;
+        forever {
+            const int currentSequence = sequence;
+            mutex.unlock();
+            if (time != ULONG_MAX) {
+                timedOut = !qt_futex_remaining(deadline, &remaining)
+                           || !qt_futex_wait(sequence, currentSequence, &remaining);
+            } else {
+                qt_futex_wait(sequence, currentSequence);
+            }
+            mutex.lock();
+            // a wakeup that raced with the timeout still counts
+            if (wakeups > 0 || timedOut)
+                break;
+        }
+
+        Q_ASSERT_X(waiters > 0, "QWaitCondition::wait", "internal error (waiters)");
+        --waiters;
+        const bool woken = wakeups > 0;
+        if (woken)
+            --wakeups;
+        mutex.unlock();
+        return woken;
+    }
+};
+
+#else // QT_LINUX_FUTEX
+
 static void report_error(int code, const char *where, const char *what)
 {
     if (code != 0)
         qWarning("%s: %s failure: %s", where, what, qPrintable(qt_error_string(code)));
 }
 
-
-
 struct QWaitConditionPrivate {
     pthread_mutex_t mutex;
     pthread_cond_t cond;
     int waiters;
     int wakeups;
 
+    QWaitConditionPrivate()
+        : waiters(0), wakeups(0)
+    {
+        report_error(pthread_mutex_init(&mutex, NULL), "QWaitCondition", "mutex init");
+        report_error(pthread_cond_init(&cond, NULL), "QWaitCondition", "cv init");
+    }
+
+    ~QWaitConditionPrivate()
+    {
+        report_error(pthread_cond_destroy(&cond), "QWaitCondition", "cv destroy");
+        report_error(pthread_mutex_destroy(&mutex), "QWaitCondition", "mutex destroy");
+    }
+
+    void lock()
+    {
+        report_error(pthread_mutex_lock(&mutex), "QWaitCondition::wait()", "mutex lock");
+    }
+
+    void wakeOne()
+    {
+        report_error(pthread_mutex_lock(&mutex), "QWaitCondition::wakeOne()", "mutex lock");
+        wakeups = qMin(wakeups + 1, waiters);
+        report_error(pthread_cond_signal(&cond), "QWaitCondition::wakeOne()", "cv signal");
+        report_error(pthread_mutex_unlock(&mutex), "QWaitCondition::wakeOne()", "mutex unlock");
+    }
+
+    void wakeAll()
+    {
+        report_error(pthread_mutex_lock(&mutex), "QWaitCondition::wakeAll()", "mutex lock");
+        wakeups = waiters;
+        report_error(pthread_cond_broadcast(&cond), "QWaitCondition::wakeAll()", "cv broadcast");
+        report_error(pthread_mutex_unlock(&mutex), "QWaitCondition::wakeAll()", "mutex unlock");
+    }
+
+    // called with mutex locked, returns with it unlocked
+
     bool wait(unsigned long time)
     {
         int code;
@@ -82,6 +193,8 @@ struct QWaitConditionPrivate {
 };
 
 
+#endif // QT_LINUX_FUTEX
+
 /*!
     \class QWaitCondition
     \brief The QWaitCondition class provides a condition variable for
@@ -185,9 +298,6 @@ struct QWaitConditionPrivate {
 QWaitCondition::QWaitCondition()
 {
     d = new QWaitConditionPrivate;
-    report_error(pthread_mutex_init(&d->mutex, NULL), "QWaitCondition", "mutex init");
-    report_error(pthread_cond_init(&d->cond, NULL), "QWaitCondition", "cv init");
-    d->waiters = d->wakeups = 0;
 }
 
 
@@ -196,8 +306,6 @@ QWaitCondition::QWaitCondition()
 */
 QWaitCondition::~QWaitCondition()
 {
-    report_error(pthread_cond_destroy(&d->cond), "QWaitCondition", "cv destroy");
-    report_error(pthread_mutex_destroy(&d->mutex), "QWaitCondition", "mutex destroy");
     delete d;
 }
 
@@ -214,10 +322,7 @@ QWaitCondition::~QWaitCondition()
 */
 void QWaitCondition::wakeOne()
 {
-    report_error(pthread_mutex_lock(&d->mutex), "QWaitCondition::wakeOne()", "mutex lock");
-    d->wakeups = qMin(d->wakeups + 1, d->waiters);
-    report_error(pthread_cond_signal(&d->cond), "QWaitCondition::wakeOne()", "cv signal");
-    report_error(pthread_mutex_unlock(&d->mutex), "QWaitCondition::wakeOne()", "mutex unlock");
+    d->wakeOne();
 }
 
 /*!
@@ -229,10 +334,7 @@ void QWaitCondition::wakeOne()
  */
 void QWaitCondition::wakeAll()
 {
-    report_error(pthread_mutex_lock(&d->mutex), "QWaitCondition::wakeAll()", "mutex lock");
-    d->wakeups = d->waiters;
-    report_error(pthread_cond_broadcast(&d->cond), "QWaitCondition::wakeAll()", "cv broadcast");
-    report_error(pthread_mutex_unlock(&d->mutex), "QWaitCondition::wakeAll()", "mutex unlock");
+    d->wakeAll();
 }
 
 /*!
@@ -267,7 +369,7 @@ bool QWaitCondition::wait(QMutex *mutex, unsigned long time)
         return false;
     }
 
-    report_error(pthread_mutex_lock(&d->mutex), "QWaitCondition::wait()", "mutex lock");
+    d->lock();
     ++d->waiters;
     mutex->unlock();
 
@@ -311,7 +413,7 @@ bool QWaitCondition::wait(QReadWriteLock *readWriteLock, unsigned long time)
         return false;
     }
 
-    report_error(pthread_mutex_lock(&d->mutex), "QWaitCondition::wait()", "mutex lock");
+    d->lock();
     ++d->waiters;
 
     int previousAccessCount = readWriteLock->d->accessCount;
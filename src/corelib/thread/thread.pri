@@ -3,24 +3,30 @@
 # public headers
 HEADERS += thread/qmutex.h \
            thread/qreadwritelock.h \
+           thread/qrunnable.h \
            thread/qsemaphore.h \
  	   thread/qthread.h \
+ 	   thread/qthreadpool.h \
  	   thread/qthreadstorage.h \
  	   thread/qwaitcondition.h \
 	   thread/qatomic.h
 	
 # private headers
-HEADERS += thread/qmutex_p.h \
+HEADERS += thread/qfutex_p.h \
+           thread/qmutex_p.h \
            thread/qmutexpool_p.h \
            thread/qreadwritelock_p.h \
-           thread/qthread_p.h
+           thread/qthread_p.h \
+           thread/qthreadpool_p.h
 
 SOURCES += thread/qatomic.cpp \
            thread/qmutex.cpp \
            thread/qreadwritelock.cpp \
+           thread/qrunnable.cpp \
 	   thread/qmutexpool.cpp \
 	   thread/qsemaphore.cpp \
  	   thread/qthread.cpp \
+ 	   thread/qthreadpool.cpp \
            thread/qthreadstorage.cpp 
 
 unix:SOURCES += thread/qmutex_unix.cpp \
@@ -0,0 +1,781 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "qbtreemap.h"
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QBTreeMap is a B+-tree. All items live in the leaves, which hold
+    their keys and their values in two arrays and are doubly linked in
+    key order; the branches above them only hold separator keys and
+    child pointers. Every node knows its parent, so that a split or a
+    removal can be propagated upwards without a search path.
+
+    Nodes are not rebalanced on removal. A leaf that becomes empty is
+    unlinked, a leaf that becomes sparse absorbs its right sibling, and
+    branches go away with their last child. This keeps removals cheap
+    and never makes the tree deeper than it was at its largest.
+*/
+
+QBTreeMapData QBTreeMapData::shared_null = {
+    Q_BASIC_ATOMIC_INITIALIZER(1), 0, 0, true, 0, 0, 0
+};
+
+QBTreeMapData *QBTreeMapData::createData()
+{
+    QBTreeMapData *d = new QBTreeMapData;
+    d->ref = 1;
+    d->size = 0;
+    d->depth = 0;
+    d->sharable = true;
+    d->root = 0;
+    d->first = 0;
+    d->last = 0;
+    return d;
+}
+
+int QBTreeMapData::indexInParent(const Node *node)
+{
+    const Branch *parent = node->parent;
+    Q_ASSERT(parent);
+    int i = 0;
+    while (parent->children[i] != node)
+        ++i;
+    Q_ASSERT(i < parent->count);
+    return i;
+}
+
+void QBTreeMapData::unlinkLeaf(Leaf *leaf)
+{
+    if (leaf->prev)
+        leaf->prev->next = leaf->next;
+    else
+        first = leaf->next;
+    if (leaf->next)
+        leaf->next->prev = leaf->prev;
+    else
+        last = leaf->prev;
+}
+
+/*!
+    \class QBTreeMap
+    \brief The QBTreeMap class is a template class that provides a B+-tree-based dictionary.
+    \since 4.4
+
+    \ingroup tools
+    \ingroup shared
+    \reentrant
+
+    QBTreeMap\<Key, T\> stores (key, value) pairs sorted by key, and
+    has the same API as QMap: lookups, lowerBound() and upperBound()
+    are logarithmic, iteration is in key order, and insertMulti()
+    allows several values per key.
+
+    Where QMap allocates every item separately and links the items
+    in a skip list, QBTreeMap packs up to several dozen items into
+    each leaf of a B+-tree, keys and values in separate arrays. A
+    lookup touches a handful of nodes instead of chasing pointers
+    all over the heap, iterating walks arrays, and the per-item
+    memory overhead is a fraction of QMap's. Inserting items in
+    ascending key order, for example when filling a map from sorted
+    data, appends to the last leaf without searching the tree at all
+    and leaves the nodes completely full.
+
+    The trade-off compared to QMap is that items are moved in memory
+    when the nodes they live in are split or merged:
+
+    \list
+    \i Inserting or removing an item invalidates references and
+       pointers to values, as well as all iterators, except for the
+       iterator returned by the function that modified the map.
+    \i Items are moved around by insertions and removals, so Key and
+       T should be cheap to copy; types declared
+       \l{Q_DECLARE_TYPEINFO()}{movable} are moved with memmove().
+    \endlist
+
+    The key type must provide operator<(), as for QMap.
+
+    QBTreeMap is \l{implicitly shared}, and provides both
+    \l{STL-style iterators} (QBTreeMap::const_iterator and
+    QBTreeMap::iterator) and \l{Java-style iterators}
+    (QBTreeMapIterator and QMutableBTreeMapIterator).
+
+    \sa QMap, QBTreeMapIterator, QMutableBTreeMapIterator
+*/
+
+/*! \fn QBTreeMap::QBTreeMap()
+
+    Constructs an empty map.
+
+    \sa clear()
+*/
+
+/*! \fn QBTreeMap::QBTreeMap(const QBTreeMap<Key, T> &other)
+
+    Constructs a copy of \a other.
+
+    This operation occurs in \l{constant time}, because QBTreeMap is
+    \l{implicitly shared}.
+
+    \sa operator=()
+*/
+
+/*! \fn QBTreeMap::~QBTreeMap()
+
+    Destroys the map. References to the values in the map, and all
+    iterators over this map, become invalid.
+*/
+
+/*! \fn QBTreeMap<Key, T> &QBTreeMap::operator=(const QBTreeMap<Key, T> &other)
+
+    Assigns \a other to this map and returns a reference to this map.
+*/
+
+/*! \fn bool QBTreeMap::operator==(const QBTreeMap<Key, T> &other) const
+
+    Returns true if \a other is equal to this map; otherwise returns
+    false.
+
+    Two maps are considered equal if they contain the same (key,
+    value) pairs, in the same order. This function requires the value
+    type to implement \c operator==().
+
+    \sa operator!=()
+*/
+
+/*! \fn bool QBTreeMap::operator!=(const QBTreeMap<Key, T> &other) const
+
+    Returns true if \a other is not equal to this map; otherwise
+    returns false.
+
+    \sa operator==()
+*/
+
+/*! \fn int QBTreeMap::size() const
+
+    Returns the number of (key, value) pairs in the map.
+
+    \sa isEmpty(), count()
+*/
+
+/*! \fn bool QBTreeMap::isEmpty() const
+
+    Returns true if the map contains no items; otherwise returns
+    false.
+
+    \sa size()
+*/
+
+/*! \fn void QBTreeMap::detach()
+
+    \internal
+*/
+
+/*! \fn bool QBTreeMap::isDetached() const
+
+    \internal
+*/
+
+/*! \fn void QBTreeMap::setSharable(bool sharable)
+
+    \internal
+*/
+
+/*! \fn void QBTreeMap::clear()
+
+    Removes all items from the map.
+
+    \sa remove()
+*/
+
+/*! \fn int QBTreeMap::remove(const Key &key)
+
+    Removes all the items that have the key \a key from the map.
+    Returns the number of items removed.
+
+    \sa clear(), take()
+*/
+
+/*! \fn T QBTreeMap::take(const Key &key)
+
+    Removes the item with the key \a key from the map and returns
+    the value associated with it.
+
+    If the item does not exist in the map, the function simply
+    returns a \l{default-constructed value}. If there are multiple
+    items for \a key in the map, only the most recently inserted one
+    is removed and returned.
+
+    \sa remove()
+*/
+
+/*! \fn bool QBTreeMap::contains(const Key &key) const
+
+    Returns true if the map contains an item with key \a key;
+    otherwise returns false.
+
+    \sa count()
+*/
+
+/*! \fn const T QBTreeMap::value(const Key &key) const
+
+    Returns the value associated with the key \a key.
+
+    If the map contains no item with key \a key, the function
+    returns a \l{default-constructed value}. If there are multiple
+    items for \a key in the map, the value of the most recently
+    inserted one is returned.
+
+    \sa key(), values(), contains(), operator[]()
+*/
+
+/*! \fn const T QBTreeMap::value(const Key &key, const T &defaultValue) const
+    \overload
+
+    If the map contains no item with key \a key, the function returns
+    \a defaultValue.
+*/
+
+/*! \fn T &QBTreeMap::operator[](const Key &key)
+
+    Returns the value associated with the key \a key as a modifiable
+    reference.
+
+    If the map contains no item with key \a key, the function inserts
+    a \l{default-constructed value} into the map with key \a key, and
+    returns a reference to it. The reference is valid until the next
+    insertion into or removal from the map.
+
+    \sa insert(), value()
+*/
+
+/*! \fn const T QBTreeMap::operator[](const Key &key) const
+
+    \overload
+
+    Same as value().
+*/
+
+/*! \fn QList<Key> QBTreeMap::uniqueKeys() const
+
+    Returns a list containing all the different keys in the map, in
+    ascending order. Keys that occur multiple times in the map occur
+    only once in the returned list.
+
+    \sa keys(), values()
+*/
+
+/*! \fn QList<Key> QBTreeMap::keys() const
+
+    Returns a list containing all the keys in the map in ascending
+    order. Keys that occur multiple times in the map also occur
+    multiple times in the list.
+
+    The order is guaranteed to be the same as that used by values().
+
+    \sa uniqueKeys(), values(), key()
+*/
+
+/*! \fn QList<Key> QBTreeMap::keys(const T &value) const
+
+    \overload
+
+    Returns a list containing all the keys associated with value \a
+    value in ascending order.
+
+    This function can be slow (\l{linear time}), because QBTreeMap's
+    internal data structure is optimized for fast lookup by key, not
+    by value.
+*/
+
+/*! \fn const Key QBTreeMap::key(const T &value) const
+
+    Returns the first key with value \a value.
+
+    If the map contains no item with value \a value, the function
+    returns a \link {default-constructed value} default-constructed
+    key \endlink.
+
+    This function can be slow (\l{linear time}), because QBTreeMap's
+    internal data structure is optimized for fast lookup by key, not
+    by value.
+
+    \sa value(), keys()
+*/
+
+/*! \fn const Key QBTreeMap::key(const T &value, const Key &defaultKey) const
+    \overload
+
+    Returns the first key with value \a value, or \a defaultKey if
+    the map contains no item with value \a value.
+*/
+
+/*! \fn QList<T> QBTreeMap::values() const
+
+    Returns a list containing all the values in the map, in ascending
+    order of their keys. If a key is associated with multiple values,
+    all of its values will be in the list, and not just the most
+    recently inserted one.
+
+    \sa keys(), value()
+*/
+
+/*! \fn QList<T> QBTreeMap::values(const Key &key) const
+
+    \overload
+
+    Returns a list containing all the values associated with key
+    \a key, from the most recently inserted to the least recently
+    inserted one.
+
+    \sa count(), insertMulti()
+*/
+
+/*! \fn int QBTreeMap::count(const Key &key) const
+
+    Returns the number of items associated with key \a key.
+
+    \sa contains(), insertMulti()
+*/
+
+/*! \fn int QBTreeMap::count() const
+
+    \overload
+
+    Same as size().
+*/
+
+/*! \fn QBTreeMap::iterator QBTreeMap::begin()
+
+    Returns an \l{STL-style iterator} pointing to the first item in
+    the map.
+
+    \sa constBegin(), end()
+*/
+
+/*! \fn QBTreeMap::const_iterator QBTreeMap::begin() const
+
+    \overload
+*/
+
+/*! \fn QBTreeMap::const_iterator QBTreeMap::constBegin() const
+
+    Returns a const \l{STL-style iterator} pointing to the first item
+    in the map.
+
+    \sa begin(), constEnd()
+*/
+
+/*! \fn QBTreeMap::iterator QBTreeMap::end()
+
+    Returns an \l{STL-style iterator} pointing to the imaginary item
+    after the last item in the map.
+
+    \sa begin(), constEnd()
+*/
+
+/*! \fn QBTreeMap::const_iterator QBTreeMap::end() const
+
+    \overload
+*/
+
+/*! \fn QBTreeMap::const_iterator QBTreeMap::constEnd() const
+
+    Returns a const \l{STL-style iterator} pointing to the imaginary
+    item after the last item in the map.
+
+    \sa constBegin(), end()
+*/
+
+/*! \fn QBTreeMap::iterator QBTreeMap::erase(iterator pos)
+
+    Removes the (key, value) pair pointed to by the iterator \a pos
+    from the map, and returns an iterator to the next item in the
+    map. The returned iterator is the only one that remains valid.
+
+    \sa remove()
+*/
+
+/*! \fn QBTreeMap::iterator QBTreeMap::find(const Key &key)
+
+    Returns an iterator pointing to the item with key \a key in the
+    map.
+
+    If the map contains no item with key \a key, the function
+    returns end().
+
+    If the map contains multiple items with key \a key, this
+    function returns an iterator that points to the most recently
+    inserted value. The other values are accessible by incrementing
+    the iterator.
+
+    \sa constFind(), value(), values(), lowerBound(), upperBound()
+*/
+
+/*! \fn QBTreeMap::const_iterator QBTreeMap::find(const Key &key) const
+
+    \overload
+*/
+
+/*! \fn QBTreeMap::const_iterator QBTreeMap::constFind(const Key &key) const
+
+    Returns an const iterator pointing to the item with key \a key in
+    the map.
+
+    If the map contains no item with key \a key, the function
+    returns constEnd().
+
+    \sa find()
+*/
+
+/*! \fn QBTreeMap::iterator QBTreeMap::lowerBound(const Key &key)
+
+    Returns an iterator pointing to the first item with key \a key in
+    the map. If the map contains no item with key \a key, the
+    function returns an iterator to the nearest item with a greater
+    key.
+
+    \sa upperBound(), find()
+*/
+
+/*! \fn QBTreeMap::const_iterator QBTreeMap::lowerBound(const Key &key) const
+
+    \overload
+*/
+
+/*! \fn QBTreeMap::iterator QBTreeMap::upperBound(const Key &key)
+
+    Returns an iterator pointing to the item that immediately follows
+    the last item with key \a key in the map. If the map contains no
+    item with key \a key, the function returns an iterator to the
+    nearest item with a greater key.
+
+    \sa lowerBound(), find()
+*/
+
+/*! \fn QBTreeMap::const_iterator QBTreeMap::upperBound(const Key &key) const
+
+    \overload
+*/
+
+/*! \fn QBTreeMap::iterator QBTreeMap::insert(const Key &key, const T &value)
+
+    Inserts a new item with the key \a key and a value of \a value.
+
+    If there is already an item with the key \a key, that item's
+    value is replaced with \a value.
+
+    If there are multiple items with the key \a key, the most
+    recently inserted item's value is replaced with \a value.
+
+    Inserting keys in ascending order is especially fast.
+
+    \sa insertMulti()
+*/
+
+/*! \fn QBTreeMap::iterator QBTreeMap::insertMulti(const Key &key, const T &value)
+
+    Inserts a new item with the key \a key and a value of \a value.
+
+    If there is already an item with the same key in the map, this
+    function will simply create a new one. (This behavior is
+    different from insert(), which overwrites the value of an
+    existing item.)
+
+    \sa insert(), values()
+*/
+
+/*! \fn QBTreeMap<Key, T> &QBTreeMap::unite(const QBTreeMap<Key, T> &other)
+
+    Inserts all the items in the \a other map into this map. If a
+    key is common to both maps, the resulting map will contain the
+    key multiple times.
+
+    \sa insertMulti()
+*/
+
+/*! \fn bool QBTreeMap::empty() const
+
+    This function is provided for STL compatibility. It is equivalent
+    to isEmpty(), returning true if the map is empty; otherwise
+    returns false.
+*/
+
+/*! \typedef QBTreeMap::ConstIterator
+
+    Qt-style synonym for QBTreeMap::const_iterator.
+*/
+
+/*! \typedef QBTreeMap::Iterator
+
+    Qt-style synonym for QBTreeMap::iterator.
+*/
+
+/*! \typedef QBTreeMap::difference_type
+
+    Typedef for ptrdiff_t. Provided for STL compatibility.
+*/
+
+/*! \typedef QBTreeMap::key_type
+
+    Typedef for Key. Provided for STL compatibility.
+*/
+
+/*! \typedef QBTreeMap::mapped_type
+
+    Typedef for T. Provided for STL compatibility.
+*/
+
+/*! \typedef QBTreeMap::size_type
+
+    Typedef for int. Provided for STL compatibility.
+*/
+
+/*! \class QBTreeMap::iterator
+    \brief The QBTreeMap::iterator class provides an STL-style non-const iterator for QBTreeMap.
+
+    QBTreeMap\<Key, T\>::iterator allows you to iterate over a
+    QBTreeMap and to modify the value (but not the key) stored under
+    a particular key. It behaves like QMap::iterator, except that
+    insertions and removals invalidate it.
+
+    \sa QBTreeMap::const_iterator, QMutableBTreeMapIterator
+*/
+
+/*! \fn QBTreeMap::iterator::iterator()
+
+    Constructs an uninitialized iterator.
+*/
+
+/*! \fn QBTreeMap::iterator::iterator(Leaf *leaf, int index)
+
+    \internal
+*/
+
+/*! \fn const Key &QBTreeMap::iterator::key() const
+
+    Returns the current item's key as a const reference.
+
+    \sa value()
+*/
+
+/*! \fn T &QBTreeMap::iterator::value() const
+
+    Returns a modifiable reference to the current item's value.
+
+    \sa key(), operator*()
+*/
+
+/*! \fn T &QBTreeMap::iterator::operator*() const
+
+    Returns a modifiable reference to the current item's value.
+
+    Same as value().
+*/
+
+/*! \fn T *QBTreeMap::iterator::operator->() const
+
+    Returns a pointer to the current item's value.
+*/
+
+/*!
+    \fn bool QBTreeMap::iterator::operator==(const iterator &other) const
+    \fn bool QBTreeMap::iterator::operator==(const const_iterator &other) const
+
+    Returns true if \a other points to the same item as this
+    iterator; otherwise returns false.
+*/
+
+/*!
+    \fn bool QBTreeMap::iterator::operator!=(const iterator &other) const
+    \fn bool QBTreeMap::iterator::operator!=(const const_iterator &other) const
+
+    Returns true if \a other points to a different item than this
+    iterator; otherwise returns false.
+*/
+
+/*! \fn QBTreeMap::iterator &QBTreeMap::iterator::operator++()
+
+    The prefix ++ operator (\c{++i}) advances the iterator to the
+    next item in the map and returns an iterator to the new current
+    item.
+*/
+
+/*! \fn QBTreeMap::iterator QBTreeMap::iterator::operator++(int)
+
+    \overload
+
+    The postfix ++ operator (\c{i++}) advances the iterator to the
+    next item in the map and returns an iterator to the previously
+    current item.
+*/
+
+/*! \fn QBTreeMap::iterator &QBTreeMap::iterator::operator--()
+
+    The prefix -- operator (\c{--i}) makes the preceding item
+    current and returns an iterator pointing to the new current item.
+*/
+
+/*! \fn QBTreeMap::iterator QBTreeMap::iterator::operator--(int)
+
+    \overload
+
+    The postfix -- operator (\c{i--}) makes the preceding item
+    current and returns an iterator pointing to the previously
+    current item.
+*/
+
+/*! \fn QBTreeMap::iterator QBTreeMap::iterator::operator+(int j) const
+
+    Returns an iterator to the item at \a j positions forward from
+    this iterator. (If \a j is negative, the iterator goes backward.)
+*/
+
+/*! \fn QBTreeMap::iterator QBTreeMap::iterator::operator-(int j) const
+
+    Returns an iterator to the item at \a j positions backward from
+    this iterator. (If \a j is negative, the iterator goes forward.)
+*/
+
+/*! \fn QBTreeMap::iterator &QBTreeMap::iterator::operator+=(int j)
+
+    Advances the iterator by \a j items. (If \a j is negative, the
+    iterator goes backward.)
+*/
+
+/*! \fn QBTreeMap::iterator &QBTreeMap::iterator::operator-=(int j)
+
+    Makes the iterator go back by \a j items. (If \a j is negative,
+    the iterator goes forward.)
+*/
+
+/*! \class QBTreeMap::const_iterator
+    \brief The QBTreeMap::const_iterator class provides an STL-style const iterator for QBTreeMap.
+
+    QBTreeMap\<Key, T\>::const_iterator allows you to iterate over a
+    QBTreeMap. It behaves like QMap::const_iterator, except that
+    insertions and removals invalidate it.
+
+    \sa QBTreeMap::iterator, QBTreeMapIterator
+*/
+
+/*! \fn QBTreeMap::const_iterator::const_iterator()
+
+    Constructs an uninitialized iterator.
+*/
+
+/*! \fn QBTreeMap::const_iterator::const_iterator(Leaf *leaf, int index)
+
+    \internal
+*/
+
+/*! \fn QBTreeMap::const_iterator::const_iterator(const iterator &other)
+
+    Constructs a copy of \a other.
+*/
+
+/*! \fn const Key &QBTreeMap::const_iterator::key() const
+
+    Returns the current item's key.
+
+    \sa value()
+*/
+
+/*! \fn const T &QBTreeMap::const_iterator::value() const
+
+    Returns the current item's value.
+
+    \sa key(), operator*()
+*/
+
+/*! \fn const T &QBTreeMap::const_iterator::operator*() const
+
+    Returns the current item's value.
+
+    Same as value().
+*/
+
+/*! \fn const T *QBTreeMap::const_iterator::operator->() const
+
+    Returns a pointer to the current item's value.
+*/
+
+/*! \fn bool QBTreeMap::const_iterator::operator==(const const_iterator &other) const
+
+    Returns true if \a other points to the same item as this
+    iterator; otherwise returns false.
+*/
+
+/*! \fn bool QBTreeMap::const_iterator::operator!=(const const_iterator &other) const
+
+    Returns true if \a other points to a different item than this
+    iterator; otherwise returns false.
+*/
+
+/*! \fn QBTreeMap::const_iterator &QBTreeMap::const_iterator::operator++()
+
+    The prefix ++ operator (\c{++i}) advances the iterator to the
+    next item in the map and returns an iterator to the new current
+    item.
+*/
+
+/*! \fn QBTreeMap::const_iterator QBTreeMap::const_iterator::operator++(int)
+
+    \overload
+
+    The postfix ++ operator (\c{i++}) advances the iterator to the
+    next item in the map and returns an iterator to the previously
+    current item.
+*/
+
+/*! \fn QBTreeMap::const_iterator &QBTreeMap::const_iterator::operator--()
+
+    The prefix -- operator (\c{--i}) makes the preceding item
+    current and returns an iterator pointing to the new current item.
+*/
+
+/*! \fn QBTreeMap::const_iterator QBTreeMap::const_iterator::operator--(int)
+
+    \overload
+
+    The postfix -- operator (\c{i--}) makes the preceding item
+    current and returns an iterator pointing to the previously
+    current item.
+*/
+
+/*! \fn QBTreeMap::const_iterator QBTreeMap::const_iterator::operator+(int j) const
+
+    Returns an iterator to the item at \a j positions forward from
+    this iterator. (If \a j is negative, the iterator goes backward.)
+*/
+
+/*! \fn QBTreeMap::const_iterator QBTreeMap::const_iterator::operator-(int j) const
+
+    Returns an iterator to the item at \a j positions backward from
+    this iterator. (If \a j is negative, the iterator goes forward.)
+*/
+
+/*! \fn QBTreeMap::const_iterator &QBTreeMap::const_iterator::operator+=(int j)
+
+    Advances the iterator by \a j items. (If \a j is negative, the
+    iterator goes backward.)
+*/
+
+/*! \fn QBTreeMap::const_iterator &QBTreeMap::const_iterator::operator-=(int j)
+
+    Makes the iterator go back by \a j items. (If \a j is negative,
+    the iterator goes forward.)
+*/
+
+QT_END_NAMESPACE
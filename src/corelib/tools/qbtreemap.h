@@ -0,0 +1,1015 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef QBTREEMAP_H
+#define QBTREEMAP_H
+
+#include <QtCore/qmap.h>
+
+#include <string.h>
+
+QT_BEGIN_HEADER
+
+QT_BEGIN_NAMESPACE
+
+QT_MODULE(Core)
+
+struct Q_CORE_EXPORT QBTreeMapData
+{
+    enum { BranchCapacity = 32 };
+
+    struct Branch;
+    struct Node {
+        Branch *parent;
+        int count;
+    };
+    struct Leaf : Node {
+        Leaf *prev;
+        Leaf *next;
+    };
+    struct Branch : Node {
+        Node *children[BranchCapacity];
+    };
+
+    QBasicAtomicInt ref;
+    int size;
+    int depth;
+    uint sharable : 1;
+    Node *root;
+    Leaf *first;
+    Leaf *last;
+
+    static QBTreeMapData *createData();
+    static int indexInParent(const Node *node);
+    void unlinkLeaf(Leaf *leaf);
+
+    static QBTreeMapData shared_null;
+};
+
+/*
+    Moves n constructed items from src to the raw memory at dst; the two
+    ranges may overlap.
+*/
+template <typename T>
+Q_INLINE_TEMPLATE void qBTreeMapRelocate(T *dst, T *src, int n)
+{
+    if (!QTypeInfo<T>::isStatic) {
+        ::memmove(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(T));
+    } else if (dst < src) {
+        for (int i = 0; i < n; ++i) {
+            new (dst + i) T(src[i]);
+            src[i].~T();
+        }
+    } else {
+        for (int i = n - 1; i >= 0; --i) {
+            new (dst + i) T(src[i]);
+            src[i].~T();
+        }
+    }
+}
+
+template <class Key, class T>
+class QBTreeMap
+{
+    typedef QBTreeMapData::Node Node;
+    typedef QBTreeMapData::Leaf Leaf;
+    typedef QBTreeMapData::Branch Branch;
+
+    enum {
+        // leaves are sized to a few cache lines' worth of items
+        ItemSize = sizeof(Key) + sizeof(T),
+        LeafCapacity = ItemSize * 64 <= 512 ? 64 : (ItemSize * 8 >= 512 ? 8 : 512 / ItemSize),
+        LeafKeysOffset = (sizeof(Leaf) + 15) & ~15,
+        LeafValuesOffset = LeafKeysOffset + ((LeafCapacity * sizeof(Key) + 15) & ~15),
+        LeafSize = LeafValuesOffset + LeafCapacity * sizeof(T),
+        BranchKeysOffset = (sizeof(Branch) + 15) & ~15,
+        BranchSize = BranchKeysOffset + (QBTreeMapData::BranchCapacity - 1) * sizeof(Key)
+    };
+
+    QBTreeMapData *d;
+
+    static inline Key *leafKeys(Leaf *leaf)
+    { return reinterpret_cast<Key *>(reinterpret_cast<char *>(leaf) + LeafKeysOffset); }
+    static inline T *leafValues(Leaf *leaf)
+    { return reinterpret_cast<T *>(reinterpret_cast<char *>(leaf) + LeafValuesOffset); }
+    static inline Key *branchKeys(Branch *branch)
+    { return reinterpret_cast<Key *>(reinterpret_cast<char *>(branch) + BranchKeysOffset); }
+
+public:
+    inline QBTreeMap() : d(&QBTreeMapData::shared_null) { d->ref.ref(); }
+    inline QBTreeMap(const QBTreeMap<Key, T> &other) : d(other.d)
+    { d->ref.ref(); if (!d->sharable) detach(); }
+    inline ~QBTreeMap() { if (!d->ref.deref()) freeData(d); }
+
+    QBTreeMap<Key, T> &operator=(const QBTreeMap<Key, T> &other);
+
+    bool operator==(const QBTreeMap<Key, T> &other) const;
+    inline bool operator!=(const QBTreeMap<Key, T> &other) const { return !(*this == other); }
+
+    inline int size() const { return d->size; }
+
+    inline bool isEmpty() const { return d->size == 0; }
+
+    inline void detach() { if (d->ref != 1) detach_helper(); }
+    inline bool isDetached() const { return d->ref == 1; }
+    inline void setSharable(bool sharable) { if (!sharable) detach(); d->sharable = sharable; }
+
+    void clear();
+
+    int remove(const Key &key);
+    T take(const Key &key);
+
+    bool contains(const Key &key) const;
+    const Key key(const T &value) const;
+    const Key key(const T &value, const Key &defaultKey) const;
+    const T value(const Key &key) const;
+    const T value(const Key &key, const T &defaultValue) const;
+    T &operator[](const Key &key);
+    const T operator[](const Key &key) const;
+
+    QList<Key> uniqueKeys() const;
+    QList<Key> keys() const;
+    QList<Key> keys(const T &value) const;
+    QList<T> values() const;
+    QList<T> values(const Key &key) const;
+    int count(const Key &key) const;
+
+    class const_iterator;
+
+    class iterator
+    {
+        Leaf *l;
+        int i;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef ptrdiff_t difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        inline iterator() : l(0), i(0) { }
+        inline iterator(Leaf *leaf, int index) : l(leaf), i(index) { }
+
+        inline const Key &key() const { return QBTreeMap::leafKeys(l)[i]; }
+        inline T &value() const { return QBTreeMap::leafValues(l)[i]; }
+        inline T &operator*() const { return QBTreeMap::leafValues(l)[i]; }
+        inline T *operator->() const { return &QBTreeMap::leafValues(l)[i]; }
+        inline bool operator==(const iterator &o) const { return i == o.i && l == o.l; }
+        inline bool operator!=(const iterator &o) const { return !(*this == o); }
+
+        inline iterator &operator++() {
+            if (++i == l->count && l->next) {
+                l = l->next;
+                i = 0;
+            }
+            return *this;
+        }
+        inline iterator operator++(int) { iterator r = *this; ++*this; return r; }
+        inline iterator &operator--() {
+            if (i == 0) {
+                l = l->prev;
+                i = l->count;
+            }
+            --i;
+            return *this;
+        }
+        inline iterator operator--(int) { iterator r = *this; --*this; return r; }
+        inline iterator operator+(int j) const
+        { iterator r = *this; if (j > 0) while (j--) ++r; else while (j++) --r; return r; }
+        inline iterator operator-(int j) const { return operator+(-j); }
+        inline iterator &operator+=(int j) { return *this = *this + j; }
+        inline iterator &operator-=(int j) { return *this = *this - j; }
+
+#ifdef QT_STRICT_ITERATORS
+    private:
+#else
+    public:
+#endif
+        inline bool operator==(const const_iterator &o) const
+            { return const_iterator(*this) == o; }
+        inline bool operator!=(const const_iterator &o) const
+            { return const_iterator(*this) != o; }
+
+    private:
+        friend class const_iterator;
+        friend class QBTreeMap<Key, T>;
+    };
+    friend class iterator;
+
+    class const_iterator
+    {
+        Leaf *l;
+        int i;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef ptrdiff_t difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        inline const_iterator() : l(0), i(0) { }
+        inline const_iterator(Leaf *leaf, int index) : l(leaf), i(index) { }
+#ifdef QT_STRICT_ITERATORS
+        explicit inline const_iterator(const iterator &o)
+#else
+        inline const_iterator(const iterator &o)
+#endif
+            : l(o.l), i(o.i) { }
+
+        inline const Key &key() const { return QBTreeMap::leafKeys(l)[i]; }
+        inline const T &value() const { return QBTreeMap::leafValues(l)[i]; }
+        inline const T &operator*() const { return QBTreeMap::leafValues(l)[i]; }
+        inline const T *operator->() const { return &QBTreeMap::leafValues(l)[i]; }
+        inline bool operator==(const const_iterator &o) const { return i == o.i && l == o.l; }
+        inline bool operator!=(const const_iterator &o) const { return !(*this == o); }
+
+        inline const_iterator &operator++() {
+            if (++i == l->count && l->next) {
+                l = l->next;
+                i = 0;
+            }
+            return *this;
+        }
+        inline const_iterator operator++(int) { const_iterator r = *this; ++*this; return r; }
+        inline const_iterator &operator--() {
+            if (i == 0) {
+                l = l->prev;
+                i = l->count;
+            }
+            --i;
+            return *this;
+        }
+        inline const_iterator operator--(int) { const_iterator r = *this; --*this; return r; }
+        inline const_iterator operator+(int j) const
+        { const_iterator r = *this; if (j > 0) while (j--) ++r; else while (j++) --r; return r; }
+        inline const_iterator operator-(int j) const { return operator+(-j); }
+        inline const_iterator &operator+=(int j) { return *this = *this + j; }
+        inline const_iterator &operator-=(int j) { return *this = *this - j; }
+
+#ifdef QT_STRICT_ITERATORS
+    private:
+        inline bool operator==(const iterator &o) const { return operator==(const_iterator(o)); }
+        inline bool operator!=(const iterator &o) const { return operator!=(const_iterator(o)); }
+#endif
+
+    private:
+        friend class QBTreeMap<Key, T>;
+    };
+    friend class const_iterator;
+
+    // STL style
+    inline iterator begin() { detach(); return iterator(d->first, 0); }
+    inline const_iterator begin() const { return const_iterator(d->first, 0); }
+    inline const_iterator constBegin() const { return const_iterator(d->first, 0); }
+    inline iterator end() { detach(); return iterator(d->last, d->last ? d->last->count : 0); }
+    inline const_iterator end() const { return const_iterator(d->last, d->last ? d->last->count : 0); }
+    inline const_iterator constEnd() const { return const_iterator(d->last, d->last ? d->last->count : 0); }
+    iterator erase(iterator it);
+
+    // more Qt
+    typedef iterator Iterator;
+    typedef const_iterator ConstIterator;
+    inline int count() const { return d->size; }
+    iterator find(const Key &key);
+    const_iterator find(const Key &key) const;
+    const_iterator constFind(const Key &key) const;
+    iterator lowerBound(const Key &key);
+    const_iterator lowerBound(const Key &key) const;
+    iterator upperBound(const Key &key);
+    const_iterator upperBound(const Key &key) const;
+    iterator insert(const Key &key, const T &value);
+    iterator insertMulti(const Key &key, const T &value);
+    QBTreeMap<Key, T> &unite(const QBTreeMap<Key, T> &other);
+
+    // STL compatibility
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef ptrdiff_t difference_type;
+    typedef int size_type;
+    inline bool empty() const { return isEmpty(); }
+
+private:
+    void detach_helper();
+    void freeData(QBTreeMapData *x);
+    static void freeNode(Node *node, int height);
+
+    const_iterator findLowerBound(const Key &key) const;
+    const_iterator findUpperBound(const Key &key) const;
+    static inline bool atEnd(const const_iterator &it) { return it.i == it.l->count; }
+    static inline const_iterator normalized(const const_iterator &it)
+    { return (it.l && atEnd(it) && it.l->next) ? const_iterator(it.l->next, 0) : it; }
+
+    iterator append(const Key &key, const T &value);
+    iterator insertAt(Leaf *leaf, int i, const Key &key, const T &value);
+    void insertIntoBranch(Branch *branch, int i, const Key &separator, Node *child);
+    void insertChild(Node *left, const Key &separator, Node *right, bool appending);
+    void removeChild(Branch *branch, int i);
+    void removeLeaf(Leaf *leaf);
+    Leaf *createLeaf();
+};
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QBTreeMap<Key, T>::Leaf *QBTreeMap<Key, T>::createLeaf()
+{
+    Leaf *leaf = static_cast<Leaf *>(qMalloc(LeafSize));
+    Q_CHECK_PTR(leaf);
+    leaf->parent = 0;
+    leaf->count = 0;
+    leaf->prev = 0;
+    leaf->next = 0;
+    return leaf;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QBTreeMap<Key, T>::freeNode(Node *node, int height)
+{
+    if (height == 1) {
+        Leaf *leaf = static_cast<Leaf *>(node);
+        if (QTypeInfo<Key>::isComplex || QTypeInfo<T>::isComplex) {
+            Key *k = leafKeys(leaf);
+            T *v = leafValues(leaf);
+            for (int i = 0; i < leaf->count; ++i) {
+                k[i].~Key();
+                v[i].~T();
+            }
+        }
+    } else {
+        Branch *branch = static_cast<Branch *>(node);
+        Key *k = branchKeys(branch);
+        for (int i = 0; i < branch->count; ++i) {
+            freeNode(branch->children[i], height - 1);
+            if (QTypeInfo<Key>::isComplex && i > 0)
+                k[i - 1].~Key();
+        }
+    }
+    qFree(node);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QBTreeMap<Key, T>::freeData(QBTreeMapData *x)
+{
+    if (x->root)
+        freeNode(x->root, x->depth);
+    delete x;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE void QBTreeMap<Key, T>::clear()
+{
+    *this = QBTreeMap<Key, T>();
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE QBTreeMap<Key, T> &QBTreeMap<Key, T>::operator=(const QBTreeMap<Key, T> &other)
+{
+    if (d != other.d) {
+        other.d->ref.ref();
+        if (!d->ref.deref())
+            freeData(d);
+        d = other.d;
+        if (!d->sharable)
+            detach_helper();
+    }
+    return *this;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QBTreeMap<Key, T>::detach_helper()
+{
+    // appending the items in order packs the copy's leaves completely
+    QBTreeMapData *x = d;
+    d = QBTreeMapData::createData();
+    for (Leaf *leaf = x->first; leaf; leaf = leaf->next) {
+        Key *k = leafKeys(leaf);
+        T *v = leafValues(leaf);
+        for (int i = 0; i < leaf->count; ++i)
+            append(k[i], v[i]);
+    }
+    d->sharable = true;
+    if (!x->ref.deref())
+        freeData(x);
+}
+
+/*
+    Descends to the position in a leaf where key would be inserted before
+    any equal keys. Separator i of a branch is not less than any key in
+    child i and not greater than any key in child i + 1, so equal keys may
+    straddle two leaves, and the position may be one past the end of its
+    leaf; normalized() turns it into a valid iterator.
+*/
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QBTreeMap<Key, T>::const_iterator
+QBTreeMap<Key, T>::findLowerBound(const Key &akey) const
+{
+    Node *node = d->root;
+    if (!node)
+        return const_iterator(0, 0);
+    for (int h = d->depth; h > 1; --h) {
+        Branch *branch = static_cast<Branch *>(node);
+        Key *k = branchKeys(branch);
+        int lo = 0;
+        int hi = branch->count - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) >> 1;
+            if (qMapLessThanKey<Key>(k[mid], akey))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        node = branch->children[lo];
+    }
+
+    Leaf *leaf = static_cast<Leaf *>(node);
+    Key *k = leafKeys(leaf);
+    int lo = 0;
+    int hi = leaf->count;
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (qMapLessThanKey<Key>(k[mid], akey))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return const_iterator(leaf, lo);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QBTreeMap<Key, T>::const_iterator
+QBTreeMap<Key, T>::findUpperBound(const Key &akey) const
+{
+    Node *node = d->root;
+    if (!node)
+        return const_iterator(0, 0);
+    for (int h = d->depth; h > 1; --h) {
+        Branch *branch = static_cast<Branch *>(node);
+        Key *k = branchKeys(branch);
+        int lo = 0;
+        int hi = branch->count - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) >> 1;
+            if (qMapLessThanKey<Key>(akey, k[mid]))
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        node = branch->children[lo];
+    }
+
+    Leaf *leaf = static_cast<Leaf *>(node);
+    Key *k = leafKeys(leaf);
+    int lo = 0;
+    int hi = leaf->count;
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (qMapLessThanKey<Key>(akey, k[mid]))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    if (lo == leaf->count && leaf->next)
+        return const_iterator(leaf->next, 0);
+    return const_iterator(leaf, lo);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QBTreeMap<Key, T>::insertIntoBranch(Branch *branch, int i,
+                                                              const Key &separator, Node *child)
+{
+    // child becomes children[i + 1], with separator in front of it
+    Q_ASSERT(branch->count < QBTreeMapData::BranchCapacity);
+    Key *k = branchKeys(branch);
+    qBTreeMapRelocate(k + i + 1, k + i, branch->count - 1 - i);
+    new (k + i) Key(separator);
+    ::memmove(branch->children + i + 2, branch->children + i + 1,
+              (branch->count - 1 - i) * sizeof(Node *));
+    branch->children[i + 1] = child;
+    child->parent = branch;
+    ++branch->count;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QBTreeMap<Key, T>::insertChild(Node *left, const Key &separator,
+                                                         Node *right, bool appending)
+{
+    Branch *branch = left->parent;
+    if (!branch) {
+        branch = static_cast<Branch *>(qMalloc(BranchSize));
+        Q_CHECK_PTR(branch);
+        branch->parent = 0;
+        branch->count = 2;
+        branch->children[0] = left;
+        branch->children[1] = right;
+        new (branchKeys(branch)) Key(separator);
+        left->parent = right->parent = branch;
+        d->root = branch;
+        ++d->depth;
+        return;
+    }
+
+    int i = QBTreeMapData::indexInParent(left);
+    if (branch->count < QBTreeMapData::BranchCapacity) {
+        insertIntoBranch(branch, i, separator, right);
+        return;
+    }
+
+    Branch *sibling = static_cast<Branch *>(qMalloc(BranchSize));
+    Q_CHECK_PTR(sibling);
+    sibling->parent = 0;
+    if (appending) {
+        // sorted insertion: leave this branch full
+        sibling->count = 1;
+        sibling->children[0] = right;
+        right->parent = sibling;
+        insertChild(branch, separator, sibling, true);
+        return;
+    }
+
+    const int m = QBTreeMapData::BranchCapacity / 2;
+    const int moved = QBTreeMapData::BranchCapacity - m;
+    Key *k = branchKeys(branch);
+    Key up(k[m - 1]);
+    k[m - 1].~Key();
+    qBTreeMapRelocate(branchKeys(sibling), k + m, moved - 1);
+    ::memcpy(sibling->children, branch->children + m, moved * sizeof(Node *));
+    for (int j = 0; j < moved; ++j)
+        sibling->children[j]->parent = sibling;
+    sibling->count = moved;
+    branch->count = m;
+
+    if (i < m)
+        insertIntoBranch(branch, i, separator, right);
+    else
+        insertIntoBranch(sibling, i - m, separator, right);
+    insertChild(branch, up, sibling, false);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QBTreeMap<Key, T>::iterator
+QBTreeMap<Key, T>::append(const Key &akey, const T &avalue)
+{
+    Leaf *leaf = d->last;
+    if (!leaf) {
+        leaf = createLeaf();
+        d->root = d->first = d->last = leaf;
+        d->depth = 1;
+    } else if (leaf->count == LeafCapacity) {
+        Leaf *next = createLeaf();
+        next->prev = leaf;
+        leaf->next = next;
+        d->last = next;
+        new (leafKeys(next)) Key(akey);
+        new (leafValues(next)) T(avalue);
+        next->count = 1;
+        ++d->size;
+        insertChild(leaf, akey, next, true);
+        return iterator(next, 0);
+    }
+    int i = leaf->count;
+    new (leafKeys(leaf) + i) Key(akey);
+    new (leafValues(leaf) + i) T(avalue);
+    ++leaf->count;
+    ++d->size;
+    return iterator(leaf, i);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QBTreeMap<Key, T>::iterator
+QBTreeMap<Key, T>::insertAt(Leaf *leaf, int i, const Key &akey, const T &avalue)
+{
+    if (!leaf)
+        return append(akey, avalue);
+
+    ++d->size;
+    if (leaf->count < LeafCapacity) {
+        Key *k = leafKeys(leaf);
+        T *v = leafValues(leaf);
+        qBTreeMapRelocate(k + i + 1, k + i, leaf->count - i);
+        qBTreeMapRelocate(v + i + 1, v + i, leaf->count - i);
+        new (k + i) Key(akey);
+        new (v + i) T(avalue);
+        ++leaf->count;
+        return iterator(leaf, i);
+    }
+
+    Leaf *right = createLeaf();
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next)
+        leaf->next->prev = right;
+    else
+        d->last = right;
+    leaf->next = right;
+
+    const int m = LeafCapacity / 2;
+    qBTreeMapRelocate(leafKeys(right), leafKeys(leaf) + m, LeafCapacity - m);
+    qBTreeMapRelocate(leafValues(right), leafValues(leaf) + m, LeafCapacity - m);
+    right->count = LeafCapacity - m;
+    leaf->count = m;
+
+    Leaf *target = leaf;
+    if (i > m) {
+        target = right;
+        i -= m;
+    }
+    Key *k = leafKeys(target);
+    T *v = leafValues(target);
+    qBTreeMapRelocate(k + i + 1, k + i, target->count - i);
+    qBTreeMapRelocate(v + i + 1, v + i, target->count - i);
+    new (k + i) Key(akey);
+    new (v + i) T(avalue);
+    ++target->count;
+
+    insertChild(leaf, leafKeys(right)[0], right, false);
+    return iterator(target, i);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QBTreeMap<Key, T>::removeChild(Branch *branch, int i)
+{
+    Key *k = branchKeys(branch);
+    int sep = i > 0 ? i - 1 : 0;
+    if (branch->count > 1) {
+        k[sep].~Key();
+        qBTreeMapRelocate(k + sep, k + sep + 1, branch->count - 2 - sep);
+    }
+    ::memmove(branch->children + i, branch->children + i + 1,
+              (branch->count - 1 - i) * sizeof(Node *));
+    --branch->count;
+
+    if (branch->count == 0) {
+        Branch *parent = branch->parent;
+        Q_ASSERT(parent);
+        int j = QBTreeMapData::indexInParent(branch);
+        qFree(branch);
+        removeChild(parent, j);
+        return;
+    }
+
+    // a root with a single child makes the tree one level shallower
+    while (d->depth > 1 && static_cast<Branch *>(d->root)->count == 1) {
+        Branch *root = static_cast<Branch *>(d->root);
+        d->root = root->children[0];
+        d->root->parent = 0;
+        --d->depth;
+        qFree(root);
+    }
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QBTreeMap<Key, T>::removeLeaf(Leaf *leaf)
+{
+    Q_ASSERT(leaf->count == 0);
+    d->unlinkLeaf(leaf);
+    if (leaf == d->root) {
+        d->root = 0;
+        d->depth = 0;
+    } else {
+        removeChild(leaf->parent, QBTreeMapData::indexInParent(leaf));
+    }
+    qFree(leaf);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QBTreeMap<Key, T>::iterator QBTreeMap<Key, T>::erase(iterator it)
+{
+    Leaf *leaf = it.l;
+    int i = it.i;
+    if (!leaf || i == leaf->count)
+        return it;
+
+    Key *k = leafKeys(leaf);
+    T *v = leafValues(leaf);
+    k[i].~Key();
+    v[i].~T();
+    qBTreeMapRelocate(k + i, k + i + 1, leaf->count - 1 - i);
+    qBTreeMapRelocate(v + i, v + i + 1, leaf->count - 1 - i);
+    --leaf->count;
+    --d->size;
+
+    if (leaf->count == 0) {
+        Leaf *next = leaf->next;
+        removeLeaf(leaf);
+        if (next)
+            return iterator(next, 0);
+        return iterator(d->last, d->last ? d->last->count : 0);
+    }
+
+    // a sparse leaf absorbs its sibling if both fit in half a leaf
+    Leaf *next = leaf->next;
+    if (next && next->parent == leaf->parent && leaf->count + next->count <= LeafCapacity / 2) {
+        qBTreeMapRelocate(k + leaf->count, leafKeys(next), next->count);
+        qBTreeMapRelocate(v + leaf->count, leafValues(next), next->count);
+        leaf->count += next->count;
+        next->count = 0;
+        removeLeaf(next);
+    }
+
+    if (i == leaf->count && leaf->next)
+        return iterator(leaf->next, 0);
+    return iterator(leaf, i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QBTreeMap<Key, T>::value(const Key &akey) const
+{
+    const_iterator it = constFind(akey);
+    return it == constEnd() ? T() : it.value();
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QBTreeMap<Key, T>::value(const Key &akey, const T &adefaultValue) const
+{
+    const_iterator it = constFind(akey);
+    return it == constEnd() ? adefaultValue : it.value();
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QBTreeMap<Key, T>::operator[](const Key &akey) const
+{
+    return value(akey);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE T &QBTreeMap<Key, T>::operator[](const Key &akey)
+{
+    detach();
+    const_iterator pos = findLowerBound(akey);
+    const_iterator it = normalized(pos);
+    if (!it.l || atEnd(it) || qMapLessThanKey<Key>(akey, it.key()))
+        return insertAt(pos.l, pos.i, akey, T()).value();
+    return leafValues(it.l)[it.i];
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE int QBTreeMap<Key, T>::count(const Key &akey) const
+{
+    int cnt = 0;
+    const_iterator it = normalized(findLowerBound(akey));
+    const_iterator e = constEnd();
+    while (it != e && !qMapLessThanKey<Key>(akey, it.key())) {
+        ++cnt;
+        ++it;
+    }
+    return cnt;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE bool QBTreeMap<Key, T>::contains(const Key &akey) const
+{
+    return constFind(akey) != constEnd();
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QBTreeMap<Key, T>::iterator
+QBTreeMap<Key, T>::insert(const Key &akey, const T &avalue)
+{
+    detach();
+    if (!d->last || qMapLessThanKey<Key>(leafKeys(d->last)[d->last->count - 1], akey))
+        return append(akey, avalue);
+
+    const_iterator pos = findLowerBound(akey);
+    const_iterator it = normalized(pos);
+    if (atEnd(it) || qMapLessThanKey<Key>(akey, it.key()))
+        return insertAt(pos.l, pos.i, akey, avalue);
+    leafValues(it.l)[it.i] = avalue;
+    return iterator(it.l, it.i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QBTreeMap<Key, T>::iterator
+QBTreeMap<Key, T>::insertMulti(const Key &akey, const T &avalue)
+{
+    detach();
+    if (!d->last || qMapLessThanKey<Key>(leafKeys(d->last)[d->last->count - 1], akey))
+        return append(akey, avalue);
+
+    const_iterator it = findLowerBound(akey);
+    return insertAt(it.l, it.i, akey, avalue);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE QBTreeMap<Key, T> &QBTreeMap<Key, T>::unite(const QBTreeMap<Key, T> &other)
+{
+    QBTreeMap<Key, T> copy(other);
+    const_iterator it = copy.constEnd();
+    const const_iterator b = copy.constBegin();
+    while (it != b) {
+        --it;
+        insertMulti(it.key(), it.value());
+    }
+    return *this;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QBTreeMap<Key, T>::const_iterator
+QBTreeMap<Key, T>::constFind(const Key &akey) const
+{
+    const_iterator it = normalized(findLowerBound(akey));
+    if (!it.l || atEnd(it) || qMapLessThanKey<Key>(akey, it.key()))
+        return constEnd();
+    return it;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QBTreeMap<Key, T>::const_iterator
+QBTreeMap<Key, T>::find(const Key &akey) const
+{
+    return constFind(akey);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QBTreeMap<Key, T>::iterator QBTreeMap<Key, T>::find(const Key &akey)
+{
+    detach();
+    const_iterator it = constFind(akey);
+    return iterator(it.l, it.i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QBTreeMap<Key, T>::const_iterator
+QBTreeMap<Key, T>::lowerBound(const Key &akey) const
+{
+    return normalized(findLowerBound(akey));
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QBTreeMap<Key, T>::iterator
+QBTreeMap<Key, T>::lowerBound(const Key &akey)
+{
+    detach();
+    const_iterator it = normalized(findLowerBound(akey));
+    return iterator(it.l, it.i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QBTreeMap<Key, T>::const_iterator
+QBTreeMap<Key, T>::upperBound(const Key &akey) const
+{
+    return findUpperBound(akey);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QBTreeMap<Key, T>::iterator
+QBTreeMap<Key, T>::upperBound(const Key &akey)
+{
+    detach();
+    const_iterator it = findUpperBound(akey);
+    return iterator(it.l, it.i);
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QBTreeMap<Key, T>::remove(const Key &akey)
+{
+    detach();
+
+    int n = 0;
+    const_iterator c = normalized(findLowerBound(akey));
+    iterator it(c.l, c.i);
+    while (it != end() && !qMapLessThanKey<Key>(akey, it.key())) {
+        it = erase(it);
+        ++n;
+    }
+    return n;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE T QBTreeMap<Key, T>::take(const Key &akey)
+{
+    detach();
+
+    iterator it = find(akey);
+    if (it == end())
+        return T();
+    T t = it.value();
+    erase(it);
+    return t;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<Key> QBTreeMap<Key, T>::uniqueKeys() const
+{
+    QList<Key> res;
+    const_iterator i = begin();
+    if (i != end()) {
+        for (;;) {
+            const Key &aKey = i.key();
+            res.append(aKey);
+            do {
+                if (++i == end())
+                    goto break_out_of_outer_loop;
+            } while (!(aKey < i.key()));   // loop while (key == i.key())
+        }
+    }
+break_out_of_outer_loop:
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<Key> QBTreeMap<Key, T>::keys() const
+{
+    QList<Key> res;
+    for (Leaf *leaf = d->first; leaf; leaf = leaf->next) {
+        Key *k = leafKeys(leaf);
+        for (int i = 0; i < leaf->count; ++i)
+            res.append(k[i]);
+    }
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<Key> QBTreeMap<Key, T>::keys(const T &avalue) const
+{
+    QList<Key> res;
+    const_iterator i = begin();
+    while (i != end()) {
+        if (i.value() == avalue)
+            res.append(i.key());
+        ++i;
+    }
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE const Key QBTreeMap<Key, T>::key(const T &avalue) const
+{
+    return key(avalue, Key());
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE const Key QBTreeMap<Key, T>::key(const T &avalue, const Key &defaultKey) const
+{
+    const_iterator i = begin();
+    while (i != end()) {
+        if (i.value() == avalue)
+            return i.key();
+        ++i;
+    }
+    return defaultKey;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<T> QBTreeMap<Key, T>::values() const
+{
+    QList<T> res;
+    for (Leaf *leaf = d->first; leaf; leaf = leaf->next) {
+        T *v = leafValues(leaf);
+        for (int i = 0; i < leaf->count; ++i)
+            res.append(v[i]);
+    }
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<T> QBTreeMap<Key, T>::values(const Key &akey) const
+{
+    QList<T> res;
+    const_iterator it = constFind(akey);
+    const_iterator e = constEnd();
+    while (it != e && !qMapLessThanKey<Key>(akey, it.key())) {
+        res.append(it.value());
+        ++it;
+    }
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE bool QBTreeMap<Key, T>::operator==(const QBTreeMap<Key, T> &other) const
+{
+    if (size() != other.size())
+        return false;
+    if (d == other.d)
+        return true;
+
+    const_iterator it1 = begin();
+    const_iterator it2 = other.begin();
+
+    while (it1 != end()) {
+        if (!(it1.value() == it2.value()) || qMapLessThanKey(it1.key(), it2.key())
+            || qMapLessThanKey(it2.key(), it1.key()))
+            return false;
+        ++it2;
+        ++it1;
+    }
+    return true;
+}
+
+Q_DECLARE_ASSOCIATIVE_ITERATOR(BTreeMap)
+Q_DECLARE_MUTABLE_ASSOCIATIVE_ITERATOR(BTreeMap)
+
+QT_END_NAMESPACE
+
+QT_END_HEADER
+
+#endif // QBTREEMAP_H
@@ -2554,7 +2554,13 @@ QDataStream &operator>>(QDataStream &in, QByteArray &ba)
     if (len == 0xffffffff)
         return in;
 
-    const quint32 Step = 1024 * 1024;
+    // read in one go if the device is known to hold all of the data,
+    // otherwise in steps, so corrupt lengths do not allocate too much
+    quint32 Step = 1024 * 1024;
+    QIODevice *device = in.device();
+    if (device && !device->isSequential() && len < 0x7fffffff
+        && device->bytesAvailable() >= qint64(len))
+        Step = qMax(Step, len);
     quint32 allocated = 0;
 
     do {
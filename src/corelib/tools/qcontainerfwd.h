@@ -22,7 +22,9 @@ QT_BEGIN_NAMESPACE
 
 QT_MODULE(Core)
 
+template <class Key, class T> class QBTreeMap;
 template <class Key, class T> class QCache;
+template <class Key, class T> class QFlatHash;
 template <class Key, class T> class QHash;
 template <class T> class QLinkedList;
 template <class T> class QList;
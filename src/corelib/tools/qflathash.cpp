@@ -0,0 +1,741 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "qflathash.h"
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The table is one block: the QFlatHashData header, padded so that the
+    slots are suitably aligned, then the slots, then one control byte per
+    slot. The first GroupWidth control bytes are mirrored after the last
+    one so that a group can be loaded from any position without wrapping.
+
+    A control byte is Empty, Deleted (a tombstone left by a removal that a
+    probe sequence may have passed over) or holds the low 7 bits of the
+    hash of the item in its slot.
+*/
+
+enum { HeaderSize = (sizeof(QFlatHashData) + 15) & ~15 };
+
+static signed char qt_flathash_empty_group[QFlatHashData::GroupWidth] = {
+    -128, -128, -128, -128, -128, -128, -128, -128,
+    -128, -128, -128, -128, -128, -128, -128, -128
+};
+
+QFlatHashData QFlatHashData::shared_null = {
+    Q_BASIC_ATOMIC_INITIALIZER(1), 0, 0, 0, true, qt_flathash_empty_group, 0
+};
+
+QFlatHashData *QFlatHashData::allocate(int capacity, int slotSize)
+{
+    Q_ASSERT(capacity == 0 || (capacity >= GroupWidth && !(capacity & (capacity - 1))));
+
+    char *block = static_cast<char *>(qMalloc(HeaderSize + capacity * slotSize
+                                              + capacity + GroupWidth));
+    Q_CHECK_PTR(block);
+    QFlatHashData *d = reinterpret_cast<QFlatHashData *>(block);
+    d->ref = 1;
+    d->size = 0;
+    d->capacity = capacity;
+    d->growthLeft = d->maximumLoad();
+    d->sharable = true;
+    d->nodes = block + HeaderSize;
+    d->ctrl = reinterpret_cast<signed char *>(d->nodes + capacity * slotSize);
+    qMemSet(d->ctrl, Empty, capacity + GroupWidth);
+    return d;
+}
+
+int QFlatHashData::capacityForSize(int size)
+{
+    if (size <= 0)
+        return 0;
+    int capacity = GroupWidth;
+    while (capacity - capacity / 8 < size)
+        capacity <<= 1;
+    return capacity;
+}
+
+void QFlatHashData::destroyAndFree()
+{
+    Q_ASSERT(this != &shared_null);
+    qFree(this);
+}
+
+/*!
+    \class QFlatHash
+    \brief The QFlatHash class is a template class that provides an open-addressing hash-table-based dictionary.
+    \since 4.4
+
+    \ingroup tools
+    \ingroup shared
+    \reentrant
+
+    QFlatHash\<Key, T\> stores (key, value) pairs and provides very
+    fast lookup of the value associated with a key. Its API is the
+    same as that of QHash, except that it never stores more than one
+    value per key (there is no insertMulti()).
+
+    Where QHash allocates a node for every item and chains the nodes
+    of a bucket together, QFlatHash stores the items themselves in
+    one flat array and resolves collisions by probing neighboring
+    slots. A separate array of one byte per slot holds 7 bits of each
+    item's hash value, so that a lookup can reject most candidate
+    slots without touching them; on processors with SSE2, sixteen of
+    these bytes are compared at once. The result is fewer cache
+    misses per lookup, no per-item allocation overhead and faster
+    iteration, which matters most for large tables of small items.
+
+    The trade-offs compared to QHash are:
+
+    \list
+    \i Inserting an item may move the other items in memory when the
+       table is rehashed, so references and pointers to values, as
+       well as iterators, are only valid until the next insertion.
+    \i Items are copied on rehash, so Key and T should be cheap to
+       copy.
+    \endlist
+
+    Like QHash, the key type must provide operator==() and a global
+    \l{qHash()}{qHash}(Key) function. Since QFlatHash relies on all
+    bits of the hash value, it scrambles the result of qHash() before
+    using it; a qHash() that merely returns an integer key is fine.
+
+    QFlatHash is \l{implicitly shared}, and provides both
+    \l{STL-style iterators} (QFlatHash::const_iterator and
+    QFlatHash::iterator) and \l{Java-style iterators}
+    (QFlatHashIterator and QMutableFlatHashIterator). The items are
+    arbitrarily ordered.
+
+    \sa QHash, QFlatHashIterator, QMutableFlatHashIterator
+*/
+
+/*! \fn QFlatHash::QFlatHash()
+
+    Constructs an empty hash.
+
+    \sa clear()
+*/
+
+/*! \fn QFlatHash::QFlatHash(const QFlatHash<Key, T> &other)
+
+    Constructs a copy of \a other.
+
+    This operation occurs in \l{constant time}, because QFlatHash is
+    \l{implicitly shared}.
+
+    \sa operator=()
+*/
+
+/*! \fn QFlatHash::~QFlatHash()
+
+    Destroys the hash. References to the values in the hash and all
+    iterators of this hash become invalid.
+*/
+
+/*! \fn QFlatHash<Key, T> &QFlatHash::operator=(const QFlatHash<Key, T> &other)
+
+    Assigns \a other to this hash and returns a reference to this hash.
+*/
+
+/*! \fn bool QFlatHash::operator==(const QFlatHash<Key, T> &other) const
+
+    Returns true if \a other is equal to this hash; otherwise returns
+    false.
+
+    Two hashes are considered equal if they contain the same (key,
+    value) pairs. This function requires the value type to implement
+    \c operator==().
+
+    \sa operator!=()
+*/
+
+/*! \fn bool QFlatHash::operator!=(const QFlatHash<Key, T> &other) const
+
+    Returns true if \a other is not equal to this hash; otherwise
+    returns false.
+
+    \sa operator==()
+*/
+
+/*! \fn int QFlatHash::size() const
+
+    Returns the number of items in the hash.
+
+    \sa isEmpty(), count()
+*/
+
+/*! \fn bool QFlatHash::isEmpty() const
+
+    Returns true if the hash contains no items; otherwise returns
+    false.
+
+    \sa size()
+*/
+
+/*! \fn int QFlatHash::capacity() const
+
+    Returns the number of items the hash can hold before it has to
+    grow its table.
+
+    \sa reserve(), squeeze()
+*/
+
+/*! \fn void QFlatHash::reserve(int size)
+
+    Ensures that the hash can hold at least \a size items without
+    growing its table. Building a large hash after a call to
+    reserve() avoids the repeated rehashing, and copying of items,
+    that growing incrementally entails.
+
+    \sa squeeze(), capacity()
+*/
+
+/*! \fn void QFlatHash::squeeze()
+
+    Shrinks the table to the smallest size that holds the current
+    items, and drops the markers left behind by removed items.
+
+    \sa reserve(), capacity()
+*/
+
+/*! \fn void QFlatHash::detach()
+
+    \internal
+*/
+
+/*! \fn bool QFlatHash::isDetached() const
+
+    \internal
+*/
+
+/*! \fn void QFlatHash::setSharable(bool sharable)
+
+    \internal
+*/
+
+/*! \fn void QFlatHash::clear()
+
+    Removes all items from the hash.
+
+    \sa remove()
+*/
+
+/*! \fn int QFlatHash::remove(const Key &key)
+
+    Removes the item that has the key \a key from the hash. Returns
+    1 if an item was removed, 0 if the key isn't in the hash.
+
+    \sa clear(), take()
+*/
+
+/*! \fn T QFlatHash::take(const Key &key)
+
+    Removes the item with the key \a key from the hash and returns
+    the value associated with it.
+
+    If the item does not exist in the hash, the function simply
+    returns a \l{default-constructed value}.
+
+    \sa remove()
+*/
+
+/*! \fn bool QFlatHash::contains(const Key &key) const
+
+    Returns true if the hash contains an item with the key \a key;
+    otherwise returns false.
+
+    \sa count()
+*/
+
+/*! \fn const T QFlatHash::value(const Key &key) const
+
+    Returns the value associated with the \a key.
+
+    If the hash contains no item with the \a key, the function
+    returns a \l{default-constructed value}.
+
+    \sa key(), values(), contains(), operator[]()
+*/
+
+/*! \fn const T QFlatHash::value(const Key &key, const T &defaultValue) const
+    \overload
+
+    If the hash contains no item with the given \a key, the function
+    returns \a defaultValue.
+*/
+
+/*! \fn T &QFlatHash::operator[](const Key &key)
+
+    Returns the value associated with the \a key as a modifiable
+    reference.
+
+    If the hash contains no item with the \a key, the function
+    inserts a \l{default-constructed value} into the hash with the \a
+    key, and returns a reference to it. The reference is valid until
+    the next insertion into the hash.
+
+    \sa insert(), value()
+*/
+
+/*! \fn const T QFlatHash::operator[](const Key &key) const
+
+    \overload
+
+    Same as value().
+*/
+
+/*! \fn QList<Key> QFlatHash::keys() const
+
+    Returns a list containing all the keys in the hash, in an
+    arbitrary order.
+
+    The order is guaranteed to be the same as that used by values().
+
+    \sa values(), key()
+*/
+
+/*! \fn QList<Key> QFlatHash::keys(const T &value) const
+
+    \overload
+
+    Returns a list containing all the keys associated with value \a
+    value, in an arbitrary order.
+
+    This function can be slow (\l{linear time}), because QFlatHash's
+    internal data structure is optimized for fast lookup by key, not
+    by value.
+*/
+
+/*! \fn QList<T> QFlatHash::values() const
+
+    Returns a list containing all the values in the hash, in an
+    arbitrary order.
+
+    The order is guaranteed to be the same as that used by keys().
+
+    \sa keys(), value()
+*/
+
+/*! \fn const Key QFlatHash::key(const T &value) const
+
+    Returns the first key mapped to \a value.
+
+    If the hash contains no item with the \a value, the function
+    returns a \link {default-constructed value} default-constructed
+    key \endlink.
+
+    This function can be slow (\l{linear time}), because QFlatHash's
+    internal data structure is optimized for fast lookup by key, not
+    by value.
+
+    \sa value(), keys()
+*/
+
+/*! \fn const Key QFlatHash::key(const T &value, const Key &defaultKey) const
+    \overload
+
+    Returns the first key mapped to \a value, or \a defaultKey if the
+    hash contains no item mapped to \a value.
+*/
+
+/*! \fn int QFlatHash::count(const Key &key) const
+
+    Returns 1 if the hash contains an item with the key \a key, 0
+    otherwise.
+
+    \sa contains()
+*/
+
+/*! \fn int QFlatHash::count() const
+
+    \overload
+
+    Same as size().
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::begin()
+
+    Returns an \l{STL-style iterator} pointing to the first item in
+    the hash.
+
+    \sa constBegin(), end()
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::begin() const
+
+    \overload
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::constBegin() const
+
+    Returns a const \l{STL-style iterator} pointing to the first item
+    in the hash.
+
+    \sa begin(), constEnd()
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::end()
+
+    Returns an \l{STL-style iterator} pointing to the imaginary item
+    after the last item in the hash.
+
+    \sa begin(), constEnd()
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::end() const
+
+    \overload
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::constEnd() const
+
+    Returns a const \l{STL-style iterator} pointing to the imaginary
+    item after the last item in the hash.
+
+    \sa constBegin(), end()
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::erase(iterator pos)
+
+    Removes the (key, value) pair associated with the iterator \a pos
+    from the hash, and returns an iterator to the next item in the
+    hash.
+
+    Unlike insertions, removals never move other items, so it is safe
+    to erase items while iterating over the hash.
+
+    \sa remove()
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::find(const Key &key)
+
+    Returns an iterator pointing to the item with the \a key in the
+    hash.
+
+    If the hash contains no item with the \a key, the function
+    returns end().
+
+    \sa value(), contains()
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::find(const Key &key) const
+
+    \overload
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::constFind(const Key &key) const
+
+    Returns an iterator pointing to the item with the \a key in the
+    hash.
+
+    If the hash contains no item with the \a key, the function
+    returns constEnd().
+
+    \sa find()
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::insert(const Key &key, const T &value)
+
+    Inserts a new item with the \a key and a value of \a value.
+
+    If there is already an item with the \a key, that item's value
+    is replaced with \a value.
+
+    \sa operator[]()
+*/
+
+/*! \fn QFlatHash<Key, T> &QFlatHash::unite(const QFlatHash<Key, T> &other)
+
+    Inserts all the items in the \a other hash into this hash,
+    replacing the values of keys that are in both hashes.
+*/
+
+/*! \fn bool QFlatHash::empty() const
+
+    This function is provided for STL compatibility. It is equivalent
+    to isEmpty(), returning true if the hash is empty; otherwise
+    returns false.
+*/
+
+/*! \typedef QFlatHash::ConstIterator
+
+    Qt-style synonym for QFlatHash::const_iterator.
+*/
+
+/*! \typedef QFlatHash::Iterator
+
+    Qt-style synonym for QFlatHash::iterator.
+*/
+
+/*! \typedef QFlatHash::difference_type
+
+    Typedef for ptrdiff_t. Provided for STL compatibility.
+*/
+
+/*! \typedef QFlatHash::key_type
+
+    Typedef for Key. Provided for STL compatibility.
+*/
+
+/*! \typedef QFlatHash::mapped_type
+
+    Typedef for T. Provided for STL compatibility.
+*/
+
+/*! \typedef QFlatHash::size_type
+
+    Typedef for int. Provided for STL compatibility.
+*/
+
+/*! \class QFlatHash::iterator
+    \brief The QFlatHash::iterator class provides an STL-style non-const iterator for QFlatHash.
+
+    QFlatHash\<Key, T\>::iterator allows you to iterate over a
+    QFlatHash and to modify the value (but not the key) associated
+    with a particular key. It behaves like QHash::iterator, except
+    that any insertion into the hash invalidates it.
+
+    \sa QFlatHash::const_iterator, QMutableFlatHashIterator
+*/
+
+/*! \fn QFlatHash::iterator::iterator()
+
+    Constructs an uninitialized iterator.
+*/
+
+/*! \fn QFlatHash::iterator::iterator(QFlatHashData *data, int index)
+
+    \internal
+*/
+
+/*! \fn const Key &QFlatHash::iterator::key() const
+
+    Returns the current item's key as a const reference.
+
+    \sa value()
+*/
+
+/*! \fn T &QFlatHash::iterator::value() const
+
+    Returns a modifiable reference to the current item's value.
+
+    \sa key(), operator*()
+*/
+
+/*! \fn T &QFlatHash::iterator::operator*() const
+
+    Returns a modifiable reference to the current item's value.
+
+    Same as value().
+*/
+
+/*! \fn T *QFlatHash::iterator::operator->() const
+
+    Returns a pointer to the current item's value.
+*/
+
+/*!
+    \fn bool QFlatHash::iterator::operator==(const iterator &other) const
+    \fn bool QFlatHash::iterator::operator==(const const_iterator &other) const
+
+    Returns true if \a other points to the same item as this
+    iterator; otherwise returns false.
+*/
+
+/*!
+    \fn bool QFlatHash::iterator::operator!=(const iterator &other) const
+    \fn bool QFlatHash::iterator::operator!=(const const_iterator &other) const
+
+    Returns true if \a other points to a different item than this
+    iterator; otherwise returns false.
+*/
+
+/*!
+    \fn QFlatHash::iterator &QFlatHash::iterator::operator++()
+
+    The prefix ++ operator (\c{++i}) advances the iterator to the
+    next item in the hash and returns an iterator to the new current
+    item.
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::iterator::operator++(int)
+
+    \overload
+
+    The postfix ++ operator (\c{i++}) advances the iterator to the
+    next item in the hash and returns an iterator to the previously
+    current item.
+*/
+
+/*!
+    \fn QFlatHash::iterator &QFlatHash::iterator::operator--()
+
+    The prefix -- operator (\c{--i}) makes the preceding item
+    current and returns an iterator pointing to the new current item.
+*/
+
+/*!
+    \fn QFlatHash::iterator QFlatHash::iterator::operator--(int)
+
+    \overload
+
+    The postfix -- operator (\c{i--}) makes the preceding item
+    current and returns an iterator pointing to the previously
+    current item.
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::iterator::operator+(int j) const
+
+    Returns an iterator to the item at \a j positions forward from
+    this iterator. (If \a j is negative, the iterator goes backward.)
+*/
+
+/*! \fn QFlatHash::iterator QFlatHash::iterator::operator-(int j) const
+
+    Returns an iterator to the item at \a j positions backward from
+    this iterator. (If \a j is negative, the iterator goes forward.)
+*/
+
+/*! \fn QFlatHash::iterator &QFlatHash::iterator::operator+=(int j)
+
+    Advances the iterator by \a j items. (If \a j is negative, the
+    iterator goes backward.)
+*/
+
+/*! \fn QFlatHash::iterator &QFlatHash::iterator::operator-=(int j)
+
+    Makes the iterator go back by \a j items. (If \a j is negative,
+    the iterator goes forward.)
+*/
+
+/*! \class QFlatHash::const_iterator
+    \brief The QFlatHash::const_iterator class provides an STL-style const iterator for QFlatHash.
+
+    QFlatHash\<Key, T\>::const_iterator allows you to iterate over a
+    QFlatHash. It behaves like QHash::const_iterator, except that any
+    insertion into the hash invalidates it.
+
+    \sa QFlatHash::iterator, QFlatHashIterator
+*/
+
+/*! \fn QFlatHash::const_iterator::const_iterator()
+
+    Constructs an uninitialized iterator.
+*/
+
+/*! \fn QFlatHash::const_iterator::const_iterator(const QFlatHashData *data, int index)
+
+    \internal
+*/
+
+/*! \fn QFlatHash::const_iterator::const_iterator(const iterator &other)
+
+    Constructs a copy of \a other.
+*/
+
+/*! \fn const Key &QFlatHash::const_iterator::key() const
+
+    Returns the current item's key.
+
+    \sa value()
+*/
+
+/*! \fn const T &QFlatHash::const_iterator::value() const
+
+    Returns the current item's value.
+
+    \sa key(), operator*()
+*/
+
+/*! \fn const T &QFlatHash::const_iterator::operator*() const
+
+    Returns the current item's value.
+
+    Same as value().
+*/
+
+/*! \fn const T *QFlatHash::const_iterator::operator->() const
+
+    Returns a pointer to the current item's value.
+*/
+
+/*! \fn bool QFlatHash::const_iterator::operator==(const const_iterator &other) const
+
+    Returns true if \a other points to the same item as this
+    iterator; otherwise returns false.
+*/
+
+/*! \fn bool QFlatHash::const_iterator::operator!=(const const_iterator &other) const
+
+    Returns true if \a other points to a different item than this
+    iterator; otherwise returns false.
+*/
+
+/*!
+    \fn QFlatHash::const_iterator &QFlatHash::const_iterator::operator++()
+
+    The prefix ++ operator (\c{++i}) advances the iterator to the
+    next item in the hash and returns an iterator to the new current
+    item.
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::const_iterator::operator++(int)
+
+    \overload
+
+    The postfix ++ operator (\c{i++}) advances the iterator to the
+    next item in the hash and returns an iterator to the previously
+    current item.
+*/
+
+/*! \fn QFlatHash::const_iterator &QFlatHash::const_iterator::operator--()
+
+    The prefix -- operator (\c{--i}) makes the preceding item
+    current and returns an iterator pointing to the new current item.
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::const_iterator::operator--(int)
+
+    \overload
+
+    The postfix -- operator (\c{i--}) makes the preceding item
+    current and returns an iterator pointing to the previously
+    current item.
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::const_iterator::operator+(int j) const
+
+    Returns an iterator to the item at \a j positions forward from
+    this iterator. (If \a j is negative, the iterator goes backward.)
+*/
+
+/*! \fn QFlatHash::const_iterator QFlatHash::const_iterator::operator-(int j) const
+
+    Returns an iterator to the item at \a j positions backward from
+    this iterator. (If \a j is negative, the iterator goes forward.)
+*/
+
+/*! \fn QFlatHash::const_iterator &QFlatHash::const_iterator::operator+=(int j)
+
+    Advances the iterator by \a j items. (If \a j is negative, the
+    iterator goes backward.)
+*/
+
+/*! \fn QFlatHash::const_iterator &QFlatHash::const_iterator::operator-=(int j)
+
+    Makes the iterator go back by \a j items. (If \a j is negative,
+    the iterator goes forward.)
+*/
+
+QT_END_NAMESPACE
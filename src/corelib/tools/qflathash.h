@@ -0,0 +1,748 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef QFLATHASH_H
+#define QFLATHASH_H
+
+#include <QtCore/qhash.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  if !(defined(Q_OS_WIN64) && defined(Q_CC_MSVC) && _MSC_VER < 1400)
+#    define QT_FLATHASH_SSE2
+#    include <emmintrin.h>
+#  endif
+#endif
+
+QT_BEGIN_HEADER
+
+QT_BEGIN_NAMESPACE
+
+QT_MODULE(Core)
+
+struct Q_CORE_EXPORT QFlatHashData
+{
+    enum { GroupWidth = 16 };
+    enum { Empty = -128, Deleted = -2 };
+
+    QBasicAtomicInt ref;
+    int size;
+    int capacity;
+    int growthLeft;
+    uint sharable : 1;
+    signed char *ctrl;
+    char *nodes;
+
+    static QFlatHashData *allocate(int capacity, int slotSize);
+    static int capacityForSize(int size);
+    void destroyAndFree();
+
+    inline int maximumLoad() const { return capacity - capacity / 8; }
+    inline void setControl(int i, signed char c)
+    {
+        ctrl[i] = c;
+        if (i < GroupWidth)
+            ctrl[capacity + i] = c;
+    }
+    inline int nextFull(int i) const;
+    inline int previousFull(int i) const;
+    inline void markErased(int i);
+
+    static QFlatHashData shared_null;
+};
+
+inline uint qFlatHashMix(uint h)
+{
+    // the low bits of qHash() are often all the entropy there is (qHash(int)
+    // is the identity), so spread them over the whole word
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+}
+
+inline int qFlatHashTrailingZeros(uint mask)
+{
+    Q_ASSERT(mask);
+#if defined(Q_CC_GNU)
+    return __builtin_ctz(mask);
+#else
+    int n = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline int qFlatHashLeadingZeros16(uint mask)
+{
+    Q_ASSERT(mask && mask <= 0xffff);
+#if defined(Q_CC_GNU)
+    return __builtin_clz(mask) - 16;
+#else
+    int n = 0;
+    while (!(mask & 0x8000)) {
+        mask <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+class QFlatHashGroup
+{
+public:
+    // a group is the GroupWidth control bytes starting at ctrl; each bit
+    // of a returned mask corresponds to one of them
+    explicit inline QFlatHashGroup(const signed char *ctrl)
+#ifdef QT_FLATHASH_SSE2
+        : c(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl)))
+#else
+        : c(ctrl)
+#endif
+    { }
+
+#ifdef QT_FLATHASH_SSE2
+    inline uint match(signed char h2) const
+    { return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), c)); }
+    inline uint matchEmpty() const
+    { return match(QFlatHashData::Empty); }
+    inline uint matchFull() const
+    { return ~_mm_movemask_epi8(c) & 0xffff; }
+    inline uint matchEmptyOrDeleted() const
+    { return _mm_movemask_epi8(c); }
+
+private:
+    __m128i c;
+#else
+    inline uint match(signed char h2) const
+    {
+        uint mask = 0;
+        for (int i = 0; i < QFlatHashData::GroupWidth; ++i)
+            mask |= uint(c[i] == h2) << i;
+        return mask;
+    }
+    inline uint matchEmpty() const
+    { return match(QFlatHashData::Empty); }
+    inline uint matchFull() const
+    { return ~matchEmptyOrDeleted() & 0xffff; }
+    inline uint matchEmptyOrDeleted() const
+    {
+        uint mask = 0;
+        for (int i = 0; i < QFlatHashData::GroupWidth; ++i)
+            mask |= uint(c[i] < 0) << i;
+        return mask;
+    }
+
+private:
+    const signed char *c;
+#endif
+};
+
+inline int QFlatHashData::nextFull(int i) const
+{
+    while (i < capacity) {
+        uint full = QFlatHashGroup(ctrl + i).matchFull();
+        if (full)
+            return qMin(i + qFlatHashTrailingZeros(full), capacity);
+        i += GroupWidth;
+    }
+    return capacity;
+}
+
+inline int QFlatHashData::previousFull(int i) const
+{
+    while (--i >= 0) {
+        if (ctrl[i] >= 0)
+            return i;
+    }
+    return -1;
+}
+
+inline void QFlatHashData::markErased(int i)
+{
+    // a slot can go back to Empty if no probe sequence can have passed over
+    // it, i.e. if there never were GroupWidth full slots in a row around it
+    int mask = capacity - 1;
+    uint emptyBefore = QFlatHashGroup(ctrl + ((i - GroupWidth) & mask)).matchEmpty();
+    uint emptyAfter = QFlatHashGroup(ctrl + i).matchEmpty();
+    if (emptyBefore && emptyAfter
+        && qFlatHashLeadingZeros16(emptyBefore) + qFlatHashTrailingZeros(emptyAfter) < GroupWidth) {
+        setControl(i, Empty);
+        ++growthLeft;
+    } else {
+        setControl(i, Deleted);
+    }
+    --size;
+}
+
+template <class Key, class T>
+struct QFlatHashNode
+{
+    Key key;
+    T value;
+
+    inline QFlatHashNode(const Key &key0, const T &value0) : key(key0), value(value0) {}
+};
+
+template <class Key, class T>
+class QFlatHash
+{
+    typedef QFlatHashNode<Key, T> Node;
+
+    QFlatHashData *d;
+
+    static inline Node *node(const QFlatHashData *x, int i)
+    { return reinterpret_cast<Node *>(x->nodes) + i; }
+
+public:
+    inline QFlatHash() : d(&QFlatHashData::shared_null) { d->ref.ref(); }
+    inline QFlatHash(const QFlatHash<Key, T> &other) : d(other.d)
+    { d->ref.ref(); if (!d->sharable) detach(); }
+    inline ~QFlatHash() { if (!d->ref.deref()) freeData(d); }
+
+    QFlatHash<Key, T> &operator=(const QFlatHash<Key, T> &other);
+
+    bool operator==(const QFlatHash<Key, T> &other) const;
+    inline bool operator!=(const QFlatHash<Key, T> &other) const { return !(*this == other); }
+
+    inline int size() const { return d->size; }
+
+    inline bool isEmpty() const { return d->size == 0; }
+
+    inline int capacity() const { return d->maximumLoad(); }
+    void reserve(int size);
+    inline void squeeze() { reserve(d->size); }
+
+    inline void detach() { if (d->ref != 1) detach_helper(); }
+    inline bool isDetached() const { return d->ref == 1; }
+    inline void setSharable(bool sharable) { if (!sharable) detach(); d->sharable = sharable; }
+
+    void clear();
+
+    int remove(const Key &key);
+    T take(const Key &key);
+
+    bool contains(const Key &key) const;
+    const Key key(const T &value) const;
+    const Key key(const T &value, const Key &defaultKey) const;
+    const T value(const Key &key) const;
+    const T value(const Key &key, const T &defaultValue) const;
+    T &operator[](const Key &key);
+    const T operator[](const Key &key) const;
+
+    QList<Key> keys() const;
+    QList<Key> keys(const T &value) const;
+    QList<T> values() const;
+    int count(const Key &key) const;
+
+    class const_iterator;
+
+    class iterator
+    {
+        QFlatHashData *d;
+        int i;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef ptrdiff_t difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        inline iterator() : d(0), i(0) { }
+        inline iterator(QFlatHashData *data, int index) : d(data), i(index) { }
+
+        inline const Key &key() const { return node(d, i)->key; }
+        inline T &value() const { return node(d, i)->value; }
+        inline T &operator*() const { return node(d, i)->value; }
+        inline T *operator->() const { return &node(d, i)->value; }
+        inline bool operator==(const iterator &o) const { return i == o.i && d == o.d; }
+        inline bool operator!=(const iterator &o) const { return !(*this == o); }
+
+        inline iterator &operator++() { i = d->nextFull(i + 1); return *this; }
+        inline iterator operator++(int) { iterator r = *this; ++*this; return r; }
+        inline iterator &operator--() { i = d->previousFull(i); return *this; }
+        inline iterator operator--(int) { iterator r = *this; --*this; return r; }
+        inline iterator operator+(int j) const
+        { iterator r = *this; if (j > 0) while (j--) ++r; else while (j++) --r; return r; }
+        inline iterator operator-(int j) const { return operator+(-j); }
+        inline iterator &operator+=(int j) { return *this = *this + j; }
+        inline iterator &operator-=(int j) { return *this = *this - j; }
+
+#ifdef QT_STRICT_ITERATORS
+    private:
+#else
+    public:
+#endif
+        inline bool operator==(const const_iterator &o) const
+            { return const_iterator(*this) == o; }
+        inline bool operator!=(const const_iterator &o) const
+            { return const_iterator(*this) != o; }
+
+    private:
+        friend class const_iterator;
+        friend class QFlatHash<Key, T>;
+    };
+    friend class iterator;
+
+    class const_iterator
+    {
+        const QFlatHashData *d;
+        int i;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef ptrdiff_t difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        inline const_iterator() : d(0), i(0) { }
+        inline const_iterator(const QFlatHashData *data, int index) : d(data), i(index) { }
+#ifdef QT_STRICT_ITERATORS
+        explicit inline const_iterator(const iterator &o)
+#else
+        inline const_iterator(const iterator &o)
+#endif
+            : d(o.d), i(o.i) { }
+
+        inline const Key &key() const { return node(d, i)->key; }
+        inline const T &value() const { return node(d, i)->value; }
+        inline const T &operator*() const { return node(d, i)->value; }
+        inline const T *operator->() const { return &node(d, i)->value; }
+        inline bool operator==(const const_iterator &o) const { return i == o.i && d == o.d; }
+        inline bool operator!=(const const_iterator &o) const { return !(*this == o); }
+
+        inline const_iterator &operator++() { i = d->nextFull(i + 1); return *this; }
+        inline const_iterator operator++(int) { const_iterator r = *this; ++*this; return r; }
+        inline const_iterator &operator--() { i = d->previousFull(i); return *this; }
+        inline const_iterator operator--(int) { const_iterator r = *this; --*this; return r; }
+        inline const_iterator operator+(int j) const
+        { const_iterator r = *this; if (j > 0) while (j--) ++r; else while (j++) --r; return r; }
+        inline const_iterator operator-(int j) const { return operator+(-j); }
+        inline const_iterator &operator+=(int j) { return *this = *this + j; }
+        inline const_iterator &operator-=(int j) { return *this = *this - j; }
+
+#ifdef QT_STRICT_ITERATORS
+    private:
+        inline bool operator==(const iterator &o) const { return operator==(const_iterator(o)); }
+        inline bool operator!=(const iterator &o) const { return operator!=(const_iterator(o)); }
+#endif
+    };
+    friend class const_iterator;
+
+    // STL style
+    inline iterator begin() { detach(); return iterator(d, d->nextFull(0)); }
+    inline const_iterator begin() const { return const_iterator(d, d->nextFull(0)); }
+    inline const_iterator constBegin() const { return const_iterator(d, d->nextFull(0)); }
+    inline iterator end() { detach(); return iterator(d, d->capacity); }
+    inline const_iterator end() const { return const_iterator(d, d->capacity); }
+    inline const_iterator constEnd() const { return const_iterator(d, d->capacity); }
+    iterator erase(iterator it);
+
+    // more Qt
+    typedef iterator Iterator;
+    typedef const_iterator ConstIterator;
+    inline int count() const { return d->size; }
+    iterator find(const Key &key);
+    const_iterator find(const Key &key) const;
+    const_iterator constFind(const Key &key) const;
+    iterator insert(const Key &key, const T &value);
+    QFlatHash<Key, T> &unite(const QFlatHash<Key, T> &other);
+
+    // STL compatibility
+    typedef T mapped_type;
+    typedef Key key_type;
+    typedef ptrdiff_t difference_type;
+    typedef int size_type;
+
+    inline bool empty() const { return isEmpty(); }
+
+private:
+    void detach_helper();
+    void freeData(QFlatHashData *x);
+    void rehash(int newCapacity);
+    int findIndex(const Key &key, uint h) const;
+    int findInsertIndex(uint h) const;
+    int createNode(uint h, const Key &key, const T &value);
+};
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::freeData(QFlatHashData *x)
+{
+    if (QTypeInfo<Key>::isComplex || QTypeInfo<T>::isComplex) {
+        for (int i = x->nextFull(0); i < x->capacity; i = x->nextFull(i + 1))
+            node(x, i)->~Node();
+    }
+    x->destroyAndFree();
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::detach_helper()
+{
+    // same capacity, so every node can stay at its index and the control
+    // bytes, tombstones included, are copied verbatim
+    QFlatHashData *x = QFlatHashData::allocate(d->capacity, sizeof(Node));
+    x->size = d->size;
+    x->growthLeft = d->growthLeft;
+    if (d->capacity) {
+        qMemCopy(x->ctrl, d->ctrl, d->capacity + QFlatHashData::GroupWidth);
+        for (int i = d->nextFull(0); i < d->capacity; i = d->nextFull(i + 1))
+            new (node(x, i)) Node(*node(d, i));
+    }
+    if (!d->ref.deref())
+        freeData(d);
+    d = x;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::rehash(int newCapacity)
+{
+    QFlatHashData *x = QFlatHashData::allocate(newCapacity, sizeof(Node));
+    QFlatHashData *old = d;
+    bool shared = old->ref != 1;
+    d = x;
+
+    for (int i = old->nextFull(0); i < old->capacity; i = old->nextFull(i + 1)) {
+        Node *n = node(old, i);
+        uint h = qFlatHashMix(qHash(n->key));
+        int j = findInsertIndex(h);
+        new (node(x, j)) Node(*n);
+        x->setControl(j, static_cast<signed char>(h & 0x7f));
+        if (!shared)
+            n->~Node();
+    }
+    x->size = old->size;
+    x->growthLeft = x->maximumLoad() - x->size;
+
+    if (shared)
+        old->ref.deref();
+    else
+        old->destroyAndFree();
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE int QFlatHash<Key, T>::findIndex(const Key &akey, uint h) const
+{
+    const int mask = d->capacity - 1;
+    const signed char h2 = static_cast<signed char>(h & 0x7f);
+    int pos = (h >> 7) & mask;
+    int step = 0;
+#ifdef QT_FLATHASH_SSE2
+    // the key is usually in the first group, close to pos; start fetching
+    // its node now rather than after the control bytes have arrived
+    _mm_prefetch(reinterpret_cast<const char *>(node(d, pos)), _MM_HINT_T0);
+#endif
+    for (;;) {
+        QFlatHashGroup group(d->ctrl + pos);
+        uint match = group.match(h2);
+        while (match) {
+            int i = (pos + qFlatHashTrailingZeros(match)) & mask;
+            if (node(d, i)->key == akey)
+                return i;
+            match &= match - 1;
+        }
+        if (group.matchEmpty())
+            return -1;
+        step += QFlatHashData::GroupWidth;
+        pos = (pos + step) & mask;
+    }
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE int QFlatHash<Key, T>::findInsertIndex(uint h) const
+{
+    const int mask = d->capacity - 1;
+    int pos = (h >> 7) & mask;
+    int step = 0;
+    for (;;) {
+        uint free = QFlatHashGroup(d->ctrl + pos).matchEmptyOrDeleted();
+        if (free)
+            return (pos + qFlatHashTrailingZeros(free)) & mask;
+        step += QFlatHashData::GroupWidth;
+        pos = (pos + step) & mask;
+    }
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatHash<Key, T>::createNode(uint h, const Key &akey, const T &avalue)
+{
+    int i = d->capacity ? findInsertIndex(h) : -1;
+    if (i < 0 || (d->growthLeft == 0 && d->ctrl[i] == QFlatHashData::Empty)) {
+        // out of empty slots; drop the tombstones if that frees enough
+        // room, otherwise grow
+        if (d->capacity && d->size <= d->maximumLoad() / 2)
+            rehash(d->capacity);
+        else
+            rehash(QFlatHashData::capacityForSize(d->size + 1));
+        i = findInsertIndex(h);
+    }
+    new (node(d, i)) Node(akey, avalue);
+    if (d->ctrl[i] == QFlatHashData::Empty)
+        --d->growthLeft;
+    d->setControl(i, static_cast<signed char>(h & 0x7f));
+    ++d->size;
+    return i;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE void QFlatHash<Key, T>::clear()
+{
+    *this = QFlatHash<Key, T>();
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE QFlatHash<Key, T> &QFlatHash<Key, T>::operator=(const QFlatHash<Key, T> &other)
+{
+    if (d != other.d) {
+        other.d->ref.ref();
+        if (!d->ref.deref())
+            freeData(d);
+        d = other.d;
+        if (!d->sharable)
+            detach_helper();
+    }
+    return *this;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatHash<Key, T>::value(const Key &akey) const
+{
+    int i;
+    if (d->size == 0 || (i = findIndex(akey, qFlatHashMix(qHash(akey)))) < 0)
+        return T();
+    return node(d, i)->value;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatHash<Key, T>::value(const Key &akey, const T &adefaultValue) const
+{
+    int i;
+    if (d->size == 0 || (i = findIndex(akey, qFlatHashMix(qHash(akey)))) < 0)
+        return adefaultValue;
+    return node(d, i)->value;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<Key> QFlatHash<Key, T>::keys() const
+{
+    QList<Key> res;
+    const_iterator i = begin();
+    while (i != end()) {
+        res.append(i.key());
+        ++i;
+    }
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<Key> QFlatHash<Key, T>::keys(const T &avalue) const
+{
+    QList<Key> res;
+    const_iterator i = begin();
+    while (i != end()) {
+        if (i.value() == avalue)
+            res.append(i.key());
+        ++i;
+    }
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE const Key QFlatHash<Key, T>::key(const T &avalue) const
+{
+    return key(avalue, Key());
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE const Key QFlatHash<Key, T>::key(const T &avalue, const Key &defaultValue) const
+{
+    const_iterator i = begin();
+    while (i != end()) {
+        if (i.value() == avalue)
+            return i.key();
+        ++i;
+    }
+    return defaultValue;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<T> QFlatHash<Key, T>::values() const
+{
+    QList<T> res;
+    const_iterator i = begin();
+    while (i != end()) {
+        res.append(i.value());
+        ++i;
+    }
+    return res;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE int QFlatHash<Key, T>::count(const Key &akey) const
+{
+    return contains(akey) ? 1 : 0;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE const T QFlatHash<Key, T>::operator[](const Key &akey) const
+{
+    return value(akey);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE T &QFlatHash<Key, T>::operator[](const Key &akey)
+{
+    detach();
+
+    uint h = qFlatHashMix(qHash(akey));
+    int i = d->size ? findIndex(akey, h) : -1;
+    if (i < 0)
+        i = createNode(h, akey, T());
+    return node(d, i)->value;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatHash<Key, T>::iterator
+QFlatHash<Key, T>::insert(const Key &akey, const T &avalue)
+{
+    detach();
+
+    uint h = qFlatHashMix(qHash(akey));
+    int i = d->size ? findIndex(akey, h) : -1;
+    if (i < 0)
+        i = createNode(h, akey, avalue);
+    else
+        node(d, i)->value = avalue;
+    return iterator(d, i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE QFlatHash<Key, T> &QFlatHash<Key, T>::unite(const QFlatHash<Key, T> &other)
+{
+    QFlatHash<Key, T> copy(other);
+    for (const_iterator it = copy.constBegin(); it != copy.constEnd(); ++it)
+        insert(it.key(), it.value());
+    return *this;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE int QFlatHash<Key, T>::remove(const Key &akey)
+{
+    if (d->size == 0)
+        return 0;
+    detach();
+
+    int i = findIndex(akey, qFlatHashMix(qHash(akey)));
+    if (i < 0)
+        return 0;
+    node(d, i)->~Node();
+    d->markErased(i);
+    return 1;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE T QFlatHash<Key, T>::take(const Key &akey)
+{
+    if (d->size == 0)
+        return T();
+    detach();
+
+    int i = findIndex(akey, qFlatHashMix(qHash(akey)));
+    if (i < 0)
+        return T();
+    Node *n = node(d, i);
+    T t = n->value;
+    n->~Node();
+    d->markErased(i);
+    return t;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::erase(iterator it)
+{
+    if (it == iterator(d, d->capacity))
+        return it;
+
+    iterator ret = it;
+    ++ret;
+    node(d, it.i)->~Node();
+    d->markErased(it.i);
+    return ret;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE void QFlatHash<Key, T>::reserve(int asize)
+{
+    int newCapacity = QFlatHashData::capacityForSize(qMax(asize, d->size));
+    if (newCapacity != d->capacity)
+        rehash(newCapacity);
+    else
+        detach();
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatHash<Key, T>::const_iterator QFlatHash<Key, T>::find(const Key &akey) const
+{
+    return constFind(akey);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatHash<Key, T>::const_iterator QFlatHash<Key, T>::constFind(const Key &akey) const
+{
+    int i = d->size ? findIndex(akey, qFlatHashMix(qHash(akey))) : -1;
+    return const_iterator(d, i < 0 ? d->capacity : i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::find(const Key &akey)
+{
+    detach();
+    int i = d->size ? findIndex(akey, qFlatHashMix(qHash(akey))) : -1;
+    return iterator(d, i < 0 ? d->capacity : i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE bool QFlatHash<Key, T>::contains(const Key &akey) const
+{
+    return d->size && findIndex(akey, qFlatHashMix(qHash(akey))) >= 0;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE bool QFlatHash<Key, T>::operator==(const QFlatHash<Key, T> &other) const
+{
+    if (size() != other.size())
+        return false;
+    if (d == other.d)
+        return true;
+
+    for (const_iterator it = begin(); it != end(); ++it) {
+        const_iterator oit = other.constFind(it.key());
+        if (oit == other.constEnd() || !(oit.value() == it.value()))
+            return false;
+    }
+    return true;
+}
+
+Q_DECLARE_ASSOCIATIVE_ITERATOR(FlatHash)
+Q_DECLARE_MUTABLE_ASSOCIATIVE_ITERATOR(FlatHash)
+
+QT_END_NAMESPACE
+
+QT_END_HEADER
+
+#endif // QFLATHASH_H
@@ -62,6 +62,9 @@ public:
 
             bytes -= nextBlockSize;
             if (buffers.count() == 1) {
+                // don't copy a block that was handed out by readChunk()
+                if (!buffers.at(0).isDetached())
+                    buffers[0] = QByteArray();
                 if (buffers.at(0).size() != basicBlockSize)
                     buffers[0].resize(basicBlockSize);
                 head = tail = 0;
@@ -94,7 +97,7 @@ public:
         }
 
         // shrink this buffer to its current size
-        buffers[tailBuffer].resize(tail);
+        shrinkTailBuffer();
 
         // create a new QByteArray with the right size
         buffers << QByteArray();
@@ -173,6 +176,8 @@ public:
         if(!buffers.isEmpty()) {
             QByteArray tmp = buffers[0];
             buffers.clear();
+            if (!tmp.isDetached())
+                tmp = QByteArray();
             buffers << tmp;
             if (buffers.at(0).size() != basicBlockSize)
                 buffers[0].resize(basicBlockSize);
@@ -249,6 +254,47 @@ public:
         return ret;
     }
 
+    // Returns the data of the first block. When it starts at the
+    // beginning of the block, the block itself is returned and shared
+    // with the caller instead of being copied.
+    inline QByteArray peekChunk() {
+        if (isEmpty())
+            return QByteArray();
+        if (head != 0)
+            return QByteArray(readPointer(), nextDataBlockSize());
+        // trim the tail block to its data; the next reserve() starts a new one
+        if (tailBuffer == 0 && tail != buffers.at(0).size())
+            buffers[0].resize(tail);
+        return buffers.first();
+    }
+
+    inline QByteArray readChunk() {
+        QByteArray chunk = peekChunk();
+        free(chunk.size());
+        return chunk;
+    }
+
+    // Appends the data of qba. Unless it is small, the array is adopted
+    // as a block of its own instead of being copied.
+    inline void append(const QByteArray &qba) {
+        int bytes = qba.size();
+        if (bytes <= basicBlockSize / 4) {
+            if (bytes > 0)
+                memcpy(reserve(bytes), qba.constData(), bytes);
+            return;
+        }
+
+        if (tail == 0) {
+            buffers[tailBuffer] = qba;
+        } else {
+            shrinkTailBuffer();
+            buffers << qba;
+            ++tailBuffer;
+        }
+        tail = bytes;
+        bufferSize += bytes;
+    }
+
     inline int skip(int length) {
         return read(0, length);
     }
@@ -279,6 +325,14 @@ public:
     }
 
 private:
+    // An array adopted by append() or shared by peekChunk() is always
+    // full, and must not be resized: QByteArray::resize() copies shared
+    // data even when the size does not change.
+    inline void shrinkTailBuffer() {
+        if (tail != buffers.at(tailBuffer).size())
+            buffers[tailBuffer].resize(tail);
+    }
+
     QList<QByteArray> buffers;
     int head, tail;
     int tailBuffer;
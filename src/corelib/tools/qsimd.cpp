@@ -0,0 +1,187 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "qsimd_p.h"
+#include <QByteArray>
+
+QT_BEGIN_NAMESPACE
+
+static uint detectProcessorFeatures()
+{
+#if defined(__x86_64__) || defined(Q_OS_WIN64)
+    return MMX|SSE|SSE2|CMOV;
+#elif defined(__ia64__)
+    return MMX|SSE|SSE2;
+#elif defined(QT_HAVE_IWMMXT)
+    // runtime detection only available when running as a previlegied process
+    static const bool doIWMMXT = !qgetenv("QT_NO_IWMMXT").toInt();
+    return doIWMMXT ? IWMMXT : 0;
+#elif defined(__i386__) || defined(_M_IX86)
+    unsigned int extended_result = 0;
+    uint result = 0;
+    /* see p. 118 of amd64 instruction set manual Vol3 */
+#if defined(Q_CC_GNU)
+    asm ("push %%ebx\n"
+         "pushf\n"
+         "pop %%eax\n"
+         "mov %%eax, %%ebx\n"
+         "xor $0x00200000, %%eax\n"
+         "push %%eax\n"
+         "popf\n"
+         "pushf\n"
+         "pop %%eax\n"
+         "xor %%edx, %%edx\n"
+         "xor %%ebx, %%eax\n"
+         "jz 1f\n"
+
+         "mov $0x00000001, %%eax\n"
+         "cpuid\n"
+         "1:\n"
+         "pop %%ebx\n"
+         "mov %%edx, %0\n"
+        : "=r" (result)
+        :
+        : "%eax", "%ecx", "%edx"
+        );
+
+    asm ("push %%ebx\n"
+         "pushf\n"
+         "pop %%eax\n"
+         "mov %%eax, %%ebx\n"
+         "xor $0x00200000, %%eax\n"
+         "push %%eax\n"
+         "popf\n"
+         "pushf\n"
+         "pop %%eax\n"
+         "xor %%edx, %%edx\n"
+         "xor %%ebx, %%eax\n"
+         "jz 2f\n"
+
+         "mov $0x80000000, %%eax\n"
+         "cpuid\n"
+	 "cmp $0x80000000, %%eax\n"
+	 "jbe 2f\n"
+	 "mov $0x80000001, %%eax\n"
+	 "cpuid\n"
+         "2:\n"
+         "pop %%ebx\n"
+         "mov %%edx, %0\n"
+        : "=r" (extended_result)
+        :
+        : "%eax", "%ecx", "%edx"
+        );
+#elif defined (Q_OS_WIN)
+    _asm {
+	push eax
+	push ebx
+	push ecx
+	push edx
+	pushfd
+	pop eax
+	mov ebx, eax
+	xor eax, 00200000h
+	push eax
+	popfd
+	pushfd
+        pop eax
+	mov edx, 0
+	xor eax, ebx
+	jz skip
+
+	mov eax, 1
+	cpuid
+	mov result, edx
+    skip:
+        pop edx
+	pop ecx
+	pop ebx
+	pop eax
+    }
+
+    _asm {
+	push eax
+	push ebx
+	push ecx
+	push edx
+	pushfd
+	pop eax
+	mov ebx, eax
+	xor eax, 00200000h
+	push eax
+	popfd
+	pushfd
+        pop eax
+	mov edx, 0
+	xor eax, ebx
+	jz skip2
+
+	mov eax, 80000000h
+	cpuid
+        cmp eax, 80000000h
+        jbe skip2
+        mov eax, 80000001h
+        cpuid
+	mov extended_result, edx
+    skip2:
+        pop edx
+	pop ecx
+	pop ebx
+	pop eax
+    }
+#endif
+
+    static const bool doMMX = !qgetenv("QT_NO_MMX").toInt();
+    static const bool doMMXEXT = !qgetenv("QT_NO_MMXEXT").toInt();
+    static const bool do3DNOW = !qgetenv("QT_NO_3DNOW").toInt();
+    static const bool do3DNOWEXT = !qgetenv("QT_NO_3DNOWEXT").toInt();
+    static const bool doSSE = !qgetenv("QT_NO_SSE").toInt();
+    static const bool doSSE2 = !qgetenv("QT_NO_SSE2").toInt();
+
+    uint features = 0;
+    // result now contains the standard feature bits
+    if (result & (1 << 15))
+        features |= CMOV;
+    if (doMMX && (result & (1 << 23)))
+        features |= MMX;
+    if (doMMXEXT && (extended_result & (1 << 22)))
+        features |= MMXEXT;
+    if (do3DNOW && (extended_result & (1 << 31)))
+        features |= MMX3DNOW;
+    if (do3DNOWEXT && (extended_result & (1 << 30)))
+        features |= MMX3DNOWEXT;
+    if (doSSE && (result & (1 << 25)))
+        features |= SSE;
+    if (doSSE2 && (result & (1 << 26)))
+        features |= SSE2;
+    return features;
+#else
+    return 0;
+#endif
+}
+
+/*!
+    \internal
+
+    Returns the CPUFeatures supported by the processor, minus the ones
+    disabled with the QT_NO_MMX, QT_NO_SSE2, etc. environment variables.
+    The result is computed on the first call.
+*/
+uint qDetectCPUFeatures()
+{
+    static uint features = 0xffffffff;
+    if (features == 0xffffffff)
+        features = detectProcessorFeatures();
+    return features;
+}
+
+QT_END_NAMESPACE
@@ -23,6 +23,8 @@
 #include "qlocale_p.h"
 #include "qstringmatcher.h"
 #include "qtools_p.h"
+#include "qstring_p.h"
+#include "qsimd_p.h"
 #include "qhash.h"
 #include "qdebug.h"
 
@@ -122,16 +124,137 @@ static int ucstricmp(const ushort *a, const ushort *ae, const uchar *b)
 }
 
 
+static void qt_from_latin1_c(ushort *dst, const uchar *src, int len)
+{
+    while (len--)
+        *dst++ = *src++;
+}
+
+static void qt_to_latin1_c(uchar *dst, const ushort *src, int len)
+{
+    while (len--) {
+        *dst++ = (*src>0xff) ? '?' : (uchar) *src;
+        ++src;
+    }
+}
+
+static int qt_from_ascii_prefix_c(ushort *dst, const uchar *src, int len)
+{
+    int i = 0;
+    for (; i < len && src[i] < 0x80; ++i)
+        dst[i] = src[i];
+    return i;
+}
+
+static int qt_to_ascii_prefix_c(uchar *dst, const ushort *src, int len)
+{
+    int i = 0;
+    for (; i < len && src[i] < 0x80; ++i)
+        dst[i] = (uchar) src[i];
+    return i;
+}
+
+static int qt_ucstr_mismatch_c(const ushort *a, const ushort *b, int len)
+{
+    int i = 0;
+    while (i < len && a[i] == b[i])
+        ++i;
+    return i;
+}
+
+static int qt_ucstr_find_c(const ushort *s, int len, ushort c)
+{
+    for (int i = 0; i < len; ++i) {
+        if (s[i] == c)
+            return i;
+    }
+    return -1;
+}
+
+static void qt_from_latin1_setup(ushort *dst, const uchar *src, int len);
+static void qt_to_latin1_setup(uchar *dst, const ushort *src, int len);
+static int qt_from_ascii_prefix_setup(ushort *dst, const uchar *src, int len);
+static int qt_to_ascii_prefix_setup(uchar *dst, const ushort *src, int len);
+static int qt_ucstr_mismatch_setup(const ushort *a, const ushort *b, int len);
+static int qt_ucstr_find_setup(const ushort *s, int len, ushort c);
+
+qt_from_latin1_func qt_from_latin1 = qt_from_latin1_setup;
+qt_to_latin1_func qt_to_latin1 = qt_to_latin1_setup;
+qt_from_ascii_prefix_func qt_from_ascii_prefix = qt_from_ascii_prefix_setup;
+qt_to_ascii_prefix_func qt_to_ascii_prefix = qt_to_ascii_prefix_setup;
+qt_ucstr_mismatch_func qt_ucstr_mismatch = qt_ucstr_mismatch_setup;
+qt_ucstr_find_func qt_ucstr_find = qt_ucstr_find_setup;
+
+static void qInitStringKernels()
+{
+    uint features = qDetectCPUFeatures();
+    Q_UNUSED(features);
+
+#ifdef QT_HAVE_SSE2
+    if (features & SSE2) {
+        qt_from_latin1 = qt_from_latin1_sse2;
+        qt_to_latin1 = qt_to_latin1_sse2;
+        qt_from_ascii_prefix = qt_from_ascii_prefix_sse2;
+        qt_to_ascii_prefix = qt_to_ascii_prefix_sse2;
+        qt_ucstr_mismatch = qt_ucstr_mismatch_sse2;
+        qt_ucstr_find = qt_ucstr_find_sse2;
+        return;
+    }
+#endif
+    qt_from_latin1 = qt_from_latin1_c;
+    qt_to_latin1 = qt_to_latin1_c;
+    qt_from_ascii_prefix = qt_from_ascii_prefix_c;
+    qt_to_ascii_prefix = qt_to_ascii_prefix_c;
+    qt_ucstr_mismatch = qt_ucstr_mismatch_c;
+    qt_ucstr_find = qt_ucstr_find_c;
+}
+
+static void qt_from_latin1_setup(ushort *dst, const uchar *src, int len)
+{
+    qInitStringKernels();
+    qt_from_latin1(dst, src, len);
+}
+
+static void qt_to_latin1_setup(uchar *dst, const ushort *src, int len)
+{
+    qInitStringKernels();
+    qt_to_latin1(dst, src, len);
+}
+
+static int qt_from_ascii_prefix_setup(ushort *dst, const uchar *src, int len)
+{
+    qInitStringKernels();
+    return qt_from_ascii_prefix(dst, src, len);
+}
+
+static int qt_to_ascii_prefix_setup(uchar *dst, const ushort *src, int len)
+{
+    qInitStringKernels();
+    return qt_to_ascii_prefix(dst, src, len);
+}
+
+static int qt_ucstr_mismatch_setup(const ushort *a, const ushort *b, int len)
+{
+    qInitStringKernels();
+    return qt_ucstr_mismatch(a, b, len);
+}
+
+static int qt_ucstr_find_setup(const ushort *s, int len, ushort c)
+{
+    qInitStringKernels();
+    return qt_ucstr_find(s, len, c);
+}
+
 static int ucstrcmp(const QChar *a, int alen, const QChar *b, int blen)
 {
     if (a == b)
         return 0;
     int l = qMin(alen, blen);
-    while (l-- && *a == *b)
-        a++,b++;
-    if (l == -1)
+    int i = qt_ucstr_mismatch(reinterpret_cast<const ushort *>(a),
+                              reinterpret_cast<const ushort *>(b), l);
+    if (i == l)
         return (alen-blen);
-    return a->unicode() - b->unicode();
+    return a[i].unicode() - b[i].unicode();
 }
 
 inline int ucstrcmp(const QString &as, const QString &bs)
@@ -2095,13 +2218,12 @@ int QString::indexOf(QChar ch, int from, Qt::CaseSensitivity cs) const
     if (from < 0)
         from = qMax(from + d->size, 0);
     if (from  < d->size) {
-        const ushort *n = d->data + from - 1;
-        const ushort *e = d->data + d->size;
         if (cs == Qt::CaseSensitive) {
-            while (++n != e)
-                if (*n == c)
-                    return  n - d->data;
+            int i = qt_ucstr_find(d->data + from, d->size - from, c);
+            return i < 0 ? -1 : from + i;
         } else {
+            const ushort *n = d->data + from - 1;
+            const ushort *e = d->data + d->size;
             c = foldCase(c);
             while (++n != e)
                 if (foldCase(*n) == c)
@@ -3010,13 +3132,7 @@ QByteArray QString::toLatin1() const
     QByteArray ba;
     if (d->size) {
         ba.resize(d->size);
-        const ushort *i = d->data;
-        const ushort *e = d->data + d->size;
-        uchar *s = (uchar*) ba.data();
-        while (i != e) {
-            *s++ = (*i>0xff) ? '?' : (uchar) *i;
-            ++i;
-        }
+        qt_to_latin1((uchar*) ba.data(), d->data, d->size);
     }
     return ba;
 }
@@ -3075,7 +3191,12 @@ QByteArray QString::toUtf8() const
         for (int i=0; i < l; i++) {
             uint u = *ch;
             if (u < 0x80) {
-                *cursor++ = (uchar)u;
+                // copy the whole ASCII run at once
+                int n = qt_to_ascii_prefix(cursor, ch, l - i);
+                cursor += n;
+                ch += n;
+                i += n - 1;
+                continue;
             } else {
                 if (u < 0x0800) {
                     *cursor++ = 0xc0 | ((uchar) (u >> 6));
@@ -3150,10 +3271,8 @@ QString::Data *QString::fromLatin1_helper(const char *str, int size)
         d->alloc = d->size = size;
         d->clean = d->asciiCache = d->simpletext = d->righttoleft = d->capacity = 0;
         d->data = d->array;
-        ushort *i = d->data;
         d->array[size] = '\0';
-        while (size--)
-           *i++ = (uchar)*str++;
+        qt_from_latin1(d->data, reinterpret_cast<const uchar *>(str), size);
     }
     return d;
 }
@@ -3435,7 +3554,10 @@ QString QString::fromUtf8(const char *str, int size)
             }
         } else {
             if (ch < 128) {
-                *qch++ = ch;
+                // copy the whole ASCII run at once
+                int n = qt_from_ascii_prefix(qch, reinterpret_cast<const uchar *>(str) + i, size - i);
+                qch += n;
+                i += n - 1;
             } else if ((ch & 0xe0) == 0xc0) {
                 uc = ch & 0x1f;
                 need = 1;
@@ -0,0 +1,73 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#ifndef QSTRING_P_H
+#define QSTRING_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Conversion and search kernels used by QString and the UTF-8 codec.
+    They are resolved on first use to the fastest version the processor
+    supports.
+
+    qt_from_latin1 widens len Latin-1 bytes; qt_to_latin1 narrows len
+    UTF-16 code units, replacing the ones above 0xff by '?'.
+
+    qt_from_ascii_prefix and qt_to_ascii_prefix convert the leading
+    ASCII characters of src and return how many there were. They may
+    write to dst past that count, but never past len.
+
+    qt_ucstr_mismatch returns the index of the first code unit that
+    differs between a and b, or len if there is none. qt_ucstr_find
+    returns the index of the first c in s, or -1.
+*/
+typedef void (*qt_from_latin1_func)(ushort *dst, const uchar *src, int len);
+typedef void (*qt_to_latin1_func)(uchar *dst, const ushort *src, int len);
+typedef int (*qt_from_ascii_prefix_func)(ushort *dst, const uchar *src, int len);
+typedef int (*qt_to_ascii_prefix_func)(uchar *dst, const ushort *src, int len);
+typedef int (*qt_ucstr_mismatch_func)(const ushort *a, const ushort *b, int len);
+typedef int (*qt_ucstr_find_func)(const ushort *s, int len, ushort c);
+
+extern qt_from_latin1_func qt_from_latin1;
+extern qt_to_latin1_func qt_to_latin1;
+extern qt_from_ascii_prefix_func qt_from_ascii_prefix;
+extern qt_to_ascii_prefix_func qt_to_ascii_prefix;
+extern qt_ucstr_mismatch_func qt_ucstr_mismatch;
+extern qt_ucstr_find_func qt_ucstr_find;
+
+#ifdef QT_HAVE_SSE2
+void qt_from_latin1_sse2(ushort *dst, const uchar *src, int len);
+void qt_to_latin1_sse2(uchar *dst, const ushort *src, int len);
+int qt_from_ascii_prefix_sse2(ushort *dst, const uchar *src, int len);
+int qt_to_ascii_prefix_sse2(uchar *dst, const ushort *src, int len);
+int qt_ucstr_mismatch_sse2(const ushort *a, const ushort *b, int len);
+int qt_ucstr_find_sse2(const ushort *s, int len, ushort c);
+#endif
+
+QT_END_NAMESPACE
+
+#endif // QSTRING_P_H
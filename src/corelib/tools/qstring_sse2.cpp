@@ -0,0 +1,142 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "qstring_p.h"
+
+#ifdef QT_HAVE_SSE2
+
+#include <emmintrin.h>
+
+QT_BEGIN_NAMESPACE
+
+static inline int trailingZeros(uint mask)
+{
+#if defined(Q_CC_GNU)
+    return __builtin_ctz(mask);
+#else
+    int n = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+void qt_from_latin1_sse2(ushort *dst, const uchar *src, int len)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_unpacklo_epi8(chunk, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 8), _mm_unpackhi_epi8(chunk, zero));
+    }
+    for (; i < len; ++i)
+        dst[i] = src[i];
+}
+
+void qt_to_latin1_sse2(uchar *dst, const ushort *src, int len)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i highByte = _mm_set1_epi16(short(0xff00));
+    const __m128i questionMark = _mm_set1_epi8('?');
+    int i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 8));
+        // characters above 0xff saturate, they are replaced below
+        const __m128i packed = _mm_packus_epi16(lo, hi);
+        const __m128i latin1 = _mm_packs_epi16(_mm_cmpeq_epi16(_mm_and_si128(lo, highByte), zero),
+                                               _mm_cmpeq_epi16(_mm_and_si128(hi, highByte), zero));
+        const __m128i result = _mm_or_si128(_mm_and_si128(latin1, packed),
+                                            _mm_andnot_si128(latin1, questionMark));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), result);
+    }
+    for (; i < len; ++i)
+        dst[i] = (src[i] > 0xff) ? '?' : uchar(src[i]);
+}
+
+int qt_from_ascii_prefix_sse2(ushort *dst, const uchar *src, int len)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_unpacklo_epi8(chunk, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 8), _mm_unpackhi_epi8(chunk, zero));
+        // the sign bits are set for the bytes that are not ASCII
+        const uint nonAscii = _mm_movemask_epi8(chunk);
+        if (nonAscii)
+            return i + trailingZeros(nonAscii);
+    }
+    for (; i < len && src[i] < 0x80; ++i)
+        dst[i] = src[i];
+    return i;
+}
+
+int qt_to_ascii_prefix_sse2(uchar *dst, const ushort *src, int len)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i nonAsciiBits = _mm_set1_epi16(short(0xff80));
+    int i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(lo, hi));
+        const __m128i ascii = _mm_packs_epi16(_mm_cmpeq_epi16(_mm_and_si128(lo, nonAsciiBits), zero),
+                                              _mm_cmpeq_epi16(_mm_and_si128(hi, nonAsciiBits), zero));
+        const uint mask = _mm_movemask_epi8(ascii);
+        if (mask != 0xffff)
+            return i + trailingZeros(~mask);
+    }
+    for (; i < len && src[i] < 0x80; ++i)
+        dst[i] = uchar(src[i]);
+    return i;
+}
+
+int qt_ucstr_mismatch_sse2(const ushort *a, const ushort *b, int len)
+{
+    int i = 0;
+    for (; i + 8 <= len; i += 8) {
+        const __m128i equal = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i)),
+                                              _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i)));
+        const uint mask = _mm_movemask_epi8(equal);
+        if (mask != 0xffff)
+            return i + trailingZeros(~mask) / 2;
+    }
+    while (i < len && a[i] == b[i])
+        ++i;
+    return i;
+}
+
+int qt_ucstr_find_sse2(const ushort *s, int len, ushort c)
+{
+    const __m128i needle = _mm_set1_epi16(c);
+    int i = 0;
+    for (; i + 8 <= len; i += 8) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        const uint mask = _mm_movemask_epi8(_mm_cmpeq_epi16(chunk, needle));
+        if (mask)
+            return i + trailingZeros(mask) / 2;
+    }
+    for (; i < len; ++i) {
+        if (s[i] == c)
+            return i;
+    }
+    return -1;
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_HAVE_SSE2
@@ -3,6 +3,7 @@
 HEADERS +=  \
 	tools/qalgorithms.h \
 	tools/qbitarray.h \
+	tools/qbtreemap.h \
 	tools/qbytearray.h \
 	tools/qbytearraymatcher.h \
 	tools/qcache.h \
@@ -11,6 +12,7 @@ HEADERS +=  \
 	tools/qcryptographichash.h \
 	tools/qdatetime.h \
 	tools/qdatetime_p.h \
+	tools/qflathash.h \
 	tools/qhash.h \
         tools/qline.h \
 	tools/qlinkedlist.h \
@@ -27,9 +29,11 @@ HEADERS +=  \
 	tools/qringbuffer_p.h \
 	tools/qshareddata.h \
 	tools/qset.h \
+	tools/qsimd_p.h \
         tools/qsize.h \
 	tools/qstack.h \
 	tools/qstring.h \
+	tools/qstring_p.h \
 	tools/qstringlist.h \
 	tools/qstringmatcher.h \
 	tools/qtimeline.h \
@@ -40,10 +44,12 @@ HEADERS +=  \
 
 SOURCES += \
 	tools/qbitarray.cpp \
+	tools/qbtreemap.cpp \
 	tools/qbytearray.cpp \
 	tools/qbytearraymatcher.cpp \
 	tools/qcryptographichash.cpp \
 	tools/qdatetime.cpp \
+	tools/qflathash.cpp \
 	tools/qhash.cpp \
         tools/qline.cpp \
 	tools/qlinkedlist.cpp \
@@ -54,6 +60,7 @@ SOURCES += \
         tools/qrect.cpp \
 	tools/qregexp.cpp \
 	tools/qshareddata.cpp \
+	tools/qsimd.cpp \
         tools/qsize.cpp \
 	tools/qstring.cpp \
 	tools/qstringlist.cpp \
@@ -61,6 +68,27 @@ SOURCES += \
 	tools/qvector.cpp \
         tools/qvsnprintf.cpp
 
+iwmmxt: DEFINES += QT_HAVE_IWMMXT
+sse2 {
+    DEFINES += QT_HAVE_SSE2
+    SSE2_SOURCES += tools/qstring_sse2.cpp \
+                    io/qdatastream_sse2.cpp
+
+    win32-g++|!win32:!*-icc* {
+        sse2_compiler.commands = $$QMAKE_CXX -c -Winline
+        sse2_compiler.commands += -msse2
+        sse2_compiler.commands += $(CXXFLAGS) $(INCPATH) ${QMAKE_FILE_IN} -o ${QMAKE_FILE_OUT}
+        sse2_compiler.dependency_type = TYPE_C
+        sse2_compiler.output = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_BASE}$${first(QMAKE_EXT_OBJ)}
+        sse2_compiler.input = SSE2_SOURCES
+        sse2_compiler.variable_out = OBJECTS
+        sse2_compiler.name = compiling[sse2] ${QMAKE_FILE_IN}
+        silent:sse2_compiler.commands = @echo compiling[sse2] ${QMAKE_FILE_IN} && $$sse2_compiler.commands
+        QMAKE_EXTRA_COMPILERS += sse2_compiler
+    } else {
+        SOURCES += $$SSE2_SOURCES
+    }
+}
 
 #zlib support
 contains(QT_CONFIG, zlib) {
@@ -47,6 +47,9 @@ unix:x11:SOURCES += image/qpixmap_x11.cpp
 !embedded:!x11:mac:SOURCES += image/qpixmap_mac.cpp
 embedded:SOURCES += image/qpixmap_qws.cpp image/qpixmap_raster.cpp
 
+# compiled together with the other SSE2 sources in painting/painting.pri
+sse2:SSE2_SOURCES += image/qimage_sse2.cpp
+
 # Built-in image format support
 HEADERS += \
         image/qbmphandler_p.h \
@@ -29,6 +29,7 @@
 #include <private/qmemrotate_p.h>
 #include <private/qpixmap_p.h>
 #include <private/qimagescale_p.h>
+#include <private/qsimd_p.h>
 
 #include <qhash.h>
 
@@ -2006,6 +2007,59 @@ bool QImage::create(const QSize& size, int depth, int numColors, QImage::Endian
  *****************************************************************************/
 
 typedef void (*Image_Converter)(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags);
+typedef void (*InPlace_Image_Converter)(QImageData *data, Qt::ImageConversionFlags);
+
+/*
+  The pixel loops of the 32 bit conversions. They are replaced with SIMD
+  versions by qInitImageConversions() and must all work with dest == src,
+  which the in place conversions rely on.
+*/
+typedef void (*Span_Converter)(uint *dest, const uint *src, int count);
+
+static void convert_ARGB_to_ARGB_PM_span(uint *dest, const uint *src, int count)
+{
+    const uint *end = src + count;
+    while (src < end) {
+        *dest = PREMUL(*src);
+        ++src;
+        ++dest;
+    }
+}
+
+static void convert_ARGB_PM_to_ARGB_span(uint *dest, const uint *src, int count)
+{
+    const uint *end = src + count;
+    while (src < end) {
+        *dest = INV_PREMUL(*src);
+        ++src;
+        ++dest;
+    }
+}
+
+static void convert_ARGB_PM_to_RGB_span(uint *dest, const uint *src, int count)
+{
+    const uint *end = src + count;
+    while (src < end) {
+        *dest = 0xff000000 | INV_PREMUL(*src);
+        ++src;
+        ++dest;
+    }
+}
+
+static void mask_alpha_span(uint *dest, const uint *src, int count)
+{
+    const uint *end = src + count;
+    while (src < end) {
+        *dest = *src | 0xff000000;
+        ++src;
+        ++dest;
+    }
+}
+
+static Span_Converter qt_convert_ARGB_to_ARGB_PM = convert_ARGB_to_ARGB_PM_span;
+static Span_Converter qt_convert_ARGB_PM_to_ARGB = convert_ARGB_PM_to_ARGB_span;
+static Span_Converter qt_convert_ARGB_PM_to_RGB = convert_ARGB_PM_to_RGB_span;
+static Span_Converter qt_mask_alpha = mask_alpha_span;
 
 static void convert_ARGB_to_ARGB_PM(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
 {
@@ -2016,14 +2070,7 @@ static void convert_ARGB_to_ARGB_PM(QImageData *dest, const QImageData *src, Qt:
     Q_ASSERT(src->nbytes == dest->nbytes);
     Q_ASSERT(src->bytes_per_line == dest->bytes_per_line);
 
-    const QRgb *src_data = (QRgb *) src->data;
-    const QRgb *end = src_data + (src->nbytes>>2);
-    QRgb *dest_data = (QRgb *) dest->data;
-    while (src_data < end) {
-        *dest_data = PREMUL(*src_data);
-        ++src_data;
-        ++dest_data;
-    }
+    qt_convert_ARGB_to_ARGB_PM((uint *) dest->data, (const uint *) src->data, src->nbytes >> 2);
 }
 
 static void convert_ARGB_PM_to_ARGB(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
@@ -2035,14 +2082,7 @@ static void convert_ARGB_PM_to_ARGB(QImageData *dest, const QImageData *src, Qt:
     Q_ASSERT(src->nbytes == dest->nbytes);
     Q_ASSERT(src->bytes_per_line == dest->bytes_per_line);
 
-    const QRgb *src_data = (QRgb *) src->data;
-    const QRgb *end = src_data + (src->nbytes>>2);
-    QRgb *dest_data = (QRgb *) dest->data;
-    while (src_data < end) {
-        *dest_data = INV_PREMUL(*src_data);
-        ++src_data;
-        ++dest_data;
-    }
+    qt_convert_ARGB_PM_to_ARGB((uint *) dest->data, (const uint *) src->data, src->nbytes >> 2);
 }
 
 static void convert_ARGB_PM_to_RGB(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
@@ -2054,14 +2094,39 @@ static void convert_ARGB_PM_to_RGB(QImageData *dest, const QImageData *src, Qt::
     Q_ASSERT(src->nbytes == dest->nbytes);
     Q_ASSERT(src->bytes_per_line == dest->bytes_per_line);
 
-    const QRgb *src_data = (QRgb *) src->data;
-    const QRgb *end = src_data + (src->nbytes>>2);
-    QRgb *dest_data = (QRgb *) dest->data;
-    while (src_data < end) {
-        *dest_data = 0xff000000 | INV_PREMUL(*src_data);
-        ++src_data;
-        ++dest_data;
-    }
+    qt_convert_ARGB_PM_to_RGB((uint *) dest->data, (const uint *) src->data, src->nbytes >> 2);
+}
+
+static void convert_ARGB_to_ARGB_PM_inplace(QImageData *data, Qt::ImageConversionFlags)
+{
+    Q_ASSERT(data->format == QImage::Format_ARGB32);
+
+    uint *buffer = (uint *) data->data;
+    qt_convert_ARGB_to_ARGB_PM(buffer, buffer, data->nbytes >> 2);
+}
+
+static void convert_ARGB_PM_to_ARGB_inplace(QImageData *data, Qt::ImageConversionFlags)
+{
+    Q_ASSERT(data->format == QImage::Format_ARGB32_Premultiplied);
+
+    uint *buffer = (uint *) data->data;
+    qt_convert_ARGB_PM_to_ARGB(buffer, buffer, data->nbytes >> 2);
+}
+
+static void convert_ARGB_PM_to_RGB_inplace(QImageData *data, Qt::ImageConversionFlags)
+{
+    Q_ASSERT(data->format == QImage::Format_ARGB32_Premultiplied);
+
+    uint *buffer = (uint *) data->data;
+    qt_convert_ARGB_PM_to_RGB(buffer, buffer, data->nbytes >> 2);
+}
+
+static void mask_alpha_inplace(QImageData *data, Qt::ImageConversionFlags)
+{
+    Q_ASSERT(data->depth == 32);
+
+    uint *buffer = (uint *) data->data;
+    qt_mask_alpha(buffer, buffer, data->nbytes >> 2);
 }
 
 static void swap_bit_order(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
@@ -2091,14 +2156,7 @@ static void mask_alpha_converter(QImageData *dest, const QImageData *src, Qt::Im
     Q_ASSERT(src->height == dest->height);
     Q_ASSERT(src->nbytes == dest->nbytes);
 
-    const uint *src_data = (const uint *)src->data;
-    const uint *end = (const uint *)(src->data + src->nbytes);
-    uint *dest_data = (uint *)dest->data;
-    while (src_data < end) {
-        *dest_data = *src_data | 0xff000000;
-        ++src_data;
-        ++dest_data;
-    }
+    qt_mask_alpha((uint *) dest->data, (const uint *) src->data, src->nbytes >> 2);
 }
 
 static QVector<QRgb> fix_color_table(const QVector<QRgb> &ctbl, QImage::Format format)
@@ -2810,6 +2868,23 @@ static void convert_Mono_to_Indexed8(QImageData *dest, const QImageData *src, Qt
 
 #if !defined(Q_WS_QWS) || defined(QT_QWS_DEPTH_16)
 
+static void convert_16_to_32_span(uint *dest, const ushort *src, int count)
+{
+    const uint *end = dest + count;
+    while (dest < end)
+        *dest++ = qt_conv16ToRgb(*src++);
+}
+
+static void convert_32_to_16_span(ushort *dest, const uint *src, int count)
+{
+    const ushort *end = dest + count;
+    while (dest < end)
+        *dest++ = qt_convRgbTo16(*src++);
+}
+
+static void (*qt_convert_16_to_32)(uint *dest, const ushort *src, int count) = convert_16_to_32_span;
+static void (*qt_convert_32_to_16)(ushort *dest, const uint *src, int count) = convert_32_to_16_span;
+
 static void convert_16_to_32(QImageData *dest, const QImageData *src, Qt::ImageConversionFlags)
 {
     Q_ASSERT(src->format == QImage::Format_RGB16);
@@ -2823,13 +2898,7 @@ static void convert_16_to_32(QImageData *dest, const QImageData *src, Qt::ImageC
     const uchar *src_data = src->data;
     uchar *dest_data = dest->data;
     for (int y = 0; y < src->height; y++) {
-        uint *p = (uint *)dest_data;
-        const ushort *b = (ushort*)src_data;
-        uint *end = p + w;
-
-        while (p < end)
-            *p++ = qt_conv16ToRgb(*b++);
-
+        qt_convert_16_to_32((uint *)dest_data, (const ushort *)src_data, w);
         src_data += src->bytes_per_line;
         dest_data += dest->bytes_per_line;
     }
@@ -2849,13 +2918,7 @@ static void convert_32_to_16(QImageData *dest,   const QImageData *src, Qt::Imag
     const uchar *src_data = src->data;
     uchar *dest_data = dest->data;
     for (int y = 0; y < src->height; y++) {
-        ushort *p = (ushort *)dest_data;
-        const uint *b = (const uint*)src_data;
-        ushort *end = p + w;
-
-        while (p < end)
-            *p++ = qt_convRgbTo16(*b++);
-
+        qt_convert_32_to_16((ushort *)dest_data, (const uint *)src_data, w);
         src_data += src->bytes_per_line;
         dest_data += dest->bytes_per_line;
     }
@@ -2968,6 +3031,79 @@ static const Image_Converter converter_map[QImage::NImageFormats][QImage::NImage
     } // Format_RGB16
 };
 
+// first index source, second dest. Only conversions that keep the depth
+// can be done in place.
+static const InPlace_Image_Converter inplace_converter_map[QImage::NImageFormats][QImage::NImageFormats] =
+{
+    {
+        0, 0, 0, 0, 0, 0, 0, 0
+    }, // Format_Invalid
+    {
+        0, 0, 0, 0, 0, 0, 0, 0
+    }, // Format_Mono
+    {
+        0, 0, 0, 0, 0, 0, 0, 0
+    }, // Format_MonoLSB
+    {
+        0, 0, 0, 0, 0, 0, 0, 0
+    }, // Format_Indexed8
+    {
+        0,
+        0,
+        0,
+        0,
+        0,
+        mask_alpha_inplace,
+        mask_alpha_inplace,
+        0
+    }, // Format_RGB32
+    {
+        0,
+        0,
+        0,
+        0,
+        mask_alpha_inplace,
+        0,
+        convert_ARGB_to_ARGB_PM_inplace,
+        0
+    }, // Format_ARGB32
+    {
+        0,
+        0,
+        0,
+        0,
+        convert_ARGB_PM_to_RGB_inplace,
+        convert_ARGB_PM_to_ARGB_inplace,
+        0,
+        0
+    }, // Format_ARGB32_Premultiplied
+    {
+        0, 0, 0, 0, 0, 0, 0, 0
+    } // Format_RGB16
+};
+
+static int qInitImageConversions()
+{
+    uint features = qDetectCPUFeatures();
+    Q_UNUSED(features);
+
+#ifdef QT_HAVE_SSE2
+    if (features & SSE2) {
+        qt_convert_ARGB_to_ARGB_PM = qt_convert_ARGB_to_ARGB_PM_sse2;
+        qt_convert_ARGB_PM_to_ARGB = qt_convert_ARGB_PM_to_ARGB_sse2;
+        qt_convert_ARGB_PM_to_RGB = qt_convert_ARGB_PM_to_RGB_sse2;
+        qt_mask_alpha = qt_mask_alpha_sse2;
+#ifndef Q_WS_QWS
+        qt_convert_16_to_32 = qt_convert_RGB16_to_RGB_sse2;
+        qt_convert_32_to_16 = qt_convert_RGB_to_RGB16_sse2;
+#endif
+    }
+#endif
+    return 1;
+}
+
+Q_CONSTRUCTOR_FUNCTION(qInitImageConversions)
+
 /*!
     Returns a copy of the image in the given \a format.
 
@@ -3039,6 +3175,37 @@ QImage QImage::convertToFormat(Format format, Qt::ImageConversionFlags flags) co
     return QImage();
 }
 
+/*!
+    \since 4.4
+
+    Converts the image to the given \a format.
+
+    Conversions between the 32-bit formats are done in place, without
+    allocating a second buffer, when the image data is not shared with
+    another QImage. Other conversions behave like convertToFormat().
+
+    The specified image conversion \a flags control how the image data
+    is handled during the conversion process.
+
+    \sa convertToFormat(), {QImage#Image Format}{Image Format}
+*/
+void QImage::convertTo(Format format, Qt::ImageConversionFlags flags)
+{
+    if (!d || d->format == format)
+        return;
+
+    InPlace_Image_Converter converter = inplace_converter_map[d->format][format];
+    if (converter && d->ref == 1 && !d->ro_data
+        && !(d->paintEngine && d->paintEngine->isActive())) {
+        detach();
+        converter(d, flags);
+        d->format = format;
+        return;
+    }
+
+    *this = convertToFormat(format, flags);
+}
+
 
 
 static inline int pixel_distance(QRgb p1, QRgb p2) {
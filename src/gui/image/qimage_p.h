@@ -26,9 +26,12 @@
 //
 
 #include <QtCore/qglobal.h>
+#include <QtCore/qmap.h>
 
 QT_BEGIN_NAMESPACE
 
+class QImageWriter;
+
 struct QImageData {        // internal image data
     QImageData();
     ~QImageData();
@@ -66,6 +69,15 @@ struct QImageData {        // internal image data
     QPaintEngine *paintEngine;
 };
 
+#ifdef QT_HAVE_SSE2
+void qt_convert_ARGB_to_ARGB_PM_sse2(uint *dest, const uint *src, int count);
+void qt_convert_ARGB_PM_to_ARGB_sse2(uint *dest, const uint *src, int count);
+void qt_convert_ARGB_PM_to_RGB_sse2(uint *dest, const uint *src, int count);
+void qt_mask_alpha_sse2(uint *dest, const uint *src, int count);
+void qt_convert_RGB16_to_RGB_sse2(uint *dest, const ushort *src, int count);
+void qt_convert_RGB_to_RGB16_sse2(ushort *dest, const uint *src, int count);
+#endif
+
 QT_END_NAMESPACE
 
 #endif
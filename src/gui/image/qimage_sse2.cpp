@@ -0,0 +1,205 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "qimage.h"
+#include <private/qimage_p.h>
+#include <private/qdrawhelper_p.h>
+
+#ifdef QT_HAVE_SSE2
+
+#include <emmintrin.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+  The SSE2 versions of the pixel loops used by the image format
+  conversions. They give exactly the same results as the C versions in
+  qimage.cpp, and all of them work when dest == src.
+*/
+
+void qt_convert_ARGB_to_ARGB_PM_sse2(uint *dest, const uint *src, int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(0xff000000);
+    const __m128i half = _mm_set1_epi16(0x80);
+
+    int i = 0;
+    for (; i < count - 3; i += 4) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i alpha = _mm_and_si128(v, alphaMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask)) == 0xffff) {
+            // all opaque, nothing to do
+            _mm_storeu_si128((__m128i *)(dest + i), v);
+            continue;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xffff) {
+            _mm_storeu_si128((__m128i *)(dest + i), zero);
+            continue;
+        }
+
+        // t = c * a; c = (t + (t >> 8) + 0x80) >> 8, as in PREMUL()
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        lo = _mm_mullo_epi16(lo, _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)),
+                                                     _MM_SHUFFLE(3, 3, 3, 3)));
+        hi = _mm_mullo_epi16(hi, _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)),
+                                                     _MM_SHUFFLE(3, 3, 3, 3)));
+        lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), half), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), half), 8);
+
+        const __m128i result = _mm_packus_epi16(lo, hi);
+        _mm_storeu_si128((__m128i *)(dest + i),
+                         _mm_or_si128(_mm_andnot_si128(alphaMask, result), alpha));
+    }
+
+    for (; i < count; ++i)
+        dest[i] = PREMUL(src[i]);
+}
+
+/*
+  Multiplies the channels of the pixels in \a v, unpacked to 16 bits, by
+  the unpremultiply factors \a f0 and \a f1 and shifts the result right
+  by 16 bits. The factors are split into their high and low 16 bits so
+  the product can be formed exactly with 16 bit multiplies. The alpha
+  channel is multiplied by one.
+*/
+static inline __m128i qt_unpremultiply_sse2(__m128i v, uint f0, uint f1)
+{
+    const short h0 = f0 >> 16;
+    const short h1 = f1 >> 16;
+    const short l0 = f0 & 0xffff;
+    const short l1 = f1 & 0xffff;
+    const __m128i high = _mm_set_epi16(1, h1, h1, h1, 1, h0, h0, h0);
+    const __m128i low = _mm_set_epi16(0, l1, l1, l1, 0, l0, l0, l0);
+    return _mm_add_epi16(_mm_mullo_epi16(v, high), _mm_mulhi_epu16(v, low));
+}
+
+template <bool opaque>
+static inline void qt_convert_ARGB_PM_sse2(uint *dest, const uint *src, int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(0xff000000);
+    const __m128i result_alpha = opaque ? alphaMask : zero;
+
+    int i = 0;
+    for (; i < count - 3; i += 4) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i alpha = _mm_and_si128(v, alphaMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask)) == 0xffff) {
+            _mm_storeu_si128((__m128i *)(dest + i), v);
+            continue;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xffff) {
+            _mm_storeu_si128((__m128i *)(dest + i), result_alpha);
+            continue;
+        }
+
+        const uint *s = src + i;
+        const __m128i lo = qt_unpremultiply_sse2(_mm_unpacklo_epi8(v, zero),
+                                                 qt_inv_premul_factor[s[0] >> 24],
+                                                 qt_inv_premul_factor[s[1] >> 24]);
+        const __m128i hi = qt_unpremultiply_sse2(_mm_unpackhi_epi8(v, zero),
+                                                 qt_inv_premul_factor[s[2] >> 24],
+                                                 qt_inv_premul_factor[s[3] >> 24]);
+
+        // a channel larger than its alpha is not valid premultiplied
+        // data, let INV_PREMUL() deal with it
+        const __m128i overflow = _mm_srli_epi16(_mm_or_si128(lo, hi), 8);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(overflow, zero)) != 0xffff) {
+            for (int j = i; j < i + 4; ++j)
+                dest[j] = opaque ? 0xff000000 | INV_PREMUL(src[j]) : INV_PREMUL(src[j]);
+            continue;
+        }
+
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_or_si128(_mm_packus_epi16(lo, hi), result_alpha));
+    }
+
+    for (; i < count; ++i)
+        dest[i] = opaque ? 0xff000000 | INV_PREMUL(src[i]) : INV_PREMUL(src[i]);
+}
+
+void qt_convert_ARGB_PM_to_ARGB_sse2(uint *dest, const uint *src, int count)
+{
+    qt_convert_ARGB_PM_sse2<false>(dest, src, count);
+}
+
+void qt_convert_ARGB_PM_to_RGB_sse2(uint *dest, const uint *src, int count)
+{
+    qt_convert_ARGB_PM_sse2<true>(dest, src, count);
+}
+
+void qt_mask_alpha_sse2(uint *dest, const uint *src, int count)
+{
+    const __m128i alphaMask = _mm_set1_epi32(0xff000000);
+
+    int i = 0;
+    for (; i < count - 3; i += 4) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_or_si128(v, alphaMask));
+    }
+
+    for (; i < count; ++i)
+        dest[i] = src[i] | 0xff000000;
+}
+
+static inline __m128i qt_convertRgb16To32_sse2(__m128i c)
+{
+    const __m128i b = _mm_or_si128(_mm_and_si128(_mm_slli_epi32(c, 3), _mm_set1_epi32(0xf8)),
+                                   _mm_and_si128(_mm_srli_epi32(c, 2), _mm_set1_epi32(0x7)));
+    const __m128i g = _mm_or_si128(_mm_and_si128(_mm_slli_epi32(c, 5), _mm_set1_epi32(0xfc00)),
+                                   _mm_and_si128(_mm_srli_epi32(c, 1), _mm_set1_epi32(0x300)));
+    const __m128i r = _mm_or_si128(_mm_and_si128(_mm_slli_epi32(c, 8), _mm_set1_epi32(0xf80000)),
+                                   _mm_and_si128(_mm_slli_epi32(c, 3), _mm_set1_epi32(0x70000)));
+    return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, _mm_set1_epi32(0xff000000)));
+}
+
+void qt_convert_RGB16_to_RGB_sse2(uint *dest, const ushort *src, int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    int i = 0;
+    for (; i < count - 7; i += 8) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dest + i), qt_convertRgb16To32_sse2(_mm_unpacklo_epi16(v, zero)));
+        _mm_storeu_si128((__m128i *)(dest + i + 4), qt_convertRgb16To32_sse2(_mm_unpackhi_epi16(v, zero)));
+    }
+
+    for (; i < count; ++i)
+        dest[i] = qConvertRgb16To32(src[i]);
+}
+
+static inline __m128i qt_convertRgb32To16_sse2(__m128i c)
+{
+    const __m128i v = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(c, 3), _mm_set1_epi32(0x001f)),
+                                                 _mm_and_si128(_mm_srli_epi32(c, 5), _mm_set1_epi32(0x07e0))),
+                                   _mm_and_si128(_mm_srli_epi32(c, 8), _mm_set1_epi32(0xf800)));
+    // sign extend so that the saturating pack keeps all 16 bits
+    return _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+}
+
+void qt_convert_RGB_to_RGB16_sse2(ushort *dest, const uint *src, int count)
+{
+    int i = 0;
+    for (; i < count - 7; i += 8) {
+        const __m128i lo = qt_convertRgb32To16_sse2(_mm_loadu_si128((const __m128i *)(src + i)));
+        const __m128i hi = qt_convertRgb32To16_sse2(_mm_loadu_si128((const __m128i *)(src + i + 4)));
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_packs_epi32(lo, hi));
+    }
+
+    for (; i < count; ++i)
+        dest[i] = qConvertRgb32To16(src[i]);
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_HAVE_SSE2
@@ -59,6 +59,9 @@
 #  include "qguieventdispatcher_glib_p.h"
 #endif
 #include "qeventdispatcher_x11_p.h"
+#if defined(Q_OS_LINUX)
+#  include <private/qeventdispatcher_epoll_p.h>
+#endif
 #include <private/qpaintengine_x11_p.h>
 
 #include <private/qkeymapper_p.h>
@@ -401,9 +404,15 @@ void QApplicationPrivate::createEventDispatcher()
                            : new QEventDispatcherGlib(q));
     else
 #endif
-        eventDispatcher = (q->type() != QApplication::Tty
-                           ? new QEventDispatcherX11(q)
-                           : new QEventDispatcherUNIX(q));
+    if (q->type() != QApplication::Tty)
+        eventDispatcher = new QEventDispatcherX11(q);
+    else
+#if defined(Q_OS_LINUX)
+    if (qgetenv("QT_NO_EPOLL").isEmpty() && QEventDispatcherEPoll::isSupported())
+        eventDispatcher = new QEventDispatcherEPoll(q);
+    else
+#endif
+        eventDispatcher = new QEventDispatcherUNIX(q);
 }
 
 /*****************************************************************************
@@ -177,7 +177,8 @@ mac {
     }
     sse2 {
 	DEFINES += QT_HAVE_SSE2
-	SSE2_SOURCES += painting/qdrawhelper_sse2.cpp
+	SSE2_SOURCES += painting/qdrawhelper_sse2.cpp \
+			painting/qimagescale_sse2.cpp
     }
     iwmmxt {
 	DEFINES += QT_HAVE_IWMMXT
@@ -15,6 +15,7 @@
 #include <private/qpainter_p.h>
 #include <private/qmath_p.h>
 #include <private/qdrawhelper_x86_p.h>
+#include <private/qsimd_p.h>
 #include <math.h>
 
 QT_BEGIN_NAMESPACE
@@ -41,6 +42,47 @@ static const int fixed_scale = 1 << 16;
 static const int half_point = 1 << 15;
 static const int buffer_size = 2048;
 
+/*
+  The unpremultiply factors, ceil(255 * 2^16 / alpha). For any channel
+  value c in 0..255, (c * qt_inv_premul_factor[alpha]) >> 16 equals
+  (255 * c) / alpha, so INV_PREMUL() gives exactly the same result as
+  dividing.
+*/
+const uint qt_inv_premul_factor[256] = {
+    0, 16711680, 8355840, 5570560, 4177920, 3342336, 2785280, 2387383,
+    2088960, 1856854, 1671168, 1519244, 1392640, 1285514, 1193692, 1114112,
+    1044480, 983040, 928427, 879563, 835584, 795795, 759622, 726595,
+    696320, 668468, 642757, 618952, 596846, 576265, 557056, 539087,
+    522240, 506415, 491520, 477477, 464214, 451668, 439782, 428505,
+    417792, 407602, 397898, 388644, 379811, 371371, 363298, 355568,
+    348160, 341055, 334234, 327680, 321379, 315315, 309476, 303849,
+    298423, 293188, 288133, 283249, 278528, 273962, 269544, 265265,
+    261120, 257103, 253208, 249429, 245760, 242199, 238739, 235376,
+    232107, 228928, 225834, 222823, 219891, 217035, 214253, 211541,
+    208896, 206318, 203801, 201346, 198949, 196608, 194322, 192089,
+    189906, 187772, 185686, 183645, 181649, 179696, 177784, 175913,
+    174080, 172286, 170528, 168805, 167117, 165463, 163840, 162250,
+    160690, 159159, 157658, 156184, 154738, 153319, 151925, 150556,
+    149212, 147891, 146594, 145319, 144067, 142835, 141625, 140435,
+    139264, 138114, 136981, 135868, 134772, 133694, 132633, 131589,
+    130560, 129548, 128552, 127571, 126604, 125652, 124715, 123791,
+    122880, 121984, 121100, 120228, 119370, 118523, 117688, 116865,
+    116054, 115253, 114464, 113685, 112917, 112159, 111412, 110674,
+    109946, 109227, 108518, 107818, 107127, 106444, 105771, 105105,
+    104448, 103800, 103159, 102526, 101901, 101283, 100673, 100070,
+    99475, 98886, 98304, 97730, 97161, 96600, 96045, 95496,
+    94953, 94417, 93886, 93362, 92843, 92330, 91823, 91321,
+    90825, 90334, 89848, 89368, 88892, 88422, 87957, 87496,
+    87040, 86590, 86143, 85701, 85264, 84831, 84403, 83979,
+    83559, 83143, 82732, 82324, 81920, 81521, 81125, 80733,
+    80345, 79961, 79580, 79203, 78829, 78459, 78092, 77729,
+    77369, 77013, 76660, 76310, 75963, 75619, 75278, 74941,
+    74606, 74275, 73946, 73620, 73297, 72977, 72660, 72345,
+    72034, 71724, 71418, 71114, 70813, 70514, 70218, 69924,
+    69632, 69344, 69057, 68773, 68491, 68211, 67934, 67659,
+    67386, 67116, 66847, 66581, 66317, 66055, 65795, 65536
+};
+
 struct LinearGradientValues
 {
     qreal dx;
@@ -334,6 +376,25 @@ static const FetchPixelProc fetchPixelProc[QImage::NImageFormats] =
     fetchPixel_RGB16
 };
 
+/*
+  The transformed fetches are templates on the source format, so that
+  the 32 bit formats get an inlined pixel fetch. Format_Invalid is used
+  for the generic version that calls through fetchPixelProc.
+*/
+template <QImage::Format format>
+static inline uint fetchPixel(FetchPixelProc fetch, const uchar *scanLine, int x,
+                              const QVector<QRgb> *rgb)
+{
+    switch (format) {
+    case QImage::Format_RGB32:
+        return fetchPixel_RGB32(scanLine, x, rgb);
+    case QImage::Format_ARGB32_Premultiplied:
+        return fetchPixel_ARGB32_Premultiplied(scanLine, x, rgb);
+    default:
+        return fetch(scanLine, x, rgb);
+    }
+}
+
 enum TextureBlendType {
     BlendUntransformed,
     BlendTiled,
@@ -354,7 +415,82 @@ static const uint * QT_FASTCALL fetch_generic(uint *buffer, const Operator *, co
     return buffer;
 }
 
-static const uint * QT_FASTCALL fetchTransformed_generic(uint *buffer, const Operator *, const QSpanData *data,
+static void QT_FASTCALL fetchTransformedBilinear_affine32(uint *buffer, int length,
+                                                          const QTextureData &texture,
+                                                          int fx, int fy, int fdx, int fdy)
+{
+    const int image_width = texture.width;
+    const int image_height = texture.height;
+
+    const uint *end = buffer + length;
+    uint *b = buffer;
+
+    if (!fdy) {
+        // scaled, but not rotated, so every pixel comes from the same two scanlines
+        int y1 = (fy >> 16);
+        int y2 = y1 + 1;
+        const int disty = ((fy - (y1 << 16)) >> 8);
+        const int idisty = 256 - disty;
+
+        y1 = qBound(0, y1, image_height - 1);
+        y2 = qBound(0, y2, image_height - 1);
+
+        const uint *s1 = (const uint *)texture.scanLine(y1);
+        const uint *s2 = (const uint *)texture.scanLine(y2);
+
+        while (b < end) {
+            int x1 = (fx >> 16);
+            int x2 = x1 + 1;
+
+            const int distx = ((fx - (x1 << 16)) >> 8);
+            const int idistx = 256 - distx;
+
+            x1 = qBound(0, x1, image_width - 1);
+            x2 = qBound(0, x2, image_width - 1);
+
+            uint xtop = INTERPOLATE_PIXEL_256(s1[x1], idistx, s1[x2], distx);
+            uint xbot = INTERPOLATE_PIXEL_256(s2[x1], idistx, s2[x2], distx);
+            *b = INTERPOLATE_PIXEL_256(xtop, idisty, xbot, disty);
+
+            fx += fdx;
+            ++b;
+        }
+        return;
+    }
+
+    while (b < end) {
+        int x1 = (fx >> 16);
+        int x2 = x1 + 1;
+        int y1 = (fy >> 16);
+        int y2 = y1 + 1;
+
+        int distx = ((fx - (x1 << 16)) >> 8);
+        int disty = ((fy - (y1 << 16)) >> 8);
+        int idistx = 256 - distx;
+        int idisty = 256 - disty;
+
+        x1 = qBound(0, x1, image_width - 1);
+        x2 = qBound(0, x2, image_width - 1);
+        y1 = qBound(0, y1, image_height - 1);
+        y2 = qBound(0, y2, image_height - 1);
+
+        const uint *s1 = (const uint *)texture.scanLine(y1);
+        const uint *s2 = (const uint *)texture.scanLine(y2);
+
+        uint xtop = INTERPOLATE_PIXEL_256(s1[x1], idistx, s1[x2], distx);
+        uint xbot = INTERPOLATE_PIXEL_256(s2[x1], idistx, s2[x2], distx);
+        *b = INTERPOLATE_PIXEL_256(xtop, idisty, xbot, disty);
+
+        fx += fdx;
+        fy += fdy;
+        ++b;
+    }
+}
+
+BilinearFetchFunc qt_fetch_bilinear_affine32 = fetchTransformedBilinear_affine32;
+
+template <QImage::Format format>
+static const uint * QT_FASTCALL fetchTransformed(uint *buffer, const Operator *, const QSpanData *data,
                                                          int y, int x, int length)
 {
     FetchPixelProc fetch = fetchPixelProc[data->texture.format];
@@ -383,7 +519,7 @@ static const uint * QT_FASTCALL fetchTransformed_generic(uint *buffer, const Ope
                        || (py < 0) || (py >= image_height);
 
             const uchar *scanLine = data->texture.scanLine(py);
-            *b = out ? uint(0) : fetch(scanLine, px, data->texture.colorTable);
+            *b = out ? uint(0) : fetchPixel<format>(fetch, scanLine, px, data->texture.colorTable);
             fx += fdx;
             fy += fdy;
             ++b;
@@ -402,7 +538,7 @@ static const uint * QT_FASTCALL fetchTransformed_generic(uint *buffer, const Ope
                        || (py < 0) || (py >= image_height);
 
             const uchar *scanLine = data->texture.scanLine(py);
-            *b = out ? uint(0) : fetch(scanLine, px, data->texture.colorTable);
+            *b = out ? uint(0) : fetchPixel<format>(fetch, scanLine, px, data->texture.colorTable);
             fx += fdx;
             fy += fdy;
             fw += fdw;
@@ -417,7 +553,8 @@ static const uint * QT_FASTCALL fetchTransformed_generic(uint *buffer, const Ope
     return buffer;
 }
 
-static const uint * QT_FASTCALL fetchTransformedTiled_generic(uint *buffer, const Operator *, const QSpanData *data,
+template <QImage::Format format>
+static const uint * QT_FASTCALL fetchTransformedTiled(uint *buffer, const Operator *, const QSpanData *data,
                                                               int y, int x, int length)
 {
     FetchPixelProc fetch = fetchPixelProc[data->texture.format];
@@ -448,7 +585,7 @@ static const uint * QT_FASTCALL fetchTransformedTiled_generic(uint *buffer, cons
             if (py < 0) py += image_height;
 
             const uchar *scanLine = data->texture.scanLine(py);
-            *b = fetch(scanLine, px, data->texture.colorTable);
+            *b = fetchPixel<format>(fetch, scanLine, px, data->texture.colorTable);
             fx += fdx;
             fy += fdy;
             ++b;
@@ -469,7 +606,7 @@ static const uint * QT_FASTCALL fetchTransformedTiled_generic(uint *buffer, cons
             if (py < 0) py += image_height;
 
             const uchar *scanLine = data->texture.scanLine(py);
-            *b = fetch(scanLine, px, data->texture.colorTable);
+            *b = fetchPixel<format>(fetch, scanLine, px, data->texture.colorTable);
             fx += fdx;
             fy += fdy;
             fw += fdw;
@@ -484,7 +621,8 @@ static const uint * QT_FASTCALL fetchTransformedTiled_generic(uint *buffer, cons
     return buffer;
 }
 
-static const uint * QT_FASTCALL fetchTransformedBilinear_generic(uint *buffer, const Operator *, const QSpanData *data,
+template <QImage::Format format>
+static const uint * QT_FASTCALL fetchTransformedBilinear(uint *buffer, const Operator *, const QSpanData *data,
                                                                  int y, int x, int length)
 {
     FetchPixelProc fetch = fetchPixelProc[data->texture.format];
@@ -504,7 +642,13 @@ static const uint * QT_FASTCALL fetchTransformedBilinear_generic(uint *buffer, c
 
     const uint *end = buffer + length;
     uint *b = buffer;
-    if (affine) {
+    if (affine && format == QImage::Format_ARGB32_Premultiplied) {
+        qt_fetch_bilinear_affine32(buffer, length, data->texture, fx, fy, fdx, fdy);
+    } else if (affine && format == QImage::Format_RGB32) {
+        qt_fetch_bilinear_affine32(buffer, length, data->texture, fx, fy, fdx, fdy);
+        for (int i = 0; i < length; ++i)
+            buffer[i] |= 0xff000000;
+    } else if (affine) {
         while (b < end) {
             int x1 = (fx >> 16);
             int x2 = x1 + 1;
@@ -524,10 +668,10 @@ static const uint * QT_FASTCALL fetchTransformedBilinear_generic(uint *buffer, c
             const uchar *s1 = data->texture.scanLine(y1);
             const uchar *s2 = data->texture.scanLine(y2);
 
-            uint tl = fetch(s1, x1, data->texture.colorTable);
-            uint tr = fetch(s1, x2, data->texture.colorTable);
-            uint bl = fetch(s2, x1, data->texture.colorTable);
-            uint br = fetch(s2, x2, data->texture.colorTable);
+            uint tl = fetchPixel<format>(fetch, s1, x1, data->texture.colorTable);
+            uint tr = fetchPixel<format>(fetch, s1, x2, data->texture.colorTable);
+            uint bl = fetchPixel<format>(fetch, s2, x1, data->texture.colorTable);
+            uint br = fetchPixel<format>(fetch, s2, x2, data->texture.colorTable);
 
             uint xtop = INTERPOLATE_PIXEL_256(tl, idistx, tr, distx);
             uint xbot = INTERPOLATE_PIXEL_256(bl, idistx, br, distx);
@@ -562,10 +706,10 @@ static const uint * QT_FASTCALL fetchTransformedBilinear_generic(uint *buffer, c
             const uchar *s1 = data->texture.scanLine(y1);
             const uchar *s2 = data->texture.scanLine(y2);
 
-            uint tl = fetch(s1, x1, data->texture.colorTable);
-            uint tr = fetch(s1, x2, data->texture.colorTable);
-            uint bl = fetch(s2, x1, data->texture.colorTable);
-            uint br = fetch(s2, x2, data->texture.colorTable);
+            uint tl = fetchPixel<format>(fetch, s1, x1, data->texture.colorTable);
+            uint tr = fetchPixel<format>(fetch, s1, x2, data->texture.colorTable);
+            uint bl = fetchPixel<format>(fetch, s2, x1, data->texture.colorTable);
+            uint br = fetchPixel<format>(fetch, s2, x2, data->texture.colorTable);
 
             uint xtop = INTERPOLATE_PIXEL_256(tl, idistx, tr, distx);
             uint xbot = INTERPOLATE_PIXEL_256(bl, idistx, br, distx);
@@ -585,7 +729,8 @@ static const uint * QT_FASTCALL fetchTransformedBilinear_generic(uint *buffer, c
     return buffer;
 }
 
-static const uint * QT_FASTCALL fetchTransformedBilinearTiled_generic(uint *buffer, const Operator *, const QSpanData *data,
+template <QImage::Format format>
+static const uint * QT_FASTCALL fetchTransformedBilinearTiled(uint *buffer, const Operator *, const QSpanData *data,
                                                                      int y, int x, int length)
 {
     FetchPixelProc fetch = fetchPixelProc[data->texture.format];
@@ -635,10 +780,10 @@ static const uint * QT_FASTCALL fetchTransformedBilinearTiled_generic(uint *buff
             const uchar *s1 = data->texture.scanLine(y1);
             const uchar *s2 = data->texture.scanLine(y2);
 
-            uint tl = fetch(s1, x1, data->texture.colorTable);
-            uint tr = fetch(s1, x2, data->texture.colorTable);
-            uint bl = fetch(s2, x1, data->texture.colorTable);
-            uint br = fetch(s2, x2, data->texture.colorTable);
+            uint tl = fetchPixel<format>(fetch, s1, x1, data->texture.colorTable);
+            uint tr = fetchPixel<format>(fetch, s1, x2, data->texture.colorTable);
+            uint bl = fetchPixel<format>(fetch, s2, x1, data->texture.colorTable);
+            uint br = fetchPixel<format>(fetch, s2, x2, data->texture.colorTable);
 
             uint xtop = INTERPOLATE_PIXEL_256(tl, idistx, tr, distx);
             uint xbot = INTERPOLATE_PIXEL_256(bl, idistx, br, distx);
@@ -683,10 +828,10 @@ static const uint * QT_FASTCALL fetchTransformedBilinearTiled_generic(uint *buff
             const uchar *s1 = data->texture.scanLine(y1);
             const uchar *s2 = data->texture.scanLine(y2);
 
-            uint tl = fetch(s1, x1, data->texture.colorTable);
-            uint tr = fetch(s1, x2, data->texture.colorTable);
-            uint bl = fetch(s2, x1, data->texture.colorTable);
-            uint br = fetch(s2, x2, data->texture.colorTable);
+            uint tl = fetchPixel<format>(fetch, s1, x1, data->texture.colorTable);
+            uint tr = fetchPixel<format>(fetch, s1, x2, data->texture.colorTable);
+            uint bl = fetchPixel<format>(fetch, s2, x1, data->texture.colorTable);
+            uint br = fetchPixel<format>(fetch, s2, x2, data->texture.colorTable);
 
             uint xtop = INTERPOLATE_PIXEL_256(tl, idistx, tr, distx);
             uint xbot = INTERPOLATE_PIXEL_256(bl, idistx, br, distx);
@@ -733,43 +878,43 @@ static const SourceFetchProc sourceFetch[NBlendTypes][QImage::NImageFormats] = {
     // Transformed
     {
         0, // Invalid
-        fetchTransformed_generic,   // Mono
-        fetchTransformed_generic,   // MonoLsb
-        fetchTransformed_generic,   // Indexed8
-        fetchTransformed_generic,   // RGB32
-        fetchTransformed_generic,   // ARGB32
-        fetchTransformed_generic,   // ARGB32_Premultiplied
-        fetchTransformed_generic    // RGB16
+        fetchTransformed<QImage::Format_Invalid>,   // Mono
+        fetchTransformed<QImage::Format_Invalid>,   // MonoLsb
+        fetchTransformed<QImage::Format_Invalid>,   // Indexed8
+        fetchTransformed<QImage::Format_RGB32>,   // RGB32
+        fetchTransformed<QImage::Format_Invalid>,   // ARGB32
+        fetchTransformed<QImage::Format_ARGB32_Premultiplied>,   // ARGB32_Premultiplied
+        fetchTransformed<QImage::Format_Invalid>    // RGB16
     },
     {
         0, // TransformedTiled
-        fetchTransformedTiled_generic,   // Mono
-        fetchTransformedTiled_generic,   // MonoLsb
-        fetchTransformedTiled_generic,   // Indexed8
-        fetchTransformedTiled_generic,   // RGB32
-        fetchTransformedTiled_generic,   // ARGB32
-        fetchTransformedTiled_generic,   // ARGB32_Premultiplied
-        fetchTransformedTiled_generic    // RGB16
+        fetchTransformedTiled<QImage::Format_Invalid>,   // Mono
+        fetchTransformedTiled<QImage::Format_Invalid>,   // MonoLsb
+        fetchTransformedTiled<QImage::Format_Invalid>,   // Indexed8
+        fetchTransformedTiled<QImage::Format_RGB32>,   // RGB32
+        fetchTransformedTiled<QImage::Format_Invalid>,   // ARGB32
+        fetchTransformedTiled<QImage::Format_ARGB32_Premultiplied>,   // ARGB32_Premultiplied
+        fetchTransformedTiled<QImage::Format_Invalid>    // RGB16
     },
     {
         0, // Bilinear
-        fetchTransformedBilinear_generic,   // Mono
-        fetchTransformedBilinear_generic,   // MonoLsb
-        fetchTransformedBilinear_generic,   // Indexed8
-        fetchTransformedBilinear_generic,   // RGB32
-        fetchTransformedBilinear_generic,   // ARGB32
-        fetchTransformedBilinear_generic,   // ARGB32_Premultiplied
-        fetchTransformedBilinear_generic    // RGB16
+        fetchTransformedBilinear<QImage::Format_Invalid>,   // Mono
+        fetchTransformedBilinear<QImage::Format_Invalid>,   // MonoLsb
+        fetchTransformedBilinear<QImage::Format_Invalid>,   // Indexed8
+        fetchTransformedBilinear<QImage::Format_RGB32>,   // RGB32
+        fetchTransformedBilinear<QImage::Format_Invalid>,   // ARGB32
+        fetchTransformedBilinear<QImage::Format_ARGB32_Premultiplied>,   // ARGB32_Premultiplied
+        fetchTransformedBilinear<QImage::Format_Invalid>    // RGB16
     },
     {
         0, // BilinearTiled
-        fetchTransformedBilinearTiled_generic,   // Mono
-        fetchTransformedBilinearTiled_generic,   // MonoLsb
-        fetchTransformedBilinearTiled_generic,   // Indexed8
-        fetchTransformedBilinearTiled_generic,   // RGB32
-        fetchTransformedBilinearTiled_generic,   // ARGB32
-        fetchTransformedBilinearTiled_generic,   // ARGB32_Premultiplied
-        fetchTransformedBilinearTiled_generic    // RGB16
+        fetchTransformedBilinearTiled<QImage::Format_Invalid>,   // Mono
+        fetchTransformedBilinearTiled<QImage::Format_Invalid>,   // MonoLsb
+        fetchTransformedBilinearTiled<QImage::Format_Invalid>,   // Indexed8
+        fetchTransformedBilinearTiled<QImage::Format_RGB32>,   // RGB32
+        fetchTransformedBilinearTiled<QImage::Format_Invalid>,   // ARGB32
+        fetchTransformedBilinearTiled<QImage::Format_ARGB32_Premultiplied>,   // ARGB32_Premultiplied
+        fetchTransformedBilinearTiled<QImage::Format_Invalid>    // RGB16
     },
 };
 
@@ -3444,7 +3589,6 @@ static void blend_transformed_bilinear_argb(int count, const QSpan *spans, void
             void *t = data->rasterBuffer->scanLine(spans->y);
 
             uint *target = ((uint *)t) + spans->x;
-            uint *image_bits = (uint *)data->texture.imageData;
             int x = int((data->m21 * (spans->y + 0.5)
                          + data->m11 * (spans->x + 0.5) + data->dx) * fixed_scale) - half_point;
             int y = int((data->m22 * (spans->y + 0.5)
@@ -3454,47 +3598,9 @@ static void blend_transformed_bilinear_argb(int count, const QSpan *spans, void
             const int coverage = (data->texture.const_alpha * spans->coverage) >> 8;
             while (length) {
                 int l = qMin(length, buffer_size);
-                const uint *end = buffer + l;
-                uint *b = buffer;
-                while (b < end) {
-                    int x1 = (x >> 16);
-                    int x2 = x1 + 1;
-                    int y1 = (y >> 16);
-                    int y2 = y1 + 1;
-
-                    int distx = ((x - (x1 << 16)) >> 8);
-                    int disty = ((y - (y1 << 16)) >> 8);
-                    int idistx = 256 - distx;
-                    int idisty = 256 - disty;
-
-                    x1 = qBound(0, x1, image_width - 1);
-                    x2 = qBound(0, x2, image_width - 1);
-                    y1 = qBound(0, y1, image_height - 1);
-                    y2 = qBound(0, y2, image_height - 1);
-
-                    int y1_offset = y1 * image_width;
-                    int y2_offset = y2 * image_width;
-
-#if defined(Q_IRIX_GCC3_3_WORKAROUND)
-                    uint tl = gccBug(image_bits[y1_offset + x1]);
-                    uint tr = gccBug(image_bits[y1_offset + x2]);
-                    uint bl = gccBug(image_bits[y2_offset + x1]);
-                    uint br = gccBug(image_bits[y2_offset + x2]);
-#else
-                    uint tl = image_bits[y1_offset + x1];
-                    uint tr = image_bits[y1_offset + x2];
-                    uint bl = image_bits[y2_offset + x1];
-                    uint br = image_bits[y2_offset + x2];
-#endif
-
-                    uint xtop = INTERPOLATE_PIXEL_256(tl, idistx, tr, distx);
-                    uint xbot = INTERPOLATE_PIXEL_256(bl, idistx, br, distx);
-                    *b = INTERPOLATE_PIXEL_256(xtop, idisty, xbot, disty);
-                    ++b;
-
-                    x += fdx;
-                    y += fdy;
-                }
+                qt_fetch_bilinear_affine32(buffer, l, data->texture, x, y, fdx, fdy);
+                x += l * fdx;
+                y += l * fdy;
                 func(target, buffer, l, coverage);
                 target += l;
                 length -= l;
@@ -5055,176 +5161,12 @@ static void qt_memfill16_setup(quint16 *dest, quint16 value, int count);
 qt_memfill32_func qt_memfill32 = qt_memfill32_setup;
 qt_memfill16_func qt_memfill16 = qt_memfill16_setup;
 
-enum CPUFeatures {
-    None        = 0,
-    MMX         = 0x1,
-    MMXEXT      = 0x2,
-    MMX3DNOW    = 0x4,
-    MMX3DNOWEXT = 0x8,
-    SSE         = 0x10,
-    SSE2        = 0x20,
-    CMOV        = 0x40,
-    IWMMXT      = 0x80
-};
-
-static uint detectCPUFeatures() {
-#if defined(__x86_64__) || defined(Q_OS_WIN64)
-    return MMX|SSE|SSE2|CMOV;
-#elif defined(__ia64__)
-    return MMX|SSE|SSE2;
-#elif defined(QT_HAVE_IWMMXT)
-    // runtime detection only available when running as a previlegied process
-    static const bool doIWMMXT = !qgetenv("QT_NO_IWMMXT").toInt();
-    return doIWMMXT ? IWMMXT : 0;
-#elif defined(__i386__) || defined(_M_IX86)
-    unsigned int extended_result = 0;
-    uint result = 0;
-    /* see p. 118 of amd64 instruction set manual Vol3 */
-#if defined(Q_CC_GNU)
-    asm ("push %%ebx\n"
-         "pushf\n"
-         "pop %%eax\n"
-         "mov %%eax, %%ebx\n"
-         "xor $0x00200000, %%eax\n"
-         "push %%eax\n"
-         "popf\n"
-         "pushf\n"
-         "pop %%eax\n"
-         "xor %%edx, %%edx\n"
-         "xor %%ebx, %%eax\n"
-         "jz 1f\n"
-
-         "mov $0x00000001, %%eax\n"
-         "cpuid\n"
-         "1:\n"
-         "pop %%ebx\n"
-         "mov %%edx, %0\n"
-        : "=r" (result)
-        :
-        : "%eax", "%ecx", "%edx"
-        );
-
-    asm ("push %%ebx\n"
-         "pushf\n"
-         "pop %%eax\n"
-         "mov %%eax, %%ebx\n"
-         "xor $0x00200000, %%eax\n"
-         "push %%eax\n"
-         "popf\n"
-         "pushf\n"
-         "pop %%eax\n"
-         "xor %%edx, %%edx\n"
-         "xor %%ebx, %%eax\n"
-         "jz 2f\n"
-
-         "mov $0x80000000, %%eax\n"
-         "cpuid\n"
-	 "cmp $0x80000000, %%eax\n"
-	 "jbe 2f\n"
-	 "mov $0x80000001, %%eax\n"
-	 "cpuid\n"
-         "2:\n"
-         "pop %%ebx\n"
-         "mov %%edx, %0\n"
-        : "=r" (extended_result)
-        :
-        : "%eax", "%ecx", "%edx"
-        );
-#elif defined (Q_OS_WIN)
-    _asm {
-	push eax
-	push ebx
-	push ecx
-	push edx
-	pushfd
-	pop eax
-	mov ebx, eax
-	xor eax, 00200000h
-	push eax
-	popfd
-	pushfd
-        pop eax
-	mov edx, 0
-	xor eax, ebx
-	jz skip
-
-	mov eax, 1
-	cpuid
-	mov result, edx
-    skip:
-        pop edx
-	pop ecx
-	pop ebx
-	pop eax
-    }
-
-    _asm {
-	push eax
-	push ebx
-	push ecx
-	push edx
-	pushfd
-	pop eax
-	mov ebx, eax
-	xor eax, 00200000h
-	push eax
-	popfd
-	pushfd
-        pop eax
-	mov edx, 0
-	xor eax, ebx
-	jz skip2
-
-	mov eax, 80000000h
-	cpuid
-        cmp eax, 80000000h
-        jbe skip2
-        mov eax, 80000001h
-        cpuid
-	mov extended_result, edx
-    skip2:
-        pop edx
-	pop ecx
-	pop ebx
-	pop eax
-    }
-#endif
-
-    static const bool doMMX = !qgetenv("QT_NO_MMX").toInt();
-    static const bool doMMXEXT = !qgetenv("QT_NO_MMXEXT").toInt();
-    static const bool do3DNOW = !qgetenv("QT_NO_3DNOW").toInt();
-    static const bool do3DNOWEXT = !qgetenv("QT_NO_3DNOWEXT").toInt();
-    static const bool doSSE = !qgetenv("QT_NO_SSE").toInt();
-    static const bool doSSE2 = !qgetenv("QT_NO_SSE2").toInt();
-
-    uint features = 0;
-    // result now contains the standard feature bits
-    if (result & (1 << 15))
-        features |= CMOV;
-    if (doMMX && (result & (1 << 23)))
-        features |= MMX;
-    if (doMMXEXT && (extended_result & (1 << 22)))
-        features |= MMXEXT;
-    if (do3DNOW && (extended_result & (1 << 31)))
-        features |= MMX3DNOW;
-    if (do3DNOWEXT && (extended_result & (1 << 30)))
-        features |= MMX3DNOWEXT;
-    if (doSSE && (result & (1 << 25)))
-        features |= SSE;
-    if (doSSE2 && (result & (1 << 26)))
-        features |= SSE2;
-    return features;
-#else
-    return 0;
-#endif
-}
-
 void qInitDrawhelperAsm()
 {
     static uint features = 0xffffffff;
     if (features != 0xffffffff)
         return;
-    features = detectCPUFeatures();
+    features = qDetectCPUFeatures();
 
     qt_memfill32 = qt_memfill_template<quint32, quint32>;
     qt_memfill16 = qt_memfill_quint16; //qt_memfill_template<quint16, quint16>;
@@ -5296,6 +5238,15 @@ void qInitDrawhelperAsm()
     }
 #endif // SSE
 
+#ifdef QT_HAVE_SSE2
+    if (features & SSE2) {
+        functionForModeAsm = qt_functionForMode_SSE2;
+        functionForModeSolidAsm = qt_functionForModeSolid_SSE2;
+        qDrawHelper[QImage::Format_ARGB32_Premultiplied].blendColor = qt_blend_color_argb_sse2;
+        qt_fetch_bilinear_affine32 = qt_fetch_bilinear_affine32_sse2;
+    }
+#endif // SSE2
+
 #ifdef QT_HAVE_IWMMXT
     if (features & IWMMXT) {
         functionForModeAsm = qt_functionForMode_IWMMXT;
@@ -5310,10 +5261,13 @@ void qInitDrawhelperAsm()
         Q_ASSERT(functionForModeAsm != 0);
         Q_ASSERT(functionForModeSolidAsm != 0);
 
-        // use the default qdrawhelper implementation for the extended composition modes
+        // use the default qdrawhelper implementation for the extended
+        // composition modes that have no optimized version
         for (int mode = 12; mode < numCompositionFunctions; ++mode) {
-            functionForModeAsm[mode] = functionForMode_C[mode];
-            functionForModeSolidAsm[mode] = functionForModeSolid_C[mode];
+            if (!functionForModeAsm[mode])
+                functionForModeAsm[mode] = functionForMode_C[mode];
+            if (!functionForModeSolidAsm[mode])
+                functionForModeSolidAsm[mode] = functionForModeSolid_C[mode];
         }
 
         functionForMode = functionForModeAsm;
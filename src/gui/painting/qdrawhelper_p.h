@@ -214,6 +214,15 @@ struct QSpanData
     void adjustSpanMethods();
 };
 
+/*
+  Fills buffer with length pixels sampled bilinearly from a 32 bit
+  texture along the affine line starting at (fx, fy) and stepping by
+  (fdx, fdy), all in 16.16 fixed point.
+*/
+typedef void QT_FASTCALL (*BilinearFetchFunc)(uint *buffer, int length, const QTextureData &texture,
+                                              int fx, int fy, int fdx, int fdy);
+extern BilinearFetchFunc qt_fetch_bilinear_affine32;
+
 template <class DST, class SRC>
 inline DST qt_colorConvert(SRC color, DST dummy)
 {
@@ -570,12 +579,18 @@ static inline uint PREMUL(uint x) {
 }
 #endif
 
-#define INV_PREMUL(p)                                   \
-    (qAlpha(p) == 0 ? 0 :                               \
-    ((qAlpha(p) << 24)                                  \
-     | (((255*qRed(p))/ qAlpha(p)) << 16)               \
-     | (((255*qGreen(p)) / qAlpha(p))  << 8)            \
-     | ((255*qBlue(p)) / qAlpha(p))))
+extern const uint qt_inv_premul_factor[256];
+
+static inline uint INV_PREMUL(uint p) {
+    const uint a = qAlpha(p);
+    if (!a)
+        return 0;
+    const uint inv = qt_inv_premul_factor[a];
+    return (a << 24)
+        | (((qRed(p) * inv) >> 16) << 16)
+        | (((qGreen(p) * inv) >> 16) << 8)
+        | ((qBlue(p) * inv) >> 16);
+}
 
 
 const uint qt_bayer_matrix[16][16] = {
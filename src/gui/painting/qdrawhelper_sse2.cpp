@@ -169,6 +169,845 @@ void qt_bitmapblit16_sse2(QRasterBuffer *rasterBuffer, int x, int y,
     }
 }
 
+/*
+  The composition functions below work on four pixels at a time. Each
+  function unpacks the pixels into 16 bit channels, two pixels per
+  register, and uses the same arithmetic as BYTE_MUL() and
+  INTERPOLATE_PIXEL_255() in qdrawhelper_p.h so that the results are
+  identical to the C versions in qdrawhelper.cpp. Functions that need
+  more than 16 bits for intermediate results widen each pixel into
+  32 bit channels.
+*/
+
+struct QSSE2Constants
+{
+    inline QSSE2Constants(uint const_alpha)
+        : zero(_mm_setzero_si128()),
+          half(_mm_set1_epi16(0x80)),
+          ff(_mm_set1_epi16(0xff)),
+          ca(_mm_set1_epi16(const_alpha)),
+          cia(_mm_set1_epi16(255 - const_alpha)),
+          alphaMask(_mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0))
+    {
+    }
+
+    const __m128i zero;
+    const __m128i half;
+    const __m128i ff;
+    const __m128i ca;
+    const __m128i cia;
+    const __m128i alphaMask;
+};
+
+static inline __m128i qt_alpha_sse2(const __m128i &x)
+{
+    const __m128i a = _mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm_shufflehi_epi16(a, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+static inline __m128i qt_negate_sse2(const __m128i &x, const QSSE2Constants &c)
+{
+    return _mm_xor_si128(x, c.ff);
+}
+
+// (t + (t >> 8) + 0x80) >> 8 for each 16 bit channel
+static inline __m128i qt_div_255_sse2(__m128i t, const QSSE2Constants &c)
+{
+    t = _mm_add_epi16(t, _mm_srli_epi16(t, 8));
+    t = _mm_add_epi16(t, c.half);
+    return _mm_srli_epi16(t, 8);
+}
+
+static inline __m128i qt_byte_mul_sse2(const __m128i &x, const __m128i &a,
+                                       const QSSE2Constants &c)
+{
+    return qt_div_255_sse2(_mm_mullo_epi16(x, a), c);
+}
+
+static inline __m128i qt_interpolate_pixel_255_sse2(const __m128i &x, const __m128i &a,
+                                                    const __m128i &y, const __m128i &b,
+                                                    const QSSE2Constants &c)
+{
+    return qt_div_255_sse2(_mm_add_epi16(_mm_mullo_epi16(x, a), _mm_mullo_epi16(y, b)), c);
+}
+
+// dest = op(dest, src) for each pixel, where op works on the 16 bit
+// channels of two pixels.
+template <typename Op>
+static inline void qt_comp_func_sse2(uint *dest, const uint *src, int length,
+                                     const Op &op, const QSSE2Constants &c)
+{
+    int i = 0;
+    for (; i < length - 3; i += 4) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<__m128i *>(dest + i));
+        const __m128i lo = op(_mm_unpacklo_epi8(d, c.zero), _mm_unpacklo_epi8(s, c.zero));
+        const __m128i hi = op(_mm_unpackhi_epi8(d, c.zero), _mm_unpackhi_epi8(s, c.zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), _mm_packus_epi16(lo, hi));
+    }
+
+    if (i < length) {
+        uint d[4];
+        uint s[4];
+        const int rest = length - i;
+        for (int j = 0; j < rest; ++j) {
+            d[j] = dest[i + j];
+            s[j] = src[i + j];
+        }
+        qt_comp_func_sse2(d, s, 4, op, c);
+        for (int j = 0; j < rest; ++j)
+            dest[i + j] = d[j];
+    }
+}
+
+template <typename Op>
+static inline void qt_comp_func_solid_sse2(uint *dest, int length, uint color,
+                                           const Op &op, const QSSE2Constants &c)
+{
+    const __m128i s = _mm_unpacklo_epi8(_mm_set1_epi32(color), c.zero);
+
+    int i = 0;
+    for (; i < length - 3; i += 4) {
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<__m128i *>(dest + i));
+        const __m128i lo = op(_mm_unpacklo_epi8(d, c.zero), s);
+        const __m128i hi = op(_mm_unpackhi_epi8(d, c.zero), s);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), _mm_packus_epi16(lo, hi));
+    }
+
+    if (i < length) {
+        uint d[4];
+        const int rest = length - i;
+        for (int j = 0; j < rest; ++j)
+            d[j] = dest[i + j];
+        qt_comp_func_solid_sse2(d, 4, color, op, c);
+        for (int j = 0; j < rest; ++j)
+            dest[i + j] = d[j];
+    }
+}
+
+#define QT_SSE2_COMP_FUNC(name, Op)                                       \
+static void QT_FASTCALL comp_func_##name##_sse2(uint *dest, const uint *src, \
+                                                int length, uint const_alpha) \
+{                                                                         \
+    const QSSE2Constants c(const_alpha);                                  \
+    qt_comp_func_sse2(dest, src, length, Op(c, const_alpha), c);          \
+}                                                                         \
+                                                                          \
+static void QT_FASTCALL comp_func_solid_##name##_sse2(uint *dest, int length, \
+                                                      uint color, uint const_alpha) \
+{                                                                         \
+    const QSSE2Constants c(const_alpha);                                  \
+    qt_comp_func_solid_sse2(dest, length, color, Op(c, const_alpha), c);  \
+}
+
+/*
+  The Porter-Duff operators. s is multiplied by the constant alpha
+  first, except for Source, Clear and DestinationIn/Out where the
+  constant alpha is folded into the destination weight.
+*/
+
+struct QSSE2Op
+{
+    inline QSSE2Op(const QSSE2Constants &constants, uint const_alpha)
+        : c(constants), full(const_alpha == 255)
+    {
+    }
+
+    inline __m128i constAlpha(const __m128i &s) const
+    {
+        return full ? s : qt_byte_mul_sse2(s, c.ca, c);
+    }
+
+    const QSSE2Constants &c;
+    const bool full;
+};
+
+// d * cia
+struct QSSE2ClearOp : public QSSE2Op
+{
+    inline QSSE2ClearOp(const QSSE2Constants &c, uint ca) : QSSE2Op(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &) const
+    {
+        return qt_byte_mul_sse2(d, c.cia, c);
+    }
+};
+
+// s * ca + d * cia
+struct QSSE2SourceOp : public QSSE2Op
+{
+    inline QSSE2SourceOp(const QSSE2Constants &c, uint ca) : QSSE2Op(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &s) const
+    {
+        return qt_interpolate_pixel_255_sse2(s, c.ca, d, c.cia, c);
+    }
+};
+
+// comp_func_solid_Source() multiplies the color and the destination separately
+struct QSSE2SolidSourceOp : public QSSE2Op
+{
+    inline QSSE2SolidSourceOp(const QSSE2Constants &c, uint ca) : QSSE2Op(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &s) const
+    {
+        return _mm_add_epi16(qt_byte_mul_sse2(s, c.ca, c), qt_byte_mul_sse2(d, c.cia, c));
+    }
+};
+
+// s + d * sia
+struct QSSE2SourceOverOp : public QSSE2Op
+{
+    inline QSSE2SourceOverOp(const QSSE2Constants &c, uint ca) : QSSE2Op(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &src) const
+    {
+        const __m128i s = constAlpha(src);
+        return _mm_add_epi16(s, qt_byte_mul_sse2(d, qt_negate_sse2(qt_alpha_sse2(s), c), c));
+    }
+};
+
+// d + s * dia
+struct QSSE2DestinationOverOp : public QSSE2Op
+{
+    inline QSSE2DestinationOverOp(const QSSE2Constants &c, uint ca) : QSSE2Op(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &src) const
+    {
+        const __m128i s = constAlpha(src);
+        return _mm_add_epi16(d, qt_byte_mul_sse2(s, qt_negate_sse2(qt_alpha_sse2(d), c), c));
+    }
+};
+
+// s * da
+struct QSSE2SourceInOp : public QSSE2Op
+{
+    inline QSSE2SourceInOp(const QSSE2Constants &c, uint ca) : QSSE2Op(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &src) const
+    {
+        if (full)
+            return qt_byte_mul_sse2(src, qt_alpha_sse2(d), c);
+        const __m128i s = qt_byte_mul_sse2(src, c.ca, c);
+        return qt_interpolate_pixel_255_sse2(s, qt_alpha_sse2(d), d, c.cia, c);
+    }
+};
+
+// d * sa
+struct QSSE2DestinationInOp : public QSSE2Op
+{
+    inline QSSE2DestinationInOp(const QSSE2Constants &c, uint ca) : QSSE2Op(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &s) const
+    {
+        __m128i a = qt_alpha_sse2(s);
+        if (!full)
+            a = _mm_add_epi16(qt_byte_mul_sse2(a, c.ca, c), c.cia);
+        return qt_byte_mul_sse2(d, a, c);
+    }
+};
+
+// s * dia
+struct QSSE2SourceOutOp : public QSSE2Op
+{
+    inline QSSE2SourceOutOp(const QSSE2Constants &c, uint ca) : QSSE2Op(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &src) const
+    {
+        const __m128i dia = qt_negate_sse2(qt_alpha_sse2(d), c);
+        if (full)
+            return qt_byte_mul_sse2(src, dia, c);
+        const __m128i s = qt_byte_mul_sse2(src, c.ca, c);
+        return qt_interpolate_pixel_255_sse2(s, dia, d, c.cia, c);
+    }
+};
+
+// d * sia
+struct QSSE2DestinationOutOp : public QSSE2Op
+{
+    inline QSSE2DestinationOutOp(const QSSE2Constants &c, uint ca) : QSSE2Op(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &s) const
+    {
+        __m128i a = qt_negate_sse2(qt_alpha_sse2(s), c);
+        if (!full)
+            a = _mm_add_epi16(qt_byte_mul_sse2(a, c.ca, c), c.cia);
+        return qt_byte_mul_sse2(d, a, c);
+    }
+};
+
+// s * da + d * sia
+struct QSSE2SourceAtopOp : public QSSE2Op
+{
+    inline QSSE2SourceAtopOp(const QSSE2Constants &c, uint ca) : QSSE2Op(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &src) const
+    {
+        const __m128i s = constAlpha(src);
+        return qt_interpolate_pixel_255_sse2(s, qt_alpha_sse2(d),
+                                             d, qt_negate_sse2(qt_alpha_sse2(s), c), c);
+    }
+};
+
+// d * sa + s * dia
+struct QSSE2DestinationAtopOp : public QSSE2Op
+{
+    inline QSSE2DestinationAtopOp(const QSSE2Constants &c, uint ca) : QSSE2Op(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &src) const
+    {
+        const __m128i s = constAlpha(src);
+        __m128i a = qt_alpha_sse2(s);
+        if (!full)
+            a = _mm_add_epi16(a, c.cia);
+        return qt_interpolate_pixel_255_sse2(d, a, s, qt_negate_sse2(qt_alpha_sse2(d), c), c);
+    }
+};
+
+// s * dia + d * sia
+struct QSSE2XorOp : public QSSE2Op
+{
+    inline QSSE2XorOp(const QSSE2Constants &c, uint ca) : QSSE2Op(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &src) const
+    {
+        const __m128i s = constAlpha(src);
+        return qt_interpolate_pixel_255_sse2(s, qt_negate_sse2(qt_alpha_sse2(d), c),
+                                             d, qt_negate_sse2(qt_alpha_sse2(s), c), c);
+    }
+};
+
+/*
+  The separable blend modes. The color channels use the blend
+  operation, the alpha channel is always Sa + Da - Sa.Da, and the
+  constant alpha interpolates between the result and d like
+  QPartialCoverage does.
+*/
+
+struct QSSE2BlendOp : public QSSE2Op
+{
+    inline QSSE2BlendOp(const QSSE2Constants &c, uint ca) : QSSE2Op(c, ca) {}
+
+    // mix_alpha() in qdrawhelper.cpp
+    inline __m128i mixAlpha(const __m128i &result, const __m128i &da, const __m128i &sa) const
+    {
+        __m128i a = _mm_mullo_epi16(qt_negate_sse2(sa, c), qt_negate_sse2(da, c));
+        a = qt_negate_sse2(_mm_srli_epi16(a, 8), c);
+        return _mm_or_si128(_mm_andnot_si128(c.alphaMask, result),
+                            _mm_and_si128(c.alphaMask, a));
+    }
+
+    inline __m128i coverage(const __m128i &result, const __m128i &d) const
+    {
+        if (full)
+            return result;
+        return qt_interpolate_pixel_255_sse2(result, c.ca, d, c.cia, c);
+    }
+};
+
+// the 16 bit channels of the pixel in the lower or upper half, as 32 bit channels
+template <int half>
+static inline __m128i qt_widen_sse2(const __m128i &x, const __m128i &y)
+{
+    return half ? _mm_unpackhi_epi16(x, y) : _mm_unpacklo_epi16(x, y);
+}
+
+// a * b + x * y in 32 bits
+template <int half>
+static inline __m128i qt_madd_sse2(const __m128i &a, const __m128i &b,
+                                   const __m128i &x, const __m128i &y)
+{
+    return _mm_madd_epi16(qt_widen_sse2<half>(a, x), qt_widen_sse2<half>(b, y));
+}
+
+static inline __m128i qt_select_sse2(const __m128i &mask, const __m128i &a, const __m128i &b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static inline __m128i qt_min_epi32_sse2(const __m128i &a, const __m128i &b)
+{
+    return qt_select_sse2(_mm_cmplt_epi32(a, b), a, b);
+}
+
+static inline __m128i qt_max_epi32_sse2(const __m128i &a, const __m128i &b)
+{
+    return qt_select_sse2(_mm_cmpgt_epi32(a, b), a, b);
+}
+
+// Runs Op::op32() on the two pixels widened to 32 bit channels.
+template <typename Op>
+struct QSSE2WideBlendOp : public QSSE2BlendOp
+{
+    inline QSSE2WideBlendOp(const QSSE2Constants &c, uint ca) : QSSE2BlendOp(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &s) const
+    {
+        const __m128i da = qt_alpha_sse2(d);
+        const __m128i sa = qt_alpha_sse2(s);
+        const __m128i mask = _mm_set1_epi32(0xff);
+        const __m128i lo = _mm_and_si128(Op::template op32<0>(d, s, da, sa, c), mask);
+        const __m128i hi = _mm_and_si128(Op::template op32<1>(d, s, da, sa, c), mask);
+        return coverage(mixAlpha(_mm_packs_epi32(lo, hi), da, sa), d);
+    }
+};
+
+// min(Sca + Dca, 1)
+struct QSSE2PlusOp : public QSSE2BlendOp
+{
+    inline QSSE2PlusOp(const QSSE2Constants &c, uint ca) : QSSE2BlendOp(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &s) const
+    {
+        return coverage(_mm_min_epi16(_mm_add_epi16(d, s), c.ff), d);
+    }
+};
+
+// Sca + Dca - Sca.Dca, which is mix_alpha() for the alpha channel as well
+struct QSSE2ScreenOp : public QSSE2BlendOp
+{
+    inline QSSE2ScreenOp(const QSSE2Constants &c, uint ca) : QSSE2BlendOp(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &s) const
+    {
+        const __m128i t = _mm_mullo_epi16(qt_negate_sse2(d, c), qt_negate_sse2(s, c));
+        return coverage(qt_negate_sse2(_mm_srli_epi16(t, 8), c), d);
+    }
+};
+
+// Sca + Dca - 2.Sca.Dca
+struct QSSE2ExclusionOp : public QSSE2BlendOp
+{
+    inline QSSE2ExclusionOp(const QSSE2Constants &c, uint ca) : QSSE2BlendOp(c, ca) {}
+    inline __m128i operator()(const __m128i &d, const __m128i &s) const
+    {
+        __m128i r = _mm_sub_epi16(_mm_add_epi16(d, s), _mm_srli_epi16(_mm_mullo_epi16(d, s), 7));
+        r = _mm_and_si128(r, c.ff);
+        return coverage(mixAlpha(r, qt_alpha_sse2(d), qt_alpha_sse2(s)), d);
+    }
+};
+
+// Sca.Dca + Sca.(1 - Da) + Dca.(1 - Sa)
+struct QSSE2Multiply
+{
+    template <int half>
+    static inline __m128i op32(const __m128i &d, const __m128i &s,
+                               const __m128i &da, const __m128i &sa, const QSSE2Constants &c)
+    {
+        const __m128i t = _mm_add_epi16(d, qt_negate_sse2(da, c));
+        return _mm_srai_epi32(qt_madd_sse2<half>(s, t, d, qt_negate_sse2(sa, c)), 8);
+    }
+};
+
+// min(Sca.Da, Dca.Sa) + Sca.(1 - Da) + Dca.(1 - Sa)
+struct QSSE2Darken
+{
+    template <int half>
+    static inline __m128i op32(const __m128i &d, const __m128i &s,
+                               const __m128i &da, const __m128i &sa, const QSSE2Constants &c)
+    {
+        const __m128i m = qt_min_epi32_sse2(qt_madd_sse2<half>(s, da, c.zero, c.zero),
+                                            qt_madd_sse2<half>(d, sa, c.zero, c.zero));
+        const __m128i t = qt_madd_sse2<half>(s, qt_negate_sse2(da, c), d, qt_negate_sse2(sa, c));
+        return _mm_srai_epi32(_mm_add_epi32(m, t), 8);
+    }
+};
+
+// max(Sca.Da, Dca.Sa) + Sca.(1 - Da) + Dca.(1 - Sa)
+struct QSSE2Lighten
+{
+    template <int half>
+    static inline __m128i op32(const __m128i &d, const __m128i &s,
+                               const __m128i &da, const __m128i &sa, const QSSE2Constants &c)
+    {
+        const __m128i m = qt_max_epi32_sse2(qt_madd_sse2<half>(s, da, c.zero, c.zero),
+                                            qt_madd_sse2<half>(d, sa, c.zero, c.zero));
+        const __m128i t = qt_madd_sse2<half>(s, qt_negate_sse2(da, c), d, qt_negate_sse2(sa, c));
+        return _mm_srai_epi32(_mm_add_epi32(m, t), 8);
+    }
+};
+
+// Sca + Dca - 2.min(Sca.Da, Dca.Sa)
+struct QSSE2Difference
+{
+    template <int half>
+    static inline __m128i op32(const __m128i &d, const __m128i &s,
+                               const __m128i &da, const __m128i &sa, const QSSE2Constants &c)
+    {
+        const __m128i m = qt_min_epi32_sse2(qt_madd_sse2<half>(s, da, c.zero, c.zero),
+                                            qt_madd_sse2<half>(d, sa, c.zero, c.zero));
+        const __m128i t = _mm_add_epi32(qt_widen_sse2<half>(s, c.zero),
+                                        qt_widen_sse2<half>(d, c.zero));
+        return _mm_sub_epi32(t, _mm_srai_epi32(m, 7));
+    }
+};
+
+/*
+  Overlay and HardLight: if 2.Dca < Da (2.Sca < Sa for HardLight)
+      2.Sca.Dca + Sca.(1 - Da) + Dca.(1 - Sa)
+  otherwise
+      Sa.Da - 2.(Da - Dca).(Sa - Sca) + Sca.(1 - Da) + Dca.(1 - Sa)
+*/
+template <int half>
+static inline __m128i qt_overlay_sse2(const __m128i &d, const __m128i &s,
+                                      const __m128i &da, const __m128i &sa,
+                                      const __m128i &mask, const QSSE2Constants &c)
+{
+    const __m128i dia = qt_negate_sse2(da, c);
+    const __m128i sia = qt_negate_sse2(sa, c);
+    const __m128i d2 = _mm_add_epi16(d, d);
+
+    const __m128i temp = qt_madd_sse2<half>(s, dia, d, sia);
+    const __m128i dark = qt_madd_sse2<half>(s, _mm_add_epi16(d2, dia), d, sia);
+    const __m128i light = _mm_add_epi32(qt_madd_sse2<half>(sa, da, _mm_sub_epi16(d2, _mm_add_epi16(da, da)),
+                                                            _mm_sub_epi16(sa, s)),
+                                        temp);
+    return qt_select_sse2(mask, dark, light);
+}
+
+struct QSSE2Overlay
+{
+    template <int half>
+    static inline __m128i op32(const __m128i &d, const __m128i &s,
+                               const __m128i &da, const __m128i &sa, const QSSE2Constants &c)
+    {
+        const __m128i mask = _mm_cmplt_epi32(qt_widen_sse2<half>(_mm_add_epi16(d, d), c.zero),
+                                             qt_widen_sse2<half>(da, c.zero));
+        return _mm_srai_epi32(qt_overlay_sse2<half>(d, s, da, sa, mask, c), 8);
+    }
+};
+
+// hardlight_op() computes in unsigned ints
+struct QSSE2HardLight
+{
+    template <int half>
+    static inline __m128i op32(const __m128i &d, const __m128i &s,
+                               const __m128i &da, const __m128i &sa, const QSSE2Constants &c)
+    {
+        const __m128i mask = _mm_cmplt_epi32(qt_widen_sse2<half>(_mm_add_epi16(s, s), c.zero),
+                                             qt_widen_sse2<half>(sa, c.zero));
+        return _mm_srli_epi32(qt_overlay_sse2<half>(d, s, da, sa, mask, c), 8);
+    }
+};
+
+QT_SSE2_COMP_FUNC(Clear, QSSE2ClearOp)
+QT_SSE2_COMP_FUNC(SourceOver, QSSE2SourceOverOp)
+QT_SSE2_COMP_FUNC(DestinationOver, QSSE2DestinationOverOp)
+QT_SSE2_COMP_FUNC(SourceIn, QSSE2SourceInOp)
+QT_SSE2_COMP_FUNC(DestinationIn, QSSE2DestinationInOp)
+QT_SSE2_COMP_FUNC(SourceOut, QSSE2SourceOutOp)
+QT_SSE2_COMP_FUNC(DestinationOut, QSSE2DestinationOutOp)
+QT_SSE2_COMP_FUNC(SourceAtop, QSSE2SourceAtopOp)
+QT_SSE2_COMP_FUNC(DestinationAtop, QSSE2DestinationAtopOp)
+QT_SSE2_COMP_FUNC(XOR, QSSE2XorOp)
+QT_SSE2_COMP_FUNC(Plus, QSSE2PlusOp)
+QT_SSE2_COMP_FUNC(Multiply, QSSE2WideBlendOp<QSSE2Multiply>)
+QT_SSE2_COMP_FUNC(Screen, QSSE2ScreenOp)
+QT_SSE2_COMP_FUNC(Overlay, QSSE2WideBlendOp<QSSE2Overlay>)
+QT_SSE2_COMP_FUNC(Darken, QSSE2WideBlendOp<QSSE2Darken>)
+QT_SSE2_COMP_FUNC(Lighten, QSSE2WideBlendOp<QSSE2Lighten>)
+QT_SSE2_COMP_FUNC(HardLight, QSSE2WideBlendOp<QSSE2HardLight>)
+QT_SSE2_COMP_FUNC(Difference, QSSE2WideBlendOp<QSSE2Difference>)
+QT_SSE2_COMP_FUNC(Exclusion, QSSE2ExclusionOp)
+
+#undef QT_SSE2_COMP_FUNC
+
+static void QT_FASTCALL comp_func_Source_sse2(uint *dest, const uint *src, int length,
+                                              uint const_alpha)
+{
+    if (const_alpha == 255) {
+        ::memcpy(dest, src, length * sizeof(uint));
+    } else {
+        const QSSE2Constants c(const_alpha);
+        qt_comp_func_sse2(dest, src, length, QSSE2SourceOp(c, const_alpha), c);
+    }
+}
+
+static void QT_FASTCALL comp_func_solid_Source_sse2(uint *dest, int length, uint color,
+                                                    uint const_alpha)
+{
+    if (const_alpha == 255) {
+        qt_memfill32_sse2(dest, color, length);
+    } else {
+        const QSSE2Constants c(const_alpha);
+        qt_comp_func_solid_sse2(dest, length, color, QSSE2SolidSourceOp(c, const_alpha), c);
+    }
+}
+
+/*
+  The C versions handle the common cases of Clear, Source and
+  SourceOver with a fill, do the same.
+*/
+static void QT_FASTCALL comp_func_solid_Clear_fill_sse2(uint *dest, int length, uint color,
+                                                        uint const_alpha)
+{
+    if (const_alpha == 255)
+        qt_memfill32_sse2(dest, 0, length);
+    else
+        comp_func_solid_Clear_sse2(dest, length, color, const_alpha);
+}
+
+static void QT_FASTCALL comp_func_Clear_fill_sse2(uint *dest, const uint *src, int length,
+                                                  uint const_alpha)
+{
+    if (const_alpha == 255)
+        qt_memfill32_sse2(dest, 0, length);
+    else
+        comp_func_Clear_sse2(dest, src, length, const_alpha);
+}
+
+// skips transparent and copies opaque groups of source pixels
+static void QT_FASTCALL comp_func_SourceOver_skip_sse2(uint *dest, const uint *src, int length,
+                                                       uint const_alpha)
+{
+    if (const_alpha != 255) {
+        comp_func_SourceOver_sse2(dest, src, length, const_alpha);
+        return;
+    }
+
+    const QSSE2Constants c(const_alpha);
+    const QSSE2SourceOverOp op(c, const_alpha);
+    const __m128i opaque = _mm_set1_epi32(0xff000000);
+
+    int i = 0;
+    for (; i < length - 3; i += 4) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(s, c.zero)) == 0xffff)
+            continue;
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, opaque), opaque)) == 0xffff) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), s);
+            continue;
+        }
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<__m128i *>(dest + i));
+        const __m128i lo = op(_mm_unpacklo_epi8(d, c.zero), _mm_unpacklo_epi8(s, c.zero));
+        const __m128i hi = op(_mm_unpackhi_epi8(d, c.zero), _mm_unpackhi_epi8(s, c.zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), _mm_packus_epi16(lo, hi));
+    }
+
+    if (i < length)
+        qt_comp_func_sse2(dest + i, src + i, length - i, op, c);
+}
+
+static void QT_FASTCALL comp_func_solid_SourceOver_fill_sse2(uint *dest, int length, uint color,
+                                                             uint const_alpha)
+{
+    if ((const_alpha & qAlpha(color)) == 255)
+        qt_memfill32_sse2(dest, color, length);
+    else
+        comp_func_solid_SourceOver_sse2(dest, length, color, const_alpha);
+}
+
+// ColorDodge, ColorBurn and SoftLight divide per channel and use the C versions
+CompositionFunctionSolid qt_functionForModeSolid_SSE2[numCompositionFunctions] = {
+    comp_func_solid_SourceOver_fill_sse2,
+    comp_func_solid_DestinationOver_sse2,
+    comp_func_solid_Clear_fill_sse2,
+    comp_func_solid_Source_sse2,
+    0,
+    comp_func_solid_SourceIn_sse2,
+    comp_func_solid_DestinationIn_sse2,
+    comp_func_solid_SourceOut_sse2,
+    comp_func_solid_DestinationOut_sse2,
+    comp_func_solid_SourceAtop_sse2,
+    comp_func_solid_DestinationAtop_sse2,
+    comp_func_solid_XOR_sse2,
+    comp_func_solid_Plus_sse2,
+    comp_func_solid_Multiply_sse2,
+    comp_func_solid_Screen_sse2,
+    comp_func_solid_Overlay_sse2,
+    comp_func_solid_Darken_sse2,
+    comp_func_solid_Lighten_sse2,
+    0,
+    0,
+    comp_func_solid_HardLight_sse2,
+    0,
+    comp_func_solid_Difference_sse2,
+    comp_func_solid_Exclusion_sse2
+};
+
+CompositionFunction qt_functionForMode_SSE2[numCompositionFunctions] = {
+    comp_func_SourceOver_skip_sse2,
+    comp_func_DestinationOver_sse2,
+    comp_func_Clear_fill_sse2,
+    comp_func_Source_sse2,
+    0,
+    comp_func_SourceIn_sse2,
+    comp_func_DestinationIn_sse2,
+    comp_func_SourceOut_sse2,
+    comp_func_DestinationOut_sse2,
+    comp_func_SourceAtop_sse2,
+    comp_func_DestinationAtop_sse2,
+    comp_func_XOR_sse2,
+    comp_func_Plus_sse2,
+    comp_func_Multiply_sse2,
+    comp_func_Screen_sse2,
+    comp_func_Overlay_sse2,
+    comp_func_Darken_sse2,
+    comp_func_Lighten_sse2,
+    0,
+    0,
+    comp_func_HardLight_sse2,
+    0,
+    comp_func_Difference_sse2,
+    comp_func_Exclusion_sse2
+};
+
+void qt_blend_color_argb_sse2(int count, const QSpan *spans, void *userData)
+{
+    QSpanData *data = reinterpret_cast<QSpanData *>(userData);
+
+    int mode = data->rasterBuffer->compositionMode;
+    if (mode == QPainter::CompositionMode_SourceOver && qAlpha(data->solid.color) == 255)
+        mode = QPainter::CompositionMode_Source;
+
+    CompositionFunctionSolid func = qt_functionForModeSolid_SSE2[mode];
+    if (!func)
+        return;
+
+    while (count--) {
+        uint *target = ((uint *)data->rasterBuffer->scanLine(spans->y)) + spans->x;
+        func(target, spans->len, data->solid.color, spans->coverage);
+        ++spans;
+    }
+}
+
+/*
+  Bilinear fetch for 32 bit textures. The coordinates and the clamping
+  are done per pixel, the interpolation is done for four pixels at a
+  time with the same arithmetic as INTERPOLATE_PIXEL_256().
+*/
+
+// (x * a + y * b) >> 8 for each 16 bit channel, where a + b == 256
+static inline __m128i qt_interpolate_pixel_256_sse2(const __m128i &x, const __m128i &a,
+                                                    const __m128i &y, const __m128i &b)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(x, a), _mm_mullo_epi16(y, b)), 8);
+}
+
+// spreads four 32 bit weights into the 16 bit channels of pixels 0, 1 and 2, 3
+static inline void qt_spread_weights_sse2(const int *w, __m128i &lo, __m128i &hi)
+{
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(w));
+    v = _mm_packs_epi32(v, v);
+    v = _mm_unpacklo_epi16(v, v);
+    lo = _mm_unpacklo_epi32(v, v);
+    hi = _mm_unpackhi_epi32(v, v);
+}
+
+static inline __m128i qt_bilinear_interpolate_sse2(const uint *tl, const uint *tr,
+                                                   const uint *bl, const uint *br,
+                                                   const int *distx, const int *disty)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(256);
+
+    __m128i dx_lo, dx_hi, dy_lo, dy_hi;
+    qt_spread_weights_sse2(distx, dx_lo, dx_hi);
+    qt_spread_weights_sse2(disty, dy_lo, dy_hi);
+    const __m128i idx_lo = _mm_sub_epi16(full, dx_lo);
+    const __m128i idx_hi = _mm_sub_epi16(full, dx_hi);
+    const __m128i idy_lo = _mm_sub_epi16(full, dy_lo);
+    const __m128i idy_hi = _mm_sub_epi16(full, dy_hi);
+
+    const __m128i vtl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tl));
+    const __m128i vtr = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tr));
+    const __m128i vbl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bl));
+    const __m128i vbr = _mm_loadu_si128(reinterpret_cast<const __m128i *>(br));
+
+    __m128i top = qt_interpolate_pixel_256_sse2(_mm_unpacklo_epi8(vtl, zero), idx_lo,
+                                                _mm_unpacklo_epi8(vtr, zero), dx_lo);
+    __m128i bottom = qt_interpolate_pixel_256_sse2(_mm_unpacklo_epi8(vbl, zero), idx_lo,
+                                                   _mm_unpacklo_epi8(vbr, zero), dx_lo);
+    const __m128i lo = qt_interpolate_pixel_256_sse2(top, idy_lo, bottom, dy_lo);
+
+    top = qt_interpolate_pixel_256_sse2(_mm_unpackhi_epi8(vtl, zero), idx_hi,
+                                        _mm_unpackhi_epi8(vtr, zero), dx_hi);
+    bottom = qt_interpolate_pixel_256_sse2(_mm_unpackhi_epi8(vbl, zero), idx_hi,
+                                           _mm_unpackhi_epi8(vbr, zero), dx_hi);
+    const __m128i hi = qt_interpolate_pixel_256_sse2(top, idy_hi, bottom, dy_hi);
+
+    return _mm_packus_epi16(lo, hi);
+}
+
+void QT_FASTCALL qt_fetch_bilinear_affine32_sse2(uint *buffer, int length,
+                                                 const QTextureData &texture,
+                                                 int fx, int fy, int fdx, int fdy)
+{
+    const int image_width = texture.width;
+    const int image_height = texture.height;
+
+    uint tl[4], tr[4], bl[4], br[4];
+    int distx[4], disty[4];
+
+    int i = 0;
+    if (!fdy) {
+        // scaled, but not rotated, so every pixel comes from the same two scanlines
+        int y1 = (fy >> 16);
+        int y2 = y1 + 1;
+        const int dy = ((fy - (y1 << 16)) >> 8);
+        disty[0] = disty[1] = disty[2] = disty[3] = dy;
+
+        y1 = qBound(0, y1, image_height - 1);
+        y2 = qBound(0, y2, image_height - 1);
+
+        const uint *s1 = reinterpret_cast<const uint *>(texture.scanLine(y1));
+        const uint *s2 = reinterpret_cast<const uint *>(texture.scanLine(y2));
+
+        for (; i < length; i += 4) {
+            for (int j = 0; j < 4; ++j) {
+                int x1 = (fx >> 16);
+                int x2 = x1 + 1;
+                distx[j] = ((fx - (x1 << 16)) >> 8);
+
+                x1 = qBound(0, x1, image_width - 1);
+                x2 = qBound(0, x2, image_width - 1);
+
+                tl[j] = s1[x1];
+                tr[j] = s1[x2];
+                bl[j] = s2[x1];
+                br[j] = s2[x2];
+
+                fx += fdx;
+            }
+
+            const __m128i result = qt_bilinear_interpolate_sse2(tl, tr, bl, br, distx, disty);
+            if (length - i >= 4) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(buffer + i), result);
+            } else {
+                uint rest[4];
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(rest), result);
+                for (int j = 0; j < length - i; ++j)
+                    buffer[i + j] = rest[j];
+            }
+        }
+        return;
+    }
+
+    for (; i < length; i += 4) {
+        for (int j = 0; j < 4; ++j) {
+            int x1 = (fx >> 16);
+            int x2 = x1 + 1;
+            int y1 = (fy >> 16);
+            int y2 = y1 + 1;
+
+            distx[j] = ((fx - (x1 << 16)) >> 8);
+            disty[j] = ((fy - (y1 << 16)) >> 8);
+
+            x1 = qBound(0, x1, image_width - 1);
+            x2 = qBound(0, x2, image_width - 1);
+            y1 = qBound(0, y1, image_height - 1);
+            y2 = qBound(0, y2, image_height - 1);
+
+            const uint *s1 = reinterpret_cast<const uint *>(texture.scanLine(y1));
+            const uint *s2 = reinterpret_cast<const uint *>(texture.scanLine(y2));
+
+            tl[j] = s1[x1];
+            tr[j] = s1[x2];
+            bl[j] = s2[x1];
+            br[j] = s2[x2];
+
+            fx += fdx;
+            fy += fdy;
+        }
+
+        const __m128i result = qt_bilinear_interpolate_sse2(tl, tr, bl, br, distx, disty);
+        if (length - i >= 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(buffer + i), result);
+        } else {
+            uint rest[4];
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(rest), result);
+            for (int j = 0; j < length - i; ++j)
+                buffer[i + j] = rest[j];
+        }
+    }
+}
+
+
 QT_END_NAMESPACE
 
 #endif // QT_HAVE_SSE2
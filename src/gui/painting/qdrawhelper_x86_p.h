@@ -86,6 +86,14 @@ void qt_bitmapblit32_sse2(QRasterBuffer *rasterBuffer, int x, int y,
 void qt_bitmapblit16_sse2(QRasterBuffer *rasterBuffer, int x, int y,
                           quint32 color,
                           const uchar *src, int width, int height, int stride);
+
+void qt_blend_color_argb_sse2(int count, const QSpan *spans, void *userData);
+void QT_FASTCALL qt_fetch_bilinear_affine32_sse2(uint *buffer, int length,
+                                                 const QTextureData &texture,
+                                                 int fx, int fy, int fdx, int fdy);
+
+extern CompositionFunction qt_functionForMode_SSE2[];
+extern CompositionFunctionSolid qt_functionForModeSolid_SSE2[];
 #endif // QT_HAVE_SSE2
 
 #ifdef QT_HAVE_IWMMXT
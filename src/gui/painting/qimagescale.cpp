@@ -12,31 +12,28 @@
 ****************************************************************************/
 #include <private/qimagescale_p.h>
 #include <private/qdrawhelper_p.h>
+#include <private/qsimd_p.h>
 
 #include "qimage.h"
 #include "qcolor.h"
 
-QT_BEGIN_NAMESPACE
-
-namespace QImageScale {
-    struct QImageScaleInfo;
-}
-
-typedef void (*qt_qimageScaleFunc)(QImageScale::QImageScaleInfo *isi, unsigned int *dest,
-                                   int dxx, int dyy, int dx, int dy, int dw,
-                                   int dh, int dow, int sow);
+#ifndef QT_NO_CONCURRENT
+#include "qthreadpool.h"
+#include "qtconcurrentmap.h"
+#endif
 
-static void qt_qimageScaleAARGB(QImageScale::QImageScaleInfo *isi, unsigned int *dest,
-                         int dxx, int dyy, int dx, int dy, int dw,
-                         int dh, int dow, int sow);
+QT_BEGIN_NAMESPACE
 
-static void qt_qimageScaleAARGBA(QImageScale::QImageScaleInfo *isi, unsigned int *dest,
-                          int dxx, int dyy, int dx, int dy, int dw,
-                          int dh, int dow, int sow);
+static void qt_qimageScaleAARGBSetup(QImageScale::QImageScaleInfo *isi, unsigned int *dest,
+                                     int dxx, int dyy, int dx, int dy, int dw,
+                                     int dh, int dow, int sow);
 
-qt_qimageScaleFunc qt_qimageScaleArgb = qt_qimageScaleAARGBA;
-qt_qimageScaleFunc qt_qimageScaleRgb  = qt_qimageScaleAARGB;
+static void qt_qimageScaleAARGBASetup(QImageScale::QImageScaleInfo *isi, unsigned int *dest,
+                                      int dxx, int dyy, int dx, int dy, int dw,
+                                      int dh, int dow, int sow);
 
+qt_qimageScaleFunc qt_qimageScaleArgb = qt_qimageScaleAARGBASetup;
+qt_qimageScaleFunc qt_qimageScaleRgb  = qt_qimageScaleAARGBSetup;
 
 /*
  * Copyright (C) 2004, 2005 Daniel M. Duley
@@ -85,13 +82,6 @@ qt_qimageScaleFunc qt_qimageScaleRgb  = qt_qimageScaleAARGB;
 
 
 namespace QImageScale {
-    struct QImageScaleInfo {
-        int *xpoints;
-        unsigned int **ypoints;
-        int *xapoints, *yapoints;
-        int xup_yup;
-    };
-
     unsigned int** qimageCalcYPoints(unsigned int *src, int sw, int sh,
                                      int dh);
     int* qimageCalcXPoints(int sw, int dw);
@@ -273,9 +263,9 @@ QImageScaleInfo* QImageScale::qimageCalcScaleInfo(const QImage &img,
 /* FIXME: NEED to optimise ScaleAARGBA - currently its "ok" but needs work*/
 
 /* scale by area sampling */
-static void qt_qimageScaleAARGBA(QImageScaleInfo *isi, unsigned int *dest,
-                                 int dxx, int dyy, int dx, int dy, int dw,
-                                 int dh, int dow, int sow)
+void qt_qimageScaleAARGBA(QImageScaleInfo *isi, unsigned int *dest,
+                          int dxx, int dyy, int dx, int dy, int dw,
+                          int dh, int dow, int sow)
 {
     unsigned int *sptr, *dptr;
     int x, y, end;
@@ -631,9 +621,9 @@ static void qt_qimageScaleAARGBA(QImageScaleInfo *isi, unsigned int *dest,
 }
 
 /* scale by area sampling - IGNORE the ALPHA byte*/
-static void qt_qimageScaleAARGB(QImageScaleInfo *isi, unsigned int *dest,
-                                int dxx, int dyy, int dx, int dy, int dw,
-                                int dh, int dow, int sow)
+void qt_qimageScaleAARGB(QImageScaleInfo *isi, unsigned int *dest,
+                         int dxx, int dyy, int dx, int dy, int dw,
+                         int dh, int dow, int sow)
 {
     unsigned int *sptr, *dptr;
     int x, y, end;
@@ -944,23 +934,148 @@ static void qt_qimageScaleAARGB(QImageScaleInfo *isi, unsigned int *dest,
     }
 }
 
-#if 0
+/*
+  Scales down by an integer factor of 2, 4 or 8 in each direction, as
+  given by isi->xbox and isi->ybox. Every destination pixel is the
+  rounded average of its box of source pixels, summed two channels at a
+  time.
+*/
+static void qt_qimageScaleBox(QImageScaleInfo *isi, unsigned int *dest,
+                              int dxx, int dyy, int dx, int dy, int dw,
+                              int dh, int dow, int sow)
+{
+    const int xbox = isi->xbox;
+    const int ybox = isi->ybox;
+    unsigned int **ypoints = isi->ypoints;
+    int *xpoints = isi->xpoints;
+
+    int shift = 0;
+    while ((1 << shift) < xbox * ybox)
+        ++shift;
+    const unsigned int round = ((1 << shift) >> 1) * 0x00010001;
+
+    const int end = dxx + dw;
+    for (int y = 0; y < dh; ++y) {
+        unsigned int *dptr = dest + dx + ((y + dy) * dow);
+        for (int x = dxx; x < end; ++x) {
+            const unsigned int *pix = ypoints[dyy + y] + xpoints[x];
+            unsigned int rb = 0;
+            unsigned int ag = 0;
+            for (int j = 0; j < ybox; ++j) {
+                for (int i = 0; i < xbox; ++i) {
+                    rb += pix[i] & 0x00ff00ff;
+                    ag += (pix[i] >> 8) & 0x00ff00ff;
+                }
+                pix += sow;
+            }
+            rb = ((rb + round) >> shift) & 0x00ff00ff;
+            ag = ((ag + round) >> shift) & 0x00ff00ff;
+            *dptr++ = rb | (ag << 8);
+        }
+    }
+}
+
+static inline bool qt_qimageIsBoxFactor(int factor)
+{
+    return factor == 2 || factor == 4 || factor == 8;
+}
+
+static void qInitImageScaleFunctions()
+{
+    uint features = qDetectCPUFeatures();
+    Q_UNUSED(features);
+
+#ifdef QT_HAVE_SSE2
+    if (features & SSE2) {
+        qt_qimageScaleArgb = qt_qimageScaleAARGBA_sse2;
+        qt_qimageScaleRgb = qt_qimageScaleAARGB_sse2;
+        return;
+    }
+#endif
+    qt_qimageScaleArgb = qt_qimageScaleAARGBA;
+    qt_qimageScaleRgb = qt_qimageScaleAARGB;
+}
+
 static void qt_qimageScaleAARGBASetup(QImageScaleInfo *isi, unsigned int *dest,
                                       int dxx, int dyy, int dx, int dy, int dw,
                                       int dh, int dow, int sow)
 {
-    qInitDrawhelperAsm();
-    qt_qimageScaleAARGBA(isi, dest, dxx, dyy, dx, dy, dw, dh, dow, sow);
+    qInitImageScaleFunctions();
+    qt_qimageScaleArgb(isi, dest, dxx, dyy, dx, dy, dw, dh, dow, sow);
 }
 
 static void qt_qimageScaleAARGBSetup(QImageScaleInfo *isi, unsigned int *dest,
-                                 int dxx, int dyy, int dx, int dy, int dw,
-                                 int dh, int dow, int sow)
+                                     int dxx, int dyy, int dx, int dy, int dw,
+                                     int dh, int dow, int sow)
 {
-    qInitDrawhelperAsm();
-    qt_qimageScaleAARGB(isi, dest, dxx, dyy, dx, dy, dw, dh, dow, sow);
+    qInitImageScaleFunctions();
+    qt_qimageScaleRgb(isi, dest, dxx, dyy, dx, dy, dw, dh, dow, sow);
 }
+
+#ifndef QT_NO_CONCURRENT
+enum {
+    // don't bother with threads for fewer destination rows than this per band
+    MinScaleBandHeight = 16,
+    // ...or for images with fewer pixels than this
+    MinParallelScalePixels = 256 * 256
+};
+
+// Scales one band of the destination rows, for QtConcurrent::blockingMap().
+struct QImageScaleBand
+{
+    inline QImageScaleBand(qt_qimageScaleFunc func, QImageScaleInfo *isi, unsigned int *dest,
+                           int dw, int dh, int sow, int bandCount)
+        : func(func), isi(isi), dest(dest), dw(dw), dh(dh), sow(sow), bandCount(bandCount) { }
+
+    inline void operator()(int band) const
+    {
+        const int top = band * dh / bandCount;
+        const int bottom = (band + 1) * dh / bandCount;
+        func(isi, dest, 0, top, 0, top, dw, bottom - top, dw, sow);
+    }
+
+    qt_qimageScaleFunc func;
+    QImageScaleInfo *isi;
+    unsigned int *dest;
+    int dw;
+    int dh;
+    int sow;
+    int bandCount;
+};
+#endif // QT_NO_CONCURRENT
+
+/*
+  Runs \a func over all the rows of the destination, split into bands
+  on the global thread pool when the image is large enough.
+*/
+static void qt_qimageScale(qt_qimageScaleFunc func, QImageScaleInfo *isi, unsigned int *dest,
+                           int dw, int dh, int sw, int sh)
+{
+#ifndef QT_NO_CONCURRENT
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int threads = pool->maxThreadCount();
+    const int bandCount = qMin(2 * threads, dh / MinScaleBandHeight);
+    if (threads > 1 && bandCount > 1
+        && qMax(sw * sh, dw * dh) >= MinParallelScalePixels) {
+        // make sure the worker threads don't race to pick the SSE2 functions
+        if (func == qt_qimageScaleAARGBASetup || func == qt_qimageScaleAARGBSetup) {
+            qInitImageScaleFunctions();
+            func = (func == qt_qimageScaleAARGBASetup) ? qt_qimageScaleArgb : qt_qimageScaleRgb;
+        }
+
+        // the calling thread takes bands as well, so the scaling finishes
+        // even when the thread pool is busy
+        QVector<int> bands(bandCount);
+        for (int i = 0; i < bandCount; ++i)
+            bands[i] = i;
+        QtConcurrent::blockingMap(bands, QImageScaleBand(func, isi, dest, dw, dh, sw, bandCount));
+        return;
+    }
+#else
+    Q_UNUSED(sh);
 #endif
+    func(isi, dest, 0, 0, 0, 0, dw, dh, dw, sw);
+}
 
 QImage qSmoothScaleImageAutoConvert(QImage &src, int dw, int dh)
 {
@@ -1000,12 +1115,18 @@ QImage qSmoothScaleImage(const QImage &src, int dw, int dh)
         return QImage();
     }
 
-    if (src.format() == QImage::Format_ARGB32)
-        qt_qimageScaleArgb(scaleinfo, (unsigned int *)buffer.scanLine(0),
-                           0, 0, 0, 0, dw, dh, dw, w);
-    else
-        qt_qimageScaleRgb(scaleinfo, (unsigned int *)buffer.scanLine(0),
-                          0, 0, 0, 0, dw, dh, dw, w);
+    qt_qimageScaleFunc func;
+    if (w == dw * (w / dw) && h == dh * (h / dh)
+        && qt_qimageIsBoxFactor(w / dw) && qt_qimageIsBoxFactor(h / dh)) {
+        scaleinfo->xbox = w / dw;
+        scaleinfo->ybox = h / dh;
+        func = qt_qimageScaleBox;
+    } else if (src.format() == QImage::Format_ARGB32) {
+        func = qt_qimageScaleArgb;
+    } else {
+        func = qt_qimageScaleRgb;
+    }
+    qt_qimageScale(func, scaleinfo, (unsigned int *)buffer.scanLine(0), dw, dh, w, h);
 
     qimageFreeScaleInfo(scaleinfo);
     return buffer;
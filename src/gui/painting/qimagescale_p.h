@@ -38,6 +38,36 @@ QImage qSmoothScaleImageAutoConvert(QImage &img, int w, int h);
 */
 QImage qSmoothScaleImage(const QImage &img, int w, int h);
 
+namespace QImageScale {
+    struct QImageScaleInfo {
+        int *xpoints;
+        unsigned int **ypoints;
+        int *xapoints, *yapoints;
+        int xup_yup;
+        int xbox, ybox;
+    };
+}
+
+typedef void (*qt_qimageScaleFunc)(QImageScale::QImageScaleInfo *isi, unsigned int *dest,
+                                   int dxx, int dyy, int dx, int dy, int dw,
+                                   int dh, int dow, int sow);
+
+void qt_qimageScaleAARGB(QImageScale::QImageScaleInfo *isi, unsigned int *dest,
+                         int dxx, int dyy, int dx, int dy, int dw,
+                         int dh, int dow, int sow);
+void qt_qimageScaleAARGBA(QImageScale::QImageScaleInfo *isi, unsigned int *dest,
+                          int dxx, int dyy, int dx, int dy, int dw,
+                          int dh, int dow, int sow);
+
+#ifdef QT_HAVE_SSE2
+void qt_qimageScaleAARGB_sse2(QImageScale::QImageScaleInfo *isi, unsigned int *dest,
+                              int dxx, int dyy, int dx, int dy, int dw,
+                              int dh, int dow, int sow);
+void qt_qimageScaleAARGBA_sse2(QImageScale::QImageScaleInfo *isi, unsigned int *dest,
+                               int dxx, int dyy, int dx, int dy, int dw,
+                               int dh, int dow, int sow);
+#endif
+
 QT_END_NAMESPACE
 
 #endif
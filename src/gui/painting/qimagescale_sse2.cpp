@@ -0,0 +1,187 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ $TROLLTECH$. All rights reserved.
+**
+** This file is part of the $MODULE$ of the Qt Toolkit.
+**
+** $TROLLTECH_DUAL_LICENSE$
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <private/qimagescale_p.h>
+
+#ifdef QT_HAVE_SSE2
+
+#include <emmintrin.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QImageScale;
+
+/*
+  The SSE2 versions of the smooth scaling functions keep the four
+  channels of a pixel in the four 32 bit lanes of a register and do the
+  same arithmetic as qt_qimageScaleAARGBA(), so the results are
+  identical. The channels and weights are both below 2^15, which makes
+  _mm_madd_epi16() an exact 32 bit multiply here.
+*/
+
+#define INV_XAP                   (256 - xapoints[x])
+#define XAP                       (xapoints[x])
+#define INV_YAP                   (256 - yapoints[dyy + y])
+#define YAP                       (yapoints[dyy + y])
+
+static inline __m128i qt_qimageScaleLoad(const unsigned int *pix, __m128i zero)
+{
+    const __m128i v = _mm_cvtsi32_si128(*pix);
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(v, zero), zero);
+}
+
+static inline __m128i qt_qimageScaleMul(__m128i v, int w)
+{
+    return _mm_madd_epi16(v, _mm_set1_epi32(w));
+}
+
+static inline unsigned int qt_qimageScalePack(__m128i v)
+{
+    v = _mm_packs_epi32(v, v);
+    v = _mm_packus_epi16(v, v);
+    return _mm_cvtsi128_si32(v);
+}
+
+/*
+  Sums \a count pixels starting at \a pix, \a step pixels apart, with
+  the first weighted by \a ap, the rest by \a C and the remainder of
+  the 2^14 total weight going to the last one. Every term is shifted
+  right by \a shift, as in the C version.
+*/
+static inline __m128i qt_qimageScaleSpan(const unsigned int *pix, int step, int ap, int C,
+                                         int shift, __m128i zero)
+{
+    const __m128i s = _mm_cvtsi32_si128(shift);
+    __m128i v = _mm_srl_epi32(qt_qimageScaleMul(qt_qimageScaleLoad(pix, zero), ap), s);
+    int j;
+    for (j = (1 << 14) - ap; j > C; j -= C) {
+        pix += step;
+        v = _mm_add_epi32(v, _mm_srl_epi32(qt_qimageScaleMul(qt_qimageScaleLoad(pix, zero), C), s));
+    }
+    if (j > 0) {
+        pix += step;
+        v = _mm_add_epi32(v, _mm_srl_epi32(qt_qimageScaleMul(qt_qimageScaleLoad(pix, zero), j), s));
+    }
+    return v;
+}
+
+template <bool alpha>
+static void qt_qimageScaleAA_sse2(QImageScaleInfo *isi, unsigned int *dest,
+                                  int dxx, int dyy, int dx, int dy, int dw,
+                                  int dh, int dow, int sow)
+{
+    unsigned int **ypoints = isi->ypoints;
+    int *xpoints = isi->xpoints;
+    int *xapoints = isi->xapoints;
+    int *yapoints = isi->yapoints;
+    const unsigned int alphaMask = alpha ? 0 : 0xff000000;
+    const __m128i zero = _mm_setzero_si128();
+
+    const int end = dxx + dw;
+    /* if we're scaling down vertically */
+    if (isi->xup_yup == 1) {
+        for (int y = 0; y < dh; ++y) {
+            const int Cy = YAP >> 16;
+            const int yap = YAP & 0xffff;
+
+            unsigned int *dptr = dest + dx + ((y + dy) * dow);
+            for (int x = dxx; x < end; ++x) {
+                const unsigned int *pix = ypoints[dyy + y] + xpoints[x];
+                __m128i v = qt_qimageScaleSpan(pix, sow, yap, Cy, 10, zero);
+                if (XAP > 0) {
+                    const __m128i vv = qt_qimageScaleSpan(pix + 1, sow, yap, Cy, 10, zero);
+                    v = _mm_add_epi32(qt_qimageScaleMul(v, INV_XAP), qt_qimageScaleMul(vv, XAP));
+                    v = _mm_srli_epi32(v, 12);
+                } else {
+                    v = _mm_srli_epi32(v, 4);
+                }
+                *dptr++ = qt_qimageScalePack(v) | alphaMask;
+            }
+        }
+    }
+    /* if we're scaling down horizontally */
+    else if (isi->xup_yup == 2) {
+        for (int y = 0; y < dh; ++y) {
+            unsigned int *dptr = dest + dx + ((y + dy) * dow);
+            for (int x = dxx; x < end; ++x) {
+                const int Cx = XAP >> 16;
+                const int xap = XAP & 0xffff;
+
+                const unsigned int *pix = ypoints[dyy + y] + xpoints[x];
+                __m128i v = qt_qimageScaleSpan(pix, 1, xap, Cx, 10, zero);
+                if (YAP > 0) {
+                    const __m128i vv = qt_qimageScaleSpan(pix + sow, 1, xap, Cx, 10, zero);
+                    v = _mm_add_epi32(qt_qimageScaleMul(v, INV_YAP), qt_qimageScaleMul(vv, YAP));
+                    v = _mm_srli_epi32(v, 12);
+                } else {
+                    v = _mm_srli_epi32(v, 4);
+                }
+                *dptr++ = qt_qimageScalePack(v) | alphaMask;
+            }
+        }
+    }
+    /* if we're scaling down horizontally & vertically */
+    else {
+        for (int y = 0; y < dh; ++y) {
+            const int Cy = YAP >> 16;
+            const int yap = YAP & 0xffff;
+
+            unsigned int *dptr = dest + dx + ((y + dy) * dow);
+            for (int x = dxx; x < end; ++x) {
+                const int Cx = XAP >> 16;
+                const int xap = XAP & 0xffff;
+
+                const unsigned int *sptr = ypoints[dyy + y] + xpoints[x];
+                __m128i vx = qt_qimageScaleSpan(sptr, 1, xap, Cx, 9, zero);
+                __m128i v = _mm_srli_epi32(qt_qimageScaleMul(vx, yap), 14);
+                int j;
+                for (j = (1 << 14) - yap; j > Cy; j -= Cy) {
+                    sptr += sow;
+                    vx = qt_qimageScaleSpan(sptr, 1, xap, Cx, 9, zero);
+                    v = _mm_add_epi32(v, _mm_srli_epi32(qt_qimageScaleMul(vx, Cy), 14));
+                }
+                if (j > 0) {
+                    sptr += sow;
+                    vx = qt_qimageScaleSpan(sptr, 1, xap, Cx, 9, zero);
+                    v = _mm_add_epi32(v, _mm_srli_epi32(qt_qimageScaleMul(vx, j), 14));
+                }
+                *dptr++ = qt_qimageScalePack(_mm_srli_epi32(v, 5)) | alphaMask;
+            }
+        }
+    }
+}
+
+void qt_qimageScaleAARGBA_sse2(QImageScaleInfo *isi, unsigned int *dest,
+                               int dxx, int dyy, int dx, int dy, int dw,
+                               int dh, int dow, int sow)
+{
+    // scaling up both ways is plain bilinear filtering, leave it to C
+    if (isi->xup_yup == 3)
+        qt_qimageScaleAARGBA(isi, dest, dxx, dyy, dx, dy, dw, dh, dow, sow);
+    else
+        qt_qimageScaleAA_sse2<true>(isi, dest, dxx, dyy, dx, dy, dw, dh, dow, sow);
+}
+
+void qt_qimageScaleAARGB_sse2(QImageScaleInfo *isi, unsigned int *dest,
+                              int dxx, int dyy, int dx, int dy, int dw,
+                              int dh, int dow, int sow)
+{
+    if (isi->xup_yup == 3)
+        qt_qimageScaleAARGB(isi, dest, dxx, dyy, dx, dy, dw, dh, dow, sow);
+    else
+        qt_qimageScaleAA_sse2<false>(isi, dest, dxx, dyy, dx, dy, dw, dh, dow, sow);
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_HAVE_SSE2
@@ -24,10 +24,14 @@
 #include <qhash.h>
 #include <qlabel.h>
 #include <qbitmap.h>
+#include <qmutex.h>
+#include <qthreadpool.h>
+#include <qtconcurrentmap.h>
 
 #include <private/qmath_p.h>
 
 #include <private/qdatabuffer_p.h>
+#include <private/qimage_p.h>
 #include <private/qpainter_p.h>
 #include <private/qtextengine_p.h>
 #include <private/qpixmap_p.h>
@@ -640,6 +644,91 @@ static inline void resolveGradientBoundsConditional(const QRectF &rect, QSpanDat
         resolveGradientBounds(rect, data);
 }
 
+/********************************************************************************
+ * class QRasterBandRenderer
+ *
+ * Used by a raster engine that paints on a QImage with the
+ * QPainter::ParallelRendering hint. The engine records its drawing commands
+ * here instead of executing them, and flush() plays them back in horizontal
+ * bands of the image using the global QThreadPool. Each band is painted by
+ * its own raster engine that has the band as its system clip, so every
+ * pixel is written by exactly one thread and the result is the same as
+ * with serial rendering.
+ *
+ * State changes are recorded as copies of the QPainterState. Anything a
+ * band engine would otherwise compute lazily in shared data is resolved
+ * while recording: pixmap textures are converted to images, dash patterns
+ * and path bounds are computed, and the pen comparison of updateState() is
+ * done by the recording engine only.
+ */
+class QRasterBandRenderer
+{
+public:
+    enum { MinBandHeight = 64, MaxCommands = 4096 };
+
+    QRasterBandRenderer(QRasterPaintEngine *engine, int bandCount);
+    ~QRasterBandRenderer();
+
+    static int bandCount(const QRasterBuffer *rasterBuffer);
+
+    void begin(const QPainterState *state, const QPoint &redirectionOffset);
+    void recordState(const QPaintEngineState &state);
+    void setPenChanged(bool changed);
+
+    void recordPath(const QPainterPath &path);
+    void recordPolygon(const QPointF *points, int pointCount, QPaintEngine::PolygonDrawMode mode);
+    void recordPolygon(const QPoint *points, int pointCount, QPaintEngine::PolygonDrawMode mode);
+    void recordEllipse(const QRectF &rect);
+    void recordRects(const QRect *rects, int rectCount);
+    void recordRects(const QRectF *rects, int rectCount);
+    void recordFillRect(const QRect &rect, const QBrush &brush);
+    bool recordImage(const QRectF &r, const QImage &image, const QRectF &sr,
+                     Qt::ImageConversionFlags flags);
+    void recordLines(const QLine *lines, int lineCount);
+    void recordLines(const QLineF *lines, int lineCount);
+    void recordPoints(const QPointF *points, int pointCount);
+
+    void flush();
+    void replay(int band);
+
+private:
+    enum CommandType {
+        State, RasterizerClip, Path, PolygonF, Polygon, Ellipse, RectsF, Rects,
+        FillRect, Image, LinesF, Lines, PointsF
+    };
+
+    // index and count refer to the buffer of the command's type; an Image
+    // command has its target and source rectangles at index in rectsF and
+    // its image at count in images, a FillRect command has its brush at
+    // count in brushes.
+    struct Command {
+        CommandType type;
+        int mode;
+        int index;
+        int count;
+    };
+
+    void prepareState(QPainterState *state) const;
+    void add(CommandType type, int index, int count = 0, int mode = 0);
+
+    QRasterPaintEngine *engine;
+    QRect rasterizerClip;
+    QList<QImage *> bandImages;
+    QList<QPainter *> bandPainters;
+
+    QDataBuffer<Command> commands;
+    QList<QPainterState *> states;
+    QList<QPainterPath> paths;
+    QList<QImage> images;
+    QList<QBrush> brushes;
+    QDataBuffer<QPointF> pointsF;
+    QDataBuffer<QPoint> points;
+    QDataBuffer<QRectF> rectsF;
+    QDataBuffer<QRect> rects;
+    QDataBuffer<QLineF> linesF;
+    QDataBuffer<QLine> lines;
+};
+
 /*!
     \class QRasterPaintEngine
     \preliminary
@@ -747,6 +836,12 @@ void QRasterPaintEngine::init()
     d->basicStroker.setLineToHook(qt_ft_outline_line_to);
     d->basicStroker.setCubicToHook(qt_ft_outline_cubic_to);
     d->dashStroker = 0;
+
+    d->bands = 0;
+    d->recording = false;
+    d->serial = false;
+    d->band_engine = false;
+    d->replay_pen_changed = false;
 }
 
 /*!
@@ -776,6 +871,7 @@ QRasterPaintEngine::~QRasterPaintEngine()
 #endif
 
     delete d->dashStroker;
+    delete d->bands;
 }
 
 /*!
@@ -960,6 +1056,8 @@ bool QRasterPaintEngine::end()
 {
     Q_D(QRasterPaintEngine);
 
+    finishParallelRendering();
+
     if (d->flushOnEnd)
         flush(d->pdev, QPoint());
 
@@ -1184,6 +1282,9 @@ void QRasterPaintEngine::updateState(const QPaintEngineState &state)
 
     QPaintEngine::DirtyFlags flags = state.state();
 
+    if (d->bands)
+        d->bands->recordState(state);
+
     bool update_fast_pen = false;
     bool update_fast_text = false;
 
@@ -1218,7 +1319,7 @@ void QRasterPaintEngine::updateState(const QPaintEngineState &state)
         }
     }
 
-    if (flags & DirtyPen && d->pen != state.pen()) {
+    if (flags & DirtyPen && d->penChanged(state)) {
         update_fast_pen = true;
         update_fast_text = true;
         d->pen = state.pen();
@@ -1309,6 +1410,11 @@ void QRasterPaintEngine::updateState(const QPaintEngineState &state)
                 d->rasterBuffer->clip = d->rasterBuffer->disabled_clip;
                 d->rasterBuffer->clipRegion = d->rasterBuffer->disabledClipRegion;
                 d->rasterBuffer->clipRect = d->rasterBuffer->disabledClipRect;
+                // Disabling the clip under a rotation leaves the raster
+                // buffer unclipped, not clipped to the device rect.
+                d->rasterBuffer->clipEnabled = d->rasterBuffer->clip
+                                               || !d->rasterBuffer->clipRect.isEmpty()
+                                               || !d->rasterBuffer->clipRegion.isEmpty();
                 d->rasterBuffer->disabled_clip = 0;
                 d->rasterBuffer->disabledClipRegion = QRegion();
                 d->rasterBuffer->disabledClipRect = QRect();
@@ -1353,6 +1459,128 @@ void QRasterPaintEngine::updateState(const QPaintEngineState &state)
                            || (mode == QPainter::CompositionMode_SourceOver
                                && qAlpha(d->penData.solid.color) == 255));
     }
+
+    if ((flags & DirtyHints) && !d->band_engine) {
+        if (state.renderHints() & QPainter::ParallelRendering)
+            startParallelRendering(state);
+        else
+            finishParallelRendering();
+    }
+
+    d->updateRecording();
+}
+
+/*!
+    \internal
+
+    Starts recording the drawing commands for band-parallel playback,
+    if the device is a QImage that is tall enough to be split into
+    bands and the global thread pool has more than one thread.
+*/
+void QRasterPaintEngine::startParallelRendering(const QPaintEngineState &state)
+{
+    Q_D(QRasterPaintEngine);
+
+    if (d->bands || d->mono_surface || !d->pdev || d->pdev->devType() != QInternal::Image)
+        return;
+
+    const int bandCount = QRasterBandRenderer::bandCount(d->rasterBuffer);
+    if (bandCount < 2)
+        return;
+
+    d->bands = new QRasterBandRenderer(this, bandCount);
+    d->bands->begin(static_cast<const QPainterState *>(&state),
+                    painter()->d_ptr->redirection_offset);
+}
+
+/*!
+    \internal
+
+    Plays back the recorded drawing commands and returns to serial
+    rendering.
+*/
+void QRasterPaintEngine::finishParallelRendering()
+{
+    Q_D(QRasterPaintEngine);
+
+    if (!d->bands)
+        return;
+
+    d->bands->flush();
+    delete d->bands;
+    d->bands = 0;
+    d->recording = false;
+}
+
+/*!
+    \internal
+
+    Updates the engine with \a state as if only \a flags were dirty.
+*/
+void QRasterPaintEngine::replayState(QPainterState *state, DirtyFlags flags)
+{
+    QPaintEngineState *oldState = QPaintEngine::state;
+    QPaintEngine::state = state;
+    clearDirty(AllDirty);
+    setDirty(flags);
+    updateState(*state);
+    QPaintEngine::state = oldState;
+}
+
+/*!
+    \internal
+
+    Returns true if the pen of \a state differs from the current pen.
+    Band engines don't compare pens, since comparing textured pens
+    converts their textures; they use the answer of the recording
+    engine instead.
+*/
+bool QRasterPaintEnginePrivate::penChanged(const QPaintEngineState &state)
+{
+    if (band_engine)
+        return replay_pen_changed;
+
+    const bool changed = pen != state.pen();
+    if (bands)
+        bands->setPenChanged(changed);
+    return changed;
+}
+
+/*!
+    \internal
+
+    Drawing commands are recorded while parallel rendering is on, unless
+    a serial operation is in progress or the pen has a texture, which
+    QBrush::isOpaque() converts lazily. Pending commands are played back
+    before the engine starts drawing itself again.
+*/
+void QRasterPaintEnginePrivate::updateRecording()
+{
+    const bool record = bands && !serial && pen.brush().style() != Qt::TexturePattern;
+    if (recording && !record)
+        bands->flush();
+    recording = record;
+}
+
+/*!
+    \internal
+
+    Returns \a brush with a pixmap texture replaced by the image that
+    QSpanData::setup() would make of it. Band engines use such brushes,
+    since the texture of a QBrush is converted lazily.
+*/
+QBrush QRasterPaintEnginePrivate::imageTextureBrush(const QBrush &brush) const
+{
+    if (brush.style() != Qt::TexturePattern || !hasPixmapTexture(brush))
+        return brush;
+
+    QBrush result(brush.texture().isQBitmap()
+                  ? rasterBuffer->colorizeBitmap(brush.textureImage(), brush.color())
+                  : brush.textureImage());
+    result.setColor(brush.color());
+    result.setTransform(brush.transform());
+    result.d->forceTextureClamp = brush.d->forceTextureClamp;
+    return result;
 }
 
 void QRasterPaintEnginePrivate::updateMatrixData(QSpanData *spanData, const QBrush &b, const QTransform &m)
@@ -1609,6 +1837,11 @@ void QRasterPaintEngine::drawRects(const QRect *rects, int rectCount)
     qDebug(" - QRasterPaintEngine::drawRect(), rectCount=%d", rectCount);
 #endif
     Q_D(QRasterPaintEngine);
+    if (d->recording) {
+        d->bands->recordRects(rects, rectCount);
+        return;
+    }
+
     if (!d->antialiased && d->txop <= QTransform::TxTranslate) {
         int offset_x = int(d->matrix.dx());
         int offset_y = int(d->matrix.dy());
@@ -1653,6 +1886,11 @@ void QRasterPaintEngine::fastFillRect(const QRect &rect, const QBrush &brush)
     Q_D(QRasterPaintEngine);
     Q_ASSERT(!d->antialiased && d->txop <= QTransform::TxTranslate);
 
+    if (d->recording) {
+        d->bands->recordFillRect(rect, brush);
+        return;
+    }
+
     int offset_x = int(d->matrix.dx());
     int offset_y = int(d->matrix.dy());
 
@@ -1679,8 +1917,13 @@ void QRasterPaintEngine::drawRects(const QRectF *rects, int rectCount)
 #ifdef QT_DEBUG_DRAW
     qDebug(" - QRasterPaintEngine::drawRect(), rectCount=%d", rectCount);
 #endif
-#ifdef QT_FAST_SPANS
     Q_D(QRasterPaintEngine);
+    if (d->recording) {
+        d->bands->recordRects(rects, rectCount);
+        return;
+    }
+
+#ifdef QT_FAST_SPANS
     if (d->tx_noshear) {
 
         if (d->brushData.blend) {
@@ -1759,6 +2002,11 @@ void QRasterPaintEngine::drawPath(const QPainterPath &path)
 
     Q_D(QRasterPaintEngine);
 
+    if (d->recording) {
+        d->bands->recordPath(path);
+        return;
+    }
+
     if (d->brushData.blend) {
         d->outlineMapper->setMatrix(d->matrix, d->txop);
         fillPath(path, &d->brushData);
@@ -1903,6 +2151,11 @@ void QRasterPaintEngine::drawPolygon(const QPointF *points, int pointCount, Poly
 #endif
     Q_ASSERT(pointCount >= 2);
 
+    if (d->recording) {
+        d->bands->recordPolygon(points, pointCount, mode);
+        return;
+    }
+
     // Do the fill
     if (d->brushData.blend && mode != PolylineMode)
         fillPolygon(points, pointCount, mode);
@@ -2000,6 +2253,11 @@ void QRasterPaintEngine::drawPolygon(const QPointF *points, int pointCount, Poly
 void QRasterPaintEngine::drawPolygon(const QPoint *points, int pointCount, PolygonDrawMode mode)
 {
     Q_D(QRasterPaintEngine);
+    if (d->recording) {
+        d->bands->recordPolygon(points, pointCount, mode);
+        return;
+    }
+
     if (!(d->int_xform && d->fast_pen)) {
         // this calls the float version
         QPaintEngine::drawPolygon(points, pointCount, mode);
@@ -2183,6 +2441,7 @@ void QRasterPaintEngine::drawPixmap(const QRectF &r, const QPixmap &pixmap, cons
         if (d->txop <= QTransform::TxTranslate
             && r.size() == sr.size()
             && r.size() == pixmap.size()) {
+            QRasterSerialPainting serial(d);
             d->drawBitmap(r.topLeft() + QPointF(d->matrix.dx(), d->matrix.dy()), pixmap, &d->penData);
             return;
         } else {
@@ -2225,13 +2484,17 @@ void QRasterPaintEngine::drawPixmap(const QRectF &r, const QPixmap &pixmap, cons
     \reimp
 */
 void QRasterPaintEngine::drawImage(const QRectF &r, const QImage &img, const QRectF &sr,
-                                   Qt::ImageConversionFlags)
+                                   Qt::ImageConversionFlags flags)
 {
 #ifdef QT_DEBUG_DRAW
     qDebug() << " - QRasterPaintEngine::drawImage(), r=" << r << " sr=" << sr << " image=" << img.size() << "depth=" << img.depth();
 #endif
 
     Q_D(QRasterPaintEngine);
+    if (d->recording && d->bands->recordImage(r, img, sr, flags))
+        return;
+    QRasterSerialPainting serial(d);
+
     QSpanData textureData;
     textureData.init(d->rasterBuffer, this);
     textureData.type = QSpanData::Texture;
@@ -2289,6 +2552,7 @@ void QRasterPaintEngine::drawTiledPixmap(const QRectF &r, const QPixmap &pixmap,
     qDebug() << " - QRasterPaintEngine::drawTiledPixmap(), r=" << r << "pixmap=" << pixmap.size();
 #endif
     Q_D(QRasterPaintEngine);
+    QRasterSerialPainting serial(d);
 
     QImage image;
     if (pixmap.depth() == 1)
@@ -2357,6 +2621,8 @@ void QRasterPaintEngine::alphaPenBlt(const void* src, int bpl, bool mono, int rx
     if (!d->penData.blend)
         return;
 
+    QRasterSerialPainting serial(d);
+
     QRasterBuffer *rb = d->rasterBuffer;
 
     const QRect rect(rx, ry, w, h);
@@ -2768,6 +3034,7 @@ void QRasterPaintEngine::drawTextItem(const QPointF &p, const QTextItem &textIte
            p.x(), p.y(), QString::fromRawData(ti.chars, ti.num_chars).toLatin1().data());
 #endif
     Q_D(QRasterPaintEngine);
+    QRasterSerialPainting serial(d);
 
     //### compute object space bounding box of text instead
     if (needsResolving(&d->penData)) {
@@ -3050,6 +3317,11 @@ void QRasterPaintEngine::drawPoints(const QPointF *points, int pointCount)
 {
     Q_D(QRasterPaintEngine);
 
+    if (d->recording) {
+        d->bands->recordPoints(points, pointCount);
+        return;
+    }
+
     double pw = d->pen.widthF();
 
     if (!d->fast_pen && (d->txop > QTransform::TxTranslate || pw > 1)) {
@@ -3126,6 +3398,10 @@ void QRasterPaintEngine::drawLines(const QLine *lines, int lineCount)
     Q_D(QRasterPaintEngine);
     if (!d->penData.blend)
         return;
+    if (d->recording) {
+        d->bands->recordLines(lines, lineCount);
+        return;
+    }
     if (d->fast_pen) {
         QRect bounds(0, 0, d->deviceRect.width(), d->deviceRect.height());
         LineDrawMode mode = d->pen.capStyle() == Qt::FlatCap
@@ -3190,6 +3466,10 @@ void QRasterPaintEngine::drawLines(const QLineF *lines, int lineCount)
     Q_D(QRasterPaintEngine);
     if (!d->penData.blend)
         return;
+    if (d->recording) {
+        d->bands->recordLines(lines, lineCount);
+        return;
+    }
     if (d->fast_pen) {
         QRect bounds(0, 0, d->deviceRect.width(), d->deviceRect.height());
         LineDrawMode mode = d->pen.capStyle() == Qt::FlatCap
@@ -3267,6 +3547,11 @@ void QRasterPaintEngine::drawEllipse(const QRectF &rect)
     if (!d->brushData.blend && !d->penData.blend)
         return;
 
+    if (d->recording) {
+        d->bands->recordEllipse(rect);
+        return;
+    }
+
     const QRectF r = d->matrix.mapRect(rect);
     ProcessSpans penBlend = d->getPenFunc(r, &d->penData);
     ProcessSpans brushBlend = d->getBrushFunc(r, &d->brushData);
@@ -3596,29 +3881,35 @@ static void qt_merge_clip(const QClipData *c1, const QClipData *c2, QClipData *r
         free(b);
 }
 
-void QRasterPaintEnginePrivate::initializeRasterizer(QSpanData *data)
+QRect QRasterPaintEnginePrivate::rasterizerClipRect() const
 {
-    rasterizer.setAntialiased(antialiased);
+    // A band engine uses the clip rect of the engine it renders for and
+    // leaves the clipping to its band to the blend function.
+    if (band_engine)
+        return replayRasterizerClip;
 
-    QRect clipRect;
-    ProcessSpans blend;
-    if (rasterBuffer->clipRect.isEmpty()) {
-        clipRect = deviceRect;
-        const QClipData *clip = rasterBuffer->clip;
-        if (rasterBuffer->clipEnabled && clip) {
-            const QRect r(QPoint(clip->xmin, clip->ymin),
-                          QPoint(clip->xmax, clip->ymax));
+    if (!rasterBuffer->clipRect.isEmpty())
+        return rasterBuffer->clipRect;
 
-            clipRect = clipRect.intersected(r);
-        }
-        blend = data->blend;
-    } else {
-        clipRect = rasterBuffer->clipRect;
-        blend = data->unclipped_blend;
+    QRect clipRect = deviceRect;
+    const QClipData *clip = rasterBuffer->clip;
+    if (rasterBuffer->clipEnabled && clip) {
+        const QRect r(QPoint(clip->xmin, clip->ymin),
+                      QPoint(clip->xmax, clip->ymax));
+
+        clipRect = clipRect.intersected(r);
     }
+    return clipRect;
+}
 
-    rasterizer.setClipRect(clipRect);
-    rasterizer.initialize(blend, data);
+void QRasterPaintEnginePrivate::initializeRasterizer(QSpanData *data)
+{
+    rasterizer.setAntialiased(antialiased);
+    rasterizer.setClipRect(rasterizerClipRect());
+    rasterizer.initialize(rasterBuffer->clipRect.isEmpty() || band_engine
+                          ? data->blend
+                          : data->unclipped_blend,
+                          data);
 }
 
 void QRasterPaintEnginePrivate::rasterize(QT_FT_Outline *outline,
@@ -4684,7 +4975,10 @@ class QGradientCache
     typedef QMultiHash<quint64, CacheInfo> QGradientColorTableHash;
 
 public:
+    inline QGradientCache() : holdCount(0) { }
+
     inline const uint *getBuffer(const QGradientStops &stops, int opacity) {
+        QMutexLocker locker(&mutex);
         quint64 hash_val = 0;
 
         for (int i = 0; i < stops.size() && i <= 2; i++)
@@ -4707,14 +5001,25 @@ public:
     }
 
     inline int paletteSize() const { return GRADIENT_STOPTABLE_SIZE; }
+
+    // The color tables are shared by the band engines of parallel
+    // rendering, so no table is evicted while a flush holds the cache.
+    inline void hold() {
+        QMutexLocker locker(&mutex);
+        ++holdCount;
+    }
+    inline void release() {
+        QMutexLocker locker(&mutex);
+        --holdCount;
+    }
 protected:
     inline int maxCacheSize() const { return 60; }
     inline void generateGradientColorTable(const QGradientStops& s,
                                            uint *colorTable,
                                            int size, int opacity) const;
     uint *addCacheElement(quint64 hash_val, const QGradientStops &stops, int opacity) {
-        if (cache.size() == maxCacheSize()) {
-            int elem_to_remove = qrand() % maxCacheSize();
+        while (holdCount == 0 && cache.size() >= maxCacheSize()) {
+            int elem_to_remove = qrand() % cache.size();
             cache.remove(cache.keys()[elem_to_remove]); // may remove more than 1, but OK
         }
         CacheInfo cache_entry(stops, opacity);
@@ -4723,6 +5028,8 @@ protected:
     }
 
     QGradientColorTableHash cache;
+    QMutex mutex;
+    int holdCount;
 };
 
 void QGradientCache::generateGradientColorTable(const QGradientStops& stops, uint *colorTable, int size, int opacity) const
@@ -4798,6 +5105,389 @@ void QGradientCache::generateGradientColorTable(const QGradientStops& stops, uin
 
 Q_GLOBAL_STATIC(QGradientCache, qt_gradient_cache)
 
+/*******************************************************************************
+ * QRasterBandRenderer
+ */
+#ifndef QT_NO_CONCURRENT
+// Plays the recorded commands back in one band, for QtConcurrent::blockingMap().
+struct QRasterBandReplay
+{
+    inline QRasterBandReplay(QRasterBandRenderer *renderer) : renderer(renderer) { }
+    inline void operator()(int band) const { renderer->replay(band); }
+
+    QRasterBandRenderer *renderer;
+};
+#endif // QT_NO_CONCURRENT
+
+template <typename T>
+static inline int qt_append_to_buffer(QDataBuffer<T> &buffer, const T *data, int count)
+{
+    const int index = buffer.size();
+    for (int i = 0; i < count; ++i)
+        buffer.add(data[i]);
+    return index;
+}
+
+/*
+    Creates \a bandCount band engines for the image \a engine paints on.
+    Each band engine paints on a QImage that shares the pixels of the
+    device and has its band as the system clip.
+*/
+QRasterBandRenderer::QRasterBandRenderer(QRasterPaintEngine *engine, int bandCount)
+    : engine(engine)
+{
+    const QRasterBuffer *rasterBuffer = engine->d_func()->rasterBuffer;
+    const int width = rasterBuffer->width();
+    const int height = rasterBuffer->height();
+
+    for (int i = 0; i < bandCount; ++i) {
+        const int top = i * height / bandCount;
+        const int bottom = (i + 1) * height / bandCount;
+
+        QImage *image = new QImage(rasterBuffer->buffer(), width, height,
+                                   rasterBuffer->bytesPerLine(), rasterBuffer->format);
+        image->paintEngine()->setSystemClip(QRegion(0, top, width, bottom - top));
+        QPainter *painter = new QPainter(image);
+        static_cast<QRasterPaintEngine *>(painter->paintEngine())->d_func()->band_engine = true;
+
+        bandImages << image;
+        bandPainters << painter;
+    }
+}
+
+QRasterBandRenderer::~QRasterBandRenderer()
+{
+    for (int i = 0; i < bandPainters.size(); ++i) {
+        bandPainters.at(i)->end();
+        delete bandPainters.at(i);
+        delete bandImages.at(i);
+    }
+    qDeleteAll(states);
+}
+
+/*
+    Returns the number of bands to split the image of \a rasterBuffer
+    into, or 0 if parallel rendering isn't worth it. There are twice as
+    many bands as threads to even out bands with more work than others.
+
+    Every band replays every recorded command, and pays for the state
+    changes, clipping and rasterizer setup of each, so thin bands spend
+    more time on setup than on pixels. Bands are therefore at least
+    MinBandHeight lines high. Neither number has been tuned on a
+    multi-core machine yet; tst_QPainterPerformance::parallelRendering
+    is there to do that.
+*/
+int QRasterBandRenderer::bandCount(const QRasterBuffer *rasterBuffer)
+{
+#ifdef QT_NO_CONCURRENT
+    Q_UNUSED(rasterBuffer);
+    return 0;
+#else
+    const int threads = QThreadPool::globalInstance()->maxThreadCount();
+    if (threads < 2)
+        return 0;
+    return qMin(2 * threads, rasterBuffer->height() / MinBandHeight);
+#endif
+}
+
+/*
+    Brings the band engines to the current state of the recording engine,
+    as described by \a state. The clip is rebuilt from the clip history of
+    the state, like QPainter::restore() does.
+*/
+void QRasterBandRenderer::begin(const QPainterState *state, const QPoint &redirectionOffset)
+{
+    QPainterState s(*state);
+    s.pen = engine->d_func()->pen;
+    prepareState(&s);
+
+    for (int i = 0; i < bandPainters.size(); ++i) {
+        QRasterPaintEngine *bandEngine = static_cast<QRasterPaintEngine *>(bandPainters.at(i)->paintEngine());
+
+        for (int j = 0; j < state->clipInfo.size(); ++j) {
+            const QPainterClipInfo &info = state->clipInfo.at(j);
+            s.matrix.setMatrix(info.matrix.m11(), info.matrix.m12(), info.matrix.m13(),
+                               info.matrix.m21(), info.matrix.m22(), info.matrix.m23(),
+                               info.matrix.dx() - redirectionOffset.x(),
+                               info.matrix.dy() - redirectionOffset.y(), info.matrix.m33());
+            s.clipOperation = info.operation;
+            if (info.clipType == QPainterClipInfo::RegionClip) {
+                s.clipRegion = info.region;
+                bandEngine->replayState(&s, QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyTransform);
+            } else {
+                s.clipPath = info.path;
+                bandEngine->replayState(&s, QPaintEngine::DirtyClipPath | QPaintEngine::DirtyTransform);
+            }
+        }
+        if (!state->clipInfo.isEmpty() && !state->clipEnabled)
+            bandEngine->replayState(&s, QPaintEngine::DirtyClipEnabled);
+
+        s.matrix = state->matrix;
+        bandEngine->d_func()->replay_pen_changed = true;
+        bandEngine->replayState(&s, QPaintEngine::DirtyPen | QPaintEngine::DirtyBrush
+                                | QPaintEngine::DirtyBrushOrigin | QPaintEngine::DirtyTransform
+                                | QPaintEngine::DirtyHints | QPaintEngine::DirtyCompositionMode
+                                | QPaintEngine::DirtyOpacity);
+    }
+}
+
+/*
+    Resolves everything in \a state that would otherwise be computed
+    lazily, and possibly at the same time, by the band engines.
+*/
+void QRasterBandRenderer::prepareState(QPainterState *state) const
+{
+    QRasterPaintEnginePrivate *d = engine->d_func();
+
+    state->brush = d->imageTextureBrush(state->brush);
+    if (state->pen.brush().style() == Qt::TexturePattern)
+        state->pen.setBrush(d->imageTextureBrush(state->pen.brush()));
+    state->pen.dashPattern();
+    state->clipPath.boundingRect();
+    state->clipPath.controlPointRect();
+    state->clipInfo.clear();
+}
+
+void QRasterBandRenderer::recordState(const QPaintEngineState &state)
+{
+    const QPaintEngine::DirtyFlags flags = QPaintEngine::DirtyPen | QPaintEngine::DirtyBrush
+                                           | QPaintEngine::DirtyBrushOrigin
+                                           | QPaintEngine::DirtyTransform
+                                           | QPaintEngine::DirtyClipRegion
+                                           | QPaintEngine::DirtyClipPath
+                                           | QPaintEngine::DirtyClipEnabled
+                                           | QPaintEngine::DirtyHints
+                                           | QPaintEngine::DirtyCompositionMode
+                                           | QPaintEngine::DirtyOpacity;
+    if (!(state.state() & flags))
+        return;
+
+    QPainterState *s = new QPainterState(static_cast<const QPainterState &>(state));
+    prepareState(s);
+
+    // Not add(), the engine hasn't finished updating its own state yet.
+    Command command = { State, true, states.size(), 0 };
+    commands.add(command);
+    states << s;
+}
+
+/*
+    Stores whether the recording engine took the pen of the last recorded
+    state, which the band engines then do as well.
+*/
+void QRasterBandRenderer::setPenChanged(bool changed)
+{
+    Q_ASSERT(!commands.isEmpty() && commands.last().type == State);
+    commands.at(commands.size() - 1).mode = changed;
+}
+
+void QRasterBandRenderer::add(CommandType type, int index, int count, int mode)
+{
+    // QRasterizer steps its edges from the top of its clip rect, so the
+    // band engines have to use the clip rect of this engine to produce
+    // the same coverage.
+    if (type != State) {
+        const QRect clip = engine->d_func()->rasterizerClipRect();
+        if (clip != rasterizerClip) {
+            rasterizerClip = clip;
+            rects.add(clip);
+            Command clipCommand = { RasterizerClip, 0, rects.size() - 1, 0 };
+            commands.add(clipCommand);
+        }
+    }
+
+    Command command = { type, mode, index, count };
+    commands.add(command);
+    if (commands.size() >= MaxCommands)
+        flush();
+}
+
+void QRasterBandRenderer::recordPath(const QPainterPath &path)
+{
+    path.boundingRect();
+    path.controlPointRect();
+    paths << path;
+    add(Path, paths.size() - 1);
+}
+
+void QRasterBandRenderer::recordPolygon(const QPointF *points, int pointCount,
+                                        QPaintEngine::PolygonDrawMode mode)
+{
+    add(PolygonF, qt_append_to_buffer(pointsF, points, pointCount), pointCount, mode);
+}
+
+void QRasterBandRenderer::recordPolygon(const QPoint *points, int pointCount,
+                                        QPaintEngine::PolygonDrawMode mode)
+{
+    add(Polygon, qt_append_to_buffer(this->points, points, pointCount), pointCount, mode);
+}
+
+void QRasterBandRenderer::recordEllipse(const QRectF &rect)
+{
+    rectsF.add(rect);
+    add(Ellipse, rectsF.size() - 1);
+}
+
+void QRasterBandRenderer::recordRects(const QRect *rects, int rectCount)
+{
+    add(Rects, qt_append_to_buffer(this->rects, rects, rectCount), rectCount);
+}
+
+void QRasterBandRenderer::recordRects(const QRectF *rects, int rectCount)
+{
+    add(RectsF, qt_append_to_buffer(rectsF, rects, rectCount), rectCount);
+}
+
+void QRasterBandRenderer::recordFillRect(const QRect &rect, const QBrush &brush)
+{
+    rects.add(rect);
+    brushes << engine->d_func()->imageTextureBrush(brush);
+    add(FillRect, rects.size() - 1, brushes.size() - 1);
+}
+
+/*
+    Returns false if \a image shares its pixels with the device; the
+    engine must draw it right away, as the pixels change with every
+    command played back.
+*/
+bool QRasterBandRenderer::recordImage(const QRectF &r, const QImage &image, const QRectF &sr,
+                                      Qt::ImageConversionFlags flags)
+{
+    const QRasterBuffer *rasterBuffer = engine->d_func()->rasterBuffer;
+    const uchar *bits = image.bits();
+    const uchar *buffer = rasterBuffer->buffer();
+    if (bits < buffer + rasterBuffer->bytesPerLine() * rasterBuffer->height()
+        && buffer < bits + image.numBytes())
+        return false;
+
+    // The pixels of an image that doesn't own them may change before
+    // they are played back.
+    if (const_cast<QImage &>(image).data_ptr()->own_data)
+        images << image;
+    else
+        images << image.copy();
+
+    rectsF.add(r);
+    rectsF.add(sr);
+    add(Image, rectsF.size() - 2, images.size() - 1, flags);
+    return true;
+}
+
+void QRasterBandRenderer::recordLines(const QLine *lines, int lineCount)
+{
+    add(Lines, qt_append_to_buffer(this->lines, lines, lineCount), lineCount);
+}
+
+void QRasterBandRenderer::recordLines(const QLineF *lines, int lineCount)
+{
+    add(LinesF, qt_append_to_buffer(linesF, lines, lineCount), lineCount);
+}
+
+void QRasterBandRenderer::recordPoints(const QPointF *points, int pointCount)
+{
+    add(PointsF, qt_append_to_buffer(pointsF, points, pointCount), pointCount);
+}
+
+/*
+    Plays back the recorded commands in all bands and waits for them to
+    finish.
+*/
+void QRasterBandRenderer::flush()
+{
+    if (commands.isEmpty())
+        return;
+
+    // the band engines look up color tables concurrently; don't let one
+    // of them evict a table that another one is painting with
+    qt_gradient_cache()->hold();
+
+#ifndef QT_NO_CONCURRENT
+    // the calling thread takes bands as well, so the playback finishes
+    // even when the thread pool is busy
+    QVector<int> bands(bandPainters.size());
+    for (int i = 0; i < bands.size(); ++i)
+        bands[i] = i;
+    QtConcurrent::blockingMap(bands, QRasterBandReplay(this));
+#else
+    for (int i = 0; i < bandPainters.size(); ++i)
+        replay(i);
+#endif
+
+    qt_gradient_cache()->release();
+
+    commands.reset();
+    qDeleteAll(states);
+    states.clear();
+    paths.clear();
+    images.clear();
+    brushes.clear();
+    pointsF.reset();
+    points.reset();
+    rectsF.reset();
+    rects.reset();
+    linesF.reset();
+    lines.reset();
+}
+
+/*
+    Plays back the recorded commands in \a band. Called from the thread
+    pool; the band engine is only used by one thread at a time.
+*/
+void QRasterBandRenderer::replay(int band)
+{
+    QRasterPaintEngine *bandEngine = static_cast<QRasterPaintEngine *>(bandPainters.at(band)->paintEngine());
+
+    for (int i = 0; i < commands.size(); ++i) {
+        const Command &command = commands.at(i);
+        switch (command.type) {
+        case State:
+            bandEngine->d_func()->replay_pen_changed = command.mode;
+            bandEngine->updateState(*states.at(command.index));
+            break;
+        case RasterizerClip:
+            bandEngine->d_func()->replayRasterizerClip = rects.at(command.index);
+            break;
+        case Path:
+            bandEngine->drawPath(paths.at(command.index));
+            break;
+        case PolygonF:
+            bandEngine->drawPolygon(pointsF.data() + command.index, command.count,
+                                    QPaintEngine::PolygonDrawMode(command.mode));
+            break;
+        case Polygon:
+            bandEngine->drawPolygon(points.data() + command.index, command.count,
+                                    QPaintEngine::PolygonDrawMode(command.mode));
+            break;
+        case Ellipse:
+            bandEngine->drawEllipse(rectsF.at(command.index));
+            break;
+        case RectsF:
+            bandEngine->drawRects(rectsF.data() + command.index, command.count);
+            break;
+        case Rects:
+            bandEngine->drawRects(rects.data() + command.index, command.count);
+            break;
+        case FillRect:
+            bandEngine->fastFillRect(rects.at(command.index), brushes.at(command.count));
+            break;
+        case Image:
+            bandEngine->drawImage(rectsF.at(command.index), images.at(command.count),
+                                  rectsF.at(command.index + 1),
+                                  Qt::ImageConversionFlags(command.mode));
+            break;
+        case Lines:
+            bandEngine->drawLines(lines.data() + command.index, command.count);
+            break;
+        case LinesF:
+            bandEngine->drawLines(linesF.data() + command.index, command.count);
+            break;
+        case PointsF:
+            bandEngine->drawPoints(pointsF.data() + command.index, command.count);
+            break;
+        }
+    }
+}
+
 
 void QSpanData::init(QRasterBuffer *rb, QRasterPaintEngine *pe)
 {
@@ -41,6 +41,8 @@ class QFTOutlineMapper;
 class QRasterPaintEnginePrivate;
 class QRasterBuffer;
 class QClipData;
+class QRasterBandRenderer;
+class QPainterState;
 
 /*******************************************************************************
  * QRasterPaintEngine
@@ -136,7 +138,11 @@ public:
 protected:
     QRasterPaintEngine(QRasterPaintEnginePrivate &d);
 private:
+    friend class QRasterBandRenderer;
     void init();
+    void startParallelRendering(const QPaintEngineState &state);
+    void finishParallelRendering();
+    void replayState(QPainterState *state, DirtyFlags flags);
 
 #if defined(Q_WS_WIN)
     bool drawTextInFontBuffer(const QRect &devRect, int xmin, int ymin, int xmax,
@@ -180,6 +186,11 @@ public:
 
     void initializeRasterizer(QSpanData *data);
 
+    bool penChanged(const QPaintEngineState &state);
+    void updateRecording();
+    QRect rasterizerClipRect() const;
+    QBrush imageTextureBrush(const QBrush &brush) const;
+
     QPointF brushOffset;
     QBrush brush;
     QPen pen;
@@ -235,9 +246,38 @@ public:
     uint isPlain45DegreeRotation : 1;
 #endif
 
+    // QPainter::ParallelRendering
+    QRasterBandRenderer *bands;
+    uint recording : 1;
+    uint serial : 1;
+    uint band_engine : 1;
+    uint replay_pen_changed : 1;
+    QRect replayRasterizerClip;
+
     QRasterizer rasterizer;
 };
 
+class QRasterSerialPainting
+{
+public:
+    inline QRasterSerialPainting(QRasterPaintEnginePrivate *d)
+        : d(d), wasSerial(d->serial)
+    {
+        d->serial = true;
+        d->updateRecording();
+    }
+
+    inline ~QRasterSerialPainting()
+    {
+        d->serial = wasSerial;
+        d->updateRecording();
+    }
+
+private:
+    QRasterPaintEnginePrivate *d;
+    bool wasSerial;
+};
+
 class QClipData {
 public:
     QClipData(int height);
@@ -986,6 +986,12 @@ void QPainterPrivate::updateState(QPainterState *newState)
     indicating that the engine should use fragment programs and offscreen
     rendering for antialiasing.
 
+    \value ParallelRendering Indicates that the raster engine may
+    rasterize into a QImage from several threads at once. Drawing
+    commands are recorded and played back in horizontal bands of the
+    image using the global QThreadPool; the result is identical to
+    serial rendering. (This hint was introduced in Qt 4.4.)
+
     \sa renderHints(), setRenderHint(), {QPainter#Rendering
     Quality}{Rendering Quality}, {Concentric Circles Example}
 
@@ -61,7 +61,8 @@ public:
         Antialiasing = 0x01,
         TextAntialiasing = 0x02,
         SmoothPixmapTransform = 0x04,
-        HighQualityAntialiasing = 0x08
+        HighQualityAntialiasing = 0x08,
+        ParallelRendering = 0x10
     };
 
     Q_DECLARE_FLAGS(RenderHints, RenderHint)
@@ -401,6 +401,20 @@ QAbstractSocketPrivate::~QAbstractSocketPrivate()
 #endif
 }
 
+/*! \internal
+
+    Hands out the blocks of the socket's read buffer directly.
+*/
+QByteArray QAbstractSocketPrivate::readChunkHelper(bool peek)
+{
+    if (!isBuffered)
+        return QIODevicePrivate::readChunkHelper(peek);
+
+    if (socketEngine && !socketEngine->isReadNotificationEnabled() && socketEngine->isValid())
+        socketEngine->setReadNotificationEnabled(true);
+    return peek ? readBuffer.peekChunk() : readBuffer.readChunk();
+}
+
 /*! \internal
 
     Resets the socket layer, clears the read and write buffers and
@@ -1859,11 +1873,15 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
         return written;
     }
 
-    char *ptr = d->writeBuffer.reserve(size);
-    if (size == 1)
-        *ptr = *data;
-    else
-        memcpy(ptr, data, size);
+    if (d->isCurrentWriteChunk(data, size)) {
+        d->writeBuffer.append(*d->currentWriteChunk);
+    } else {
+        char *ptr = d->writeBuffer.reserve(size);
+        if (size == 1)
+            *ptr = *data;
+        else
+            memcpy(ptr, data, size);
+    }
 
     qint64 written = size;
 
@@ -45,6 +45,8 @@ public:
     QAbstractSocketPrivate();
     virtual ~QAbstractSocketPrivate();
 
+    QByteArray readChunkHelper(bool peek);
+
     // from QAbstractSocketEngineReceiver
     inline void readNotification() { canReadNotification(); }
     inline void writeNotification() { canWriteNotification(); }
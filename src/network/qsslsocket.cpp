@@ -1368,11 +1368,18 @@ qint64 QSslSocket::writeData(const char *data, qint64 len)
 #ifdef QSSLSOCKET_DEBUG
     qDebug() << "QSslSocket::writeData(" << (void *)data << "," << len << ")";
 #endif
-    if (d->mode == UnencryptedMode && !d->autoStartHandshake)
+    if (d->mode == UnencryptedMode && !d->autoStartHandshake) {
+        if (d->isCurrentWriteChunk(data, len))
+            return d->plainSocket->write(*d->currentWriteChunk);
         return d->plainSocket->write(data, len);
+    }
 
-    char *writePtr = d->writeBuffer.reserve(len);
-    ::memcpy(writePtr, data, len);
+    if (d->isCurrentWriteChunk(data, len)) {
+        d->writeBuffer.append(*d->currentWriteChunk);
+    } else {
+        char *writePtr = d->writeBuffer.reserve(len);
+        ::memcpy(writePtr, data, len);
+    }
 
     if (d->connectionEncrypted)
         d->transmit();
@@ -1395,6 +1402,16 @@ QSslSocketPrivate::~QSslSocketPrivate()
 {
 }
 
+/*!
+    \internal
+*/
+QByteArray QSslSocketPrivate::readChunkHelper(bool peek)
+{
+    if (mode == QSslSocket::UnencryptedMode && !autoStartHandshake)
+        return peek ? plainSocket->peekChunk() : plainSocket->readChunk();
+    return peek ? readBuffer.peekChunk() : readBuffer.readChunk();
+}
+
 /*!
     \internal
 */
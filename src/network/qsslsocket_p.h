@@ -58,6 +58,8 @@ public:
     QSslSocketPrivate();
     virtual ~QSslSocketPrivate();
 
+    QByteArray readChunkHelper(bool peek);
+
     void init();
 
     QSslSocket::SslMode mode;
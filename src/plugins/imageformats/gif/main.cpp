@@ -64,6 +64,7 @@ QImageIOHandler *QGifPlugin::create(QIODevice *device, const QByteArray &format)
 
 Q_EXPORT_STATIC_PLUGIN(QGifPlugin)
 Q_EXPORT_PLUGIN2(qgif, QGifPlugin)
+Q_PLUGIN_METADATA_KEYS(QImageIOHandlerFactoryInterface_iid, "gif")
 
 #endif // QT_NO_IMAGEFORMATPLUGIN
 
@@ -63,6 +63,7 @@ QImageIOHandler *QJpegPlugin::create(QIODevice *device, const QByteArray &format
 
 Q_EXPORT_STATIC_PLUGIN(QJpegPlugin)
 Q_EXPORT_PLUGIN2(qjpeg, QJpegPlugin)
+Q_PLUGIN_METADATA_KEYS(QImageIOHandlerFactoryInterface_iid, "jpeg;jpg")
 
 QT_END_NAMESPACE
 
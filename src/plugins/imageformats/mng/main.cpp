@@ -64,6 +64,7 @@ QImageIOHandler *QMngPlugin::create(QIODevice *device, const QByteArray &format)
 
 Q_EXPORT_STATIC_PLUGIN(QMngPlugin)
 Q_EXPORT_PLUGIN2(qmng, QMngPlugin)
+Q_PLUGIN_METADATA_KEYS(QImageIOHandlerFactoryInterface_iid, "mng")
 
 QT_END_NAMESPACE
 
@@ -68,6 +68,7 @@ QImageIOHandler *QSvgPlugin::create(QIODevice *device, const QByteArray &format)
 
 Q_EXPORT_STATIC_PLUGIN(QSvgPlugin)
 Q_EXPORT_PLUGIN2(qsvg, QSvgPlugin)
+Q_PLUGIN_METADATA_KEYS(QImageIOHandlerFactoryInterface_iid, "svg")
 
 QT_END_NAMESPACE
 
@@ -63,6 +63,7 @@ QStringList QTiffPlugin::keys() const
 
 Q_EXPORT_STATIC_PLUGIN(QTiffPlugin)
 Q_EXPORT_PLUGIN2(qtiff, QTiffPlugin)
+Q_PLUGIN_METADATA_KEYS(QImageIOHandlerFactoryInterface_iid, "tiff;tif")
 
 QT_END_NAMESPACE
 
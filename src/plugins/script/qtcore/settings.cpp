@@ -220,6 +220,7 @@ QScriptValue constructSettingsClass(QScriptEngine *eng)
 
     ADD_ENUM_VALUE(ctorFun, QSettings, NativeFormat);
     ADD_ENUM_VALUE(ctorFun, QSettings, IniFormat);
+    ADD_ENUM_VALUE(ctorFun, QSettings, BinaryFormat);
     ADD_ENUM_VALUE(ctorFun, QSettings, InvalidFormat);
     ADD_ENUM_VALUE(ctorFun, QSettings, CustomFormat1);
     ADD_ENUM_VALUE(ctorFun, QSettings, CustomFormat2);
@@ -49,5 +49,6 @@ QStringList QDB2DriverPlugin::keys() const
 
 Q_EXPORT_STATIC_PLUGIN(QDB2DriverPlugin)
 Q_EXPORT_PLUGIN2(qsqldb2, QDB2DriverPlugin)
+Q_PLUGIN_METADATA_KEYS(QSqlDriverFactoryInterface_iid, "QDB2")
 
 QT_END_NAMESPACE
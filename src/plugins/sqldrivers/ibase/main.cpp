@@ -49,5 +49,6 @@ QStringList QIBaseDriverPlugin::keys() const
 
 Q_EXPORT_STATIC_PLUGIN(QIBaseDriverPlugin)
 Q_EXPORT_PLUGIN2(qsqlibase, QIBaseDriverPlugin)
+Q_PLUGIN_METADATA_KEYS(QSqlDriverFactoryInterface_iid, "QIBASE")
 
 QT_END_NAMESPACE
@@ -50,5 +50,6 @@ QStringList QMYSQLDriverPlugin::keys() const
 
 Q_EXPORT_STATIC_PLUGIN(QMYSQLDriverPlugin)
 Q_EXPORT_PLUGIN2(qsqlmysql, QMYSQLDriverPlugin)
+Q_PLUGIN_METADATA_KEYS(QSqlDriverFactoryInterface_iid, "QMYSQL3;QMYSQL")
 
 QT_END_NAMESPACE
@@ -50,5 +50,6 @@ QStringList QOCIDriverPlugin::keys() const
 
 Q_EXPORT_STATIC_PLUGIN(QOCIDriverPlugin)
 Q_EXPORT_PLUGIN2(qsqloci, QOCIDriverPlugin)
+Q_PLUGIN_METADATA_KEYS(QSqlDriverFactoryInterface_iid, "QOCI8;QOCI")
 
 QT_END_NAMESPACE
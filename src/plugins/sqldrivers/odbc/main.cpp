@@ -50,5 +50,6 @@ QStringList QODBCDriverPlugin::keys() const
 
 Q_EXPORT_STATIC_PLUGIN(QODBCDriverPlugin)
 Q_EXPORT_PLUGIN2(qsqlodbc, QODBCDriverPlugin)
+Q_PLUGIN_METADATA_KEYS(QSqlDriverFactoryInterface_iid, "QODBC3;QODBC")
 
 QT_END_NAMESPACE
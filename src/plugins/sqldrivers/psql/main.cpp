@@ -50,5 +50,6 @@ QStringList QPSQLDriverPlugin::keys() const
 
 Q_EXPORT_STATIC_PLUGIN(QPSQLDriverPlugin)
 Q_EXPORT_PLUGIN2(qsqlpsql, QPSQLDriverPlugin)
+Q_PLUGIN_METADATA_KEYS(QSqlDriverFactoryInterface_iid, "QPSQL7;QPSQL")
 
 QT_END_NAMESPACE
@@ -49,5 +49,6 @@ QStringList QSQLiteDriverPlugin::keys() const
 
 Q_EXPORT_STATIC_PLUGIN(QSQLiteDriverPlugin)
 Q_EXPORT_PLUGIN2(qsqlite, QSQLiteDriverPlugin)
+Q_PLUGIN_METADATA_KEYS(QSqlDriverFactoryInterface_iid, "QSQLITE")
 
 QT_END_NAMESPACE
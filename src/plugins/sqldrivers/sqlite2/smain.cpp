@@ -49,5 +49,6 @@ QStringList QSQLite2DriverPlugin::keys() const
 
 Q_EXPORT_STATIC_PLUGIN(QSQLite2DriverPlugin)
 Q_EXPORT_PLUGIN2(qsqlite2, QSQLite2DriverPlugin)
+Q_PLUGIN_METADATA_KEYS(QSqlDriverFactoryInterface_iid, "QSQLITE2")
 
 QT_END_NAMESPACE
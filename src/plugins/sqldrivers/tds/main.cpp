@@ -57,5 +57,6 @@ QStringList QTDSDriverPlugin::keys() const
 
 Q_EXPORT_STATIC_PLUGIN(QTDSDriverPlugin)
 Q_EXPORT_PLUGIN2(qsqltds, QTDSDriverPlugin)
+Q_PLUGIN_METADATA_KEYS(QSqlDriverFactoryInterface_iid, "QTDS7;QTDS")
 
 QT_END_NAMESPACE
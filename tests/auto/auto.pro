@@ -67,6 +67,7 @@ SUBDIRS += bic \
            qbitarray \
            qboxlayout \
            qbrush \
+           qbtreemap \
            qbuffer \
            qbuttongroup \
            qbytearray \
@@ -77,6 +78,7 @@ SUBDIRS += bic \
            qclipboard \
            qcolor \
            qcombobox \
+           qcompressiondevice \
            qcompleter \
            qcomplextext \
            qcopchannel \
@@ -109,6 +111,7 @@ SUBDIRS += bic \
            qfileinfo \
            qfilesystemwatcher \
            qflags \
+           qflathash \
            qfocusevent \
            qfocusframe \
            qfont \
@@ -116,6 +119,8 @@ SUBDIRS += bic \
            qfontdialog \
            qfontmetrics \
            qftp \
+           qfuture \
+           qfuturewatcher \
            qgl \
            qglobal \
            qgraphicsitem \
@@ -259,6 +264,9 @@ SUBDIRS += bic \
            qtableview \
            qtablewidget \
            qtabwidget \
+           qtconcurrentfilter \
+           qtconcurrentmap \
+           qtconcurrentrun \
            qtcpserver \
            qtcpsocket \
            qtemporaryfile \
@@ -279,6 +287,7 @@ SUBDIRS += bic \
            qtextstream \
            qtexttable \
            qthread \
+           qthreadpool \
            qthreadstorage \
            qtime \
            qtimeline \
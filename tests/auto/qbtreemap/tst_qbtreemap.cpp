@@ -0,0 +1,501 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qbtreemap.h>
+#include <qmap.h>
+
+//TESTED_CLASS=
+//TESTED_FILES=corelib/tools/qbtreemap.h corelib/tools/qbtreemap.cpp
+
+class tst_QBTreeMap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insert();
+    void count();
+    void implicitSharing();
+    void iterators();
+    void javaIterators();
+    void bounds();
+    void multi();
+    void erase();
+    void take();
+    void keysValues();
+    void compare();
+    void sortedInsertion();
+    void churn();
+};
+
+class Counted
+{
+public:
+    Counted() { ++count; }
+    Counted(const QString &s) : str(s) { ++count; }
+    Counted(const Counted &o) : str(o.str) { ++count; }
+    ~Counted() { --count; }
+    Counted &operator=(const Counted &o) { str = o.str; return *this; }
+    bool operator==(const Counted &o) const { return str == o.str; }
+
+    QString str;
+    static int count;
+};
+
+int Counted::count = 0;
+
+// keeps the moves within the nodes on the copy-construct path
+Q_DECLARE_TYPEINFO(Counted, Q_COMPLEX_TYPE);
+
+template <class Key, class T>
+static bool sameItems(const QBTreeMap<Key, T> &map, const QMap<Key, T> &reference)
+{
+    if (map.size() != reference.size())
+        return false;
+    typename QBTreeMap<Key, T>::const_iterator it = map.constBegin();
+    typename QMap<Key, T>::const_iterator rit = reference.constBegin();
+    for (; rit != reference.constEnd(); ++it, ++rit) {
+        if (it == map.constEnd() || !(it.key() == rit.key()) || !(it.value() == rit.value()))
+            return false;
+    }
+    return it == map.constEnd();
+}
+
+void tst_QBTreeMap::insert()
+{
+    QBTreeMap<int, QString> map;
+    QVERIFY(map.isEmpty());
+    QVERIFY(!map.contains(0));
+    QCOMPARE(map.value(0), QString());
+    QCOMPARE(map.value(0, QString("x")), QString("x"));
+    QVERIFY(map.constFind(0) == map.constEnd());
+    QVERIFY(map.lowerBound(0) == map.end());
+
+    // odd keys in a scrambled order, so that nodes split all over
+    for (int i = 0; i < 5000; ++i) {
+        int k = (i * 7919) % 5000;
+        map.insert(k * 2 + 1, QString::number(k * 2 + 1));
+    }
+    QCOMPARE(map.size(), 5000);
+    for (int i = 0; i < 10000; ++i) {
+        QCOMPARE(map.contains(i), bool(i % 2));
+        QCOMPARE(map.value(i), i % 2 ? QString::number(i) : QString());
+    }
+    QVERIFY(!map.contains(-1));
+    QVERIFY(!map.contains(10001));
+
+    int previous = -1;
+    int n = 0;
+    for (QBTreeMap<int, QString>::const_iterator it = map.constBegin(); it != map.constEnd(); ++it) {
+        QVERIFY(it.key() > previous);
+        QCOMPARE(it.value(), QString::number(it.key()));
+        previous = it.key();
+        ++n;
+    }
+    QCOMPARE(n, 5000);
+
+    QBTreeMap<int, QString>::iterator it = map.insert(11, QString("eleven"));
+    QCOMPARE(it.key(), 11);
+    QCOMPARE(*it, QString("eleven"));
+    QCOMPARE(map.size(), 5000);
+
+    map[11] = QString("ELEVEN");
+    QCOMPARE(map.value(11), QString("ELEVEN"));
+    QCOMPARE(map[12], QString());
+    QCOMPARE(map.size(), 5001);
+
+    const QBTreeMap<int, QString> &cmap = map;
+    QCOMPARE(cmap[14], QString());
+    QCOMPARE(map.size(), 5001);
+
+    QCOMPARE(map.remove(11), 1);
+    QCOMPARE(map.remove(11), 0);
+    QCOMPARE(map.size(), 5000);
+
+    map.clear();
+    QVERIFY(map.isEmpty());
+    QVERIFY(map.constBegin() == map.constEnd());
+}
+
+void tst_QBTreeMap::count()
+{
+    {
+        QBTreeMap<QString, Counted> map;
+        QBTreeMap<QString, Counted> map2(map);
+        map2["Hallo"] = Counted("Fritz");
+        QCOMPARE(map.count(), 0);
+        QCOMPARE(map2.count(), 1);
+        QCOMPARE(Counted::count, 1);
+    }
+    QCOMPARE(Counted::count, 0);
+
+    {
+        QBTreeMap<int, Counted> map;
+        for (int i = 0; i < 2000; ++i)
+            map.insert((i * 37) % 2000, Counted(QString::number(i)));
+        QCOMPARE(Counted::count, 2000);
+
+        QBTreeMap<int, Counted> map2 = map;
+        map2.insert(5000, Counted("x"));
+        QCOMPARE(Counted::count, 4001);
+
+        for (int i = 0; i < 2000; i += 2)
+            map.remove(i);
+        QCOMPARE(Counted::count, 3001);
+
+        map2 = map;
+        QCOMPARE(Counted::count, 1000);
+
+        for (int i = 1; i < 2000; i += 2)
+            map.remove(i);
+        QVERIFY(map.isEmpty());
+        QCOMPARE(Counted::count, 1000);
+    }
+    QCOMPARE(Counted::count, 0);
+}
+
+void tst_QBTreeMap::implicitSharing()
+{
+    QBTreeMap<int, int> map;
+    for (int i = 0; i < 1000; ++i)
+        map.insert(i, i * 2);
+
+    QBTreeMap<int, int> copy = map;
+    QVERIFY(!map.isDetached());
+
+    copy[5] = 0;
+    QVERIFY(map.isDetached());
+    QVERIFY(copy.isDetached());
+    QCOMPARE(map.value(5), 10);
+    QCOMPARE(copy.value(5), 0);
+
+    copy = map;
+    copy.remove(7);
+    QVERIFY(map.contains(7));
+    QVERIFY(!copy.contains(7));
+
+    copy = map;
+    *copy.find(9) = -1;
+    QCOMPARE(map.value(9), 18);
+    QCOMPARE(copy.value(9), -1);
+
+    copy = map;
+    copy.setSharable(false);
+    QBTreeMap<int, int> copy2 = copy;
+    QVERIFY(copy.isDetached());
+    QVERIFY(copy2.isDetached());
+    QCOMPARE(copy2, map);
+    copy.setSharable(true);
+}
+
+void tst_QBTreeMap::iterators()
+{
+    QBTreeMap<int, int> map;
+    QVERIFY(map.begin() == map.end());
+
+    for (int i = 0; i < 1000; ++i)
+        map.insert(999 - i, i);
+
+    // forward and backward iteration over several leaves
+    int k = 0;
+    for (QBTreeMap<int, int>::const_iterator it = map.constBegin(); it != map.constEnd(); ++it)
+        QCOMPARE(it.key(), k++);
+    QCOMPARE(k, 1000);
+
+    QBTreeMap<int, int>::const_iterator it = map.constEnd();
+    while (it != map.constBegin()) {
+        --it;
+        QCOMPARE(it.key(), --k);
+        QCOMPARE(*it, 999 - k);
+    }
+    QCOMPARE(k, 0);
+
+    QBTreeMap<int, int>::iterator mit = map.begin();
+    mit += 500;
+    QCOMPARE(mit.key(), 500);
+    mit -= 250;
+    QCOMPARE(mit.key(), 250);
+    QCOMPARE((mit + 3).key(), 253);
+    QCOMPARE((mit - 3).key(), 247);
+    QCOMPARE((map.end() - 1).key(), 999);
+
+    for (mit = map.begin(); mit != map.end(); ++mit)
+        mit.value() = -mit.key();
+    QCOMPARE(map.value(123), -123);
+
+    int sum = 0;
+    foreach (int value, map)
+        sum += value;
+    QCOMPARE(sum, -999 * 1000 / 2);
+}
+
+void tst_QBTreeMap::javaIterators()
+{
+    QBTreeMap<int, int> map;
+    for (int i = 0; i < 500; ++i)
+        map.insert(i, i);
+
+    int expected = 0;
+    QBTreeMapIterator<int, int> i(map);
+    while (i.hasNext()) {
+        i.next();
+        QCOMPARE(i.key(), expected++);
+    }
+    while (i.hasPrevious()) {
+        i.previous();
+        QCOMPARE(i.key(), --expected);
+    }
+
+    QMutableBTreeMapIterator<int, int> j(map);
+    while (j.hasNext()) {
+        if (j.next().key() % 2)
+            j.remove();
+        else
+            j.setValue(-j.value());
+    }
+    QCOMPARE(map.size(), 250);
+    QCOMPARE(map.value(10), -10);
+    QVERIFY(!map.contains(11));
+}
+
+void tst_QBTreeMap::bounds()
+{
+    QBTreeMap<int, int> map;
+    for (int i = 0; i < 3000; ++i)
+        map.insert(i * 10, i);
+
+    QCOMPARE(map.lowerBound(-5).key(), 0);
+    QCOMPARE(map.lowerBound(0).key(), 0);
+    QCOMPARE(map.lowerBound(5).key(), 10);
+    QCOMPARE(map.lowerBound(10).key(), 10);
+    QCOMPARE(map.upperBound(10).key(), 20);
+    QCOMPARE(map.upperBound(15).key(), 20);
+    QVERIFY(map.lowerBound(29991) == map.end());
+    QVERIFY(map.upperBound(29990) == map.end());
+    QCOMPARE(map.lowerBound(29990).key(), 29990);
+
+    // count the items in a range
+    for (int lo = 0; lo < 30000; lo += 997) {
+        int hi = lo + 1234;
+        int n = 0;
+        const QBTreeMap<int, int> &cmap = map;
+        QBTreeMap<int, int>::const_iterator it = cmap.lowerBound(lo);
+        QBTreeMap<int, int>::const_iterator end = cmap.upperBound(hi);
+        for (; it != end; ++it) {
+            QVERIFY(it.key() >= lo && it.key() <= hi);
+            ++n;
+        }
+        int expected = 0;
+        for (int k = lo; k <= hi && k < 30000; ++k)
+            expected += (k % 10 == 0);
+        QCOMPARE(n, expected);
+    }
+}
+
+void tst_QBTreeMap::multi()
+{
+    // enough equal keys to straddle several leaves
+    QBTreeMap<int, int> map;
+    QMap<int, int> reference;
+    for (int i = 0; i < 1000; ++i) {
+        int key = (i * 13) % 5;
+        map.insertMulti(key, i);
+        reference.insertMulti(key, i);
+    }
+    QVERIFY(sameItems(map, reference));
+
+    for (int key = -1; key <= 5; ++key) {
+        QCOMPARE(map.count(key), reference.count(key));
+        QCOMPARE(map.values(key), reference.values(key));
+        QCOMPARE(map.value(key, -1), reference.value(key, -1));
+        QCOMPARE(map.contains(key), reference.contains(key));
+    }
+    QCOMPARE(map.uniqueKeys(), reference.uniqueKeys());
+    QCOMPARE(map.keys(), reference.keys());
+
+    // insert() replaces the most recently inserted value
+    map.insert(3, -3);
+    reference.insert(3, -3);
+    QVERIFY(sameItems(map, reference));
+
+    QCOMPARE(map.take(2), reference.take(2));
+    QVERIFY(sameItems(map, reference));
+
+    QCOMPARE(map.remove(1), reference.remove(1));
+    QVERIFY(sameItems(map, reference));
+
+    QBTreeMap<int, int> other;
+    QMap<int, int> otherReference;
+    for (int i = 0; i < 300; ++i) {
+        other.insertMulti(i % 7, -i);
+        otherReference.insertMulti(i % 7, -i);
+    }
+    map.unite(other);
+    reference.unite(otherReference);
+    QVERIFY(sameItems(map, reference));
+}
+
+void tst_QBTreeMap::erase()
+{
+    QBTreeMap<int, int> map;
+    for (int i = 0; i < 3000; ++i)
+        map.insert(i, i);
+
+    QBTreeMap<int, int>::iterator it = map.begin();
+    while (it != map.end()) {
+        if (it.key() % 3)
+            it = map.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(map.size(), 1000);
+    int k = 0;
+    for (it = map.begin(); it != map.end(); ++it, k += 3)
+        QCOMPARE(it.key(), k);
+
+    // erasing everything from the back
+    while (!map.isEmpty()) {
+        it = map.erase(map.end() - 1);
+        QVERIFY(it == map.end());
+    }
+    QVERIFY(map.begin() == map.end());
+    QVERIFY(map.erase(map.end()) == map.end());
+
+    map.insert(1, 1);
+    QCOMPARE(map.value(1), 1);
+}
+
+void tst_QBTreeMap::take()
+{
+    QBTreeMap<QString, Counted> map;
+    map.insert("a", Counted("A"));
+    map.insert("b", Counted("B"));
+
+    QCOMPARE(map.take("a").str, QString("A"));
+    QCOMPARE(map.take("a").str, QString());
+    QCOMPARE(map.size(), 1);
+
+    QBTreeMap<QString, Counted> copy = map;
+    QCOMPARE(copy.take("b").str, QString("B"));
+    QVERIFY(copy.isEmpty());
+    QCOMPARE(map.size(), 1);
+
+    map.clear();
+    QCOMPARE(Counted::count, 0);
+}
+
+void tst_QBTreeMap::keysValues()
+{
+    QBTreeMap<QString, int> map;
+    QVERIFY(map.keys().isEmpty());
+    QVERIFY(map.values().isEmpty());
+
+    map.insert("one", 1);
+    map.insert("two", 2);
+    map.insert("deux", 2);
+
+    QCOMPARE(map.keys(), QList<QString>() << "deux" << "one" << "two");
+    QCOMPARE(map.values(), QList<int>() << 2 << 1 << 2);
+    QCOMPARE(map.keys(2), QList<QString>() << "deux" << "two");
+    QCOMPARE(map.key(1), QString("one"));
+    QCOMPARE(map.key(3), QString());
+    QCOMPARE(map.key(3, QString("none")), QString("none"));
+}
+
+void tst_QBTreeMap::compare()
+{
+    QBTreeMap<int, QString> a;
+    QBTreeMap<int, QString> b;
+    QVERIFY(a == b);
+
+    // the same items in a different tree shape still compare equal
+    for (int i = 0; i < 1000; ++i)
+        a.insert(i, QString::number(i));
+    for (int i = 999; i >= 0; --i)
+        b.insert(i, QString::number(i));
+    QVERIFY(a == b);
+    QVERIFY(!(a != b));
+
+    b[500] = QString("five hundred");
+    QVERIFY(a != b);
+    b.remove(500);
+    QVERIFY(a != b);
+}
+
+void tst_QBTreeMap::sortedInsertion()
+{
+    QBTreeMap<int, int> map;
+    QMap<int, int> reference;
+    for (int i = 0; i < 100000; ++i) {
+        map.insert(i, i);
+        reference.insert(i, i);
+    }
+    QVERIFY(sameItems(map, reference));
+
+    // inserting in the middle of completely full nodes
+    for (int i = 0; i < 100000; i += 1000) {
+        map.insertMulti(i, -i);
+        reference.insertMulti(i, -i);
+    }
+    QVERIFY(sameItems(map, reference));
+    for (int i = 0; i < 100000; i += 777)
+        QCOMPARE(map.value(i), reference.value(i));
+}
+
+void tst_QBTreeMap::churn()
+{
+    // random inserts and removals against QMap as a reference, so that
+    // nodes keep splitting, merging and disappearing
+    QBTreeMap<int, int> map;
+    QMap<int, int> reference;
+    qsrand(1);
+    for (int round = 0; round < 200000; ++round) {
+        int key = qrand() % 2048;
+        switch (qrand() % 5) {
+        case 0:
+        case 1:
+            map.insert(key, round);
+            reference.insert(key, round);
+            break;
+        case 2:
+            map.insertMulti(key, round);
+            reference.insertMulti(key, round);
+            break;
+        case 3:
+            QCOMPARE(map.remove(key), reference.remove(key));
+            break;
+        case 4:
+            QCOMPARE(map.take(key), reference.take(key));
+            break;
+        }
+        if (round % 20000 == 0) {
+            QVERIFY(sameItems(map, reference));
+            QCOMPARE(map.lowerBound(key) == map.end(), reference.lowerBound(key) == reference.end());
+            QCOMPARE(map.upperBound(key) == map.end(), reference.upperBound(key) == reference.end());
+        }
+    }
+    QVERIFY(sameItems(map, reference));
+
+    QMap<int, int>::const_iterator rit = reference.constBegin();
+    for (; rit != reference.constEnd(); ++rit) {
+        QCOMPARE(map.lowerBound(rit.key()).key(), reference.lowerBound(rit.key()).key());
+        QCOMPARE(map.lowerBound(rit.key()).value(), reference.lowerBound(rit.key()).value());
+    }
+
+    while (!reference.isEmpty()) {
+        int key = reference.constBegin().key();
+        QCOMPARE(map.remove(key), reference.remove(key));
+    }
+    QVERIFY(map.isEmpty());
+    QVERIFY(map.constBegin() == map.constEnd());
+}
+
+QTEST_APPLESS_MAIN(tst_QBTreeMap)
+#include "tst_qbtreemap.moc"
@@ -0,0 +1,7 @@
+load(qttest_p4)
+SOURCES  += tst_qbtreemapperformance.cpp
+
+QT = core
+
+DEFINES += QT_USE_USING_NAMESPACE
+
@@ -0,0 +1,209 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qbtreemap.h>
+#include <qmap.h>
+
+//TESTED_CLASS=
+//TESTED_FILES=corelib/tools/qbtreemap.h corelib/tools/qbtreemap.cpp
+
+class tst_QBTreeMapPerformance : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertRandom_data() { sizes(); }
+    void insertRandom();
+    void insertSorted_data() { sizes(); }
+    void insertSorted();
+    void lookup_data() { sizes(); }
+    void lookup();
+    void range_data() { sizes(); }
+    void range();
+    void iterate_data() { sizes(); }
+    void iterate();
+
+private:
+    void sizes();
+};
+
+void tst_QBTreeMapPerformance::sizes()
+{
+    QTest::addColumn<int>("size");
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("100000") << 100000;
+    QTest::newRow("1000000") << 1000000;
+}
+
+// a permutation of 0..size-1 when size is not a multiple of the prime
+static inline int scrambled(int i, int size)
+{
+    return int((qint64(i) * 1000003) % size);
+}
+
+// every benchmark performs about the same number of operations
+// regardless of the map size, so the timings can be compared
+static inline int repeatCount(int size)
+{
+    return qMax(1, 2000000 / size);
+}
+
+template <class Map>
+static int timeInsert(int size, bool sorted, int *checksum)
+{
+    QTime timer;
+    timer.start();
+    int repeat = repeatCount(size);
+    *checksum = 0;
+    for (int r = 0; r < repeat; ++r) {
+        Map map;
+        for (int i = 0; i < size; ++i)
+            map.insert(sorted ? i : scrambled(i, size), i);
+        *checksum += map.size() + map.constBegin().value();
+    }
+    return timer.elapsed();
+}
+
+void tst_QBTreeMapPerformance::insertRandom()
+{
+    QFETCH(int, size);
+
+    int mapChecksum, btreeChecksum;
+    int mapTime = timeInsert<QMap<int, int> >(size, false, &mapChecksum);
+    int btreeTime = timeInsert<QBTreeMap<int, int> >(size, false, &btreeChecksum);
+    QCOMPARE(btreeChecksum, mapChecksum);
+
+    qDebug() << size << "items, random insert: QMap" << mapTime << "ms, QBTreeMap" << btreeTime << "ms";
+}
+
+void tst_QBTreeMapPerformance::insertSorted()
+{
+    QFETCH(int, size);
+
+    int mapChecksum, btreeChecksum;
+    int mapTime = timeInsert<QMap<int, int> >(size, true, &mapChecksum);
+    int btreeTime = timeInsert<QBTreeMap<int, int> >(size, true, &btreeChecksum);
+    QCOMPARE(btreeChecksum, mapChecksum);
+
+    qDebug() << size << "items, sorted insert: QMap" << mapTime << "ms, QBTreeMap" << btreeTime << "ms";
+}
+
+template <class Map>
+static int timeLookup(const Map &map, int size, int *checksum)
+{
+    QTime timer;
+    timer.start();
+    int repeat = repeatCount(size);
+    *checksum = 0;
+    for (int r = 0; r < repeat; ++r) {
+        // half of the lookups hit, half miss
+        for (int i = 0; i < size; ++i)
+            *checksum += map.value(scrambled(i, size) * 2 + (i & 1), 1);
+    }
+    return timer.elapsed();
+}
+
+void tst_QBTreeMapPerformance::lookup()
+{
+    QFETCH(int, size);
+
+    QMap<int, int> map;
+    QBTreeMap<int, int> btree;
+    for (int i = 0; i < size; ++i) {
+        map.insert(scrambled(i, size) * 2, i);
+        btree.insert(scrambled(i, size) * 2, i);
+    }
+
+    int mapChecksum, btreeChecksum;
+    int mapTime = timeLookup(map, size, &mapChecksum);
+    int btreeTime = timeLookup(btree, size, &btreeChecksum);
+    QCOMPARE(btreeChecksum, mapChecksum);
+
+    qDebug() << size << "items, lookup: QMap" << mapTime << "ms, QBTreeMap" << btreeTime << "ms";
+}
+
+template <class Map>
+static int timeRange(const Map &map, int size, int *checksum)
+{
+    QTime timer;
+    timer.start();
+    const int width = 100;
+    int ranges = repeatCount(size) * size / width;
+    *checksum = 0;
+    for (int r = 0; r < ranges; ++r) {
+        int lo = scrambled(r, size);
+        typename Map::const_iterator it = map.lowerBound(lo);
+        typename Map::const_iterator end = map.upperBound(lo + width);
+        for (; it != end; ++it)
+            *checksum += it.value();
+    }
+    return timer.elapsed();
+}
+
+void tst_QBTreeMapPerformance::range()
+{
+    QFETCH(int, size);
+
+    // keys are spread out and inserted in random order, as they would
+    // be in a map that has been in use for a while
+    QMap<int, int> map;
+    QBTreeMap<int, int> btree;
+    for (int i = 0; i < size; ++i) {
+        map.insert(scrambled(i, size), i);
+        btree.insert(scrambled(i, size), i);
+    }
+
+    int mapChecksum, btreeChecksum;
+    int mapTime = timeRange(map, size, &mapChecksum);
+    int btreeTime = timeRange(btree, size, &btreeChecksum);
+    QCOMPARE(btreeChecksum, mapChecksum);
+
+    qDebug() << size << "items, lowerBound/upperBound ranges: QMap" << mapTime
+             << "ms, QBTreeMap" << btreeTime << "ms";
+}
+
+template <class Map>
+static int timeIterate(const Map &map, int size, int *checksum)
+{
+    QTime timer;
+    timer.start();
+    int repeat = repeatCount(size);
+    *checksum = 0;
+    for (int r = 0; r < repeat; ++r) {
+        typename Map::const_iterator it = map.constBegin();
+        typename Map::const_iterator end = map.constEnd();
+        for (; it != end; ++it)
+            *checksum += it.value();
+    }
+    return timer.elapsed();
+}
+
+void tst_QBTreeMapPerformance::iterate()
+{
+    QFETCH(int, size);
+
+    QMap<int, int> map;
+    QBTreeMap<int, int> btree;
+    for (int i = 0; i < size; ++i) {
+        map.insert(scrambled(i, size), i);
+        btree.insert(scrambled(i, size), i);
+    }
+
+    int mapChecksum, btreeChecksum;
+    int mapTime = timeIterate(map, size, &mapChecksum);
+    int btreeTime = timeIterate(btree, size, &btreeChecksum);
+    QCOMPARE(btreeChecksum, mapChecksum);
+
+    qDebug() << size << "items, iterate: QMap" << mapTime << "ms, QBTreeMap" << btreeTime << "ms";
+}
+
+QTEST_APPLESS_MAIN(tst_QBTreeMapPerformance)
+#include "tst_qbtreemapperformance.moc"
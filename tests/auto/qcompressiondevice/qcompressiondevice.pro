@@ -0,0 +1,8 @@
+load(qttest_p4)
+SOURCES  += tst_qcompressiondevice.cpp
+
+
+QT = core
+
+DEFINES += QT_USE_USING_NAMESPACE
+
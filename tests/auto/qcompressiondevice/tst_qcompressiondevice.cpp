@@ -0,0 +1,275 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QCompressionDevice>
+#include <QFile>
+#include <QTemporaryFile>
+
+//TESTED_CLASS=
+//TESTED_FILES=corelib/io/qcompressiondevice.h corelib/io/qcompressiondevice.cpp
+
+Q_DECLARE_METATYPE(QCompressionDevice::Format)
+
+class tst_QCompressionDevice : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void getSetCheck();
+    void openModes();
+    void roundTrip_data();
+    void roundTrip();
+    void smallReadsAndWrites();
+    void qCompressInterop();
+    void multiMemberGzip();
+    void corruptData();
+    void truncatedFile();
+    void compressionLevel();
+    void flush();
+};
+
+static QByteArray testData(int size)
+{
+    QByteArray data;
+    data.reserve(size);
+    uint seed = 1;
+    while (data.size() < size) {
+        seed = seed * 1103515245 + 12345;
+        // mix runs of text with noise so both compress differently
+        if ((seed >> 16) % 4)
+            data.append("The quick brown fox jumps over the lazy dog. ");
+        else
+            data.append(char(seed >> 24));
+    }
+    data.resize(size);
+    return data;
+}
+
+static QByteArray compress(const QByteArray &data, QCompressionDevice::Format format, int level = -1)
+{
+    QBuffer buffer;
+    QCompressionDevice device(&buffer, format);
+    device.setCompressionLevel(level);
+    if (!device.open(QIODevice::WriteOnly))
+        return QByteArray();
+    device.write(data);
+    device.close();
+    return buffer.data();
+}
+
+static QByteArray uncompress(const QByteArray &data, QCompressionDevice::Format format)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    QCompressionDevice device(&buffer, format);
+    if (!device.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return device.readAll();
+}
+
+void tst_QCompressionDevice::getSetCheck()
+{
+    QBuffer buffer;
+    QCompressionDevice device(&buffer);
+    QCOMPARE(device.device(), static_cast<QIODevice *>(&buffer));
+    QCOMPARE(device.format(), QCompressionDevice::ZlibFormat);
+    QCOMPARE(device.compressionLevel(), -1);
+    QVERIFY(device.isSequential());
+
+    device.setFormat(QCompressionDevice::GzipFormat);
+    QCOMPARE(device.format(), QCompressionDevice::GzipFormat);
+    device.setCompressionLevel(9);
+    QCOMPARE(device.compressionLevel(), 9);
+    device.setCompressionLevel(42);
+    QCOMPARE(device.compressionLevel(), 9);
+}
+
+void tst_QCompressionDevice::openModes()
+{
+    QBuffer buffer;
+    QCompressionDevice device(&buffer);
+    QVERIFY(!device.open(QIODevice::ReadWrite));
+    QVERIFY(!device.open(QIODevice::WriteOnly | QIODevice::Append));
+    QVERIFY(!buffer.isOpen());
+
+    // the device is opened and closed on demand
+    QVERIFY(device.open(QIODevice::WriteOnly));
+    QVERIFY(buffer.isOpen());
+    device.close();
+    QVERIFY(!buffer.isOpen());
+
+    // but left alone if it was open already
+    buffer.open(QIODevice::ReadOnly);
+    QVERIFY(!device.open(QIODevice::WriteOnly));
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    device.close();
+    QVERIFY(buffer.isOpen());
+}
+
+void tst_QCompressionDevice::roundTrip_data()
+{
+    QTest::addColumn<QCompressionDevice::Format>("format");
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("zlib-empty") << QCompressionDevice::ZlibFormat << 0;
+    QTest::newRow("zlib-small") << QCompressionDevice::ZlibFormat << 100;
+    QTest::newRow("zlib-large") << QCompressionDevice::ZlibFormat << 1000000;
+    QTest::newRow("gzip-empty") << QCompressionDevice::GzipFormat << 0;
+    QTest::newRow("gzip-small") << QCompressionDevice::GzipFormat << 100;
+    QTest::newRow("gzip-large") << QCompressionDevice::GzipFormat << 1000000;
+    QTest::newRow("raw-empty") << QCompressionDevice::RawDeflateFormat << 0;
+    QTest::newRow("raw-small") << QCompressionDevice::RawDeflateFormat << 100;
+    QTest::newRow("raw-large") << QCompressionDevice::RawDeflateFormat << 1000000;
+}
+
+void tst_QCompressionDevice::roundTrip()
+{
+    QFETCH(QCompressionDevice::Format, format);
+    QFETCH(int, size);
+
+    QByteArray data = testData(size);
+    QByteArray compressed = compress(data, format);
+    QVERIFY(!compressed.isEmpty());
+    if (size > 1000)
+        QVERIFY(compressed.size() < size);
+    if (format == QCompressionDevice::GzipFormat) {
+        QCOMPARE(uchar(compressed.at(0)), uchar(0x1f));
+        QCOMPARE(uchar(compressed.at(1)), uchar(0x8b));
+    }
+    QCOMPARE(uncompress(compressed, format), data);
+}
+
+void tst_QCompressionDevice::smallReadsAndWrites()
+{
+    QByteArray data = testData(100000);
+
+    QBuffer buffer;
+    QCompressionDevice writer(&buffer, QCompressionDevice::GzipFormat);
+    QVERIFY(writer.open(QIODevice::WriteOnly));
+    for (int i = 0; i < data.size(); i += 7)
+        QCOMPARE(writer.write(data.mid(i, 7)), qint64(data.mid(i, 7).size()));
+    writer.close();
+
+    QCompressionDevice reader(&buffer, QCompressionDevice::GzipFormat);
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+    QByteArray result;
+    char chunk[13];
+    qint64 n;
+    while ((n = reader.read(chunk, sizeof(chunk))) > 0)
+        result.append(QByteArray(chunk, int(n)));
+    QCOMPARE(n, qint64(0));
+    QVERIFY(reader.atEnd());
+    QCOMPARE(result, data);
+}
+
+void tst_QCompressionDevice::qCompressInterop()
+{
+    QByteArray data = testData(50000);
+
+    // qCompress() output is a zlib stream after a four byte size prefix
+    QCOMPARE(uncompress(qCompress(data).mid(4), QCompressionDevice::ZlibFormat), data);
+
+    QByteArray compressed = compress(data, QCompressionDevice::ZlibFormat);
+    QByteArray prefix(4, 0);
+    prefix[0] = char(data.size() >> 24);
+    prefix[1] = char(data.size() >> 16);
+    prefix[2] = char(data.size() >> 8);
+    prefix[3] = char(data.size());
+    QCOMPARE(qUncompress(prefix + compressed), data);
+}
+
+void tst_QCompressionDevice::multiMemberGzip()
+{
+    QByteArray first = testData(3000);
+    QByteArray second = testData(5000).toUpper();
+    QByteArray compressed = compress(first, QCompressionDevice::GzipFormat)
+                            + compress(second, QCompressionDevice::GzipFormat);
+    QCOMPARE(uncompress(compressed, QCompressionDevice::GzipFormat), first + second);
+}
+
+void tst_QCompressionDevice::corruptData()
+{
+    QByteArray compressed = compress(testData(10000), QCompressionDevice::ZlibFormat);
+    for (int i = 10; i < 40; ++i)
+        compressed[i] = char(~compressed.at(i));
+
+    QBuffer buffer;
+    buffer.setData(compressed);
+    QCompressionDevice device(&buffer);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    char chunk[20000];
+    qint64 total = 0;
+    qint64 n;
+    while ((n = device.read(chunk, sizeof(chunk))) > 0)
+        total += n;
+    QVERIFY(total < 10000);
+    QVERIFY(!device.errorString().isEmpty());
+}
+
+void tst_QCompressionDevice::truncatedFile()
+{
+    QByteArray compressed = compress(testData(10000), QCompressionDevice::GzipFormat);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(compressed.left(compressed.size() / 2));
+    file.flush();
+
+    QFile input(file.fileName());
+    QCompressionDevice device(&input, QCompressionDevice::GzipFormat);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QVERIFY(input.isOpen());
+    char chunk[1000];
+    qint64 n;
+    while ((n = device.read(chunk, sizeof(chunk))) > 0)
+        ;
+    QCOMPARE(device.errorString(), QString("Unexpected end of compressed data"));
+    device.close();
+    QVERIFY(!input.isOpen());
+}
+
+void tst_QCompressionDevice::compressionLevel()
+{
+    QByteArray data = testData(100000);
+    QByteArray stored = compress(data, QCompressionDevice::RawDeflateFormat, 0);
+    QByteArray best = compress(data, QCompressionDevice::RawDeflateFormat, 9);
+    QVERIFY(stored.size() > data.size());
+    QVERIFY(best.size() < data.size() / 2);
+    QCOMPARE(uncompress(stored, QCompressionDevice::RawDeflateFormat), data);
+    QCOMPARE(uncompress(best, QCompressionDevice::RawDeflateFormat), data);
+}
+
+void tst_QCompressionDevice::flush()
+{
+    QByteArray data = testData(1000);
+
+    QBuffer buffer;
+    QCompressionDevice writer(&buffer);
+    QVERIFY(writer.open(QIODevice::WriteOnly));
+    writer.write(data);
+    QVERIFY(writer.flush());
+
+    // everything written so far can be decoded before the stream ends
+    QBuffer partial;
+    partial.setData(buffer.data());
+    QCompressionDevice reader(&partial);
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+    QCOMPARE(reader.read(data.size() * 2), data);
+
+    writer.close();
+    QVERIFY(!writer.flush());
+    QCOMPARE(uncompress(buffer.data(), QCompressionDevice::ZlibFormat), data);
+}
+
+QTEST_MAIN(tst_QCompressionDevice)
+#include "tst_qcompressiondevice.moc"
@@ -18,6 +18,8 @@ private slots:
     void argc();
     void postEvent();
     void removePostedEvents();
+    void postEvents();
+    void queuedSignalsFromThreads();
     void deliverInDefinedOrder();
     void applicationPid();
 };
@@ -253,6 +255,147 @@ void tst_QCoreApplication::removePostedEvents()
     expected.clear();
 }
 
+void tst_QCoreApplication::postEvents()
+{
+    int argc = 1;
+    char *argv[] = { "tst_qcoreapplication" };
+    QCoreApplication app(argc, argv);
+
+    EventSpy spy;
+    QObject one, two;
+    one.installEventFilter(&spy);
+    two.installEventFilter(&spy);
+
+    QList<QEvent *> events;
+    events << new QEvent(QEvent::Type(QEvent::User + 2))
+           << new QEvent(QEvent::Type(QEvent::User + 3))
+           << new QEvent(QEvent::Type(QEvent::User + 4));
+    QCoreApplication::postEvent(&one, new QEvent(QEvent::Type(QEvent::User + 1)));
+    QCoreApplication::postEvents(&one, events);
+    events.clear();
+    events << new QEvent(QEvent::Type(QEvent::User + 5))
+           << new QEvent(QEvent::Type(QEvent::User + 6));
+    QCoreApplication::postEvents(&two, events, 1);
+    QCoreApplication::postEvents(&two, QList<QEvent *>());
+
+    QList<int> expected;
+    expected << QEvent::User + 5
+             << QEvent::User + 6
+             << QEvent::User + 1
+             << QEvent::User + 2
+             << QEvent::User + 3
+             << QEvent::User + 4;
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(spy.recordedEvents, expected);
+    spy.recordedEvents.clear();
+
+    // batched events can be removed like any other posted event
+    events.clear();
+    events << new QEvent(QEvent::Type(QEvent::User + 7))
+           << new QEvent(QEvent::Type(QEvent::User + 8));
+    QCoreApplication::postEvents(&one, events);
+    QCoreApplication::removePostedEvents(&one, QEvent::User + 7);
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(spy.recordedEvents, QList<int>() << QEvent::User + 8);
+}
+
+class ProgressEvent : public QEvent
+{
+public:
+    ProgressEvent(QThread *thread, int value)
+        : QEvent(QEvent::User), thread(thread), value(value)
+    { }
+
+    QThread *thread;
+    int value;
+};
+
+class ProgressThread : public QThread
+{
+    Q_OBJECT
+
+public:
+    enum { Count = 5000 };
+
+    QObject *receiver;
+
+signals:
+    void progress(int);
+
+protected:
+    void run()
+    {
+        for (int i = 1; i <= Count; ++i) {
+            emit progress(i);
+            if (i % 100 == 0)
+                QCoreApplication::postEvent(receiver, new ProgressEvent(this, i));
+        }
+    }
+};
+
+class ProgressReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    QHash<QObject *, int> values;
+    int count;
+    bool inOrder;
+
+    ProgressReceiver()
+        : count(0), inOrder(true)
+    { }
+
+    bool event(QEvent *e)
+    {
+        if (e->type() == QEvent::User) {
+            // events and queued signals from one thread arrive in order
+            ProgressEvent *pe = static_cast<ProgressEvent *>(e);
+            if (values.value(pe->thread) != pe->value)
+                inOrder = false;
+            return true;
+        }
+        return QObject::event(e);
+    }
+
+public slots:
+    void progress(int value)
+    {
+        int &last = values[sender()];
+        if (value != last + 1)
+            inOrder = false;
+        last = value;
+        ++count;
+    }
+};
+
+void tst_QCoreApplication::queuedSignalsFromThreads()
+{
+    int argc = 1;
+    char *argv[] = { "tst_qcoreapplication" };
+    QCoreApplication app(argc, argv);
+
+    ProgressReceiver receiver;
+    ProgressThread threads[4];
+    for (int i = 0; i < 4; ++i) {
+        threads[i].receiver = &receiver;
+        connect(&threads[i], SIGNAL(progress(int)), &receiver, SLOT(progress(int)));
+    }
+    for (int i = 0; i < 4; ++i)
+        threads[i].start();
+
+    QTime time;
+    time.start();
+    while (receiver.count < 4 * ProgressThread::Count && time.elapsed() < 30000)
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+    for (int i = 0; i < 4; ++i)
+        QVERIFY(threads[i].wait(10000));
+    QCoreApplication::sendPostedEvents();
+
+    QCOMPARE(receiver.count, 4 * int(ProgressThread::Count));
+    QVERIFY(receiver.inOrder);
+}
+
 class DeliverInDefinedOrderThread : public QThread
 {
     Q_OBJECT
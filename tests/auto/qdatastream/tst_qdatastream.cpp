@@ -163,6 +163,10 @@ private slots:
 
     void streamRealDataTypes();
 
+    void streamArrays_data();
+    void streamArrays();
+    void readArrayPastEnd();
+
 private:
     void writebool(QDataStream *s);
     void writeQBool(QDataStream *s);
@@ -2921,6 +2925,127 @@ void tst_QDataStream::streamToAndFromQByteArray()
     QCOMPARE(y, x);
 }
 
+template <typename T>
+static bool checkArrays(QDataStream::ByteOrder byteOrder, int version, int count)
+{
+    QVector<T> vector;
+    for (int i = 0; i < count; ++i)
+        vector.append(T(qint64(i) * Q_INT64_C(0x0102030405) - Q_INT64_C(0x1234567890)) / T(3));
+
+    // the arrays are written exactly as the values are one at a time
+    QByteArray expected;
+    QDataStream out(&expected, QIODevice::WriteOnly);
+    out.setByteOrder(byteOrder);
+    out.setVersion(version);
+    out << quint32(count);
+    for (int i = 0; i < count; ++i)
+        out << vector.at(i);
+
+    QByteArray data;
+    QDataStream vectorOut(&data, QIODevice::WriteOnly);
+    vectorOut.setByteOrder(byteOrder);
+    vectorOut.setVersion(version);
+    vectorOut << vector;
+    if (data != expected)
+        return false;
+
+    data.clear();
+    QDataStream listOut(&data, QIODevice::WriteOnly);
+    listOut.setByteOrder(byteOrder);
+    listOut.setVersion(version);
+    listOut << vector.toList();
+    if (data != expected)
+        return false;
+
+    // and read back exactly as the values are one at a time
+    QVector<T> elements;
+    QDataStream elementIn(expected);
+    elementIn.setByteOrder(byteOrder);
+    elementIn.setVersion(version);
+    quint32 size;
+    elementIn >> size;
+    for (int i = 0; i < count; ++i) {
+        T value;
+        elementIn >> value;
+        elements.append(value);
+    }
+    if (version >= QDataStream::Qt_3_3 && elements != vector)
+        return false;
+
+    QVector<T> result;
+    QDataStream in(expected);
+    in.setByteOrder(byteOrder);
+    in.setVersion(version);
+    in >> result;
+    if (in.status() != QDataStream::Ok || !in.atEnd() || result != elements)
+        return false;
+
+    QDataStream arrayIn(expected);
+    arrayIn.setByteOrder(byteOrder);
+    arrayIn.setVersion(version);
+    arrayIn >> size;
+    result.fill(T(1), count);
+    arrayIn.readArray(result.data(), count);
+    return arrayIn.status() == QDataStream::Ok && arrayIn.atEnd() && result == elements;
+}
+
+void tst_QDataStream::streamArrays_data()
+{
+    QTest::addColumn<int>("byteOrder");
+    QTest::addColumn<int>("version");
+    QTest::addColumn<int>("count");
+
+    const int counts[] = { 0, 1, 7, 1000, 5000 };
+    for (int i = 0; i < int(sizeof(counts) / sizeof(counts[0])); ++i) {
+        QByteArray suffix = " " + QByteArray::number(counts[i]);
+        QTest::newRow("big endian" + suffix) << int(QDataStream::BigEndian)
+                                             << int(QDataStream::Qt_4_3) << counts[i];
+        QTest::newRow("little endian" + suffix) << int(QDataStream::LittleEndian)
+                                                << int(QDataStream::Qt_4_3) << counts[i];
+        QTest::newRow("qt 3.1" + suffix) << int(QDataStream::BigEndian)
+                                         << int(QDataStream::Qt_3_1) << counts[i];
+    }
+}
+
+void tst_QDataStream::streamArrays()
+{
+    QFETCH(int, byteOrder);
+    QFETCH(int, version);
+    QFETCH(int, count);
+
+    QDataStream::ByteOrder order = QDataStream::ByteOrder(byteOrder);
+    QVERIFY(checkArrays<qint8>(order, version, count));
+    QVERIFY(checkArrays<quint8>(order, version, count));
+    QVERIFY(checkArrays<qint16>(order, version, count));
+    QVERIFY(checkArrays<quint16>(order, version, count));
+    QVERIFY(checkArrays<qint32>(order, version, count));
+    QVERIFY(checkArrays<quint32>(order, version, count));
+    QVERIFY(checkArrays<qint64>(order, version, count));
+    QVERIFY(checkArrays<quint64>(order, version, count));
+    QVERIFY(checkArrays<float>(order, version, count));
+    QVERIFY(checkArrays<double>(order, version, count));
+}
+
+void tst_QDataStream::readArrayPastEnd()
+{
+    // two and a half values
+    QByteArray data("\x00\x00\x00\x01\x00\x00\x00\x02\x00\x00", 10);
+    QDataStream in(data);
+    quint32 values[4] = { 9, 9, 9, 9 };
+    in.readArray(values, 4);
+    QCOMPARE(in.status(), QDataStream::ReadPastEnd);
+    QCOMPARE(values[0], quint32(1));
+    QCOMPARE(values[1], quint32(2));
+    QCOMPARE(values[2], quint32(0));
+    QCOMPARE(values[3], quint32(0));
+
+    QDataStream vectorIn(QByteArray("\x00\x00\x00\x03\x00\x00\x00\x01", 8));
+    QVector<qint32> vector;
+    vectorIn >> vector;
+    QCOMPARE(vectorIn.status(), QDataStream::ReadPastEnd);
+    QCOMPARE(vector, QVector<qint32>() << 1 << 0 << 0);
+}
+
 void tst_QDataStream::streamRealDataTypes()
 {
     // Generate QPicture from SVG.
@@ -39,6 +39,10 @@ private slots:
     void absoluteFilePathsFromRelativeIteratorPath();
     void recurseWithFilters() const;
     void longPath();
+    void knownTypeFilters_data();
+    void knownTypeFilters();
+    void parallelIteration_data();
+    void parallelIteration();
 };
 
 tst_QDirIterator::tst_QDirIterator()
@@ -334,6 +338,136 @@ void tst_QDirIterator::longPath()
     dir.rmdir("longpaths");
 }
 
+static void createTree(QDir dir, int depth)
+{
+    for (int i = 0; i < 20; ++i)
+        QFile(dir.filePath(QString("file%1").arg(i))).open(QIODevice::WriteOnly);
+    QFile(dir.filePath(".hiddenfile")).open(QIODevice::WriteOnly);
+    if (depth == 0)
+        return;
+    for (int i = 0; i < 4; ++i) {
+        QString name = QString("dir%1").arg(i);
+        dir.mkdir(name);
+        createTree(QDir(dir.filePath(name)), depth - 1);
+    }
+    dir.mkdir(".hiddendir");
+}
+
+static void removeTree(const QString &path)
+{
+    QDir dir(path);
+    foreach (QString name, dir.entryList(QDir::Files | QDir::Hidden | QDir::System))
+        dir.remove(name);
+    foreach (QString name, dir.entryList(QDir::Dirs | QDir::Hidden | QDir::NoDotAndDotDot))
+        removeTree(dir.filePath(name));
+    QDir().rmdir(path);
+}
+
+void tst_QDirIterator::knownTypeFilters_data()
+{
+    QTest::addColumn<QDir::Filters>("filters");
+    QTest::addColumn<QStringList>("entries");
+
+    QTest::newRow("Files") << QDir::Filters(QDir::Files)
+                           << QString("file,writable,linktofile.lnk").split(',');
+    QTest::newRow("Dirs") << QDir::Filters(QDir::Dirs | QDir::NoDotAndDotDot)
+                          << QString("directory,linktodirectory.lnk").split(',');
+    QTest::newRow("Dirs | Hidden") << QDir::Filters(QDir::Dirs | QDir::Hidden)
+                                   << QString(".,..,directory,linktodirectory.lnk,.hidden").split(',');
+    QTest::newRow("Files | Hidden") << QDir::Filters(QDir::Files | QDir::Hidden)
+                                    << QString("file,writable,linktofile.lnk,.hiddenfile").split(',');
+    QTest::newRow("Files | NoSymLinks") << QDir::Filters(QDir::Files | QDir::NoSymLinks)
+                                        << QString("file,writable").split(',');
+    QTest::newRow("System") << QDir::Filters(QDir::System)
+                            << QString("brokenlink.lnk").split(',');
+}
+
+void tst_QDirIterator::knownTypeFilters()
+{
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QStringList, entries);
+
+    // the types of most entries are known without a stat()
+    QDir("entrylist").mkdir(".hidden");
+    QFile("entrylist/.hiddenfile").open(QIODevice::WriteOnly);
+
+    QDirIterator it("entrylist", filters);
+    QStringList list;
+    while (it.hasNext()) {
+        it.next();
+        list << it.fileName();
+        QVERIFY(it.fileInfo().exists() || it.fileInfo().isSymLink());
+    }
+
+    QDir("entrylist").rmdir(".hidden");
+    QFile::remove("entrylist/.hiddenfile");
+
+    list.sort();
+    entries.sort();
+    QCOMPARE(list, entries);
+}
+
+void tst_QDirIterator::parallelIteration_data()
+{
+    QTest::addColumn<QDir::Filters>("filters");
+    QTest::addColumn<QStringList>("nameFilters");
+
+    QTest::newRow("all") << QDir::Filters(QDir::NoFilter) << QStringList("*");
+    QTest::newRow("hidden") << QDir::Filters(QDir::AllEntries | QDir::Hidden | QDir::NoDotAndDotDot)
+                            << QStringList("*");
+    QTest::newRow("dirs") << QDir::Filters(QDir::Dirs | QDir::NoDotAndDotDot) << QStringList("*");
+    QTest::newRow("name filters") << QDir::Filters(QDir::AllDirs | QDir::Files | QDir::NoDotAndDotDot)
+                                  << QStringList("file1*");
+}
+
+void tst_QDirIterator::parallelIteration()
+{
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QStringList, nameFilters);
+
+    removeTree("paralleltree");
+    QVERIFY(QDir().mkdir("paralleltree"));
+    createTree(QDir("paralleltree"), 3);
+
+    QStringList serial;
+    QDirIterator it("paralleltree", nameFilters, filters, QDirIterator::Subdirectories);
+    while (it.hasNext())
+        serial << it.next();
+    QVERIFY(serial.size() > 20);
+
+    // parallel iteration returns the same entries in the same order
+    QStringList parallel;
+    QDirIterator pit("paralleltree", nameFilters, filters,
+                     QDirIterator::Subdirectories | QDirIterator::ParallelIteration);
+    while (pit.hasNext()) {
+        parallel << pit.next();
+        QCOMPARE(pit.filePath(), parallel.last());
+        QCOMPARE(pit.fileInfo().filePath(), parallel.last());
+    }
+    QCOMPARE(parallel, serial);
+
+    // unless it's unordered
+    QStringList unordered;
+    QDirIterator uit("paralleltree", nameFilters, filters,
+                     QDirIterator::Subdirectories | QDirIterator::ParallelIteration
+                     | QDirIterator::UnorderedIteration);
+    while (uit.hasNext())
+        unordered << uit.next();
+    unordered.sort();
+    serial.sort();
+    QCOMPARE(unordered, serial);
+
+    // stopping early must not wait for the whole tree
+    {
+        QDirIterator partial("paralleltree", nameFilters, filters,
+                             QDirIterator::Subdirectories | QDirIterator::ParallelIteration);
+        QVERIFY(partial.hasNext());
+        partial.next();
+    }
+
+    removeTree("paralleltree");
+}
+
 QTEST_MAIN(tst_QDirIterator)
 
 #include "tst_qdiriterator.moc"
@@ -0,0 +1,22 @@
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+#include <QtCore/qplugin.h>
+#include <plugininterface.h>
+
+// declares its keys, so that it is only loaded when it is used
+class Plugin1 : public QObject, public PluginInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(PluginInterface QFactoryInterface)
+
+public:
+    QStringList keys() const
+    { return QStringList() << QLatin1String("plugin1") << QLatin1String("alias1"); }
+    QString pluginName() const
+    { return QLatin1String("Plugin1"); }
+};
+
+Q_EXPORT_PLUGIN2(plugin1, Plugin1)
+Q_PLUGIN_METADATA_KEYS(PluginInterface_iid, "plugin1;alias1")
+
+#include "plugin1.moc"
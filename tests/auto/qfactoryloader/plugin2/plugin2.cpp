@@ -0,0 +1,21 @@
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+#include <QtCore/qplugin.h>
+#include <plugininterface.h>
+
+// has no metadata; its keys are learned by loading it once
+class Plugin2 : public QObject, public PluginInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(PluginInterface QFactoryInterface)
+
+public:
+    QStringList keys() const
+    { return QStringList() << QLatin1String("plugin2"); }
+    QString pluginName() const
+    { return QLatin1String("Plugin2"); }
+};
+
+Q_EXPORT_PLUGIN2(plugin2, Plugin2)
+
+#include "plugin2.moc"
@@ -0,0 +1,14 @@
+TEMPLATE      = lib
+CONFIG       += plugin
+HEADERS       = ../plugininterface.h
+SOURCES       = plugin2.cpp
+INCLUDEPATH  += ..
+TARGET        = plugin2
+DESTDIR       = ../bin
+QT            = core
+
+# no special install rule for the plugin used by test
+INSTALLS =
+
+DEFINES += QT_USE_USING_NAMESPACE
+
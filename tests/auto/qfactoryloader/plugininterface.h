@@ -0,0 +1,14 @@
+#ifndef PLUGININTERFACE_H
+#define PLUGININTERFACE_H
+
+#include <QtCore/qfactoryinterface.h>
+
+struct PluginInterface : public QFactoryInterface
+{
+    virtual QString pluginName() const = 0;
+};
+
+#define PluginInterface_iid "com.trolltech.autotests.qfactoryloader.plugininterface/1.0"
+Q_DECLARE_INTERFACE(PluginInterface, PluginInterface_iid)
+
+#endif // PLUGININTERFACE_H
@@ -0,0 +1,12 @@
+TEMPLATE    =	subdirs
+CONFIG  += ordered
+SUBDIRS	=	plugin1 \
+		plugin2 \
+		tst
+TARGET = tst_qfactoryloader
+
+# no special install rule for subdir
+INSTALLS =
+
+DEFINES += QT_USE_USING_NAMESPACE
+
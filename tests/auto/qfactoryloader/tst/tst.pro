@@ -0,0 +1,15 @@
+load(qttest_p4)
+SOURCES         += ../tst_qfactoryloader.cpp
+TARGET  = ../tst_qfactoryloader
+QT = core
+
+win32 {
+  CONFIG(debug, debug|release) {
+    TARGET = ../../debug/tst_qfactoryloader
+} else {
+    TARGET = ../../release/tst_qfactoryloader
+  }
+}
+
+DEFINES += QT_USE_USING_NAMESPACE
+
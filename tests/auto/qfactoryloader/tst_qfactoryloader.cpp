@@ -0,0 +1,112 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qdir.h>
+#include <qlibrary.h>
+#include <private/qfactoryloader_p.h>
+#include "plugininterface.h"
+
+#if defined(Q_OS_DARWIN)
+# define SUFFIX         ".dylib"
+# define PREFIX         "lib"
+#elif defined(Q_OS_HPUX) && !defined(__ia64)
+# define SUFFIX         ".sl"
+# define PREFIX         "lib"
+#elif defined(Q_OS_AIX)
+# define SUFFIX         ".a"
+# define PREFIX         "lib"
+#elif defined(Q_OS_WIN)
+# define SUFFIX         ".dll"
+# define PREFIX         ""
+#else  // all other Unix
+# define SUFFIX         ".so"
+# define PREFIX         "lib"
+#endif
+
+static QString pluginFileName(const QString &name)
+{
+    return QFileInfo(QDir::currentPath() + "/bin/" + PREFIX + name + SUFFIX).canonicalFilePath();
+}
+
+//TESTED_CLASS=
+//TESTED_FILES=corelib/plugin/qfactoryloader_p.h corelib/plugin/qfactoryloader.cpp
+
+class tst_QFactoryLoader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void keys();
+    void lazyLoading();
+    void cachedKeys();
+    void otherInterface();
+};
+
+void tst_QFactoryLoader::keys()
+{
+    QFactoryLoader loader(PluginInterface_iid, QStringList() << QDir::currentPath(), "/bin");
+    QStringList keys = loader.keys();
+    QVERIFY(keys.contains("plugin1"));
+    QVERIFY(keys.contains("alias1"));
+    QVERIFY(keys.contains("plugin2"));
+    QCOMPARE(keys.count(), 3);
+}
+
+void tst_QFactoryLoader::lazyLoading()
+{
+    QLibrary plugin1(pluginFileName("plugin1"));
+
+    QFactoryLoader loader(PluginInterface_iid, QStringList() << QDir::currentPath(), "/bin");
+    QVERIFY(loader.keys().contains("alias1"));
+    // the keys of plugin1 are read from its metadata
+    QVERIFY(!plugin1.isLoaded());
+
+    PluginInterface *instance = qobject_cast<PluginInterface *>(loader.instance("alias1"));
+    QVERIFY(instance);
+    QCOMPARE(instance->pluginName(), QString("Plugin1"));
+    QVERIFY(plugin1.isLoaded());
+
+    instance = qobject_cast<PluginInterface *>(loader.instance("plugin2"));
+    QVERIFY(instance);
+    QCOMPARE(instance->pluginName(), QString("Plugin2"));
+
+    QVERIFY(!loader.instance("plugin3"));
+}
+
+void tst_QFactoryLoader::cachedKeys()
+{
+    // the first loaders have learned the keys of plugin2
+    QFactoryLoader loader(PluginInterface_iid, QStringList() << QDir::currentPath(), "/bin");
+    QVERIFY(loader.keys().contains("plugin2"));
+
+    // so has the cache of the directory
+    QSettings settings(QSettings::UserScope, QLatin1String("Trolltech"));
+    QString cacheKey = QString::fromLatin1("Qt Plugin Directory Cache %1.%2/%3")
+                       .arg((QT_VERSION & 0xff0000) >> 16)
+                       .arg((QT_VERSION & 0xff00) >> 8)
+                       .arg(QDir::cleanPath(QDir::currentPath() + "/bin"));
+    QByteArray cache = settings.value(cacheKey).toByteArray();
+    QVERIFY(!cache.isEmpty());
+    QVERIFY(cache.contains(PluginInterface_iid));
+}
+
+void tst_QFactoryLoader::otherInterface()
+{
+    QLibrary plugin1(pluginFileName("plugin1"));
+    bool loaded = plugin1.isLoaded();
+
+    QFactoryLoader loader("com.trolltech.autotests.qfactoryloader.nosuchinterface",
+                          QStringList() << QDir::currentPath(), "/bin");
+    QVERIFY(loader.keys().isEmpty());
+    QCOMPARE(plugin1.isLoaded(), loaded);
+}
+
+QTEST_MAIN(tst_QFactoryLoader)
+#include "tst_qfactoryloader.moc"
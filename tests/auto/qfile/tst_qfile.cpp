@@ -136,6 +136,11 @@ private slots:
     void readEof_data();
     void readEof();
 
+    void map_data();
+    void map();
+    void mapAfterClose();
+    void mapWrite();
+
     // --- Task related tests below this line
     void task167217();
     
@@ -714,6 +719,131 @@ void tst_QFile::invalidFile()
     QVERIFY( !f.open( QIODevice::ReadWrite ) );
 }
 
+void tst_QFile::map_data()
+{
+    QTest::addColumn<int>("fileSize");
+    QTest::addColumn<qint64>("offset");
+    QTest::addColumn<qint64>("size");
+    QTest::addColumn<QFile::FileError>("error");
+
+    QTest::newRow("zero") << 4096 << qint64(0) << qint64(0) << QFile::UnspecifiedError;
+    QTest::newRow("negative offset") << 4096 << qint64(-1) << qint64(1) << QFile::UnspecifiedError;
+    QTest::newRow("past end") << 4096 << qint64(4000) << qint64(200) << QFile::UnspecifiedError;
+    QTest::newRow("offset past end") << 4096 << qint64(8192) << qint64(1) << QFile::UnspecifiedError;
+    QTest::newRow("whole file") << 4096 << qint64(0) << qint64(4096) << QFile::NoError;
+    QTest::newRow("one byte") << 4096 << qint64(0) << qint64(1) << QFile::NoError;
+    QTest::newRow("last byte") << 4096 << qint64(4095) << qint64(1) << QFile::NoError;
+    QTest::newRow("unaligned offset") << 100000 << qint64(4097) << qint64(50000) << QFile::NoError;
+    QTest::newRow("across pages") << 100000 << qint64(8191) << qint64(2) << QFile::NoError;
+}
+
+static QByteArray mapTestData(int size)
+{
+    QByteArray data(size, '\0');
+    for (int i = 0; i < size; ++i)
+        data[i] = char(i % 251);
+    return data;
+}
+
+void tst_QFile::map()
+{
+    QFETCH(int, fileSize);
+    QFETCH(qint64, offset);
+    QFETCH(qint64, size);
+    QFETCH(QFile::FileError, error);
+
+    const QByteArray data = mapTestData(fileSize);
+    const QString fileName = QDir::currentPath() + QLatin1String("/qfile_map_testfile");
+    QFile::remove(fileName);
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QCOMPARE(file.write(data), qint64(fileSize));
+
+    // the mapping sees data that is still buffered in the QFile
+    uchar *memory = file.map(offset, size);
+    QCOMPARE(file.error(), error);
+    QVERIFY((error == QFile::NoError) == (memory != 0));
+    if (error != QFile::NoError) {
+        QVERIFY(!file.errorString().isEmpty());
+        file.close();
+        QFile::remove(fileName);
+        return;
+    }
+
+    QByteArray view = QByteArray::fromRawData(reinterpret_cast<const char *>(memory), int(size));
+    QCOMPARE(view, data.mid(int(offset), int(size)));
+
+    // a second mapping of the same range is independent of the first
+    uchar *memory2 = file.map(offset, size);
+    QVERIFY(memory2 != 0);
+    QVERIFY(memory2 != memory);
+    QCOMPARE(memcmp(memory, memory2, size), 0);
+
+    QVERIFY(file.unmap(memory));
+    QCOMPARE(file.error(), QFile::NoError);
+    QVERIFY(!file.unmap(memory));
+    QCOMPARE(file.error(), QFile::PermissionsError);
+    QVERIFY(file.unmap(memory2));
+
+    file.close();
+    QFile::remove(fileName);
+}
+
+void tst_QFile::mapAfterClose()
+{
+    const QByteArray data = mapTestData(10000);
+    const QString fileName = QDir::currentPath() + QLatin1String("/qfile_map_testfile");
+    QFile::remove(fileName);
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QCOMPARE(file.write(data), qint64(data.size()));
+    }
+
+    QFile file(fileName);
+    QVERIFY(!file.map(0, 100));
+    QCOMPARE(file.error(), QFile::PermissionsError);
+
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    uchar *memory = file.map(5000, 5000);
+    QVERIFY(memory);
+    file.close();
+
+    // the mapping outlives the file being open
+    QCOMPARE(QByteArray::fromRawData(reinterpret_cast<const char *>(memory), 5000),
+             data.mid(5000));
+    QVERIFY(file.unmap(memory));
+
+    // mappings that are left are released with the file engine
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QVERIFY(file.map(0, 100));
+    file.setFileName(QString());
+    QFile::remove(fileName);
+}
+
+void tst_QFile::mapWrite()
+{
+    const QByteArray data = mapTestData(10000);
+    const QString fileName = QDir::currentPath() + QLatin1String("/qfile_map_testfile");
+    QFile::remove(fileName);
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QCOMPARE(file.write(data), qint64(data.size()));
+
+    uchar *memory = file.map(100, 10);
+    QVERIFY(memory);
+    memcpy(memory, "0123456789", 10);
+    QVERIFY(file.unmap(memory));
+    file.close();
+
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray expected = data;
+    expected.replace(100, 10, "0123456789");
+    QCOMPARE(file.readAll(), expected);
+    file.close();
+    QFile::remove(fileName);
+}
+
 void tst_QFile::createFile()
 {
     if ( QFile::exists( "createme.txt" ) )
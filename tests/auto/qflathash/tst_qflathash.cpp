@@ -0,0 +1,454 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qflathash.h>
+#include <qhash.h>
+
+//TESTED_CLASS=
+//TESTED_FILES=corelib/tools/qflathash.h corelib/tools/qflathash.cpp
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insert();
+    void count();
+    void implicitSharing();
+    void iterators();
+    void javaIterators();
+    void erase();
+    void take();
+    void keysValues();
+    void reserveSqueeze();
+    void compare();
+    void collisions();
+    void churn();
+};
+
+class Counted
+{
+public:
+    Counted() { ++count; }
+    Counted(const QString &s) : str(s) { ++count; }
+    Counted(const Counted &o) : str(o.str) { ++count; }
+    ~Counted() { --count; }
+    Counted &operator=(const Counted &o) { str = o.str; return *this; }
+    bool operator==(const Counted &o) const { return str == o.str; }
+
+    QString str;
+    static int count;
+};
+
+int Counted::count = 0;
+
+void tst_QFlatHash::insert()
+{
+    QFlatHash<int, QString> hash;
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.size(), 0);
+    QVERIFY(!hash.contains(0));
+    QCOMPARE(hash.value(0), QString());
+    QCOMPARE(hash.value(0, QString("x")), QString("x"));
+    QVERIFY(hash.constFind(0) == hash.constEnd());
+
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, QString::number(i));
+    QCOMPARE(hash.size(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+        QVERIFY(hash.contains(i));
+        QCOMPARE(hash.value(i), QString::number(i));
+        QCOMPARE(hash.count(i), 1);
+    }
+    QVERIFY(!hash.contains(1000));
+    QVERIFY(!hash.contains(-1));
+
+    // insert() replaces the value of an existing key
+    QFlatHash<int, QString>::iterator it = hash.insert(10, QString("ten"));
+    QCOMPARE(it.key(), 10);
+    QCOMPARE(it.value(), QString("ten"));
+    QCOMPARE(hash.size(), 1000);
+    QCOMPARE(hash.value(10), QString("ten"));
+
+    hash[10] = QString("TEN");
+    QCOMPARE(hash.value(10), QString("TEN"));
+    QCOMPARE(hash[2000], QString());
+    QCOMPARE(hash.size(), 1001);
+
+    const QFlatHash<int, QString> &chash = hash;
+    QCOMPARE(chash[3000], QString());
+    QCOMPARE(hash.size(), 1001);
+
+    QCOMPARE(hash.remove(10), 1);
+    QCOMPARE(hash.remove(10), 0);
+    QVERIFY(!hash.contains(10));
+    QCOMPARE(hash.size(), 1000);
+
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+    QVERIFY(!hash.contains(1));
+}
+
+void tst_QFlatHash::count()
+{
+    {
+        QFlatHash<QString, Counted> hash;
+        QFlatHash<QString, Counted> hash2(hash);
+        QCOMPARE(Counted::count, 0);
+        hash2["Hallo"] = Counted("Fritz");
+        QCOMPARE(hash.count(), 0);
+        QCOMPARE(hash2.count(), 1);
+        QCOMPARE(Counted::count, 1);
+    }
+    QCOMPARE(Counted::count, 0);
+
+    {
+        QFlatHash<int, Counted> hash;
+        for (int i = 0; i < 500; ++i)
+            hash.insert(i, Counted(QString::number(i)));
+        QCOMPARE(Counted::count, 500);
+
+        QFlatHash<int, Counted> hash2 = hash;
+        QCOMPARE(Counted::count, 500);
+        hash2.insert(1000, Counted("x"));
+        QCOMPARE(Counted::count, 1001);
+
+        for (int i = 0; i < 500; i += 2)
+            hash.remove(i);
+        QCOMPARE(Counted::count, 751);
+
+        hash2 = hash;
+        QCOMPARE(Counted::count, 250);
+
+        hash.squeeze();
+        QCOMPARE(Counted::count, 500);
+    }
+    QCOMPARE(Counted::count, 0);
+}
+
+void tst_QFlatHash::implicitSharing()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i * 2);
+
+    QFlatHash<int, int> copy = hash;
+    QVERIFY(!hash.isDetached());
+    QVERIFY(!copy.isDetached());
+
+    copy[5] = 0;
+    QVERIFY(hash.isDetached());
+    QVERIFY(copy.isDetached());
+    QCOMPARE(hash.value(5), 10);
+    QCOMPARE(copy.value(5), 0);
+
+    copy = hash;
+    copy.remove(7);
+    QVERIFY(hash.contains(7));
+    QVERIFY(!copy.contains(7));
+
+    copy = hash;
+    QFlatHash<int, int>::iterator it = copy.find(9);
+    *it = -1;
+    QCOMPARE(hash.value(9), 18);
+    QCOMPARE(copy.value(9), -1);
+
+    copy = hash;
+    copy.reserve(10000);
+    QVERIFY(copy.capacity() >= 10000);
+    QVERIFY(hash.capacity() < 10000);
+    QCOMPARE(copy, hash);
+
+    copy.setSharable(false);
+    QFlatHash<int, int> copy2 = copy;
+    QVERIFY(copy.isDetached());
+    QVERIFY(copy2.isDetached());
+    copy.setSharable(true);
+}
+
+void tst_QFlatHash::iterators()
+{
+    QFlatHash<int, QString> hash;
+    QVERIFY(hash.begin() == hash.end());
+    QVERIFY(hash.constBegin() == hash.constEnd());
+
+    for (int i = 1; i <= 100; ++i)
+        hash.insert(i, QString::number(i));
+
+    QSet<int> seen;
+    int n = 0;
+    for (QFlatHash<int, QString>::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it) {
+        QCOMPARE(it.value(), QString::number(it.key()));
+        QCOMPARE(*it, QString::number(it.key()));
+        seen.insert(it.key());
+        ++n;
+    }
+    QCOMPARE(n, 100);
+    QCOMPARE(seen.size(), 100);
+
+    // backward iteration visits the same items in reverse
+    QList<int> forward;
+    for (QFlatHash<int, QString>::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it)
+        forward.append(it.key());
+    QList<int> backward;
+    QFlatHash<int, QString>::const_iterator it = hash.constEnd();
+    while (it != hash.constBegin()) {
+        --it;
+        backward.prepend(it.key());
+    }
+    QCOMPARE(backward, forward);
+
+    QFlatHash<int, QString>::iterator mit = hash.begin();
+    mit += 10;
+    QCOMPARE(mit.key(), forward.at(10));
+    mit -= 5;
+    QCOMPARE(mit.key(), forward.at(5));
+    QCOMPARE((mit + 3).key(), forward.at(8));
+    QCOMPARE((mit - 3).key(), forward.at(2));
+
+    for (mit = hash.begin(); mit != hash.end(); ++mit)
+        mit.value() += QLatin1String("!");
+    QCOMPARE(hash.value(42), QString("42!"));
+
+    QFlatHash<int, QString>::const_iterator cit = hash.find(42);
+    QVERIFY(cit == hash.find(42));
+    QCOMPARE(cit.value(), QString("42!"));
+
+    int total = 0;
+    foreach (QString value, hash)
+        total += value.size();
+    QCOMPARE(total, 9 * 2 + 90 * 3 + 1 * 4);
+}
+
+void tst_QFlatHash::javaIterators()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 50; ++i)
+        hash.insert(i, i);
+
+    int sum = 0;
+    QFlatHashIterator<int, int> i(hash);
+    while (i.hasNext()) {
+        i.next();
+        QCOMPARE(i.key(), i.value());
+        sum += i.value();
+    }
+    QCOMPARE(sum, 49 * 50 / 2);
+
+    QMutableFlatHashIterator<int, int> j(hash);
+    while (j.hasNext()) {
+        if (j.next().key() % 2)
+            j.remove();
+        else
+            j.setValue(-j.value());
+    }
+    QCOMPARE(hash.size(), 25);
+    QCOMPARE(hash.value(10), -10);
+    QVERIFY(!hash.contains(11));
+}
+
+void tst_QFlatHash::erase()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+
+    // erasing never moves other items, so iteration can continue
+    QFlatHash<int, int>::iterator it = hash.begin();
+    while (it != hash.end()) {
+        if (it.key() % 3 == 0)
+            it = hash.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(hash.size(), 666);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.contains(i), i % 3 != 0);
+
+    QVERIFY(hash.erase(hash.end()) == hash.end());
+}
+
+void tst_QFlatHash::take()
+{
+    QFlatHash<QString, Counted> hash;
+    hash.insert("a", Counted("A"));
+    hash.insert("b", Counted("B"));
+
+    QCOMPARE(hash.take("a").str, QString("A"));
+    QCOMPARE(hash.take("a").str, QString());
+    QCOMPARE(hash.size(), 1);
+
+    QFlatHash<QString, Counted> copy = hash;
+    QCOMPARE(copy.take("b").str, QString("B"));
+    QVERIFY(copy.isEmpty());
+    QCOMPARE(hash.size(), 1);
+
+    hash.clear();
+    QCOMPARE(Counted::count, 0);
+}
+
+void tst_QFlatHash::keysValues()
+{
+    QFlatHash<QString, int> hash;
+    QVERIFY(hash.keys().isEmpty());
+    QVERIFY(hash.values().isEmpty());
+
+    hash.insert("one", 1);
+    hash.insert("two", 2);
+    hash.insert("deux", 2);
+
+    QList<QString> keys = hash.keys();
+    QList<int> values = hash.values();
+    QCOMPARE(keys.size(), 3);
+    for (int i = 0; i < keys.size(); ++i)
+        QCOMPARE(hash.value(keys.at(i)), values.at(i));
+
+    QStringList twos = hash.keys(2);
+    qSort(twos);
+    QCOMPARE(twos, QStringList() << "deux" << "two");
+    QCOMPARE(hash.key(1), QString("one"));
+    QCOMPARE(hash.key(3), QString());
+    QCOMPARE(hash.key(3, QString("none")), QString("none"));
+
+    QFlatHash<QString, int> other;
+    other.insert("one", 10);
+    other.insert("three", 3);
+    hash.unite(other);
+    QCOMPARE(hash.size(), 4);
+    QCOMPARE(hash.value("one"), 10);
+    QCOMPARE(hash.value("three"), 3);
+}
+
+void tst_QFlatHash::reserveSqueeze()
+{
+    QFlatHash<int, int> hash;
+    QCOMPARE(hash.capacity(), 0);
+
+    hash.reserve(1000);
+    int capacity = hash.capacity();
+    QVERIFY(capacity >= 1000);
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.capacity(), capacity);
+
+    for (int i = 0; i < 990; ++i)
+        hash.remove(i);
+    QCOMPARE(hash.capacity(), capacity);
+    hash.squeeze();
+    QVERIFY(hash.capacity() < capacity);
+    QVERIFY(hash.capacity() >= 10);
+    for (int i = 990; i < 1000; ++i)
+        QCOMPARE(hash.value(i), i);
+
+    hash.clear();
+    hash.squeeze();
+    QCOMPARE(hash.capacity(), 0);
+    hash.insert(1, 1);
+    QCOMPARE(hash.value(1), 1);
+}
+
+void tst_QFlatHash::compare()
+{
+    QFlatHash<int, QString> a;
+    QFlatHash<int, QString> b;
+    QVERIFY(a == b);
+
+    // the same items in a different table layout still compare equal
+    for (int i = 0; i < 100; ++i)
+        a.insert(i, QString::number(i));
+    b.reserve(5000);
+    for (int i = 99; i >= 0; --i)
+        b.insert(i, QString::number(i));
+    QVERIFY(a == b);
+    QVERIFY(!(a != b));
+
+    b[50] = QString("fifty");
+    QVERIFY(a != b);
+    b.remove(50);
+    QVERIFY(a != b);
+    b.insert(100, QString::number(50));
+    QVERIFY(a != b);
+}
+
+struct BadKey
+{
+    BadKey(int v = 0) : value(v) { }
+    bool operator==(const BadKey &o) const { return value == o.value; }
+    int value;
+};
+
+uint qHash(const BadKey &)
+{
+    return 42;
+}
+
+void tst_QFlatHash::collisions()
+{
+    // every key has the same hash value, so every lookup has to probe
+    QFlatHash<BadKey, int> hash;
+    for (int i = 0; i < 300; ++i)
+        hash.insert(BadKey(i), i);
+    QCOMPARE(hash.size(), 300);
+    for (int i = 0; i < 300; ++i)
+        QCOMPARE(hash.value(BadKey(i), -1), i);
+    QVERIFY(!hash.contains(BadKey(300)));
+
+    for (int i = 0; i < 300; i += 2)
+        QCOMPARE(hash.remove(BadKey(i)), 1);
+    for (int i = 0; i < 300; ++i)
+        QCOMPARE(hash.contains(BadKey(i)), i % 2 == 1);
+
+    // reinsertion reuses the tombstones left by the removals
+    for (int i = 0; i < 300; i += 2)
+        hash.insert(BadKey(i), -i);
+    QCOMPARE(hash.size(), 300);
+    for (int i = 0; i < 300; ++i)
+        QCOMPARE(hash.value(BadKey(i), 1), i % 2 ? i : -i);
+}
+
+void tst_QFlatHash::churn()
+{
+    // random inserts and removals against QHash as a reference, so that
+    // the table cycles through growth, tombstones and in-place rehashes
+    QFlatHash<int, int> hash;
+    QHash<int, int> reference;
+    qsrand(1);
+    for (int round = 0; round < 200000; ++round) {
+        int key = qrand() % 4096;
+        switch (qrand() % 3) {
+        case 0:
+        case 1:
+            hash.insert(key, round);
+            reference.insert(key, round);
+            break;
+        case 2:
+            QCOMPARE(hash.remove(key), reference.remove(key));
+            break;
+        }
+        if (round % 20000 == 0) {
+            QCOMPARE(hash.size(), reference.size());
+            QHash<int, int>::const_iterator it = reference.constBegin();
+            for (; it != reference.constEnd(); ++it)
+                QCOMPARE(hash.value(it.key(), -1), it.value());
+        }
+    }
+
+    QCOMPARE(hash.size(), reference.size());
+    int n = 0;
+    for (QFlatHash<int, int>::const_iterator it = hash.constBegin(); it != hash.constEnd(); ++it) {
+        QCOMPARE(it.value(), reference.value(it.key(), -1));
+        ++n;
+    }
+    QCOMPARE(n, reference.size());
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatHash)
+#include "tst_qflathash.moc"
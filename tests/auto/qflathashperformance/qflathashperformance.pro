@@ -0,0 +1,7 @@
+load(qttest_p4)
+SOURCES  += tst_qflathashperformance.cpp
+
+QT = core
+
+DEFINES += QT_USE_USING_NAMESPACE
+
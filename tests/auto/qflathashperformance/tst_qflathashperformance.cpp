@@ -0,0 +1,244 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qflathash.h>
+#include <qhash.h>
+
+//TESTED_CLASS=
+//TESTED_FILES=corelib/tools/qflathash.h corelib/tools/qflathash.cpp
+
+class tst_QFlatHashPerformance : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insert_data() { sizes(); }
+    void insert();
+    void lookup_data() { sizes(); }
+    void lookup();
+    void lookupRandomOrder_data() { sizes(); }
+    void lookupRandomOrder();
+    void lookupStrings_data();
+    void lookupStrings();
+    void iterate_data() { sizes(); }
+    void iterate();
+
+private:
+    void sizes();
+};
+
+void tst_QFlatHashPerformance::sizes()
+{
+    QTest::addColumn<int>("size");
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("100000") << 100000;
+    QTest::newRow("2000000") << 2000000;
+}
+
+// spreads consecutive integers over the key space without repeating
+static inline int key(int i)
+{
+    return int(uint(i) * 2654435761U);
+}
+
+// every benchmark performs about the same number of operations
+// regardless of the table size, so the timings can be compared
+static inline int repeatCount(int size)
+{
+    return qMax(1, 4000000 / size);
+}
+
+template <class Hash>
+static int timeInsert(int size, int *checksum)
+{
+    QTime timer;
+    timer.start();
+    int repeat = repeatCount(size);
+    *checksum = 0;
+    for (int r = 0; r < repeat; ++r) {
+        Hash hash;
+        for (int i = 0; i < size; ++i)
+            hash.insert(key(i), i);
+        *checksum += hash.size();
+    }
+    return timer.elapsed();
+}
+
+void tst_QFlatHashPerformance::insert()
+{
+    QFETCH(int, size);
+
+    int hashChecksum, flatChecksum;
+    int hashTime = timeInsert<QHash<int, int> >(size, &hashChecksum);
+    int flatTime = timeInsert<QFlatHash<int, int> >(size, &flatChecksum);
+    QCOMPARE(flatChecksum, hashChecksum);
+
+    qDebug() << size << "items, insert: QHash" << hashTime << "ms, QFlatHash" << flatTime << "ms";
+}
+
+template <class Hash>
+static int timeLookup(const Hash &hash, int size, int *checksum)
+{
+    QTime timer;
+    timer.start();
+    int repeat = repeatCount(size);
+    *checksum = 0;
+    for (int r = 0; r < repeat; ++r) {
+        // half of the lookups hit, half miss
+        for (int i = 0; i < size; ++i)
+            *checksum += hash.value(key(i * 2), 1);
+    }
+    return timer.elapsed();
+}
+
+void tst_QFlatHashPerformance::lookup()
+{
+    QFETCH(int, size);
+
+    QHash<int, int> hash;
+    QFlatHash<int, int> flat;
+    for (int i = 0; i < size; ++i) {
+        hash.insert(key(i), i);
+        flat.insert(key(i), i);
+    }
+
+    int hashChecksum, flatChecksum;
+    int hashTime = timeLookup(hash, size, &hashChecksum);
+    int flatTime = timeLookup(flat, size, &flatChecksum);
+    QCOMPARE(flatChecksum, hashChecksum);
+
+    qDebug() << size << "items, lookup: QHash" << hashTime << "ms, QFlatHash" << flatTime << "ms";
+}
+
+// building two million string keys takes longer than the lookups
+void tst_QFlatHashPerformance::lookupStrings_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("100000") << 100000;
+}
+
+// QHash allocates its nodes in insertion order, so looking the keys up
+// in that order walks its nodes sequentially; shuffle them to measure
+// the cache misses a real workload would see
+template <class Hash>
+static int timeLookupKeys(const Hash &hash, const QVector<int> &keys, int *checksum)
+{
+    QTime timer;
+    timer.start();
+    int repeat = repeatCount(keys.size());
+    *checksum = 0;
+    for (int r = 0; r < repeat; ++r) {
+        for (int i = 0; i < keys.size(); ++i)
+            *checksum += hash.value(keys.at(i), 1);
+    }
+    return timer.elapsed();
+}
+
+void tst_QFlatHashPerformance::lookupRandomOrder()
+{
+    QFETCH(int, size);
+
+    QHash<int, int> hash;
+    QFlatHash<int, int> flat;
+    for (int i = 0; i < size; ++i) {
+        hash.insert(key(i), i);
+        flat.insert(key(i), i);
+    }
+
+    QVector<int> keys(size);
+    for (int i = 0; i < size; ++i)
+        keys[i] = key(i * 2);
+    qsrand(5);
+    for (int i = size - 1; i > 0; --i)
+        qSwap(keys[i], keys[((uint(qrand()) << 15) ^ uint(qrand())) % uint(i + 1)]);
+
+    int hashChecksum, flatChecksum;
+    int hashTime = timeLookupKeys(hash, keys, &hashChecksum);
+    int flatTime = timeLookupKeys(flat, keys, &flatChecksum);
+    QCOMPARE(flatChecksum, hashChecksum);
+
+    qDebug() << size << "items, lookup in random order: QHash" << hashTime << "ms, QFlatHash" << flatTime << "ms";
+}
+
+template <class Hash>
+static int timeLookupStrings(const Hash &hash, const QStringList &keys, int *checksum)
+{
+    QTime timer;
+    timer.start();
+    int repeat = repeatCount(keys.size());
+    *checksum = 0;
+    for (int r = 0; r < repeat; ++r) {
+        for (int i = 0; i < keys.size(); ++i)
+            *checksum += hash.value(keys.at(i));
+    }
+    return timer.elapsed();
+}
+
+void tst_QFlatHashPerformance::lookupStrings()
+{
+    QFETCH(int, size);
+
+    QStringList keys;
+    QHash<QString, int> hash;
+    QFlatHash<QString, int> flat;
+    for (int i = 0; i < size; ++i) {
+        QString k = QString::number(key(i), 16);
+        keys.append(k);
+        hash.insert(k, i);
+        flat.insert(k, i);
+    }
+
+    int hashChecksum, flatChecksum;
+    int hashTime = timeLookupStrings(hash, keys, &hashChecksum);
+    int flatTime = timeLookupStrings(flat, keys, &flatChecksum);
+    QCOMPARE(flatChecksum, hashChecksum);
+
+    qDebug() << size << "items, string lookup: QHash" << hashTime << "ms, QFlatHash" << flatTime << "ms";
+}
+
+template <class Hash>
+static int timeIterate(const Hash &hash, int size, int *checksum)
+{
+    QTime timer;
+    timer.start();
+    int repeat = repeatCount(size);
+    *checksum = 0;
+    for (int r = 0; r < repeat; ++r) {
+        typename Hash::const_iterator it = hash.constBegin();
+        typename Hash::const_iterator end = hash.constEnd();
+        for (; it != end; ++it)
+            *checksum += it.value();
+    }
+    return timer.elapsed();
+}
+
+void tst_QFlatHashPerformance::iterate()
+{
+    QFETCH(int, size);
+
+    QHash<int, int> hash;
+    QFlatHash<int, int> flat;
+    for (int i = 0; i < size; ++i) {
+        hash.insert(key(i), i);
+        flat.insert(key(i), i);
+    }
+
+    int hashChecksum, flatChecksum;
+    int hashTime = timeIterate(hash, size, &hashChecksum);
+    int flatTime = timeIterate(flat, size, &flatChecksum);
+    QCOMPARE(flatChecksum, hashChecksum);
+
+    qDebug() << size << "items, iterate: QHash" << hashTime << "ms, QFlatHash" << flatTime << "ms";
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatHashPerformance)
+#include "tst_qflathashperformance.moc"
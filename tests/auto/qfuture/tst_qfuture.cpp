@@ -0,0 +1,301 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qfuture.h>
+#include <qfutureinterface.h>
+#include <qthreadpool.h>
+#include <qrunnable.h>
+
+//TESTED_CLASS=QFuture
+//TESTED_FILES=corelib/concurrent/qfuture.h corelib/concurrent/qfutureinterface.h corelib/concurrent/qfutureinterface.cpp corelib/concurrent/qtconcurrentresultstore.h
+
+class tst_QFuture : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultConstruction();
+    void futureInterface();
+    void refcounting();
+    void cancel();
+    void pause();
+    void progress();
+    void resultStore();
+    void filterMode();
+    void iterators();
+    void javaIterator();
+    void voidFuture();
+    void waitForResultFromThread();
+};
+
+void tst_QFuture::defaultConstruction()
+{
+    // a default constructed future is canceled and finished
+    QFuture<int> future;
+    QVERIFY(future.isCanceled());
+    QVERIFY(future.isFinished());
+    QVERIFY(!future.isRunning());
+    QCOMPARE(future.resultCount(), 0);
+    future.waitForFinished();
+
+    QFuture<void> voidFuture;
+    QVERIFY(voidFuture.isCanceled());
+    QVERIFY(voidFuture.isFinished());
+}
+
+void tst_QFuture::futureInterface()
+{
+    QFutureInterface<int> iface;
+    QFuture<int> future = iface.future();
+    QVERIFY(!future.isStarted());
+    QVERIFY(!future.isFinished());
+
+    iface.reportStarted();
+    QVERIFY(future.isStarted());
+    QVERIFY(future.isRunning());
+
+    iface.reportResult(42);
+    QVERIFY(future.isResultReadyAt(0));
+    QCOMPARE(future.result(), 42);
+
+    iface.reportFinished();
+    QVERIFY(future.isFinished());
+    QVERIFY(!future.isRunning());
+    QVERIFY(!future.isCanceled());
+}
+
+void tst_QFuture::refcounting()
+{
+    QFuture<int> a;
+    {
+        QFutureInterface<int> iface;
+        iface.reportStarted();
+        a = iface.future();
+        QFuture<int> b = a;
+        QVERIFY(a == b);
+        QVERIFY(!(a != b));
+        iface.reportResult(7);
+        iface.reportFinished();
+    }
+    // the future keeps the results alive after the interface is gone
+    QCOMPARE(a.result(), 7);
+
+    QFuture<int> c;
+    QVERIFY(a != c);
+    c = a;
+    QVERIFY(a == c);
+}
+
+void tst_QFuture::cancel()
+{
+    QFutureInterface<void> iface;
+    iface.reportStarted();
+    QFuture<void> future = iface.future();
+    QVERIFY(!future.isCanceled());
+    future.cancel();
+    QVERIFY(future.isCanceled());
+    QVERIFY(iface.isCanceled());
+    QVERIFY(!future.isFinished());
+    iface.reportFinished();
+    QVERIFY(future.isFinished());
+
+    // results reported after cancelation are dropped
+    QFutureInterface<int> intIface;
+    intIface.reportStarted();
+    QFuture<int> intFuture = intIface.future();
+    intIface.reportResult(1);
+    intFuture.cancel();
+    intIface.reportResult(2);
+    intIface.reportFinished();
+    QCOMPARE(intFuture.resultCount(), 1);
+}
+
+void tst_QFuture::pause()
+{
+    QFutureInterface<void> iface;
+    iface.reportStarted();
+    QFuture<void> future = iface.future();
+
+    QVERIFY(!future.isPaused());
+    future.pause();
+    QVERIFY(future.isPaused());
+    future.resume();
+    QVERIFY(!future.isPaused());
+    future.togglePaused();
+    QVERIFY(future.isPaused());
+    future.setPaused(false);
+    QVERIFY(!future.isPaused());
+
+    iface.reportFinished();
+}
+
+void tst_QFuture::progress()
+{
+    QFutureInterface<void> iface;
+    QFuture<void> future = iface.future();
+
+    iface.setProgressRange(0, 100);
+    QCOMPARE(future.progressMinimum(), 0);
+    QCOMPARE(future.progressMaximum(), 100);
+
+    iface.setProgressValue(50);
+    QCOMPARE(future.progressValue(), 50);
+
+    // progress never goes backwards
+    iface.setProgressValue(40);
+    QCOMPARE(future.progressValue(), 50);
+
+    iface.setProgressValueAndText(60, QLatin1String("sixty"));
+    QCOMPARE(future.progressValue(), 60);
+    QCOMPARE(future.progressText(), QString("sixty"));
+}
+
+void tst_QFuture::resultStore()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+    QFuture<int> future = iface.future();
+
+    // results may arrive out of order; resultCount() only counts the
+    // contiguous range from index 0
+    iface.reportResult(2, 2);
+    QCOMPARE(future.resultCount(), 0);
+    QVERIFY(future.isResultReadyAt(2));
+    iface.reportResult(0, 0);
+    QCOMPARE(future.resultCount(), 1);
+    iface.reportResult(1, 1);
+    QCOMPARE(future.resultCount(), 3);
+
+    QVector<int> batch;
+    batch << 3 << 4 << 5;
+    iface.reportResults(batch, 3);
+    QCOMPARE(future.resultCount(), 6);
+    iface.reportFinished();
+
+    QList<int> expected;
+    expected << 0 << 1 << 2 << 3 << 4 << 5;
+    QCOMPARE(future.results(), expected);
+    for (int i = 0; i < expected.count(); ++i)
+        QCOMPARE(future.resultAt(i), i);
+}
+
+void tst_QFuture::filterMode()
+{
+    QFutureInterface<int> iface;
+    iface.setFilterMode(true);
+    iface.reportStarted();
+    QFuture<int> future = iface.future();
+
+    // a null result in filter mode leaves no gap in the result indices
+    iface.reportResult(0, 0);
+    iface.reportResult((const int *)0, 2);
+    iface.reportResult(3, 1);
+    iface.reportResults(QVector<int>(), 3, 2);
+    iface.reportResult(5, 5);
+    iface.reportFinished();
+
+    QCOMPARE(future.results(), QList<int>() << 0 << 3 << 5);
+    QCOMPARE(future.resultCount(), 3);
+}
+
+void tst_QFuture::iterators()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+    for (int i = 0; i < 10; ++i)
+        iface.reportResult(i, i);
+    iface.reportFinished();
+
+    QFuture<int> future = iface.future();
+    int expected = 0;
+    for (QFuture<int>::const_iterator it = future.begin(); it != future.end(); ++it)
+        QCOMPARE(*it, expected++);
+    QCOMPARE(expected, 10);
+
+    QFuture<int>::const_iterator it = future.constBegin() + 9;
+    QCOMPARE(*it, 9);
+    --it;
+    QCOMPARE(*it, 8);
+    it -= 3;
+    QCOMPARE(*it, 5);
+    QCOMPARE(*(it + 2), 7);
+}
+
+void tst_QFuture::javaIterator()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+    iface.reportResult(1);
+    iface.reportResult(2);
+    iface.reportResult(3);
+    iface.reportFinished();
+
+    QFutureIterator<int> it(iface.future());
+    int sum = 0;
+    while (it.hasNext())
+        sum += it.next();
+    QCOMPARE(sum, 6);
+    QVERIFY(it.hasPrevious());
+    QCOMPARE(it.previous(), 3);
+    it.toFront();
+    QCOMPARE(it.peekNext(), 1);
+}
+
+void tst_QFuture::voidFuture()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+    QFuture<int> future = iface.future();
+    QFuture<void> voidFuture = future;
+    QVERIFY(voidFuture.isRunning());
+    voidFuture.cancel();
+    QVERIFY(future.isCanceled());
+    iface.reportFinished();
+    QVERIFY(voidFuture.isFinished());
+}
+
+class ResultReporter : public QRunnable
+{
+public:
+    ResultReporter(QFutureInterface<int> *iface) : iface(iface) { }
+
+    void run()
+    {
+        for (int i = 0; i < 5; ++i) {
+            QTest::qSleep(20);
+            iface->reportResult(i, i);
+        }
+        iface->reportFinished();
+    }
+
+    QFutureInterface<int> *iface;
+};
+
+void tst_QFuture::waitForResultFromThread()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+    QFuture<int> future = iface.future();
+
+    ResultReporter reporter(&iface);
+    reporter.setAutoDelete(false);
+    QThreadPool::globalInstance()->start(&reporter);
+
+    // resultAt() blocks until the result has been reported
+    QCOMPARE(future.resultAt(2), 2);
+    QCOMPARE(future.resultAt(4), 4);
+    future.waitForFinished();
+    QVERIFY(future.isFinished());
+    QThreadPool::globalInstance()->waitForDone();
+}
+
+QTEST_MAIN(tst_QFuture)
+#include "tst_qfuture.moc"
@@ -0,0 +1,321 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qfuturewatcher.h>
+#include <qtconcurrentmap.h>
+#include <qtconcurrentrun.h>
+
+//TESTED_CLASS=QFutureWatcher
+//TESTED_FILES=corelib/concurrent/qfuturewatcher.h corelib/concurrent/qfuturewatcher.cpp
+
+class tst_QFutureWatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void startFinish();
+    void futureSignals();
+    void resultsReadyAt();
+    void progressValueChanged();
+    void progressText();
+    void canceled();
+    void pauseBuffersSignals();
+    void watchFinishedFuture();
+    void changeFuture();
+    void disconnectedWatcher();
+    void sharedFutureInterface();
+};
+
+// resultReadyAt() is only emitted when something is connected to it
+// through QObject::connect(), which QSignalSpy does not use.
+class ResultReadyTester : public QObject
+{
+    Q_OBJECT
+public:
+    ResultReadyTester(QFutureWatcherBase *watcher)
+    {
+        connect(watcher, SIGNAL(resultReadyAt(int)), SLOT(resultReadyAt(int)));
+    }
+
+    QList<int> indices;
+
+public slots:
+    void resultReadyAt(int index) { indices.append(index); }
+};
+
+static void sleeper()
+{
+    QTest::qSleep(50);
+}
+
+void tst_QFutureWatcher::startFinish()
+{
+    QFutureWatcher<void> watcher;
+    QSignalSpy started(&watcher, SIGNAL(started()));
+    QSignalSpy finished(&watcher, SIGNAL(finished()));
+
+    watcher.setFuture(QtConcurrent::run(sleeper));
+    QTest::qWait(10); // spin the event loop to deliver queued callouts
+    QCOMPARE(started.count(), 1);
+    QCOMPARE(finished.count(), 0);
+    watcher.future().waitForFinished();
+    QTest::qWait(10);
+    QCOMPARE(started.count(), 1);
+    QCOMPARE(finished.count(), 1);
+    QVERIFY(watcher.isFinished());
+}
+
+void tst_QFutureWatcher::futureSignals()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+
+    QFutureWatcher<int> watcher;
+    QSignalSpy progressSpy(&watcher, SIGNAL(progressValueChanged(int)));
+    QSignalSpy rangeSpy(&watcher, SIGNAL(progressRangeChanged(int, int)));
+    ResultReadyTester resultSpy(&watcher);
+    QSignalSpy finishedSpy(&watcher, SIGNAL(finished()));
+    watcher.setFuture(iface.future());
+
+    iface.setProgressRange(0, 1);
+    iface.setProgressValue(1);
+    iface.reportResult(10);
+    iface.reportFinished();
+
+    // signals are delivered through the event loop, not synchronously
+    QCOMPARE(resultSpy.indices.count(), 0);
+    QTest::qWait(10);
+
+    // the initial state is replayed when the watcher is attached
+    QVERIFY(rangeSpy.count() > 0);
+    QCOMPARE(rangeSpy.last().at(1).toInt(), 1);
+    QVERIFY(progressSpy.count() > 0);
+    QCOMPARE(progressSpy.last().at(0).toInt(), 1);
+    QCOMPARE(resultSpy.indices, QList<int>() << 0);
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(watcher.result(), 10);
+}
+
+void tst_QFutureWatcher::resultsReadyAt()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+
+    QFutureWatcher<int> watcher;
+    ResultReadyTester resultSpy(&watcher);
+    QSignalSpy resultsSpy(&watcher, SIGNAL(resultsReadyAt(int, int)));
+    watcher.setFuture(iface.future());
+
+    QVector<int> batch;
+    batch << 1 << 2 << 3;
+    iface.reportResults(batch);
+    iface.reportResult(4);
+    iface.reportFinished();
+    QTest::qWait(10);
+
+    QCOMPARE(resultsSpy.count(), 2);
+    QCOMPARE(resultsSpy.at(0).at(0).toInt(), 0);
+    QCOMPARE(resultsSpy.at(0).at(1).toInt(), 3);
+    QCOMPARE(resultsSpy.at(1).at(0).toInt(), 3);
+    QCOMPARE(resultsSpy.at(1).at(1).toInt(), 4);
+
+    // resultReadyAt() is emitted once per result
+    QCOMPARE(resultSpy.indices, QList<int>() << 0 << 1 << 2 << 3);
+}
+
+static int multiplyBy2(int x)
+{
+    return 2 * x;
+}
+
+void tst_QFutureWatcher::progressValueChanged()
+{
+    QList<int> list;
+    for (int i = 0; i < 1000; ++i)
+        list.append(i);
+
+    QFutureWatcher<int> watcher;
+    QSignalSpy progressSpy(&watcher, SIGNAL(progressValueChanged(int)));
+    QSignalSpy finishedSpy(&watcher, SIGNAL(finished()));
+    watcher.setFuture(QtConcurrent::mapped(list, multiplyBy2));
+    watcher.waitForFinished();
+
+    QTime time;
+    time.start();
+    while (finishedSpy.count() == 0 && time.elapsed() < 5000)
+        QTest::qWait(10);
+    QCOMPARE(finishedSpy.count(), 1);
+
+    QVERIFY(progressSpy.count() > 0);
+    QCOMPARE(progressSpy.last().at(0).toInt(), list.count());
+    QCOMPARE(watcher.progressValue(), list.count());
+    QCOMPARE(watcher.progressMaximum(), list.count());
+}
+
+void tst_QFutureWatcher::progressText()
+{
+    QFutureInterface<void> iface;
+    iface.reportStarted();
+
+    QFutureWatcher<void> watcher;
+    QSignalSpy textSpy(&watcher, SIGNAL(progressTextChanged(const QString &)));
+    watcher.setFuture(iface.future());
+
+    iface.setProgressValueAndText(1, QLatin1String("one"));
+    iface.reportFinished();
+    QTest::qWait(10);
+
+    QCOMPARE(textSpy.count(), 1);
+    QCOMPARE(textSpy.at(0).at(0).toString(), QString("one"));
+    QCOMPARE(watcher.progressText(), QString("one"));
+}
+
+void tst_QFutureWatcher::canceled()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+
+    QFutureWatcher<int> watcher;
+    QSignalSpy canceledSpy(&watcher, SIGNAL(canceled()));
+    ResultReadyTester resultSpy(&watcher);
+    QSignalSpy finishedSpy(&watcher, SIGNAL(finished()));
+    watcher.setFuture(iface.future());
+
+    iface.reportResult(1);
+    watcher.cancel();
+    QVERIFY(iface.isCanceled());
+    iface.reportResult(2);
+    iface.reportFinished();
+    QTest::qWait(10);
+
+    // no result signals are delivered once the future has been canceled
+    QCOMPARE(canceledSpy.count(), 1);
+    QCOMPARE(resultSpy.indices.count(), 0);
+    QCOMPARE(finishedSpy.count(), 1);
+    QVERIFY(watcher.isCanceled());
+}
+
+void tst_QFutureWatcher::pauseBuffersSignals()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+
+    QFutureWatcher<int> watcher;
+    QSignalSpy pausedSpy(&watcher, SIGNAL(paused()));
+    QSignalSpy resumedSpy(&watcher, SIGNAL(resumed()));
+    ResultReadyTester resultSpy(&watcher);
+    watcher.setFuture(iface.future());
+
+    watcher.pause();
+    QVERIFY(watcher.isPaused());
+    iface.reportResult(1);
+    iface.reportResult(2);
+    QTest::qWait(10);
+    QCOMPARE(pausedSpy.count(), 1);
+    QCOMPARE(resultSpy.indices.count(), 0);
+
+    watcher.resume();
+    QTest::qWait(10);
+    QCOMPARE(resumedSpy.count(), 1);
+    QCOMPARE(resultSpy.indices.count(), 2);
+
+    iface.reportFinished();
+    QTest::qWait(10);
+}
+
+void tst_QFutureWatcher::watchFinishedFuture()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+    iface.reportResult(1);
+    iface.reportResult(2);
+    iface.reportFinished();
+
+    // attaching to a finished future replays its state
+    QFutureWatcher<int> watcher;
+    QSignalSpy startedSpy(&watcher, SIGNAL(started()));
+    ResultReadyTester resultSpy(&watcher);
+    QSignalSpy finishedSpy(&watcher, SIGNAL(finished()));
+    watcher.setFuture(iface.future());
+    QTest::qWait(10);
+
+    QCOMPARE(startedSpy.count(), 1);
+    QCOMPARE(resultSpy.indices.count(), 2);
+    QCOMPARE(finishedSpy.count(), 1);
+}
+
+void tst_QFutureWatcher::changeFuture()
+{
+    QFutureInterface<int> first;
+    first.reportStarted();
+    QFutureInterface<int> second;
+    second.reportStarted();
+
+    QFutureWatcher<int> watcher;
+    ResultReadyTester resultSpy(&watcher);
+    watcher.setFuture(first.future());
+    first.reportResult(1);
+
+    // pending notifications from the old future are dropped
+    watcher.setFuture(second.future());
+    QTest::qWait(10);
+    QCOMPARE(resultSpy.indices.count(), 0);
+
+    first.reportResult(2);
+    second.reportResult(3);
+    QTest::qWait(10);
+    QCOMPARE(resultSpy.indices.count(), 1);
+    QCOMPARE(watcher.result(), 3);
+
+    first.reportFinished();
+    second.reportFinished();
+}
+
+void tst_QFutureWatcher::disconnectedWatcher()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+    {
+        QFutureWatcher<int> watcher;
+        watcher.setFuture(iface.future());
+        iface.reportResult(1);
+    }
+    // destroying the watcher with pending events must be safe
+    iface.reportResult(2);
+    iface.reportFinished();
+    QTest::qWait(10);
+
+    QFutureWatcher<int> watcher;
+    QVERIFY(watcher.isCanceled());
+}
+
+void tst_QFutureWatcher::sharedFutureInterface()
+{
+    QFutureInterface<int> iface;
+    iface.reportStarted();
+
+    QFutureWatcher<int> watcher1;
+    QFutureWatcher<int> watcher2;
+    ResultReadyTester spy1(&watcher1);
+    ResultReadyTester spy2(&watcher2);
+    watcher1.setFuture(iface.future());
+    watcher2.setFuture(iface.future());
+
+    iface.reportResult(1);
+    iface.reportFinished();
+    QTest::qWait(10);
+
+    QCOMPARE(spy1.indices.count(), 1);
+    QCOMPARE(spy2.indices.count(), 1);
+}
+
+QTEST_MAIN(tst_QFutureWatcher)
+#include "tst_qfuturewatcher.moc"
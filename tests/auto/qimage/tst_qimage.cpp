@@ -16,6 +16,7 @@
 #include <stdio.h>
 
 #include <qpainter.h>
+#include <qthreadpool.h>
 
 //TESTED_CLASS=
 //TESTED_FILES=gui/image/qimage.h gui/image/qimage.cpp
@@ -41,6 +42,9 @@ private slots:
 
     void convertToFormat_data();
     void convertToFormat();
+    void convertTo_data();
+    void convertTo();
+    void convertToShared();
 
     void createAlphaMask_data();
     void createAlphaMask();
@@ -54,6 +58,9 @@ private slots:
     void rotate_data();
     void rotate();
 
+    void smoothScale_data();
+    void smoothScale();
+
 #if QT_VERSION >= 0x040102
     void copy();
 #endif
@@ -409,6 +416,52 @@ void tst_QImage::convertToFormat()
     QVERIFY(same);
 }
 
+void tst_QImage::convertTo_data()
+{
+    convertToFormat_data();
+}
+
+void tst_QImage::convertTo()
+{
+    QFETCH(int, inFormat);
+    QFETCH(uint, inPixel);
+    QFETCH(int, resFormat);
+
+    // odd width, so that the SIMD converters also run their tail loops
+    QImage image(37, 5, QImage::Format(inFormat));
+    if (inFormat == QImage::Format_Mono) {
+        image.setColor(0, qRgba(0,0,0,0xff));
+        image.setColor(1, qRgba(255,255,255,0xff));
+    }
+    for (int y=0; y<image.height(); ++y)
+        for (int x=0; x<image.width(); ++x)
+            image.setPixel(x, y, inPixel);
+
+    QImage expected = image.convertToFormat(QImage::Format(resFormat));
+
+    const uchar *bits = image.bits();
+    const bool inPlace = image.depth() == 32 && expected.depth() == 32;
+    image.convertTo(QImage::Format(resFormat));
+
+    QCOMPARE(int(image.format()), resFormat);
+    QCOMPARE(image, expected);
+    if (inPlace)
+        QVERIFY(image.bits() == bits);
+}
+
+void tst_QImage::convertToShared()
+{
+    QImage image(17, 3, QImage::Format_ARGB32);
+    image.fill(0x80ff4020);
+    QImage copy = image;
+
+    image.convertTo(QImage::Format_ARGB32_Premultiplied);
+    QCOMPARE(image.format(), QImage::Format_ARGB32_Premultiplied);
+    QCOMPARE(copy.format(), QImage::Format_ARGB32);
+    QCOMPARE(copy.pixel(16, 2), 0x80ff4020u);
+    QCOMPARE(image, copy.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+}
+
 void tst_QImage::createAlphaMask_data()
 {
     QTest::addColumn<int>("x");
@@ -584,6 +637,65 @@ void tst_QImage::rotate()
     QCOMPARE(original, dest);
 }
 
+void tst_QImage::smoothScale_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<QSize>("sourceSize");
+    QTest::addColumn<QSize>("scaledSize");
+
+    QTest::newRow("argb32, box 2x2") << QImage::Format_ARGB32 << QSize(512, 384) << QSize(256, 192);
+    QTest::newRow("argb32, box 8x4") << QImage::Format_ARGB32 << QSize(512, 384) << QSize(64, 96);
+    QTest::newRow("argb32, down") << QImage::Format_ARGB32 << QSize(512, 384) << QSize(317, 101);
+    QTest::newRow("argb32, down x") << QImage::Format_ARGB32 << QSize(512, 384) << QSize(100, 400);
+    QTest::newRow("argb32, down y") << QImage::Format_ARGB32 << QSize(512, 384) << QSize(600, 50);
+    QTest::newRow("argb32, up") << QImage::Format_ARGB32 << QSize(100, 80) << QSize(333, 555);
+    QTest::newRow("rgb32, box 4x4") << QImage::Format_RGB32 << QSize(512, 384) << QSize(128, 96);
+    QTest::newRow("rgb32, down") << QImage::Format_RGB32 << QSize(512, 384) << QSize(299, 199);
+    QTest::newRow("rgb32, up") << QImage::Format_RGB32 << QSize(100, 80) << QSize(333, 555);
+}
+
+static bool fuzzyCompareColor(QRgb a, QRgb b)
+{
+    return qAbs(qRed(a) - qRed(b)) <= 1 && qAbs(qGreen(a) - qGreen(b)) <= 1
+        && qAbs(qBlue(a) - qBlue(b)) <= 1 && qAbs(qAlpha(a) - qAlpha(b)) <= 1;
+}
+
+void tst_QImage::smoothScale()
+{
+    QFETCH(QImage::Format, format);
+    QFETCH(QSize, sourceSize);
+    QFETCH(QSize, scaledSize);
+
+    const QRgb color = format == QImage::Format_RGB32 ? 0xff406080 : 0x80406080;
+    QImage image(sourceSize, format);
+    image.fill(color);
+
+    QImage scaled = image.scaled(scaledSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    QCOMPARE(scaled.size(), scaledSize);
+    QCOMPARE(scaled.format(), format);
+    for (int y = 0; y < scaled.height(); ++y) {
+        const QRgb *line = reinterpret_cast<const QRgb *>(scaled.scanLine(y));
+        for (int x = 0; x < scaled.width(); ++x)
+            QVERIFY(fuzzyCompareColor(line[x], color));
+    }
+
+    // the result must not depend on how many threads do the scaling
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x)
+            line[x] = qRgba(x * 7 + y, x ^ y, y * 3, format == QImage::Format_RGB32 ? 0xff : x + y);
+    }
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(1);
+    QImage serial = image.scaled(scaledSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    pool->setMaxThreadCount(4);
+    QImage parallel = image.scaled(scaledSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    pool->setMaxThreadCount(maxThreadCount);
+    QCOMPARE(parallel, serial);
+}
+
 #if QT_VERSION >= 0x040102
 void tst_QImage::copy()
 {
@@ -36,6 +36,7 @@ private slots:
 #endif // QT_VERSION
     void getch();
     void putch();
+    void readChunk();
 
     void readLine_data();
     void readLine();
@@ -344,6 +345,49 @@ void tst_QIODevice::putch()
     QCOMPARE(buffer.getch(), 0x00);
 }
 
+void tst_QIODevice::readChunk()
+{
+    QByteArray data;
+    for (int i = 0; i < 100000; ++i)
+        data.append(char('a' + i % 26));
+
+    QBuffer buffer;
+    QFile::remove("chunktestfile");
+    QFile file("chunktestfile");
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write(data), qint64(data.size()));
+    file.close();
+
+    for (int i = 0; i < 2; ++i) {
+        QIODevice *device = i ? (QIODevice *)&file : (QIODevice *)&buffer;
+        if (i == 0)
+            buffer.setData(data);
+        QVERIFY(device->open(QIODevice::ReadOnly));
+
+        // mix chunks with the other read functions
+        QCOMPARE(device->read(3), data.left(3));
+        device->ungetChar('c');
+        QCOMPARE(device->peekChunk().left(2), QByteArray("cd"));
+
+        QByteArray result = data.left(2);
+        QByteArray chunk;
+        while (!(chunk = device->readChunk()).isEmpty()) {
+            result += chunk;
+            QCOMPARE(device->pos(), qint64(result.size()));
+            if (result.size() < 500) {
+                QCOMPARE(device->read(10), data.mid(result.size(), 10));
+                result += data.mid(result.size(), 10);
+            }
+        }
+        QCOMPARE(result, data);
+        QVERIFY(device->atEnd());
+        QVERIFY(device->peekChunk().isEmpty());
+        device->close();
+    }
+
+    file.remove();
+}
+
 void tst_QIODevice::readLine_data()
 {
     QTest::addColumn<QByteArray>("data");
@@ -34,6 +34,7 @@ private slots:
     void lock_unlock_locked_tryLock();
     void stressTest();
     void tryLockRace();
+    void timedTryLockRace();
 };
 
 static const int iterations = 100;
@@ -431,5 +432,48 @@ void tst_QMutex::tryLockRace()
     TryLockRaceThread::mutex.unlock();
 }
 
+class TimedTryLockThread : public QThread
+{
+public:
+    static QMutex mutex;
+    static QBasicAtomicInt sentinel;
+    static QBasicAtomicInt lockCount;
+
+    void run()
+    {
+        QTime t;
+        t.start();
+        int i = 0;
+        do {
+            // mix blocking locks with waits that time out while the
+            // mutex is being handed over
+            if (++i % 2 ? mutex.tryLock(1) : (mutex.lock(), true)) {
+                Q_ASSERT(!sentinel.ref());
+                lockCount.ref();
+                usleep(100);
+                Q_ASSERT(sentinel.deref());
+                mutex.unlock();
+            }
+        } while (t.elapsed() < 5000);
+    }
+};
+QMutex TimedTryLockThread::mutex;
+QBasicAtomicInt TimedTryLockThread::sentinel = Q_BASIC_ATOMIC_INITIALIZER(-1);
+QBasicAtomicInt TimedTryLockThread::lockCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+void tst_QMutex::timedTryLockRace()
+{
+    TimedTryLockThread thread[threadCount];
+    for (int i = 0; i < threadCount; ++i)
+        thread[i].start();
+    for (int i = 0; i < threadCount; ++i)
+        QVERIFY(thread[i].wait(20000));
+    QVERIFY(int(TimedTryLockThread::lockCount) > 0);
+
+    // a timed out wait must not leave the mutex locked
+    QVERIFY(TimedTryLockThread::mutex.tryLock(1000));
+    TimedTryLockThread::mutex.unlock();
+}
+
 QTEST_MAIN(tst_QMutex)
 #include "tst_qmutex.moc"
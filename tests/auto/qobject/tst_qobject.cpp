@@ -76,6 +76,9 @@ private slots:
     void recursiveSignalEmission();
     void blockingQueuedConnection();
     void compatibilityChildInsertedEvents();
+    void connectDisconnectDuringEmission();
+    void emitWhileConnectingInOtherThread();
+    void connectAndEmitInManyThreads();
 
 protected:
 };
@@ -118,6 +121,8 @@ public:
     void emitSignal3() { emit signal3(); }
     void emitSignal4() { emit signal4(); }
 
+    int receiverCount(const char *signal) const { return receivers(signal); }
+
 signals:
     void signal1();
     void signal2();
@@ -2368,5 +2373,214 @@ void tst_QObject::compatibilityChildInsertedEvents()
     }
 }
 
+class EmissionModifier : public QObject
+{
+    Q_OBJECT
+public:
+    EmissionModifier(SenderObject *sender, ReceiverObject *receiver)
+        : sender(sender), receiver(receiver)
+    { }
+
+    SenderObject *sender;
+    ReceiverObject *receiver;
+
+public slots:
+    void disconnectReceiver()
+    {
+        QObject::disconnect(sender, SIGNAL(signal1()), receiver, SLOT(slot2()));
+        QObject::connect(sender, SIGNAL(signal1()), receiver, SLOT(slot3()));
+    }
+
+    void deleteReceiver()
+    {
+        delete receiver;
+        receiver = 0;
+    }
+};
+
+void tst_QObject::connectDisconnectDuringEmission()
+{
+    SenderObject sender;
+    ReceiverObject *receiver = new ReceiverObject;
+    EmissionModifier modifier(&sender, receiver);
+
+    // connections broken by a slot are not called anymore, connections
+    // made by a slot are only called by the next emission
+    QObject::connect(&sender, SIGNAL(signal1()), receiver, SLOT(slot1()));
+    QObject::connect(&sender, SIGNAL(signal1()), &modifier, SLOT(disconnectReceiver()));
+    QObject::connect(&sender, SIGNAL(signal1()), receiver, SLOT(slot2()));
+    sender.emitSignal1();
+    QVERIFY(receiver->called(1));
+    QVERIFY(!receiver->called(2));
+    QVERIFY(!receiver->called(3));
+    QCOMPARE(sender.receiverCount(SIGNAL(signal1())), 3);
+
+    receiver->reset();
+    QObject::disconnect(&sender, SIGNAL(signal1()), &modifier, SLOT(disconnectReceiver()));
+    sender.emitSignal1();
+    QVERIFY(receiver->called(1));
+    QVERIFY(!receiver->called(2));
+    QVERIFY(receiver->called(3));
+
+    // a receiver deleted by a slot is not called anymore
+    receiver->reset();
+    QObject::connect(&sender, SIGNAL(signal2()), &modifier, SLOT(deleteReceiver()));
+    QObject::connect(&sender, SIGNAL(signal2()), receiver, SLOT(slot4()));
+    sender.emitSignal2();
+    QVERIFY(!modifier.receiver);
+    QCOMPARE(sender.receiverCount(SIGNAL(signal2())), 1);
+}
+
+class ConnectingThread : public QThread
+{
+public:
+    ConnectingThread(SenderObject *sender, ReceiverObject *receiver)
+        : sender(sender), receiver(receiver), stop(false)
+    { }
+
+    void run()
+    {
+        while (!stop) {
+            // signal3() is never emitted, so the object is not called
+            QObject *object = new QObject;
+            QObject::connect(sender, SIGNAL(signal3()), object, SLOT(deleteLater()));
+            QObject::connect(sender, SIGNAL(signal1()), receiver, SLOT(slot2()),
+                             Qt::DirectConnection);
+            QObject::disconnect(sender, SIGNAL(signal1()), receiver, SLOT(slot2()));
+            delete object;
+        }
+    }
+
+    SenderObject *sender;
+    ReceiverObject *receiver;
+    volatile bool stop;
+};
+
+void tst_QObject::emitWhileConnectingInOtherThread()
+{
+    SenderObject sender;
+    ReceiverObject receiver;
+    QObject::connect(&sender, SIGNAL(signal1()), &receiver, SLOT(slot1()));
+
+    // emitting does not lock, while the other thread keeps replacing the
+    // connection lists of the sender
+    ConnectingThread thread(&sender, &receiver);
+    thread.start();
+    for (int i = 0; i < 20000; ++i) {
+        receiver.reset();
+        sender.emitSignal1();
+        QVERIFY(receiver.called(1));
+    }
+    thread.stop = true;
+    QVERIFY(thread.wait(10000));
+
+    QCOMPARE(sender.receiverCount(SIGNAL(signal1())), 1);
+    QCOMPARE(sender.receiverCount(SIGNAL(signal3())), 0);
+}
+
+class CountingReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    QAtomicInt count;
+
+public slots:
+    void slot() { count.ref(); }
+};
+
+class ManyConnectingThread : public QThread
+{
+public:
+    ManyConnectingThread(SenderObject *sender, const QList<CountingReceiver *> &receivers)
+        : sender(sender), receivers(receivers)
+    { }
+
+    void run()
+    {
+        // every connection grows the connection list of signal1(), which
+        // keeps publishing new snapshots while the other threads emit
+        for (int i = 0; i < receivers.count(); ++i)
+            QObject::connect(sender, SIGNAL(signal1()), receivers.at(i), SLOT(slot()),
+                             Qt::DirectConnection);
+    }
+
+    SenderObject *sender;
+    QList<CountingReceiver *> receivers;
+};
+
+class EmittingThread : public QThread
+{
+public:
+    EmittingThread(SenderObject *sender)
+        : sender(sender), stop(false), emissions(0)
+    { }
+
+    void run()
+    {
+        while (!stop) {
+            sender->emitSignal1();
+            ++emissions;
+        }
+    }
+
+    SenderObject *sender;
+    volatile bool stop;
+    int emissions;
+};
+
+void tst_QObject::connectAndEmitInManyThreads()
+{
+    enum { ConnectingThreads = 4, EmittingThreads = 4, ReceiversPerThread = 500 };
+
+    SenderObject sender;
+    CountingReceiver first;
+    QObject::connect(&sender, SIGNAL(signal1()), &first, SLOT(slot()), Qt::DirectConnection);
+
+    QList<CountingReceiver *> allReceivers;
+    QList<ManyConnectingThread *> connectingThreads;
+    for (int i = 0; i < ConnectingThreads; ++i) {
+        QList<CountingReceiver *> receivers;
+        for (int j = 0; j < ReceiversPerThread; ++j)
+            receivers.append(new CountingReceiver);
+        allReceivers += receivers;
+        connectingThreads.append(new ManyConnectingThread(&sender, receivers));
+    }
+    QList<EmittingThread *> emittingThreads;
+    for (int i = 0; i < EmittingThreads; ++i)
+        emittingThreads.append(new EmittingThread(&sender));
+
+    for (int i = 0; i < EmittingThreads; ++i)
+        emittingThreads.at(i)->start();
+    for (int i = 0; i < ConnectingThreads; ++i)
+        connectingThreads.at(i)->start();
+
+    for (int i = 0; i < ConnectingThreads; ++i)
+        QVERIFY(connectingThreads.at(i)->wait(60000));
+    int emissions = 0;
+    for (int i = 0; i < EmittingThreads; ++i) {
+        emittingThreads.at(i)->stop = true;
+        QVERIFY(emittingThreads.at(i)->wait(60000));
+        emissions += emittingThreads.at(i)->emissions;
+    }
+
+    // no emission missed the connection made before the threads started
+    QCOMPARE(int(first.count), emissions);
+    QCOMPARE(sender.receiverCount(SIGNAL(signal1())),
+             1 + ConnectingThreads * ReceiversPerThread);
+
+    // every receiver is called exactly once more by a final emission
+    QList<int> counts;
+    for (int i = 0; i < allReceivers.count(); ++i)
+        counts.append(allReceivers.at(i)->count);
+    sender.emitSignal1();
+    QCOMPARE(int(first.count), emissions + 1);
+    for (int i = 0; i < allReceivers.count(); ++i)
+        QCOMPARE(int(allReceivers.at(i)->count), counts.at(i) + 1);
+
+    qDeleteAll(connectingThreads);
+    qDeleteAll(emittingThreads);
+    qDeleteAll(allReceivers);
+}
+
 QTEST_MAIN(tst_QObject)
 #include "tst_qobject.moc"
@@ -1,7 +1,3 @@
-load(qttest_p4)
-QT += qt3support
-SOURCES  += tst_qpainter.cpp
-
-
-DEFINES += QT_USE_USING_NAMESPACE
-
+TEMPLATE = subdirs
+SUBDIRS = test \
+          renderdrawhelper
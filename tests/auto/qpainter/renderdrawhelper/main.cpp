@@ -0,0 +1,167 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+/*
+    Renders a scene with the raster engine and writes the raw pixels to a
+    file. tst_QPainter runs this once with the default CPU features and
+    once with QT_NO_MMX, QT_NO_SSE2 and friends set, and compares the
+    results. The features are detected only once per process, so this
+    has to be a separate program.
+*/
+
+#include <QApplication>
+#include <QBrush>
+#include <QDataStream>
+#include <QFile>
+#include <QImage>
+#include <QPainter>
+#include <QTransform>
+
+// premultiplied pixels with every alpha, including lots of 0 and 255
+static QImage patternImage(int width, int height, int seed)
+{
+    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < height; ++y) {
+        uint *line = reinterpret_cast<uint *>(image.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            int a = (x * 29 + y * 47 + seed * 13) % 256;
+            if ((x + y + seed) % 7 == 0)
+                a = 255;
+            else if ((x + 2 * y + seed) % 11 == 0)
+                a = 0;
+            const int r = (x * 53 + y * 7 + seed) % (a + 1);
+            const int g = (x * 5 + y * 31 + seed * 3) % (a + 1);
+            const int b = (x * 17 + y * 13 + seed * 7) % (a + 1);
+            line[x] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+    return image;
+}
+
+static void paintComposition(QImage *dest, QPainter::CompositionMode mode)
+{
+    const QImage src = patternImage(61, 29, 2);
+
+    QPainter p(dest);
+    p.setCompositionMode(mode);
+
+    // source spans that start unaligned and are not a multiple of 4 long
+    p.drawImage(3, 2, src);
+    p.setOpacity(0.6);
+    p.drawImage(QPoint(1, 9), src, QRect(2, 0, 57, 29));
+    p.setOpacity(1);
+
+    // solid spans, opaque and translucent, with full and partial coverage
+    p.fillRect(QRect(5, 33, 63, 3), QColor(255, 128, 0));
+    p.fillRect(QRect(2, 37, 67, 5), QColor(30, 200, 90, 140));
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(Qt::NoPen);
+    p.setBrush(QColor(0, 90, 255, 100));
+    p.drawEllipse(QRectF(10.5, 5.3, 49.2, 30.1));
+}
+
+static QList<QImage> compositionScene()
+{
+    QList<QImage> images;
+    for (int mode = QPainter::CompositionMode_SourceOver;
+         mode <= QPainter::CompositionMode_Exclusion; ++mode) {
+        QImage argb = patternImage(71, 43, 1);
+        paintComposition(&argb, QPainter::CompositionMode(mode));
+        images << argb;
+
+        QImage rgb = patternImage(71, 43, 3).convertToFormat(QImage::Format_RGB32);
+        paintComposition(&rgb, QPainter::CompositionMode(mode));
+        images << rgb;
+    }
+    return images;
+}
+
+// the channels are 0 or equal to alpha for ARGB32_Premultiplied
+static QImage smoothTransformSource(QImage::Format format)
+{
+    QImage image(13, 11, format);
+    for (int y = 0; y < image.height(); ++y) {
+        uint *line = reinterpret_cast<uint *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            const int i = y * image.width() + x;
+            if (format == QImage::Format_RGB32) {
+                line[x] = 0xff000000 | ((i * 2654435761U) >> 8);
+            } else {
+                const uint a = i % 5 == 0 ? 255 : (i % 7 == 0 ? 0 : (i * 37) % 256);
+                line[x] = (a << 24) | ((i & 1 ? a : 0) << 16) | ((i & 2 ? a : 0) << 8) | (i & 4 ? a : 0);
+            }
+        }
+    }
+    return image;
+}
+
+static QImage paintSmoothTransformed(const QImage &source, bool tiled, const QTransform &transform)
+{
+    QImage image(83, 67, QImage::Format_ARGB32_Premultiplied);
+    image.fill(0);
+    QPainter p(&image);
+    p.setRenderHint(QPainter::SmoothPixmapTransform);
+    if (tiled) {
+        QBrush brush(source);
+        brush.setTransform(transform);
+        p.fillRect(image.rect(), brush);
+    } else {
+        p.translate(41, 33);
+        p.setTransform(transform, true);
+        p.drawImage(-source.width() / 2, -source.height() / 2, source);
+    }
+    return image;
+}
+
+static QList<QImage> smoothTransformScene()
+{
+    QList<QTransform> transforms;
+    transforms << QTransform().scale(4.7, 3.3)
+               << QTransform().scale(0.6, 0.45)
+               << QTransform().rotate(17).scale(3, 3)
+               << QTransform().rotate(-110).scale(2.5, 1.7).shear(0.2, 0);
+
+    QList<QImage> images;
+    for (int tiled = 0; tiled < 2; ++tiled) {
+        for (int i = 0; i < transforms.count(); ++i) {
+            images << paintSmoothTransformed(smoothTransformSource(QImage::Format_RGB32),
+                                             tiled, transforms.at(i))
+                   << paintSmoothTransformed(smoothTransformSource(QImage::Format_ARGB32_Premultiplied),
+                                             tiled, transforms.at(i));
+        }
+    }
+    return images;
+}
+
+int main(int argc, char **argv)
+{
+    QApplication app(argc, argv, false);
+    if (argc != 3)
+        return 1;
+
+    QList<QImage> images;
+    if (qstrcmp(argv[1], "composition") == 0)
+        images = compositionScene();
+    else if (qstrcmp(argv[1], "smoothtransform") == 0)
+        images = smoothTransformScene();
+    else
+        return 1;
+
+    QFile file(QString::fromLocal8Bit(argv[2]));
+    if (!file.open(QIODevice::WriteOnly))
+        return 1;
+    QDataStream out(&file);
+    out << images.count();
+    foreach (const QImage &image, images) {
+        out << image.width() << image.height() << int(image.format());
+        for (int y = 0; y < image.height(); ++y)
+            out.writeRawData(reinterpret_cast<const char *>(image.scanLine(y)), image.width() * 4);
+    }
+    return 0;
+}
@@ -0,0 +1,10 @@
+TEMPLATE = app
+DEPENDPATH += .
+INCLUDEPATH += .
+
+# Input
+SOURCES += main.cpp
+CONFIG += qt warn_on
+CONFIG -= app_bundle
+
+DEFINES += QT_USE_USING_NAMESPACE
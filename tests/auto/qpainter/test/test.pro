@@ -0,0 +1,14 @@
+load(qttest_p4)
+QT += qt3support
+SOURCES  += ../tst_qpainter.cpp
+TARGET = ../tst_qpainter
+
+win32 {
+  CONFIG(debug, debug|release) {
+    TARGET = ../../debug/tst_qpainter
+} else {
+    TARGET = ../../release/tst_qpainter
+  }
+}
+
+DEFINES += QT_USE_USING_NAMESPACE
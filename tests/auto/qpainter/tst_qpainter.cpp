@@ -23,6 +23,8 @@
 #include <qpaintengine.h>
 #include <qdesktopwidget.h>
 #include <qpixmap.h>
+#include <qprocess.h>
+#include <qdir.h>
 
 #include <qpainter.h>
 
@@ -108,6 +110,14 @@ private slots:
     void setOpacity_data();
     void setOpacity();
 
+    void parallelRendering_data();
+    void parallelRendering();
+
+    void simdCompositionModes();
+    void smoothTransformedFetch_data();
+    void smoothTransformedFetch();
+    void simdSmoothTransform();
+
 private:
     void fillData();
     QColor baseColor( int k, int intensity=255 );
@@ -2204,5 +2214,276 @@ void tst_QPainter::setOpacity()
     QCOMPARE(dest, expected);
 }
 
+static void paintParallelRenderingScene(QPainter *p, int w, int h)
+{
+    QLinearGradient lg(0, 0, w, h);
+    lg.setColorAt(0, QColor(255, 0, 0, 200));
+    lg.setColorAt(0.5, Qt::green);
+    lg.setColorAt(1, QColor(0, 0, 255, 120));
+    QRadialGradient rg(w / 2, h / 2, w / 3);
+    rg.setColorAt(0, Qt::yellow);
+    rg.setColorAt(1, QColor(0, 0, 0, 50));
+
+    QImage image(53, 37, QImage::Format_ARGB32);
+    for (int y = 0; y < image.height(); ++y)
+        for (int x = 0; x < image.width(); ++x)
+            image.setPixel(x, y, qRgba(x * 4, y * 6, 128, (x + y) * 3));
+
+    p->fillRect(0, 0, w, h, Qt::white);
+    p->setPen(Qt::black);
+    p->setBrush(Qt::blue);
+    p->drawRect(10, 10, w / 2, h / 2);
+    p->drawLine(0, 0, w, h);
+
+    p->setRenderHint(QPainter::Antialiasing);
+    for (int i = 0; i < 10; ++i) {
+        QPainterPath path;
+        path.addEllipse(i * 15, i * 30, w / 2, h / 3);
+        path.addRect(w - i * 20, i * 10, i * 5, h / 2);
+        p->setPen(QPen(i % 2 ? QBrush(lg) : QBrush(QColor(i * 20, 100, 200, 180)), 1 + i % 3));
+        p->setBrush(i % 3 ? QBrush(rg) : QBrush(lg));
+        p->drawPath(path);
+    }
+
+    p->setClipRect(20, 20, w - 60, h - 50);
+    QPainterPath clip;
+    clip.addEllipse(30, 30, w - 50, h - 70);
+    p->setClipPath(clip, Qt::IntersectClip);
+    p->fillRect(0, 0, w, h, rg);
+    p->setClipping(false);
+    p->drawLine(QLineF(0, h, w, 0));
+    p->setClipping(true);
+
+    p->save();
+    p->translate(w / 2, h / 2);
+    p->rotate(33);
+    p->setOpacity(0.6);
+    p->setRenderHint(QPainter::SmoothPixmapTransform);
+    p->drawImage(QRectF(-60, -40, 120, 80), image);
+    p->setPen(QPen(Qt::red, 3, Qt::DashDotLine));
+    p->drawEllipse(QRectF(-70, -50, 140, 100));
+    p->setClipping(false);
+    p->setClipping(true);
+    p->drawLine(-w, -h, w, h);
+    p->restore();
+
+    p->setCompositionMode(QPainter::CompositionMode_Xor);
+    p->setBrush(QBrush(Qt::darkCyan, Qt::Dense4Pattern));
+    p->drawPolygon(QPolygon() << QPoint(5, h - 5) << QPoint(w / 2, 5) << QPoint(w - 5, h - 5));
+}
+
+void tst_QPainter::parallelRendering_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+    QTest::newRow("QImage::Format_RGB32") << QImage::Format_RGB32;
+    QTest::newRow("QImage::Format_ARGB32") << QImage::Format_ARGB32;
+    QTest::newRow("QImage::Format_ARGB32_Premultiplied") << QImage::Format_ARGB32_Premultiplied;
+}
+
+/*
+    Tests that painting with QPainter::ParallelRendering gives the same
+    image as painting on a single thread.
+*/
+void tst_QPainter::parallelRendering()
+{
+    QFETCH(QImage::Format, format);
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(4);
+
+    const QSize size(211, 397);
+    QImage serial(size, format);
+    QImage parallel(size, format);
+
+    QPainter p(&serial);
+    paintParallelRenderingScene(&p, size.width(), size.height());
+    p.end();
+
+    p.begin(&parallel);
+    p.setRenderHint(QPainter::ParallelRendering);
+    QVERIFY(p.testRenderHint(QPainter::ParallelRendering));
+    paintParallelRenderingScene(&p, size.width(), size.height());
+    p.end();
+
+    pool->setMaxThreadCount(maxThreadCount);
+
+    QCOMPARE(parallel, serial);
+}
+
+#if defined(Q_OS_WIN) && defined(QT_DEBUG)
+static const char renderDrawHelperPath[] = "renderdrawhelper/debug/renderdrawhelper";
+#elif defined(Q_OS_WIN)
+static const char renderDrawHelperPath[] = "renderdrawhelper/release/renderdrawhelper";
+#else
+static const char renderDrawHelperPath[] = "renderdrawhelper/renderdrawhelper";
+#endif
+
+/*
+    Renders \a scene in the renderdrawhelper process and returns the
+    images. With \a generic set, the MMX, SSE and SSE2 draw helpers are
+    disabled in that process, so the generic C functions are used.
+*/
+static QList<QImage> renderWithDrawHelpers(const QString &scene, bool generic)
+{
+    QStringList environment = QProcess::systemEnvironment();
+    if (generic) {
+        environment << "QT_NO_MMX=1" << "QT_NO_MMXEXT=1" << "QT_NO_3DNOW=1"
+                    << "QT_NO_3DNOWEXT=1" << "QT_NO_SSE=1" << "QT_NO_SSE2=1";
+    }
+    const QString fileName = QDir::temp().filePath(QString::fromLatin1("tst_qpainter_%1_%2")
+                                                   .arg(scene).arg(generic ? "generic" : "simd"));
+
+    QList<QImage> images;
+    QProcess process;
+    process.setEnvironment(environment);
+    process.start(QString::fromLatin1(renderDrawHelperPath), QStringList() << scene << fileName);
+    if (!process.waitForFinished(60000) || process.exitStatus() != QProcess::NormalExit
+        || process.exitCode() != 0) {
+        return images;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return images;
+    QDataStream in(&file);
+    int count;
+    in >> count;
+    for (int i = 0; i < count; ++i) {
+        int width, height, format;
+        in >> width >> height >> format;
+        QImage image(width, height, QImage::Format(format));
+        for (int y = 0; y < height; ++y)
+            in.readRawData(reinterpret_cast<char *>(image.scanLine(y)), width * 4);
+        images << image;
+    }
+    file.close();
+    QFile::remove(fileName);
+    return images;
+}
+
+/*
+    Tests that the SIMD composition functions and the SSE2 blendColor
+    give the same pixels as the generic ones, for every composition
+    mode. The scene mixes source and destination alpha and draws spans
+    that start unaligned and are not a multiple of 4 pixels long. In
+    debug builds the SIMD draw helpers are never used, so both runs
+    take the generic path.
+*/
+void tst_QPainter::simdCompositionModes()
+{
+    const QList<QImage> simd = renderWithDrawHelpers("composition", false);
+    const QList<QImage> generic = renderWithDrawHelpers("composition", true);
+    QVERIFY(!simd.isEmpty());
+    QCOMPARE(simd.count(), generic.count());
+
+    // one ARGB32_Premultiplied and one RGB32 destination per mode
+    for (int i = 0; i < simd.count(); ++i) {
+        QVERIFY2(simd.at(i) == generic.at(i),
+                 qPrintable(QString::fromLatin1("composition mode %1, %2 destination")
+                            .arg(i / 2).arg(i % 2 ? "RGB32" : "ARGB32_Premultiplied")));
+    }
+}
+
+// the channels are 0 or equal to alpha for ARGB32_Premultiplied, so
+// converting to ARGB32 and back gives the same pixels
+static QImage smoothTransformSource(QImage::Format format)
+{
+    QImage image(13, 11, format);
+    for (int y = 0; y < image.height(); ++y) {
+        uint *line = reinterpret_cast<uint *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            const int i = y * image.width() + x;
+            if (format == QImage::Format_RGB32) {
+                line[x] = 0xff000000 | ((i * 2654435761U) >> 8);
+            } else {
+                const uint a = i % 5 == 0 ? 255 : (i % 7 == 0 ? 0 : (i * 37) % 256);
+                line[x] = (a << 24) | ((i & 1 ? a : 0) << 16) | ((i & 2 ? a : 0) << 8) | (i & 4 ? a : 0);
+            }
+        }
+    }
+    return image;
+}
+
+static QImage paintSmoothTransformed(const QImage &source, bool tiled, const QTransform &transform)
+{
+    QImage image(83, 67, QImage::Format_ARGB32_Premultiplied);
+    image.fill(0);
+    QPainter p(&image);
+    // Source writes the fetched pixels, scaled only by the coverage
+    p.setCompositionMode(QPainter::CompositionMode_Source);
+    p.setRenderHint(QPainter::SmoothPixmapTransform);
+    if (tiled) {
+        QBrush brush(source);
+        brush.setTransform(transform);
+        p.fillRect(image.rect(), brush);
+    } else {
+        p.translate(41, 33);
+        p.setTransform(transform, true);
+        p.drawImage(-source.width() / 2, -source.height() / 2, source);
+    }
+    return image;
+}
+
+void tst_QPainter::smoothTransformedFetch_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<bool>("tiled");
+    QTest::addColumn<QTransform>("transform");
+
+    QList<QImage::Format> formats;
+    formats << QImage::Format_RGB32 << QImage::Format_ARGB32_Premultiplied;
+    for (int i = 0; i < formats.count(); ++i) {
+        const char *format = formats.at(i) == QImage::Format_RGB32 ? "RGB32" : "ARGB32_Premultiplied";
+        for (int tiled = 0; tiled < 2; ++tiled) {
+            const QString name = QString::fromLatin1("%1, %2, ").arg(format).arg(tiled ? "tiled" : "plain");
+            QTest::newRow(qPrintable(name + "scaled up"))
+                << formats.at(i) << bool(tiled) << QTransform().scale(4.7, 3.3);
+            QTest::newRow(qPrintable(name + "scaled down"))
+                << formats.at(i) << bool(tiled) << QTransform().scale(0.6, 0.45);
+            QTest::newRow(qPrintable(name + "rotated"))
+                << formats.at(i) << bool(tiled) << QTransform().rotate(17).scale(3, 3);
+            QTest::newRow(qPrintable(name + "rotated and sheared"))
+                << formats.at(i) << bool(tiled) << QTransform().rotate(-110).scale(2.5, 1.7).shear(0.2, 0);
+        }
+    }
+}
+
+/*
+    Tests that the bilinear fetches specialized for RGB32 and
+    ARGB32_Premultiplied sources, and qt_fetch_bilinear_affine32(),
+    give the same pixels as the generic fetch, which is used for ARGB32
+    sources.
+*/
+void tst_QPainter::smoothTransformedFetch()
+{
+    QFETCH(QImage::Format, format);
+    QFETCH(bool, tiled);
+    QFETCH(QTransform, transform);
+
+    const QImage source = smoothTransformSource(format);
+    const QImage generic = source.convertToFormat(QImage::Format_ARGB32);
+    QCOMPARE(generic.convertToFormat(format), source);
+
+    const QImage expected = paintSmoothTransformed(generic, tiled, transform);
+    const QImage actual = paintSmoothTransformed(source, tiled, transform);
+    QCOMPARE(actual, expected);
+}
+
+/*
+    Tests that the SSE2 qt_fetch_bilinear_affine32() gives the same
+    pixels as the C version, for the scene of smoothTransformedFetch()
+    drawn with SourceOver.
+*/
+void tst_QPainter::simdSmoothTransform()
+{
+    const QList<QImage> simd = renderWithDrawHelpers("smoothtransform", false);
+    const QList<QImage> generic = renderWithDrawHelpers("smoothtransform", true);
+    QVERIFY(!simd.isEmpty());
+    QCOMPARE(simd.count(), generic.count());
+    for (int i = 0; i < simd.count(); ++i)
+        QVERIFY2(simd.at(i) == generic.at(i), qPrintable(QString::fromLatin1("image %1").arg(i)));
+}
+
 QTEST_MAIN(tst_QPainter)
 #include "tst_qpainter.moc"
@@ -0,0 +1,4 @@
+load(qttest_p4)
+SOURCES  += tst_qpainterperformance.cpp
+
+DEFINES += QT_USE_USING_NAMESPACE
@@ -0,0 +1,129 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qapplication.h>
+#include <qimage.h>
+#include <qpainter.h>
+#include <qthreadpool.h>
+
+//TESTED_CLASS=
+//TESTED_FILES=gui/painting/qpaintengine_raster.cpp
+
+class tst_QPainterPerformance : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parallelRendering_data();
+    void parallelRendering();
+};
+
+Q_DECLARE_METATYPE(QSize)
+
+void tst_QPainterPerformance::parallelRendering_data()
+{
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<int>("threads");
+
+    // the raster engine uses 2 bands per thread, but none lower than 64
+    // lines, so the small image tests how the band count is capped
+    QList<QSize> sizes;
+    sizes << QSize(1024, 768) << QSize(1024, 256);
+    QList<int> threads;
+    threads << 2 << 4 << 8;
+    if (!threads.contains(QThread::idealThreadCount()) && QThread::idealThreadCount() > 1)
+        threads << QThread::idealThreadCount();
+
+    for (int i = 0; i < sizes.count(); ++i) {
+        for (int j = 0; j < threads.count(); ++j) {
+            const QSize &size = sizes.at(i);
+            QTest::newRow(qPrintable(QString::fromLatin1("%1x%2, %3 threads")
+                                     .arg(size.width()).arg(size.height()).arg(threads.at(j))))
+                << size << threads.at(j);
+        }
+    }
+}
+
+static void paintScene(QPainter *p, int w, int h)
+{
+    QLinearGradient lg(0, 0, w, h);
+    lg.setColorAt(0, QColor(255, 0, 0, 200));
+    lg.setColorAt(0.5, Qt::green);
+    lg.setColorAt(1, QColor(0, 0, 255, 120));
+
+    QImage image(97, 61, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < image.height(); ++y)
+        for (int x = 0; x < image.width(); ++x)
+            image.setPixel(x, y, qRgba(x * 2, y * 4, 128, 255));
+
+    p->fillRect(0, 0, w, h, Qt::white);
+
+    p->setRenderHint(QPainter::Antialiasing);
+    for (int i = 0; i < 200; ++i) {
+        const QRectF r((i * 37) % w - 50, (i * 53) % h - 50, 100 + i % 150, 80 + i % 90);
+        p->setPen(QPen(QColor(i % 255, 100, 200, 180), 1 + i % 4));
+        p->setBrush(i % 2 ? QBrush(lg) : QBrush(QColor(40, i % 255, 90, 150)));
+        p->drawEllipse(r);
+    }
+    for (int i = 0; i < 200; ++i) {
+        p->setPen(QPen(QColor(0, 0, i % 255, 200), 3));
+        p->drawLine(QLineF((i * 41) % w, 0, (i * 17) % w, h));
+    }
+
+    p->setRenderHint(QPainter::SmoothPixmapTransform);
+    for (int i = 0; i < 20; ++i) {
+        p->save();
+        p->translate((i * 131) % w, (i * 71) % h);
+        p->rotate(i * 17);
+        p->scale(2.5, 2.5);
+        p->drawImage(0, 0, image);
+        p->restore();
+    }
+}
+
+static int timePaint(const QSize &size, bool parallel)
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    QTime timer;
+    timer.start();
+    for (int i = 0; i < 10; ++i) {
+        QPainter p(&image);
+        p.setRenderHint(QPainter::ParallelRendering, parallel);
+        paintScene(&p, size.width(), size.height());
+    }
+    return timer.elapsed();
+}
+
+/*
+    Compares painting a scene of antialiased ellipses, thick lines and
+    smoothly transformed images serially and with the ParallelRendering
+    hint, using the given number of threads.
+*/
+void tst_QPainterPerformance::parallelRendering()
+{
+    QFETCH(QSize, size);
+    QFETCH(int, threads);
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(threads);
+
+    const int serialTime = timePaint(size, false);
+    const int parallelTime = timePaint(size, true);
+
+    pool->setMaxThreadCount(maxThreadCount);
+
+    qDebug() << size << "on" << QThread::idealThreadCount() << "cores," << threads
+             << "threads: serial" << serialTime << "ms, parallel" << parallelTime << "ms";
+}
+
+QTEST_MAIN(tst_QPainterPerformance)
+#include "tst_qpainterperformance.moc"
@@ -100,6 +100,8 @@ private slots:
     void setStandardOutputFile();
     void setStandardOutputProcess_data();
     void setStandardOutputProcess();
+    void setStandardOutputProcessLargeOutput();
+    void readBufferSize();
     void failToStart();
     void failToStartWithWait();
     void failToStartWithEventLoop();
@@ -107,6 +109,7 @@ private slots:
     void fileWriterProcess();
     void detachedWorkingDirectoryAndPid();
     void switchReadChannels();
+    void readAndWriteChunks();
 
 protected slots:
     void readFromProcess();
@@ -139,6 +142,14 @@ void tst_QProcess::getSetCheck()
     QCOMPARE(QProcess::ProcessChannel(QProcess::StandardOutput), obj1.readChannel());
     obj1.setReadChannel(QProcess::ProcessChannel(QProcess::StandardError));
     QCOMPARE(QProcess::ProcessChannel(QProcess::StandardError), obj1.readChannel());
+
+    // qint64 QProcess::readBufferSize()
+    // void QProcess::setReadBufferSize(qint64)
+    QCOMPARE(obj1.readBufferSize(), qint64(0));
+    obj1.setReadBufferSize(4096);
+    QCOMPARE(obj1.readBufferSize(), qint64(4096));
+    obj1.setReadBufferSize(-1);
+    QCOMPARE(obj1.readBufferSize(), qint64(0));
 }
 
 tst_QProcess::tst_QProcess()
@@ -1665,6 +1676,66 @@ void tst_QProcess::setStandardOutputProcess()
         QCOMPARE(all, QByteArray("HHeelllloo,,  WWoorrlldd"));
 }
 
+static QByteArray testProcessOutput()
+{
+    QByteArray output;
+    for (int i = 0; i < 10240; ++i)
+        output += QByteArray::number(i) + " -this is a number\n";
+    return output;
+}
+
+void tst_QProcess::setStandardOutputProcessLargeOutput()
+{
+    QProcess source;
+    QProcess sink;
+    source.setReadBufferSize(256 * 1024);
+    source.setStandardOutputProcess(&sink);
+
+#ifdef Q_OS_MAC
+    source.start("testProcessOutput/testProcessOutput.app");
+    sink.start("testProcessEcho/testProcessEcho.app");
+#else
+    source.start("testProcessOutput/testProcessOutput");
+    sink.start("testProcessEcho/testProcessEcho");
+#endif
+
+    // the output goes straight from one process to the other
+    QPROCESS_VERIFY(source, waitForFinished());
+    QCOMPARE(source.bytesAvailable(), qint64(0));
+    QPROCESS_VERIFY(sink, waitForFinished());
+    QCOMPARE(sink.readAllStandardOutput(), testProcessOutput());
+}
+
+void tst_QProcess::readBufferSize()
+{
+    QProcess process;
+    process.setReadBufferSize(4096);
+#ifdef Q_OS_MAC
+    process.start("testProcessOutput/testProcessOutput.app");
+#else
+    process.start("testProcessOutput/testProcessOutput");
+#endif
+    QVERIFY(process.waitForStarted(5000));
+
+    // the process waits for us when the buffer is full
+    QTestEventLoop::instance().enterLoop(1);
+    QVERIFY(process.bytesAvailable() >= 4096);
+    QVERIFY(process.bytesAvailable() < 4096 + 65536);
+    QCOMPARE(process.state(), QProcess::Running);
+
+    // and continues when the data has been read
+    QByteArray output;
+    QTime stopWatch;
+    stopWatch.start();
+    while (process.state() == QProcess::Running && stopWatch.elapsed() < 30000) {
+        output += process.readAllStandardOutput();
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 100);
+    }
+    QCOMPARE(process.state(), QProcess::NotRunning);
+    output += process.readAll();
+    QCOMPARE(output, testProcessOutput());
+}
+
 void tst_QProcess::fileWriterProcess()
 {
     QString stdinStr;
@@ -1753,5 +1824,40 @@ void tst_QProcess::switchReadChannels()
     QCOMPARE(process.read(1), QByteArray("D"));
 }
 
+//-----------------------------------------------------------------------------
+void tst_QProcess::readAndWriteChunks()
+{
+    QByteArray data;
+    for (int i = 0; i < 20000; ++i)
+        data.append(char('a' + i % 26));
+
+    QProcess process;
+#ifdef Q_OS_MAC
+    process.start("testProcessEcho/testProcessEcho.app");
+#else
+    process.start("testProcessEcho/testProcessEcho");
+#endif
+    QVERIFY(process.waitForStarted(5000));
+
+    // large arrays are queued without being copied
+    QCOMPARE(process.write(data), qint64(data.size()));
+    QCOMPARE(process.bytesToWrite(), qint64(data.size()));
+
+    QByteArray result;
+    while (result.size() < data.size()) {
+        if (process.bytesAvailable() == 0 && !process.waitForReadyRead(5000))
+            break;
+        QByteArray peeked = process.peekChunk();
+        QByteArray chunk = process.readChunk();
+        QCOMPARE(chunk, peeked);
+        QVERIFY(!chunk.isEmpty());
+        result += chunk;
+    }
+    QCOMPARE(result, data);
+
+    process.write("", 1);
+    QVERIFY(process.waitForFinished(5000));
+}
+
 QTEST_MAIN(tst_QProcess)
 #include "tst_qprocess.moc"
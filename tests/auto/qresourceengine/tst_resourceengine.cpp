@@ -9,6 +9,7 @@
 
 #include <QtTest/QtTest>
 #include <QtCore>
+#include <private/qresource_p.h>
 
 class tst_ResourceEngine: public QObject
 {
@@ -24,6 +25,7 @@ private slots:
     void checkStructure();
     void searchPath_data();
     void searchPath();
+    void lookupIndex();
 };
 
 Q_DECLARE_METATYPE(QLocale)
@@ -402,6 +404,57 @@ void tst_ResourceEngine::checkUnregisterResource()
     QCOMPARE((int)fileInfo.size(), size);
 }
 
+void tst_ResourceEngine::lookupIndex()
+{
+    const QString file(":/lookup_index/runtime_resource/test/abc/123/+++/currentdir.txt");
+    QVERIFY(!QFile::exists(file));
+
+    // registering a resource drops the remembered misses
+    QVERIFY(QResource::registerResource("runtime_resource.rcc", "/lookup_index/"));
+    QVERIFY(QFile::exists(file));
+
+    // looking up the same path again does not search the resource roots
+    qt_resource_reset_lookup_statistics();
+    QVERIFY(QResource(file).isValid());
+    QResourceLookupStatistics stats = qt_resource_lookup_statistics();
+    QCOMPARE(stats.lookups, 1);
+    QCOMPARE(stats.indexHits, 1);
+    QCOMPARE(stats.rootsSearched, 0);
+
+    const QString other(":/lookup_index/runtime_resource/otherdir/otherdir.txt");
+    QVERIFY(QResource(other).isValid());
+    stats = qt_resource_lookup_statistics();
+    QCOMPARE(stats.lookups, 2);
+    QCOMPARE(stats.indexHits, 1);
+    QVERIFY(stats.rootsSearched >= 1);
+    const int rootsSearched = stats.rootsSearched;
+    QVERIFY(QResource(other).isValid());
+    stats = qt_resource_lookup_statistics();
+    QCOMPARE(stats.lookups, 3);
+    QCOMPARE(stats.indexHits, 2);
+    QCOMPARE(stats.rootsSearched, rootsSearched);
+
+    // unregistering a resource drops the remembered hits
+    QVERIFY(QResource::unregisterResource("runtime_resource.rcc", "/lookup_index/"));
+    QVERIFY(!QResource(file).isValid());
+    QVERIFY(!QFile::exists(file));
+
+    // the index follows the default locale
+    QVERIFY(QResource::registerResource("runtime_resource.rcc", "/lookup_index/"));
+    const QString alias(":/lookup_index/runtime_resource/aliasdir/aliasdir.txt");
+    {
+        QFile file1(alias);
+        QVERIFY(file1.open(QFile::ReadOnly));
+        QVERIFY(file1.readAll().startsWith("\"This is another file in this directory\""));
+        QLocale::setDefault(QLocale("de"));
+        QFile file2(alias);
+        QVERIFY(file2.open(QFile::ReadOnly));
+        QVERIFY(file2.readAll().startsWith("Deutsch"));
+        QLocale::setDefault(QLocale::system());
+    }
+    QVERIFY(QResource::unregisterResource("runtime_resource.rcc", "/lookup_index/"));
+}
+
 QTEST_MAIN(tst_ResourceEngine)
 
 #include "tst_resourceengine.moc"
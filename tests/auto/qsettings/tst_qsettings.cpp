@@ -89,6 +89,9 @@ private slots:
     void registerFormat();
     void setPath();
 #endif
+#if QT_VERSION >= 0x040400
+    void binaryFormat();
+#endif
 
     /*
         These tests were developed for the Qt 3 QSettings class.
@@ -241,6 +244,9 @@ static void populateWithFormats()
 
     QTest::newRow("native") << QSettings::NativeFormat;
     QTest::newRow("ini") << QSettings::IniFormat;
+#if QT_VERSION >= 0x040400
+    QTest::newRow("binary") << QSettings::BinaryFormat;
+#endif
 #if QT_VERSION >= 0x040100
     QTest::newRow("custom1") << QSettings::CustomFormat1;
     QTest::newRow("custom2") << QSettings::CustomFormat2;
@@ -1020,7 +1026,8 @@ void tst_QSettings::testVariantTypes()
 
     // With Qt 4.2 we store key sequences as strings instead of binary variant blob, for improved
     // readability in the resulting format.
-    if (format >= QSettings::InvalidFormat || QT_VERSION < 0x040200) {
+    if (format >= QSettings::InvalidFormat || format == QSettings::BinaryFormat
+        || QT_VERSION < 0x040200) {
         testVal("keysequence", QKeySequence(Qt::ControlModifier + Qt::Key_F1), QKeySequence, KeySequence);
     } else {
         testVal("keysequence", QKeySequence(Qt::ControlModifier + Qt::Key_F1), QString, String);
@@ -2438,6 +2445,9 @@ void tst_QSettings::testCaseSensitivity()
 #endif
             break;
         case QSettings::IniFormat:
+#if QT_VERSION >= 0x040400
+        case QSettings::BinaryFormat:
+#endif
             cs = false;
             break;
 #if QT_VERSION >= 0x040100
@@ -3439,6 +3449,10 @@ void tst_QSettings::setPath()
 #endif
         TEST_PATH(i == 0, "ini", IniFormat, UserScope, "gamma")
         TEST_PATH(i == 0, "ini", IniFormat, SystemScope, "omicron")
+#if QT_VERSION >= 0x040400
+        TEST_PATH(i == 0, "qsb", BinaryFormat, UserScope, "kappa")
+        TEST_PATH(i == 0, "qsb", BinaryFormat, SystemScope, "lambda")
+#endif
         TEST_PATH(i == 0, "custom1", CustomFormat1, UserScope, "epsilon")
         TEST_PATH(i == 0, "custom1", CustomFormat1, SystemScope, "zeta")
         TEST_PATH(i == 0, "custom2", CustomFormat2, UserScope, "eta")
@@ -3447,6 +3461,72 @@ void tst_QSettings::setPath()
 }
 #endif
 
+#if QT_VERSION >= 0x040400
+void tst_QSettings::binaryFormat()
+{
+    QString fileName = settingsPath("someDir/settings.qsb");
+
+    {
+        QSettings settings(fileName, QSettings::BinaryFormat);
+        for (int i = 0; i < 1000; ++i)
+            settings.setValue(QString("group%1/key%2").arg(i % 10).arg(i), i);
+        settings.setValue("data", QByteArray("a\0b", 3));
+    }
+    QConfFile::clearCache();
+
+    QSettings settings(fileName, QSettings::BinaryFormat);
+    QCOMPARE(settings.status(), QSettings::NoError);
+    QCOMPARE(settings.value("group3/key123").toInt(), 123);
+    QCOMPARE(settings.value("GROUP3/KEY123").toInt(), 123);
+    QCOMPARE(settings.value("data").toByteArray(), QByteArray("a\0b", 3));
+    QVERIFY(!settings.contains("group3/key124"));
+    QCOMPARE(settings.childGroups().count(), 10);
+    settings.beginGroup("group9");
+    QCOMPARE(settings.childKeys().count(), 100);
+    settings.endGroup();
+
+    // unchanged values are kept when others are written
+    settings.setValue("group3/key123", -123);
+    settings.remove("group4");
+    settings.sync();
+    QCOMPARE(settings.status(), QSettings::NoError);
+    QConfFile::clearCache();
+    {
+        QSettings settings2(fileName, QSettings::BinaryFormat);
+        QCOMPARE(settings2.value("group3/key123").toInt(), -123);
+        QCOMPARE(settings2.value("group3/key133").toInt(), 133);
+        QVERIFY(!settings2.contains("group4/key124"));
+        QCOMPARE(settings2.allKeys().count(), 901);
+    }
+
+    /*
+        Replace the file behind our back with one that has the same
+        size. It is noticed even if the time stamp doesn't change.
+    */
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray contents = file.readAll();
+    file.close();
+    int valuePos = contents.indexOf(QByteArray("a\0b", 3));
+    QVERIFY(valuePos != -1);
+    contents[8] = char(contents.at(8) + 1);     // the generation
+    contents[valuePos + 2] = 'c';
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write(contents), qint64(contents.size()));
+    file.close();
+    settings.sync();
+    QCOMPARE(settings.value("data").toByteArray(), QByteArray("a\0c", 3));
+
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("This is not a binary settings file");
+    file.close();
+    QConfFile::clearCache();
+    QSettings settings3(fileName, QSettings::BinaryFormat);
+    QCOMPARE(settings3.status(), QSettings::FormatError);
+    QVERIFY(settings3.allKeys().isEmpty());
+}
+#endif
+
 void tst_QSettings::rainersSyncBugOnMac_data()
 {
     ctor_data();
@@ -15,6 +15,12 @@
 #include <QtNetwork/QTcpSocket>
 #include <private/qnativesocketengine_p.h>
 
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <unistd.h>
+#endif
+
 class tst_QSocketNotifier : public QObject
 {
     Q_OBJECT
@@ -24,6 +30,11 @@ public:
 
 private slots:
     void unexpectedDisconnection();
+#ifdef Q_OS_UNIX
+    void pipeNotifiers();
+    void deleteWhilePending();
+    void manyNotifiers();
+#endif
 };
 
 tst_QSocketNotifier::tst_QSocketNotifier()
@@ -142,5 +153,167 @@ void tst_QSocketNotifier::unexpectedDisconnection()
     server.close();
 }
 
+#ifdef Q_OS_UNIX
+class ActivationCounter : public QObject
+{
+    Q_OBJECT
+public:
+    ActivationCounter() : count(0), lastSocket(-1) { }
+
+    int count;
+    int lastSocket;
+    QList<QSocketNotifier *> toDelete;
+
+public slots:
+    void activated(int socket)
+    {
+        ++count;
+        lastSocket = socket;
+        // delete the other notifiers, which may already be pending
+        for (int i = 0; i < toDelete.count(); ++i) {
+            if (toDelete.at(i) != sender())
+                delete toDelete.at(i);
+        }
+        toDelete.clear();
+    }
+};
+
+static void drainPipe(int fd)
+{
+    char c[16];
+    (void) ::read(fd, c, sizeof(c));
+}
+
+void tst_QSocketNotifier::pipeNotifiers()
+{
+    int fds[2];
+    QVERIFY(::pipe(fds) == 0);
+
+    ActivationCounter readCounter;
+    QSocketNotifier readNotifier(fds[0], QSocketNotifier::Read);
+    connect(&readNotifier, SIGNAL(activated(int)), &readCounter, SLOT(activated(int)));
+
+    // nothing to read yet
+    QCoreApplication::processEvents();
+    QCOMPARE(readCounter.count, 0);
+
+    QCOMPARE(int(::write(fds[1], "x", 1)), 1);
+    QCoreApplication::processEvents();
+    QCOMPARE(readCounter.count, 1);
+    QCOMPARE(readCounter.lastSocket, fds[0]);
+
+    // a disabled notifier is not activated
+    readNotifier.setEnabled(false);
+    QCoreApplication::processEvents();
+    QCOMPARE(readCounter.count, 1);
+
+    // level triggered: still readable after being enabled again
+    readNotifier.setEnabled(true);
+    QCoreApplication::processEvents();
+    QCOMPARE(readCounter.count, 2);
+    drainPipe(fds[0]);
+    QCoreApplication::processEvents();
+    QCOMPARE(readCounter.count, 2);
+
+    // read and write notifiers on the same descriptor pair
+    ActivationCounter writeCounter;
+    QSocketNotifier writeNotifier(fds[1], QSocketNotifier::Write);
+    connect(&writeNotifier, SIGNAL(activated(int)), &writeCounter, SLOT(activated(int)));
+    QCoreApplication::processEvents();
+    QCOMPARE(writeCounter.count, 1);
+    QCOMPARE(readCounter.count, 2);
+    writeNotifier.setEnabled(false);
+
+    ::close(fds[1]);
+    // the reader sees the hang up
+    QCoreApplication::processEvents();
+    QCOMPARE(readCounter.count, 3);
+
+    readNotifier.setEnabled(false);
+    ::close(fds[0]);
+}
+
+void tst_QSocketNotifier::deleteWhilePending()
+{
+    int fds1[2], fds2[2];
+    QVERIFY(::pipe(fds1) == 0);
+    QVERIFY(::pipe(fds2) == 0);
+    QCOMPARE(int(::write(fds1[1], "1", 1)), 1);
+    QCOMPARE(int(::write(fds2[1], "2", 1)), 1);
+
+    // whichever notifier is activated first deletes the other one
+    ActivationCounter counter;
+    QSocketNotifier *notifier1 = new QSocketNotifier(fds1[0], QSocketNotifier::Read);
+    QSocketNotifier *notifier2 = new QSocketNotifier(fds2[0], QSocketNotifier::Read);
+    connect(notifier1, SIGNAL(activated(int)), &counter, SLOT(activated(int)));
+    connect(notifier2, SIGNAL(activated(int)), &counter, SLOT(activated(int)));
+    counter.toDelete << notifier1 << notifier2;
+
+    QCoreApplication::processEvents();
+    QCOMPARE(counter.count, 1);
+    QCoreApplication::processEvents();
+    QCOMPARE(counter.count, 2);
+    delete (counter.lastSocket == fds1[0] ? notifier1 : notifier2);
+
+    ::close(fds1[0]);
+    ::close(fds1[1]);
+    ::close(fds2[0]);
+    ::close(fds2[1]);
+}
+
+void tst_QSocketNotifier::manyNotifiers()
+{
+    QAbstractEventDispatcher *dispatcher = QAbstractEventDispatcher::instance();
+    if (!dispatcher || !dispatcher->inherits("QEventDispatcherEPoll"))
+        QSKIP("Descriptors above FD_SETSIZE need the epoll event dispatcher", SkipAll);
+
+    const int pipeCount = FD_SETSIZE / 2 + 64;
+    rlimit limit;
+    QVERIFY(::getrlimit(RLIMIT_NOFILE, &limit) == 0);
+    if (limit.rlim_cur < rlim_t(2 * pipeCount + 64)) {
+        limit.rlim_cur = qMin(limit.rlim_max, rlim_t(2 * pipeCount + 64));
+        ::setrlimit(RLIMIT_NOFILE, &limit);
+        ::getrlimit(RLIMIT_NOFILE, &limit);
+        if (limit.rlim_cur < rlim_t(2 * pipeCount + 64))
+            QSKIP("Not enough file descriptors available", SkipAll);
+    }
+
+    QList<int> readFds, writeFds;
+    QList<QSocketNotifier *> notifiers;
+    ActivationCounter counter;
+    for (int i = 0; i < pipeCount; ++i) {
+        int fds[2];
+        QVERIFY(::pipe(fds) == 0);
+        readFds << fds[0];
+        writeFds << fds[1];
+        QSocketNotifier *notifier = new QSocketNotifier(fds[0], QSocketNotifier::Read);
+        connect(notifier, SIGNAL(activated(int)), &counter, SLOT(activated(int)));
+        notifiers << notifier;
+    }
+    QVERIFY(readFds.last() >= FD_SETSIZE);
+
+    QCoreApplication::processEvents();
+    QCOMPARE(counter.count, 0);
+
+    // only the ready descriptor is activated
+    QCOMPARE(int(::write(writeFds.last(), "x", 1)), 1);
+    QCoreApplication::processEvents();
+    QCOMPARE(counter.count, 1);
+    QCOMPARE(counter.lastSocket, readFds.last());
+    drainPipe(readFds.last());
+
+    QCOMPARE(int(::write(writeFds.at(3), "x", 1)), 1);
+    QCoreApplication::processEvents();
+    QCOMPARE(counter.count, 2);
+    QCOMPARE(counter.lastSocket, readFds.at(3));
+
+    qDeleteAll(notifiers);
+    for (int i = 0; i < pipeCount; ++i) {
+        ::close(readFds.at(i));
+        ::close(writeFds.at(i));
+    }
+}
+#endif
+
 QTEST_MAIN(tst_QSocketNotifier)
 #include <tst_qsocketnotifier.moc>
@@ -156,6 +156,9 @@ private slots:
     void resizeAfterFromRawData();
     void resizeAfterReserve();
     void QCharRefMutableUnicode() const;
+    void latin1Runs();
+    void utf8Runs();
+    void searchAndCompareRuns();
 };
 
 typedef QList<int> IntList;
@@ -4136,6 +4139,117 @@ void tst_QString::QCharRefMutableUnicode() const
     QCOMPARE(str, QString::fromLatin1("str"));
 }
 
+// The conversion and search loops work on blocks of characters, so
+// these check every length and every position of the interesting
+// character up to a few blocks.
+static const int RunLength = 70;
+
+static QByteArray encodeUtf8(ushort u)
+{
+    QByteArray utf8;
+    if (u < 0x80) {
+        utf8 += char(u);
+    } else if (u < 0x800) {
+        utf8 += char(0xc0 | (u >> 6));
+        utf8 += char(0x80 | (u & 0x3f));
+    } else {
+        utf8 += char(0xe0 | (u >> 12));
+        utf8 += char(0x80 | ((u >> 6) & 0x3f));
+        utf8 += char(0x80 | (u & 0x3f));
+    }
+    return utf8;
+}
+
+void tst_QString::latin1Runs()
+{
+    for (int len = 0; len < RunLength; ++len) {
+        for (int pos = 0; pos < len; ++pos) {
+            QByteArray latin1(len, 'a');
+            latin1[pos] = '\xe9';
+            latin1[len - 1] = '\xff';
+            QString expected(len, QLatin1Char('a'));
+            expected[pos] = QChar(0xe9);
+            expected[len - 1] = QChar(0xff);
+            QString str = QString::fromLatin1(latin1.constData(), len);
+            QCOMPARE(str, expected);
+            QCOMPARE(str.toLatin1(), latin1);
+
+            str[pos] = QChar(0x20ac);
+            latin1[pos] = '?';
+            QCOMPARE(str.toLatin1(), latin1);
+            str[pos] = QChar(0x100);
+            QCOMPARE(str.toLatin1(), latin1);
+        }
+    }
+}
+
+void tst_QString::utf8Runs()
+{
+    QTextCodec *codec = QTextCodec::codecForName("UTF-8");
+    QVERIFY(codec);
+
+    const ushort specials[] = { 0x7f, 0x80, 0xe9, 0x7ff, 0x800, 0x20ac, 0xfffd };
+    const int specialCount = sizeof(specials) / sizeof(specials[0]);
+    for (int len = 1; len < RunLength; ++len) {
+        for (int pos = 0; pos < len; ++pos) {
+            for (int i = 0; i < specialCount; ++i) {
+                QString str(len, QLatin1Char('x'));
+                str[pos] = QChar(specials[i]);
+
+                QByteArray utf8 = QByteArray(pos, 'x') + encodeUtf8(specials[i])
+                                  + QByteArray(len - pos - 1, 'x');
+
+                QCOMPARE(str.toUtf8(), utf8);
+                QCOMPARE(codec->fromUnicode(str), utf8);
+                QCOMPARE(QString::fromUtf8(utf8), str);
+                QCOMPARE(codec->toUnicode(utf8), str);
+            }
+
+            // a surrogate pair
+            QString str(len + 1, QLatin1Char('y'));
+            str[pos] = QChar(0xd800);
+            str[pos + 1] = QChar(0xdc00);
+            QByteArray utf8 = QByteArray(pos, 'y') + "\xf0\x90\x80\x80" + QByteArray(len - pos - 1, 'y');
+            QCOMPARE(str.toUtf8(), utf8);
+            QCOMPARE(QString::fromUtf8(utf8), str);
+
+            // an invalid sequence in the middle of ASCII
+            QByteArray invalid(len, 'z');
+            invalid[pos] = '\xc3';
+            QString expected(len, QLatin1Char('z'));
+            expected[pos] = QChar(QChar::ReplacementCharacter);
+            QCOMPARE(QString::fromUtf8(invalid), expected);
+        }
+    }
+}
+
+void tst_QString::searchAndCompareRuns()
+{
+    for (int len = 1; len < RunLength; ++len) {
+        QString str(len, QLatin1Char('a'));
+        QCOMPARE(str.indexOf(QLatin1Char('b')), -1);
+        for (int pos = 0; pos < len; ++pos) {
+            QString other = str;
+            other[pos] = QLatin1Char('b');
+            QCOMPARE(other.indexOf(QLatin1Char('b')), pos);
+            QCOMPARE(other.indexOf(QLatin1Char('b'), pos), pos);
+            QCOMPARE(other.indexOf(QLatin1Char('b'), pos + 1), -1);
+            QCOMPARE(other.indexOf(QLatin1Char('b'), pos - len), pos);
+
+            QVERIFY(str < other);
+            QVERIFY(!(other < str));
+            QVERIFY(str.compare(other) < 0);
+            QVERIFY(other.compare(str) > 0);
+            QVERIFY(other.left(pos) < other);
+            QCOMPARE(other.compare(other.left(pos + 1) + str.mid(pos + 1)), 0);
+
+            other[pos] = QChar(0xff61);
+            QVERIFY(str < other);
+            QCOMPARE(other.indexOf(QChar(0xff61)), pos);
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "tst_qstring.moc"
@@ -0,0 +1,210 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qtconcurrentfilter.h>
+#include <qlist.h>
+#include <qvector.h>
+#include <qstringlist.h>
+
+//TESTED_FILES=corelib/concurrent/qtconcurrentfilter.h corelib/concurrent/qtconcurrentfilterkernel.h
+
+class tst_QtConcurrentFilter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void filter();
+    void filtered();
+    void filteredReduced();
+    void blockingFiltered();
+    void memberFunctions();
+    void resultOrder();
+    void emptySequence();
+    void nothingKept();
+    void cancel();
+};
+
+static bool keepEvenIntegers(const int &x)
+{
+    return (x & 1) == 0;
+}
+
+class KeepEvenIntegers
+{
+public:
+    typedef bool result_type;
+
+    bool operator()(const int &x) const { return (x & 1) == 0; }
+};
+
+static void intSumReduce(int &sum, int x)
+{
+    sum += x;
+}
+
+class IntSumReduce
+{
+public:
+    typedef int result_type;
+
+    void operator()(int &sum, int x) const { sum += x; }
+};
+
+static QList<int> sequence(int count)
+{
+    QList<int> list;
+    for (int i = 0; i < count; ++i)
+        list.append(i);
+    return list;
+}
+
+void tst_QtConcurrentFilter::filter()
+{
+    {
+        QList<int> list;
+        list << 1 << 2 << 3 << 4;
+        QtConcurrent::filter(list, keepEvenIntegers).waitForFinished();
+        QCOMPARE(list, QList<int>() << 2 << 4);
+    }
+    {
+        QVector<int> vector;
+        vector << 1 << 2 << 3 << 4;
+        QtConcurrent::filter(vector, KeepEvenIntegers()).waitForFinished();
+        QCOMPARE(vector, QVector<int>() << 2 << 4);
+    }
+    {
+        QList<int> list;
+        list << 1 << 2 << 3 << 4;
+        QtConcurrent::blockingFilter(list, keepEvenIntegers);
+        QCOMPARE(list, QList<int>() << 2 << 4);
+    }
+}
+
+void tst_QtConcurrentFilter::filtered()
+{
+    QList<int> list;
+    list << 1 << 2 << 3 << 4;
+
+    QFuture<int> future = QtConcurrent::filtered(list, keepEvenIntegers);
+    QCOMPARE(future.results(), QList<int>() << 2 << 4);
+    QCOMPARE(future.resultCount(), 2);
+
+    future = QtConcurrent::filtered(list.constBegin(), list.constEnd(), KeepEvenIntegers());
+    QCOMPARE(future.results(), QList<int>() << 2 << 4);
+
+    // the Java-style iterator skips the filtered out gaps
+    QFutureIterator<int> it(future);
+    QVERIFY(it.hasNext());
+    QCOMPARE(it.next(), 2);
+    QCOMPARE(it.next(), 4);
+    QVERIFY(!it.hasNext());
+
+    QCOMPARE(list, QList<int>() << 1 << 2 << 3 << 4);
+}
+
+void tst_QtConcurrentFilter::filteredReduced()
+{
+    QList<int> list;
+    list << 1 << 2 << 3 << 4;
+
+    QCOMPARE(QtConcurrent::filteredReduced(list, keepEvenIntegers, intSumReduce).result(), 6);
+    QCOMPARE(QtConcurrent::filteredReduced<int>(list, KeepEvenIntegers(), IntSumReduce()).result(), 6);
+    QCOMPARE(QtConcurrent::filteredReduced(list.constBegin(), list.constEnd(), keepEvenIntegers, intSumReduce).result(), 6);
+    QCOMPARE(QtConcurrent::blockingFilteredReduced(list, keepEvenIntegers, intSumReduce), 6);
+    QCOMPARE(QtConcurrent::blockingFilteredReduced<int>(list.constBegin(), list.constEnd(), KeepEvenIntegers(), IntSumReduce()), 6);
+}
+
+void tst_QtConcurrentFilter::blockingFiltered()
+{
+    QList<int> list;
+    list << 1 << 2 << 3 << 4;
+
+    QCOMPARE(QtConcurrent::blockingFiltered(list, keepEvenIntegers), QList<int>() << 2 << 4);
+    QCOMPARE(QtConcurrent::blockingFiltered<QVector<int> >(list.constBegin(), list.constEnd(), KeepEvenIntegers()),
+             QVector<int>() << 2 << 4);
+}
+
+void tst_QtConcurrentFilter::memberFunctions()
+{
+    QStringList strings;
+    strings << "foo" << QString() << "bar" << QString();
+
+    QStringList nulls = QtConcurrent::blockingFiltered(strings, &QString::isNull);
+    QCOMPARE(nulls.count(), 2);
+
+    QtConcurrent::blockingFilter(strings, &QString::isEmpty);
+    QCOMPARE(strings.count(), 2);
+}
+
+void tst_QtConcurrentFilter::resultOrder()
+{
+    const QList<int> list = sequence(10000);
+    QList<int> expected;
+    for (int i = 0; i < list.count(); i += 2)
+        expected.append(i);
+
+    QCOMPARE(QtConcurrent::filtered(list, keepEvenIntegers).results(), expected);
+    QCOMPARE(QtConcurrent::blockingFiltered(list, keepEvenIntegers), expected);
+
+    QList<int> copy = list;
+    QtConcurrent::blockingFilter(copy, keepEvenIntegers);
+    QCOMPARE(copy, expected);
+}
+
+void tst_QtConcurrentFilter::emptySequence()
+{
+    QList<int> empty;
+    QtConcurrent::blockingFilter(empty, keepEvenIntegers);
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(QtConcurrent::filtered(empty, keepEvenIntegers).resultCount(), 0);
+    QCOMPARE(QtConcurrent::blockingFilteredReduced(empty, keepEvenIntegers, intSumReduce), 0);
+}
+
+static bool keepNothing(const int &)
+{
+    return false;
+}
+
+void tst_QtConcurrentFilter::nothingKept()
+{
+    QList<int> list = sequence(1000);
+    QFuture<int> future = QtConcurrent::filtered(list, keepNothing);
+    future.waitForFinished();
+    QCOMPARE(future.resultCount(), 0);
+    QVERIFY(future.results().isEmpty());
+
+    QtConcurrent::blockingFilter(list, keepNothing);
+    QVERIFY(list.isEmpty());
+}
+
+static QAtomicInt slowCount;
+
+static bool slowKeep(const int &)
+{
+    QTest::qSleep(5);
+    slowCount.ref();
+    return true;
+}
+
+void tst_QtConcurrentFilter::cancel()
+{
+    QList<int> list = sequence(200);
+    slowCount = 0;
+
+    QFuture<int> future = QtConcurrent::filtered(list, slowKeep);
+    future.cancel();
+    future.waitForFinished();
+    QVERIFY(future.isCanceled());
+    QVERIFY(int(slowCount) < list.count());
+}
+
+QTEST_MAIN(tst_QtConcurrentFilter)
+#include "tst_qtconcurrentfilter.moc"
@@ -0,0 +1,377 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qtconcurrentmap.h>
+#include <qfuturewatcher.h>
+#include <qthreadpool.h>
+#include <qlist.h>
+#include <qvector.h>
+#include <qstringlist.h>
+
+//TESTED_FILES=corelib/concurrent/qtconcurrentmap.h corelib/concurrent/qtconcurrentmapkernel.h corelib/concurrent/qtconcurrentreducekernel.h
+
+using namespace QtConcurrent;
+
+class tst_QtConcurrentMap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void map();
+    void blockingMap();
+    void mapped();
+    void blockingMapped();
+    void mappedReduced();
+    void blockingMappedReduced();
+    void orderedReduce();
+    void memberFunctions();
+    void functionObjects();
+    void emptySequence();
+    void largeSequence();
+    void cancel();
+    void pauseResume();
+    void progress();
+    void throttledResults();
+};
+
+static void multiplyBy2Immutable(int x)
+{
+    x *= 2;
+}
+
+static void multiplyBy2InPlace(int &x)
+{
+    x *= 2;
+}
+
+static int multiplyBy2(int x)
+{
+    return x * 2;
+}
+
+static void intSumReduce(int &sum, int x)
+{
+    sum += x;
+}
+
+static void intListReduce(QList<int> &list, int x)
+{
+    list.append(x);
+}
+
+class MultiplyBy2
+{
+public:
+    typedef int result_type;
+
+    int operator()(int x) const { return x * 2; }
+};
+
+class MultiplyBy2InPlace
+{
+public:
+    typedef void result_type;
+
+    void operator()(int &x) const { x *= 2; }
+};
+
+class IntSumReduce
+{
+public:
+    typedef int result_type;
+
+    void operator()(int &sum, int x) const { sum += x; }
+};
+
+static QList<int> sequence(int count)
+{
+    QList<int> list;
+    for (int i = 0; i < count; ++i)
+        list.append(i);
+    return list;
+}
+
+void tst_QtConcurrentMap::map()
+{
+    // functions operating on a copy
+    {
+        QList<int> list = sequence(4);
+        QtConcurrent::map(list, multiplyBy2Immutable).waitForFinished();
+        QCOMPARE(list, sequence(4));
+    }
+
+    // in-place
+    {
+        QList<int> list;
+        list << 1 << 2 << 3;
+        QtConcurrent::map(list, multiplyBy2InPlace).waitForFinished();
+        QCOMPARE(list, QList<int>() << 2 << 4 << 6);
+        QtConcurrent::map(list.begin(), list.end(), multiplyBy2InPlace).waitForFinished();
+        QCOMPARE(list, QList<int>() << 4 << 8 << 12);
+    }
+
+    // function objects
+    {
+        QVector<int> vector;
+        vector << 1 << 2 << 3;
+        QtConcurrent::map(vector, MultiplyBy2InPlace()).waitForFinished();
+        QCOMPARE(vector, QVector<int>() << 2 << 4 << 6);
+    }
+}
+
+void tst_QtConcurrentMap::blockingMap()
+{
+    QList<int> list;
+    list << 1 << 2 << 3;
+    QtConcurrent::blockingMap(list, multiplyBy2InPlace);
+    QCOMPARE(list, QList<int>() << 2 << 4 << 6);
+    QtConcurrent::blockingMap(list.begin(), list.end(), MultiplyBy2InPlace());
+    QCOMPARE(list, QList<int>() << 4 << 8 << 12);
+}
+
+void tst_QtConcurrentMap::mapped()
+{
+    QList<int> list;
+    list << 1 << 2 << 3;
+
+    {
+        QFuture<int> future = QtConcurrent::mapped(list, multiplyBy2);
+        QCOMPARE(future.results(), QList<int>() << 2 << 4 << 6);
+        QCOMPARE(future.resultCount(), 3);
+        QCOMPARE(future.resultAt(1), 4);
+    }
+    {
+        QFuture<int> future = QtConcurrent::mapped(list.constBegin(), list.constEnd(), MultiplyBy2());
+        QCOMPARE(future.results(), QList<int>() << 2 << 4 << 6);
+    }
+
+    // the input sequence must be left untouched
+    QCOMPARE(list, QList<int>() << 1 << 2 << 3);
+
+    // iterating the future waits for each result in turn
+    {
+        QFuture<int> future = QtConcurrent::mapped(sequence(100), multiplyBy2);
+        int expected = 0;
+        QFuture<int>::const_iterator it = future.constBegin();
+        for (; it != future.constEnd(); ++it) {
+            QCOMPARE(*it, expected);
+            expected += 2;
+        }
+        QCOMPARE(expected, 200);
+    }
+}
+
+void tst_QtConcurrentMap::blockingMapped()
+{
+    QList<int> list;
+    list << 1 << 2 << 3;
+
+    QList<int> result = QtConcurrent::blockingMapped<QList<int> >(list, multiplyBy2);
+    QCOMPARE(result, QList<int>() << 2 << 4 << 6);
+
+    QVector<int> vector = QtConcurrent::blockingMapped<QVector<int> >(list.constBegin(), list.constEnd(), MultiplyBy2());
+    QCOMPARE(vector, QVector<int>() << 2 << 4 << 6);
+}
+
+void tst_QtConcurrentMap::mappedReduced()
+{
+    QList<int> list;
+    list << 1 << 2 << 3;
+
+    QCOMPARE(QtConcurrent::mappedReduced(list, multiplyBy2, intSumReduce).result(), 12);
+    QCOMPARE(QtConcurrent::mappedReduced<int>(list, MultiplyBy2(), IntSumReduce()).result(), 12);
+    QCOMPARE(QtConcurrent::mappedReduced(list.constBegin(), list.constEnd(), multiplyBy2, intSumReduce).result(), 12);
+    QCOMPARE(QtConcurrent::mappedReduced<int>(list.constBegin(), list.constEnd(), MultiplyBy2(), IntSumReduce()).result(), 12);
+}
+
+void tst_QtConcurrentMap::blockingMappedReduced()
+{
+    QList<int> list;
+    list << 1 << 2 << 3;
+
+    QCOMPARE(QtConcurrent::blockingMappedReduced(list, multiplyBy2, intSumReduce), 12);
+    QCOMPARE(QtConcurrent::blockingMappedReduced<int>(list, MultiplyBy2(), IntSumReduce()), 12);
+    QCOMPARE(QtConcurrent::blockingMappedReduced(list.constBegin(), list.constEnd(), multiplyBy2, intSumReduce), 12);
+}
+
+void tst_QtConcurrentMap::orderedReduce()
+{
+    const QList<int> list = sequence(1000);
+    QList<int> expected;
+    for (int i = 0; i < list.count(); ++i)
+        expected.append(i * 2);
+
+    QList<int> result = QtConcurrent::blockingMappedReduced(list, multiplyBy2, intListReduce,
+                                                            QtConcurrent::OrderedReduce);
+    QCOMPARE(result, expected);
+
+    // unordered reduction visits every item exactly once
+    result = QtConcurrent::blockingMappedReduced(list, multiplyBy2, intListReduce,
+                                                 QtConcurrent::UnorderedReduce);
+    qSort(result);
+    QCOMPARE(result, expected);
+}
+
+class Number
+{
+public:
+    Number() : n(0) { }
+    Number(int n) : n(n) { }
+
+    int toInt() const { return n; }
+    void multiplyBy2() { n *= 2; }
+    void add(const Number &other) { n += other.n; }
+
+    bool operator==(const Number &other) const { return n == other.n; }
+
+private:
+    int n;
+};
+
+void tst_QtConcurrentMap::memberFunctions()
+{
+    QList<Number> numbers;
+    numbers << 1 << 2 << 3;
+
+    QtConcurrent::blockingMap(numbers, &Number::multiplyBy2);
+    QCOMPARE(numbers, QList<Number>() << 2 << 4 << 6);
+
+    QList<int> ints = QtConcurrent::blockingMapped<QList<int> >(numbers, &Number::toInt);
+    QCOMPARE(ints, QList<int>() << 2 << 4 << 6);
+
+    QStringList strings;
+    strings << "a" << "bb" << "ccc";
+    QList<int> sizes = QtConcurrent::mapped(strings, &QString::size).results();
+    QCOMPARE(sizes, QList<int>() << 1 << 2 << 3);
+
+    Number sum = QtConcurrent::blockingMappedReduced<Number>(ints, multiplyBy2, &Number::add);
+    QCOMPARE(sum.toInt(), 24);
+}
+
+void tst_QtConcurrentMap::functionObjects()
+{
+    QList<int> list;
+    list << 1 << 2 << 3;
+
+    MultiplyBy2 multiply;
+    QCOMPARE(QtConcurrent::mapped(list, multiply).results(), QList<int>() << 2 << 4 << 6);
+    QCOMPARE(QtConcurrent::blockingMappedReduced<int>(list, multiply, IntSumReduce()), 12);
+}
+
+void tst_QtConcurrentMap::emptySequence()
+{
+    QList<int> empty;
+
+    QtConcurrent::map(empty, multiplyBy2InPlace).waitForFinished();
+    QtConcurrent::blockingMap(empty, multiplyBy2InPlace);
+
+    QFuture<int> future = QtConcurrent::mapped(empty, multiplyBy2);
+    future.waitForFinished();
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.resultCount(), 0);
+
+    QCOMPARE(QtConcurrent::blockingMappedReduced(empty, multiplyBy2, intSumReduce), 0);
+    QCOMPARE(QtConcurrent::blockingMapped<QList<int> >(empty, multiplyBy2), QList<int>());
+}
+
+void tst_QtConcurrentMap::largeSequence()
+{
+    const int count = 100000;
+    QVector<int> vector(count);
+    for (int i = 0; i < count; ++i)
+        vector[i] = i;
+
+    QtConcurrent::blockingMap(vector, multiplyBy2InPlace);
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(vector.at(i), i * 2);
+
+    QFuture<int> future = QtConcurrent::mapped(vector, multiplyBy2);
+    future.waitForFinished();
+    QCOMPARE(future.resultCount(), count);
+    for (int i = 0; i < count; i += 997)
+        QCOMPARE(future.resultAt(i), i * 4);
+}
+
+static QAtomicInt slowCount;
+
+static void slowMap(int &x)
+{
+    QTest::qSleep(5);
+    slowCount.ref();
+    x = 1;
+}
+
+void tst_QtConcurrentMap::cancel()
+{
+    QList<int> list = sequence(200);
+    slowCount = 0;
+
+    QFuture<void> future = QtConcurrent::map(list, slowMap);
+    future.cancel();
+    QVERIFY(future.isCanceled());
+    future.waitForFinished();
+    QVERIFY(future.isFinished());
+
+    // cancelation is asynchronous, but it must stop the iteration early
+    QVERIFY(int(slowCount) < list.count());
+}
+
+void tst_QtConcurrentMap::pauseResume()
+{
+    QList<int> list = sequence(50);
+    slowCount = 0;
+
+    QFuture<void> future = QtConcurrent::map(list, slowMap);
+    future.pause();
+    QVERIFY(future.isPaused());
+
+    // threads finish the block they are working on and then stop
+    QTest::qWait(200);
+    const int countWhilePaused = slowCount;
+    QTest::qWait(200);
+    QCOMPARE(int(slowCount), countWhilePaused);
+    QVERIFY(!future.isFinished());
+
+    future.resume();
+    future.waitForFinished();
+    QCOMPARE(int(slowCount), list.count());
+    foreach (int x, list)
+        QCOMPARE(x, 1);
+}
+
+void tst_QtConcurrentMap::progress()
+{
+    QList<int> list = sequence(1000);
+    QFuture<void> future = QtConcurrent::map(list, multiplyBy2InPlace);
+    future.waitForFinished();
+    QCOMPARE(future.progressMinimum(), 0);
+    QCOMPARE(future.progressMaximum(), list.count());
+    QCOMPARE(future.progressValue(), list.count());
+}
+
+void tst_QtConcurrentMap::throttledResults()
+{
+    // A watcher that does not return to the event loop throttles the
+    // producing threads; waiting on the future must still complete.
+    QList<int> list = sequence(10000);
+    QFutureWatcher<int> watcher;
+    QSignalSpy spy(&watcher, SIGNAL(resultsReadyAt(int, int)));
+    watcher.setPendingResultsLimit(1);
+    watcher.setFuture(QtConcurrent::mapped(list, multiplyBy2));
+    watcher.waitForFinished();
+    QCOMPARE(watcher.future().resultCount(), list.count());
+
+    QTest::qWait(100);
+    QVERIFY(spy.count() > 0);
+}
+
+QTEST_MAIN(tst_QtConcurrentMap)
+#include "tst_qtconcurrentmap.moc"
@@ -0,0 +1,5 @@
+load(qttest_p4)
+SOURCES  += tst_qtconcurrentrun.cpp
+QT = core
+
+DEFINES += QT_USE_USING_NAMESPACE
@@ -0,0 +1,221 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qtconcurrentrun.h>
+#include <qfuturewatcher.h>
+#include <qthreadpool.h>
+#include <qstringlist.h>
+
+//TESTED_FILES=corelib/concurrent/qtconcurrentrun.h corelib/concurrent/qtconcurrentrunbase.h corelib/concurrent/qtconcurrentstoredfunctioncall.h
+
+class tst_QtConcurrentRun : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void runLightFunction();
+    void runHeavyFunction();
+    void returnValue();
+    void functionObject();
+    void memberFunctions();
+    void arguments();
+    void implicitConvertibleTypes();
+    void recursive();
+    void waitStealsQueuedTask();
+};
+
+static void light()
+{
+}
+
+static QAtomicInt heavyCount;
+
+static void heavy()
+{
+    QTest::qSleep(50);
+    heavyCount.ref();
+}
+
+void tst_QtConcurrentRun::runLightFunction()
+{
+    QFuture<void> future = QtConcurrent::run(light);
+    future.waitForFinished();
+    QVERIFY(future.isFinished());
+    QVERIFY(!future.isRunning());
+}
+
+void tst_QtConcurrentRun::runHeavyFunction()
+{
+    heavyCount = 0;
+    QFuture<void> future = QtConcurrent::run(heavy);
+    QVERIFY(future.isStarted());
+    future.waitForFinished();
+    QCOMPARE(int(heavyCount), 1);
+}
+
+static int returnInt0()
+{
+    return 10;
+}
+
+static int returnInt1(int i)
+{
+    return i;
+}
+
+static double returnDouble(double d)
+{
+    return d;
+}
+
+void tst_QtConcurrentRun::returnValue()
+{
+    QCOMPARE(QtConcurrent::run(returnInt0).result(), 10);
+    QCOMPARE(QtConcurrent::run(returnInt1, 4).result(), 4);
+    QCOMPARE(QtConcurrent::run(returnDouble, 4.5).result(), 4.5);
+
+    QFuture<int> future = QtConcurrent::run(returnInt0);
+    int value = future;
+    QCOMPARE(value, 10);
+    QCOMPARE(future.resultCount(), 1);
+
+    // futures can be copied into QFuture<void> for status only
+    QFuture<void> voidFuture = future;
+    QVERIFY(voidFuture.isFinished());
+}
+
+class Concatenate
+{
+public:
+    typedef QString result_type;
+
+    QString operator()() const { return QLatin1String("foo"); }
+    QString operator()(const QString &a, const QString &b) const { return a + b; }
+};
+
+void tst_QtConcurrentRun::functionObject()
+{
+    Concatenate concatenate;
+    QCOMPARE(QtConcurrent::run(concatenate).result(), QString("foo"));
+    QCOMPARE(QtConcurrent::run(concatenate, QString("foo"), QString("bar")).result(), QString("foobar"));
+}
+
+class Counter
+{
+public:
+    Counter() : count(0) { }
+
+    int value() const { return count; }
+    int valuePlus(int i) const { return count + i; }
+    void increment() { ++count; }
+    void add(int a, int b) { count += a + b; }
+
+    int count;
+};
+
+void tst_QtConcurrentRun::memberFunctions()
+{
+    Counter counter;
+    counter.count = 5;
+
+    // const member functions on a copy
+    QCOMPARE(QtConcurrent::run(counter, &Counter::value).result(), 5);
+    QCOMPARE(QtConcurrent::run(counter, &Counter::valuePlus, 3).result(), 8);
+
+    // non-const member functions operate on a copy when passed by reference
+    QtConcurrent::run(counter, &Counter::increment).waitForFinished();
+    QCOMPARE(counter.count, 5);
+
+    // and on the instance itself when passed by pointer
+    QtConcurrent::run(&counter, &Counter::increment).waitForFinished();
+    QCOMPARE(counter.count, 6);
+    QtConcurrent::run(&counter, &Counter::add, 1, 2).waitForFinished();
+    QCOMPARE(counter.count, 9);
+
+    const Counter *constCounter = &counter;
+    QCOMPARE(QtConcurrent::run(constCounter, &Counter::valuePlus, 1).result(), 10);
+
+    QByteArray bytearray = "a,b,c";
+    QList<QByteArray> parts = QtConcurrent::run(bytearray, &QByteArray::split, ',').result();
+    QCOMPARE(parts, QList<QByteArray>() << "a" << "b" << "c");
+}
+
+static int sum5(int a, int b, int c, int d, int e)
+{
+    return a + b + c + d + e;
+}
+
+static QString stringArgument(const QString &s)
+{
+    return s;
+}
+
+void tst_QtConcurrentRun::arguments()
+{
+    QCOMPARE(QtConcurrent::run(sum5, 1, 2, 3, 4, 5).result(), 15);
+
+    // arguments are copied when run() is called
+    QString s = QLatin1String("before");
+    QFuture<QString> future = QtConcurrent::run(stringArgument, s);
+    s = QLatin1String("after");
+    QCOMPARE(future.result(), QString("before"));
+}
+
+static double doubleFromInt(int i)
+{
+    return i;
+}
+
+void tst_QtConcurrentRun::implicitConvertibleTypes()
+{
+    QCOMPARE(QtConcurrent::run(doubleFromInt, 'a').result(), double('a'));
+    QCOMPARE(QtConcurrent::run(stringArgument, QLatin1String("latin1")).result(), QString("latin1"));
+}
+
+static int fibonacci(int n)
+{
+    if (n < 2)
+        return n;
+    QFuture<int> a = QtConcurrent::run(fibonacci, n - 1);
+    QFuture<int> b = QtConcurrent::run(fibonacci, n - 2);
+    return a.result() + b.result();
+}
+
+void tst_QtConcurrentRun::recursive()
+{
+    // Each task waits for tasks queued behind it; this only completes
+    // when waiting threads run the queued tasks themselves.
+    QCOMPARE(fibonacci(12), 144);
+}
+
+void tst_QtConcurrentRun::waitStealsQueuedTask()
+{
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int oldMax = pool->maxThreadCount();
+    pool->setMaxThreadCount(1);
+
+    heavyCount = 0;
+    QFuture<void> blocker = QtConcurrent::run(heavy);
+    QFuture<int> queued = QtConcurrent::run(returnInt0);
+
+    // the only pool thread is busy, so result() runs the task in this thread
+    QTime time;
+    time.start();
+    QCOMPARE(queued.result(), 10);
+    QVERIFY(!blocker.isFinished() || time.elapsed() < 50);
+
+    blocker.waitForFinished();
+    QCOMPARE(int(heavyCount), 1);
+    pool->setMaxThreadCount(oldMax);
+}
+
+QTEST_MAIN(tst_QtConcurrentRun)
+#include "tst_qtconcurrentrun.moc"
@@ -0,0 +1,6 @@
+load(qttest_p4)
+SOURCES  += tst_qthreadpool.cpp
+QT = core
+
+DEFINES += QT_USE_USING_NAMESPACE
+
@@ -0,0 +1,506 @@
+/****************************************************************************
+**
+** Copyright (C) 1992-$THISYEAR$ Trolltech AS. All rights reserved.
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qcoreapplication.h>
+#include <qthreadpool.h>
+#include <qstring.h>
+#include <qmutex.h>
+#include <qset.h>
+
+//TESTED_CLASS=QThreadPool
+//TESTED_FILES=corelib/thread/qthreadpool.h corelib/thread/qthreadpool.cpp corelib/thread/qrunnable.h
+
+class tst_QThreadPool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void runTask();
+    void singleton();
+    void destruction();
+    void runMultiple();
+    void autoDelete();
+    void priorityStart();
+    void expiryTimeout();
+    void maxThreadCount();
+    void tryStart();
+    void reserveThread();
+    void releaseThread();
+    void nestedStart();
+    void workStealing();
+    void releaseThreadLocalQueue();
+    void waitForDone();
+};
+
+static int testFunctionCount;
+
+class FunctionTask : public QRunnable
+{
+public:
+    FunctionTask(void (*function)()) : function(function) { }
+    void run() { function(); }
+
+private:
+    void (*function)();
+};
+
+static void sleepTestFunction()
+{
+    QTest::qSleep(1000);
+    ++testFunctionCount;
+}
+
+static void emptyFunct()
+{ }
+
+static QMutex funcTestMutex;
+static void noSleepTestFunctionMutex()
+{
+    QMutexLocker locker(&funcTestMutex);
+    ++testFunctionCount;
+}
+
+static void sleepTestFunctionMutex()
+{
+    QTest::qSleep(1000);
+    QMutexLocker locker(&funcTestMutex);
+    ++testFunctionCount;
+}
+
+void tst_QThreadPool::runTask()
+{
+    QThreadPool manager;
+    testFunctionCount = 0;
+    manager.start(new FunctionTask(sleepTestFunction));
+    manager.waitForDone();
+    QCOMPARE(testFunctionCount, 1);
+}
+
+void tst_QThreadPool::singleton()
+{
+    QVERIFY(QThreadPool::globalInstance() != 0);
+    QCOMPARE(QThreadPool::globalInstance(), QThreadPool::globalInstance());
+    QCOMPARE(QThreadPool::globalInstance()->maxThreadCount(),
+             qAbs(QThread::idealThreadCount()));
+
+    testFunctionCount = 0;
+    QThreadPool::globalInstance()->start(new FunctionTask(sleepTestFunction));
+    QThreadPool::globalInstance()->waitForDone();
+    QCOMPARE(testFunctionCount, 1);
+}
+
+void tst_QThreadPool::destruction()
+{
+    testFunctionCount = 0;
+    QThreadPool *threadManager = new QThreadPool();
+    threadManager->start(new FunctionTask(sleepTestFunction));
+    threadManager->start(new FunctionTask(sleepTestFunction));
+    delete threadManager;
+    QCOMPARE(testFunctionCount, 2);
+}
+
+void tst_QThreadPool::runMultiple()
+{
+    const int runs = 10;
+
+    {
+        QThreadPool manager;
+        testFunctionCount = 0;
+        for (int i = 0; i < runs; ++i)
+            manager.start(new FunctionTask(sleepTestFunctionMutex));
+    }
+    QCOMPARE(testFunctionCount, runs);
+
+    {
+        QThreadPool manager;
+        testFunctionCount = 0;
+        for (int i = 0; i < runs; ++i)
+            manager.start(new FunctionTask(noSleepTestFunctionMutex));
+    }
+    QCOMPARE(testFunctionCount, runs);
+
+    {
+        QThreadPool manager;
+        for (int i = 0; i < 500; ++i)
+            manager.start(new FunctionTask(emptyFunct));
+    }
+}
+
+static QAtomicInt deleteCount;
+
+class AutoDeleteTask : public QRunnable
+{
+public:
+    ~AutoDeleteTask() { deleteCount.ref(); }
+    void run() { }
+};
+
+void tst_QThreadPool::autoDelete()
+{
+    deleteCount = 0;
+    {
+        QThreadPool threadManager;
+        for (int i = 0; i < 20; ++i)
+            threadManager.start(new AutoDeleteTask());
+    }
+    QCOMPARE(int(deleteCount), 20);
+
+    AutoDeleteTask noDelete;
+    noDelete.setAutoDelete(false);
+    QVERIFY(!noDelete.autoDelete());
+    deleteCount = 0;
+    {
+        QThreadPool threadManager;
+        for (int i = 0; i < 20; ++i)
+            threadManager.start(&noDelete);
+    }
+    QCOMPARE(int(deleteCount), 0);
+}
+
+class RecordingTask : public QRunnable
+{
+public:
+    RecordingTask(QList<int> *order, QMutex *mutex, int value)
+        : order(order), mutex(mutex), value(value) { }
+    void run()
+    {
+        QMutexLocker locker(mutex);
+        order->append(value);
+    }
+
+    QList<int> *order;
+    QMutex *mutex;
+    int value;
+};
+
+class BlockingTask : public QRunnable
+{
+public:
+    BlockingTask(QSemaphore *started, QSemaphore *proceed)
+        : started(started), proceed(proceed) { }
+    void run()
+    {
+        started->release();
+        proceed->acquire();
+    }
+
+    QSemaphore *started;
+    QSemaphore *proceed;
+};
+
+void tst_QThreadPool::priorityStart()
+{
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+
+    // occupy the only thread so that everything else is queued
+    QSemaphore started, proceed;
+    threadPool.start(new BlockingTask(&started, &proceed));
+    started.acquire();
+
+    QMutex mutex;
+    QList<int> order;
+    threadPool.start(new RecordingTask(&order, &mutex, 0), 0);
+    threadPool.start(new RecordingTask(&order, &mutex, 1), 0);
+    threadPool.start(new RecordingTask(&order, &mutex, 2), 10);
+    threadPool.start(new RecordingTask(&order, &mutex, 3), 5);
+    proceed.release();
+    threadPool.waitForDone();
+
+    QCOMPARE(order, QList<int>() << 2 << 3 << 0 << 1);
+}
+
+class ExpiryTimeoutTask : public QRunnable
+{
+public:
+    QThread *thread;
+    QAtomicInt runCount;
+    QSemaphore semaphore;
+
+    ExpiryTimeoutTask()
+        : thread(0), runCount(0)
+    {
+        setAutoDelete(false);
+    }
+
+    void run()
+    {
+        thread = QThread::currentThread();
+        runCount.ref();
+        semaphore.release();
+    }
+};
+
+void tst_QThreadPool::expiryTimeout()
+{
+    ExpiryTimeoutTask task;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+
+    int expiryTimeout = threadPool.expiryTimeout();
+    threadPool.setExpiryTimeout(1000);
+    QCOMPARE(threadPool.expiryTimeout(), 1000);
+
+    // run the task
+    threadPool.start(&task);
+    QVERIFY(task.semaphore.tryAcquire(1, 10000));
+    QCOMPARE(int(task.runCount), 1);
+    QVERIFY(!task.thread->wait(100));
+    // thread should expire
+    QThread *firstThread = task.thread;
+    QVERIFY(task.thread->wait(10000));
+
+    // run task again, thread should be restarted
+    threadPool.start(&task);
+    QVERIFY(task.semaphore.tryAcquire(1, 10000));
+    QCOMPARE(int(task.runCount), 2);
+    QVERIFY(!task.thread->wait(100));
+    // thread should expire again
+    QVERIFY(task.thread->wait(10000));
+
+    // thread pool should have reused the expired thread (instead of
+    // starting a new one)
+    QCOMPARE(firstThread, task.thread);
+
+    threadPool.setExpiryTimeout(expiryTimeout);
+    QCOMPARE(threadPool.expiryTimeout(), expiryTimeout);
+}
+
+class CountingTask : public QRunnable
+{
+public:
+    static QAtomicInt active;
+    static QAtomicInt peak;
+
+    void run()
+    {
+        const int now = active.fetchAndAddOrdered(1) + 1;
+        for (;;) {
+            const int p = peak;
+            if (now <= p || peak.testAndSetOrdered(p, now))
+                break;
+        }
+        QTest::qSleep(50);
+        active.deref();
+    }
+};
+
+QAtomicInt CountingTask::active;
+QAtomicInt CountingTask::peak;
+
+void tst_QThreadPool::maxThreadCount()
+{
+    for (int limit = 1; limit <= 4; ++limit) {
+        CountingTask::active = 0;
+        CountingTask::peak = 0;
+
+        QThreadPool threadPool;
+        threadPool.setMaxThreadCount(limit);
+        QCOMPARE(threadPool.maxThreadCount(), limit);
+        for (int i = 0; i < limit * 4; ++i)
+            threadPool.start(new CountingTask());
+        threadPool.waitForDone();
+
+        QVERIFY(int(CountingTask::peak) <= limit);
+        QCOMPARE(threadPool.activeThreadCount(), 0);
+    }
+}
+
+void tst_QThreadPool::tryStart()
+{
+    QSemaphore started, proceed;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(2);
+    for (int i = 0; i < threadPool.maxThreadCount(); ++i)
+        QVERIFY(threadPool.tryStart(new BlockingTask(&started, &proceed)));
+    started.acquire(threadPool.maxThreadCount());
+    QCOMPARE(threadPool.activeThreadCount(), 2);
+
+    AutoDeleteTask task;
+    task.setAutoDelete(false);
+    QVERIFY(!threadPool.tryStart(&task));
+
+    proceed.release(threadPool.maxThreadCount());
+    threadPool.waitForDone();
+    QVERIFY(threadPool.tryStart(&task));
+    threadPool.waitForDone();
+}
+
+void tst_QThreadPool::reserveThread()
+{
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+
+    threadPool.reserveThread();
+    QCOMPARE(threadPool.activeThreadCount(), 1);
+
+    // the reserved thread does not count against starting the first thread
+    QSemaphore started, proceed;
+    threadPool.start(new BlockingTask(&started, &proceed));
+    QVERIFY(started.tryAcquire(1, 10000));
+    QCOMPARE(threadPool.activeThreadCount(), 2);
+
+    AutoDeleteTask task;
+    task.setAutoDelete(false);
+    QVERIFY(!threadPool.tryStart(&task));
+
+    proceed.release();
+    threadPool.releaseThread();
+    threadPool.waitForDone();
+    QCOMPARE(threadPool.activeThreadCount(), 0);
+}
+
+void tst_QThreadPool::releaseThread()
+{
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+
+    QSemaphore started, proceed;
+    threadPool.start(new BlockingTask(&started, &proceed));
+    QVERIFY(started.tryAcquire(1, 10000));
+
+    // releasing without reserving lets one more thread run
+    threadPool.releaseThread();
+    threadPool.start(new BlockingTask(&started, &proceed));
+    QVERIFY(started.tryAcquire(1, 10000));
+    QCOMPARE(threadPool.activeThreadCount(), 1);
+
+    proceed.release(2);
+    threadPool.reserveThread();
+    threadPool.waitForDone();
+}
+
+class FanOutTask : public QRunnable
+{
+public:
+    FanOutTask(QThreadPool *pool, int depth, QAtomicInt *count, QSet<QThread *> *threads, QMutex *mutex)
+        : pool(pool), depth(depth), count(count), threads(threads), mutex(mutex) { }
+
+    void run()
+    {
+        {
+            QMutexLocker locker(mutex);
+            threads->insert(QThread::currentThread());
+        }
+        count->ref();
+        if (depth > 0) {
+            pool->start(new FanOutTask(pool, depth - 1, count, threads, mutex));
+            pool->start(new FanOutTask(pool, depth - 1, count, threads, mutex));
+        }
+        QTest::qSleep(1);
+    }
+
+    QThreadPool *pool;
+    int depth;
+    QAtomicInt *count;
+    QSet<QThread *> *threads;
+    QMutex *mutex;
+};
+
+void tst_QThreadPool::nestedStart()
+{
+    // runnables started from pool threads go to the local run queue
+    QAtomicInt count;
+    QSet<QThread *> threads;
+    QMutex mutex;
+    {
+        QThreadPool threadPool;
+        threadPool.setMaxThreadCount(1);
+        threadPool.start(new FanOutTask(&threadPool, 6, &count, &threads, &mutex));
+        threadPool.waitForDone();
+        QCOMPARE(int(count), (1 << 7) - 1);
+        QCOMPARE(threads.count(), 1);
+    }
+}
+
+void tst_QThreadPool::workStealing()
+{
+    // a single root task fans out; idle threads have to steal to help
+    QAtomicInt count;
+    QSet<QThread *> threads;
+    QMutex mutex;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(4);
+    threadPool.start(new FanOutTask(&threadPool, 8, &count, &threads, &mutex));
+    threadPool.waitForDone();
+    QCOMPARE(int(count), (1 << 9) - 1);
+    QVERIFY(threads.count() > 1);
+    QVERIFY(threads.count() <= 4);
+}
+
+class SignalTask : public QRunnable
+{
+public:
+    SignalTask(QSemaphore *done) : done(done) { }
+    void run() { done->release(); }
+    QSemaphore *done;
+};
+
+class WaitForChildTask : public QRunnable
+{
+public:
+    WaitForChildTask(QThreadPool *pool, QSemaphore *done)
+        : pool(pool), done(done), childDone(false) { }
+
+    void run()
+    {
+        // the child goes to this thread's run queue, which nobody drains
+        // while we wait unless releaseThread() lets another thread steal it
+        QSemaphore child;
+        pool->start(new SignalTask(&child));
+        pool->releaseThread();
+        childDone = child.tryAcquire(1, 5000);
+        pool->reserveThread();
+        done->release();
+    }
+
+    QThreadPool *pool;
+    QSemaphore *done;
+    bool childDone;
+};
+
+void tst_QThreadPool::releaseThreadLocalQueue()
+{
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    QSemaphore done;
+    WaitForChildTask *task = new WaitForChildTask(&threadPool, &done);
+    task->setAutoDelete(false);
+    threadPool.start(task);
+    QVERIFY(done.tryAcquire(1, 10000));
+    QVERIFY(task->childDone);
+    threadPool.waitForDone();
+    delete task;
+}
+
+void tst_QThreadPool::waitForDone()
+{
+    QTime total, pass;
+    total.start();
+
+    QThreadPool threadPool;
+    while (total.elapsed() < 2000) {
+        int runs;
+        runs = 0;
+        pass.restart();
+        while (pass.elapsed() < 100) {
+            threadPool.start(new FunctionTask(emptyFunct));
+            ++runs;
+        }
+        threadPool.waitForDone();
+        QCOMPARE(threadPool.activeThreadCount(), 0);
+    }
+}
+
+QTEST_MAIN(tst_QThreadPool)
+#include "tst_qthreadpool.moc"
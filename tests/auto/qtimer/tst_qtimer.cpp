@@ -48,6 +48,8 @@ private slots:
     void recurringTimer_data();
     void recurringTimer();
     void deleteLaterOnQTimer(); // long name, don't want to shadow QObject::deleteLater()
+    void manyTimers();
+    void killTimersWhileActive();
 };
 
 class TimerHelper : public QObject
@@ -335,5 +337,75 @@ void tst_QTimer::deleteLaterOnQTimer()
     QVERIFY(pointer.isNull());
 }
 
+class ManyTimersObject : public QObject
+{
+public:
+    QHash<int, int> intervals;
+    QHash<int, int> fired;
+    QTime time;
+
+    void timerEvent(QTimerEvent *e)
+    {
+        if (!fired.contains(e->timerId()))
+            fired.insert(e->timerId(), time.elapsed());
+        killTimer(e->timerId());
+    }
+};
+
+void tst_QTimer::manyTimers()
+{
+    ManyTimersObject object;
+    object.time.start();
+    QList<int> killed;
+    for (int i = 0; i < 2000; ++i) {
+        const int interval = 20 + (i * 7) % 300;
+        const int id = object.startTimer(interval);
+        QVERIFY(id > 0);
+        object.intervals.insert(id, interval);
+        if (i % 4 == 0)
+            killed << id;
+    }
+    for (int i = 0; i < killed.count(); ++i)
+        object.killTimer(killed.at(i));
+
+    QTest::qWait(1000);
+
+    QCOMPARE(object.fired.count(), object.intervals.count() - killed.count());
+    for (int i = 0; i < killed.count(); ++i)
+        QVERIFY(!object.fired.contains(killed.at(i)));
+    // a timer never fires before its interval has elapsed
+    QHash<int, int>::const_iterator it = object.fired.constBegin();
+    for (; it != object.fired.constEnd(); ++it)
+        QVERIFY(it.value() >= object.intervals.value(it.key()));
+}
+
+class KillingObject : public QObject
+{
+public:
+    KillingObject() : count(0) { }
+
+    QList<int> timers;
+    int count;
+
+    void timerEvent(QTimerEvent *)
+    {
+        // the first timer to fire kills all the others, including ones
+        // that are due in the same activation
+        ++count;
+        for (int i = 0; i < timers.count(); ++i)
+            killTimer(timers.at(i));
+        timers.clear();
+    }
+};
+
+void tst_QTimer::killTimersWhileActive()
+{
+    KillingObject object;
+    for (int i = 0; i < 100; ++i)
+        object.timers << object.startTimer(0);
+    QTest::qWait(100);
+    QCOMPARE(object.count, 1);
+}
+
 QTEST_MAIN(tst_QTimer)
 #include "tst_qtimer.moc"
@@ -0,0 +1,436 @@
+<!DOCTYPE TS><TS version="1.1" language="de">
+<context>
+    <name>Generated</name>
+    <message>
+        <source>Message 0</source>
+        <translation>Nachricht 0</translation>
+    </message>
+    <message>
+        <source>Message 1</source>
+        <translation>Nachricht 1</translation>
+    </message>
+    <message>
+        <source>Message 2</source>
+        <translation>Nachricht 2</translation>
+    </message>
+    <message>
+        <source>Message 3</source>
+        <translation>Nachricht 3</translation>
+    </message>
+    <message>
+        <source>Message 4</source>
+        <translation>Nachricht 4</translation>
+    </message>
+    <message>
+        <source>Message 5</source>
+        <translation>Nachricht 5</translation>
+    </message>
+    <message>
+        <source>Message 6</source>
+        <translation>Nachricht 6</translation>
+    </message>
+    <message>
+        <source>Message 7</source>
+        <translation>Nachricht 7</translation>
+    </message>
+    <message>
+        <source>Message 8</source>
+        <translation>Nachricht 8</translation>
+    </message>
+    <message>
+        <source>Message 9</source>
+        <translation>Nachricht 9</translation>
+    </message>
+    <message>
+        <source>Message 10</source>
+        <translation>Nachricht 10</translation>
+    </message>
+    <message>
+        <source>Message 11</source>
+        <translation>Nachricht 11</translation>
+    </message>
+    <message>
+        <source>Message 12</source>
+        <translation>Nachricht 12</translation>
+    </message>
+    <message>
+        <source>Message 13</source>
+        <translation>Nachricht 13</translation>
+    </message>
+    <message>
+        <source>Message 14</source>
+        <translation>Nachricht 14</translation>
+    </message>
+    <message>
+        <source>Message 15</source>
+        <translation>Nachricht 15</translation>
+    </message>
+    <message>
+        <source>Message 16</source>
+        <translation>Nachricht 16</translation>
+    </message>
+    <message>
+        <source>Message 17</source>
+        <translation>Nachricht 17</translation>
+    </message>
+    <message>
+        <source>Message 18</source>
+        <translation>Nachricht 18</translation>
+    </message>
+    <message>
+        <source>Message 19</source>
+        <translation>Nachricht 19</translation>
+    </message>
+    <message>
+        <source>Message 20</source>
+        <translation>Nachricht 20</translation>
+    </message>
+    <message>
+        <source>Message 21</source>
+        <translation>Nachricht 21</translation>
+    </message>
+    <message>
+        <source>Message 22</source>
+        <translation>Nachricht 22</translation>
+    </message>
+    <message>
+        <source>Message 23</source>
+        <translation>Nachricht 23</translation>
+    </message>
+    <message>
+        <source>Message 24</source>
+        <translation>Nachricht 24</translation>
+    </message>
+    <message>
+        <source>Message 25</source>
+        <translation>Nachricht 25</translation>
+    </message>
+    <message>
+        <source>Message 26</source>
+        <translation>Nachricht 26</translation>
+    </message>
+    <message>
+        <source>Message 27</source>
+        <translation>Nachricht 27</translation>
+    </message>
+    <message>
+        <source>Message 28</source>
+        <translation>Nachricht 28</translation>
+    </message>
+    <message>
+        <source>Message 29</source>
+        <translation>Nachricht 29</translation>
+    </message>
+    <message>
+        <source>Message 30</source>
+        <translation>Nachricht 30</translation>
+    </message>
+    <message>
+        <source>Message 31</source>
+        <translation>Nachricht 31</translation>
+    </message>
+    <message>
+        <source>Message 32</source>
+        <translation>Nachricht 32</translation>
+    </message>
+    <message>
+        <source>Message 33</source>
+        <translation>Nachricht 33</translation>
+    </message>
+    <message>
+        <source>Message 34</source>
+        <translation>Nachricht 34</translation>
+    </message>
+    <message>
+        <source>Message 35</source>
+        <translation>Nachricht 35</translation>
+    </message>
+    <message>
+        <source>Message 36</source>
+        <translation>Nachricht 36</translation>
+    </message>
+    <message>
+        <source>Message 37</source>
+        <translation>Nachricht 37</translation>
+    </message>
+    <message>
+        <source>Message 38</source>
+        <translation>Nachricht 38</translation>
+    </message>
+    <message>
+        <source>Message 39</source>
+        <translation>Nachricht 39</translation>
+    </message>
+    <message>
+        <source>Message 40</source>
+        <translation>Nachricht 40</translation>
+    </message>
+    <message>
+        <source>Message 41</source>
+        <translation>Nachricht 41</translation>
+    </message>
+    <message>
+        <source>Message 42</source>
+        <translation>Nachricht 42</translation>
+    </message>
+    <message>
+        <source>Message 43</source>
+        <translation>Nachricht 43</translation>
+    </message>
+    <message>
+        <source>Message 44</source>
+        <translation>Nachricht 44</translation>
+    </message>
+    <message>
+        <source>Message 45</source>
+        <translation>Nachricht 45</translation>
+    </message>
+    <message>
+        <source>Message 46</source>
+        <translation>Nachricht 46</translation>
+    </message>
+    <message>
+        <source>Message 47</source>
+        <translation>Nachricht 47</translation>
+    </message>
+    <message>
+        <source>Message 48</source>
+        <translation>Nachricht 48</translation>
+    </message>
+    <message>
+        <source>Message 49</source>
+        <translation>Nachricht 49</translation>
+    </message>
+    <message>
+        <source>Message 50</source>
+        <translation>Nachricht 50</translation>
+    </message>
+    <message>
+        <source>Message 51</source>
+        <translation>Nachricht 51</translation>
+    </message>
+    <message>
+        <source>Message 52</source>
+        <translation>Nachricht 52</translation>
+    </message>
+    <message>
+        <source>Message 53</source>
+        <translation>Nachricht 53</translation>
+    </message>
+    <message>
+        <source>Message 54</source>
+        <translation>Nachricht 54</translation>
+    </message>
+    <message>
+        <source>Message 55</source>
+        <translation>Nachricht 55</translation>
+    </message>
+    <message>
+        <source>Message 56</source>
+        <translation>Nachricht 56</translation>
+    </message>
+    <message>
+        <source>Message 57</source>
+        <translation>Nachricht 57</translation>
+    </message>
+    <message>
+        <source>Message 58</source>
+        <translation>Nachricht 58</translation>
+    </message>
+    <message>
+        <source>Message 59</source>
+        <translation>Nachricht 59</translation>
+    </message>
+    <message>
+        <source>Message 60</source>
+        <translation>Nachricht 60</translation>
+    </message>
+    <message>
+        <source>Message 61</source>
+        <translation>Nachricht 61</translation>
+    </message>
+    <message>
+        <source>Message 62</source>
+        <translation>Nachricht 62</translation>
+    </message>
+    <message>
+        <source>Message 63</source>
+        <translation>Nachricht 63</translation>
+    </message>
+    <message>
+        <source>Message 64</source>
+        <translation>Nachricht 64</translation>
+    </message>
+    <message>
+        <source>Message 65</source>
+        <translation>Nachricht 65</translation>
+    </message>
+    <message>
+        <source>Message 66</source>
+        <translation>Nachricht 66</translation>
+    </message>
+    <message>
+        <source>Message 67</source>
+        <translation>Nachricht 67</translation>
+    </message>
+    <message>
+        <source>Message 68</source>
+        <translation>Nachricht 68</translation>
+    </message>
+    <message>
+        <source>Message 69</source>
+        <translation>Nachricht 69</translation>
+    </message>
+    <message>
+        <source>Message 70</source>
+        <translation>Nachricht 70</translation>
+    </message>
+    <message>
+        <source>Message 71</source>
+        <translation>Nachricht 71</translation>
+    </message>
+    <message>
+        <source>Message 72</source>
+        <translation>Nachricht 72</translation>
+    </message>
+    <message>
+        <source>Message 73</source>
+        <translation>Nachricht 73</translation>
+    </message>
+    <message>
+        <source>Message 74</source>
+        <translation>Nachricht 74</translation>
+    </message>
+    <message>
+        <source>Message 75</source>
+        <translation>Nachricht 75</translation>
+    </message>
+    <message>
+        <source>Message 76</source>
+        <translation>Nachricht 76</translation>
+    </message>
+    <message>
+        <source>Message 77</source>
+        <translation>Nachricht 77</translation>
+    </message>
+    <message>
+        <source>Message 78</source>
+        <translation>Nachricht 78</translation>
+    </message>
+    <message>
+        <source>Message 79</source>
+        <translation>Nachricht 79</translation>
+    </message>
+    <message>
+        <source>Message 80</source>
+        <translation>Nachricht 80</translation>
+    </message>
+    <message>
+        <source>Message 81</source>
+        <translation>Nachricht 81</translation>
+    </message>
+    <message>
+        <source>Message 82</source>
+        <translation>Nachricht 82</translation>
+    </message>
+    <message>
+        <source>Message 83</source>
+        <translation>Nachricht 83</translation>
+    </message>
+    <message>
+        <source>Message 84</source>
+        <translation>Nachricht 84</translation>
+    </message>
+    <message>
+        <source>Message 85</source>
+        <translation>Nachricht 85</translation>
+    </message>
+    <message>
+        <source>Message 86</source>
+        <translation>Nachricht 86</translation>
+    </message>
+    <message>
+        <source>Message 87</source>
+        <translation>Nachricht 87</translation>
+    </message>
+    <message>
+        <source>Message 88</source>
+        <translation>Nachricht 88</translation>
+    </message>
+    <message>
+        <source>Message 89</source>
+        <translation>Nachricht 89</translation>
+    </message>
+    <message>
+        <source>Message 90</source>
+        <translation>Nachricht 90</translation>
+    </message>
+    <message>
+        <source>Message 91</source>
+        <translation>Nachricht 91</translation>
+    </message>
+    <message>
+        <source>Message 92</source>
+        <translation>Nachricht 92</translation>
+    </message>
+    <message>
+        <source>Message 93</source>
+        <translation>Nachricht 93</translation>
+    </message>
+    <message>
+        <source>Message 94</source>
+        <translation>Nachricht 94</translation>
+    </message>
+    <message>
+        <source>Message 95</source>
+        <translation>Nachricht 95</translation>
+    </message>
+    <message>
+        <source>Message 96</source>
+        <translation>Nachricht 96</translation>
+    </message>
+    <message>
+        <source>Message 97</source>
+        <translation>Nachricht 97</translation>
+    </message>
+    <message>
+        <source>Message 98</source>
+        <translation>Nachricht 98</translation>
+    </message>
+    <message>
+        <source>Message 99</source>
+        <translation>Nachricht 99</translation>
+    </message>
+</context>
+<context>
+    <name>QLabel</name>
+    <message numerus="yes">
+        <source>%n file(s)</source>
+        <translation>
+            <numerusform>%n Datei</numerusform>
+            <numerusform>%n Dateien</numerusform>
+        </translation>
+    </message>
+    <message>
+        <source>Open</source>
+        <translation>Offen</translation>
+    </message>
+</context>
+<context>
+    <name>QPushButton</name>
+    <message>
+        <source>Hello world!</source>
+        <translation>Hallo Welt!</translation>
+    </message>
+    <message>
+        <source>Open</source>
+        <comment>adjective</comment>
+        <translation>Offen</translation>
+    </message>
+    <message>
+        <source>Open</source>
+        <comment>verb</comment>
+        <translation>&#xd6;ffnen</translation>
+    </message>
+</context>
+</TS>
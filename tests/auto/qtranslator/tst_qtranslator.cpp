@@ -36,6 +36,8 @@ private slots:
     void threadLoad();
     void testLanguageChange();
     void plural();
+    void perfectHash();
+    void translationCache();
 
 private:
     int languageChangeEventCounter;
@@ -185,5 +187,92 @@ void tst_QTranslator::plural()
     QCOMPARE(QCoreApplication::translate("QPushButton", "Hello %n world(s)!", 0, e, 2), QString::fromLatin1("Hallo 2 Welten!"));
 }
 
+static QByteArray readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+void tst_QTranslator::perfectHash()
+{
+    QByteArray data = readFile("hashed_la.qm");
+    QVERIFY(!data.isEmpty());
+
+    // the same file without its perfect hash table, which makes
+    // QTranslator fall back to searching the hashes
+    QByteArray plain = data;
+    int pos = 16;
+    while (pos + 5 <= plain.size() && uchar(plain.at(pos)) != 0x96) {
+        const uchar *p = reinterpret_cast<const uchar *>(plain.constData()) + pos + 1;
+        pos += 5 + ((p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]);
+    }
+    QVERIFY(pos < plain.size());
+    plain[pos] = char(0x97);
+
+    QTranslator hashed;
+    QVERIFY(hashed.load("hashed_la"));
+    QTranslator searched;
+    QVERIFY(searched.load(reinterpret_cast<const uchar *>(plain.constData()), plain.size()));
+
+    QTranslator *translators[2] = { &hashed, &searched };
+    for (int t = 0; t < 2; ++t) {
+        QTranslator &tor = *translators[t];
+        QVERIFY(!tor.isEmpty());
+        QCOMPARE(tor.translate("QPushButton", "Hello world!"), QString::fromLatin1("Hallo Welt!"));
+        QCOMPARE(tor.translate("QPushButton", "Open", "verb"), QString::fromLatin1("\xd6" "ffnen"));
+        QCOMPARE(tor.translate("QPushButton", "Open", "adjective"), QString::fromLatin1("Offen"));
+        QCOMPARE(tor.translate("QLabel", "Open"), QString::fromLatin1("Offen"));
+        // falls back to the message without comment
+        QCOMPARE(tor.translate("QLabel", "Open", "noun"), QString::fromLatin1("Offen"));
+        QCOMPARE(tor.translate("QLabel", "%n file(s)", 0, 1), QString::fromLatin1("%n Datei"));
+        QCOMPARE(tor.translate("QLabel", "%n file(s)", 0, 2), QString::fromLatin1("%n Dateien"));
+        for (int i = 0; i < 100; ++i) {
+            QByteArray source = "Message " + QByteArray::number(i);
+            QCOMPARE(tor.translate("Generated", source), QString::fromLatin1("Nachricht %1").arg(i));
+        }
+
+        QVERIFY(tor.translate("QPushButton", "Close").isNull());
+        QVERIFY(tor.translate("QPushButton", "Hello World!").isNull());
+        QVERIFY(tor.translate("Generated", "Message 100").isNull());
+        QVERIFY(tor.translate("QCheckBox", "Hello world!").isNull());
+    }
+}
+
+void tst_QTranslator::translationCache()
+{
+    QTranslator tor;
+    QVERIFY(tor.load("hashed_la"));
+
+    // translations are cached by the addresses of the strings, which
+    // must not be mistaken for the strings themselves
+    char context[32];
+    char source[32];
+    for (int i = 0; i < 3; ++i) {
+        qstrcpy(context, "QPushButton");
+        qstrcpy(source, "Hello world!");
+        QCOMPARE(tor.translate(context, source), QString::fromLatin1("Hallo Welt!"));
+        qstrcpy(source, "Close");
+        QVERIFY(tor.translate(context, source).isNull());
+        qstrcpy(source, "Open");
+        QCOMPARE(tor.translate(context, source, "verb"), QString::fromLatin1("\xd6" "ffnen"));
+        qstrcpy(context, "QLabel");
+        QCOMPARE(tor.translate(context, source), QString::fromLatin1("Offen"));
+        qstrcpy(source, "%n file(s)");
+        QCOMPARE(tor.translate(context, source, 0, 1), QString::fromLatin1("%n Datei"));
+        QCOMPARE(tor.translate(context, source, 0, 5), QString::fromLatin1("%n Dateien"));
+    }
+
+    // loading another file drops the cached translations
+    QVERIFY(tor.load("hellotr_la"));
+    qstrcpy(context, "QPushButton");
+    qstrcpy(source, "Hello world!");
+    QCOMPARE(tor.translate(context, source), QString::fromLatin1("Hallo Welt!"));
+    qstrcpy(context, "QLabel");
+    qstrcpy(source, "Open");
+    QVERIFY(tor.translate(context, source).isNull());
+}
+
 QTEST_MAIN(tst_QTranslator)
 #include "tst_qtranslator.moc"
@@ -22,6 +22,7 @@
 #include <QDataStream>
 #include <QFile>
 #include <QMap>
+#include <QVector>
 #include <QtAlgorithms>
 
 #include <stdlib.h>
@@ -61,6 +62,89 @@ static uint elfHash(const char * name)
     return h;
 }
 
+/*
+    Maps the hash \a h to a slot of a table with \a size entries. This
+    must match the function that QTranslator uses to look up the
+    perfect hash table.
+*/
+static inline uint perfectHashSlot(uint h, uint seed, uint size)
+{
+    h ^= seed;
+    h *= 0x45d9f3b;
+    h ^= h >> 16;
+    h *= 0x45d9f3b;
+    h ^= h >> 16;
+    return h % size;
+}
+
+/*
+    Builds a perfect hash table for the distinct \a hashes, which map to
+    the index of their first entry in the offset array. The keys are
+    distributed over buckets first; each bucket then gets a seed that
+    places all of its keys in free slots. Buckets are processed from
+    the largest to the smallest, as the small ones are easier to place
+    once the table fills up. Returns an empty array if no seeds are
+    found.
+*/
+static QByteArray buildPerfectHash(const QMap<uint, int> &hashes)
+{
+    const uint keyCount = hashes.size();
+    if (!keyCount)
+        return QByteArray();
+    const uint bucketCount = keyCount / 4 + 1;
+
+    QVector<QList<uint> > buckets(bucketCount);
+    QMap<uint, int>::const_iterator it;
+    for (it = hashes.constBegin(); it != hashes.constEnd(); ++it)
+        buckets[perfectHashSlot(it.key(), 0, bucketCount)].append(it.key());
+
+    QMap<int, QList<uint> > bySize;
+    for (uint b = 0; b < bucketCount; ++b) {
+        if (!buckets.at(b).isEmpty())
+            bySize[-buckets.at(b).size()].append(b);
+    }
+
+    QVector<quint32> seeds(bucketCount, 0);
+    QVector<quint32> indices(keyCount, 0);
+    QVector<bool> used(keyCount, false);
+    QMap<int, QList<uint> >::const_iterator size;
+    for (size = bySize.constBegin(); size != bySize.constEnd(); ++size) {
+        foreach (uint b, size.value()) {
+            const QList<uint> &bucket = buckets.at(b);
+            QVector<uint> taken;
+            quint32 seed;
+            for (seed = 1; seed < 0x10000; ++seed) {
+                taken.clear();
+                foreach (uint h, bucket) {
+                    uint slot = perfectHashSlot(h, seed, keyCount);
+                    if (used.at(slot) || taken.contains(slot))
+                        break;
+                    taken.append(slot);
+                }
+                if (taken.size() == bucket.size())
+                    break;
+            }
+            if (seed == 0x10000)
+                return QByteArray();
+
+            seeds[b] = seed;
+            for (int i = 0; i < bucket.size(); ++i) {
+                used[taken.at(i)] = true;
+                indices[taken.at(i)] = hashes.value(bucket.at(i));
+            }
+        }
+    }
+
+    QByteArray table;
+    QDataStream ds(&table, QIODevice::WriteOnly);
+    ds << quint32(bucketCount);
+    for (uint b = 0; b < bucketCount; ++b)
+        ds << seeds.at(b);
+    for (uint k = 0; k < keyCount; ++k)
+        ds << indices.at(k);
+    return table;
+}
+
 extern bool qt_detectRTLLanguage();
 
 class TranslatorPrivate
@@ -82,7 +166,8 @@ public:
         uint o;
     };
 
-    enum { Contexts = 0x2f, Hashes = 0x42, Messages = 0x69, NumerusRules = 0x88 };
+    enum { Contexts = 0x2f, Hashes = 0x42, Messages = 0x69, NumerusRules = 0x88,
+           PerfectHashes = 0x96 };
 
     TranslatorPrivate(Translator *qq) : q(qq), unmapPointer(0), unmapLength(0) {}
     // Translator must finalize this before deallocating it
@@ -96,6 +181,7 @@ public:
     QByteArray messageArray;
     QByteArray offsetArray;
     QByteArray contextArray;
+    QByteArray perfectHashArray;
 
 #ifndef QT_NO_TRANSLATION_BUILDER
     QMap<TranslatorMessage, void *> messages;
@@ -160,6 +246,12 @@ bool Translator::save(QIODevice *iod, SaveMode mode)
         s << quint8(TranslatorPrivate::NumerusRules) << nrs;
         s.writeRawData(d->numerusRules.constData(), nrs);
     }
+    if (!d->perfectHashArray.isEmpty()) {
+        tag = (quint8)TranslatorPrivate::PerfectHashes;
+        quint32 phs = (quint32)d->perfectHashArray.size();
+        s << tag << phs;
+        s.writeRawData(d->perfectHashArray, phs);
+    }
     return true;
 }
 
@@ -174,6 +266,7 @@ void Translator::clear()
     d->messageArray.clear();
     d->offsetArray.clear();
     d->contextArray.clear();
+    d->perfectHashArray.clear();
     d->messages.clear();
 
     QEvent ev(QEvent::LanguageChange);
@@ -212,11 +305,17 @@ void Translator::squeeze(SaveMode mode)
     QMap<TranslatorPrivate::Offset, void *>::Iterator offset;
     offset = offsets.begin();
     QDataStream ds(&d->offsetArray, QIODevice::WriteOnly);
+    QMap<uint, int> hashes;
+    int index = 0;
     while (offset != offsets.end()) {
         TranslatorPrivate::Offset k = offset.key();
         ++offset;
         ds << (quint32)k.h << (quint32)k.o;
+        if (!hashes.contains(k.h))
+            hashes.insert(k.h, index);
+        ++index;
     }
+    d->perfectHashArray = buildPerfectHash(hashes);
 
     if (mode == Stripped) {
         QMap<QByteArray, int> contextSet;